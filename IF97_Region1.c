@@ -281,3 +281,84 @@ double if97_r1_w (double p_MPa , double t_Kelvin ){
 
 
 
+//**********************************************************
+//********* REGION 1 PROPERTY SETS *************************
+
+/* the requested derivatives of gamma, from table 2.  (7.1 - pi) and (tau - 1.222)
+ * are always positive in region 1, so may be divided by */
+void if97_r1_gibbs_derivs (double if97_pi, double if97_tau, int iDerivs, typIF97GibbsDerivs *d){
+	int i;
+	double dblPiTerm, dblTauTerm, dblNTerm;
+	double dblA = 7.1 - if97_pi;
+	double dblB = if97_tau - 1.222;
+	
+	d->gamma = 0.0;
+	d->gammaPi = 0.0;
+	d->gammaPiPi = 0.0;
+	d->gammaTau = 0.0;
+	d->gammaTauTau = 0.0;
+	d->gammaPiTau = 0.0;
+	
+	for (i=1; i <= MAX_GIBBS_COEFFS_R1; i++) {
+		dblPiTerm = pow(dblA, GIBBS_COEFFS_R1[i].Ii);
+		dblTauTerm = pow(dblB, GIBBS_COEFFS_R1[i].Ji);
+		dblNTerm = GIBBS_COEFFS_R1[i].ni * dblPiTerm * dblTauTerm;
+		
+		if (iDerivs & IF97_D0)  d->gamma += dblNTerm;
+		if (iDerivs & IF97_DX)  d->gammaPi -= GIBBS_COEFFS_R1[i].Ii * dblNTerm / dblA;
+		if (iDerivs & IF97_DXX) d->gammaPiPi += GIBBS_COEFFS_R1[i].Ii * (GIBBS_COEFFS_R1[i].Ii - 1) * dblNTerm / (dblA * dblA);
+		if (iDerivs & IF97_DT)  d->gammaTau += GIBBS_COEFFS_R1[i].Ji * dblNTerm / dblB;
+		if (iDerivs & IF97_DTT) d->gammaTauTau += GIBBS_COEFFS_R1[i].Ji * (GIBBS_COEFFS_R1[i].Ji - 1) * dblNTerm / (dblB * dblB);
+		if (iDerivs & IF97_DXT) d->gammaPiTau -= GIBBS_COEFFS_R1[i].Ii * GIBBS_COEFFS_R1[i].Ji * dblNTerm / (dblA * dblB);
+	}
+}
+
+
+
+// properties selected by iMask (IF97_MASK_*) in region 1
+void if97_r1_props (double p_MPa, double t_Kelvin, int iMask, typSteamState *state){
+	typIF97GibbsDerivs derivs;
+	
+	double if97pi = p_MPa / PSTAR_R1;
+	double if97tau = TSTAR_R1 / t_Kelvin;
+	
+	if97_r1_gibbs_derivs (if97pi, if97tau, if97_gibbs_derivs_needed(iMask), &derivs);
+	if97_gibbs_props (p_MPa, t_Kelvin, if97pi, if97tau, &derivs, iMask, state);
+}
+
+
+
+// specific volume (m3/kg) and [dv/dp] at constant T (m3/kg/MPa) in region 1, in a single pass, for the pressure from the density
+// v = R T gamma_pi / pstar, so [dv/dp]_T = R T gamma_pipi / pstar^2
+void if97_r1_v_dvdp (double p_MPa, double t_Kelvin, double *v, double *dvdp){
+	typIF97GibbsDerivs derivs;
+	double dblRT = IF97_R * 1000 * t_Kelvin / (PSTAR_R1 * 1e6);
+	
+	if97_r1_gibbs_derivs (p_MPa / PSTAR_R1, TSTAR_R1 / t_Kelvin, IF97_DX | IF97_DXX, &derivs);
+	*v = dblRT * derivs.gammaPi;
+	*dvdp = dblRT * derivs.gammaPiPi / PSTAR_R1;
+}
+
+
+
+//**********************************************************
+//********* REGION 1 PROPERTY EQUATIONS FOR ARRAYS *********
+
+/* specific enthalpy in region 1 (KJ / Kg) for arrays.  The sum of if97_r1_GammaTau is 
+ * taken term by term across the elements, so that each term is one loop over the 
+ * elements which the compiler can vectorise.  The terms are added in turn, so an element
+ * differs from if97_r1_h only by rounding, as the threads of its reduction may add them 
+ * in another order */
+void if97_r1_h_n (const double *p_MPa, const double *t_Kelvin, double *h, int n){
+	int i, k;
+	
+	for (k = 0; k < n; k++) h[k] = 0.0;
+	
+	for (i=1; i <= MAX_GIBBS_COEFFS_R1; i++) {
+		#pragma omp simd
+		for (k = 0; k < n; k++)
+			h[k] += GIBBS_COEFFS_R1[i].ni * pow(7.1 - p_MPa[k] / PSTAR_R1, GIBBS_COEFFS_R1[i].Ii) * GIBBS_COEFFS_R1[i].Ji * pow(TSTAR_R1 / t_Kelvin[k] - 1.222, GIBBS_COEFFS_R1[i].Ji-1);
+	}
+	
+	for (k = 0; k < n; k++) h[k] = IF97_R * t_Kelvin[k] * (TSTAR_R1 / t_Kelvin[k]) * h[k];
+}
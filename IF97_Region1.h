@@ -75,6 +75,32 @@
 	/** speed of sound in region 1 (m/s) */
 	double if97_r1_w (double p_MPa , double t_Kelvin );
 
+
+
+//**************************************************************
+//********* REGION 1 PROPERTY SETS *****************************
+
+	/** dimensionless Gibbs free energy derivatives selected by iDerivs (IF97_D*) 
+	 * for reduced pressure pi and reduced inverse temperature tau, in a single pass */
+	void if97_r1_gibbs_derivs (double if97_pi, double if97_tau, int iDerivs, typIF97GibbsDerivs *d);
+
+	/** properties selected by iMask (IF97_MASK_*, see IF97_common.h) in region 1 */
+	void if97_r1_props (double p_MPa, double t_Kelvin, int iMask, typSteamState *state);
+
+	/** specific volume (m3/kg) and [dv/dp] at constant temperature (m3/kg/MPa) in region 1, 
+	 * in a single pass.  For finding the pressure from the density */
+	void if97_r1_v_dvdp (double p_MPa, double t_Kelvin, double *v, double *dvdp);
+
+
+
+//**************************************************************
+//********* REGION 1 PROPERTY EQUATIONS FOR ARRAYS *************
+
+	/** specific enthalpy in region 1 (KJ / Kg) for arrays of n pressures and temperatures.
+	 * Each element differs from if97_r1_h only by rounding, as its reduction may add the terms in 
+	 * another order.  h must not be one of the inputs */
+	void if97_r1_h_n (const double *p_MPa, const double *t_Kelvin, double *h, int n);
+
 	
 
 #endif // IF97_REGION1_H
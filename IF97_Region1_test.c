@@ -12,6 +12,7 @@
 
 
 #include "IF97_Region1.h"
+#include "if97_test_points.h"
 #include "IF97_common.h"
 #include "if97_lib_test.h"
 
@@ -19,6 +20,8 @@
 
 int if97_region1_test (FILE *logFile){	
 	int intermediateResult;
+	const typIF97TestPoint *pt;
+	int i;
 	
 	fprintf(logFile, "\n\n*** IF97 REGION 1 MODULE CHECK ***\n" );
 	
@@ -45,37 +48,17 @@ int if97_region1_test (FILE *logFile){
 
 	intermediateResult = TEST_PASS; //clear flags.  
 	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_g, 3.0, 300.0, -2.35716470e+00, TEST_ACCURACY, SIG_FIG, "if97_r1_g", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_g, 80.0, 300.0, 7.35736720e+01, TEST_ACCURACY, SIG_FIG, "if97_r1_g", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_g, 3.0, 500.0, -3.14667321e+02, TEST_ACCURACY, SIG_FIG, "if97_r1_g", logFile);
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_v, 3.0, 300.0, 1.00215168e-3, TEST_ACCURACY, SIG_FIG, "if97_r1_v", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_v, 80.0, 300.0, 9.71180894e-4, TEST_ACCURACY, SIG_FIG, "if97_r1_v", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_v, 3.0, 500.0, 1.20241800e-3, TEST_ACCURACY, SIG_FIG, "if97_r1_v", logFile);
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_h, 3.0, 300.0, 1.15331273e2, TEST_ACCURACY, SIG_FIG, "if97_r1_h", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_h, 80.0, 300.0, 1.84142828e2, TEST_ACCURACY, SIG_FIG, "if97_r1_h", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_h, 3.0, 500.0, 9.75542239e2, TEST_ACCURACY, SIG_FIG, "if97_r1_h", logFile);	
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_u, 3.0, 300.0, 1.12324818e2, TEST_ACCURACY, SIG_FIG, "if97_r1_u", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_u, 80.0, 300.0, 1.06448356e2, TEST_ACCURACY, SIG_FIG, "if97_r1_u", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_u, 3.0, 500.0, 9.71934985e2, TEST_ACCURACY, SIG_FIG, "if97_r1_u", logFile);		
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_s, 3.0, 300.0, 3.92294792e-1, TEST_ACCURACY, SIG_FIG, "if97_r1_s", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_s, 80.0, 300.0, 3.68563852e-1, TEST_ACCURACY, SIG_FIG, "if97_r1_s", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_s, 3.0, 500.0, 2.58041912e0, TEST_ACCURACY, SIG_FIG, "if97_r1_s", logFile);	
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cp, 3.0, 300.0, 4.17301218e0, TEST_ACCURACY, SIG_FIG, "if97_r1_Cp", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cp, 80.0, 300.0, 4.01008987e0, TEST_ACCURACY, SIG_FIG, "if97_r1_Cp", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cp, 3.0, 500.0, 4.65580682e0, TEST_ACCURACY, SIG_FIG, "if97_r1_Cp", logFile);	
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cv, 3.0, 300.0, 4.12120160e0, TEST_ACCURACY, SIG_FIG, "if97_r1_Cv", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cv, 80.0, 300.0, 3.91736606e0, TEST_ACCURACY, SIG_FIG, "if97_r1_Cv", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cv, 3.0, 500.0, 3.22139223e0, TEST_ACCURACY, SIG_FIG, "if97_r1_Cv", logFile);	
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_w, 3.0, 300.0, 1.50773921e3, TEST_ACCURACY, SIG_FIG, "if97_r1_w", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_w, 80.0, 300.0, 1.63469054e3, TEST_ACCURACY, SIG_FIG, "if97_r1_w", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r1_w, 3.0, 500.0, 1.24071337e3, TEST_ACCURACY, SIG_FIG, "if97_r1_w", logFile);		
+	for (i = 0; i < IF97_TEST_POINTS; i++) {  // see if97_test_points.h
+		pt = &IF97_R1_TEST_POINTS[i];
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_g, pt->in1, pt->t_K, pt->g, TEST_ACCURACY, SIG_FIG, "if97_r1_g", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_v, pt->in1, pt->t_K, pt->vOrP, TEST_ACCURACY, SIG_FIG, "if97_r1_v", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_h, pt->in1, pt->t_K, pt->h, TEST_ACCURACY, SIG_FIG, "if97_r1_h", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_u, pt->in1, pt->t_K, pt->u, TEST_ACCURACY, SIG_FIG, "if97_r1_u", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_s, pt->in1, pt->t_K, pt->s, TEST_ACCURACY, SIG_FIG, "if97_r1_s", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cp, pt->in1, pt->t_K, pt->Cp, TEST_ACCURACY, SIG_FIG, "if97_r1_Cp", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_Cv, pt->in1, pt->t_K, pt->Cv, TEST_ACCURACY, SIG_FIG, "if97_r1_Cv", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r1_w, pt->in1, pt->t_K, pt->w, TEST_ACCURACY, SIG_FIG, "if97_r1_w", logFile);
+	}
 
 
 
@@ -424,3 +424,101 @@ double if97_r2_w (double p_MPa , double t_Kelvin ){
 }
 
  
+//**********************************************************
+//********* REGION 2 PROPERTY SETS *************************
+
+// the requested derivatives of gamma, the ideal gas part from table 10 and the residual part from table 11
+void if97_r2_gibbs_derivs (double if97_pi, double if97_tau, int iDerivs, typIF97GibbsDerivs *d){
+	int i;
+	double dblTauTerm, dblNTerm;
+	double dblB = if97_tau - 0.5;
+	
+	// ideal gas part.  Equation 16
+	d->gamma = (iDerivs & IF97_D0) ? log(if97_pi) : 0.0;
+	d->gammaPi = 1.0 / if97_pi;
+	d->gammaPiPi = -1.0 / sqr (if97_pi);
+	d->gammaTau = 0.0;
+	d->gammaTauTau = 0.0;
+	d->gammaPiTau = 0.0;
+	
+	if (iDerivs & (IF97_D0 | IF97_DT | IF97_DTT)) {
+		for (i=1; i <= MAX_GIBBS_COEFFS_R2_O; i++) {
+			dblNTerm = GIBBS_COEFFS_R2_O[i].ni * pow(if97_tau, GIBBS_COEFFS_R2_O[i].Ji);
+			
+			if (iDerivs & IF97_D0)  d->gamma += dblNTerm;
+			if (iDerivs & IF97_DT)  d->gammaTau += GIBBS_COEFFS_R2_O[i].Ji * dblNTerm / if97_tau;
+			if (iDerivs & IF97_DTT) d->gammaTauTau += GIBBS_COEFFS_R2_O[i].Ji * (GIBBS_COEFFS_R2_O[i].Ji - 1.0) * dblNTerm / sqr(if97_tau);
+		}
+	}
+	
+	// residual part.  Equation 17
+	for (i=1; i <= MAX_GIBBS_COEFFS_R2_R; i++) {
+		dblTauTerm = pow(dblB, GIBBS_COEFFS_R2_R[i].Ji);
+		dblNTerm = GIBBS_COEFFS_R2_R[i].ni * pow(if97_pi, GIBBS_COEFFS_R2_R[i].Ii) * dblTauTerm;
+		
+		if (iDerivs & IF97_D0)  d->gamma += dblNTerm;
+		if (iDerivs & IF97_DX)  d->gammaPi += GIBBS_COEFFS_R2_R[i].Ii * dblNTerm / if97_pi;
+		if (iDerivs & IF97_DXX) d->gammaPiPi += GIBBS_COEFFS_R2_R[i].Ii * (GIBBS_COEFFS_R2_R[i].Ii - 1.0) * dblNTerm / sqr(if97_pi);
+		if (iDerivs & IF97_DT)  d->gammaTau += GIBBS_COEFFS_R2_R[i].Ji * dblNTerm / dblB;
+		if (iDerivs & IF97_DTT) d->gammaTauTau += GIBBS_COEFFS_R2_R[i].Ji * (GIBBS_COEFFS_R2_R[i].Ji - 1.0) * dblNTerm / sqr(dblB);
+		if (iDerivs & IF97_DXT) d->gammaPiTau += GIBBS_COEFFS_R2_R[i].Ii * GIBBS_COEFFS_R2_R[i].Ji * dblNTerm / (if97_pi * dblB);
+	}
+}
+
+
+
+// properties selected by iMask (IF97_MASK_*) in region 2
+void if97_r2_props (double p_MPa, double t_Kelvin, int iMask, typSteamState *state){
+	typIF97GibbsDerivs derivs;
+	
+	double if97pi = p_MPa / PSTAR_R2;
+	double if97tau = TSTAR_R2 / t_Kelvin;
+	
+	if97_r2_gibbs_derivs (if97pi, if97tau, if97_gibbs_derivs_needed(iMask), &derivs);
+	if97_gibbs_props (p_MPa, t_Kelvin, if97pi, if97tau, &derivs, iMask, state);
+}
+
+
+
+// specific volume (m3/kg) and [dv/dp] at constant T (m3/kg/MPa) in region 2, in a single pass, for the pressure from the density
+// v = R T gamma_pi / pstar, so [dv/dp]_T = R T gamma_pipi / pstar^2
+void if97_r2_v_dvdp (double p_MPa, double t_Kelvin, double *v, double *dvdp){
+	typIF97GibbsDerivs derivs;
+	double dblRT = IF97_R * 1000 * t_Kelvin / (PSTAR_R2 * 1e6);
+	
+	if97_r2_gibbs_derivs (p_MPa / PSTAR_R2, TSTAR_R2 / t_Kelvin, IF97_DX | IF97_DXX, &derivs);
+	*v = dblRT * derivs.gammaPi;
+	*dvdp = dblRT * derivs.gammaPiPi / PSTAR_R2;
+}
+
+
+
+//**********************************************************
+//********* REGION 2 PROPERTY EQUATIONS FOR ARRAYS *********
+
+/* specific enthalpy in region 2 (KJ / Kg) for arrays.  The residual sum of 
+ * if97_r2_GammaTau_r is taken term by term across the elements, so that each term 
+ * is one loop over the elements which the compiler can vectorise.  The terms are 
+ * added in turn.  if97_r2_h's reduction may add them in another order, so each element
+ * is as it gives to within rounding */
+void if97_r2_h_n (const double *p_MPa, const double *t_Kelvin, double *h, int n){
+	int i, k;
+	double if97tau, dblGammaSum_o;
+	
+	for (k = 0; k < n; k++) h[k] = 0.0;
+	
+	for (i=1; i <= MAX_GIBBS_COEFFS_R2_R; i++) {
+		#pragma omp simd
+		for (k = 0; k < n; k++)
+			h[k] += GIBBS_COEFFS_R2_R[i].ni	* pow( p_MPa[k] / PSTAR_R2, GIBBS_COEFFS_R2_R[i].Ii)
+							* GIBBS_COEFFS_R2_R[i].Ji * pow((TSTAR_R2 / t_Kelvin[k] - 0.5), (GIBBS_COEFFS_R2_R[i].Ji - 1.0)); 
+	}
+	
+	for (k = 0; k < n; k++) {
+		if97tau = TSTAR_R2 / t_Kelvin[k];
+		dblGammaSum_o = 0.0;
+		for (i=1; i <= MAX_GIBBS_COEFFS_R2_O; i++)
+			dblGammaSum_o += GIBBS_COEFFS_R2_O[i].ni * GIBBS_COEFFS_R2_O[i].Ji * pow(if97tau, ( GIBBS_COEFFS_R2_O[i].Ji  - 1.0));
+		h[k] = IF97_R * t_Kelvin[k] * if97tau * (dblGammaSum_o + h[k]);
+	}
+}
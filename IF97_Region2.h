@@ -116,4 +116,31 @@
 
 
 
+//**************************************************************
+//********* REGION 2 PROPERTY SETS *****************************
+
+	/** dimensionless Gibbs free energy derivatives (ideal gas plus residual) 
+	 * selected by iDerivs (IF97_D*) for reduced pressure pi and reduced 
+	 * inverse temperature tau, in a single pass */
+	void if97_r2_gibbs_derivs (double if97_pi, double if97_tau, int iDerivs, typIF97GibbsDerivs *d);
+
+	/** properties selected by iMask (IF97_MASK_*, see IF97_common.h) in region 2 */
+	void if97_r2_props (double p_MPa, double t_Kelvin, int iMask, typSteamState *state);
+
+	/** specific volume (m3/kg) and [dv/dp] at constant temperature (m3/kg/MPa) in region 2, 
+	 * in a single pass.  For finding the pressure from the density */
+	void if97_r2_v_dvdp (double p_MPa, double t_Kelvin, double *v, double *dvdp);
+
+
+
+//**************************************************************
+//********* REGION 2 PROPERTY EQUATIONS FOR ARRAYS *************
+
+	/** specific enthalpy in region 2 (KJ / Kg) for arrays of n pressures and temperatures.
+	 * Each element is as if97_r2_h gives to within rounding, its threads adding the terms in 
+	 * their own order.  h must not be one of the inputs */
+	void if97_r2_h_n (const double *p_MPa, const double *t_Kelvin, double *h, int n);
+
+
+
 #endif // IF97_REGION2_H
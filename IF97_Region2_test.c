@@ -11,6 +11,7 @@
 
 
 #include "IF97_Region2.h"
+#include "if97_test_points.h"
 #include "IF97_Region2_met.h"
 #include <stdio.h>
 
@@ -18,6 +19,8 @@
 
 int if97_region2_test (FILE *logFile){	
 	int intermediateResult= TEST_PASS; //initialise with clear flags.  
+	const typIF97TestPoint *pt;
+	int i;
 	
 	fprintf(logFile, "\n\n*** IF97 REGION 2 MODULE CHECK ***\n" );
 	
@@ -44,37 +47,17 @@ int if97_region2_test (FILE *logFile){
 
 	fprintf(logFile, "*** IF97 REGION 2 PROPERTY (FORWARDS) EQUATIONS CHECK ***\n\n" );
 	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_g, 0.0035, 300.0, -6.80544936074451, TEST_ACCURACY, SIG_FIG, "if97_r2_g", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_g, 0.0035, 700.0, -3786.81595128593, TEST_ACCURACY, SIG_FIG, "if97_r2_g", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_g, 30.0, 700.0, -991.287342764431, TEST_ACCURACY, SIG_FIG, "if97_r2_g", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_v, 0.0035, 300.0, 3.94913866e01, TEST_ACCURACY, SIG_FIG, "if97_r2_v", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_v, 0.0035, 700.0, 9.23015898e01, TEST_ACCURACY, SIG_FIG, "if97_r2_v", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_v, 30.0, 700.0, 5.42946619e-3, TEST_ACCURACY, SIG_FIG, "if97_r2_v", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_h, 0.0035, 300.0, 2.54991145e03, TEST_ACCURACY, SIG_FIG, "if97_r2_h", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_h, 0.0035, 700.0, 3.33568375e03, TEST_ACCURACY, SIG_FIG, "if97_r2_h", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_h, 30.0, 700.0, 2.63149474e03, TEST_ACCURACY, SIG_FIG, "if97_r2_h", logFile);	
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_u, 0.0035, 300.0, 2.41169160e03, TEST_ACCURACY, SIG_FIG, "if97_r2_u", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_u, 0.0035, 700.0, 3.01262819e03, TEST_ACCURACY, SIG_FIG, "if97_r2_u", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_u, 30.0, 700.0, 2.46861076e03, TEST_ACCURACY, SIG_FIG, "if97_r2_u", logFile);
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_s, 0.0035, 300.0, 8.52238967e00, TEST_ACCURACY, SIG_FIG, "if97_r2_s", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_s, 0.0035, 700.0, 1.01749996e01, TEST_ACCURACY, SIG_FIG, "if97_r2_s", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_s, 30.0, 700.0, 5.17540298e00, TEST_ACCURACY, SIG_FIG, "if97_r2_s", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cp, 0.0035, 300.0, 1.91300162e00, TEST_ACCURACY, SIG_FIG, "if97_r2_Cp", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cp, 0.0035, 700.0, 2.08141274e00, TEST_ACCURACY, SIG_FIG, "if97_r2_Cp", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cp, 30.0, 700.0, 1.03505092e01, TEST_ACCURACY, SIG_FIG, "if97_r2_Cp", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cv, 0.0035, 300.0, 1.441326618975, TEST_ACCURACY, SIG_FIG, "if97_r2_Cv", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cv, 0.0035, 700.0, 1.6197833256, TEST_ACCURACY, SIG_FIG, "if97_r2_Cv", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cv, 30.0, 700.0, 2.975538368909, TEST_ACCURACY, SIG_FIG, "if97_r2_Cv", logFile);	
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_w, 0.0035, 300.0, 4.27920172e02, TEST_ACCURACY, SIG_FIG, "if97_r2_w", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_w, 0.0035, 700.0, 6.44289068e02, TEST_ACCURACY, SIG_FIG, "if97_r2_w", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r2_w, 30.0, 700.0, 4.80386523e02, TEST_ACCURACY, SIG_FIG, "if97_r2_w", logFile);
+	for (i = 0; i < IF97_TEST_POINTS; i++) {  // see if97_test_points.h
+		pt = &IF97_R2_TEST_POINTS[i];
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_g, pt->in1, pt->t_K, pt->g, TEST_ACCURACY, SIG_FIG, "if97_r2_g", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_v, pt->in1, pt->t_K, pt->vOrP, TEST_ACCURACY, SIG_FIG, "if97_r2_v", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_h, pt->in1, pt->t_K, pt->h, TEST_ACCURACY, SIG_FIG, "if97_r2_h", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_u, pt->in1, pt->t_K, pt->u, TEST_ACCURACY, SIG_FIG, "if97_r2_u", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_s, pt->in1, pt->t_K, pt->s, TEST_ACCURACY, SIG_FIG, "if97_r2_s", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cp, pt->in1, pt->t_K, pt->Cp, TEST_ACCURACY, SIG_FIG, "if97_r2_Cp", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_Cv, pt->in1, pt->t_K, pt->Cv, TEST_ACCURACY, SIG_FIG, "if97_r2_Cv", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r2_w, pt->in1, pt->t_K, pt->w, TEST_ACCURACY, SIG_FIG, "if97_r2_w", logFile);
+	}
 
 	
 
@@ -40,7 +40,7 @@
 
 
 
-const typIF97Coeffs_IJn  PHI_COEFFS_R3[] = {
+const typIF97Coeffs_IJn  PHI_COEFFS_R3[IF97_R3_PHI_COEFFS + 1] = {
 	{0,    0,	 0.0} 				   //0  i starts at 1, so 0th i is not used
 	,{ 0,    0,    0.10658070028513E1}	// "0, 0" are "-, -" in the standard
 	,{ 0,    0,    -0.15732845290239E2}
@@ -84,7 +84,7 @@ const typIF97Coeffs_IJn  PHI_COEFFS_R3[] = {
 	,{ 11,    26,    -0.44923899061815E-4}
 };
 
-const int MAX_COEFFS_PHI_R3 = 40;
+const int MAX_COEFFS_PHI_R3 = IF97_R3_PHI_COEFFS;
 
 // dimensionless helmholz free energy in Region3 :   See Equation 28
 double if97_r3_Phi (double if97_delta, double  if97_tau) {
@@ -302,6 +302,142 @@ double if97_r3_w (double rho_kgPerM3 , double t_Kelvin ) {
 }	
 
 
+// [dp/drho] at constant T (MPa m3/kg) in region 3 for a given density (kg/m3) and temperature (K). 
+// The derivative for finding the density from the pressure.  Zero at the critical point
+double if97_r3_dpdrho (double rho_kgPerM3 , double t_Kelvin ) {
+		
+	double if97delta = rho_kgPerM3 / IF97_RHOC;
+	double if97tau =  IF97_TC / t_Kelvin;
+	
+return  0.001 * IF97_R * t_Kelvin * (2.0 * if97delta * if97_r3_PhiDelta(if97delta, if97tau) 
+				+ sqr(if97delta) * if97_r3_PhiDeltaDelta(if97delta, if97tau));  // factor of 1000 as if97_r3_p
+}	
+
+
+
+
+//**********************************************************
+//********* REGION 3 PRESSURE ON AN ISOTHERM ***************
+
+void if97_r3_isotherm (double t_Kelvin, typIF97R3Isotherm *iso){
+	double if97tau =  IF97_TC / t_Kelvin;
+	int i;
+	
+	iso->t_Kelvin = t_Kelvin;
+	for (i=2; i <= MAX_COEFFS_PHI_R3 ; i++) iso->dblTauPow[i] = pow( if97tau, PHI_COEFFS_R3[i].Ji);
+}
+
+
+// the terms are as if97_r3_PhiDelta, added in turn, so the pressure is as if97_r3_p gives to within the rounding of its reduction
+double if97_r3_p_iso (double rho_kgPerM3, void *ctx){
+	const typIF97R3Isotherm *iso = ctx;
+	double if97delta = rho_kgPerM3 / IF97_RHOC;
+	double dblPhiSum = 0.0;
+	int i;
+	
+	for (i=2; i <= MAX_COEFFS_PHI_R3 ; i++) 
+		dblPhiSum +=   PHI_COEFFS_R3[i].ni *   PHI_COEFFS_R3[i].Ii *  pow(if97delta , PHI_COEFFS_R3[i].Ii - 1.0 ) *  iso->dblTauPow[i];
+	
+return  0.001 * rho_kgPerM3 *  IF97_R * iso->t_Kelvin * if97delta * (PHI_COEFFS_R3[1].ni /if97delta + dblPhiSum);
+}
+
+
+
+
+//**********************************************************
+//********* REGION 3 PROPERTY SETS *************************
+
+// the requested derivatives of phi, from table 30.  The first term is logarithmic, so is taken apart
+void if97_r3_helm_derivs (double if97_delta, double if97_tau, int iDerivs, typIF97HelmDerivs *d){
+	int i;
+	double dblNTerm;
+	
+	// the logarithmic first term
+	d->phi = (iDerivs & IF97_D0) ? PHI_COEFFS_R3[1].ni * log(if97_delta) : 0.0;
+	d->phiDelta = PHI_COEFFS_R3[1].ni / if97_delta;
+	d->phiDeltaDelta = - PHI_COEFFS_R3[1].ni / sqr(if97_delta);
+	d->phiTau = 0.0;
+	d->phiTauTau = 0.0;
+	d->phiDeltaTau = 0.0;
+	
+	for (i=2; i <= MAX_COEFFS_PHI_R3 ; i++) {
+		dblNTerm = PHI_COEFFS_R3[i].ni * pow(if97_delta, PHI_COEFFS_R3[i].Ii) * pow(if97_tau, PHI_COEFFS_R3[i].Ji);
+		
+		if (iDerivs & IF97_D0)  d->phi += dblNTerm;
+		if (iDerivs & IF97_DX)  d->phiDelta += PHI_COEFFS_R3[i].Ii * dblNTerm / if97_delta;
+		if (iDerivs & IF97_DXX) d->phiDeltaDelta += PHI_COEFFS_R3[i].Ii * (PHI_COEFFS_R3[i].Ii - 1.0) * dblNTerm / sqr(if97_delta);
+		if (iDerivs & IF97_DT)  d->phiTau += PHI_COEFFS_R3[i].Ji * dblNTerm / if97_tau;
+		if (iDerivs & IF97_DTT) d->phiTauTau += PHI_COEFFS_R3[i].Ji * (PHI_COEFFS_R3[i].Ji - 1.0) * dblNTerm / sqr(if97_tau);
+		if (iDerivs & IF97_DXT) d->phiDeltaTau += PHI_COEFFS_R3[i].Ii * PHI_COEFFS_R3[i].Ji * dblNTerm / (if97_delta * if97_tau);
+	}
+}
+
+
+
+// properties selected by iMask (IF97_MASK_*) in region 3 for a given density (kg/m3) and temperature (K).  See table 31
+void if97_r3_props (double rho_kgPerM3, double t_Kelvin, int iMask, typSteamState *state){
+	typIF97HelmDerivs d;
+	double dblDenom, dblCpPart;
+	
+	double if97delta = rho_kgPerM3 / IF97_RHOC;
+	double if97tau = IF97_TC / t_Kelvin;
+	
+	if97_r3_helm_derivs (if97delta, if97tau, if97_helm_derivs_needed(iMask), &d);
+	
+	if (iMask & IF97_MASK_V)
+		state->rho_kgperM3 = rho_kgPerM3;
+	
+	if (iMask & IF97_MASK_H)
+		state->h_kJperkg = IF97_R * t_Kelvin * (if97tau * d.phiTau + if97delta * d.phiDelta);
+	
+	if (iMask & IF97_MASK_U)
+		state->u_kJperkg = IF97_R * t_Kelvin * if97tau * d.phiTau;
+	
+	if (iMask & IF97_MASK_S)
+		state->s_kJperkgK = IF97_R * (if97tau * d.phiTau - d.phi);
+	
+	if (iMask & IF97_MASK_CV)
+		state->Cv_kJperkgK = - IF97_R * sqr(if97tau) * d.phiTauTau;
+	
+	if (iMask & (IF97_MASK_CP | IF97_MASK_W)) {
+		dblDenom = 2.0 * if97delta * d.phiDelta + sqr(if97delta) * d.phiDeltaDelta;
+		dblCpPart = sqr(if97delta * d.phiDelta - if97delta * if97tau * d.phiDeltaTau);
+		
+		if (iMask & IF97_MASK_CP)
+			state->Cp_kJperkgK = IF97_R * (-sqr(if97tau) * d.phiTauTau + dblCpPart / dblDenom);
+		
+		if (iMask & IF97_MASK_W)  // 1000 because R in in KJ / Kg.K  not J / Kg.K 
+			state->Vs_MperSec = sqrt(IF97_R * 1000.0 * t_Kelvin * (dblDenom - dblCpPart / (sqr(if97tau) * d.phiTauTau)));
+	}
+}
+
+
+
+//**********************************************************
+//********* REGION 3 PROPERTY EQUATIONS FOR ARRAYS *********
+
+/* pressure (MPa) in region 3 for arrays.  The sum of if97_r3_PhiDelta is taken
+ * term by term across the elements, so that each term is one loop over the elements
+ * which the compiler can vectorise.  The terms are added in turn, so each element is
+ * as if97_r3_p gives, to within the rounding of the order its reduction adds them in */
+void if97_r3_p_n (const double *rho_kgPerM3, const double *t_Kelvin, double *p_MPa, int n){
+	int i, k;
+	double if97delta;
+	
+	for (k = 0; k < n; k++) p_MPa[k] = 0.0;
+	
+	for (i=2; i <= MAX_COEFFS_PHI_R3 ; i++) {
+		#pragma omp simd
+		for (k = 0; k < n; k++)
+			p_MPa[k] +=   PHI_COEFFS_R3[i].ni *   PHI_COEFFS_R3[i].Ii *  pow(rho_kgPerM3[k] / IF97_RHOC , PHI_COEFFS_R3[i].Ii - 1.0 ) *  pow( IF97_TC / t_Kelvin[k], PHI_COEFFS_R3[i].Ji)	;
+	}
+	
+	for (k = 0; k < n; k++) {
+		if97delta = rho_kgPerM3[k] / IF97_RHOC;
+		p_MPa[k] = 0.001 * rho_kgPerM3[k] *  IF97_R * t_Kelvin[k] * if97delta * (PHI_COEFFS_R3[1].ni /if97delta + p_MPa[k]);
+	}
+}
+
 
 
 // TODO Phase Equilibrium equations from table 31
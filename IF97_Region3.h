@@ -106,6 +106,58 @@ double if97_r3_Cp (double rho_kgPerM3 , double t_Kelvin );
 double if97_r3_w (double rho_kgPerM3 , double t_Kelvin ) ;
 
 
+/** [dp/drho] at constant temperature (MPa m3/kg) in region 3 for a given 
+ * density (kg/m3) and temperature (K) */
+double if97_r3_dpdrho (double rho_kgPerM3 , double t_Kelvin ) ;
+
+
+//**************************************************************
+//********* REGION 3 PROPERTY SETS *****************************
+
+/** dimensionless Helmholtz free energy derivatives selected by iDerivs (IF97_D*) 
+ * for reduced density delta and reduced inverse temperature tau, in a single pass */
+void if97_r3_helm_derivs (double if97_delta, double if97_tau, int iDerivs, typIF97HelmDerivs *d);
+
+
+/** properties selected by iMask (IF97_MASK_*, see IF97_common.h) in region 3 for a 
+ * given density (kg/m3) and temperature (K) */
+void if97_r3_props (double rho_kgPerM3, double t_Kelvin, int iMask, typSteamState *state);
+
+
+
+//**************************************************************
+//********* REGION 3 PRESSURE ON AN ISOTHERM *******************
+
+#define IF97_R3_PHI_COEFFS 40  // coefficients of the region 3 Helmholtz free energy.  Sizes PHI_COEFFS_R3
+
+/** work which is the same at every density on an isotherm: the powers of tau 
+ * in the Helmholtz free energy. Set by if97_r3_isotherm */
+typedef struct sctIF97R3Isotherm {
+	double t_Kelvin;
+	double dblTauPow[IF97_R3_PHI_COEFFS + 1];  // tau^Ji, from i = 2
+} typIF97R3Isotherm;
+
+
+/** prepares the isotherm at t_Kelvin for if97_r3_p_iso */
+void if97_r3_isotherm (double t_Kelvin, typIF97R3Isotherm *iso);
+
+
+/** pressure (MPa) in region 3 for a given density (kg/m3) on the isotherm ctx 
+ * (a typIF97R3Isotherm *).  As if97_r3_p, without recalculating the powers of tau. 
+ * For finding density from pressure with ctx_solv */
+double if97_r3_p_iso (double rho_kgPerM3, void *ctx);
+
+
+
+//**************************************************************
+//********* REGION 3 PROPERTY EQUATIONS FOR ARRAYS *************
+
+/** pressure (MPa) in region 3 for arrays of n densities (kg/m3) and temperatures (K).
+ * Each element is as if97_r3_p gives, to within the rounding of the order its reduction adds 
+ * the terms in.  p must not be one of the inputs */
+void if97_r3_p_n (const double *rho_kgPerM3, const double *t_Kelvin, double *p_MPa, int n);
+
+
 // TODO Phase Equilibrium equations from table 31
 
 
@@ -11,6 +11,7 @@
 * *******************************************************************************/
 
 #include "IF97_Region3.h"
+#include "if97_test_points.h"
 #include <stdio.h>
 #include "IF97_common.h"
 #include "if97_lib_test.h"
@@ -18,6 +19,8 @@
 
 int if97_region3_test (FILE *logFile){	
 	int intermediateResult= TEST_PASS; //initialise with clear flags.  
+	const typIF97TestPoint *pt;
+	int i;
 	
 	fprintf(logFile, "\n\n*** IF97 REGION 3 MODULE CHECK ***\n" );
 
@@ -42,37 +45,17 @@ int if97_region3_test (FILE *logFile){
 
 	fprintf(logFile, "*** IF97 REGION 3 PROPERTY (FORWARDS) EQUATIONS CHECK ***\n\n" );
 	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_hhz, 500.0, 650.0 , -823.014490474163, TEST_ACCURACY, SIG_FIG, "if97_r3_hhz", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_hhz, 200.0, 650.0 , -891.693463667219, TEST_ACCURACY, SIG_FIG, "if97_r3_hhz", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_hhz, 500.0, 750.0 , -1250.21997453598, TEST_ACCURACY, SIG_FIG, "if97_r3_hhz", logFile);
-		
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_p, 500.0, 650.0 , 2.55837018e01, TEST_ACCURACY, SIG_FIG, "if97_r3_p", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_p, 200.0, 650.0 , 2.22930643e01, TEST_ACCURACY, SIG_FIG, "if97_r3_p", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_p, 500.0, 750.0 , 7.83095639e01, TEST_ACCURACY, SIG_FIG, "if97_r3_p", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_h, 500.0, 650.0 , 1.86343019e03, TEST_ACCURACY, SIG_FIG, "if97_r3_h", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_h, 200.0, 650.0 , 2.37512401e03, TEST_ACCURACY, SIG_FIG, "if97_r3_h", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_h, 500.0, 750.0 , 2.25868845e03, TEST_ACCURACY, SIG_FIG, "if97_r3_h", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_u, 500.0, 650.0 , 1.81226279e03, TEST_ACCURACY, SIG_FIG, "if97_r3_u", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_u, 200.0, 650.0 , 2.26365868e03, TEST_ACCURACY, SIG_FIG, "if97_r3_u", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_u, 500.0, 750.0 , 2.10206932e03, TEST_ACCURACY, SIG_FIG, "if97_r3_u", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_s, 500.0, 650.0 , 4.05427273e00, TEST_ACCURACY, SIG_FIG, "if97_r3_s", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_s, 200.0, 650.0 , 4.85438792e00, TEST_ACCURACY, SIG_FIG, "if97_r3_s", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_s, 500.0, 750.0 , 4.46971906e00, TEST_ACCURACY, SIG_FIG, "if97_r3_s", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cp, 500.0, 650.0 , 1.38935717e01, TEST_ACCURACY, SIG_FIG, "if97_r3_Cp", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cp, 200.0, 650.0 , 4.46579342e01, TEST_ACCURACY, SIG_FIG, "if97_r3_Cp", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cp, 500.0, 750.0 , 6.34165359e00, TEST_ACCURACY, SIG_FIG, "if97_r3_Cp", logFile);
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cv, 500.0, 650.0 , 3.191317871889, TEST_ACCURACY, SIG_FIG, "if97_r3_Cv", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cv, 200.0, 650.0 , 4.04118075955, TEST_ACCURACY, SIG_FIG, "if97_r3_Cv", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cv, 500.0, 750.0 , 2.71701677121, TEST_ACCURACY, SIG_FIG, "if97_r3_Cv", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_w, 500.0, 650.0 , 5.02005554e02, TEST_ACCURACY, SIG_FIG, "if97_r3_w", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_w, 200.0, 650.0 , 3.83444594e02, TEST_ACCURACY, SIG_FIG, "if97_r3_w", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r3_w, 500.0, 750.0 , 7.60696041e02, TEST_ACCURACY, SIG_FIG, "if97_r3_w", logFile);
+	for (i = 0; i < IF97_TEST_POINTS; i++) {  // see if97_test_points.h
+		pt = &IF97_R3_TEST_POINTS[i];
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_hhz, pt->in1, pt->t_K, pt->g, TEST_ACCURACY, SIG_FIG, "if97_r3_hhz", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_p, pt->in1, pt->t_K, pt->vOrP, TEST_ACCURACY, SIG_FIG, "if97_r3_p", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_h, pt->in1, pt->t_K, pt->h, TEST_ACCURACY, SIG_FIG, "if97_r3_h", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_u, pt->in1, pt->t_K, pt->u, TEST_ACCURACY, SIG_FIG, "if97_r3_u", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_s, pt->in1, pt->t_K, pt->s, TEST_ACCURACY, SIG_FIG, "if97_r3_s", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cp, pt->in1, pt->t_K, pt->Cp, TEST_ACCURACY, SIG_FIG, "if97_r3_Cp", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_Cv, pt->in1, pt->t_K, pt->Cv, TEST_ACCURACY, SIG_FIG, "if97_r3_Cv", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r3_w, pt->in1, pt->t_K, pt->w, TEST_ACCURACY, SIG_FIG, "if97_r3_w", logFile);
+	}
 	
 
 	
@@ -26,6 +26,7 @@
 
 #include "IF97_common.h"  //PSTAR TSTAR & sqr
 #include "IF97_Region4.h" // saturation line used in determining subregion
+#include "if97_stats.h"
 #include "IF97_B23.h"   // not strictly required but used in v(p,t) subregion selector as an error detector
 #include <math.h> // for pow, log
 /* #ifdef _OPENMP // multithreading via libgomp
@@ -2282,6 +2283,8 @@ double if97_R3bw_v_pt (double p_MPa, double t_K){
 	
 	char R3_bw_region = if97_r3_pt_subregion(p_MPa, t_K);
 
+	IF97_STATS_SUBREGION(R3_bw_region);
+
 	i =(int)R3_bw_region - (int)'a';
 	
 	if ((i < 0) || (i >25)) return 0.00; //ERROR
@@ -369,3 +369,67 @@ double if97_r5_w (double p_MPa , double t_Kelvin ){
  
 
 
+//**********************************************************
+//********* REGION 5 PROPERTY SETS *************************
+
+// the requested derivatives of gamma, the ideal gas part from table 37 and the residual part from table 38
+void if97_r5_gibbs_derivs (double if97_pi, double if97_tau, int iDerivs, typIF97GibbsDerivs *d){
+	int i;
+	double dblNTerm;
+	
+	// ideal gas part.  Equation 33
+	d->gamma = (iDerivs & IF97_D0) ? log(if97_pi) : 0.0;
+	d->gammaPi = 1.0 / if97_pi;
+	d->gammaPiPi = -1.0 / sqr (if97_pi);
+	d->gammaTau = 0.0;
+	d->gammaTauTau = 0.0;
+	d->gammaPiTau = 0.0;
+	
+	if (iDerivs & (IF97_D0 | IF97_DT | IF97_DTT)) {
+		for (i=1; i <= MAX_GIBBS_COEFFS_R5_O; i++) {
+			dblNTerm = GIBBS_COEFFS_R5_O[i].ni * pow(if97_tau, GIBBS_COEFFS_R5_O[i].Ji);
+			
+			if (iDerivs & IF97_D0)  d->gamma += dblNTerm;
+			if (iDerivs & IF97_DT)  d->gammaTau += GIBBS_COEFFS_R5_O[i].Ji * dblNTerm / if97_tau;
+			if (iDerivs & IF97_DTT) d->gammaTauTau += GIBBS_COEFFS_R5_O[i].Ji * (GIBBS_COEFFS_R5_O[i].Ji - 1.0) * dblNTerm / sqr(if97_tau);
+		}
+	}
+	
+	// residual part.  Equation 34
+	for (i=1; i <= MAX_GIBBS_COEFFS_R5_R; i++) {
+		dblNTerm = GIBBS_COEFFS_R5_R[i].ni * pow(if97_pi, GIBBS_COEFFS_R5_R[i].Ii) * pow(if97_tau, GIBBS_COEFFS_R5_R[i].Ji);
+		
+		if (iDerivs & IF97_D0)  d->gamma += dblNTerm;
+		if (iDerivs & IF97_DX)  d->gammaPi += GIBBS_COEFFS_R5_R[i].Ii * dblNTerm / if97_pi;
+		if (iDerivs & IF97_DXX) d->gammaPiPi += GIBBS_COEFFS_R5_R[i].Ii * (GIBBS_COEFFS_R5_R[i].Ii - 1.0) * dblNTerm / sqr(if97_pi);
+		if (iDerivs & IF97_DT)  d->gammaTau += GIBBS_COEFFS_R5_R[i].Ji * dblNTerm / if97_tau;
+		if (iDerivs & IF97_DTT) d->gammaTauTau += GIBBS_COEFFS_R5_R[i].Ji * (GIBBS_COEFFS_R5_R[i].Ji - 1.0) * dblNTerm / sqr(if97_tau);
+		if (iDerivs & IF97_DXT) d->gammaPiTau += GIBBS_COEFFS_R5_R[i].Ii * GIBBS_COEFFS_R5_R[i].Ji * dblNTerm / (if97_pi * if97_tau);
+	}
+}
+
+
+
+// properties selected by iMask (IF97_MASK_*) in region 5
+void if97_r5_props (double p_MPa, double t_Kelvin, int iMask, typSteamState *state){
+	typIF97GibbsDerivs derivs;
+	
+	double if97pi = p_MPa / PSTAR_R5;
+	double if97tau = TSTAR_R5 / t_Kelvin;
+	
+	if97_r5_gibbs_derivs (if97pi, if97tau, if97_gibbs_derivs_needed(iMask), &derivs);
+	if97_gibbs_props (p_MPa, t_Kelvin, if97pi, if97tau, &derivs, iMask, state);
+}
+
+
+
+// specific volume (m3/kg) and [dv/dp] at constant T (m3/kg/MPa) in region 5, in a single pass, for the pressure from the density
+// v = R T gamma_pi / pstar, so [dv/dp]_T = R T gamma_pipi / pstar^2
+void if97_r5_v_dvdp (double p_MPa, double t_Kelvin, double *v, double *dvdp){
+	typIF97GibbsDerivs derivs;
+	double dblRT = IF97_R * 1000 * t_Kelvin / (PSTAR_R5 * 1e6);
+	
+	if97_r5_gibbs_derivs (p_MPa / PSTAR_R5, TSTAR_R5 / t_Kelvin, IF97_DX | IF97_DXX, &derivs);
+	*v = dblRT * derivs.gammaPi;
+	*dvdp = dblRT * derivs.gammaPiPi / PSTAR_R5;
+}
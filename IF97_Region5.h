@@ -103,4 +103,21 @@
 
 
 
+//**************************************************************
+//********* REGION 5 PROPERTY SETS *****************************
+
+	/** dimensionless Gibbs free energy derivatives (ideal gas plus residual) 
+	 * selected by iDerivs (IF97_D*) for reduced pressure pi and reduced 
+	 * inverse temperature tau, in a single pass */
+	void if97_r5_gibbs_derivs (double if97_pi, double if97_tau, int iDerivs, typIF97GibbsDerivs *d);
+
+	/** properties selected by iMask (IF97_MASK_*, see IF97_common.h) in region 5 */
+	void if97_r5_props (double p_MPa, double t_Kelvin, int iMask, typSteamState *state);
+
+	/** specific volume (m3/kg) and [dv/dp] at constant temperature (m3/kg/MPa) in region 5, 
+	 * in a single pass.  For finding the pressure from the density */
+	void if97_r5_v_dvdp (double p_MPa, double t_Kelvin, double *v, double *dvdp);
+
+
+
 #endif // IF97_REGION5_H
@@ -12,6 +12,7 @@
 //TODO  insert correct conditions for g and Cv and check table
 
 #include "IF97_Region5.h"
+#include "if97_test_points.h"
 #include <stdio.h>
 #include "IF97_common.h"
 #include "if97_lib_test.h"
@@ -19,6 +20,8 @@
 
 int if97_region5_test (FILE *logFile){	
 	int intermediateResult= TEST_PASS; //initialise with clear flags.  
+	const typIF97TestPoint *pt;
+	int i;
 	
 	fprintf(logFile, "\n\n*** IF97 REGION 5 MODULE CHECK ***\n" );
 
@@ -45,37 +48,17 @@ int if97_region5_test (FILE *logFile){
 
 	fprintf(logFile, "*** IF97 REGION 5 (high temperature steam) PROPERTY (FORWARDS) EQUATIONS CHECK ***\n" );
 	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_g, 0.5, 1500.0, -9261.36457876123, TEST_ACCURACY, SIG_FIG, "if97_r5_g", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_g, 30.0, 1500.0, -6427.31684918484, TEST_ACCURACY, SIG_FIG, "if97_r5_g", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_g, 30.0, 2000.0, -10501.5844236579, TEST_ACCURACY, SIG_FIG, "if97_r5_g", logFile);
-		
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_v, 0.5, 1500.0, 1.38455090e00, TEST_ACCURACY, SIG_FIG, "if97_r5_v", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_v, 30.0, 1500.0, 2.30761299e-02, TEST_ACCURACY, SIG_FIG, "if97_r5_v", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_v, 30.0, 2000.0, 3.11385219e-02, TEST_ACCURACY, SIG_FIG, "if97_r5_v", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_h, 0.5, 1500.0, 5.21976855e03, TEST_ACCURACY, SIG_FIG, "if97_r5_h", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_h, 30.0, 1500.0, 5.16723514e03, TEST_ACCURACY, SIG_FIG, "if97_r5_h", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_h, 30.0, 2000.0, 6.57122604e03, TEST_ACCURACY, SIG_FIG, "if97_r5_h", logFile);	
-
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_u, 0.5, 1500.0, 4.52749310e03, TEST_ACCURACY, SIG_FIG, "if97_r5_u", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_u, 30.0, 1500.0, 4.47495124e03, TEST_ACCURACY, SIG_FIG, "if97_r5_u", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_u, 30.0, 2000.0, 5.63707038e03, TEST_ACCURACY, SIG_FIG, "if97_r5_u", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_s, 0.5, 1500.0, 9.654088753313, TEST_ACCURACY, SIG_FIG, "if97_r5_s", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_s, 30.0, 1500.0, 7.729701326183, TEST_ACCURACY, SIG_FIG, "if97_r5_s", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_s, 30.0, 2000.0, 8.536405231138, TEST_ACCURACY, SIG_FIG, "if97_r5_s", logFile);	
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cp, 0.5, 1500.0, 2.61609445e00, TEST_ACCURACY, SIG_FIG, "if97_r5_Cp", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cp, 30.0, 1500.0, 2.72724317e00, TEST_ACCURACY, SIG_FIG, "if97_r5_Cp", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cp, 30.0, 2000.0, 2.88569882e00, TEST_ACCURACY, SIG_FIG, "if97_r5_Cp", logFile);
-	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cv, 0.5, 1500.0, 2.1533778351, TEST_ACCURACY, SIG_FIG, "if97_r5_Cv", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cv, 30.0, 1500.0, 2.192748293665, TEST_ACCURACY, SIG_FIG, "if97_r5_Cv", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cv, 30.0, 2000.0, 2.395894362358, TEST_ACCURACY, SIG_FIG, "if97_r5_Cv", logFile);
-		
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_w, 0.5, 1500.0, 9.17068690e02, TEST_ACCURACY, SIG_FIG, "if97_r5_w", logFile);
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_w, 30.0, 1500.0, 9.28548002e02, TEST_ACCURACY, SIG_FIG, "if97_r5_w", logFile);	
-	intermediateResult = intermediateResult | testDoubleInput ( if97_r5_w, 30.0, 2000.0, 1.06736948e03, TEST_ACCURACY, SIG_FIG, "if97_r5_w", logFile);
+	for (i = 0; i < IF97_TEST_POINTS; i++) {  // see if97_test_points.h
+		pt = &IF97_R5_TEST_POINTS[i];
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_g, pt->in1, pt->t_K, pt->g, TEST_ACCURACY, SIG_FIG, "if97_r5_g", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_v, pt->in1, pt->t_K, pt->vOrP, TEST_ACCURACY, SIG_FIG, "if97_r5_v", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_h, pt->in1, pt->t_K, pt->h, TEST_ACCURACY, SIG_FIG, "if97_r5_h", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_u, pt->in1, pt->t_K, pt->u, TEST_ACCURACY, SIG_FIG, "if97_r5_u", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_s, pt->in1, pt->t_K, pt->s, TEST_ACCURACY, SIG_FIG, "if97_r5_s", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cp, pt->in1, pt->t_K, pt->Cp, TEST_ACCURACY, SIG_FIG, "if97_r5_Cp", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_Cv, pt->in1, pt->t_K, pt->Cv, TEST_ACCURACY, SIG_FIG, "if97_r5_Cv", logFile);
+		intermediateResult = intermediateResult | testDoubleInput ( if97_r5_w, pt->in1, pt->t_K, pt->w, TEST_ACCURACY, SIG_FIG, "if97_r5_w", logFile);
+	}
 	
 
 	if (intermediateResult != 0)
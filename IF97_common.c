@@ -72,6 +72,8 @@
 
 
 #include "IF97_common.h"
+#include <math.h>  // sqrt
+#include <string.h>  // strcpy
 
 
 /** squares a double without using pow */
@@ -80,3 +82,88 @@ double sqr (double dblArg) {	return dblArg * dblArg; }
 /** squares a double without using pow */
 double cube (double dblArg){	return dblArg * dblArg * dblArg; }
 
+
+
+
+/** sets every property of a steam state to -9999 (not applicable) */
+void if97_clear_state (typSteamState *state){
+	state->p_MPa = -9999.0;
+	state->t_K = -9999.0;
+	state->h_kJperkg = -9999.0;
+	state->u_kJperkg = -9999.0;
+	state->s_kJperkgK = -9999.0;
+	state->Cv_kJperkgK = -9999.0;
+	state->Cp_kJperkgK = -9999.0;
+	state->Vs_MperSec = -9999.0;
+	state->rho_kgperM3 = -9999.0;
+	state->qual_pct = -9999.0;
+	state->phase = LIQUID;
+	state->iRegion = 0;
+	strcpy (state->strSteamTables, "IAPWS-IF97");
+}
+
+
+
+/** Gibbs free energy derivatives needed for the properties in iMask.  See Table 3 */
+int if97_gibbs_derivs_needed (int iMask){
+	int iDerivs = 0;
+	
+	if (iMask & IF97_MASK_V) iDerivs |= IF97_DX;
+	if (iMask & IF97_MASK_H) iDerivs |= IF97_DT;
+	if (iMask & IF97_MASK_U) iDerivs |= IF97_DT | IF97_DX;
+	if (iMask & IF97_MASK_S) iDerivs |= IF97_DT | IF97_D0;
+	if (iMask & IF97_MASK_CP) iDerivs |= IF97_DTT;
+	if (iMask & (IF97_MASK_CV | IF97_MASK_W)) iDerivs |= IF97_DX | IF97_DXX | IF97_DTT | IF97_DXT;
+	
+	return iDerivs;
+}
+
+
+
+/** Helmholtz free energy derivatives needed for the properties in iMask.  See Table 31 */
+int if97_helm_derivs_needed (int iMask){
+	int iDerivs = 0;
+	
+	if (iMask & IF97_MASK_H) iDerivs |= IF97_DT | IF97_DX;
+	if (iMask & IF97_MASK_U) iDerivs |= IF97_DT;
+	if (iMask & IF97_MASK_S) iDerivs |= IF97_DT | IF97_D0;
+	if (iMask & IF97_MASK_CV) iDerivs |= IF97_DTT;
+	if (iMask & (IF97_MASK_CP | IF97_MASK_W)) iDerivs |= IF97_DX | IF97_DXX | IF97_DTT | IF97_DXT;
+	
+	return iDerivs;
+}
+
+
+
+/** fills the properties in iMask from the dimensionless Gibbs free energy derivatives. 
+ * Common to regions 1, 2 and 5. See Tables 3, 12 and 39 */
+void if97_gibbs_props (double p_MPa, double t_K, double pi, double tau, const typIF97GibbsDerivs *d, int iMask, typSteamState *state){
+	double dblCvPart;
+	
+	// inputs need to convert to pure SI, hence the ´magic´ numbers
+	if (iMask & IF97_MASK_V)
+		state->rho_kgperM3 = 1.0 / ((IF97_R * 1000 * t_K / (p_MPa * 1e6)) * pi * d->gammaPi);
+	
+	if (iMask & IF97_MASK_H)
+		state->h_kJperkg = IF97_R * t_K * tau * d->gammaTau;
+	
+	if (iMask & IF97_MASK_U)
+		state->u_kJperkg = IF97_R * t_K * (tau * d->gammaTau - pi * d->gammaPi);
+	
+	if (iMask & IF97_MASK_S)
+		state->s_kJperkgK = IF97_R * (tau * d->gammaTau - d->gamma);
+	
+	if (iMask & IF97_MASK_CP)
+		state->Cp_kJperkgK = -IF97_R * sqr(tau) * d->gammaTauTau;
+	
+	if (iMask & (IF97_MASK_CV | IF97_MASK_W)) {
+		dblCvPart = sqr(d->gammaPi - tau * d->gammaPiTau);
+		
+		if (iMask & IF97_MASK_CV)
+			state->Cv_kJperkgK = IF97_R * (-sqr(tau) * d->gammaTauTau + dblCvPart / d->gammaPiPi);
+		
+		if (iMask & IF97_MASK_W)
+			state->Vs_MperSec = sqrt( (IF97_R * 1000 * t_K * sqr(d->gammaPi))
+									/ (dblCvPart / (sqr(tau) * d->gammaTauTau) - d->gammaPiPi));
+	}
+}
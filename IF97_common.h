@@ -130,6 +130,7 @@ typedef struct sctSteamState {  //-9999 if not applicable
 	double p_MPa;
 	double t_K;
 	double h_kJperkg;
+	double u_kJperkg;
 	double s_kJperkgK;
 	double Cv_kJperkgK;
 	double Cp_kJperkgK;
@@ -142,9 +143,59 @@ typedef struct sctSteamState {  //-9999 if not applicable
 } typSteamState;
 
 
+// ******** PROPERTY MASKS **************//
+/* bitwise selection of the properties wanted from a state evaluation.
+ * Only the free energy derivatives needed by the selected properties
+ * are calculated, so asking for less is cheaper.  The region props 
+ * functions (if97_r1_props etc.) set the selected properties only, and
+ * leave the others in the state untouched */
 
-	
-// ********COMMON FUNCTIONS**************//	
+	#define IF97_MASK_V   1    // specific volume (stored as density in typSteamState)
+	#define IF97_MASK_H   2    // specific enthalpy
+	#define IF97_MASK_U   4    // specific internal energy
+	#define IF97_MASK_S   8    // specific entropy
+	#define IF97_MASK_CP  16   // specific isobaric heat capacity
+	#define IF97_MASK_CV  32   // specific isochoric heat capacity
+	#define IF97_MASK_W   64   // speed of sound
+	#define IF97_MASK_ALL 127
+
+
+/* bitwise selection of the dimensionless free energy derivatives.
+ * For the Gibbs regions (1, 2 & 5) X is pi, for the Helmholtz region (3) X is delta.
+ * The region derivs functions (if97_r1_gibbs_derivs etc.) give those selected in a 
+ * single pass over the region's coefficients.  Each term needs only one pow() per 
+ * variable, and the lower powers of its derivatives follow from it by division */
+
+	#define IF97_D0     1   // gamma or phi
+	#define IF97_DX     2   // [d / d pi] or [d / d delta]
+	#define IF97_DXX    4   // [d2 / d pi2] or [d2 / d delta2]
+	#define IF97_DT     8   // [d / d tau]
+	#define IF97_DTT    16  // [d2 / d tau2]
+	#define IF97_DXT    32  // [d2 / d pi d tau] or [d2 / d delta d tau]
+
+
+typedef struct sctIF97GibbsDerivs {  // dimensionless Gibbs free energy and its derivatives
+	double gamma;
+	double gammaPi;
+	double gammaPiPi;
+	double gammaTau;
+	double gammaTauTau;
+	double gammaPiTau;
+} typIF97GibbsDerivs;
+
+
+typedef struct sctIF97HelmDerivs {  // dimensionless Helmholtz free energy and its derivatives
+	double phi;
+	double phiDelta;
+	double phiDeltaDelta;
+	double phiTau;
+	double phiTauTau;
+	double phiDeltaTau;
+} typIF97HelmDerivs;
+
+
+
+// ********COMMON FUNCTIONS**************//
 
 // squares a double without using pow
 double sqr (double dblArg);
@@ -152,6 +203,19 @@ double sqr (double dblArg);
 // cubes a double without using pow
 double cube (double dblArg);
 
+// sets every property of a steam state to -9999 (not applicable)
+void if97_clear_state (typSteamState *state);
+
+// free energy derivatives (IF97_D*) needed for the properties in iMask (IF97_MASK_*) in a Gibbs region
+int if97_gibbs_derivs_needed (int iMask);
+
+// free energy derivatives (IF97_D*) needed for the properties in iMask (IF97_MASK_*) in a Helmholtz region
+int if97_helm_derivs_needed (int iMask);
+
+/* fills the properties in iMask from the dimensionless Gibbs free energy derivatives.
+ * Common to regions 1, 2 and 5.  pi and tau are the reduced pressure and inverse temperature of the region */
+void if97_gibbs_props (double p_MPa, double t_K, double pi, double tau, const typIF97GibbsDerivs *d, int iMask, typSteamState *state);
+
 
 
 /* ********ERROR HANDLING**************
@@ -0,0 +1,717 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* ACCURACY AGAINST SPEED OF THE WAYS OF EVALUATING A PROPERTY
+*
+* The reference is the scalar if97_ path, which is first checked against the
+* IAPWS-IF97 check values used in IF97_Region*_test.c.  Every other way of
+* evaluating a property (a mode) is then compared with the reference over dense
+* grids in each region, along the region boundaries and the saturation line and
+* near the critical point.  For each mode, property and grid the maximum and RMS
+* relative errors and the calls per second are reported, as a table and as CSV,
+* followed by the modes on the Pareto front of speed against maximum error.
+*
+* To compare another way of evaluating (a table, a fit, a batch path) add it to
+* the list of modes in main with accAddMode.  To compare builds (compiler flags,
+* OpenMP on or off) run the harness from each build; the build is in the CSV.
+*
+* usage: if97_accuracy [csv file] [points per axis]
+*         defaults are if97_accuracy.csv and 60
+* returns 0, 1 if the reference fails a check value, 2 if the CSV cannot be written
+* *******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <float.h>
+#include <math.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#include "IF97_common.h"
+#include "IF97_B23.h"
+#include "IF97_Region4.h"
+#include "if97_lib.h"
+#include "winsteam_compatibility.h"
+
+
+#define ACC_CSVLOC "if97_accuracy.csv"
+#define ACC_POINTS 60  // default grid points per axis
+#define ACC_MAX_MODES 64
+#define ACC_MAX_ZONES 16
+#define ACC_MAX_RESULTS (ACC_MAX_MODES * (ACC_MAX_ZONES + 1))
+#define ACC_MIN_TIME_NS 2e7  // a mode is evaluated over a zone repeatedly for at least this long
+#define ACC_CHECK_TOL 1e-8  // relative error allowed against a check value (given to 9 figures)
+#define ACC_CHECK_TOL_R3 1e-5  // in region 3, where the density is from the backwards equations
+
+#define ACC_PT 0  // the input pairs
+#define ACC_PH 1
+#define ACC_PS 2
+
+
+// a set of points.  Each pair of inputs is made from the (p,T) of the point
+typedef struct sctAccZone {
+	char strName[32];
+	bool bPT;  // false if T does not fix the state (two phase).  Only (p,h) and (p,s) are then used
+	int n;
+	double *p_MPa;
+	double *t_K;
+	double *h_kJperkg;
+	double *s_kJperkgK;
+} typAccZone;
+
+
+// a way of evaluating a property, as a scalar function or a function of arrays
+typedef struct sctAccMode {
+	char strMode[40];
+	char strProperty[8];
+	int iPair;  // ACC_PT, ACC_PH or ACC_PS
+	double (*ref) (double, double);  // the reference.  NULL to compare with the temperature of the point
+	double (*scalar) (double, double);
+	void (*batch) (const double *, const double *, double *, int);
+} typAccMode;
+
+
+typedef struct sctAccResult {
+	const typAccMode *mode;
+	char strZone[32];
+	long lPoints;
+	long lCompared;  // points where neither gave an error code
+	long lMismatch;  // points where one gave an error code and the other did not
+	double dblMaxErr;
+	double dblSumSqErr;
+	double dblWorstIn1;
+	double dblWorstIn2;
+	double dblCalls;
+	double dblNs;
+} typAccResult;
+
+
+typAccMode modes[ACC_MAX_MODES];
+int numModes = 0;
+typAccZone zones[ACC_MAX_ZONES];
+int numZones = 0;
+typAccResult results[ACC_MAX_RESULTS];
+int numResults = 0;
+char strBuild[80];
+
+
+
+// ***************** TIMING *********************
+
+// a monotonic time in ns
+double accNow (void){
+#ifdef _WIN32
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double) count.QuadPart * 1e9 / (double) freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#endif
+}
+
+
+// the compiler and OpenMP settings, to tell the CSV of one build from another
+void accDescribeBuild (void){
+#if defined(__VERSION__)
+	const char *strCompiler = __VERSION__;
+#elif defined(_MSC_VER)
+	const char *strCompiler = "msvc";
+#else
+	const char *strCompiler = "unknown compiler";
+#endif
+#if defined(__OPTIMIZE__)
+	const char *strOpt = "optimised";
+#else
+	const char *strOpt = "not optimised";
+#endif
+#ifdef _OPENMP
+	snprintf(strBuild, sizeof(strBuild), "%s %s OpenMP %i threads", strCompiler, strOpt, omp_get_max_threads());
+#else
+	snprintf(strBuild, sizeof(strBuild), "%s %s no OpenMP", strCompiler, strOpt);
+#endif
+}
+
+
+
+// ***************** ZONES *********************
+
+typAccZone *accNewZone (const char *strName, bool bPT, int iCapacity){
+	typAccZone *zone;
+
+	if (numZones >= ACC_MAX_ZONES) return NULL;
+	zone = &zones[numZones];
+	snprintf(zone->strName, sizeof(zone->strName), "%s", strName);
+	zone->bPT = bPT;
+	zone->n = 0;
+	zone->p_MPa = malloc(iCapacity * sizeof(double));
+	zone->t_K = malloc(iCapacity * sizeof(double));
+	zone->h_kJperkg = malloc(iCapacity * sizeof(double));
+	zone->s_kJperkgK = malloc(iCapacity * sizeof(double));
+	if ((zone->p_MPa == NULL) || (zone->t_K == NULL) || (zone->h_kJperkg == NULL) || (zone->s_kJperkgK == NULL)) return NULL;
+	numZones++;
+	return zone;
+}
+
+
+// adds a single phase point, if it is in a valid region
+void accAddPT (typAccZone *zone, double p_MPa, double t_K){
+	if (region_pt(p_MPa, t_K) == 0) return;
+	zone->p_MPa[zone->n] = p_MPa;
+	zone->t_K[zone->n] = t_K;
+	zone->h_kJperkg[zone->n] = if97_pt_h(p_MPa, t_K);
+	zone->s_kJperkgK[zone->n] = if97_pt_s(p_MPa, t_K);
+	zone->n++;
+}
+
+
+// a grid over one region, with pressures spaced logarithmically if bLogP
+void accFillRegion (int iRegion, const char *strName, double dblPLow, double dblPHigh, bool bLogP,
+		double dblTLow, double dblTHigh, int iPoints){
+	typAccZone *zone = accNewZone(strName, true, iPoints * iPoints);
+	double p_MPa, t_K;
+	int i, j;
+
+	if (zone == NULL) return;
+	for (i = 0; i < iPoints; i++) {
+		p_MPa = bLogP ? dblPLow * pow(dblPHigh / dblPLow, (double) i / (iPoints - 1))
+				: dblPLow + (dblPHigh - dblPLow) * i / (iPoints - 1);
+		for (j = 0; j < iPoints; j++) {
+			t_K = dblTLow + (dblTHigh - dblTLow) * j / (iPoints - 1);
+			if (region_pt(p_MPa, t_K) == iRegion) accAddPT(zone, p_MPa, t_K);
+		}
+	}
+}
+
+
+// offsets from a boundary, K or relative pressure, on either side
+const double ACC_OFFSETS[6] = {-1.0, -0.1, -1e-3, 1e-3, 0.1, 1.0};
+
+
+void accFillBoundaries (int iPoints){
+	typAccZone *zone;
+	double p_MPa, t_K, ts_K;
+	int i, j;
+
+	// just either side of the saturation line, up to near the critical point
+	if ((zone = accNewZone("saturation line", true, 6 * iPoints)) != NULL)
+		for (i = 0; i < iPoints; i++) {
+			p_MPa = 0.001 * pow(22.0 / 0.001, (double) i / (iPoints - 1));
+			ts_K = if97_r4_ts(p_MPa);
+			for (j = 0; j < 6; j++) accAddPT(zone, p_MPa, ts_K + ACC_OFFSETS[j]);
+		}
+
+	// either side of the boundary between regions 2 and 3
+	if ((zone = accNewZone("B23 boundary", true, 6 * iPoints)) != NULL)
+		for (i = 0; i < iPoints; i++) {
+			t_K = IF97_B23_LTEMP + (IF97_B23_UTEMP - IF97_B23_LTEMP) * i / (iPoints - 1);
+			for (j = 0; j < 6; j++) accAddPT(zone, IF97_B23P(t_K) * (1.0 + 0.01 * ACC_OFFSETS[j]), t_K);
+		}
+
+	// either side of 623.15 K, between regions 1 and 3
+	if ((zone = accNewZone("623.15 K boundary", true, 6 * iPoints)) != NULL)
+		for (i = 0; i < iPoints; i++) {
+			p_MPa = if97_r4_ps(IF97_R1_UTEMP) + 0.01 + (IF97_R1_UPRESS - if97_r4_ps(IF97_R1_UTEMP) - 0.01) * i / (iPoints - 1);
+			for (j = 0; j < 6; j++) accAddPT(zone, p_MPa, IF97_R1_UTEMP + ACC_OFFSETS[j]);
+		}
+
+	// either side of 1073.15 K, between regions 2 and 5
+	if ((zone = accNewZone("1073.15 K boundary", true, 6 * iPoints)) != NULL)
+		for (i = 0; i < iPoints; i++) {
+			p_MPa = 0.001 * pow(IF97_R5_UPRESS / 0.001, (double) i / (iPoints - 1));
+			for (j = 0; j < 6; j++) accAddPT(zone, p_MPa, IF97_R2_UTEMP + ACC_OFFSETS[j]);
+		}
+}
+
+
+// a grid around the critical point, where region 3 needs iteration
+void accFillNearCritical (int iPoints){
+	typAccZone *zone = accNewZone("near critical", true, iPoints * iPoints);
+	int i, j;
+
+	if (zone == NULL) return;
+	for (i = 0; i < iPoints; i++)
+		for (j = 0; j < iPoints; j++)
+			accAddPT(zone, 21.0 + 3.0 * i / (iPoints - 1), 640.0 + 15.0 * j / (iPoints - 1));
+}
+
+
+// a grid of pressure and quality in the wet region, for (p,h) and (p,s) only
+void accFillTwoPhase (int iPoints){
+	typAccZone *zone = accNewZone("two phase", false, iPoints * iPoints);
+	typSteamState liq, vap;
+	double p_MPa, ts_K, dblQual;
+	int i, j;
+
+	if (zone == NULL) return;
+	for (i = 0; i < iPoints; i++) {
+		p_MPa = 0.001 * pow(22.0 / 0.001, (double) i / (iPoints - 1));
+		ts_K = if97_r4_ts(p_MPa);
+		sat_props(p_MPa, ts_K, false, IF97_MASK_H | IF97_MASK_S, &liq);
+		sat_props(p_MPa, ts_K, true, IF97_MASK_H | IF97_MASK_S, &vap);
+		for (j = 1; j < iPoints - 1; j++) {
+			dblQual = (double) j / (iPoints - 1);
+			zone->p_MPa[zone->n] = p_MPa;
+			zone->t_K[zone->n] = ts_K;
+			zone->h_kJperkg[zone->n] = liq.h_kJperkg + dblQual * (vap.h_kJperkg - liq.h_kJperkg);
+			zone->s_kJperkgK[zone->n] = liq.s_kJperkgK + dblQual * (vap.s_kJperkgK - liq.s_kJperkgK);
+			zone->n++;
+		}
+	}
+}
+
+
+
+// the error codes of if97_lib (-9998, -9999) and of the winsteam functions (DBL_MIN)
+bool accIsError (double dblValue){
+	return (dblValue == -9998.0) || (dblValue == -9999.0) || (dblValue == DBL_MIN) || (dblValue == DBL_MIN + 1.0) || !isfinite(dblValue);
+}
+
+
+
+// ***************** MODES *********************
+
+void accAddMode (const char *strMode, const char *strProperty, int iPair, double (*ref) (double, double),
+		double (*scalar) (double, double), void (*batch) (const double *, const double *, double *, int)){
+	typAccMode *mode;
+
+	if (numModes >= ACC_MAX_MODES) return;
+	mode = &modes[numModes++];
+	snprintf(mode->strMode, sizeof(mode->strMode), "%s", strMode);
+	snprintf(mode->strProperty, sizeof(mode->strProperty), "%s", strProperty);
+	mode->iPair = iPair;
+	mode->ref = ref;
+	mode->scalar = scalar;
+	mode->batch = batch;
+}
+
+
+// the state functions, asking only for the property wanted
+double acc_pt_mask_h (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_H).h_kJperkg;}
+double acc_pt_mask_s (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_S).s_kJperkgK;}
+double acc_pt_mask_Cp (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_CP).Cp_kJperkgK;}
+double acc_pt_mask_w (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_W).Vs_MperSec;}
+double acc_pt_mask_v (double p_MPa, double t_K) {
+	double dblRho = if97_pt_state_mask(p_MPa, t_K, IF97_MASK_V).rho_kgperM3;
+	return (dblRho > 0.0) ? 1.0 / dblRho : dblRho;
+}
+
+double acc_ph_mask_t (double p_MPa, double h_kJperkg) {return if97_ph_state_mask(p_MPa, h_kJperkg, 0).t_K;}
+double acc_ph_mask_s (double p_MPa, double h_kJperkg) {return if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_S).s_kJperkgK;}
+double acc_ph_mask_v (double p_MPa, double h_kJperkg) {
+	double dblRho = if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_V).rho_kgperM3;
+	return (dblRho > 0.0) ? 1.0 / dblRho : dblRho;
+}
+
+double acc_ps_mask_t (double p_MPa, double s_kJperkgK) {return if97_ps_state_mask(p_MPa, s_kJperkgK, 0).t_K;}
+double acc_ps_mask_h (double p_MPa, double s_kJperkgK) {return if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_H).h_kJperkg;}
+double acc_ps_mask_v (double p_MPa, double s_kJperkgK) {
+	double dblRho = if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_V).rho_kgperM3;
+	return (dblRho > 0.0) ? 1.0 / dblRho : dblRho;
+}
+
+
+// the winsteam compatible functions in SI (bar, C, kJ/kg), through a unit set handle
+const typStmUnitSet *accUnitSet = NULL;
+double acc_StmPTH_u (double p_MPa, double t_K) {return StmPTH_u(10.0 * p_MPa, t_K - 273.15, accUnitSet);}
+double acc_StmPTS_u (double p_MPa, double t_K) {return StmPTS_u(10.0 * p_MPa, t_K - 273.15, accUnitSet);}
+double acc_StmPTV_u (double p_MPa, double t_K) {return StmPTV_u(10.0 * p_MPa, t_K - 273.15, accUnitSet);}
+double acc_StmPTC_u (double p_MPa, double t_K) {return StmPTC_u(10.0 * p_MPa, t_K - 273.15, accUnitSet);}
+double acc_StmPTW_u (double p_MPa, double t_K) {return StmPTW_u(10.0 * p_MPa, t_K - 273.15, accUnitSet);}
+
+
+/* the winsteam compatible array functions in SI, shared between threads by OpenMP.
+ * The inputs are converted to bar and C, and temperatures back to K */
+void accStmArray (void (*func) (const double *, const double *, double *, int, char *),
+		const double *p_MPa, const double *in2, double *out, int n, bool bTempIn, bool bTempOut){
+	double *p_bar = malloc(n * sizeof(double));
+	double *in2SI = malloc(n * sizeof(double));
+	int i;
+
+	if ((p_bar == NULL) || (in2SI == NULL))
+		for (i = 0; i < n; i++) out[i] = -9999.0;
+	else {
+		for (i = 0; i < n; i++) {
+			p_bar[i] = 10.0 * p_MPa[i];
+			in2SI[i] = bTempIn ? in2[i] - 273.15 : in2[i];
+		}
+		func(p_bar, in2SI, out, n, "SI");
+		if (bTempOut)
+			for (i = 0; i < n; i++)
+				if (!accIsError(out[i])) out[i] += 273.15;
+	}
+	free(p_bar);
+	free(in2SI);
+}
+
+void acc_StmPTH_n (const double *p, const double *t, double *out, int n) {accStmArray(StmPTH_n, p, t, out, n, true, false);}
+void acc_StmPTS_n (const double *p, const double *t, double *out, int n) {accStmArray(StmPTS_n, p, t, out, n, true, false);}
+void acc_StmPTV_n (const double *p, const double *t, double *out, int n) {accStmArray(StmPTV_n, p, t, out, n, true, false);}
+void acc_StmPTC_n (const double *p, const double *t, double *out, int n) {accStmArray(StmPTC_n, p, t, out, n, true, false);}
+void acc_StmPTW_n (const double *p, const double *t, double *out, int n) {accStmArray(StmPTW_n, p, t, out, n, true, false);}
+void acc_StmPHT_n (const double *p, const double *h, double *out, int n) {accStmArray(StmPHT_n, p, h, out, n, false, true);}
+void acc_StmPHS_n (const double *p, const double *h, double *out, int n) {accStmArray(StmPHS_n, p, h, out, n, false, false);}
+void acc_StmPHV_n (const double *p, const double *h, double *out, int n) {accStmArray(StmPHV_n, p, h, out, n, false, false);}
+void acc_StmPST_n (const double *p, const double *s, double *out, int n) {accStmArray(StmPST_n, p, s, out, n, false, true);}
+void acc_StmPSH_n (const double *p, const double *s, double *out, int n) {accStmArray(StmPSH_n, p, s, out, n, false, false);}
+void acc_StmPSV_n (const double *p, const double *s, double *out, int n) {accStmArray(StmPSV_n, p, s, out, n, false, false);}
+
+
+
+// ***************** COMPARING *********************
+
+/* the value below which errors are taken as absolute rather than relative, for
+ * properties which pass through zero (h and s of liquid near the triple point) */
+double accFloor (const char *strProperty){
+	if (strcmp(strProperty, "h") == 0) return 1.0;  // kJ/kg
+	if (strcmp(strProperty, "s") == 0) return 1e-2;  // kJ/kg.K
+	return 0.0;
+}
+
+
+// evaluates a mode over n points
+void accEvaluate (const typAccMode *mode, const double *in1, const double *in2, double *out, int n){
+	int i;
+
+	if (mode->batch != NULL) {
+		mode->batch(in1, in2, out, n);
+		return;
+	}
+	for (i = 0; i < n; i++) out[i] = mode->scalar(in1[i], in2[i]);
+}
+
+
+// compares a mode with the reference over a zone, timing it, and keeps the result
+void accRun (const typAccMode *mode, const typAccZone *zone){
+	const double *in2 = (mode->iPair == ACC_PH) ? zone->h_kJperkg : (mode->iPair == ACC_PS) ? zone->s_kJperkgK : zone->t_K;
+	double *out, dblRef, dblErr, dblStart, dblNs, dblFloor = accFloor(mode->strProperty);
+	long lCalls = 0;
+	typAccResult *res;
+	int i;
+
+	if ((numResults >= ACC_MAX_RESULTS) || (zone->n == 0) || ((mode->iPair == ACC_PT) && !zone->bPT)) return;
+	out = malloc(zone->n * sizeof(double));
+	if (out == NULL) return;
+
+	dblStart = accNow();
+	do {
+		accEvaluate(mode, zone->p_MPa, in2, out, zone->n);
+		lCalls += zone->n;
+		dblNs = accNow() - dblStart;
+	} while (dblNs < ACC_MIN_TIME_NS);
+
+	res = &results[numResults++];
+	memset(res, 0, sizeof(typAccResult));
+	res->mode = mode;
+	snprintf(res->strZone, sizeof(res->strZone), "%s", zone->strName);
+	res->lPoints = zone->n;
+	res->dblCalls = (double) lCalls;
+	res->dblNs = dblNs;
+
+	for (i = 0; i < zone->n; i++) {
+		dblRef = (mode->ref != NULL) ? mode->ref(zone->p_MPa[i], in2[i]) : zone->t_K[i];
+		if (accIsError(dblRef) || accIsError(out[i])) {
+			if (accIsError(dblRef) != accIsError(out[i])) res->lMismatch++;
+			continue;
+		}
+		dblErr = fabs(out[i] - dblRef) / fmax(fabs(dblRef), dblFloor);
+		res->lCompared++;
+		res->dblSumSqErr += dblErr * dblErr;
+		if (dblErr > res->dblMaxErr) {
+			res->dblMaxErr = dblErr;
+			res->dblWorstIn1 = zone->p_MPa[i];
+			res->dblWorstIn2 = in2[i];
+		}
+	}
+	free(out);
+}
+
+
+// sums the results of a mode over all zones into one with the zone "all".  NULL if there are none
+const typAccResult *accSumZones (const typAccMode *mode){
+	typAccResult sum;
+	int i;
+
+	memset(&sum, 0, sizeof(typAccResult));
+	sum.mode = mode;
+	strcpy(sum.strZone, "all");
+	for (i = 0; i < numResults; i++) {
+		if (results[i].mode != mode) continue;
+		sum.lPoints += results[i].lPoints;
+		sum.lCompared += results[i].lCompared;
+		sum.lMismatch += results[i].lMismatch;
+		sum.dblSumSqErr += results[i].dblSumSqErr;
+		sum.dblCalls += results[i].dblCalls;
+		sum.dblNs += results[i].dblNs;
+		if (results[i].dblMaxErr >= sum.dblMaxErr) {
+			sum.dblMaxErr = results[i].dblMaxErr;
+			sum.dblWorstIn1 = results[i].dblWorstIn1;
+			sum.dblWorstIn2 = results[i].dblWorstIn2;
+		}
+	}
+	if ((sum.lPoints == 0) || (numResults >= ACC_MAX_RESULTS)) return NULL;
+	results[numResults] = sum;
+	return &results[numResults++];
+}
+
+
+
+// ***************** REPORTING *********************
+
+const char *ACC_PAIRS[3] = {"p,T", "p,h", "p,s"};
+
+double accRms (const typAccResult *res){
+	return (res->lCompared > 0) ? sqrt(res->dblSumSqErr / res->lCompared) : 0.0;
+}
+
+double accCallsPerSec (const typAccResult *res){
+	return (res->dblNs > 0.0) ? 1e9 * res->dblCalls / res->dblNs : 0.0;
+}
+
+
+void accPrintResult (const typAccResult *res){
+	printf("%-28s %-4s %-3s %-20s %7li %8li %11.3e %11.3e %12.0f\n", res->mode->strMode, ACC_PAIRS[res->mode->iPair],
+			res->mode->strProperty, res->strZone, res->lCompared, res->lMismatch, res->dblMaxErr, accRms(res), accCallsPerSec(res));
+	fflush(stdout);
+}
+
+
+int accWriteCsv (const char *strFile){
+	FILE *out = fopen(strFile, "w");
+	int i;
+
+	if (out == NULL) return 1;
+	fprintf(out, "mode,pair,property,zone,points,compared,mismatches,max_rel_err,rms_rel_err,worst_in1,worst_in2,calls_per_sec,build\n");
+	for (i = 0; i < numResults; i++)
+		fprintf(out, "\"%s\",\"%s\",%s,\"%s\",%li,%li,%li,%.6e,%.6e,%.10g,%.10g,%.0f,\"%s\"\n",
+				results[i].mode->strMode, ACC_PAIRS[results[i].mode->iPair], results[i].mode->strProperty, results[i].strZone,
+				results[i].lPoints, results[i].lCompared, results[i].lMismatch, results[i].dblMaxErr, accRms(&results[i]),
+				results[i].dblWorstIn1, results[i].dblWorstIn2, accCallsPerSec(&results[i]), strBuild);
+	fclose(out);
+	return 0;
+}
+
+
+/* for each property, the modes not beaten on both speed and maximum error by another
+ * (over all zones, and with no mismatched error codes) */
+void accPrintPareto (void){
+	const typAccResult *a, *b;
+	bool bDominated;
+	int i, j;
+
+	printf("\nPareto front (over all zones)\n");
+	printf("%-28s %-4s %-3s %11s %11s %12s\n", "mode", "pair", "", "max err", "rms err", "calls/s");
+	for (i = 0; i < numResults; i++) {
+		a = &results[i];
+		if ((strcmp(a->strZone, "all") != 0) || (a->mode->ref == NULL) || (a->lMismatch > 0)) continue;
+		bDominated = false;
+		for (j = 0; (j < numResults) && !bDominated; j++) {
+			b = &results[j];
+			if ((j == i) || (strcmp(b->strZone, "all") != 0) || (b->mode->ref == NULL) || (b->lMismatch > 0)
+					|| (b->mode->iPair != a->mode->iPair) || (strcmp(b->mode->strProperty, a->mode->strProperty) != 0)) continue;
+			bDominated = (b->dblMaxErr <= a->dblMaxErr) && (accCallsPerSec(b) >= accCallsPerSec(a))
+					&& ((b->dblMaxErr < a->dblMaxErr) || (accCallsPerSec(b) > accCallsPerSec(a)));
+		}
+		if (!bDominated)
+			printf("%-28s %-4s %-3s %11.3e %11.3e %12.0f\n", a->mode->strMode, ACC_PAIRS[a->mode->iPair],
+					a->mode->strProperty, a->dblMaxErr, accRms(a), accCallsPerSec(a));
+	}
+}
+
+
+
+// ***************** CHECK VALUES *********************
+
+typedef struct sctAccCheck {
+	const char *strFunc;
+	double (*func) (double, double);
+	double dblIn1;
+	double dblIn2;
+	double dblExpected;
+	double dblTol;
+} typAccCheck;
+
+double acc_Ps_t (double p_MPa, double dummy) {return if97_Ps_t(p_MPa);}
+double acc_Ts_p (double t_K, double dummy) {return if97_Ts_p(t_K);}
+
+
+/* the IAPWS-IF97 check values of IF97_Region*_test.c, through the if97_pt_ functions.
+ * Region 3 is checked at the pressures of its (rho,T) check values.  Away from the
+ * critical point the density is then from the backwards equations, which are allowed
+ * a relative error of 1e-5 in v */
+const typAccCheck ACC_CHECKS[] = {
+	{"if97_pt_v", if97_pt_v, 3.0, 300.0, 1.00215168e-3, ACC_CHECK_TOL},
+	{"if97_pt_v", if97_pt_v, 80.0, 300.0, 9.71180894e-4, ACC_CHECK_TOL},
+	{"if97_pt_v", if97_pt_v, 3.0, 500.0, 1.20241800e-3, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 3.0, 300.0, 1.15331273e2, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 80.0, 300.0, 1.84142828e2, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 3.0, 500.0, 9.75542239e2, ACC_CHECK_TOL},
+	{"if97_pt_u", if97_pt_u, 3.0, 300.0, 1.12324818e2, ACC_CHECK_TOL},
+	{"if97_pt_s", if97_pt_s, 3.0, 300.0, 3.92294792e-1, ACC_CHECK_TOL},
+	{"if97_pt_s", if97_pt_s, 3.0, 500.0, 2.58041912e0, ACC_CHECK_TOL},
+	{"if97_pt_Cp", if97_pt_Cp, 3.0, 300.0, 4.17301218e0, ACC_CHECK_TOL},
+	{"if97_pt_Cp", if97_pt_Cp, 80.0, 300.0, 4.01008987e0, ACC_CHECK_TOL},
+	{"if97_pt_Vs", if97_pt_Vs, 3.0, 300.0, 1.50773921e3, ACC_CHECK_TOL},
+	{"if97_pt_Vs", if97_pt_Vs, 3.0, 500.0, 1.24071337e3, ACC_CHECK_TOL},
+
+	{"if97_pt_v", if97_pt_v, 0.0035, 300.0, 3.94913866e01, ACC_CHECK_TOL},
+	{"if97_pt_v", if97_pt_v, 30.0, 700.0, 5.42946619e-3, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 0.0035, 300.0, 2.54991145e03, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 0.0035, 700.0, 3.33568375e03, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 30.0, 700.0, 2.63149474e03, ACC_CHECK_TOL},
+	{"if97_pt_u", if97_pt_u, 30.0, 700.0, 2.46861076e03, ACC_CHECK_TOL},
+	{"if97_pt_s", if97_pt_s, 0.0035, 700.0, 1.01749996e01, ACC_CHECK_TOL},
+	{"if97_pt_Cp", if97_pt_Cp, 30.0, 700.0, 1.03505092e01, ACC_CHECK_TOL},
+	{"if97_pt_Vs", if97_pt_Vs, 0.0035, 300.0, 4.27920172e02, ACC_CHECK_TOL},
+	{"if97_pt_Vs", if97_pt_Vs, 30.0, 700.0, 4.80386523e02, ACC_CHECK_TOL},
+
+	{"if97_pt_v", if97_pt_v, 2.55837018e01, 650.0, 1.0 / 500.0, ACC_CHECK_TOL_R3},
+	{"if97_pt_v", if97_pt_v, 2.22930643e01, 650.0, 1.0 / 200.0, ACC_CHECK_TOL_R3},
+	{"if97_pt_v", if97_pt_v, 7.83095639e01, 750.0, 1.0 / 500.0, ACC_CHECK_TOL_R3},
+	{"if97_pt_h", if97_pt_h, 2.55837018e01, 650.0, 1.86343019e03, ACC_CHECK_TOL_R3},
+	{"if97_pt_h", if97_pt_h, 2.22930643e01, 650.0, 2.37512401e03, ACC_CHECK_TOL_R3},
+	{"if97_pt_h", if97_pt_h, 7.83095639e01, 750.0, 2.25868845e03, ACC_CHECK_TOL_R3},
+	{"if97_pt_s", if97_pt_s, 2.55837018e01, 650.0, 4.05427273e00, ACC_CHECK_TOL_R3},
+	{"if97_pt_Vs", if97_pt_Vs, 7.83095639e01, 750.0, 7.60696041e02, ACC_CHECK_TOL_R3},
+
+	{"if97_Ts_p", acc_Ts_p, 300.0, 0.0, 0.353658941e-2, ACC_CHECK_TOL},
+	{"if97_Ts_p", acc_Ts_p, 500.0, 0.0, 0.263889776e1, ACC_CHECK_TOL},
+	{"if97_Ts_p", acc_Ts_p, 600.0, 0.0, 0.123443146e2, ACC_CHECK_TOL},
+	{"if97_Ps_t", acc_Ps_t, 0.1, 0.0, 0.372755919E3, ACC_CHECK_TOL},
+	{"if97_Ps_t", acc_Ps_t, 1.0, 0.0, 0.453035632E3, ACC_CHECK_TOL},
+	{"if97_Ps_t", acc_Ps_t, 10.0, 0.0, 0.584149488E3, ACC_CHECK_TOL},
+
+	{"if97_pt_v", if97_pt_v, 0.5, 1500.0, 1.38455090e00, ACC_CHECK_TOL},
+	{"if97_pt_v", if97_pt_v, 30.0, 2000.0, 3.11385219e-02, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 0.5, 1500.0, 5.21976855e03, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 30.0, 1500.0, 5.16723514e03, ACC_CHECK_TOL},
+	{"if97_pt_h", if97_pt_h, 30.0, 2000.0, 6.57122604e03, ACC_CHECK_TOL},
+	{"if97_pt_s", if97_pt_s, 30.0, 2000.0, 8.536405231138, ACC_CHECK_TOL},
+	{"if97_pt_Cp", if97_pt_Cp, 0.5, 1500.0, 2.61609445e00, ACC_CHECK_TOL}
+};
+
+
+// checks the reference path.  Returns the number of check values it fails
+int accCheckReference (void){
+	const int numChecks = sizeof(ACC_CHECKS) / sizeof(ACC_CHECKS[0]);
+	double dblResult, dblErr;
+	int i, iFails = 0;
+
+	printf("Reference checked against the IAPWS-IF97 check values\n");
+	for (i = 0; i < numChecks; i++) {
+		dblResult = ACC_CHECKS[i].func(ACC_CHECKS[i].dblIn1, ACC_CHECKS[i].dblIn2);
+		dblErr = fabs(dblResult - ACC_CHECKS[i].dblExpected) / fabs(ACC_CHECKS[i].dblExpected);
+		if (!(dblErr <= ACC_CHECKS[i].dblTol)) {
+			iFails++;
+			printf("    FAIL %s (%g, %g) = %.9g  expected %.9g  relative error %.3e\n", ACC_CHECKS[i].strFunc,
+					ACC_CHECKS[i].dblIn1, ACC_CHECKS[i].dblIn2, dblResult, ACC_CHECKS[i].dblExpected, dblErr);
+		}
+	}
+	printf("%i of %i check values passed\n\n", numChecks - iFails, numChecks);
+	return iFails;
+}
+
+
+
+int main (int argc, char **argv){
+	const char *strCsv = (argc > 1) ? argv[1] : ACC_CSVLOC;
+	int iPoints = (argc > 2) ? atoi(argv[2]) : ACC_POINTS;
+	const typAccResult *sum;
+	int iFails, i, j;
+
+	if (iPoints < 3) iPoints = ACC_POINTS;
+	accDescribeBuild();
+	printf("if97_accuracy: %s\n\n", strBuild);
+
+	iFails = accCheckReference();
+
+	// the zones
+	accFillRegion(1, "region 1", 0.001, IF97_R1_UPRESS, true, IF97_R1_LTEMP, IF97_R1_UTEMP, iPoints);
+	accFillRegion(2, "region 2", 0.001, IF97_R2_UPRESS, true, IF97_R1_LTEMP, IF97_R2_UTEMP, iPoints);
+	accFillRegion(3, "region 3", IF97_B23_LPRESS, IF97_R3_UPRESS, false, IF97_R3_LTEMP, IF97_B23_UTEMP, iPoints);
+	accFillRegion(5, "region 5", 0.001, IF97_R5_UPRESS, true, IF97_R5_LTEMP, IF97_R5_UTEMP, iPoints);
+	accFillBoundaries(iPoints);
+	accFillNearCritical(iPoints);
+	accFillTwoPhase(iPoints);
+
+	// the modes.  The reference itself is run to give its speed
+	accUnitSet = StmUnitSetOpen("SI");
+
+	accAddMode("if97_pt_ (reference)", "h", ACC_PT, if97_pt_h, if97_pt_h, NULL);
+	accAddMode("if97_pt_state_mask", "h", ACC_PT, if97_pt_h, acc_pt_mask_h, NULL);
+	accAddMode("StmPTH_u SI", "h", ACC_PT, if97_pt_h, acc_StmPTH_u, NULL);
+	accAddMode("StmPTH_n SI", "h", ACC_PT, if97_pt_h, NULL, acc_StmPTH_n);
+	accAddMode("if97_pt_ (reference)", "v", ACC_PT, if97_pt_v, if97_pt_v, NULL);
+	accAddMode("if97_pt_state_mask", "v", ACC_PT, if97_pt_v, acc_pt_mask_v, NULL);
+	accAddMode("StmPTV_u SI", "v", ACC_PT, if97_pt_v, acc_StmPTV_u, NULL);
+	accAddMode("StmPTV_n SI", "v", ACC_PT, if97_pt_v, NULL, acc_StmPTV_n);
+	accAddMode("if97_pt_ (reference)", "s", ACC_PT, if97_pt_s, if97_pt_s, NULL);
+	accAddMode("if97_pt_state_mask", "s", ACC_PT, if97_pt_s, acc_pt_mask_s, NULL);
+	accAddMode("StmPTS_u SI", "s", ACC_PT, if97_pt_s, acc_StmPTS_u, NULL);
+	accAddMode("StmPTS_n SI", "s", ACC_PT, if97_pt_s, NULL, acc_StmPTS_n);
+	accAddMode("if97_pt_ (reference)", "Cp", ACC_PT, if97_pt_Cp, if97_pt_Cp, NULL);
+	accAddMode("if97_pt_state_mask", "Cp", ACC_PT, if97_pt_Cp, acc_pt_mask_Cp, NULL);
+	accAddMode("StmPTC_u SI", "Cp", ACC_PT, if97_pt_Cp, acc_StmPTC_u, NULL);
+	accAddMode("StmPTC_n SI", "Cp", ACC_PT, if97_pt_Cp, NULL, acc_StmPTC_n);
+	accAddMode("if97_pt_ (reference)", "w", ACC_PT, if97_pt_Vs, if97_pt_Vs, NULL);
+	accAddMode("if97_pt_state_mask", "w", ACC_PT, if97_pt_Vs, acc_pt_mask_w, NULL);
+	accAddMode("StmPTW_u SI", "w", ACC_PT, if97_pt_Vs, acc_StmPTW_u, NULL);
+	accAddMode("StmPTW_n SI", "w", ACC_PT, if97_pt_Vs, NULL, acc_StmPTW_n);
+
+	// the backwards paths against the temperature each point was made from
+	accAddMode("if97_ph_t round trip", "T", ACC_PH, NULL, if97_ph_t, NULL);
+	accAddMode("if97_ps_t round trip", "T", ACC_PS, NULL, if97_ps_t, NULL);
+
+	accAddMode("if97_ph_ (reference)", "T", ACC_PH, if97_ph_t, if97_ph_t, NULL);
+	accAddMode("if97_ph_state_mask", "T", ACC_PH, if97_ph_t, acc_ph_mask_t, NULL);
+	accAddMode("StmPHT_n SI", "T", ACC_PH, if97_ph_t, NULL, acc_StmPHT_n);
+	accAddMode("if97_ph_ (reference)", "v", ACC_PH, if97_ph_v, if97_ph_v, NULL);
+	accAddMode("if97_ph_state_mask", "v", ACC_PH, if97_ph_v, acc_ph_mask_v, NULL);
+	accAddMode("StmPHV_n SI", "v", ACC_PH, if97_ph_v, NULL, acc_StmPHV_n);
+	accAddMode("if97_ph_ (reference)", "s", ACC_PH, if97_ph_s, if97_ph_s, NULL);
+	accAddMode("if97_ph_state_mask", "s", ACC_PH, if97_ph_s, acc_ph_mask_s, NULL);
+	accAddMode("StmPHS_n SI", "s", ACC_PH, if97_ph_s, NULL, acc_StmPHS_n);
+
+	accAddMode("if97_ps_ (reference)", "T", ACC_PS, if97_ps_t, if97_ps_t, NULL);
+	accAddMode("if97_ps_state_mask", "T", ACC_PS, if97_ps_t, acc_ps_mask_t, NULL);
+	accAddMode("StmPST_n SI", "T", ACC_PS, if97_ps_t, NULL, acc_StmPST_n);
+	accAddMode("if97_ps_ (reference)", "h", ACC_PS, if97_ps_h, if97_ps_h, NULL);
+	accAddMode("if97_ps_state_mask", "h", ACC_PS, if97_ps_h, acc_ps_mask_h, NULL);
+	accAddMode("StmPSH_n SI", "h", ACC_PS, if97_ps_h, NULL, acc_StmPSH_n);
+	accAddMode("if97_ps_ (reference)", "v", ACC_PS, if97_ps_v, if97_ps_v, NULL);
+	accAddMode("if97_ps_state_mask", "v", ACC_PS, if97_ps_v, acc_ps_mask_v, NULL);
+	accAddMode("StmPSV_n SI", "v", ACC_PS, if97_ps_v, NULL, acc_StmPSV_n);
+
+	printf("%-28s %-4s %-3s %-20s %7s %8s %11s %11s %12s\n", "mode", "pair", "", "zone", "points", "mismatch", "max err", "rms err", "calls/s");
+	for (i = 0; i < numModes; i++) {
+		for (j = 0; j < numZones; j++) accRun(&modes[i], &zones[j]);
+		if ((sum = accSumZones(&modes[i])) != NULL) accPrintResult(sum);
+	}
+
+	accPrintPareto();
+
+	if (accWriteCsv(strCsv) != 0) {
+		fprintf(stderr, "if97_accuracy: cannot write %s\n", strCsv);
+		return 2;
+	}
+	printf("\nResults for each zone written to %s\n", strCsv);
+	return (iFails > 0) ? 1 : 0;
+}
@@ -0,0 +1,736 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* MICROBENCHMARKS OF THE REGION KERNELS, THE DISPATCHERS AND THE WRAPPERS
+*
+* Each function is called on a fixed set of inputs drawn from a distribution for
+* its region, cycling through them.  Calls are timed in batches; each batch gives
+* one latency sample (batch time / calls in the batch), from which the median and
+* 99th percentile are taken.  The results are printed as a table and written as
+* JSON, with the compiler and OpenMP settings, so that builds can be compared.
+*
+* usage: if97_bench [json file] [samples per function]
+*         defaults are if97_bench.json and 2000
+* *******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#include "IF97_common.h"
+#include "IF97_Region1.h"
+#include "IF97_Region2.h"
+#include "IF97_Region3.h"
+#include "IF97_Region3bw.h"
+#include "IF97_Region4.h"
+#include "IF97_Region5.h"
+#include "if97_lib.h"
+#include "if97_warm.h"
+#include "if97_flash.h"
+#include "if97_sbtl.h"
+#include "if97_ttse.h"
+#include "if97_compact.h"
+#include "if97_quad.h"
+#include "solve.h"
+#include "units.h"
+#include "winsteam_compatibility.h"
+
+
+#ifndef M_PI
+	#define M_PI 3.14159265358979323846
+#endif
+
+#define BENCH_JSONLOC "if97_bench.json"
+#define BENCH_POINTS 1024  // inputs in each distribution, called in turn
+#define BENCH_BATCH 64  // calls timed together as one latency sample
+#define BENCH_SAMPLES 2000  // default latency samples per function
+#define BENCH_MAX_RESULTS 256
+#define BENCH_SUBREGION_POINTS 256  // inputs for each region 3 subregion
+
+
+typedef struct sctBenchInputs {
+	char strName[40];  // describes the distribution
+	int n;
+	double in1[BENCH_POINTS];
+	double in2[BENCH_POINTS];
+} typBenchInputs;
+
+
+typedef struct sctBenchResult {
+	char strGroup[24];
+	char strName[40];
+	char strInputs[40];
+	long lCalls;
+	double dblNsPerCall;
+	double dblCallsPerSec;
+	double dblP50Ns;
+	double dblP99Ns;
+} typBenchResult;
+
+
+typBenchResult results[BENCH_MAX_RESULTS];
+int numResults = 0;
+int numSamples = BENCH_SAMPLES;
+volatile double dblSink;  // results are added here so that the calls are not optimised away
+
+
+
+// ***************** TIMING AND RANDOM INPUTS *********************
+
+// a monotonic time in ns
+double benchNow (void){
+#ifdef _WIN32
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double) count.QuadPart * 1e9 / (double) freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#endif
+}
+
+
+// uniform on [0, 1) from a linear congruential generator, so every run draws the same inputs
+unsigned long benchSeed = 12345;
+double benchRand (void){
+	benchSeed = (benchSeed * 1103515245ul + 12345ul) % 2147483648ul;
+	return (double) benchSeed / 2147483648.0;
+}
+
+double benchUniform (double dblLow, double dblHigh){
+	return dblLow + (dblHigh - dblLow) * benchRand();
+}
+
+// log uniform, as pressures span several decades
+double benchLogUniform (double dblLow, double dblHigh){
+	return dblLow * pow(dblHigh / dblLow, benchRand());
+}
+
+
+// a (p,T) point in the given region, by rejection
+void benchPointPT (int iRegion, double *p_MPa, double *t_K){
+	do {
+		switch (iRegion) {
+		case 1 :
+			*t_K = benchUniform(IF97_R1_LTEMP, IF97_R1_UTEMP);
+			*p_MPa = benchLogUniform(0.001, IF97_R1_UPRESS);
+			break;
+		case 2 :
+			*t_K = benchUniform(IF97_R1_LTEMP, IF97_R2_UTEMP);
+			*p_MPa = benchLogUniform(0.001, IF97_R2_UPRESS);
+			break;
+		case 3 :
+			*t_K = benchUniform(IF97_R3_LTEMP, IF97_B23_UTEMP);
+			*p_MPa = benchUniform(IF97_B23_LPRESS, IF97_R3_UPRESS);
+			break;
+		case 5 :
+			*t_K = benchUniform(IF97_R5_LTEMP, IF97_R5_UTEMP);
+			*p_MPa = benchLogUniform(0.001, IF97_R5_UPRESS);
+			break;
+		}
+	} while (region_pt(*p_MPa, *t_K) != iRegion);
+}
+
+
+// (p,T) points in one region
+void benchFillRegion (typBenchInputs *in, int iRegion){
+	int i;
+
+	sprintf(in->strName, "region %i (p,T)", iRegion);
+	in->n = BENCH_POINTS;
+	for (i = 0; i < in->n; i++) benchPointPT(iRegion, &in->in1[i], &in->in2[i]);
+}
+
+
+/* (p,T) points as met in plant calculations: mostly regions 1 and 2 with a
+ * tail in region 3 and a little in region 5 */
+void benchFillMixed (typBenchInputs *in){
+	int i;
+	double dblDraw;
+
+	strcpy(in->strName, "mixed (p,T)");
+	in->n = BENCH_POINTS;
+	for (i = 0; i < in->n; i++) {
+		dblDraw = benchRand();
+		benchPointPT((dblDraw < 0.40) ? 1 : (dblDraw < 0.85) ? 2 : (dblDraw < 0.95) ? 3 : 5, &in->in1[i], &in->in2[i]);
+	}
+}
+
+
+// (p,T) points in region 3 where the backwards equations are not accurate enough and iteration is needed
+void benchFillNearCritical (typBenchInputs *in){
+	int i;
+
+	strcpy(in->strName, "near critical (p,T)");
+	in->n = BENCH_POINTS;
+	for (i = 0; i < in->n; i++) {
+		do {
+			in->in1[i] = benchUniform(if97_r4_ps(643.15), 22.5);
+			in->in2[i] = benchUniform(643.15, 650.0);
+		} while (!isNearCritical(in->in1[i], in->in2[i]) || (region_pt(in->in1[i], in->in2[i]) != 3));
+	}
+}
+
+
+
+/* (p,T) points along a closed loop, in order, as a time stepping simulation meets them:
+ * a small step each call, crossing between regions 1, 3 and 2 around the critical point */
+void benchFillTrajectory (typBenchInputs *in){
+	int i;
+	double dblAngle;
+
+	strcpy(in->strName, "trajectory (p,T)");
+	in->n = BENCH_POINTS;
+	for (i = 0; i < in->n; i++) {
+		dblAngle = 2.0 * M_PI * i / in->n;
+		in->in1[i] = IF97_PC * (1.0 + 0.15 * sin(dblAngle));
+		in->in2[i] = 640.0 + 60.0 * sin(dblAngle + 1.0) + 30.0 * cos(3.0 * dblAngle);
+	}
+}
+
+
+// (p,T) points along a closed loop which stays near critical in region 3
+void benchFillNearCriticalTrajectory (typBenchInputs *in){
+	int i;
+	double dblAngle, p_MPa, t_K;
+
+	strcpy(in->strName, "near critical trajectory");
+	in->n = 0;
+	for (i = 0; i < BENCH_POINTS; i++) {
+		dblAngle = 2.0 * M_PI * i / BENCH_POINTS;
+		p_MPa = 22.3 + 0.15 * sin(dblAngle);
+		t_K = 647.5 + 1.2 * cos(dblAngle);
+		if (!isNearCritical(p_MPa, t_K) || (region_pt(p_MPa, t_K) != 3)) continue;
+		in->in1[in->n] = p_MPa;
+		in->in2[in->n] = t_K;
+		in->n++;
+	}
+}
+
+
+
+// (u,v) points of wet steam: a saturation temperature and a quality, each uniform
+void benchFillWetUV (typBenchInputs *in){
+	int i;
+	double t_K, p_MPa, dblQ;
+	typSteamState liq, vap;
+
+	strcpy(in->strName, "two phase (u,v)");
+	in->n = BENCH_POINTS;
+	for (i = 0; i < in->n; i++) {
+		t_K = benchUniform(IF97_T_TRIP, IF97_TC);
+		p_MPa = if97_r4_ps(t_K);
+		dblQ = benchRand();
+		sat_props(p_MPa, t_K, false, IF97_MASK_U, &liq);
+		sat_props(p_MPa, t_K, true, IF97_MASK_U, &vap);
+		in->in1[i] = (1.0 - dblQ) * liq.u_kJperkg + dblQ * vap.u_kJperkg;
+		in->in2[i] = (1.0 - dblQ) / liq.rho_kgperM3 + dblQ / vap.rho_kgperM3;
+	}
+}
+
+// ***************** WRAPPERS *********************
+// so that everything benchmarked is a function of two doubles
+
+double bench_r4_ps (double t_K, double dummy) {return if97_r4_ps(t_K);}
+double bench_r4_ts (double p_MPa, double dummy) {return if97_r4_ts(p_MPa);}
+double bench_Ps_t (double p_MPa, double dummy) {return if97_Ps_t(p_MPa);}
+double bench_Ts_p (double t_K, double dummy) {return if97_Ts_p(t_K);}
+double bench_region_pt (double p_MPa, double t_K) {return (double) region_pt(p_MPa, t_K);}
+
+// density near the critical point, as the if97_pt_ functions find it
+double bench_secant_r3 (double p_MPa, double t_K) {
+	return secant_solv(if97_r3_p, t_K, false, p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100).dSolution;
+}
+
+double bench_ctx_r3 (double p_MPa, double t_K) {
+	typIF97R3Isotherm iso;
+	
+	if97_r3_isotherm(t_K, &iso);
+	return ctx_solv(if97_r3_p_iso, NULL, &iso, p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, NULL, TEST_ACCURACY, SIG_FIG, 100).dSolution;
+}
+
+double bench_newton_r3 (double p_MPa, double t_K) {
+	return newton_solv(if97_r3_p, if97_r3_dpdrho, t_K, false, p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), TEST_ACCURACY, SIG_FIG, 100).dSolution;
+}
+
+// temperature of the state at a pair, by if97_flash
+double bench_flash_hs (double h_kJperkg, double s_kJperkgK) {
+	typSteamState state;
+	
+	if97_flash(IF97_PAIR_HS, h_kJperkg, s_kJperkgK, 0, &state);
+	return state.t_K;
+}
+
+double bench_flash_uv (double u_kJperkg, double v_m3perkg) {
+	typSteamState state;
+	
+	if97_flash(IF97_PAIR_UV, u_kJperkg, v_m3perkg, 0, &state);
+	return state.t_K;
+}
+
+// the same by table look-up, from the default tables
+typIF97Sbtl benchSbtl;
+double bench_sbtl_ph_t (double p_MPa, double h_kJperkg) {return if97_sbtl_ph_t(&benchSbtl, p_MPa, h_kJperkg);}
+double bench_sbtl_uv_t (double u_kJperkg, double v_m3perkg) {return if97_sbtl_vu_t(&benchSbtl, v_m3perkg, u_kJperkg);}
+typIF97Ttse benchTtse;
+double bench_ttse_ph_t (double p_MPa, double h_kJperkg) {return if97_ttse_ph_t(&benchTtse, p_MPa, h_kJperkg);}
+double bench_ttse_pt_h (double p_MPa, double t_K) {return if97_ttse_pt_h(&benchTtse, p_MPa, t_K);}
+typIF97Compact benchCompact;
+double bench_compact_pt_h (double p_MPa, double t_K) {return if97_compact_pt_h(&benchCompact, p_MPa, t_K);}
+typIF97Quad benchQuad;
+double bench_quad_pt_h (double p_MPa, double t_K) {return if97_quad_eval(&benchQuad, p_MPa, t_K);}
+void bench_quad_pt_h_n (const double *p_MPa, const double *t_K, double *h_kJperkg, int n) {if97_quad_eval_n(&benchQuad, p_MPa, t_K, h_kJperkg, n);}
+
+// warm started inverses.  benchRun calls them on the trajectory in order, so each starts from the last point
+typIF97Warm benchWarmPH, benchWarmPS, benchWarmRho;
+double bench_warm_ph_t (double p_MPa, double h_kJperkg) {return if97_warm_ph_t(&benchWarmPH, p_MPa, h_kJperkg);}
+double bench_warm_ps_t (double p_MPa, double s_kJperkgK) {return if97_warm_ps_t(&benchWarmPS, p_MPa, s_kJperkgK);}
+double bench_warm_r3_rho_pt (double p_MPa, double t_K) {return if97_warm_r3_rho_pt(&benchWarmRho, p_MPa, t_K);}
+
+// how often a handle was warm started, and the iterations its calls took
+void benchWarmReport (const char *strName, const typIF97Warm *warm, long lIterations, int n){
+	printf("%-12s %-28s warm %li cold %li, %.2f iterations per call\n", "warm", strName,
+			warm->lWarm, warm->lCold, (double) lIterations / n);
+}
+
+// the share of (u,v) inputs outside the tables, which the SBTL passes to if97_flash
+void benchSbtlReport (const char *strName, const typBenchInputs *in){
+	int i, nOut = 0;
+
+	for (i = 0; i < in->n; i++) nOut += !if97_sbtl_vu_in_tables(&benchSbtl, in->in2[i], in->in1[i]);
+	printf("%-12s %-28s %-24s %.1f%% by if97_flash\n", "sbtl", strName, in->strName, 100.0 * nOut / in->n);
+}
+
+// winsteam compatible functions in SI (bar, C, kJ/kg)
+const typStmUnitSet *benchUnitSet = NULL;
+double bench_StmPTH (double p_bar, double t_C) {return StmPTH(p_bar, t_C, "SI");}
+double bench_StmPTH_u (double p_bar, double t_C) {return StmPTH_u(p_bar, t_C, benchUnitSet);}
+double bench_StmPTV (double p_bar, double t_C) {return StmPTV(p_bar, t_C, "SI");}
+double bench_StmPHT (double p_bar, double h_kJperkg) {return StmPHT(p_bar, h_kJperkg, "SI");}
+double bench_StmPST (double p_bar, double s_kJperkgK) {return StmPST(p_bar, s_kJperkgK, "SI");}
+
+// unit conversions
+typUnitConv benchConv;
+double bench_convertNamedUnit (double p_psia, double dummy) {return convertNamedUnit(p_psia, "psia", "MPa");}
+double bench_getUnitConv (double p_psia, double dummy) {return applyUnitConv(p_psia, getUnitConv("psia", "MPa"));}
+double bench_applyUnitConv (double p_psia, double dummy) {return applyUnitConv(p_psia, benchConv);}
+double bench_getUnitIndex (double p_psia, double dummy) {return (double) getUnitIndex("pounds per square inch");}
+
+
+
+// ***************** RUNNING AND REPORTING *********************
+
+int benchCompare (const void *a, const void *b){
+	double dblA = *(const double *) a, dblB = *(const double *) b;
+	return (dblA > dblB) - (dblA < dblB);
+}
+
+
+// times func over the inputs and keeps the result
+void benchRun (const char *strGroup, const char *strName, double (*func) (double, double), const typBenchInputs *in){
+	double *dblSamples;
+	double dblStart, dblBatch, dblTotal = 0.0, dblSum = 0.0;
+	int i, j, k = 0;
+	typBenchResult *res;
+
+	if (numResults >= BENCH_MAX_RESULTS) return;
+	dblSamples = malloc(numSamples * sizeof(double));
+	if (dblSamples == NULL) return;
+
+	for (j = 0; j < in->n; j++) dblSum += func(in->in1[j], in->in2[j]);  // warm up the caches
+
+	for (i = 0; i < numSamples; i++) {
+		dblStart = benchNow();
+		for (j = 0; j < BENCH_BATCH; j++) {
+			dblSum += func(in->in1[k], in->in2[k]);
+			if (++k == in->n) k = 0;
+		}
+		dblBatch = benchNow() - dblStart;
+		dblTotal += dblBatch;
+		dblSamples[i] = dblBatch / BENCH_BATCH;
+	}
+	dblSink += dblSum;
+	qsort(dblSamples, numSamples, sizeof(double), benchCompare);
+
+	res = &results[numResults++];
+	snprintf(res->strGroup, sizeof(res->strGroup), "%s", strGroup);
+	snprintf(res->strName, sizeof(res->strName), "%s", strName);
+	snprintf(res->strInputs, sizeof(res->strInputs), "%s", in->strName);
+	res->lCalls = (long) numSamples * BENCH_BATCH;
+	res->dblNsPerCall = dblTotal / res->lCalls;
+	res->dblCallsPerSec = 1e9 / res->dblNsPerCall;
+	res->dblP50Ns = dblSamples[numSamples / 2];
+	res->dblP99Ns = dblSamples[(int) (0.99 * (numSamples - 1))];
+
+	printf("%-12s %-28s %-24s %10.1f %14.0f %10.1f %10.1f\n", res->strGroup, res->strName, res->strInputs,
+			res->dblNsPerCall, res->dblCallsPerSec, res->dblP50Ns, res->dblP99Ns);
+	fflush(stdout);
+	free(dblSamples);
+}
+
+
+// times an array function called on BENCH_BATCH inputs at a time, as one latency sample.
+// The times are per point, so they compare with benchRun's
+void benchRunBatch (const char *strGroup, const char *strName, void (*func) (const double *, const double *, double *, int), const typBenchInputs *in){
+	double *dblSamples;
+	double dblOut[BENCH_BATCH];
+	double dblStart, dblBatch, dblTotal = 0.0, dblSum = 0.0;
+	int i, j, k = 0;
+	typBenchResult *res;
+
+	if ((numResults >= BENCH_MAX_RESULTS) || (in->n < BENCH_BATCH)) return;
+	dblSamples = malloc(numSamples * sizeof(double));
+	if (dblSamples == NULL) return;
+
+	for (j = 0; j + BENCH_BATCH <= in->n; j += BENCH_BATCH) {  // warm up the caches
+		func(&in->in1[j], &in->in2[j], dblOut, BENCH_BATCH);
+		dblSum += dblOut[0];
+	}
+
+	for (i = 0; i < numSamples; i++) {
+		if (k + BENCH_BATCH > in->n) k = 0;
+		dblStart = benchNow();
+		func(&in->in1[k], &in->in2[k], dblOut, BENCH_BATCH);
+		dblBatch = benchNow() - dblStart;
+		for (j = 0; j < BENCH_BATCH; j++) dblSum += dblOut[j];
+		k += BENCH_BATCH;
+		dblTotal += dblBatch;
+		dblSamples[i] = dblBatch / BENCH_BATCH;
+	}
+	dblSink += dblSum;
+	qsort(dblSamples, numSamples, sizeof(double), benchCompare);
+
+	res = &results[numResults++];
+	snprintf(res->strGroup, sizeof(res->strGroup), "%s", strGroup);
+	snprintf(res->strName, sizeof(res->strName), "%s", strName);
+	snprintf(res->strInputs, sizeof(res->strInputs), "%s", in->strName);
+	res->lCalls = (long) numSamples * BENCH_BATCH;
+	res->dblNsPerCall = dblTotal / res->lCalls;
+	res->dblCallsPerSec = 1e9 / res->dblNsPerCall;
+	res->dblP50Ns = dblSamples[numSamples / 2];
+	res->dblP99Ns = dblSamples[(int) (0.99 * (numSamples - 1))];
+
+	printf("%-12s %-28s %-24s %10.1f %14.0f %10.1f %10.1f\n", res->strGroup, res->strName, res->strInputs,
+			res->dblNsPerCall, res->dblCallsPerSec, res->dblP50Ns, res->dblP99Ns);
+	fflush(stdout);
+	free(dblSamples);
+}
+
+
+// writes the build settings and the results as JSON
+int benchWriteJson (const char *strFile){
+	FILE *out = fopen(strFile, "w");
+	int i;
+
+	if (out == NULL) return 1;
+
+	fprintf(out, "{\n");
+	fprintf(out, "  \"benchmark\": \"if97_bench\",\n");
+	fprintf(out, "  \"build\": {\n");
+#if defined(__VERSION__)
+	fprintf(out, "    \"compiler\": \"%s\",\n", __VERSION__);
+#elif defined(_MSC_VER)
+	fprintf(out, "    \"compiler\": \"msvc %i\",\n", _MSC_VER);
+#else
+	fprintf(out, "    \"compiler\": \"unknown\",\n");
+#endif
+#if defined(__OPTIMIZE__)
+	fprintf(out, "    \"optimised\": true,\n");
+#else
+	fprintf(out, "    \"optimised\": false,\n");
+#endif
+#ifdef _OPENMP
+	fprintf(out, "    \"openmp\": %i,\n", _OPENMP);
+	fprintf(out, "    \"max_threads\": %i\n", omp_get_max_threads());
+#else
+	fprintf(out, "    \"openmp\": 0,\n");
+	fprintf(out, "    \"max_threads\": 1\n");
+#endif
+	fprintf(out, "  },\n");
+	fprintf(out, "  \"samples_per_function\": %i,\n", numSamples);
+	fprintf(out, "  \"calls_per_sample\": %i,\n", BENCH_BATCH);
+	fprintf(out, "  \"results\": [\n");
+	for (i = 0; i < numResults; i++) {
+		fprintf(out, "    {\"group\": \"%s\", \"function\": \"%s\", \"inputs\": \"%s\", \"calls\": %li, "
+				"\"ns_per_call\": %.2f, \"calls_per_sec\": %.0f, \"p50_ns\": %.2f, \"p99_ns\": %.2f}%s\n",
+				results[i].strGroup, results[i].strName, results[i].strInputs, results[i].lCalls,
+				results[i].dblNsPerCall, results[i].dblCallsPerSec, results[i].dblP50Ns, results[i].dblP99Ns,
+				(i < numResults - 1) ? "," : "");
+	}
+	fprintf(out, "  ]\n}\n");
+	fclose(out);
+	return 0;
+}
+
+
+
+int main (int argc, char **argv){
+	const char *strJson = (argc > 1) ? argv[1] : BENCH_JSONLOC;
+	static typBenchInputs r1, r2, r3, r3RhoT, r5, mixed, mixedPH, mixedPS, mixedHS, mixedUV, wetUV, mixedRhoT, nearCrit, sat_p, sat_t, stmPT, stmPH, stmPS, psia;
+	static typBenchInputs traj, trajPH, trajPS, nearCritTraj;
+	static typBenchInputs subregion[26];
+	char strName[40];
+	double p_MPa, t_K;
+	long lIterations;
+	int i, iSub, iTries;
+
+	if (argc > 2) numSamples = atoi(argv[2]);
+	if (numSamples < 2) numSamples = BENCH_SAMPLES;
+
+	// the input distributions
+	benchFillRegion(&r1, 1);
+	benchFillRegion(&r2, 2);
+	benchFillRegion(&r3, 3);
+	benchFillRegion(&r5, 5);
+	benchFillMixed(&mixed);
+	benchFillNearCritical(&nearCrit);
+	benchFillTrajectory(&traj);
+	benchFillNearCriticalTrajectory(&nearCritTraj);
+	benchFillWetUV(&wetUV);
+
+	strcpy(r3RhoT.strName, "region 3 (rho,T)");
+	r3RhoT.n = r3.n;
+	for (i = 0; i < r3.n; i++) {
+		r3RhoT.in1[i] = r3_rho_pt(r3.in1[i], r3.in2[i]);
+		r3RhoT.in2[i] = r3.in2[i];
+	}
+
+	strcpy(sat_t.strName, "saturation T");
+	strcpy(sat_p.strName, "saturation p");
+	sat_t.n = sat_p.n = BENCH_POINTS;
+	for (i = 0; i < BENCH_POINTS; i++) {
+		sat_t.in1[i] = benchUniform(IF97_R1_LTEMP, IF97_TC);
+		sat_p.in1[i] = benchLogUniform(IF97_P_TRIP / 1e6, IF97_PC);
+		sat_t.in2[i] = sat_p.in2[i] = 0.0;
+	}
+
+	// the mixed points as (p,h) and (p,s), and in the SI unit set
+	strcpy(mixedPH.strName, "mixed (p,h)");
+	strcpy(mixedPS.strName, "mixed (p,s)");
+	strcpy(stmPT.strName, "mixed (p,T) bar C");
+	strcpy(stmPH.strName, "mixed (p,h) bar kJ/kg");
+	strcpy(stmPS.strName, "mixed (p,s) bar kJ/kg/K");
+	strcpy(psia.strName, "psia");
+	mixedPH.n = mixedPS.n = stmPT.n = stmPH.n = stmPS.n = psia.n = mixed.n;
+	for (i = 0; i < mixed.n; i++) {
+		mixedPH.in1[i] = mixedPS.in1[i] = mixed.in1[i];
+		mixedPH.in2[i] = if97_pt_h(mixed.in1[i], mixed.in2[i]);
+		mixedPS.in2[i] = if97_pt_s(mixed.in1[i], mixed.in2[i]);
+		stmPT.in1[i] = stmPH.in1[i] = stmPS.in1[i] = 10.0 * mixed.in1[i];
+		stmPT.in2[i] = mixed.in2[i] - 273.15;
+		stmPH.in2[i] = mixedPH.in2[i];
+		stmPS.in2[i] = mixedPS.in2[i];
+		psia.in1[i] = 145.0377 * mixed.in1[i];
+		psia.in2[i] = 0.0;
+	}
+
+	// the mixed points as (h,s) and (u,v), for the flash, and as (rho,T)
+	strcpy(mixedHS.strName, "mixed (h,s)");
+	strcpy(mixedUV.strName, "mixed (u,v)");
+	strcpy(mixedRhoT.strName, "mixed (rho,T)");
+	mixedHS.n = mixedUV.n = mixedRhoT.n = mixed.n;
+	for (i = 0; i < mixed.n; i++) {
+		mixedRhoT.in1[i] = 1.0 / if97_pt_v(mixed.in1[i], mixed.in2[i]);
+		mixedRhoT.in2[i] = mixed.in2[i];
+		mixedHS.in1[i] = mixedPH.in2[i];
+		mixedHS.in2[i] = mixedPS.in2[i];
+		mixedUV.in1[i] = if97_pt_u(mixed.in1[i], mixed.in2[i]);
+		mixedUV.in2[i] = if97_pt_v(mixed.in1[i], mixed.in2[i]);
+	}
+
+	// the trajectory as (p,h) and (p,s)
+	strcpy(trajPH.strName, "trajectory (p,h)");
+	strcpy(trajPS.strName, "trajectory (p,s)");
+	trajPH.n = trajPS.n = traj.n;
+	for (i = 0; i < traj.n; i++) {
+		trajPH.in1[i] = trajPS.in1[i] = traj.in1[i];
+		trajPH.in2[i] = if97_pt_h(traj.in1[i], traj.in2[i]);
+		trajPS.in2[i] = if97_pt_s(traj.in1[i], traj.in2[i]);
+	}
+
+	// region 3 points sorted by the subregion of the backwards equations
+	for (iSub = 0; iSub < 26; iSub++) {
+		sprintf(subregion[iSub].strName, "region 3%c (p,T)", 'a' + iSub);
+		subregion[iSub].n = 0;
+	}
+	for (iTries = 0; iTries < 2000000; iTries++) {
+		if (iTries % 2) benchPointPT(3, &p_MPa, &t_K);
+		else {  // most of the subregions are close to the critical point
+			p_MPa = benchUniform(IF97_B23_LPRESS, 25.0);
+			t_K = benchUniform(IF97_R3_LTEMP, 660.0);
+			if (region_pt(p_MPa, t_K) != 3) continue;
+		}
+		iSub = if97_r3_pt_subregion(p_MPa, t_K) - 'a';
+		if ((iSub < 0) || (iSub >= 26) || (subregion[iSub].n >= BENCH_SUBREGION_POINTS)) continue;
+		subregion[iSub].in1[subregion[iSub].n] = p_MPa;
+		subregion[iSub].in2[subregion[iSub].n] = t_K;
+		subregion[iSub].n++;
+	}
+
+	benchUnitSet = StmUnitSetOpen("SI");
+	benchConv = getUnitConv("psia", "MPa");
+
+	printf("%-12s %-28s %-24s %10s %14s %10s %10s\n", "group", "function", "inputs", "ns/call", "calls/s", "p50 ns", "p99 ns");
+
+	benchRun("region 1", "if97_r1_g", if97_r1_g, &r1);
+	benchRun("region 1", "if97_r1_v", if97_r1_v, &r1);
+	benchRun("region 1", "if97_r1_u", if97_r1_u, &r1);
+	benchRun("region 1", "if97_r1_s", if97_r1_s, &r1);
+	benchRun("region 1", "if97_r1_h", if97_r1_h, &r1);
+	benchRun("region 1", "if97_r1_Cp", if97_r1_Cp, &r1);
+	benchRun("region 1", "if97_r1_Cv", if97_r1_Cv, &r1);
+	benchRun("region 1", "if97_r1_w", if97_r1_w, &r1);
+
+	benchRun("region 2", "if97_r2_g", if97_r2_g, &r2);
+	benchRun("region 2", "if97_r2_v", if97_r2_v, &r2);
+	benchRun("region 2", "if97_r2_u", if97_r2_u, &r2);
+	benchRun("region 2", "if97_r2_s", if97_r2_s, &r2);
+	benchRun("region 2", "if97_r2_h", if97_r2_h, &r2);
+	benchRun("region 2", "if97_r2_Cp", if97_r2_Cp, &r2);
+	benchRun("region 2", "if97_r2_Cv", if97_r2_Cv, &r2);
+	benchRun("region 2", "if97_r2_w", if97_r2_w, &r2);
+
+	benchRun("region 3", "if97_r3_hhz", if97_r3_hhz, &r3RhoT);
+	benchRun("region 3", "if97_r3_p", if97_r3_p, &r3RhoT);
+	benchRun("region 3", "if97_r3_u", if97_r3_u, &r3RhoT);
+	benchRun("region 3", "if97_r3_s", if97_r3_s, &r3RhoT);
+	benchRun("region 3", "if97_r3_h", if97_r3_h, &r3RhoT);
+	benchRun("region 3", "if97_r3_Cp", if97_r3_Cp, &r3RhoT);
+	benchRun("region 3", "if97_r3_Cv", if97_r3_Cv, &r3RhoT);
+	benchRun("region 3", "if97_r3_w", if97_r3_w, &r3RhoT);
+
+	benchRun("region 4", "if97_r4_ps", bench_r4_ps, &sat_t);
+	benchRun("region 4", "if97_r4_ts", bench_r4_ts, &sat_p);
+
+	benchRun("region 5", "if97_r5_g", if97_r5_g, &r5);
+	benchRun("region 5", "if97_r5_v", if97_r5_v, &r5);
+	benchRun("region 5", "if97_r5_u", if97_r5_u, &r5);
+	benchRun("region 5", "if97_r5_s", if97_r5_s, &r5);
+	benchRun("region 5", "if97_r5_h", if97_r5_h, &r5);
+	benchRun("region 5", "if97_r5_Cp", if97_r5_Cp, &r5);
+	benchRun("region 5", "if97_r5_Cv", if97_r5_Cv, &r5);
+	benchRun("region 5", "if97_r5_w", if97_r5_w, &r5);
+
+	benchRun("region 3 bw", "if97_R3bw_v_pt", if97_R3bw_v_pt, &r3);
+	for (iSub = 0; iSub < 26; iSub++) {
+		if (subregion[iSub].n < 16) continue;  // too small to find
+		sprintf(strName, "if97_R3bw_v_pt 3%c", 'a' + iSub);
+		benchRun("region 3 bw", strName, if97_R3bw_v_pt, &subregion[iSub]);
+	}
+
+	benchRun("solver", "secant_solv if97_r3_p", bench_secant_r3, &nearCrit);
+	benchRun("solver", "ctx_solv if97_r3_p_iso", bench_ctx_r3, &nearCrit);
+	benchRun("solver", "newton_solv if97_r3_p", bench_newton_r3, &nearCrit);
+	benchRunBatch("solver", "r3_rho_pt_n", r3_rho_pt_n, &nearCrit);
+
+	benchRun("dispatcher", "region_pt", bench_region_pt, &mixed);
+	benchRun("dispatcher", "if97_Ps_t", bench_Ps_t, &sat_p);
+	benchRun("dispatcher", "if97_Ts_p", bench_Ts_p, &sat_t);
+	benchRun("dispatcher", "if97_pt_h", if97_pt_h, &mixed);
+	benchRun("dispatcher", "if97_pt_u", if97_pt_u, &mixed);
+	benchRun("dispatcher", "if97_pt_s", if97_pt_s, &mixed);
+	benchRun("dispatcher", "if97_pt_v", if97_pt_v, &mixed);
+	benchRun("dispatcher", "if97_pt_Cv", if97_pt_Cv, &mixed);
+	benchRun("dispatcher", "if97_pt_Cp", if97_pt_Cp, &mixed);
+	benchRun("dispatcher", "if97_pt_Vs", if97_pt_Vs, &mixed);
+	benchRun("dispatcher", "if97_pt_gamma", if97_pt_gamma, &mixed);
+	benchRun("dispatcher", "if97_pt_h", if97_pt_h, &nearCrit);
+	benchRun("dispatcher", "if97_ph_t", if97_ph_t, &mixedPH);
+	benchRun("dispatcher", "if97_ps_t", if97_ps_t, &mixedPS);
+	benchRun("dispatcher", "if97_rhot_h", if97_rhot_h, &mixedRhoT);
+	benchRun("dispatcher", "if97_rhot_p", if97_rhot_p, &mixedRhoT);
+
+	benchRun("flash", "if97_flash (h,s)", bench_flash_hs, &mixedHS);
+	benchRun("flash", "if97_flash (u,v)", bench_flash_uv, &mixedUV);
+	benchRun("flash", "if97_flash (u,v)", bench_flash_uv, &wetUV);
+
+	if (if97_sbtl_init(&benchSbtl, IF97_SBTL_NX, IF97_SBTL_NY) == SOLVE_CONVERGE) {
+		benchRun("sbtl", "if97_sbtl_ph_t", bench_sbtl_ph_t, &mixedPH);
+		benchRun("sbtl", "if97_sbtl_vu_t", bench_sbtl_uv_t, &mixedUV);
+		benchRun("sbtl", "if97_sbtl_vu_t", bench_sbtl_uv_t, &wetUV);
+		benchSbtlReport("if97_sbtl_vu_t", &mixedUV);
+		benchSbtlReport("if97_sbtl_vu_t", &wetUV);
+		if97_sbtl_free(&benchSbtl);
+	}
+	if (if97_ttse_init(&benchTtse, NULL) == SOLVE_CONVERGE) {
+		benchRun("ttse", "if97_ttse_ph_t", bench_ttse_ph_t, &mixedPH);
+		benchRun("ttse", "if97_ttse_pt_h", bench_ttse_pt_h, &mixed);
+		if97_ttse_free(&benchTtse);
+	}
+	if (if97_compact_init(&benchCompact, NULL) == SOLVE_CONVERGE) {
+		benchRun("compact", "if97_compact_pt_h", bench_compact_pt_h, &r1);
+		benchRun("compact", "if97_compact_pt_h", bench_compact_pt_h, &r2);
+		benchRun("compact", "if97_compact_pt_h", bench_compact_pt_h, &mixed);  // regions 3 and 5 fall through to if97_pt_h
+		if97_compact_free(&benchCompact);
+	}
+	if (if97_quad_init(&benchQuad, NULL) == SOLVE_CONVERGE) {
+		benchRun("quad", "if97_quad_eval (p,T) h", bench_quad_pt_h, &r1);
+		benchRun("quad", "if97_quad_eval (p,T) h", bench_quad_pt_h, &mixed);
+		benchRunBatch("quad", "if97_quad_eval_n (p,T) h", bench_quad_pt_h_n, &mixed);
+		if97_quad_free(&benchQuad);
+	}
+
+	benchRun("warm", "if97_ph_t", if97_ph_t, &trajPH);
+	benchRun("warm", "if97_warm_ph_t", bench_warm_ph_t, &trajPH);
+	benchRun("warm", "if97_ps_t", if97_ps_t, &trajPS);
+	benchRun("warm", "if97_warm_ps_t", bench_warm_ps_t, &trajPS);
+	benchRun("warm", "r3_rho_pt", r3_rho_pt, &nearCritTraj);
+	benchRun("warm", "if97_warm_r3_rho_pt", bench_warm_r3_rho_pt, &nearCritTraj);
+
+	// once more round each loop, counted
+	if97_warm_init(&benchWarmPH);
+	for (i = 0, lIterations = 0; i < trajPH.n; i++) {
+		dblSink += if97_warm_ph_t(&benchWarmPH, trajPH.in1[i], trajPH.in2[i]);
+		lIterations += benchWarmPH.iIterations;
+	}
+	benchWarmReport("if97_warm_ph_t", &benchWarmPH, lIterations, trajPH.n);
+	if97_warm_init(&benchWarmPS);
+	for (i = 0, lIterations = 0; i < trajPS.n; i++) {
+		dblSink += if97_warm_ps_t(&benchWarmPS, trajPS.in1[i], trajPS.in2[i]);
+		lIterations += benchWarmPS.iIterations;
+	}
+	benchWarmReport("if97_warm_ps_t", &benchWarmPS, lIterations, trajPS.n);
+	if97_warm_init(&benchWarmRho);
+	for (i = 0, lIterations = 0; i < nearCritTraj.n; i++) {
+		dblSink += if97_warm_r3_rho_pt(&benchWarmRho, nearCritTraj.in1[i], nearCritTraj.in2[i]);
+		lIterations += benchWarmRho.iIterations;
+	}
+	benchWarmReport("if97_warm_r3_rho_pt", &benchWarmRho, lIterations, nearCritTraj.n);
+
+	benchRun("winsteam", "StmPTH", bench_StmPTH, &stmPT);
+	benchRun("winsteam", "StmPTH_u", bench_StmPTH_u, &stmPT);
+	benchRun("winsteam", "StmPTV", bench_StmPTV, &stmPT);
+	benchRun("winsteam", "StmPHT", bench_StmPHT, &stmPH);
+	benchRun("winsteam", "StmPST", bench_StmPST, &stmPS);
+
+	benchRun("units", "convertNamedUnit", bench_convertNamedUnit, &psia);
+	benchRun("units", "getUnitConv", bench_getUnitConv, &psia);
+	benchRun("units", "applyUnitConv", bench_applyUnitConv, &psia);
+	benchRun("units", "getUnitIndex", bench_getUnitIndex, &psia);
+
+	if (benchWriteJson(strJson) != 0) {
+		fprintf(stderr, "if97_bench: cannot write %s\n", strJson);
+		return 1;
+	}
+	printf("\nResults written to %s\n", strJson);
+	return 0;
+}
@@ -0,0 +1,498 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Compact tables of h, v, s and u on (p,T) in regions 1 and 2.  See if97_compact.h
+
+/* Within a domain T = T_lo(p) + eta (T_hi(p) - T_lo(p)), so that for a property z, from
+ * its (p,T) base derivatives (if97_deriv)
+ *
+ * 	z_x = p z_p + z_T (T_lo' + eta (T_hi' - T_lo')),  z_eta = z_T (T_hi - T_lo)
+ *
+ * where ' is d / dx, x = ln p, and the slopes of the bounding curves are differenced.  The
+ * nodes are evenly spaced in w and y, which close them up towards the critical region:  in a
+ * domain bounded below by the saturation or B23 line eta = y^2, in one bounded above by the
+ * saturation line or 623.15 K eta = 1 - (1 - y)^2, and likewise x runs from x_lo to x_hi as
+ * w^2 or 1 - (1 - w)^2 towards IF97_B23_LPRESS.  So z_w = z_x dx/dw, z_y = z_eta deta/dy.  The
+ * mixed derivative z_w_y is the central difference of z_w across a step of COMPACT_STEP of a
+ * node spacing.  The bicubic Hermite interpolant over a cell, in t and u running from 0 to 1
+ * across it, is
+ *
+ * 	z = sum over its corners (a,b) of  H_a(t) H_b(u) z + G_a(t) H_b(u) z_w dw
+ * 					+ H_a(t) G_b(u) z_y dy + G_a(t) G_b(u) z_w_y dw dy
+ *
+ * with H_0(t) = (1 + 2t)(1 - t)^2, H_1(t) = t^2 (3 - 2t), G_0(t) = t (1 - t)^2 and
+ * G_1(t) = -t^2 (1 - t).
+ */
+
+
+#include <math.h> // for log, exp, sqrt, pow, ceil, isfinite
+#include <stdbool.h>
+#include <stddef.h> // for NULL
+#include <stdlib.h> // for malloc, free
+
+#include "if97_compact.h"
+#include "if97_lib.h"
+#include "if97_deriv.h"
+#include "IF97_common.h"
+#include "IF97_Region4.h"
+#include "IF97_B23.h"
+#include "solve.h"
+
+
+#define COMPACT_P_TRIP (IF97_P_TRIP * 1e-6)  // MPa
+#define COMPACT_STEP 1e-3  // step, as a fraction of the node spacing, over which the mixed derivative is differenced
+#define COMPACT_SLOPE_STEP 1e-6  // step in x over which the slopes of the bounding curves are differenced
+#define COMPACT_TERMS 4  // terms at each node
+#define COMPACT_CHECKS 3  // errors found at the middle of the edges along w, those along y, and the cells
+
+
+// the bounding curves of the domains
+enum compactCurve {
+	COMPACT_CONST,  // an isotherm
+	COMPACT_TS,  // the saturation line
+	COMPACT_B23,  // the region 2 / 3 boundary
+};
+
+
+// the closing up of the nodes along x or eta
+enum compactCluster {
+	COMPACT_EVEN,  // eta = y
+	COMPACT_LO,  // eta = y^2
+	COMPACT_HI,  // eta = 1 - (1 - y)^2
+};
+
+
+// the domains, in the order of if97_compact.h
+typedef struct sctCompactDomain {
+	int iRegion;
+	double pLo_MPa;
+	double pHi_MPa;
+	int iLo;  // enum compactCurve of the lower bound in T
+	double tLo_K;  // the isotherm, if it is one
+	int iHi;
+	double tHi_K;
+	int iClusterX;  // enum compactCluster of x from w
+	int iCluster;  // of eta from y
+} typCompactDomain;
+
+const typCompactDomain compactDomains[IF97_COMPACT_DOMAINS] = {
+	{1, COMPACT_P_TRIP, IF97_B23_LPRESS, COMPACT_CONST, IF97_R1_LTEMP, COMPACT_TS, 0.0, COMPACT_HI, COMPACT_HI},
+	{1, IF97_B23_LPRESS, IF97_R1_UPRESS, COMPACT_CONST, IF97_R1_LTEMP, COMPACT_CONST, IF97_R1_UTEMP, COMPACT_LO, COMPACT_HI},
+	{2, COMPACT_P_TRIP, IF97_B23_LPRESS, COMPACT_TS, 0.0, COMPACT_CONST, IF97_R2_UTEMP, COMPACT_HI, COMPACT_LO},
+	{2, IF97_B23_LPRESS, IF97_R1_UPRESS, COMPACT_B23, 0.0, COMPACT_CONST, IF97_R2_UTEMP, COMPACT_LO, COMPACT_LO},
+};
+
+
+
+// ******  Domains   *******
+
+double compactCurveT(int iCurve, double tConst_K, double p_MPa){
+	switch (iCurve) {
+	case COMPACT_TS: return if97_r4_ts(p_MPa);
+	case COMPACT_B23: return IF97_B23T(p_MPa);
+	default: return tConst_K;
+	}
+}
+
+
+// eta at y in a domain closed up by iCluster, and deta/dy
+double compactEta(int iCluster, double y, double *dEta_dy){
+	switch (iCluster) {
+	case COMPACT_LO:
+		*dEta_dy = 2.0 * y;
+		return y * y;
+	case COMPACT_HI:
+		*dEta_dy = 2.0 * (1.0 - y);
+		return 1.0 - (1.0 - y) * (1.0 - y);
+	default:
+		*dEta_dy = 1.0;
+		return y;
+	}
+}
+
+
+// y at eta, the inverse of compactEta
+double compactY(int iCluster, double eta){
+	switch (iCluster) {
+	case COMPACT_LO: return sqrt(eta);
+	case COMPACT_HI: return 1.0 - sqrt(1.0 - eta);
+	default: return eta;
+	}
+}
+
+
+// the domain of (p_MPa, t_K), and the bounds in T there, as region_pt finds the region.  -1 if
+// it is in neither region 1 nor region 2, or outside the domains
+int compactDomain(double p_MPa, double t_K, double *tLo_K, double *tHi_K){
+	double ts_K;
+
+	if (!((p_MPa >= COMPACT_P_TRIP) && (p_MPa <= IF97_R1_UPRESS) && (t_K >= IF97_R1_LTEMP) && (t_K <= IF97_R2_UTEMP)))
+		return -1;
+	if (p_MPa < IF97_B23_LPRESS) {
+		ts_K = if97_r4_ts(p_MPa);
+		if (ts_K > t_K) {
+			*tLo_K = IF97_R1_LTEMP;
+			*tHi_K = ts_K;
+			return 0;
+		}
+		*tLo_K = ts_K;
+		*tHi_K = IF97_R2_UTEMP;
+		return 2;
+	}
+	if (t_K < IF97_R1_UTEMP) {
+		*tLo_K = IF97_R1_LTEMP;
+		*tHi_K = IF97_R1_UTEMP;
+		return 1;
+	}
+	*tLo_K = IF97_B23T(p_MPa);
+	*tHi_K = IF97_R2_UTEMP;
+	return (*tLo_K < t_K) ? 3 : -1;  // region 3 otherwise
+}
+
+
+// the property k of domain iDomain at (w,y), and its first derivatives in w and y.  false if not finite
+bool compactFirst(int iDomain, int k, double w, double y, double *z, double *zw, double *zy){
+	const typCompactDomain *dom = &compactDomains[iDomain];
+	const enum if97_prop_t prop[IF97_COMPACT_NPROPS] = {IF97_H, IF97_V, IF97_S, IF97_U};
+	typSteamState state;
+	typIF97Partials pd;
+	double x0 = log(dom->pLo_MPa), x1 = log(dom->pHi_MPa), dX_dw, x, p_MPa, tLo, tHi, sLo, sHi, z_p, z_T, dEta_dy, eta;
+
+	x = x0 + (x1 - x0) * compactEta(dom->iClusterX, w, &dX_dw);
+	dX_dw *= x1 - x0;
+	p_MPa = exp(x);
+	eta = compactEta(dom->iCluster, y, &dEta_dy);
+
+	tLo = compactCurveT(dom->iLo, dom->tLo_K, p_MPa);
+	tHi = compactCurveT(dom->iHi, dom->tHi_K, p_MPa);
+	sLo = (compactCurveT(dom->iLo, dom->tLo_K, exp(x + COMPACT_SLOPE_STEP)) - compactCurveT(dom->iLo, dom->tLo_K, exp(x - COMPACT_SLOPE_STEP)))
+			/ (2.0 * COMPACT_SLOPE_STEP);
+	sHi = (compactCurveT(dom->iHi, dom->tHi_K, exp(x + COMPACT_SLOPE_STEP)) - compactCurveT(dom->iHi, dom->tHi_K, exp(x - COMPACT_SLOPE_STEP)))
+			/ (2.0 * COMPACT_SLOPE_STEP);
+
+	// the region's own equation, whether or not the state is within it
+	state.p_MPa = p_MPa;
+	state.t_K = tLo + eta * (tHi - tLo);
+	state.iRegion = dom->iRegion;
+	pd = if97_state_partials(&state);
+
+	*z = pd.val[prop[k]];
+	z_p = pd.d1[prop[k]];
+	z_T = pd.d2[prop[k]];
+	if (k == IF97_COMPACT_PROP_V) {
+		*z = log(*z);
+		z_p /= pd.val[IF97_V];
+		z_T /= pd.val[IF97_V];
+	}
+	*zw = (p_MPa * z_p + z_T * (sLo + eta * (sHi - sLo))) * dX_dw;
+	*zy = z_T * (tHi - tLo) * dEta_dy;
+	return isfinite(*z) && isfinite(*zw) && isfinite(*zy);
+}
+
+
+// the terms of node (w,y) into a, each scaled by the node spacings dw and dy.  NAN if not finite
+void compactNode(int iDomain, int k, double w, double y, double dw, double dy, double *a){
+	double z, zw, zy, zwLo, zwHi, zScratch, zyScratch, dblStep = COMPACT_STEP * dy;
+
+	if (compactFirst(iDomain, k, w, y, &z, &zw, &zy)
+			&& compactFirst(iDomain, k, w, y - dblStep, &zScratch, &zwLo, &zyScratch)
+			&& compactFirst(iDomain, k, w, y + dblStep, &zScratch, &zwHi, &zyScratch)) {
+		a[0] = z;
+		a[1] = zw * dw;
+		a[2] = zy * dy;
+		a[3] = (zwHi - zwLo) / (2.0 * dblStep) * dw * dy;
+	}
+	else a[0] = a[1] = a[2] = a[3] = NAN;
+}
+
+
+
+// ******  Building   *******
+
+void compactClear(typIF97CompactTable *table){
+	table->base = NULL;
+	table->a = NULL;
+}
+
+
+void compactFree(typIF97CompactTable *table){
+	free(table->base);
+	free(table->a);
+	compactClear(table);
+}
+
+
+// builds table, for property k of domain iDomain, on nx by ny nodes.  false if it cannot be allocated
+bool compactBuild(typIF97CompactTable *table, int iDomain, int k, int nx, int ny){
+	const typCompactDomain *dom = &compactDomains[iDomain];
+	int nb = (ny + IF97_COMPACT_BLOCK - 1) / IF97_COMPACT_BLOCK;
+	double *row, dblBase;
+	bool isOK = true;
+	long lNode;
+	int i, j, m, b;
+
+	table->nx = nx;
+	table->ny = ny;
+	table->x0 = log(dom->pLo_MPa);
+	table->x1 = log(dom->pHi_MPa);
+	table->dblRdx = nx - 1;
+	table->dblRdy = ny - 1;
+	table->dblErr = INFINITY;
+	table->base = malloc((long) nx * nb * sizeof(double));
+	table->a = malloc((long) nx * ny * COMPACT_TERMS * sizeof(float));
+	if ((table->base == NULL) || (table->a == NULL)) return false;
+
+	#pragma omp parallel for private(j, m, b, lNode, row, dblBase)  // the rows are independent
+	for (i = 0; i < nx; i++) {
+		row = malloc(ny * COMPACT_TERMS * sizeof(double));
+		if (row == NULL) {
+			isOK = false;
+			continue;
+		}
+		for (j = 0; j < ny; j++)
+			compactNode(iDomain, k, i / table->dblRdx, j / table->dblRdy, 1.0 / table->dblRdx, 1.0 / table->dblRdy,
+					row + j * COMPACT_TERMS);
+
+		// each block of nodes is offset by the value at its last finite node
+		for (b = 0; b < nb; b++) {
+			for (j = ((b + 1) * IF97_COMPACT_BLOCK < ny) ? (b + 1) * IF97_COMPACT_BLOCK - 1 : ny - 1, dblBase = 0.0;
+					j >= b * IF97_COMPACT_BLOCK; j--) {
+				if (isfinite(row[j * COMPACT_TERMS])) {
+					dblBase = row[j * COMPACT_TERMS];
+					break;
+				}
+			}
+			table->base[(long) i * nb + b] = dblBase;
+			for (j = b * IF97_COMPACT_BLOCK; (j < (b + 1) * IF97_COMPACT_BLOCK) && (j < ny); j++) {
+				lNode = ((long) i * ny + j) * COMPACT_TERMS;
+				row[j * COMPACT_TERMS] -= dblBase;
+				for (m = 0; m < COMPACT_TERMS; m++) table->a[lNode + m] = (float) row[j * COMPACT_TERMS + m];
+				for (m = 0; m < COMPACT_TERMS; m++) if (!isfinite(table->a[lNode + m])) table->a[lNode] = NAN;  // overflows the float
+			}
+		}
+		free(row);
+	}
+	return isOK;
+}
+
+
+
+// ******  Look-up   *******
+
+// the interpolant of table at (w,y), NAN if a node of its cell is not finite
+double compactEval(const typIF97CompactTable *table, double w, double y){
+	int nb = (table->ny + IF97_COMPACT_BLOCK - 1) / IF97_COMPACT_BLOCK;
+	double dblI = w * table->dblRdx, dblJ = y * table->dblRdy;
+	double t, u, ht[2], gt[2], hu[2], gu[2], z = 0.0;
+	const float *a;
+	int i, j, ia, ib;
+
+	i = (int) dblI;
+	if (i > table->nx - 2) i = table->nx - 2;
+	if (i < 0) i = 0;
+	j = (int) dblJ;
+	if (j > table->ny - 2) j = table->ny - 2;
+	if (j < 0) j = 0;
+	t = dblI - i;
+	u = dblJ - j;
+
+	ht[0] = (1.0 + 2.0 * t) * (1.0 - t) * (1.0 - t);
+	ht[1] = t * t * (3.0 - 2.0 * t);
+	gt[0] = t * (1.0 - t) * (1.0 - t);
+	gt[1] = -t * t * (1.0 - t);
+	hu[0] = (1.0 + 2.0 * u) * (1.0 - u) * (1.0 - u);
+	hu[1] = u * u * (3.0 - 2.0 * u);
+	gu[0] = u * (1.0 - u) * (1.0 - u);
+	gu[1] = -u * u * (1.0 - u);
+
+	for (ia = 0; ia < 2; ia++) {
+		for (ib = 0; ib < 2; ib++) {
+			a = table->a + ((long) (i + ia) * table->ny + j + ib) * COMPACT_TERMS;
+			z += hu[ib] * (ht[ia] * (table->base[(long) (i + ia) * nb + (j + ib) / IF97_COMPACT_BLOCK] + a[0]) + gt[ia] * a[1])
+					+ gu[ib] * (ht[ia] * a[2] + gt[ia] * a[3]);
+		}
+	}
+	return z;
+}
+
+
+// property k from tab at (p_MPa, t_K), NAN if outside the tables
+double compactPt(const typIF97Compact *tab, double p_MPa, double t_K, int k){
+	const typIF97CompactTable *table;
+	double tLo, tHi, z;
+	int iDomain = compactDomain(p_MPa, t_K, &tLo, &tHi);
+
+	if (iDomain < 0) return NAN;
+	table = &tab->table[iDomain][k];
+	if (table->a == NULL) return NAN;
+	z = compactEval(table, compactY(compactDomains[iDomain].iClusterX, (log(p_MPa) - table->x0) / (table->x1 - table->x0)),
+			compactY(compactDomains[iDomain].iCluster, (t_K - tLo) / (tHi - tLo)));
+	return (k == IF97_COMPACT_PROP_V) ? exp(z) : z;
+}
+
+
+
+// ******  Checking   *******
+
+// the difference of property k from table at (p_MPa, t_K) from if97_pt_.  Relative for v
+double compactError(const typIF97CompactTable *table, int k, double p_MPa, double t_K, double w, double y){
+	double z = compactEval(table, w, y);
+
+	if (isnan(z)) return INFINITY;
+	switch (k) {
+	case IF97_COMPACT_PROP_H: return fabs(z - if97_pt_h(p_MPa, t_K));
+	case IF97_COMPACT_PROP_V: return fabs(exp(z) / if97_pt_v(p_MPa, t_K) - 1.0);
+	case IF97_COMPACT_PROP_S: return fabs(z - if97_pt_s(p_MPa, t_K));
+	default: return fabs(z - if97_pt_u(p_MPa, t_K));
+	}
+}
+
+
+// the largest errors of table, for property k of domain iDomain, at the middle of the edges
+// along w, of those along y and of the cells, into err.  Only states in the domain are checked
+void compactCheck(const typIF97CompactTable *table, int iDomain, int k, double *err){
+	double *rowErr = malloc(table->nx * COMPACT_CHECKS * sizeof(double));
+	const typCompactDomain *dom = &compactDomains[iDomain];
+	double dw = 1.0 / table->dblRdx, dy = 1.0 / table->dblRdy, w, y, eta, dScratch, p_MPa, t_K, tLo, tHi, e;
+	int i, j, m;
+
+	if (rowErr == NULL) {
+		err[0] = err[1] = err[2] = INFINITY;
+		return;
+	}
+
+	#pragma omp parallel for private(j, m, w, y, eta, dScratch, p_MPa, t_K, tLo, tHi, e)  // the rows are independent
+	for (i = 0; i < table->nx; i++) {
+		rowErr[i * COMPACT_CHECKS] = rowErr[i * COMPACT_CHECKS + 1] = rowErr[i * COMPACT_CHECKS + 2] = 0.0;
+		for (j = 0; j < table->ny; j++) {
+			for (m = 0; m < COMPACT_CHECKS; m++) {
+				w = (i + ((m != 1) ? 0.5 : 0.0)) * dw;  // edges along w, along y, cells
+				y = (j + ((m != 0) ? 0.5 : 0.0)) * dy;
+				if ((w > 1.0) || (y > 1.0)) continue;
+				p_MPa = exp(table->x0 + (table->x1 - table->x0) * compactEta(dom->iClusterX, w, &dScratch));
+				eta = compactEta(dom->iCluster, y, &dScratch);
+				tLo = compactCurveT(dom->iLo, dom->tLo_K, p_MPa);
+				tHi = compactCurveT(dom->iHi, dom->tHi_K, p_MPa);
+				t_K = tLo + eta * (tHi - tLo);
+				if (compactDomain(p_MPa, t_K, &tLo, &tHi) != iDomain) continue;
+				e = compactError(table, k, p_MPa, t_K, w, y);
+				if (!(e <= rowErr[i * COMPACT_CHECKS + m])) rowErr[i * COMPACT_CHECKS + m] = e;
+			}
+		}
+	}
+
+	err[0] = err[1] = err[2] = 0.0;
+	for (i = 0; i < table->nx; i++)
+		for (m = 0; m < COMPACT_CHECKS; m++)
+			if (!(rowErr[i * COMPACT_CHECKS + m] <= err[m])) err[m] = rowErr[i * COMPACT_CHECKS + m];
+	free(rowErr);
+}
+
+
+// factor by which to multiply the nodes along an axis on which the error err was found, for a
+// bound dblTol.  The interpolant's error falls as the fourth power of the spacing
+double compactRefine(double err, double dblTol){
+	double dblFactor;
+
+	if (err <= dblTol) return 1.0;
+	dblFactor = 1.1 * pow(err / dblTol, 0.25);
+	if (!(dblFactor <= 4.0)) return 4.0;
+	return (dblFactor < 1.25) ? 1.25 : dblFactor;
+}
+
+
+
+// ******  External   *******
+
+int if97_compact_init(typIF97Compact *tab, const typIF97CompactSpec *spec){
+	const typIF97CompactSpec defaultSpec = {IF97_COMPACT_TOL_H, IF97_COMPACT_TOL_V, IF97_COMPACT_TOL_S, IF97_COMPACT_TOL_U};
+	typIF97CompactTable *table;
+	double dblTol[IF97_COMPACT_NPROPS], err[COMPACT_CHECKS], fx, fy;
+	int iDomain, k, nx, ny, iFail = 0;
+
+	for (iDomain = 0; iDomain < IF97_COMPACT_DOMAINS; iDomain++)
+		for (k = 0; k < IF97_COMPACT_NPROPS; k++) compactClear(&tab->table[iDomain][k]);
+	tab->lBytes = 0;
+	tab->spec = (spec == NULL) ? defaultSpec : *spec;
+	dblTol[IF97_COMPACT_PROP_H] = tab->spec.dblTolH;
+	dblTol[IF97_COMPACT_PROP_V] = tab->spec.dblTolV;
+	dblTol[IF97_COMPACT_PROP_S] = tab->spec.dblTolS;
+	dblTol[IF97_COMPACT_PROP_U] = tab->spec.dblTolU;
+	for (k = 0; k < IF97_COMPACT_NPROPS; k++) if (!((dblTol[k] > 0.0) && isfinite(dblTol[k]))) return SOLVE_NOT_DEFINED;
+
+	// each table from coarse, refined along w and y as the errors found there require
+	for (iDomain = 0; (iDomain < IF97_COMPACT_DOMAINS) && (iFail == 0); iDomain++) {
+		for (k = 0; (k < IF97_COMPACT_NPROPS) && (iFail == 0); k++) {
+			table = &tab->table[iDomain][k];
+			for (nx = ny = IF97_COMPACT_N0; iFail == 0; ) {
+				if (!compactBuild(table, iDomain, k, nx, ny)) {
+					iFail = SOLVE_NO_MEMORY;
+					break;
+				}
+				compactCheck(table, iDomain, k, err);
+				if ((err[0] <= dblTol[k]) && (err[1] <= dblTol[k]) && (err[2] <= dblTol[k])) {
+					table->dblErr = (err[0] > err[1]) ? ((err[0] > err[2]) ? err[0] : err[2]) : ((err[1] > err[2]) ? err[1] : err[2]);
+					break;
+				}
+				fx = compactRefine(err[0], dblTol[k]);
+				fy = compactRefine(err[1], dblTol[k]);
+				if ((fx == 1.0) && (fy == 1.0)) fx = fy = compactRefine(err[2], dblTol[k]);
+				compactFree(table);
+				nx = (int) ceil((nx - 1) * fx) + 1;
+				ny = (int) ceil((ny - 1) * fy) + 1;
+				if ((nx > IF97_COMPACT_NMAX) || (ny > IF97_COMPACT_NMAX)) iFail = SOLVE_NO_CONVERGE;
+			}
+			if (iFail == 0)
+				tab->lBytes += (size_t) table->nx * ((table->ny + IF97_COMPACT_BLOCK - 1) / IF97_COMPACT_BLOCK) * sizeof(double)
+						+ (size_t) table->nx * table->ny * COMPACT_TERMS * sizeof(float);
+		}
+	}
+
+	if (iFail != 0) if97_compact_free(tab);
+	return iFail;
+}
+
+
+void if97_compact_free(typIF97Compact *tab){
+	int iDomain, k;
+
+	for (iDomain = 0; iDomain < IF97_COMPACT_DOMAINS; iDomain++)
+		for (k = 0; k < IF97_COMPACT_NPROPS; k++) compactFree(&tab->table[iDomain][k]);
+	tab->lBytes = 0;
+}
+
+
+
+double if97_compact_pt_h(const typIF97Compact *tab, double p_MPa, double t_K){
+	double z = compactPt(tab, p_MPa, t_K, IF97_COMPACT_PROP_H);
+
+	if (isnan(z)) return if97_pt_h(p_MPa, t_K);
+	return z;
+}
+
+
+double if97_compact_pt_v(const typIF97Compact *tab, double p_MPa, double t_K){
+	double z = compactPt(tab, p_MPa, t_K, IF97_COMPACT_PROP_V);
+
+	if (isnan(z)) return if97_pt_v(p_MPa, t_K);
+	return z;
+}
+
+
+double if97_compact_pt_s(const typIF97Compact *tab, double p_MPa, double t_K){
+	double z = compactPt(tab, p_MPa, t_K, IF97_COMPACT_PROP_S);
+
+	if (isnan(z)) return if97_pt_s(p_MPa, t_K);
+	return z;
+}
+
+
+double if97_compact_pt_u(const typIF97Compact *tab, double p_MPa, double t_K){
+	double z = compactPt(tab, p_MPa, t_K, IF97_COMPACT_PROP_U);
+
+	if (isnan(z)) return if97_pt_u(p_MPa, t_K);
+	return z;
+}
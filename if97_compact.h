@@ -0,0 +1,133 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Compact, cache resident tables of h, v, s and u on (p,T) in regions 1 and 2
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_compact.h
+ * @author Martin Lord
+ * @brief h, v, s and u from (p,T) in regions 1 and 2, from tables small enough to stay in cache
+ * @details
+ * Regions 1 and 2 are each split at IF97_B23_LPRESS into two domains, bounded by two
+ * pressures and by two curves between them:  273.15 K, the saturation line or 623.15 K for
+ * region 1, and the saturation line or the B23 line and 1073.15 K for region 2.  Within a
+ * domain the coordinates are x = ln p and eta = (T - T_lo(p)) / (T_hi(p) - T_lo(p)), which
+ * runs from 0 to 1 across it, so that the grid follows the region's boundaries and no cell
+ * reaches far past them, where the equations of the other regions, continued, soon diverge.
+ * The domains run from the triple point pressure to 100 MPa.  \n
+ *
+ * Each property of each domain has its own table, of nodes on a regular grid of w against
+ * y, from which x and eta are quadratic, closing the nodes up towards the critical point,
+ * where the properties change fastest.  At each node are kept the property (ln v for v) and
+ * its derivatives in w, in y and in both, each scaled by the node spacing, the first from the
+ * analytic derivatives
+ * (if97_deriv.h), the mixed by differencing them.  A look-up is the bicubic Hermite
+ * interpolant over the cell about the state:  C1 continuous, and exact for cubics.  \n
+ *
+ * The terms are stored as float rather than double, the property itself relative to an offset
+ * (a double) shared by IF97_COMPACT_BLOCK nodes along eta, so that the offset, not the float,
+ * carries its magnitude.  A node takes 16 bytes.  The interpolation is in double.  The
+ * region of a state is found as region_pt finds it, so as if97_pt_ would, and states in
+ * region 3 or 5, or outside the domains, are given by if97_pt_h and so on.  \n
+ *
+ * The resolution of each table is chosen by if97_compact_init to meet the error bound of
+ * typIF97CompactSpec for its property:  starting coarse, the table is built and compared
+ * with if97_pt_ at the middle of every edge and every cell, and its nodes along w and
+ * along y multiplied as the errors found there require, until the largest error is within
+ * the bound.  With the default bounds the tables take about 1 MB, and some seconds to build.
+ *
+ * UNITS  p: MPa, T: K, v: m3/kg, h, u: kJ/kg, s: kJ/kg/K
+ */
+
+
+#ifndef IF97_COMPACT_H
+#define IF97_COMPACT_H
+
+#include <stddef.h>
+
+
+#define IF97_COMPACT_TOL_H 1e-3  // kJ/kg  default error bounds
+#define IF97_COMPACT_TOL_V 1e-6  // relative
+#define IF97_COMPACT_TOL_S 1e-6  // kJ/kg/K
+#define IF97_COMPACT_TOL_U 1e-3  // kJ/kg
+#define IF97_COMPACT_N0 16  // nodes along w and y of the first, coarse, table
+#define IF97_COMPACT_NMAX 2048  // most nodes along either
+#define IF97_COMPACT_BLOCK 8  // nodes along y sharing an offset
+#define IF97_COMPACT_DOMAINS 4  // region 1 below and above IF97_B23_LPRESS, region 2 below and above
+
+
+// the tabulated properties
+enum if97_compact_prop_t {
+	IF97_COMPACT_PROP_H = 0,
+	IF97_COMPACT_PROP_V = 1,  // as ln v
+	IF97_COMPACT_PROP_S = 2,
+	IF97_COMPACT_PROP_U = 3,
+	IF97_COMPACT_NPROPS = 4,
+};
+
+
+/** error bounds of the tables, each the largest difference from if97_pt_ allowed */
+typedef struct sctIF97CompactSpec {
+	double dblTolH;  // kJ/kg
+	double dblTolV;  // relative
+	double dblTolS;  // kJ/kg/K
+	double dblTolU;  // kJ/kg
+} typIF97CompactSpec;
+
+
+/** one property of one domain, on nx by ny nodes evenly spaced from 0 to 1 in w and y, which give x and eta */
+typedef struct sctIF97CompactTable {
+	int nx;
+	int ny;
+	double x0;  // ln p at w = 0
+	double x1;  // ln p at w = 1
+	double dblRdx;  // 1 / spacing of the nodes in w
+	double dblRdy;  // in y
+	double dblErr;  // largest difference from if97_pt_ found in checking it
+	double *base;  // base[i nb + j / IF97_COMPACT_BLOCK] is the offset of node (i,j), nb the blocks along y
+	float *a;  // a[4 (i ny + j) + m], m = 0 to 3, the property less its offset, z_w dw, z_y dy and z_w_y dw dy at node (i,j)
+} typIF97CompactTable;
+
+
+/** the tables of the domains of regions 1 and 2 */
+typedef struct sctIF97Compact {
+	typIF97CompactSpec spec;
+	size_t lBytes;  // memory of the tables
+	typIF97CompactTable table[IF97_COMPACT_DOMAINS][IF97_COMPACT_NPROPS];
+} typIF97Compact;
+
+
+/** builds the tables in tab, to the error bounds of spec, or of IF97_COMPACT_TOL_* if spec is NULL.
+ * Returns SOLVE_CONVERGE (0) if they were built, SOLVE_NO_MEMORY if they could not be allocated,
+ * SOLVE_NO_CONVERGE if a bound cannot be met within IF97_COMPACT_NMAX nodes, or SOLVE_NOT_DEFINED
+ * if a bound is not positive.  Unless built, tab holds no memory */
+int if97_compact_init(typIF97Compact *tab, const typIF97CompactSpec *spec);
+
+/** frees the tables of tab */
+void if97_compact_free(typIF97Compact *tab);
+
+
+/** specific enthalpy (kJ/kg) for a given p_MPa and t_K.  As if97_pt_h outside regions 1 and 2 */
+double if97_compact_pt_h(const typIF97Compact *tab, double p_MPa, double t_K);
+
+/** specific volume (m3/kg) for a given p_MPa and t_K.  As if97_pt_v outside regions 1 and 2 */
+double if97_compact_pt_v(const typIF97Compact *tab, double p_MPa, double t_K);
+
+/** specific entropy (kJ/kg/K) for a given p_MPa and t_K.  As if97_pt_s outside regions 1 and 2 */
+double if97_compact_pt_s(const typIF97Compact *tab, double p_MPa, double t_K);
+
+/** specific internal energy (kJ/kg) for a given p_MPa and t_K.  As if97_pt_u outside regions 1 and 2 */
+double if97_compact_pt_u(const typIF97Compact *tab, double p_MPa, double t_K);
+
+
+#endif // IF97_COMPACT_H
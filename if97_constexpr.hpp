@@ -0,0 +1,650 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    IAPWS-IF97 region equations unrolled at compile time (C++17)
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_constexpr.hpp
+ * @author Martin Lord
+ * @brief IAPWS-IF97 compile time region equations (C++17 only)
+ * @details
+ * The coefficient tables of regions 1 to 5 as constexpr arrays, and the free
+ * energy derivatives as templates over the region and the order of differentiation.
+ * Each sum is expanded by the compiler into one term per table row, with the
+ * exponents and derivative factors known at compile time, so that a caller can
+ * inline steam properties into a hot loop.  Terms which the differentiation
+ * makes zero are dropped.  In a constant expression the integer powers are exact 
+ * products. \n
+ *
+ * Usage example: \n
+ *
+ * double gPT = if97::gibbs<if97::Region1, 1, 1>(pi, tau);   // [d2 gamma / d pi d tau] \n
+ * double h = if97::Region<2>::h(0.0035, 300.0);              // callers who know their region \n
+ *
+ * At run time each term is formed as the C library forms it, with pow() and its factors 
+ * multiplied in the same order, and the terms are summed in table order, so that results 
+ * agree with IF97_Region1.c to IF97_Region5.c single threaded to within 1 ulp.  (The C 
+ * sums' OpenMP reductions add in another order with more threads.)  Without 
+ * __builtin_is_constant_evaluated (GCC 9, Clang 9, MSVC 2019 16.5 on) the exact products 
+ * are used at run time too, and agree to within their rounding only.  The header uses 
+ * only the constants of IF97_common.h and can be used alongside the C API. \n
+ *
+ * UNITS  p: MPa, T: K, rho: kg/m3, v: m3/kg, h, u: kJ/kg, s, cp, cv: kJ/kg/K, w: m/s
+ *
+ * @see http://www.iapws.org/relguide/IF97-Rev.html
+ */
+
+
+#ifndef IF97_CONSTEXPR_HPP
+#define IF97_CONSTEXPR_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+extern "C" {
+#include "IF97_common.h"  //PSTAR TSTAR, IF97_R
+}
+
+
+// whether a constexpr function is being evaluated at compile time.  C++17 has no std::is_constant_evaluated
+#if defined(__has_builtin)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define IF97_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#endif
+#if !defined(IF97_CONSTANT_EVALUATED) && ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+	#define IF97_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#ifndef IF97_CONSTANT_EVALUATED
+	#define IF97_CONSTANT_EVALUATED() true
+#endif
+
+
+namespace if97 {
+
+
+//**************************************************************
+//********* COEFFICIENT TABLES *********************************
+/* copies of the tables in IF97_Region1.c to IF97_Region5.c, with the same
+ * numbering: row 0 is not used */
+
+namespace coeffs {
+
+struct IJn { int I; int J; double n; };
+struct Jn { int J; double n; };
+
+// see Table 2
+inline constexpr IJn gibbs_r1[] = {
+	 { 0, 0, 0.0 }  // 0
+	,{ 0, -2, 0.14632971213167E+00 }  // 1
+	,{ 0, -1, -0.84548187169114E+00 }  // 2
+	,{ 0, 0, -0.37563603672040E+01 }  // 3
+	,{ 0, 1, 0.33855169168385E+01 }  // 4
+	,{ 0, 2, -0.95791963387872E+00 }  // 5
+	,{ 0, 3, 0.15772038513228E+00 }  // 6
+	,{ 0, 4, -0.16616417199501E-01 }  // 7
+	,{ 0, 5, 0.81214629983568E-03 }  // 8
+	,{ 1, -9, 0.28319080123804E-03 }  // 9
+	,{ 1, -7, -0.60706301565874E-03 }  // 10
+	,{ 1, -1, -0.18990068218419E-01 }  // 11
+	,{ 1, 0, -0.32529748770505E-01 }  // 12
+	,{ 1, 1, -0.21841717175414E-01 }  // 13
+	,{ 1, 3, -0.52838357969930E-04 }  // 14
+	,{ 2, -3, -0.47184321073267E-03 }  // 15
+	,{ 2, 0, -0.30001780793026E-03 }  // 16
+	,{ 2, 1, 0.47661393906987E-04 }  // 17
+	,{ 2, 3, -0.44141845330846E-05 }  // 18
+	,{ 2, 17, -0.72694996297594E-15 }  // 19
+	,{ 3, -4, -0.31679644845054E-04 }  // 20
+	,{ 3, 0, -0.28270797985312E-05 }  // 21
+	,{ 3, 6, -0.85205128120103E-09 }  // 22
+	,{ 4, -5, -0.22425281908000E-05 }  // 23
+	,{ 4, -2, -0.65171222895601E-06 }  // 24
+	,{ 4, 10, -0.14341729937924E-12 }  // 25
+	,{ 5, -8, -0.40516996860117E-06 }  // 26
+	,{ 8, -11, -0.12734301741641E-08 }  // 27
+	,{ 8, -6, -0.17424871230634E-09 }  // 28
+	,{ 21, -29, -0.68762131295531E-18 }  // 29
+	,{ 23, -31, 0.14478307828521E-19 }  // 30
+	,{ 29, -38, 0.26335781662795E-22 }  // 31
+	,{ 30, -39, -0.11947622640071E-22 }  // 32
+	,{ 31, -40, 0.18228094581404E-23 }  // 33
+	,{ 32, -41, -0.93537087292458E-25 }  // 34
+};
+
+// see Table 10
+inline constexpr Jn gibbs_r2_o[] = {
+	 { 0, 0.0 }  // 0
+	,{ 0, -9.6927686500217 }  // 1
+	,{ 1, 10.086655968018 }  // 2
+	,{ -5, -0.0056087911283 }  // 3
+	,{ -4, 0.0714527380815 }  // 4
+	,{ -3, -0.4071049822393 }  // 5
+	,{ -2, 1.4240819171444 }  // 6
+	,{ -1, -4.383951131945 }  // 7
+	,{ 2, -0.2840863246077 }  // 8
+	,{ 3, 0.0212684637533 }  // 9
+};
+
+// see Table 11
+inline constexpr IJn gibbs_r2_r[] = {
+	 { 0, 0, 0.0 }  // 0
+	,{ 1, 0, -1.7731742473213E-003 }  // 1
+	,{ 1, 1, -1.7834862292358E-002 }  // 2
+	,{ 1, 2, -4.5996013696365E-002 }  // 3
+	,{ 1, 3, -5.7581259083432E-002 }  // 4
+	,{ 1, 6, -5.0325278727930E-002 }  // 5
+	,{ 2, 1, -3.3032641670203E-005 }  // 6
+	,{ 2, 2, -1.8948987516315E-004 }  // 7
+	,{ 2, 4, -3.9392777243355E-003 }  // 8
+	,{ 2, 7, -4.3797295650573E-002 }  // 9
+	,{ 2, 36, -2.6674547914087E-005 }  // 10
+	,{ 3, 0, 2.0481737692309E-008 }  // 11
+	,{ 3, 1, 4.3870667284435E-007 }  // 12
+	,{ 3, 3, -3.2277677238570E-005 }  // 13
+	,{ 3, 6, -1.5033924542148E-003 }  // 14
+	,{ 3, 35, -4.0668253562649E-002 }  // 15
+	,{ 4, 1, -7.8847309559367E-010 }  // 16
+	,{ 4, 2, 1.2790717852285E-008 }  // 17
+	,{ 4, 3, 4.8225372718507E-007 }  // 18
+	,{ 5, 7, 2.2922076337661E-006 }  // 19
+	,{ 6, 3, -1.6714766451061E-011 }  // 20
+	,{ 6, 16, -2.1171472321355E-003 }  // 21
+	,{ 6, 35, -2.3895741934104E+001 }  // 22
+	,{ 7, 0, -5.9059564324270E-018 }  // 23
+	,{ 7, 11, -1.2621808899101E-006 }  // 24
+	,{ 7, 25, -3.8946842435739E-002 }  // 25
+	,{ 8, 8, 1.1256211360459E-011 }  // 26
+	,{ 8, 36, -8.2311340897998E+000 }  // 27
+	,{ 9, 13, 1.9809712802088E-008 }  // 28
+	,{ 10, 4, 1.0406965210174E-019 }  // 29
+	,{ 10, 10, -1.0234747095929E-013 }  // 30
+	,{ 10, 14, -1.0018179379511E-009 }  // 31
+	,{ 16, 29, -8.0882908646985E-011 }  // 32
+	,{ 16, 50, 1.0693031879409E-001 }  // 33
+	,{ 18, 57, -3.3662250574171E-001 }  // 34
+	,{ 20, 20, 8.9185845355421E-025 }  // 35
+	,{ 20, 35, 3.0629316876232E-013 }  // 36
+	,{ 20, 48, -4.2002467698208E-006 }  // 37
+	,{ 21, 21, -5.9056029685639E-026 }  // 38
+	,{ 22, 53, 3.7826947613457E-006 }  // 39
+	,{ 23, 39, -1.2768608934681E-015 }  // 40
+	,{ 24, 26, 7.3087610595061E-029 }  // 41
+	,{ 24, 40, 5.5414715350778E-017 }  // 42
+	,{ 24, 58, -9.4369707241210E-007 }  // 43
+};
+
+// see Table 30
+inline constexpr IJn phi_r3[] = {
+	 { 0, 0, 0.0 }  // 0
+	,{ 0, 0, 0.10658070028513E1 }  // 1
+	,{ 0, 0, -0.15732845290239E2 }  // 2
+	,{ 0, 1, 0.20944396974307E2 }  // 3
+	,{ 0, 2, -0.76867707878716E1 }  // 4
+	,{ 0, 7, 0.26185947787954E1 }  // 5
+	,{ 0, 10, -0.28080781148620E1 }  // 6
+	,{ 0, 12, 0.12053369696517E1 }  // 7
+	,{ 0, 23, -0.84566812812502E-2 }  // 8
+	,{ 1, 2, -0.12654315477714E1 }  // 9
+	,{ 1, 6, -0.11524407806681E1 }  // 10
+	,{ 1, 15, 0.88521043984318 }  // 11
+	,{ 1, 17, -0.64207765181607 }  // 12
+	,{ 2, 0, 0.38493460186671 }  // 13
+	,{ 2, 2, -0.85214708824206 }  // 14
+	,{ 2, 6, 0.48972281541877E1 }  // 15
+	,{ 2, 7, -0.30502617256965E1 }  // 16
+	,{ 2, 22, 0.39420536879154E-1 }  // 17
+	,{ 2, 26, 0.12558408424308 }  // 18
+	,{ 3, 0, -0.27999329698710 }  // 19
+	,{ 3, 2, 0.13899799569460E1 }  // 20
+	,{ 3, 4, -0.20189915023570E1 }  // 21
+	,{ 3, 16, -0.82147637173963E-2 }  // 22
+	,{ 3, 26, -0.47596035734923 }  // 23
+	,{ 4, 0, 0.43984074473500E-1 }  // 24
+	,{ 4, 2, -0.44476435428739 }  // 25
+	,{ 4, 4, 0.90572070719733 }  // 26
+	,{ 4, 26, 0.70522450087967 }  // 27
+	,{ 5, 1, 0.10770512626332 }  // 28
+	,{ 5, 3, -0.32913623258954 }  // 29
+	,{ 5, 26, -0.50871062041158 }  // 30
+	,{ 6, 0, -0.22175400873096E-1 }  // 31
+	,{ 6, 2, 0.94260751665092E-1 }  // 32
+	,{ 6, 26, 0.16436278447961 }  // 33
+	,{ 7, 2, -0.13503372241348E-1 }  // 34
+	,{ 8, 26, -0.14834345352472E-1 }  // 35
+	,{ 9, 2, 0.57922953628084E-3 }  // 36
+	,{ 9, 26, 0.32308904703711E-2 }  // 37
+	,{ 10, 0, 0.80964802996215E-4 }  // 38
+	,{ 10, 1, -0.16557679795037E-3 }  // 39
+	,{ 11, 26, -0.44923899061815E-4 }  // 40
+};
+
+// see Table 34
+inline constexpr double sat_r4[] = {
+	 0.0  // 0
+	,0.11670521452767E4  // 1
+	,-0.72421316703206E6  // 2
+	,-0.17073846940092E2  // 3
+	,0.12020824702470E5  // 4
+	,-0.32325550322333E7  // 5
+	,0.14915108613530E2  // 6
+	,-0.48232657361591E4  // 7
+	,0.40511340542057E6  // 8
+	,-0.23855557567849  // 9
+	,0.65017534844798E3  // 10
+};
+
+// see Table 37
+inline constexpr Jn gibbs_r5_o[] = {
+	 { 0, 0.0 }  // 0
+	,{ 0, -0.13179983674201E2 }  // 1
+	,{ 1, 0.68540841634434E1 }  // 2
+	,{ -3, -0.24805148933466E-1 }  // 3
+	,{ -2, 0.36901534980333 }  // 4
+	,{ -1, -0.31161318213925E1 }  // 5
+	,{ 2, -0.32961626538917 }  // 6
+};
+
+// see Table 38
+inline constexpr IJn gibbs_r5_r[] = {
+	 { 0, 0, 0.0 }  // 0
+	,{ 1, 1, 0.15736404855259E-2 }  // 1
+	,{ 1, 2, 0.90153761673944E-3 }  // 2
+	,{ 1, 3, -0.50270077677648E-2 }  // 3
+	,{ 2, 3, 0.22440037409485E-5 }  // 4
+	,{ 2, 9, -0.41163275453471E-5 }  // 5
+	,{ 3, 7, 0.37919454822955E-7 }  // 6
+};
+
+} // namespace coeffs
+
+
+
+//**************************************************************
+//********* REGION TAGS ****************************************
+
+/** region N of the formulation.  Used as a tag by gibbs<> and helmholtz<>,
+ * and specialised below with the properties of each region */
+template <int N> struct Region;
+
+typedef Region<1> Region1;
+typedef Region<2> Region2;
+typedef Region<3> Region3;
+typedef Region<4> Region4;
+typedef Region<5> Region5;
+
+template <class R> struct region_number;
+template <int N> struct region_number<Region<N>> { static constexpr int value = N; };
+
+
+
+//**************************************************************
+//********* COMPILE TIME SUMS **********************************
+
+namespace detail {
+
+// x^E by repeated squaring, E known at compile time
+template <int E> constexpr double ipow (double x) {
+	if constexpr (E < 0) return 1.0 / ipow<-E>(x);
+	else if constexpr (E == 0) return 1.0;
+	else if constexpr (E == 1) return x;
+	else if constexpr (E % 2 == 0) { double r = ipow<E / 2>(x); return r * r; }
+	else return x * ipow<E - 1>(x);
+}
+
+// x^E as the C library takes it, with pow(), at run time, and as an exact product in a constant expression.
+// The exponent is read through a volatile so that the compiler cannot make pow(x, 2) into x * x, or
+// pow(x, -1) into 1 / x, which may round otherwise than pow() on the C library's table exponents
+template <int E> constexpr double cpow (double x) {
+	if (IF97_CONSTANT_EVALUATED()) return ipow<E>(x);
+	volatile double e = E;
+	return std::pow(x, e);
+}
+
+// the factor E (E-1) ... (E-D+1) from differentiating x^E D times
+constexpr double falling (int E, int D) {
+	double r = 1.0;
+	for (int k = 0; k < D; k++) r *= E - k;
+	return r;
+}
+
+// x E (E-1) ... (E-D+1), multiplied in one factor at a time, as the C library does
+template <int E, int D> constexpr double times_falling (double x) {
+	if constexpr (D == 0) return x;
+	else return times_falling<E, D - 1>(x) * (double) (E - D + 1);
+}
+
+// [d^DA / d a^DA] [d^DB / d b^DB] of n a^I b^J, row K of an IJn table.  The factors are multiplied
+// in the order of the C sums of regions 2, 3 and 5: n, those of a, a^(I-DA), those of b, b^(J-DB)
+template <const auto &Table, std::size_t K, int DA, int DB>
+constexpr double term_ij (double a, double b) {
+	constexpr coeffs::IJn c = Table[K];
+	if constexpr (falling(c.I, DA) * falling(c.J, DB) == 0.0) return 0.0;
+	else return times_falling<c.J, DB>(times_falling<c.I, DA>(c.n) * cpow<c.I - DA>(a)) * cpow<c.J - DB>(b);
+}
+
+// row K of region 1, a = 7.1 - pi, b = tau - 1.222, with each derivative grouped as IF97_Region1.c groups it
+template <std::size_t K, int DPi, int DTau>
+constexpr double term_r1 (double a, double b) {
+	constexpr coeffs::IJn c = coeffs::gibbs_r1[K];
+	constexpr double n = (DPi % 2) ? -c.n : c.n;  // sign from differentiating (7.1 - pi)
+	if constexpr (falling(c.I, DPi) * falling(c.J, DTau) == 0.0) return 0.0;
+	else if constexpr (DTau == 0) return times_falling<c.I, DPi>(n) * (cpow<c.I - DPi>(a) * cpow<c.J>(b));
+	else if constexpr (DPi == 0 && DTau == 1) return times_falling<c.J, 1>(n * cpow<c.I>(a)) * cpow<c.J - 1>(b);
+	else if constexpr (DPi == 0 && DTau == 2) return n * (times_falling<c.J, 2>(cpow<c.I>(a)) * cpow<c.J - 2>(b));
+	else if constexpr (DPi == 1 && DTau == 1) return -(c.n * c.I * (times_falling<c.J, 1>(cpow<c.I - 1>(a)) * cpow<c.J - 1>(b)));
+	else return term_ij<coeffs::gibbs_r1, K, DPi, DTau>(a, b) * ((DPi % 2) ? -1.0 : 1.0);
+}
+
+// [d^DB / d b^DB] of n b^J, row K of a Jn table, as term_ij
+template <const auto &Table, std::size_t K, int DB>
+constexpr double term_j (double b) {
+	constexpr coeffs::Jn c = Table[K];
+	if constexpr (falling(c.J, DB) == 0.0) return 0.0;
+	else return times_falling<c.J, DB>(c.n) * cpow<c.J - DB>(b);
+}
+
+// rows First to the end of the table, summed in order
+template <const auto &Table, std::size_t First, int DA, int DB, std::size_t... K>
+constexpr double sum_ij (double a, double b, std::index_sequence<K...>) {
+	return (0.0 + ... + term_ij<Table, First + K, DA, DB>(a, b));
+}
+
+template <const auto &Table, std::size_t First, int DA, int DB>
+constexpr double sum_ij (double a, double b) {
+	constexpr std::size_t rows = sizeof(Table) / sizeof(Table[0]);
+	return sum_ij<Table, First, DA, DB>(a, b, std::make_index_sequence<rows - First>());
+}
+
+template <int DPi, int DTau, std::size_t... K>
+constexpr double sum_r1 (double a, double b, std::index_sequence<K...>) {
+	return (0.0 + ... + term_r1<1 + K, DPi, DTau>(a, b));
+}
+
+template <const auto &Table, int DB, std::size_t... K>
+constexpr double sum_j (double b, std::index_sequence<K...>) {
+	return (0.0 + ... + term_j<Table, 1 + K, DB>(b));
+}
+
+template <const auto &Table, int DB>
+constexpr double sum_j (double b) {
+	constexpr std::size_t rows = sizeof(Table) / sizeof(Table[0]);
+	return sum_j<Table, DB>(b, std::make_index_sequence<rows - 1>());
+}
+
+// [d^D / d x^D] of ln(x), D > 0
+template <int D> constexpr double dlog (double x) {
+	return ((D % 2) ? 1.0 : -1.0) * falling(D - 1, D - 1) / ipow<D>(x);
+}
+
+} // namespace detail
+
+
+
+//**************************************************************
+//********* FREE ENERGY DERIVATIVES ****************************
+
+/** residual part of the dimensionless Gibbs free energy, [d^DPi / d pi^DPi] [d^DTau / d tau^DTau].
+ * Region 1 has no ideal gas part, so this is the whole of gamma */
+template <class R, int DPi, int DTau>
+constexpr double gibbs_r (double pi, double tau) {
+	constexpr int N = region_number<R>::value;
+	static_assert(N == 1 || N == 2 || N == 5, "gibbs: regions 1, 2 and 5 only");
+
+	if constexpr (N == 1)
+		return detail::sum_r1<DPi, DTau>(7.1 - pi, tau - 1.222, std::make_index_sequence<sizeof(coeffs::gibbs_r1) / sizeof(coeffs::IJn) - 1>());
+	else if constexpr (N == 2)
+		return detail::sum_ij<coeffs::gibbs_r2_r, 1, DPi, DTau>(pi, tau - 0.5);
+	else
+		return detail::sum_ij<coeffs::gibbs_r5_r, 1, DPi, DTau>(pi, tau);
+}
+
+
+/** ideal gas part of the dimensionless Gibbs free energy in regions 2 and 5 */
+template <class R, int DPi, int DTau>
+inline double gibbs_o (double pi, double tau) {
+	constexpr int N = region_number<R>::value;
+	static_assert(N == 2 || N == 5, "gibbs_o: regions 2 and 5 only");
+
+	if constexpr (DTau == 0 && DPi > 0) return detail::dlog<DPi>(pi);
+	else if constexpr (DPi > 0) return 0.0;
+	else if constexpr (N == 2) return ((DTau == 0) ? std::log(pi) : 0.0) + detail::sum_j<coeffs::gibbs_r2_o, DTau>(tau);
+	else return ((DTau == 0) ? std::log(pi) : 0.0) + detail::sum_j<coeffs::gibbs_r5_o, DTau>(tau);
+}
+
+
+/** dimensionless Gibbs free energy gamma(pi, tau) of region 1, 2 or 5,
+ * [d^DPi / d pi^DPi] [d^DTau / d tau^DTau] */
+template <class R, int DPi, int DTau>
+inline double gibbs (double pi, double tau) {
+	if constexpr (region_number<R>::value == 1) return gibbs_r<R, DPi, DTau>(pi, tau);
+	else return gibbs_o<R, DPi, DTau>(pi, tau) + gibbs_r<R, DPi, DTau>(pi, tau);
+}
+
+
+/** dimensionless Helmholtz free energy phi(delta, tau) of region 3,
+ * [d^DDelta / d delta^DDelta] [d^DTau / d tau^DTau] */
+template <class R, int DDelta, int DTau>
+inline double helmholtz (double delta, double tau) {
+	static_assert(region_number<R>::value == 3, "helmholtz: region 3 only");
+	constexpr double n1 = coeffs::phi_r3[1].n;
+
+	// the first term is n1 ln(delta)
+	if constexpr (DDelta == 0 && DTau == 0) 
+		return n1 * std::log(delta) + detail::sum_ij<coeffs::phi_r3, 2, 0, 0>(delta, tau);
+	else if constexpr (DDelta == 1 && DTau == 0)
+		return n1 / delta + detail::sum_ij<coeffs::phi_r3, 2, 1, 0>(delta, tau);
+	else if constexpr (DDelta == 2 && DTau == 0)
+		return -n1 / (delta * delta) + detail::sum_ij<coeffs::phi_r3, 2, 2, 0>(delta, tau);
+	else if constexpr (DTau == 0)
+		return n1 * detail::dlog<DDelta>(delta) + detail::sum_ij<coeffs::phi_r3, 2, DDelta, 0>(delta, tau);
+	else
+		return detail::sum_ij<coeffs::phi_r3, 2, DDelta, DTau>(delta, tau);
+}
+
+
+
+//**************************************************************
+//********* REGION DISPATCH ************************************
+/* the property equations as written in the C library, so that
+ * Region<N>::h (p, T) and if97_rN_h (p, T) are the same sum */
+
+/** region 1 properties at (p, T) */
+template <> struct Region<1> {
+	static double gPi (double pi, double tau) { return gibbs<Region1, 1, 0>(pi, tau); }
+	static double gPiPi (double pi, double tau) { return gibbs<Region1, 2, 0>(pi, tau); }
+	static double gTau (double pi, double tau) { return gibbs<Region1, 0, 1>(pi, tau); }
+	static double gTauTau (double pi, double tau) { return gibbs<Region1, 0, 2>(pi, tau); }
+	static double gPiTau (double pi, double tau) { return gibbs<Region1, 1, 1>(pi, tau); }
+
+	static double g (double p, double t) { return IF97_R * t * gibbs<Region1, 0, 0>(p / PSTAR_R1, TSTAR_R1 / t); }
+
+	static double v (double p, double t) {
+		double pi = p / PSTAR_R1;
+		return (IF97_R * 1000 * t / (p * 1e6)) * pi * gPi(pi, TSTAR_R1 / t);
+	}
+
+	static double u (double p, double t) {
+		double pi = p / PSTAR_R1, tau = TSTAR_R1 / t;
+		return (IF97_R * t) * (tau * gTau(pi, tau) - pi * gPi(pi, tau));
+	}
+
+	static double s (double p, double t) {
+		double pi = p / PSTAR_R1, tau = TSTAR_R1 / t;
+		return IF97_R * (tau * gTau(pi, tau) - gibbs<Region1, 0, 0>(pi, tau));
+	}
+
+	static double h (double p, double t) {
+		double pi = p / PSTAR_R1, tau = TSTAR_R1 / t;
+		return IF97_R * t * tau * gTau(pi, tau);
+	}
+
+	static double cp (double p, double t) {
+		double pi = p / PSTAR_R1, tau = TSTAR_R1 / t;
+		return -IF97_R * tau * tau * gTauTau(pi, tau);
+	}
+
+	static double cv (double p, double t) {
+		double pi = p / PSTAR_R1, tau = TSTAR_R1 / t;
+		double a = gPi(pi, tau) - tau * gPiTau(pi, tau);
+		return IF97_R * (-(tau * tau * gTauTau(pi, tau)) + (a * a / gPiPi(pi, tau)));
+	}
+
+	static double w (double p, double t) {
+		double pi = p / PSTAR_R1, tau = TSTAR_R1 / t;
+		double gp = gPi(pi, tau);
+		double a = gp - tau * gPiTau(pi, tau);
+		return std::sqrt((IF97_R * 1000 * t * (gp * gp)) / ((a * a / (tau * tau * gTauTau(pi, tau))) - gPiPi(pi, tau)));
+	}
+};
+
+
+// regions 2 and 5 have the same form: an ideal gas part and a residual part
+template <int N, class Scale> struct GibbsIdealRegion {
+	typedef Region<N> R;
+
+	static double g (double p, double t) { return IF97_R * t * gibbs<R, 0, 0>(p / Scale::pstar, Scale::tstar / t); }
+
+	static double v (double p, double t) {
+		double pi = p / Scale::pstar, tau = Scale::tstar / t;
+		return (IF97_R * 1000 * t / (p * 1e6)) * pi * (gibbs_o<R, 1, 0>(pi, tau) + gibbs_r<R, 1, 0>(pi, tau));
+	}
+
+	static double u (double p, double t) {
+		double pi = p / Scale::pstar, tau = Scale::tstar / t;
+		return (IF97_R * t) * ((tau * (gibbs_o<R, 0, 1>(pi, tau) + gibbs_r<R, 0, 1>(pi, tau)))
+				- (pi * (gibbs_o<R, 1, 0>(pi, tau) + gibbs_r<R, 1, 0>(pi, tau))));
+	}
+
+	static double s (double p, double t) {
+		double pi = p / Scale::pstar, tau = Scale::tstar / t;
+		return IF97_R * (tau * (gibbs_o<R, 0, 1>(pi, tau) + gibbs_r<R, 0, 1>(pi, tau)) - gibbs<R, 0, 0>(pi, tau));
+	}
+
+	static double h (double p, double t) {
+		double pi = p / Scale::pstar, tau = Scale::tstar / t;
+		return IF97_R * t * tau * (gibbs_o<R, 0, 1>(pi, tau) + gibbs_r<R, 0, 1>(pi, tau));
+	}
+
+	static double cp (double p, double t) {
+		double pi = p / Scale::pstar, tau = Scale::tstar / t;
+		return -IF97_R * (tau * tau) * (gibbs_o<R, 0, 2>(pi, tau) + gibbs_r<R, 0, 2>(pi, tau));
+	}
+
+	static double cv (double p, double t) {
+		double pi = p / Scale::pstar, tau = Scale::tstar / t;
+		double a = 1.0 + pi * gibbs_r<R, 1, 0>(pi, tau) - tau * pi * gibbs_r<R, 1, 1>(pi, tau);
+		return IF97_R * ((-(tau * tau) * (gibbs_o<R, 0, 2>(pi, tau) + gibbs_r<R, 0, 2>(pi, tau)))
+				- (a * a / (1.0 - (pi * pi) * gibbs_r<R, 2, 0>(pi, tau))));
+	}
+
+	static double w (double p, double t) {
+		double pi = p / Scale::pstar, tau = Scale::tstar / t;
+		double gp = gibbs_r<R, 1, 0>(pi, tau);
+		double a = 1.0 + pi * gp - tau * pi * gibbs_r<R, 1, 1>(pi, tau);
+		return std::sqrt(IF97_R * 1000 * t * ((1.0 + 2.0 * pi * gp + (pi * pi) * (gp * gp)) /
+				((1.0 - (pi * pi) * gibbs_r<R, 2, 0>(pi, tau)) +
+				 (a * a / ((tau * tau) * (gibbs_o<R, 0, 2>(pi, tau) + gibbs_r<R, 0, 2>(pi, tau)))))));
+	}
+};
+
+struct Region2Scale { static constexpr double pstar = PSTAR_R2, tstar = TSTAR_R2; };
+struct Region5Scale { static constexpr double pstar = PSTAR_R5, tstar = TSTAR_R5; };
+
+/** region 2 properties at (p, T) */
+template <> struct Region<2> : GibbsIdealRegion<2, Region2Scale> {};
+
+/** region 5 properties at (p, T) */
+template <> struct Region<5> : GibbsIdealRegion<5, Region5Scale> {};
+
+
+/** region 3 properties at (rho, T) */
+template <> struct Region<3> {
+	static double phiD (double d, double tau) { return helmholtz<Region3, 1, 0>(d, tau); }
+	static double phiDD (double d, double tau) { return helmholtz<Region3, 2, 0>(d, tau); }
+	static double phiT (double d, double tau) { return helmholtz<Region3, 0, 1>(d, tau); }
+	static double phiTT (double d, double tau) { return helmholtz<Region3, 0, 2>(d, tau); }
+	static double phiDT (double d, double tau) { return helmholtz<Region3, 1, 1>(d, tau); }
+
+	static double p (double rho, double t) {
+		double d = rho / IF97_RHOC;
+		return 0.001 * rho * IF97_R * t * d * phiD(d, IF97_TC / t);
+	}
+
+	static double u (double rho, double t) {
+		double tau = IF97_TC / t;
+		return IF97_R * t * tau * phiT(rho / IF97_RHOC, tau);
+	}
+
+	static double s (double rho, double t) {
+		double d = rho / IF97_RHOC, tau = IF97_TC / t;
+		return IF97_R * (tau * phiT(d, tau) - helmholtz<Region3, 0, 0>(d, tau));
+	}
+
+	static double h (double rho, double t) {
+		double d = rho / IF97_RHOC, tau = IF97_TC / t;
+		return IF97_R * t * (tau * phiT(d, tau) + d * phiD(d, tau));
+	}
+
+	static double cv (double rho, double t) {
+		double tau = IF97_TC / t;
+		return -IF97_R * ((tau * tau) * phiTT(rho / IF97_RHOC, tau));
+	}
+
+	static double cp (double rho, double t) {
+		double d = rho / IF97_RHOC, tau = IF97_TC / t;
+		double pd = phiD(d, tau);
+		double a = d * pd - d * tau * phiDT(d, tau);
+		return IF97_R * (-(tau * tau) * phiTT(d, tau) + a * a / (2.0 * d * pd + (d * d) * phiDD(d, tau)));
+	}
+
+	static double w (double rho, double t) {
+		double d = rho / IF97_RHOC, tau = IF97_TC / t;
+		double pd = phiD(d, tau);
+		double a = d * pd - d * tau * phiDT(d, tau);
+		return std::sqrt(IF97_R * 1000.0 * t * (2.0 * d * pd + (d * d) * phiDD(d, tau) - (a * a) / ((tau * tau) * phiTT(d, tau))));
+	}
+};
+
+
+/** region 4, the saturation line */
+template <> struct Region<4> {
+	/** saturation pressure (MPa) at temperature T (K) */
+	static double ps (double t) {
+		constexpr const auto &n = coeffs::sat_r4;
+		double th = t + n[9] / (t - n[10]);
+		double A = th * th + n[1] * th + n[2];
+		double B = n[3] * (th * th) + n[4] * th + n[5];
+		double C = n[6] * (th * th) + n[7] * th + n[8];
+		double r = 2 * C / (-B + std::sqrt(B * B - 4 * A * C));
+		r = r * r;
+		return r * r;
+	}
+
+	/** saturation temperature (K) at pressure p (MPa) */
+	static double ts (double p) {
+		constexpr const auto &n = coeffs::sat_r4;
+		double b = std::pow(p, 0.25);
+		double E = b * b + n[3] * b + n[6];
+		double F = n[1] * (b * b) + n[4] * b + n[7];
+		double G = n[2] * (b * b) + n[5] * b + n[8];
+		double D = 2 * G / (-F - std::sqrt(F * F - 4 * E * G));
+		return 0.5 * (n[10] + D - std::sqrt((n[10] + D) * (n[10] + D) - 4 * (n[9] + n[10] * D)));
+	}
+};
+
+
+} // namespace if97
+
+#endif // IF97_CONSTEXPR_HPP
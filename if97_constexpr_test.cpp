@@ -0,0 +1,335 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* A SHORT PROGRAMME TO CHECK THE COMPILE TIME REGION EQUATIONS AGAINST THE C LIBRARY
+* *******************************************************************************/
+
+#include "if97_constexpr.hpp"
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <climits>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+extern "C" {
+#include "IF97_Region1.h"
+#include "IF97_Region2.h"
+#include "IF97_Region3.h"
+#include "IF97_Region4.h"
+#include "IF97_Region5.h"
+#include "if97_lib.h"
+#include "if97_test_points.h"
+
+	// coefficient tables and free energy sums of the C library
+	extern const typIF97Coeffs_IJn GIBBS_COEFFS_R1[];
+	extern const int MAX_GIBBS_COEFFS_R1;
+	extern const typIF97Coeffs_Jn GIBBS_COEFFS_R2_O[];
+	extern const int MAX_GIBBS_COEFFS_R2_O;
+	extern const typIF97Coeffs_IJn GIBBS_COEFFS_R2_R[];
+	extern const int MAX_GIBBS_COEFFS_R2_R;
+	extern const typIF97Coeffs_IJn PHI_COEFFS_R3[];
+	extern const int MAX_COEFFS_PHI_R3;
+	extern const double IF97_R3_n[];
+	extern const typIF97Coeffs_Jn GIBBS_COEFFS_R5_O[];
+	extern const int MAX_GIBBS_COEFFS_R5_O;
+	extern const typIF97Coeffs_IJn GIBBS_COEFFS_R5_R[];
+	extern const int MAX_GIBBS_COEFFS_R5_R;
+
+	double if97_r1_Gamma (double if97_pi, double if97_tau);
+	double if97_r1_GammaPi (double if97_pi, double if97_tau);
+	double if97_r1_GammaPiPi (double if97_pi, double if97_tau);
+	double if97_r1_GammaTau (double if97_pi, double if97_tau);
+	double if97_r1_GammaTauTau (double if97_pi, double if97_tau);
+	double if97_r1_GammaPiTau (double if97_pi, double if97_tau);
+
+	double if97_r2_Gamma_r (double if97_pi, double if97_tau);
+	double if97_r2_GammaPi_r (double if97_pi, double if97_tau);
+	double if97_r2_GammaPiPi_r (double if97_pi, double if97_tau);
+	double if97_r2_GammaTau_r (double if97_pi, double if97_tau);
+	double if97_r2_GammaTauTau_r (double if97_pi, double if97_tau);
+	double if97_r2_GammaPiTau_r (double if97_pi, double if97_tau);
+	double if97_r2_Gamma_o (double if97_pi, double if97_tau);
+	double if97_r2_GammaTau_o (double if97_tau);
+	double if97_r2_GammaTauTau_o (double if97_tau);
+
+	double if97_r3_Phi (double if97_delta, double if97_tau);
+	double if97_r3_PhiDelta (double if97_delta, double if97_tau);
+	double if97_r3_PhiDeltaDelta (double if97_delta, double if97_tau);
+	double if97_r3_PhiTau (double if97_delta, double if97_tau);
+	double if97_r3_PhiTauTau (double if97_delta, double if97_tau);
+	double if97_r3_PhiDeltaTau (double if97_delta, double if97_tau);
+
+	double if97_r5_Gamma_r (double if97_pi, double if97_tau);
+	double if97_r5_GammaPi_r (double if97_pi, double if97_tau);
+	double if97_r5_GammaPiPi_r (double if97_pi, double if97_tau);
+	double if97_r5_GammaTau_r (double if97_pi, double if97_tau);
+	double if97_r5_GammaTauTau_r (double if97_pi, double if97_tau);
+	double if97_r5_GammaPiTau_r (double if97_pi, double if97_tau);
+	double if97_r5_Gamma_o (double if97_pi, double if97_tau);
+	double if97_r5_GammaTau_o (double if97_tau);
+	double if97_r5_GammaTauTau_o (double if97_tau);
+}
+
+#define CONSTEXPRTESTLOGLOC "IF97ConstexprTest.log"
+
+/* The compile time equations form each term as the C library does and add the terms in table
+ * order, so at run time they agree with it to the last place.  The C sums are OpenMP reductions,
+ * which add in another order with more threads, so the library is run on one.  Results are
+ * compared in units in the last place */
+#define CONSTEXPR_ULPS 1
+
+
+// units in the last place between two doubles, counted along their ordered bit patterns
+long long ulpDistance (double a, double b)
+{
+	long long ia, ib;
+
+	if (a == b) return 0;  // including +0 and -0
+	if ((a < 0.0) != (b < 0.0) || std::isnan(a) || std::isnan(b)) return LLONG_MAX;
+	std::memcpy (&ia, &a, sizeof ia);
+	std::memcpy (&ib, &b, sizeof ib);
+	return (ia > ib) ? ia - ib : ib - ia;
+}
+
+
+// compares a result with that expected, to within maxUlps units in the last place. Pass = 0. See IF97_Common.h for failure codes.
+int testUlps (double actual, double expectedOutput, long long maxUlps, const char *funcName, FILE *logFile)
+{
+	long long ulps = ulpDistance(actual, expectedOutput);
+
+	if (ulps <= maxUlps) {
+		if (VERBOSE_TEST)
+			fprintf (logFile, "%s = %.17g \t Expected: %.17g \t ulps : %lld \t PASS\n", funcName, actual, expectedOutput, ulps);
+		return TEST_PASS;
+	}
+	if (VERBOSE_TEST)
+		fprintf (logFile, "%s = %.17g \t Expected: %.17g \t ulps : %lld \t FAIL\n", funcName, actual, expectedOutput, ulps);
+	return TEST_INCORRECT;
+}
+
+
+// the constexpr tables are copies of the C tables
+int checkTables (FILE *logFile)
+{
+	int intermediateResult = TEST_PASS;
+	int i;
+
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R1; i++)
+		if (if97::coeffs::gibbs_r1[i].I != GIBBS_COEFFS_R1[i].Ii || if97::coeffs::gibbs_r1[i].J != GIBBS_COEFFS_R1[i].Ji
+				|| if97::coeffs::gibbs_r1[i].n != GIBBS_COEFFS_R1[i].ni) intermediateResult |= TEST_INCORRECT;
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R2_O; i++)
+		if (if97::coeffs::gibbs_r2_o[i].J != GIBBS_COEFFS_R2_O[i].Ji || if97::coeffs::gibbs_r2_o[i].n != GIBBS_COEFFS_R2_O[i].ni)
+			intermediateResult |= TEST_INCORRECT;
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R2_R; i++)
+		if (if97::coeffs::gibbs_r2_r[i].I != GIBBS_COEFFS_R2_R[i].Ii || if97::coeffs::gibbs_r2_r[i].J != GIBBS_COEFFS_R2_R[i].Ji
+				|| if97::coeffs::gibbs_r2_r[i].n != GIBBS_COEFFS_R2_R[i].ni) intermediateResult |= TEST_INCORRECT;
+	for (i = 1; i <= MAX_COEFFS_PHI_R3; i++)
+		if (if97::coeffs::phi_r3[i].I != PHI_COEFFS_R3[i].Ii || if97::coeffs::phi_r3[i].J != PHI_COEFFS_R3[i].Ji
+				|| if97::coeffs::phi_r3[i].n != PHI_COEFFS_R3[i].ni) intermediateResult |= TEST_INCORRECT;
+	for (i = 1; i <= 10; i++)
+		if (if97::coeffs::sat_r4[i] != IF97_R3_n[i]) intermediateResult |= TEST_INCORRECT;
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R5_O; i++)
+		if (if97::coeffs::gibbs_r5_o[i].J != GIBBS_COEFFS_R5_O[i].Ji || if97::coeffs::gibbs_r5_o[i].n != GIBBS_COEFFS_R5_O[i].ni)
+			intermediateResult |= TEST_INCORRECT;
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R5_R; i++)
+		if (if97::coeffs::gibbs_r5_r[i].I != GIBBS_COEFFS_R5_R[i].Ii || if97::coeffs::gibbs_r5_r[i].J != GIBBS_COEFFS_R5_R[i].Ji
+				|| if97::coeffs::gibbs_r5_r[i].n != GIBBS_COEFFS_R5_R[i].ni) intermediateResult |= TEST_INCORRECT;
+
+	// the table sizes agree, so the unrolled sums run over the same rows as the C loops
+	if (sizeof(if97::coeffs::gibbs_r1) / sizeof(if97::coeffs::IJn) != (size_t) MAX_GIBBS_COEFFS_R1 + 1
+			|| sizeof(if97::coeffs::gibbs_r2_o) / sizeof(if97::coeffs::Jn) != (size_t) MAX_GIBBS_COEFFS_R2_O + 1
+			|| sizeof(if97::coeffs::gibbs_r2_r) / sizeof(if97::coeffs::IJn) != (size_t) MAX_GIBBS_COEFFS_R2_R + 1
+			|| sizeof(if97::coeffs::phi_r3) / sizeof(if97::coeffs::IJn) != (size_t) MAX_COEFFS_PHI_R3 + 1
+			|| sizeof(if97::coeffs::gibbs_r5_o) / sizeof(if97::coeffs::Jn) != (size_t) MAX_GIBBS_COEFFS_R5_O + 1
+			|| sizeof(if97::coeffs::gibbs_r5_r) / sizeof(if97::coeffs::IJn) != (size_t) MAX_GIBBS_COEFFS_R5_R + 1)
+		intermediateResult |= TEST_INCORRECT;
+
+	fprintf (logFile, "coefficient tables : %s\n", (intermediateResult == TEST_PASS) ? "PASS" : "FAIL");
+	return intermediateResult;
+}
+
+
+int checkRegion1 (double p_MPa, double t_K, FILE *logFile)
+{
+	int intermediateResult = TEST_PASS;
+	double pi = p_MPa / PSTAR_R1;
+	double tau = TSTAR_R1 / t_K;
+
+	fprintf (logFile, "\nregion 1, p = %g MPa, T = %g K\n", p_MPa, t_K);
+
+	intermediateResult |= testUlps (if97::gibbs<if97::Region1, 0, 0>(pi, tau), if97_r1_Gamma(pi, tau), CONSTEXPR_ULPS, "gamma", logFile);
+	intermediateResult |= testUlps (if97::gibbs<if97::Region1, 1, 0>(pi, tau), if97_r1_GammaPi(pi, tau), CONSTEXPR_ULPS, "gammaPi", logFile);
+	intermediateResult |= testUlps (if97::gibbs<if97::Region1, 2, 0>(pi, tau), if97_r1_GammaPiPi(pi, tau), CONSTEXPR_ULPS, "gammaPiPi", logFile);
+	intermediateResult |= testUlps (if97::gibbs<if97::Region1, 0, 1>(pi, tau), if97_r1_GammaTau(pi, tau), CONSTEXPR_ULPS, "gammaTau", logFile);
+	intermediateResult |= testUlps (if97::gibbs<if97::Region1, 0, 2>(pi, tau), if97_r1_GammaTauTau(pi, tau), CONSTEXPR_ULPS, "gammaTauTau", logFile);
+	intermediateResult |= testUlps (if97::gibbs<if97::Region1, 1, 1>(pi, tau), if97_r1_GammaPiTau(pi, tau), CONSTEXPR_ULPS, "gammaPiTau", logFile);
+
+	intermediateResult |= testUlps (if97::Region<1>::v(p_MPa, t_K), if97_r1_v(p_MPa, t_K), CONSTEXPR_ULPS, "v", logFile);
+	intermediateResult |= testUlps (if97::Region<1>::h(p_MPa, t_K), if97_r1_h(p_MPa, t_K), CONSTEXPR_ULPS, "h", logFile);
+	intermediateResult |= testUlps (if97::Region<1>::u(p_MPa, t_K), if97_r1_u(p_MPa, t_K), CONSTEXPR_ULPS, "u", logFile);
+	intermediateResult |= testUlps (if97::Region<1>::s(p_MPa, t_K), if97_r1_s(p_MPa, t_K), CONSTEXPR_ULPS, "s", logFile);
+	intermediateResult |= testUlps (if97::Region<1>::cp(p_MPa, t_K), if97_r1_Cp(p_MPa, t_K), CONSTEXPR_ULPS, "cp", logFile);
+	intermediateResult |= testUlps (if97::Region<1>::cv(p_MPa, t_K), if97_r1_Cv(p_MPa, t_K), CONSTEXPR_ULPS, "cv", logFile);
+	intermediateResult |= testUlps (if97::Region<1>::w(p_MPa, t_K), if97_r1_w(p_MPa, t_K), CONSTEXPR_ULPS, "w", logFile);
+
+	return intermediateResult;
+}
+
+
+int checkRegion2 (double p_MPa, double t_K, FILE *logFile)
+{
+	int intermediateResult = TEST_PASS;
+	double pi = p_MPa / PSTAR_R2;
+	double tau = TSTAR_R2 / t_K;
+
+	fprintf (logFile, "\nregion 2, p = %g MPa, T = %g K\n", p_MPa, t_K);
+
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region2, 0, 0>(pi, tau), if97_r2_Gamma_r(pi, tau), CONSTEXPR_ULPS, "gamma_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region2, 1, 0>(pi, tau), if97_r2_GammaPi_r(pi, tau), CONSTEXPR_ULPS, "gammaPi_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region2, 2, 0>(pi, tau), if97_r2_GammaPiPi_r(pi, tau), CONSTEXPR_ULPS, "gammaPiPi_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region2, 0, 1>(pi, tau), if97_r2_GammaTau_r(pi, tau), CONSTEXPR_ULPS, "gammaTau_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region2, 0, 2>(pi, tau), if97_r2_GammaTauTau_r(pi, tau), CONSTEXPR_ULPS, "gammaTauTau_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region2, 1, 1>(pi, tau), if97_r2_GammaPiTau_r(pi, tau), CONSTEXPR_ULPS, "gammaPiTau_r", logFile);
+
+	intermediateResult |= testUlps (if97::gibbs_o<if97::Region2, 0, 0>(pi, tau), if97_r2_Gamma_o(pi, tau), CONSTEXPR_ULPS, "gamma_o", logFile);
+	intermediateResult |= testUlps (if97::gibbs_o<if97::Region2, 0, 1>(pi, tau), if97_r2_GammaTau_o(tau), CONSTEXPR_ULPS, "gammaTau_o", logFile);
+	intermediateResult |= testUlps (if97::gibbs_o<if97::Region2, 0, 2>(pi, tau), if97_r2_GammaTauTau_o(tau), CONSTEXPR_ULPS, "gammaTauTau_o", logFile);
+
+	intermediateResult |= testUlps (if97::Region<2>::v(p_MPa, t_K), if97_r2_v(p_MPa, t_K), CONSTEXPR_ULPS, "v", logFile);
+	intermediateResult |= testUlps (if97::Region<2>::h(p_MPa, t_K), if97_r2_h(p_MPa, t_K), CONSTEXPR_ULPS, "h", logFile);
+	intermediateResult |= testUlps (if97::Region<2>::u(p_MPa, t_K), if97_r2_u(p_MPa, t_K), CONSTEXPR_ULPS, "u", logFile);
+	intermediateResult |= testUlps (if97::Region<2>::s(p_MPa, t_K), if97_r2_s(p_MPa, t_K), CONSTEXPR_ULPS, "s", logFile);
+	intermediateResult |= testUlps (if97::Region<2>::cp(p_MPa, t_K), if97_r2_Cp(p_MPa, t_K), CONSTEXPR_ULPS, "cp", logFile);
+	intermediateResult |= testUlps (if97::Region<2>::cv(p_MPa, t_K), if97_r2_Cv(p_MPa, t_K), CONSTEXPR_ULPS, "cv", logFile);
+	intermediateResult |= testUlps (if97::Region<2>::w(p_MPa, t_K), if97_r2_w(p_MPa, t_K), CONSTEXPR_ULPS, "w", logFile);
+
+	return intermediateResult;
+}
+
+
+int checkRegion3 (double rho, double t_K, FILE *logFile)
+{
+	int intermediateResult = TEST_PASS;
+	double delta = rho / IF97_RHOC;
+	double tau = IF97_TC / t_K;
+
+	fprintf (logFile, "\nregion 3, rho = %g kg/m3, T = %g K\n", rho, t_K);
+
+	intermediateResult |= testUlps (if97::helmholtz<if97::Region3, 0, 0>(delta, tau), if97_r3_Phi(delta, tau), CONSTEXPR_ULPS, "phi", logFile);
+	intermediateResult |= testUlps (if97::helmholtz<if97::Region3, 1, 0>(delta, tau), if97_r3_PhiDelta(delta, tau), CONSTEXPR_ULPS, "phiDelta", logFile);
+	intermediateResult |= testUlps (if97::helmholtz<if97::Region3, 2, 0>(delta, tau), if97_r3_PhiDeltaDelta(delta, tau), CONSTEXPR_ULPS, "phiDeltaDelta", logFile);
+	intermediateResult |= testUlps (if97::helmholtz<if97::Region3, 0, 1>(delta, tau), if97_r3_PhiTau(delta, tau), CONSTEXPR_ULPS, "phiTau", logFile);
+	intermediateResult |= testUlps (if97::helmholtz<if97::Region3, 0, 2>(delta, tau), if97_r3_PhiTauTau(delta, tau), CONSTEXPR_ULPS, "phiTauTau", logFile);
+	intermediateResult |= testUlps (if97::helmholtz<if97::Region3, 1, 1>(delta, tau), if97_r3_PhiDeltaTau(delta, tau), CONSTEXPR_ULPS, "phiDeltaTau", logFile);
+
+	intermediateResult |= testUlps (if97::Region<3>::p(rho, t_K), if97_r3_p(rho, t_K), CONSTEXPR_ULPS, "p", logFile);
+	intermediateResult |= testUlps (if97::Region<3>::h(rho, t_K), if97_r3_h(rho, t_K), CONSTEXPR_ULPS, "h", logFile);
+	intermediateResult |= testUlps (if97::Region<3>::u(rho, t_K), if97_r3_u(rho, t_K), CONSTEXPR_ULPS, "u", logFile);
+	intermediateResult |= testUlps (if97::Region<3>::s(rho, t_K), if97_r3_s(rho, t_K), CONSTEXPR_ULPS, "s", logFile);
+	intermediateResult |= testUlps (if97::Region<3>::cp(rho, t_K), if97_r3_Cp(rho, t_K), CONSTEXPR_ULPS, "cp", logFile);
+	intermediateResult |= testUlps (if97::Region<3>::cv(rho, t_K), if97_r3_Cv(rho, t_K), CONSTEXPR_ULPS, "cv", logFile);
+	intermediateResult |= testUlps (if97::Region<3>::w(rho, t_K), if97_r3_w(rho, t_K), CONSTEXPR_ULPS, "w", logFile);
+
+	return intermediateResult;
+}
+
+
+int checkRegion5 (double p_MPa, double t_K, FILE *logFile)
+{
+	int intermediateResult = TEST_PASS;
+	double pi = p_MPa / PSTAR_R5;
+	double tau = TSTAR_R5 / t_K;
+
+	fprintf (logFile, "\nregion 5, p = %g MPa, T = %g K\n", p_MPa, t_K);
+
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region5, 0, 0>(pi, tau), if97_r5_Gamma_r(pi, tau), CONSTEXPR_ULPS, "gamma_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region5, 1, 0>(pi, tau), if97_r5_GammaPi_r(pi, tau), CONSTEXPR_ULPS, "gammaPi_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region5, 2, 0>(pi, tau), if97_r5_GammaPiPi_r(pi, tau), CONSTEXPR_ULPS, "gammaPiPi_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region5, 0, 1>(pi, tau), if97_r5_GammaTau_r(pi, tau), CONSTEXPR_ULPS, "gammaTau_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region5, 0, 2>(pi, tau), if97_r5_GammaTauTau_r(pi, tau), CONSTEXPR_ULPS, "gammaTauTau_r", logFile);
+	intermediateResult |= testUlps (if97::gibbs_r<if97::Region5, 1, 1>(pi, tau), if97_r5_GammaPiTau_r(pi, tau), CONSTEXPR_ULPS, "gammaPiTau_r", logFile);
+
+	intermediateResult |= testUlps (if97::gibbs_o<if97::Region5, 0, 0>(pi, tau), if97_r5_Gamma_o(pi, tau), CONSTEXPR_ULPS, "gamma_o", logFile);
+	intermediateResult |= testUlps (if97::gibbs_o<if97::Region5, 0, 1>(pi, tau), if97_r5_GammaTau_o(tau), CONSTEXPR_ULPS, "gammaTau_o", logFile);
+	intermediateResult |= testUlps (if97::gibbs_o<if97::Region5, 0, 2>(pi, tau), if97_r5_GammaTauTau_o(tau), CONSTEXPR_ULPS, "gammaTauTau_o", logFile);
+
+	intermediateResult |= testUlps (if97::Region<5>::v(p_MPa, t_K), if97_r5_v(p_MPa, t_K), CONSTEXPR_ULPS, "v", logFile);
+	intermediateResult |= testUlps (if97::Region<5>::h(p_MPa, t_K), if97_r5_h(p_MPa, t_K), CONSTEXPR_ULPS, "h", logFile);
+	intermediateResult |= testUlps (if97::Region<5>::u(p_MPa, t_K), if97_r5_u(p_MPa, t_K), CONSTEXPR_ULPS, "u", logFile);
+	intermediateResult |= testUlps (if97::Region<5>::s(p_MPa, t_K), if97_r5_s(p_MPa, t_K), CONSTEXPR_ULPS, "s", logFile);
+	intermediateResult |= testUlps (if97::Region<5>::cp(p_MPa, t_K), if97_r5_Cp(p_MPa, t_K), CONSTEXPR_ULPS, "cp", logFile);
+	intermediateResult |= testUlps (if97::Region<5>::cv(p_MPa, t_K), if97_r5_Cv(p_MPa, t_K), CONSTEXPR_ULPS, "cv", logFile);
+	intermediateResult |= testUlps (if97::Region<5>::w(p_MPa, t_K), if97_r5_w(p_MPa, t_K), CONSTEXPR_ULPS, "w", logFile);
+
+	return intermediateResult;
+}
+
+
+int main (int argc, char **argv)
+{
+	int intermediateResult = TEST_PASS;
+	int i, j;
+	double p, t;
+	FILE *pTestLog = fopen(CONSTEXPRTESTLOGLOC, "w");
+
+	// the sums are constant expressions
+	static_assert(if97::gibbs_r<if97::Region1, 0, 1>(3.0 / PSTAR_R1, TSTAR_R1 / 300.0) != 0.0, "gibbs_r is not constexpr");
+	static_assert(if97::detail::ipow<-3>(2.0) == 0.125, "ipow");
+
+#ifdef _OPENMP
+	omp_set_num_threads(1);  // the C sums' reductions add in table order only on one thread
+#endif
+
+	fprintf (pTestLog, "\n\n*** IF97 COMPILE TIME REGION EQUATIONS CHECK ***\n\n");
+
+	intermediateResult |= checkTables (pTestLog);
+
+	// a grid over each region
+	for (i = 0; i <= 5; i++) {
+		for (j = 0; j <= 5; j++) {
+			p = 0.001 + i * 20.0;
+			t = 283.15 + j * 68.0;
+			if (region_pt(p, t) == 1) intermediateResult |= checkRegion1 (p, t, pTestLog);
+
+			t = 300.0 + j * 150.0;
+			if (region_pt(p, t) == 2) intermediateResult |= checkRegion2 (p, t, pTestLog);
+
+			t = 1073.15 + j * 240.0;
+			if (region_pt(p / 2.0, t) == 5) intermediateResult |= checkRegion5 (p / 2.0, t, pTestLog);
+
+			intermediateResult |= checkRegion3 (150.0 + i * 100.0, 650.0 + j * 30.0, pTestLog);
+		}
+	}
+	for (i = 0; i < IF97_TEST_POINTS; i++) {  // the verification points of the release, as in the region tests
+		intermediateResult |= checkRegion1 (IF97_R1_TEST_POINTS[i].in1, IF97_R1_TEST_POINTS[i].t_K, pTestLog);
+		intermediateResult |= checkRegion2 (IF97_R2_TEST_POINTS[i].in1, IF97_R2_TEST_POINTS[i].t_K, pTestLog);
+		intermediateResult |= checkRegion3 (IF97_R3_TEST_POINTS[i].in1, IF97_R3_TEST_POINTS[i].t_K, pTestLog);
+		intermediateResult |= checkRegion5 (IF97_R5_TEST_POINTS[i].in1, IF97_R5_TEST_POINTS[i].t_K, pTestLog);
+	}
+
+	// region 4 is the same arithmetic as the C library, so agrees exactly
+	fprintf (pTestLog, "\nsaturation line\n");
+	for (i = 0; i <= 10; i++) {
+		t = 273.16 + i * 37.39;
+		p = if97_r4_ps(t);
+		intermediateResult |= testUlps (if97::Region<4>::ps(t), p, 0, "ps", pTestLog);
+		intermediateResult |= testUlps (if97::Region<4>::ts(p), if97_r4_ts(p), 0, "ts", pTestLog);
+	}
+
+	if (intermediateResult != 0)
+		intermediateResult = intermediateResult | TEST_FAIL;
+
+	fprintf (pTestLog, "\nResults summary for if97_constexpr : Error code %i \n%s\n", intermediateResult, (intermediateResult == TEST_PASS) ? "PASS" : "FAIL");
+	fclose (pTestLog);
+	printf ("Test log results can be found in %s\n", CONSTEXPRTESTLOGLOC);
+
+	return intermediateResult;
+}
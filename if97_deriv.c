@@ -0,0 +1,317 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    IAPWS-IF97 analytic thermodynamic partial derivatives
+
+/* Each property is differentiated with respect to the base variables
+ * (p, T) using only v, [dv/dp]_T, [dv/dT]_p, h, s and cp, which come 
+ * straight from the free energy derivatives: 
+ * 
+ * [dh/dp]_T = v - T [dv/dT]_p		[dh/dT]_p = cp
+ * [ds/dp]_T = - [dv/dT]_p			[ds/dT]_p = cp / T
+ * [dg/dp]_T = v					[dg/dT]_p = - s
+ * u = h - pv
+ * 
+ * p.v is in MPa.m3/kg, so is multiplied by 1000 to give kJ/kg
+ */
+
+
+#include "IF97_common.h"  //PSTAR TSTAR & sqr
+#include "IF97_Region1.h"
+#include "IF97_Region2.h"
+#include "IF97_Region3.h"
+#include "IF97_Region4.h"
+#include "IF97_Region5.h"
+#include "if97_lib.h"
+#include "if97_deriv.h"
+#include <math.h> // for pow, log
+
+
+// every free energy derivative
+#define IF97_D_ALL (IF97_D0 | IF97_DX | IF97_DXX | IF97_DT | IF97_DTT | IF97_DXT)
+
+
+
+// ******  Used internally   *******
+
+
+/* fills the (p,T) base derivatives of every property from v, its derivatives, h, s and cp */
+void fill_pt_partials(typIF97Partials *pd, double p_MPa, double t_K, double v, double v_p, double v_T, 
+			double h, double s, double cp){
+	
+	pd->val[IF97_P] = p_MPa;
+	pd->val[IF97_T] = t_K;
+	pd->val[IF97_V] = v;
+	pd->val[IF97_H] = h;
+	pd->val[IF97_S] = s;
+	pd->val[IF97_U] = h - 1000.0 * p_MPa * v;
+	pd->val[IF97_G] = h - t_K * s;
+	
+	// [d / dp] at constant T
+	pd->d1[IF97_P] = 1.0;
+	pd->d1[IF97_T] = 0.0;
+	pd->d1[IF97_V] = v_p;
+	pd->d1[IF97_H] = 1000.0 * (v - t_K * v_T);
+	pd->d1[IF97_S] = -1000.0 * v_T;
+	pd->d1[IF97_U] = pd->d1[IF97_H] - 1000.0 * (v + p_MPa * v_p);
+	pd->d1[IF97_G] = 1000.0 * v;
+	
+	// [d / dT] at constant p
+	pd->d2[IF97_P] = 0.0;
+	pd->d2[IF97_T] = 1.0;
+	pd->d2[IF97_V] = v_T;
+	pd->d2[IF97_H] = cp;
+	pd->d2[IF97_S] = cp / t_K;
+	pd->d2[IF97_U] = cp - 1000.0 * p_MPa * v_T;
+	pd->d2[IF97_G] = -s;
+}
+
+
+
+/* (p,T) base derivatives in a Gibbs region (1, 2 or 5) from the dimensionless
+ * Gibbs free energy derivatives.  pStar is the reducing pressure of the region */
+void gibbs_pt_partials(typIF97Partials *pd, double p_MPa, double t_K, double pStar, double pi, double tau,
+			const typIF97GibbsDerivs *d){
+	typSteamState state;
+	
+	if97_gibbs_props(p_MPa, t_K, pi, tau, d, IF97_MASK_V | IF97_MASK_H | IF97_MASK_S | IF97_MASK_CP, &state);
+	
+	fill_pt_partials(pd, p_MPa, t_K, 1.0 / state.rho_kgperM3,
+			IF97_R * t_K * d->gammaPiPi / (1000.0 * sqr(pStar)),  
+			IF97_R * (d->gammaPi - tau * d->gammaPiTau) / (1000.0 * pStar),
+			state.h_kJperkg, state.s_kJperkgK, state.Cp_kJperkgK);
+}
+
+
+
+/* (p,T) base derivatives in region 3 for a given density and temperature, from the
+ * dimensionless Helmholtz free energy derivatives.  See Table 31 */
+void helm_pt_partials(typIF97Partials *pd, double rho_kgPerM3, double t_K){
+	typIF97HelmDerivs d;
+	double dblP_rho, dblP_T, dblCpPart;
+	
+	double if97delta = rho_kgPerM3 / IF97_RHOC;
+	double if97tau = IF97_TC / t_K;
+	
+	if97_r3_helm_derivs(if97delta, if97tau, IF97_D_ALL, &d);
+	
+	dblP_rho = IF97_R * t_K * (2.0 * if97delta * d.phiDelta + sqr(if97delta) * d.phiDeltaDelta) / 1000.0;  // [dp/drho]_T
+	dblP_T = rho_kgPerM3 * IF97_R * if97delta * (d.phiDelta - if97tau * d.phiDeltaTau) / 1000.0;  // [dp/dT]_rho
+	dblCpPart = sqr(if97delta * d.phiDelta - if97delta * if97tau * d.phiDeltaTau);
+	
+	fill_pt_partials(pd, rho_kgPerM3 * IF97_R * t_K * if97delta * d.phiDelta / 1000.0, t_K, 
+			1.0 / rho_kgPerM3,
+			-1.0 / (sqr(rho_kgPerM3) * dblP_rho),
+			dblP_T / (sqr(rho_kgPerM3) * dblP_rho),
+			IF97_R * t_K * (if97tau * d.phiTau + if97delta * d.phiDelta),
+			IF97_R * (if97tau * d.phiTau - d.phi),
+			IF97_R * (-sqr(if97tau) * d.phiTauTau + dblCpPart / (2.0 * if97delta * d.phiDelta + sqr(if97delta) * d.phiDeltaDelta)));
+}
+
+
+
+/* (p,T) base derivatives of saturated water or steam at p_MPa and its saturation temperature */
+void sat_pt_partials(typIF97Partials *pd, double p_MPa, double ts_K, bool bVapour){
+	typIF97GibbsDerivs d;
+	
+	if (p_MPa >= IF97_B23_LPRESS)  // consistent with region_pt
+		helm_pt_partials(pd, r3_rho_sat(p_MPa, ts_K, bVapour), ts_K);
+	
+	else if (bVapour){
+		if97_r2_gibbs_derivs(p_MPa / PSTAR_R2, TSTAR_R2 / ts_K, IF97_D_ALL, &d);
+		gibbs_pt_partials(pd, p_MPa, ts_K, PSTAR_R2, p_MPa / PSTAR_R2, TSTAR_R2 / ts_K, &d);
+	}
+	else{
+		if97_r1_gibbs_derivs(p_MPa / PSTAR_R1, TSTAR_R1 / ts_K, IF97_D_ALL, &d);
+		gibbs_pt_partials(pd, p_MPa, ts_K, PSTAR_R1, p_MPa / PSTAR_R1, TSTAR_R1 / ts_K, &d);
+	}
+}
+
+
+
+
+// ******  External   *******
+
+
+/** property values and their derivatives with respect to the base variables for a state
+ * whose region is already known.  Uses p_MPa and t_K in regions 1, 2 and 5, rho_kgperM3 
+ * and t_K in region 3 and p_MPa and qual_pct in region 4 */
+typIF97Partials if97_state_partials(const typSteamState *state){
+	typIF97Partials pd;
+	typIF97GibbsDerivs d;
+	double p_MPa = state->p_MPa;
+	double t_K = state->t_K;
+	
+	pd.iRegion = state->iRegion;
+	
+	switch (pd.iRegion) {
+	case 1 :
+		if97_r1_gibbs_derivs(p_MPa / PSTAR_R1, TSTAR_R1 / t_K, IF97_D_ALL, &d);
+		gibbs_pt_partials(&pd, p_MPa, t_K, PSTAR_R1, p_MPa / PSTAR_R1, TSTAR_R1 / t_K, &d);
+		break;
+	case 2 :
+		if97_r2_gibbs_derivs(p_MPa / PSTAR_R2, TSTAR_R2 / t_K, IF97_D_ALL, &d);
+		gibbs_pt_partials(&pd, p_MPa, t_K, PSTAR_R2, p_MPa / PSTAR_R2, TSTAR_R2 / t_K, &d);
+		break;
+	case 3:
+		helm_pt_partials(&pd, state->rho_kgperM3, t_K);
+		pd.val[IF97_P] = p_MPa;  // exact input rather than that recalculated from density
+		break;
+	case 4:
+		pd = if97_px_partials(p_MPa, state->qual_pct / 100.0);
+		break;
+	case 5: 
+		if97_r5_gibbs_derivs(p_MPa / PSTAR_R5, TSTAR_R5 / t_K, IF97_D_ALL, &d);
+		gibbs_pt_partials(&pd, p_MPa, t_K, PSTAR_R5, p_MPa / PSTAR_R5, TSTAR_R5 / t_K, &d);
+		break;
+	default:
+		pd.iRegion = 0;
+	}
+	return pd;
+}
+
+
+
+/** property values and their derivatives with respect to p and T for a single phase state */
+typIF97Partials if97_pt_partials(double p_MPa, double t_K){
+	typSteamState state;
+	
+	state.p_MPa = p_MPa;
+	state.t_K = t_K;
+	state.iRegion = region_pt(p_MPa, t_K);
+	if (state.iRegion == 3)
+		state.rho_kgperM3 = r3_rho_pt(p_MPa, t_K);
+	
+	return if97_state_partials(&state);
+}
+
+
+
+/** property values and their derivatives with respect to p and x for a two phase state.
+ * The slope of the saturation line is from the Clausius-Clapeyron equation
+ * dTs/dp = Ts (v'' - v') / (h'' - h') */
+typIF97Partials if97_px_partials(double p_MPa, double x){
+	typIF97Partials pd, liq, vap;
+	double ts_K, dblDtsDp, dblLiqSat, dblVapSat;
+	int i;
+	
+	pd.iRegion = 0;
+	if ((p_MPa < IF97_P_TRIP / 1e6) || (p_MPa >= IF97_PC) || (x < 0.0) || (x > 1.0))
+		return pd;  // error region not valid
+	
+	pd.iRegion = 4;
+	ts_K = if97_r4_ts(p_MPa);
+	
+	sat_pt_partials(&liq, p_MPa, ts_K, false);
+	sat_pt_partials(&vap, p_MPa, ts_K, true);
+	
+	// 1000 because h is in kJ/kg and p in MPa
+	dblDtsDp = 1000.0 * ts_K * (vap.val[IF97_V] - liq.val[IF97_V]) / (vap.val[IF97_H] - liq.val[IF97_H]);
+	
+	for (i = 0; i < IF97_NPROPS; i++){
+		// derivatives of the saturated properties along the saturation line
+		dblLiqSat = liq.d1[i] + liq.d2[i] * dblDtsDp;
+		dblVapSat = vap.d1[i] + vap.d2[i] * dblDtsDp;
+		
+		pd.val[i] = liq.val[i] + x * (vap.val[i] - liq.val[i]);
+		pd.d1[i] = dblLiqSat + x * (dblVapSat - dblLiqSat);
+		pd.d2[i] = vap.val[i] - liq.val[i];
+	}
+	
+	// exact inputs rather than those recalculated
+	pd.val[IF97_P] = p_MPa;
+	pd.val[IF97_T] = ts_K;
+	
+	return pd;
+}
+
+
+
+/** partial derivative (dX/dY)_Z using Bridgman's method */
+double if97_partial(const typIF97Partials *partials, enum if97_prop_t X, enum if97_prop_t Y, enum if97_prop_t Z){
+	double dblDenom;
+	
+	if (partials->iRegion == 0) return -9998.0;  //error region not valid
+	
+	dblDenom = partials->d1[Y] * partials->d2[Z] - partials->d2[Y] * partials->d1[Z];
+	if (dblDenom == 0.0) return -9999.0;  // derivative does not exist
+	
+	return (partials->d1[X] * partials->d2[Z] - partials->d2[X] * partials->d1[Z]) / dblDenom;
+}
+
+
+
+/** partial derivative (dX/dY)_Z for a single phase state at p_MPa and t_K */
+double if97_pt_deriv(double p_MPa, double t_K, enum if97_prop_t X, enum if97_prop_t Y, enum if97_prop_t Z){
+	typIF97Partials pd = if97_pt_partials(p_MPa, t_K);
+	return if97_partial(&pd, X, Y, Z);
+}
+
+
+
+/** partial derivative (dX/dY)_Z for a two phase state at p_MPa and dryness fraction x */
+double if97_px_deriv(double p_MPa, double x, enum if97_prop_t X, enum if97_prop_t Y, enum if97_prop_t Z){
+	typIF97Partials pd = if97_px_partials(p_MPa, x);
+	return if97_partial(&pd, X, Y, Z);
+}
+
+
+
+// PH JACOBIAN BLOCKS
+
+
+/** values and (p,h) Jacobian blocks of T, v, s and x for n states.  See if97_deriv.h */
+int if97_ph_jacobian_n(int n, const double *p_MPa, const double *h_kJperkg, double *values, double *jacobian){
+	int i, k, iErrCount = 0;
+	
+	#pragma omp parallel for reduction(+:iErrCount) private(k) 	//handle loop multithreaded	
+	for (i = 0; i < n; i++) {
+		double *val = values + i * IF97_JAC_NOUT;
+		double *jac = jacobian + i * IF97_JAC_NOUT * 2;
+		typSteamState state;
+		typIF97Partials pd;
+		
+		// the region is found once, and is shared by the values and their derivatives
+		state = if97_ph_state_mask(p_MPa[i], h_kJperkg[i], IF97_MASK_V | IF97_MASK_S);
+		
+		if (state.iRegion == 0) {  // error region not valid
+			for (k = 0; k < IF97_JAC_NOUT; k++) {
+				val[k] = -9998.0;
+				jac[2 * k] = -9998.0;
+				jac[2 * k + 1] = -9998.0;
+			}
+			iErrCount++;
+			continue;
+		}
+		
+		pd = if97_state_partials(&state);
+		
+		val[IF97_JAC_T] = state.t_K;
+		jac[2 * IF97_JAC_T] = if97_partial(&pd, IF97_T, IF97_P, IF97_H);
+		jac[2 * IF97_JAC_T + 1] = if97_partial(&pd, IF97_T, IF97_H, IF97_P);
+		
+		val[IF97_JAC_V] = 1.0 / state.rho_kgperM3;
+		jac[2 * IF97_JAC_V] = if97_partial(&pd, IF97_V, IF97_P, IF97_H);
+		jac[2 * IF97_JAC_V + 1] = if97_partial(&pd, IF97_V, IF97_H, IF97_P);
+		
+		val[IF97_JAC_S] = state.s_kJperkgK;
+		jac[2 * IF97_JAC_S] = if97_partial(&pd, IF97_S, IF97_P, IF97_H);
+		jac[2 * IF97_JAC_S + 1] = if97_partial(&pd, IF97_S, IF97_H, IF97_P);
+		
+		if (state.iRegion == 4) {
+			// h = h' + x (h'' - h'), so with (p,x) as the base variables:
+			val[IF97_JAC_X] = state.qual_pct / 100.0;
+			jac[2 * IF97_JAC_X] = - pd.d1[IF97_H] / pd.d2[IF97_H];
+			jac[2 * IF97_JAC_X + 1] = 1.0 / pd.d2[IF97_H];
+		}
+		else {
+			val[IF97_JAC_X] = (state.phase == LIQUID) ? 0.0 : 1.0;
+			jac[2 * IF97_JAC_X] = 0.0;
+			jac[2 * IF97_JAC_X + 1] = 0.0;
+		}
+	}
+	return iErrCount;
+}
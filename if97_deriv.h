@@ -0,0 +1,125 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    IAPWS-IF97 analytic thermodynamic partial derivatives
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ * 
+ * @file if97_deriv.h
+ * @author Martin Lord
+ * @brief IAPWS-IF97 analytic partial derivatives (dX/dY)_Z
+ * @details 
+ * Any partial derivative among p, T, v, h, s, u and g, formed from the 
+ * dimensionless Gibbs (regions 1, 2, 5) or Helmholtz (region 3) free energy 
+ * derivatives using Bridgman's method.  \n
+ * 
+ * Every property is first differentiated with respect to a pair of base 
+ * variables: (p, T) in single phase, (p, x) in the two phase region, where the 
+ * slope of the saturation line comes from the Clausius-Clapeyron equation.  
+ * Any partial then follows from \n
+ * 
+ * (dX/dY)_Z = (X1 Z2 - X2 Z1) / (Y1 Z2 - Y2 Z1) \n
+ * 
+ * where 1 and 2 denote the derivatives with respect to the first and second base variable. \n
+ * 
+ * UNITS  p: MPa, T: K, v: m3/kg, h, u, g: kJ/kg, s: kJ/kg/K, x: dryness fraction (0 to 1)
+ * 
+ * @see http://www.iapws.org/relguide/IF97-Rev.html
+ */
+
+
+#ifndef IF97_DERIV_H
+#define IF97_DERIV_H
+
+#include "IF97_common.h"
+
+
+// properties which may be differentiated
+enum if97_prop_t {
+	IF97_P = 0,	// pressure
+	IF97_T = 1,	// temperature
+	IF97_V = 2,	// specific volume
+	IF97_H = 3,	// specific enthalpy
+	IF97_S = 4,	// specific entropy
+	IF97_U = 5,	// specific internal energy
+	IF97_G = 6,	// specific Gibbs free energy
+	IF97_NPROPS = 7,
+};
+
+
+typedef struct sctIF97Partials {  
+	int iRegion;  // 1, 2, 3, 5 single phase.  4 two phase.  0 not valid
+	double val[IF97_NPROPS];  // property values
+	double d1[IF97_NPROPS];  // [d / dp] at constant T (single phase) or at constant x (two phase)
+	double d2[IF97_NPROPS];  // [d / dT] at constant p (single phase) or [d / dx] at constant p (two phase)
+} typIF97Partials;
+
+
+
+// USED INTERNALLY BY THE LIBRARY MODULES
+
+/** (p,T) base derivatives in region 3 for a given density and temperature.  
+ * val[IF97_P] is the pressure at that density */
+void helm_pt_partials(typIF97Partials *pd, double rho_kgPerM3, double t_K);
+
+
+/** property values and their derivatives with respect to the base variables for a state
+ * whose region is already known (eg from if97_pt_state or if97_ph_state).  Uses p_MPa and t_K 
+ * in regions 1, 2 and 5, rho_kgperM3 and t_K in region 3 and p_MPa and qual_pct in region 4 */
+typIF97Partials if97_state_partials(const typSteamState *state);
+
+/** property values and their derivatives with respect to p and T for a single phase
+ * state at p_MPa and t_K.  iRegion is 0 if out of bounds */
+typIF97Partials if97_pt_partials(double p_MPa, double t_K);
+
+/** property values and their derivatives with respect to p and x for a two phase
+ * state at p_MPa and dryness fraction x (0 to 1).  iRegion is 0 if out of bounds */
+typIF97Partials if97_px_partials(double p_MPa, double x);
+
+/** partial derivative (dX/dY)_Z from a set of base derivatives.  
+ * -9998 if the state is not valid. -9999 if the derivative does not exist 
+ * (eg (dh/dT)_p in the two phase region) */
+double if97_partial(const typIF97Partials *partials, enum if97_prop_t X, enum if97_prop_t Y, enum if97_prop_t Z);
+
+/** partial derivative (dX/dY)_Z for a single phase state at p_MPa and t_K */
+double if97_pt_deriv(double p_MPa, double t_K, enum if97_prop_t X, enum if97_prop_t Y, enum if97_prop_t Z);
+
+/** partial derivative (dX/dY)_Z for a two phase state at p_MPa and dryness fraction x */
+double if97_px_deriv(double p_MPa, double x, enum if97_prop_t X, enum if97_prop_t Y, enum if97_prop_t Z);
+
+
+
+// PH JACOBIAN BLOCKS
+
+// outputs of if97_ph_jacobian_n, in the order they are stored for each state
+enum if97_jac_out_t {
+	IF97_JAC_T = 0,	// temperature (K)
+	IF97_JAC_V = 1,	// specific volume (m3/kg)
+	IF97_JAC_S = 2,	// specific entropy (kJ/kg/K)
+	IF97_JAC_X = 3,	// dryness fraction.  0 for single phase liquid, 1 for single phase vapour
+	IF97_JAC_NOUT = 4,
+};
+
+/** values and Jacobian blocks of T, v, s and x with respect to (p,h) for n states,
+ * for the assembly of sparse Newton Jacobians in equation-oriented solvers. \n
+ * 
+ * values[IF97_JAC_NOUT * i + k] is output k of state i \n
+ * jacobian[2 * (IF97_JAC_NOUT * i + k)] is [d / dp]_h of output k of state i \n
+ * jacobian[2 * (IF97_JAC_NOUT * i + k) + 1] is [d / dh]_p of output k of state i \n
+ * 
+ * so that each state occupies a contiguous 4 x 2 row major block.  The states are 
+ * evaluated in parallel when compiled with OpenMP. \n
+ * Returns the number of states out of bounds, whose values and derivatives are set to -9998 */
+int if97_ph_jacobian_n(int n, const double *p_MPa, const double *h_kJperkg, double *values, double *jacobian);
+
+
+#endif // IF97_DERIV_H
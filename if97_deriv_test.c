@@ -0,0 +1,170 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* ********************************************************************
+* A SHORT PROGRAMME TO CHECK THE ANALYTIC PARTIAL DERIVATIVES 
+* *********************************************************************/
+
+#include "if97_deriv.h"
+#include "if97_lib.h"
+#include <stdio.h>
+#include "IF97_common.h"
+#include "if97_lib_test.h"
+
+
+#define JAC_TEST_N 100  // states in the batch Jacobian check
+
+/* Most checks use identities which hold exactly, whatever the equation of state:
+ * 
+ * (dh/dT)_p = cp		(dh/dp)_s = v		(dh/ds)_p = T
+ * (du/ds)_v = T		(du/dv)_s = -p		(dg/dp)_T = v
+ * 
+ * with v in the above multiplied by 1000 to give kJ/kg/MPa
+ */
+
+double deriv_pt_hTp (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_H, IF97_T, IF97_P);}
+double deriv_pt_hps (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_H, IF97_P, IF97_S);}
+double deriv_pt_hsp (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_H, IF97_S, IF97_P);}
+double deriv_pt_usv (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_U, IF97_S, IF97_V);}
+double deriv_pt_uvs (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_U, IF97_V, IF97_S);}
+double deriv_pt_gpT (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_G, IF97_P, IF97_T);}
+double deriv_pt_pTv (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_P, IF97_T, IF97_V);}
+double deriv_pt_pvT (double p_MPa, double t_K) {return if97_pt_deriv(p_MPa, t_K, IF97_P, IF97_V, IF97_T);}
+
+double deriv_px_hsp (double p_MPa, double x) {return if97_px_deriv(p_MPa, x, IF97_H, IF97_S, IF97_P);}
+double deriv_px_hps (double p_MPa, double x) {return if97_px_deriv(p_MPa, x, IF97_H, IF97_P, IF97_S);}
+double deriv_px_Tpx (double p_MPa, double x) {return if97_px_deriv(p_MPa, x, IF97_T, IF97_P, IF97_S);}
+double deriv_px_hTp (double p_MPa, double x) {return if97_px_deriv(p_MPa, x, IF97_H, IF97_T, IF97_P);}
+double deriv_px_Thp (double p_MPa, double x) {return if97_px_deriv(p_MPa, x, IF97_T, IF97_H, IF97_P);}
+
+
+// single (p,h) Jacobian entries, d / dp at constant h if bDh is false, d / dh at constant p otherwise
+double jac_entry (double p_MPa, double h_kJperkg, int iOut, bool bDh){
+	double values[IF97_JAC_NOUT], jacobian[2 * IF97_JAC_NOUT];
+	
+	if97_ph_jacobian_n(1, &p_MPa, &h_kJperkg, values, jacobian);
+	return jacobian[2 * iOut + (bDh ? 1 : 0)];
+}
+
+double jac_Th (double p_MPa, double h_kJperkg) {return jac_entry(p_MPa, h_kJperkg, IF97_JAC_T, true);}
+double jac_sh (double p_MPa, double h_kJperkg) {return jac_entry(p_MPa, h_kJperkg, IF97_JAC_S, true);}
+double jac_sp (double p_MPa, double h_kJperkg) {return jac_entry(p_MPa, h_kJperkg, IF97_JAC_S, false);}
+double jac_vp (double p_MPa, double h_kJperkg) {return jac_entry(p_MPa, h_kJperkg, IF97_JAC_V, false);}
+double jac_xh (double p_MPa, double h_kJperkg) {return jac_entry(p_MPa, h_kJperkg, IF97_JAC_X, true);}
+double jac_xp (double p_MPa, double h_kJperkg) {return jac_entry(p_MPa, h_kJperkg, IF97_JAC_X, false);}
+
+
+int if97_deriv_test (FILE *logFile){	
+	int intermediateResult= TEST_PASS; //initialise with clear flags.  
+	double dblDelta, dblRho;
+	double pBatch[JAC_TEST_N], hBatch[JAC_TEST_N], valBatch[JAC_TEST_N * IF97_JAC_NOUT], jacBatch[JAC_TEST_N * IF97_JAC_NOUT * 2];
+	double valSingle[IF97_JAC_NOUT], jacSingle[IF97_JAC_NOUT * 2];
+	int i, k, iBatchErr;
+	
+	fprintf(logFile, "\n\n*** IF97 ANALYTIC PARTIAL DERIVATIVES CHECK ***\n" );
+	
+	fprintf(logFile, "*** SINGLE PHASE ***\n" );
+	// region 1.  See Table 5
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hTp, 3.0, 300.0, 0.417301218e1, TEST_ACCURACY, SIG_FIG, "(dh/dT)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hps, 3.0, 300.0, 1000.0 * 0.100215168e-2, TEST_ACCURACY, SIG_FIG, "(dh/dp)_s", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hsp, 3.0, 300.0, 300.0, TEST_ACCURACY, SIG_FIG, "(dh/ds)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_usv, 3.0, 300.0, 300.0, TEST_ACCURACY, SIG_FIG, "(du/ds)_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_uvs, 3.0, 300.0, -3000.0, TEST_ACCURACY, SIG_FIG, "(du/dv)_s", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_gpT, 3.0, 300.0, 1000.0 * 0.100215168e-2, TEST_ACCURACY, SIG_FIG, "(dg/dp)_T", logFile);
+	
+	// region 2.  See Table 15
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hTp, 0.0035, 300.0, 0.191300162e1, TEST_ACCURACY, SIG_FIG, "(dh/dT)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hps, 0.0035, 300.0, 1000.0 * 0.394913866e2, TEST_ACCURACY, SIG_FIG, "(dh/dp)_s", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hsp, 0.0035, 700.0, 700.0, TEST_ACCURACY, SIG_FIG, "(dh/ds)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_uvs, 0.0035, 700.0, -3.5, TEST_ACCURACY, SIG_FIG, "(du/dv)_s", logFile);
+	
+	// region 3.  Density from the backwards equations, so compare with properties at that density
+	dblRho = r3_rho_pt(25.5837018, 650.0);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hsp, 25.5837018, 650.0, 650.0, TEST_ACCURACY, SIG_FIG, "(dh/ds)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_usv, 25.5837018, 650.0, 650.0, TEST_ACCURACY, SIG_FIG, "(du/ds)_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_uvs, 25.5837018, 650.0, -1000.0 * if97_r3_p(dblRho, 650.0), TEST_ACCURACY, SIG_FIG, "(du/dv)_s", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hps, 25.5837018, 650.0, 1000.0 / dblRho, TEST_ACCURACY, SIG_FIG, "(dh/dp)_s", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hTp, 25.5837018, 650.0, if97_r3_Cp(dblRho, 650.0), TEST_ACCURACY, SIG_FIG, "(dh/dT)_p", logFile);
+	
+	// against central differences of the region 3 pressure equation
+	dblDelta = 0.001;
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_pTv, 25.5837018, 650.0, 
+			(if97_r3_p(dblRho, 650.0 + dblDelta) - if97_r3_p(dblRho, 650.0 - dblDelta)) / (2.0 * dblDelta), 6, SIG_FIG, "(dp/dT)_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_pvT, 25.5837018, 650.0, 
+			(if97_r3_p(1.0 / (1.0 / dblRho + 1e-8), 650.0) - if97_r3_p(1.0 / (1.0 / dblRho - 1e-8), 650.0)) / 2e-8, 6, SIG_FIG, "(dp/dv)_T", logFile);
+	
+	// region 5.  See Table 42
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hTp, 0.5, 1500.0, 0.261609445e1, TEST_ACCURACY, SIG_FIG, "(dh/dT)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hps, 0.5, 1500.0, 1000.0 * 0.138455090e1, TEST_ACCURACY, SIG_FIG, "(dh/dp)_s", logFile);
+	
+	// out of bounds
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_pt_hTp, 120.0, 300.0, -9998.0, TEST_ACCURACY, SIG_FIG, "(dh/dT)_p", logFile);
+	
+	
+	fprintf(logFile, "*** TWO PHASE ***\n" );
+	/* the saturation line (region 4) is consistent with regions 1, 2 and 3 only to 
+	 * within the tolerances of IF97, so the identities involving T hold less closely */
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_hsp, 1.0, 0.5, if97_r4_ts(1.0), 0.01, PERCENT, "(dh/ds)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_hsp, 20.0, 0.5, if97_r4_ts(20.0), 0.01, PERCENT, "(dh/ds)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_hps, 1.0, 0.5, 
+			1000.0 * (if97_r1_v(1.0, if97_r4_ts(1.0)) + if97_r2_v(1.0, if97_r4_ts(1.0))) / 2.0, 0.1, PERCENT, "(dh/dp)_s", logFile);
+	
+	dblDelta = 0.0001;
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_Tpx, 1.0, 0.5, 
+			(if97_r4_ts(1.0 + dblDelta) - if97_r4_ts(1.0 - dblDelta)) / (2.0 * dblDelta), 0.1, PERCENT, "(dT/dp)_s", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_Tpx, 20.0, 0.5, 
+			(if97_r4_ts(20.0 + dblDelta) - if97_r4_ts(20.0 - dblDelta)) / (2.0 * dblDelta), 0.1, PERCENT, "(dT/dp)_s", logFile);
+	
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_Thp, 1.0, 0.5, 0.0, 0.0, ABS, "(dT/dh)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_hTp, 1.0, 0.5, -9999.0, 0.0, ABS, "(dh/dT)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( deriv_px_hTp, 25.0, 0.5, -9998.0, 0.0, ABS, "(dh/dT)_p", logFile);
+	
+	
+	fprintf(logFile, "*** PH JACOBIAN BLOCKS ***\n" );
+	/* (ds/dh)_p = 1/T and (ds/dp)_h = -v/T exactly, from dh = T ds + v dp */
+	intermediateResult = intermediateResult | testDoubleInput ( jac_Th, 3.0, 0.115331273e3, 1.0 / 0.417301218e1, TEST_ACCURACY, SIG_FIG, "(dT/dh)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_sh, 3.0, 0.115331273e3, 1.0 / if97_ph_t(3.0, 0.115331273e3), TEST_ACCURACY, SIG_FIG, "(ds/dh)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_sp, 3.0, 0.115331273e3, 
+			-1000.0 * if97_ph_v(3.0, 0.115331273e3) / if97_ph_t(3.0, 0.115331273e3), TEST_ACCURACY, SIG_FIG, "(ds/dp)_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_sh, 25.0, 2500.0, 1.0 / if97_ph_t(25.0, 2500.0), TEST_ACCURACY, SIG_FIG, "(ds/dh)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_sp, 25.0, 2500.0, 
+			-1000.0 * if97_ph_v(25.0, 2500.0) / if97_ph_t(25.0, 2500.0), TEST_ACCURACY, SIG_FIG, "(ds/dp)_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_sh, 0.5, 5000.0, 1.0 / if97_ph_t(0.5, 5000.0), TEST_ACCURACY, SIG_FIG, "(ds/dh)_p", logFile);
+	
+	// against central differences of the (p,h) functions
+	dblDelta = 0.001;
+	intermediateResult = intermediateResult | testDoubleInput ( jac_vp, 10.0, 3000.0, 
+			(if97_ph_v(10.0 + dblDelta, 3000.0) - if97_ph_v(10.0 - dblDelta, 3000.0)) / (2.0 * dblDelta), 5, SIG_FIG, "(dv/dp)_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_vp, 25.0, 2000.0, 
+			(if97_ph_v(25.0 + dblDelta, 2000.0) - if97_ph_v(25.0 - dblDelta, 2000.0)) / (2.0 * dblDelta), 5, SIG_FIG, "(dv/dp)_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_xh, 1.0, 2000.0, 
+			(if97_ph_q(1.0, 2000.0 + dblDelta) - if97_ph_q(1.0, 2000.0 - dblDelta)) / (200.0 * dblDelta), 5, SIG_FIG, "(dx/dh)_p", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_xp, 1.0, 2000.0, 
+			(if97_ph_q(1.0 + dblDelta, 2000.0) - if97_ph_q(1.0 - dblDelta, 2000.0)) / (200.0 * dblDelta), 4, SIG_FIG, "(dx/dp)_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( jac_xp, 3.0, 0.115331273e3, 0.0, 0.0, ABS, "(dx/dp)_h", logFile);
+	
+	// a batch gives the same as the states one at a time
+	for (i = 0; i < JAC_TEST_N; i++) {
+		pBatch[i] = 0.01 + 60.0 * i / JAC_TEST_N;
+		hBatch[i] = 100.0 + 3500.0 * ((i * 7) % JAC_TEST_N) / JAC_TEST_N;
+	}
+	if97_ph_jacobian_n(JAC_TEST_N, pBatch, hBatch, valBatch, jacBatch);
+	iBatchErr = TEST_PASS;
+	for (i = 0; i < JAC_TEST_N; i++) {
+		if97_ph_jacobian_n(1, pBatch + i, hBatch + i, valSingle, jacSingle);
+		for (k = 0; k < 2 * IF97_JAC_NOUT; k++)
+			if (jacSingle[k] != jacBatch[2 * IF97_JAC_NOUT * i + k]) iBatchErr = TEST_INCORRECT;
+		for (k = 0; k < IF97_JAC_NOUT; k++)
+			if (valSingle[k] != valBatch[IF97_JAC_NOUT * i + k]) iBatchErr = TEST_INCORRECT;
+	}
+	fprintf(logFile, "if97_ph_jacobian_n batch of %i against single states \t %s\n", JAC_TEST_N, (iBatchErr == TEST_PASS) ? "PASS" : "FAIL");
+	intermediateResult = intermediateResult | iBatchErr;
+	
+	if (intermediateResult != 0)
+		intermediateResult= intermediateResult | TEST_FAIL;
+	return intermediateResult;
+}
@@ -0,0 +1,24 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* ********************************************************************
+* A SHORT PROGRAMME TO CHECK THE ANALYTIC PARTIAL DERIVATIVES 
+* *********************************************************************/
+
+
+#ifndef IF97_DERIV_TEST_H
+#define IF97_DERIV_TEST_H
+
+#include "if97_deriv.h"
+#include <stdio.h>
+#include "IF97_common.h"
+#include "if97_lib_test.h"
+
+
+int if97_deriv_test (FILE *logFile);
+
+#endif // IF97_DERIV_TEST_H
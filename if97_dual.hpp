@@ -0,0 +1,418 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    IAPWS-IF97 region equations over forward mode dual numbers (C++)
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_dual.hpp
+ * @author Martin Lord
+ * @brief IAPWS-IF97 automatic differentiation (C++ only)
+ * @details
+ * The region equations as templates over the scalar type, evaluated from the
+ * coefficient tables of the C library.  With S = double they are the plain
+ * double equations.  With S = if97::Dual<N> every result also carries its exact
+ * derivatives with respect to N independent variables, so that any quantity built
+ * from them (a cycle efficiency for instance) is differentiated exactly in one pass. \n
+ *
+ * Usage example, the gradient of h with respect to p and T: \n
+ *
+ * if97::Dual<2> p = if97::Dual<2>::variable(3.0, 0); \n
+ * if97::Dual<2> t = if97::Dual<2>::variable(300.0, 1); \n
+ * if97::Dual<2> h = if97::pt_props(p, t).h;   // h.d[0] = (dh/dp)_T,  h.d[1] = cp \n
+ *
+ * The density in region 3 is found by the C library (backwards equations and
+ * iteration) and its derivatives by the implicit function theorem, so no derivative
+ * is carried through the iteration. \n
+ *
+ * UNITS  p: MPa, T: K, rho: kg/m3, v: m3/kg, h, u: kJ/kg, s, cp, cv: kJ/kg/K, w: m/s
+ *
+ * @see http://www.iapws.org/relguide/IF97-Rev.html
+ */
+
+
+#ifndef IF97_DUAL_HPP
+#define IF97_DUAL_HPP
+
+#include <cmath>
+
+extern "C" {
+#include "IF97_common.h"  //PSTAR TSTAR, structures
+#include "IF97_Region3.h"
+#include "if97_lib.h"
+
+	// coefficient tables of the C library
+	extern const typIF97Coeffs_IJn GIBBS_COEFFS_R1[];
+	extern const int MAX_GIBBS_COEFFS_R1;
+	extern const typIF97Coeffs_Jn GIBBS_COEFFS_R2_O[];
+	extern const int MAX_GIBBS_COEFFS_R2_O;
+	extern const typIF97Coeffs_IJn GIBBS_COEFFS_R2_R[];
+	extern const int MAX_GIBBS_COEFFS_R2_R;
+	extern const typIF97Coeffs_IJn PHI_COEFFS_R3[];
+	extern const int MAX_COEFFS_PHI_R3;
+	extern const double IF97_R3_n[];  // region 4 saturation line
+	extern const typIF97Coeffs_Jn GIBBS_COEFFS_R5_O[];
+	extern const int MAX_GIBBS_COEFFS_R5_O;
+	extern const typIF97Coeffs_IJn GIBBS_COEFFS_R5_R[];
+	extern const int MAX_GIBBS_COEFFS_R5_R;
+	extern const double B23_N[];
+}
+
+
+namespace if97 {
+
+
+//**************************************************************
+//********* DUAL NUMBERS ***************************************
+
+/** a value and its first derivatives with respect to N independent variables */
+template <int N> struct Dual {
+	double v;
+	double d[N];
+
+	Dual (double val = 0.0) : v(val) { for (int k = 0; k < N; k++) d[k] = 0.0; }
+
+	/** independent variable number k (0 to N-1) with value val */
+	static Dual variable (double val, int k) { Dual x(val); x.d[k] = 1.0; return x; }
+
+	Dual &operator+= (const Dual &b) { v += b.v; for (int k = 0; k < N; k++) d[k] += b.d[k]; return *this; }
+	Dual &operator-= (const Dual &b) { v -= b.v; for (int k = 0; k < N; k++) d[k] -= b.d[k]; return *this; }
+	Dual &operator*= (const Dual &b) { for (int k = 0; k < N; k++) d[k] = d[k] * b.v + v * b.d[k]; v *= b.v; return *this; }
+	Dual &operator/= (const Dual &b) { for (int k = 0; k < N; k++) d[k] = (d[k] * b.v - v * b.d[k]) / (b.v * b.v); v /= b.v; return *this; }
+};
+
+
+// value of a scalar, whether plain or dual
+inline double value (double x) { return x; }
+template <int N> double value (const Dual<N> &x) { return x.v; }
+
+template <int N> Dual<N> operator- (Dual<N> a) { a.v = -a.v; for (int k = 0; k < N; k++) a.d[k] = -a.d[k]; return a; }
+
+template <int N> Dual<N> operator+ (Dual<N> a, const Dual<N> &b) { return a += b; }
+template <int N> Dual<N> operator- (Dual<N> a, const Dual<N> &b) { return a -= b; }
+template <int N> Dual<N> operator* (Dual<N> a, const Dual<N> &b) { return a *= b; }
+template <int N> Dual<N> operator/ (Dual<N> a, const Dual<N> &b) { return a /= b; }
+
+template <int N> Dual<N> operator+ (Dual<N> a, double b) { a.v += b; return a; }
+template <int N> Dual<N> operator+ (double a, Dual<N> b) { b.v += a; return b; }
+template <int N> Dual<N> operator- (Dual<N> a, double b) { a.v -= b; return a; }
+template <int N> Dual<N> operator- (double a, const Dual<N> &b) { return -b + a; }
+template <int N> Dual<N> operator* (Dual<N> a, double b) { a.v *= b; for (int k = 0; k < N; k++) a.d[k] *= b; return a; }
+template <int N> Dual<N> operator* (double a, Dual<N> b) { return b * a; }
+template <int N> Dual<N> operator/ (Dual<N> a, double b) { return a * (1.0 / b); }
+template <int N> Dual<N> operator/ (double a, const Dual<N> &b) { return Dual<N>(a) / b; }
+
+
+// chain rule: f(x) with f'(x) = dfdx
+template <int N> Dual<N> chain (const Dual<N> &x, double f, double dfdx) {
+	Dual<N> r(f);
+	for (int k = 0; k < N; k++) r.d[k] = dfdx * x.d[k];
+	return r;
+}
+
+template <int N> Dual<N> pow (const Dual<N> &x, int n) {
+	if (n == 0) return Dual<N>(1.0);
+	return chain(x, std::pow(x.v, n), n * std::pow(x.v, n - 1));
+}
+template <int N> Dual<N> pow (const Dual<N> &x, double a) { return chain(x, std::pow(x.v, a), a * std::pow(x.v, a - 1.0)); }
+template <int N> Dual<N> sqrt (const Dual<N> &x) { double r = std::sqrt(x.v); return chain(x, r, 0.5 / r); }
+template <int N> Dual<N> log (const Dual<N> &x) { return chain(x, std::log(x.v), 1.0 / x.v); }
+template <int N> Dual<N> exp (const Dual<N> &x) { double r = std::exp(x.v); return chain(x, r, r); }
+
+
+
+//**************************************************************
+//********* FREE ENERGY DERIVATIVES ****************************
+
+/** dimensionless Gibbs free energy and its derivatives */
+template <class S> struct GibbsDerivs {
+	S gamma, gammaPi, gammaPiPi, gammaTau, gammaTauTau, gammaPiTau;
+};
+
+/** dimensionless Helmholtz free energy and its derivatives */
+template <class S> struct HelmDerivs {
+	S phi, phiDelta, phiDeltaDelta, phiTau, phiTauTau, phiDeltaTau;
+};
+
+/** properties of a state.  -9998 if the region is not valid */
+template <class S> struct Props {
+	S p, t, rho, v, h, u, s, cp, cv, w;
+	int iRegion;
+};
+
+
+/* adds n A^I B^J and its derivatives with respect to pi and tau to d, where
+ * dA/dpi = sA and dB/dtau = 1 */
+template <class S> void add_gibbs_term (GibbsDerivs<S> &d, double n, int I, int J, const S &A, double sA, const S &B) {
+	using std::pow;
+	S nTerm = n * pow(A, I) * pow(B, J);
+
+	d.gamma += nTerm;
+	d.gammaPi += sA * I * nTerm / A;
+	d.gammaPiPi += I * (I - 1.0) * nTerm / (A * A);
+	d.gammaTau += J * nTerm / B;
+	d.gammaTauTau += J * (J - 1.0) * nTerm / (B * B);
+	d.gammaPiTau += sA * I * J * nTerm / (A * B);
+}
+
+
+/* adds the ideal gas part of regions 2 and 5:  ln(pi) + sum n tau^J */
+template <class S> void add_gibbs_ideal (GibbsDerivs<S> &d, const typIF97Coeffs_Jn *coeffs, int iMax, const S &pi, const S &tau) {
+	using std::pow; using std::log;
+	int i;
+
+	d.gamma += log(pi);
+	d.gammaPi += 1.0 / pi;
+	d.gammaPiPi -= 1.0 / (pi * pi);
+
+	for (i = 1; i <= iMax; i++) {
+		S nTerm = coeffs[i].ni * pow(tau, coeffs[i].Ji);
+		d.gamma += nTerm;
+		d.gammaTau += coeffs[i].Ji * nTerm / tau;
+		d.gammaTauTau += coeffs[i].Ji * (coeffs[i].Ji - 1.0) * nTerm / (tau * tau);
+	}
+}
+
+
+/** region 1 Gibbs free energy derivatives.  See Table 4 */
+template <class S> GibbsDerivs<S> r1_gibbs (const S &pi, const S &tau) {
+	GibbsDerivs<S> d = GibbsDerivs<S>();
+	S A = 7.1 - pi;
+	S B = tau - 1.222;
+	int i;
+
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R1; i++)
+		add_gibbs_term(d, GIBBS_COEFFS_R1[i].ni, GIBBS_COEFFS_R1[i].Ii, GIBBS_COEFFS_R1[i].Ji, A, -1.0, B);
+	return d;
+}
+
+
+/** region 2 Gibbs free energy derivatives, ideal gas plus residual.  See Tables 13 and 14 */
+template <class S> GibbsDerivs<S> r2_gibbs (const S &pi, const S &tau) {
+	GibbsDerivs<S> d = GibbsDerivs<S>();
+	S B = tau - 0.5;
+	int i;
+
+	add_gibbs_ideal(d, GIBBS_COEFFS_R2_O, MAX_GIBBS_COEFFS_R2_O, pi, tau);
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R2_R; i++)
+		add_gibbs_term(d, GIBBS_COEFFS_R2_R[i].ni, GIBBS_COEFFS_R2_R[i].Ii, GIBBS_COEFFS_R2_R[i].Ji, pi, 1.0, B);
+	return d;
+}
+
+
+/** region 5 Gibbs free energy derivatives, ideal gas plus residual.  See Tables 40 and 41 */
+template <class S> GibbsDerivs<S> r5_gibbs (const S &pi, const S &tau) {
+	GibbsDerivs<S> d = GibbsDerivs<S>();
+	int i;
+
+	add_gibbs_ideal(d, GIBBS_COEFFS_R5_O, MAX_GIBBS_COEFFS_R5_O, pi, tau);
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R5_R; i++)
+		add_gibbs_term(d, GIBBS_COEFFS_R5_R[i].ni, GIBBS_COEFFS_R5_R[i].Ii, GIBBS_COEFFS_R5_R[i].Ji, pi, 1.0, tau);
+	return d;
+}
+
+
+/** region 3 Helmholtz free energy derivatives.  See Table 32 */
+template <class S> HelmDerivs<S> r3_helm (const S &delta, const S &tau) {
+	using std::pow; using std::log;
+	HelmDerivs<S> d = HelmDerivs<S>();
+	int i;
+
+	d.phi = PHI_COEFFS_R3[1].ni * log(delta);
+	d.phiDelta = PHI_COEFFS_R3[1].ni / delta;
+	d.phiDeltaDelta = -PHI_COEFFS_R3[1].ni / (delta * delta);
+
+	for (i = 2; i <= MAX_COEFFS_PHI_R3; i++) {
+		double I = PHI_COEFFS_R3[i].Ii;
+		double J = PHI_COEFFS_R3[i].Ji;
+		S nTerm = PHI_COEFFS_R3[i].ni * pow(delta, PHI_COEFFS_R3[i].Ii) * pow(tau, PHI_COEFFS_R3[i].Ji);
+
+		d.phi += nTerm;
+		d.phiDelta += I * nTerm / delta;
+		d.phiDeltaDelta += I * (I - 1.0) * nTerm / (delta * delta);
+		d.phiTau += J * nTerm / tau;
+		d.phiTauTau += J * (J - 1.0) * nTerm / (tau * tau);
+		d.phiDeltaTau += I * J * nTerm / (delta * tau);
+	}
+	return d;
+}
+
+
+
+//**************************************************************
+//********* REGION PROPERTIES **********************************
+
+/** properties from the Gibbs free energy derivatives, common to regions 1, 2 and 5. See Table 3 */
+template <class S> Props<S> gibbs_props (const S &p_MPa, const S &t_K, const S &pi, const S &tau, const GibbsDerivs<S> &d) {
+	using std::sqrt;
+	Props<S> r;
+	S cvPart = (d.gammaPi - tau * d.gammaPiTau) * (d.gammaPi - tau * d.gammaPiTau);
+
+	r.p = p_MPa;
+	r.t = t_K;
+	r.v = IF97_R * t_K * pi * d.gammaPi / (1000.0 * p_MPa);  // 1000 for kJ and MPa to SI
+	r.rho = 1.0 / r.v;
+	r.h = IF97_R * t_K * tau * d.gammaTau;
+	r.u = IF97_R * t_K * (tau * d.gammaTau - pi * d.gammaPi);
+	r.s = IF97_R * (tau * d.gammaTau - d.gamma);
+	r.cp = -IF97_R * tau * tau * d.gammaTauTau;
+	r.cv = IF97_R * (-tau * tau * d.gammaTauTau + cvPart / d.gammaPiPi);
+	r.w = sqrt(IF97_R * 1000.0 * t_K * d.gammaPi * d.gammaPi / (cvPart / (tau * tau * d.gammaTauTau) - d.gammaPiPi));
+	return r;
+}
+
+
+/** region 1 properties for a given pressure (MPa) and temperature (K) */
+template <class S> Props<S> r1_props (const S &p_MPa, const S &t_K) {
+	S pi = p_MPa / PSTAR_R1, tau = TSTAR_R1 / t_K;
+	Props<S> r = gibbs_props(p_MPa, t_K, pi, tau, r1_gibbs(pi, tau));
+	r.iRegion = 1;
+	return r;
+}
+
+/** region 2 properties for a given pressure (MPa) and temperature (K) */
+template <class S> Props<S> r2_props (const S &p_MPa, const S &t_K) {
+	S pi = p_MPa / PSTAR_R2, tau = TSTAR_R2 / t_K;
+	Props<S> r = gibbs_props(p_MPa, t_K, pi, tau, r2_gibbs(pi, tau));
+	r.iRegion = 2;
+	return r;
+}
+
+/** region 5 properties for a given pressure (MPa) and temperature (K) */
+template <class S> Props<S> r5_props (const S &p_MPa, const S &t_K) {
+	S pi = p_MPa / PSTAR_R5, tau = TSTAR_R5 / t_K;
+	Props<S> r = gibbs_props(p_MPa, t_K, pi, tau, r5_gibbs(pi, tau));
+	r.iRegion = 5;
+	return r;
+}
+
+
+/** region 3 properties for a given density (kg/m3) and temperature (K). See Table 31 */
+template <class S> Props<S> r3_props (const S &rho, const S &t_K) {
+	using std::sqrt;
+	Props<S> r;
+	S delta = rho / IF97_RHOC, tau = IF97_TC / t_K;
+	HelmDerivs<S> d = r3_helm(delta, tau);
+	S dPart = 2.0 * delta * d.phiDelta + delta * delta * d.phiDeltaDelta;
+	S cpPart = (delta * d.phiDelta - delta * tau * d.phiDeltaTau) * (delta * d.phiDelta - delta * tau * d.phiDeltaTau);
+
+	r.p = rho * IF97_R * t_K * delta * d.phiDelta / 1000.0;
+	r.t = t_K;
+	r.rho = rho;
+	r.v = 1.0 / rho;
+	r.h = IF97_R * t_K * (tau * d.phiTau + delta * d.phiDelta);
+	r.u = IF97_R * t_K * tau * d.phiTau;
+	r.s = IF97_R * (tau * d.phiTau - d.phi);
+	r.cv = -IF97_R * tau * tau * d.phiTauTau;
+	r.cp = IF97_R * (-tau * tau * d.phiTauTau + cpPart / dPart);
+	r.w = sqrt(IF97_R * 1000.0 * t_K * (dPart - cpPart / (tau * tau * d.phiTauTau)));
+	r.iRegion = 3;
+	return r;
+}
+
+
+/** region 3 pressure (MPa) for a given density (kg/m3) and temperature (K) */
+template <class S> S r3_p (const S &rho, const S &t_K) {
+	S delta = rho / IF97_RHOC, tau = IF97_TC / t_K;
+	return rho * IF97_R * t_K * delta * r3_helm(delta, tau).phiDelta / 1000.0;
+}
+
+
+/* density found in double by the C library, given the derivatives of p and T:
+ * p(rho, T) = p  so  [drho] = ([dp] - [dp/dT]_rho [dT]) / [dp/drho]_T */
+inline double r3_rho_implicit (double rho, double p_MPa, double t_K) { return rho; }
+
+template <int N> Dual<N> r3_rho_implicit (double rho, const Dual<N> &p_MPa, const Dual<N> &t_K) {
+	Dual<N> pAtRho = r3_p(Dual<N>(rho), t_K);  // carries [dp/dT]_rho [dT]
+	double delta = rho / IF97_RHOC, tau = IF97_TC / t_K.v;
+	HelmDerivs<double> d = r3_helm(delta, tau);
+	double dpdrho = IF97_R * t_K.v * (2.0 * delta * d.phiDelta + delta * delta * d.phiDeltaDelta) / 1000.0;
+	Dual<N> r(rho);
+
+	for (int k = 0; k < N; k++) r.d[k] = (p_MPa.d[k] - pAtRho.d[k]) / dpdrho;
+	return r;
+}
+
+
+/** region 3 density (kg/m3) for a given pressure (MPa) and temperature (K) */
+template <class S> S r3_rho_pt (const S &p_MPa, const S &t_K) {
+	return r3_rho_implicit(::r3_rho_pt(value(p_MPa), value(t_K)), p_MPa, t_K);
+}
+
+
+
+//**************************************************************
+//********* SATURATION LINE AND BOUNDARIES *********************
+
+/** saturation pressure (MPa) for a given temperature (K).  Equation 30 */
+template <class S> S r4_ps (const S &ts_K) {
+	using std::sqrt;
+	const double *n = IF97_R3_n;
+	S I = ts_K + n[9] / (ts_K - n[10]);
+	S A = I * I + n[1] * I + n[2];
+	S B = n[3] * I * I + n[4] * I + n[5];
+	S C = n[6] * I * I + n[7] * I + n[8];
+	S x = 2.0 * C / (-B + sqrt(B * B - 4.0 * A * C));
+	return (x * x) * (x * x);
+}
+
+
+/** saturation temperature (K) for a given pressure (MPa).  Equation 31 */
+template <class S> S r4_ts (const S &ps_MPa) {
+	using std::sqrt; using std::pow;
+	const double *n = IF97_R3_n;
+	S B = pow(ps_MPa, 0.25);
+	S E = B * B + n[3] * B + n[6];
+	S F = n[1] * B * B + n[4] * B + n[7];
+	S G = n[2] * B * B + n[5] * B + n[8];
+	S D = 2.0 * G / (-F - sqrt(F * F - 4.0 * E * G));
+	return 0.5 * (n[10] + D - sqrt((n[10] + D) * (n[10] + D) - 4.0 * (n[9] + n[10] * D)));
+}
+
+
+/** temperature (K) of the region 2-3 boundary for a given pressure (MPa).  Equation 6 */
+template <class S> S b23_t (const S &p_MPa) {
+	using std::sqrt;
+	return B23_N[4] + sqrt((p_MPa - B23_N[5]) / B23_N[3]);
+}
+
+
+
+//**************************************************************
+//********* PT *************************************************
+
+/** properties for a given pressure (MPa) and temperature (K) in whichever region
+ * they fall.  Every property is -9998 (iRegion 0) if out of bounds */
+template <class S> Props<S> pt_props (const S &p_MPa, const S &t_K) {
+	Props<S> r;
+
+	switch (region_pt(value(p_MPa), value(t_K))) {
+	case 1 :
+		return r1_props(p_MPa, t_K);
+	case 2 :
+		return r2_props(p_MPa, t_K);
+	case 3 :
+		r = r3_props(r3_rho_pt(p_MPa, t_K), t_K);
+		r.p = p_MPa;  // exact input rather than that recalculated from density
+		return r;
+	case 5 :
+		return r5_props(p_MPa, t_K);
+	}
+	r.p = r.t = r.rho = r.v = r.h = r.u = r.s = r.cp = r.cv = r.w = S(-9998.0);  //error region not valid
+	r.iRegion = 0;
+	return r;
+}
+
+
+} // namespace if97
+
+#endif // IF97_DUAL_HPP
@@ -0,0 +1,158 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* A SHORT PROGRAMME TO CHECK THE DUAL NUMBER (AUTOMATIC DIFFERENTIATION) LAYER
+* *******************************************************************************/
+
+#include "if97_dual.hpp"
+#include <cstdio>
+#include <cmath>
+
+extern "C" {
+#include "IF97_Region1.h"
+#include "IF97_Region2.h"
+#include "IF97_Region4.h"
+#include "IF97_Region5.h"
+#include "IF97_B23.h"
+#include "if97_deriv.h"
+}
+
+#define DUALTESTLOGLOC "IF97DualTest.log"
+
+typedef if97::Dual<2> D2;
+
+
+// compares a result with that expected, to tol significant figures. Pass = 0. See IF97_Common.h for failure codes.
+int testValue (double actual, double expectedOutput, double tol, const char *funcName, FILE *logFile)
+{
+	double error = fabs((actual - expectedOutput) / expectedOutput);
+
+	if (error <= pow(10, -tol)) {
+		if (VERBOSE_TEST)
+			fprintf (logFile, "%s = %.10g \t Expected: %.10g \t Error ratio : %e \t PASS\n", funcName, actual, expectedOutput, error);
+		return TEST_PASS;
+	}
+	if (VERBOSE_TEST)
+		fprintf (logFile, "%s = %.10g \t Expected: %.10g \t Error ratio : %e \t FAIL\n", funcName, actual, expectedOutput, error);
+	return TEST_INCORRECT;
+}
+
+
+/* cp for the central differences.  In region 3 the density from the backwards equations 
+ * is refined by Newton's method, as the differences are otherwise swamped by their error */
+double cp_pt (double p_MPa, double t_K)
+{
+	double rho;
+	if97::Dual<1> pAtRho;
+	int i;
+
+	if (region_pt(p_MPa, t_K) != 3) return if97::pt_props(p_MPa, t_K).cp;
+
+	rho = r3_rho_pt(p_MPa, t_K);
+	for (i = 0; i < 5; i++) {
+		pAtRho = if97::r3_p(if97::Dual<1>::variable(rho, 0), if97::Dual<1>(t_K));
+		rho += (p_MPa - pAtRho.v) / pAtRho.d[0];
+	}
+	return if97::r3_props(rho, t_K).cp;
+}
+
+
+// the double instantiation against the C library, and its derivatives against the analytic partials
+int checkRegion (double p_MPa, double t_K, FILE *logFile)
+{
+	int intermediateResult = TEST_PASS;
+	double rho;
+	if97::Props<double> pd = if97::pt_props(p_MPa, t_K);
+	if97::Props<D2> pad = if97::pt_props(D2::variable(p_MPa, 0), D2::variable(t_K, 1));
+
+	fprintf (logFile, "\np = %g MPa, T = %g K, region %i\n", p_MPa, t_K, pd.iRegion);
+
+	switch (pd.iRegion) {
+	case 1:
+		intermediateResult |= testValue (pd.h, if97_r1_h(p_MPa, t_K), 12, "h", logFile);
+		intermediateResult |= testValue (pd.s, if97_r1_s(p_MPa, t_K), 12, "s", logFile);
+		intermediateResult |= testValue (pd.w, if97_r1_w(p_MPa, t_K), 12, "w", logFile);
+		break;
+	case 2:
+		intermediateResult |= testValue (pd.h, if97_r2_h(p_MPa, t_K), 12, "h", logFile);
+		intermediateResult |= testValue (pd.s, if97_r2_s(p_MPa, t_K), 12, "s", logFile);
+		intermediateResult |= testValue (pd.w, if97_r2_w(p_MPa, t_K), 12, "w", logFile);
+		break;
+	case 3:
+		rho = r3_rho_pt(p_MPa, t_K);
+		intermediateResult |= testValue (pd.h, if97_r3_h(rho, t_K), 12, "h", logFile);
+		intermediateResult |= testValue (pd.s, if97_r3_s(rho, t_K), 12, "s", logFile);
+		intermediateResult |= testValue (pd.w, if97_r3_w(rho, t_K), 12, "w", logFile);
+		break;
+	case 5:
+		intermediateResult |= testValue (pd.h, if97_r5_h(p_MPa, t_K), 12, "h", logFile);
+		intermediateResult |= testValue (pd.s, if97_r5_s(p_MPa, t_K), 12, "s", logFile);
+		intermediateResult |= testValue (pd.w, if97_r5_w(p_MPa, t_K), 12, "w", logFile);
+		break;
+	}
+
+	// the dual values are the double values
+	intermediateResult |= testValue (pad.h.v, pd.h, 13, "dual h", logFile);
+	intermediateResult |= testValue (pad.cp.v, pd.cp, 13, "dual cp", logFile);
+
+	// derivatives.  (dh/dT)_p = cp exactly
+	intermediateResult |= testValue (pad.h.d[1], pd.cp, 10, "(dh/dT)_p", logFile);
+	intermediateResult |= testValue (pad.h.d[0], if97_pt_deriv(p_MPa, t_K, IF97_H, IF97_P, IF97_T), 10, "(dh/dp)_T", logFile);
+	intermediateResult |= testValue (pad.v.d[0], if97_pt_deriv(p_MPa, t_K, IF97_V, IF97_P, IF97_T), 10, "(dv/dp)_T", logFile);
+	intermediateResult |= testValue (pad.v.d[1], if97_pt_deriv(p_MPa, t_K, IF97_V, IF97_T, IF97_P), 10, "(dv/dT)_p", logFile);
+	intermediateResult |= testValue (pad.s.d[0], if97_pt_deriv(p_MPa, t_K, IF97_S, IF97_P, IF97_T), 10, "(ds/dp)_T", logFile);
+
+	/* a second derivative, (dcp/dT)_p, against a central difference.  In region 3 the dual is 
+	 * at the density from the backwards equations, the difference at the exact density */
+	intermediateResult |= testValue (pad.cp.d[1], (cp_pt(p_MPa, t_K + 0.001) - cp_pt(p_MPa, t_K - 0.001)) / 0.002, 
+			(pd.iRegion == 3) ? 4 : 5, "(dcp/dT)_p", logFile);
+
+	return intermediateResult;
+}
+
+
+int main (int argc, char **argv)
+{
+	int intermediateResult = TEST_PASS;
+	FILE *pTestLog = fopen(DUALTESTLOGLOC, "w");
+
+	fprintf (pTestLog, "\n\n*** IF97 DUAL NUMBER (AUTOMATIC DIFFERENTIATION) CHECK ***\n");
+
+	intermediateResult |= checkRegion (3.0, 300.0, pTestLog);
+	intermediateResult |= checkRegion (80.0, 500.0, pTestLog);
+	intermediateResult |= checkRegion (0.0035, 300.0, pTestLog);
+	intermediateResult |= checkRegion (30.0, 700.0, pTestLog);
+	intermediateResult |= checkRegion (25.5837018, 650.0, pTestLog);
+	intermediateResult |= checkRegion (50.0, 700.0, pTestLog);
+	intermediateResult |= checkRegion (0.5, 1500.0, pTestLog);
+	intermediateResult |= checkRegion (30.0, 2000.0, pTestLog);
+
+	fprintf (pTestLog, "\nsaturation line and boundaries\n");
+	{
+		if97::Dual<1> p = if97::Dual<1>::variable(1.0, 0);
+		if97::Dual<1> t = if97::Dual<1>::variable(453.035632, 0);
+
+		intermediateResult |= testValue (if97::r4_ts(1.0), if97_r4_ts(1.0), 14, "r4_ts", pTestLog);
+		intermediateResult |= testValue (if97::r4_ps(453.035632), if97_r4_ps(453.035632), 14, "r4_ps", pTestLog);
+		intermediateResult |= testValue (if97::b23_t(25.0), IF97_B23T(25.0), 14, "b23_t", pTestLog);
+
+		intermediateResult |= testValue (if97::r4_ts(p).d[0], (if97_r4_ts(1.0001) - if97_r4_ts(0.9999)) / 0.0002, 6, "dTs/dp", pTestLog);
+		intermediateResult |= testValue (if97::r4_ps(t).d[0], (if97_r4_ps(453.036632) - if97_r4_ps(453.034632)) / 0.002, 6, "dps/dT", pTestLog);
+		intermediateResult |= testValue (if97::r4_ts(if97::r4_ps(t)).d[0], 1.0, 10, "d Ts(ps(T)) / dT", pTestLog);
+		intermediateResult |= testValue (if97::b23_t(if97::Dual<1>::variable(25.0, 0)).d[0], (IF97_B23T(25.001) - IF97_B23T(24.999)) / 0.002, 6, "dTb23/dp", pTestLog);
+	}
+
+	if (intermediateResult != 0)
+		intermediateResult = intermediateResult | TEST_FAIL;
+
+	fprintf (pTestLog, "\nResults summary for if97_dual : Error code %i \n%s\n", intermediateResult, (intermediateResult == TEST_PASS) ? "PASS" : "FAIL");
+	fclose (pTestLog);
+	printf ("Test log results can be found in %s\n", DUALTESTLOGLOC);
+
+	return intermediateResult;
+}
@@ -0,0 +1,580 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    IAPWS-IF97 states from any pair of properties.  See if97_flash.h
+
+/* The unknowns x[0], x[1] of each region are
+ *   regions 1, 2, 5:  ln p (MPa), T (K)
+ *   region 3:         rho (kg/m3), T (K)
+ *   region 4:         ln p (MPa), x (dryness fraction, 0 to 1)
+ *
+ * The pressure is solved for as its log, as ln pi is, so that no step can make it negative
+ * and a step across decades is no larger than one within a decade.  In the liquid, where
+ * the properties hardly depend on pressure, a step in p would often overshoot below zero.
+ *
+ * if97_deriv gives every property with its derivatives with respect to (p,T), or in
+ * region 4 to (p,x).  [dX/d ln p] = p [dX/dp].  In region 3 they are turned into
+ * derivatives with respect to (rho,T):
+ *
+ * [dX/drho]_T = [dX/dp]_T [dp/drho]_T		[dp/drho]_T = -1 / (rho^2 [dv/dp]_T)
+ * [dX/dT]_rho = [dX/dT]_p + [dX/dp]_T [dp/dT]_rho		[dp/dT]_rho = -[dv/dT]_p / [dv/dp]_T
+ */
+
+
+#include <math.h> // for log, fabs, isfinite
+#include <stdbool.h>
+#include <stddef.h> // for NULL
+
+#include "if97_flash.h"
+#include "if97_lib.h"
+#include "if97_deriv.h"
+#include "IF97_common.h"
+#include "solve.h"
+
+
+#define FLASH_NEWTON_MAX 50  // iterations allowed to each attempt
+#define FLASH_TOL 1e-10  // tolerance of each property, relative to its value or, if larger, its scale
+#define FLASH_MAX_SEEDS 320  // states spread over the regions, from which the iteration starts
+#define FLASH_TRIES 2  // seeds tried in each region, nearest first
+#define FLASH_SAT_POINTS 20  // pressures along the saturation line at which the saturated properties are kept
+#define FLASH_SAT_MARGIN 0.25  // how far outside 0 to 1 the estimated dryness fraction may be for region 4 to be tried
+#define FLASH_X_TOL 1e-8  // how far outside 0 to 1 a dryness fraction found may be, taken as on the saturation line
+#define FLASH_SAT_GUESSES 4  // guesses in region 4 kept from along the saturation line
+#define FLASH_SAT_TOL 1e-9  // tolerance of g (flashSatLever) in placing a guess on the saturation line
+#define FLASH_SAT_SEARCH 40  // golden section steps in looking for a change of sign of g between saturation points
+#define FLASH_GOLDEN 0.6180339887498949  // (sqrt(5) - 1) / 2
+
+
+
+typedef struct sctFlashCtx {
+	int iRegion;
+	enum if97_prop_t prop[2];
+} typFlashCtx;
+
+
+typedef struct sctFlashSeed {
+	int iRegion;
+	double x[2];  // the unknowns of the region
+	double val[IF97_NPROPS];  // the properties there
+} typFlashSeed;
+
+
+typedef struct sctFlashSat {
+	double lnP;  // ln p_MPa
+	double liq[IF97_NPROPS];  // saturated water
+	double vap[IF97_NPROPS];  // saturated steam
+} typFlashSat;
+
+
+// the pair sought along the saturation line
+typedef struct sctFlashSatCtx {
+	const enum if97_prop_t *prop;
+	const double *dblSought;
+} typFlashSatCtx;
+
+
+typFlashSeed flashSeeds[FLASH_MAX_SEEDS];
+int flashNumSeeds = 0;
+typFlashSat flashSat[FLASH_SAT_POINTS];
+bool flashSeedsReady = false;
+
+
+// a size of each property, against which small values are measured
+const double flashScale[IF97_NPROPS] = {0.001, 1.0, 0.0, 100.0, 1.0, 100.0, 100.0};  // P, T, V, H, S, U, G
+
+
+// the largest step in each unknown of each region, so that an error in one (often the 
+// temperature) does not throw the other far away in the first steps
+const double flashMaxStep[6][2] = {{0.0, 0.0}, {1.0, 50.0}, {1.0, 50.0}, {100.0, 50.0}, {1.0, 0.5}, {1.0, 200.0}};
+
+
+
+// ******  Used internally   *******
+
+
+/* properties and their derivatives with respect to the unknowns of iRegion at x.
+ * false if they cannot be evaluated there */
+bool flashPartials(int iRegion, const double *x, typIF97Partials *pd){
+	typSteamState state;
+	double dblP_rho, dblP_T, dblX;
+	int i;
+
+	switch (iRegion) {
+	case 1 :
+	case 2 :
+	case 5 :
+		if (x[1] <= 0.0) return false;
+		state.iRegion = iRegion;
+		state.p_MPa = exp(x[0]);
+		state.t_K = x[1];
+		*pd = if97_state_partials(&state);
+		for (i = 0; i < IF97_NPROPS; i++) pd->d1[i] *= state.p_MPa;
+		break;
+	case 3 :
+		if ((x[0] <= 0.0) || (x[1] <= 0.0)) return false;
+		helm_pt_partials(pd, x[0], x[1]);
+		pd->iRegion = 3;
+		dblP_rho = -1.0 / (sqr(x[0]) * pd->d1[IF97_V]);
+		dblP_T = -pd->d2[IF97_V] / pd->d1[IF97_V];
+		for (i = 0; i < IF97_NPROPS; i++) {
+			pd->d2[i] += pd->d1[i] * dblP_T;
+			pd->d1[i] *= dblP_rho;
+		}
+		break;
+	case 4 :
+		// beyond the saturation lines (x < 0 or x > 1) the mixture is carried on linearly, so that
+		// a step may cross them on its way.  flashValid rejects a solution there
+		dblX = (x[1] < 0.0) ? 0.0 : ((x[1] > 1.0) ? 1.0 : x[1]);
+		*pd = if97_px_partials(exp(x[0]), dblX);
+		if (pd->iRegion != 4) return false;
+		for (i = 0; i < IF97_NPROPS; i++) {
+			pd->val[i] += (x[1] - dblX) * pd->d2[i];
+			pd->d1[i] *= pd->val[IF97_P];
+		}
+		break;
+	default :
+		return false;
+	}
+	for (i = 0; i < IF97_NPROPS; i++)
+		if (!isfinite(pd->val[i]) || !isfinite(pd->d1[i]) || !isfinite(pd->d2[i])) return false;
+	return true;
+}
+
+
+/* the two properties of the pair at x, and their Jacobian, for newton2_solv */
+bool flashFunc(const double *x, void *ctx, double *f, double *jac){
+	typFlashCtx *fc = ctx;
+	typIF97Partials pd;
+	int k;
+
+	if (!flashPartials(fc->iRegion, x, &pd)) return false;
+	for (k = 0; k < 2; k++) {
+		f[k] = pd.val[fc->prop[k]];
+		if (jac != NULL) {
+			jac[2 * k] = pd.d1[fc->prop[k]];
+			jac[2 * k + 1] = pd.d2[fc->prop[k]];
+		}
+	}
+	return true;
+}
+
+
+/* is a solution at x in the region it was found in?  In region 3 it must also be
+ * mechanically stable, and below the critical pressure on its own side of the
+ * saturation line (liquid is denser than critical, steam less dense) */
+bool flashValid(int iRegion, const double *x){
+	typIF97Partials pd;
+
+	switch (iRegion) {
+	case 1 :
+	case 2 :
+	case 5 :
+		return (region_pt(exp(x[0]), x[1]) == iRegion);
+	case 3 :
+		if (!flashPartials(3, x, &pd) || (region_pt(pd.val[IF97_P], x[1]) != 3) || (pd.d1[IF97_P] <= 0.0)) return false;
+		if (pd.val[IF97_P] < IF97_PC)
+			return ((x[1] < if97_r4_ts(pd.val[IF97_P])) == (x[0] > IF97_RHOC));
+		return true;
+	case 4 :
+		// the saturated states themselves may solve to just beyond the saturation lines
+		return (exp(x[0]) >= IF97_P_TRIP / 1e6) && (exp(x[0]) < IF97_PC) && (x[1] >= -FLASH_X_TOL) && (x[1] <= 1.0 + FLASH_X_TOL);
+	}
+	return false;
+}
+
+
+/* adds a seed at (p_MPa or, in region 3, the density, and T) if it is a valid state of iRegion */
+void flashAddSeed(int iRegion, double x0, double x1){
+	double x[2] = {(iRegion == 3) ? x0 : log(x0), x1};
+	typIF97Partials pd;
+	typFlashSeed *seed;
+	int i;
+
+	if ((flashNumSeeds >= FLASH_MAX_SEEDS) || !flashValid(iRegion, x) || !flashPartials(iRegion, x, &pd)) return;
+	seed = &flashSeeds[flashNumSeeds++];
+	seed->iRegion = iRegion;
+	seed->x[0] = x[0];
+	seed->x[1] = x[1];
+	for (i = 0; i < IF97_NPROPS; i++) seed->val[i] = pd.val[i];
+}
+
+
+/* spreads the seeds over regions 1, 2, 3 and 5, and the points along the saturation line.  
+ * Done once, on the first call */
+void flashSeedsInit(void){
+	const double r1T[] = {275.0, 300.0, 350.0, 400.0, 450.0, 500.0, 550.0, 600.0, 620.0};
+	const double r1P[] = {0.01, 0.1, 1.0, 5.0, 10.0, 20.0, 50.0, 100.0};
+	const double r2T[] = {280.0, 320.0, 380.0, 450.0, 550.0, 650.0, 750.0, 900.0, 1050.0};
+	const double r2P[] = {0.001, 0.01, 0.1, 1.0, 5.0, 10.0, 20.0, 50.0, 100.0};
+	const double r3Rho[] = {100.0, 200.0, 280.0, 322.0, 380.0, 450.0, 550.0, 650.0};
+	const double r3T[] = {625.0, 640.0, 650.0, 660.0, 700.0, 750.0, 800.0, 860.0};
+	const double r4P[FLASH_SAT_POINTS] = {IF97_P_TRIP / 1e6, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 
+			1.0, 2.0, 5.0, 10.0, 15.0, 18.0, 20.0, 21.0, 21.7, 22.0};
+	typIF97Partials liq, vap;
+	const double r5T[] = {1100.0, 1400.0, 1700.0, 2000.0, 2250.0};
+	const double r5P[] = {0.001, 0.01, 0.1, 1.0, 10.0, 50.0};
+	int i, j;
+
+	#pragma omp critical (if97_flash_seeds)
+	{
+		if (!flashSeedsReady) {
+			for (i = 0; i < 9; i++) for (j = 0; j < 8; j++) flashAddSeed(1, r1P[j], r1T[i]);
+			for (i = 0; i < 9; i++) for (j = 0; j < 9; j++) flashAddSeed(2, r2P[j], r2T[i]);
+			for (i = 0; i < 8; i++) for (j = 0; j < 8; j++) flashAddSeed(3, r3Rho[j], r3T[i]);
+			for (i = 0; i < FLASH_SAT_POINTS; i++) {
+				liq = if97_px_partials(r4P[i], 0.0);
+				vap = if97_px_partials(r4P[i], 1.0);
+				flashSat[i].lnP = log(r4P[i]);
+				for (j = 0; j < IF97_NPROPS; j++) {
+					flashSat[i].liq[j] = liq.val[j];
+					flashSat[i].vap[j] = vap.val[j];
+				}
+			}
+			for (i = 0; i < 5; i++) for (j = 0; j < 6; j++) flashAddSeed(5, r5P[j], r5T[i]);
+			flashSeedsReady = true;
+		}
+	}
+}
+
+
+/* how far a property's value is from the sought value, for choosing the nearest seed.
+ * Pressure and volume span decades, so are compared on a log scale */
+double flashDistance(enum if97_prop_t prop, double dblVal, double dblSought){
+	if ((prop == IF97_P) || (prop == IF97_V))
+		return ((dblVal > 0.0) && (dblSought > 0.0)) ? log(dblVal / dblSought) : 1e10;
+	return (dblVal - dblSought) / (fabs(dblSought) + flashScale[prop]);
+}
+
+
+/* from saturated properties liq and vap, the dryness fraction which gives the second of the pair,
+ * and g, which is zero where the pair is met at that pressure.  With p or T first g is its 
+ * difference from the sought value, otherwise the difference of the two dryness fractions */
+void flashSatLever(const double *liq, const double *vap, const enum if97_prop_t *prop, const double *dblSought, double *g, double *dblX){
+	*dblX = (dblSought[1] - liq[prop[1]]) / (vap[prop[1]] - liq[prop[1]]);
+	if ((prop[0] == IF97_P) || (prop[0] == IF97_T))
+		*g = liq[prop[0]] - dblSought[0];
+	else
+		*g = (dblSought[0] - liq[prop[0]]) / (vap[prop[0]] - liq[prop[0]]) - *dblX;
+}
+
+
+/* the lever at ln p on the saturation line itself, between the saturation points */
+void flashSatLeverAt(double lnP, const typFlashSatCtx *sc, double *g, double *dblX){
+	typIF97Partials liq = if97_px_partials(exp(lnP), 0.0);
+	typIF97Partials vap = if97_px_partials(exp(lnP), 1.0);
+
+	flashSatLever(liq.val, vap.val, sc->prop, sc->dblSought, g, dblX);
+}
+
+
+/* g at ln p, for ctx_solv */
+double flashSatG(double lnP, void *ctx){
+	double g, dblX;
+
+	flashSatLeverAt(lnP, ctx, &g, &dblX);
+	return g;
+}
+
+
+/* solves g = 0 between ln p lo and hi, where it changes sign, and adds the root to the guesses 
+ * x if its dryness fraction is not far outside 0 to 1 */
+void flashSatRoot(typFlashSatCtx *sc, double lo, double hi, double dblGuess, double x[][2], int *nGuesses){
+	typSolvBounds bounds = {lo, hi};
+	typSolvResult slvResult;
+	double g, dblX;
+
+	if (*nGuesses >= FLASH_SAT_GUESSES) return;
+	slvResult = ctx_solv(flashSatG, NULL, sc, 0.0, dblGuess, 0.0, &bounds, FLASH_SAT_TOL, SLV_ABS, FLASH_NEWTON_MAX);
+	if (slvResult.iErrCode != SOLVE_CONVERGE) return;
+	flashSatLeverAt(slvResult.dSolution, sc, &g, &dblX);
+	if ((dblX < -FLASH_SAT_MARGIN) || (dblX > 1.0 + FLASH_SAT_MARGIN)) return;
+	x[*nGuesses][0] = slvResult.dSolution;
+	x[*nGuesses][1] = dblX;
+	(*nGuesses)++;
+}
+
+
+/* guesses x (ln p, dryness fraction) in region 4, wherever g changes sign along the saturation 
+ * line.  Where it changes sign between two saturation points it is solved for between them.  
+ * Where it only comes close to zero at a saturation point, as (h,s) of wet steam of a low quality 
+ * does, the lowest point of |g| about it is searched for a change of sign that the saturation 
+ * points step over.  Returns the number of guesses, of which those with a dryness fraction in 
+ * 0 to 1 (to within FLASH_X_TOL) are two phase, and the others just outside (so that a solution 
+ * may still be two phase) */
+int flashSatGuess(const enum if97_prop_t *prop, const double *dblSought, double x[][2]){
+	typFlashSatCtx sc = {prop, dblSought};
+	double g[FLASH_SAT_POINTS], dblX[FLASH_SAT_POINTS];
+	double a, b, c, d, gc, gd, dblSign, dblMid;
+	int k, j, nGuesses = 0;
+	
+	for (k = 0; k < FLASH_SAT_POINTS; k++) flashSatLever(flashSat[k].liq, flashSat[k].vap, prop, dblSought, &g[k], &dblX[k]);
+	
+	for (k = 0; k < FLASH_SAT_POINTS - 1; k++) {
+		if ((g[k] == 0.0) || ((g[k] < 0.0) != (g[k + 1] < 0.0))) {
+			flashSatRoot(&sc, flashSat[k].lnP, flashSat[k + 1].lnP, 
+					flashSat[k].lnP + g[k] / (g[k] - g[k + 1]) * (flashSat[k + 1].lnP - flashSat[k].lnP), x, &nGuesses);
+			continue;
+		}
+		if ((k == 0) || ((g[k] < 0.0) != (g[k - 1] < 0.0)) || (fabs(g[k]) >= fabs(g[k - 1])) || (fabs(g[k]) > fabs(g[k + 1]))
+				|| (dblX[k] < -FLASH_SAT_MARGIN) || (dblX[k] > 1.0 + FLASH_SAT_MARGIN)) continue;
+		
+		// golden section search for the lowest |g| between the neighbouring points, until g changes sign
+		dblSign = (g[k] < 0.0) ? -1.0 : 1.0;
+		a = flashSat[k - 1].lnP;
+		b = flashSat[k + 1].lnP;
+		c = b - FLASH_GOLDEN * (b - a);
+		d = a + FLASH_GOLDEN * (b - a);
+		gc = dblSign * flashSatG(c, &sc);
+		gd = dblSign * flashSatG(d, &sc);
+		for (j = 0; (j < FLASH_SAT_SEARCH) && (gc > 0.0) && (gd > 0.0); j++) {
+			if (gc < gd) {
+				b = d;	d = c;	gd = gc;
+				c = b - FLASH_GOLDEN * (b - a);
+				gc = dblSign * flashSatG(c, &sc);
+			}
+			else {
+				a = c;	c = d;	gc = gd;
+				d = a + FLASH_GOLDEN * (b - a);
+				gd = dblSign * flashSatG(d, &sc);
+			}
+		}
+		if (gc <= 0.0) dblMid = c;
+		else if (gd <= 0.0) dblMid = d;
+		else continue;  // close to the saturation line, but not on it
+		flashSatRoot(&sc, a, dblMid, 0.5 * (a + dblMid), x, &nGuesses);
+		flashSatRoot(&sc, dblMid, b, 0.5 * (dblMid + b), x, &nGuesses);
+	}
+	return nGuesses;
+}
+
+
+/* fills the state at a solution x of iRegion, with the properties in iMask */
+void flashFillState(int iRegion, const double *x, int iMask, typSteamState *state){
+	typSteamState liq, vap;
+	typIF97Partials pd;
+	double dblX;
+
+	if97_clear_state(state);
+	state->iRegion = iRegion;
+
+	switch (iRegion) {
+	case 1 :
+		state->phase = LIQUID;
+		state->p_MPa = exp(x[0]);
+		state->t_K = x[1];
+		if97_r1_props(state->p_MPa, x[1], iMask | IF97_MASK_V, state);
+		break;
+	case 2 :
+		state->phase = VAPOUR;
+		state->p_MPa = exp(x[0]);
+		state->t_K = x[1];
+		if97_r2_props(state->p_MPa, x[1], iMask | IF97_MASK_V, state);
+		break;
+	case 3 :
+		flashPartials(3, x, &pd);
+		state->phase = (x[0] > IF97_RHOC) ? LIQUID : VAPOUR;
+		state->p_MPa = pd.val[IF97_P];
+		state->t_K = x[1];
+		if97_r3_props(x[0], x[1], iMask | IF97_MASK_V, state);
+		break;
+	case 4 :
+		dblX = (x[1] < 0.0) ? 0.0 : ((x[1] > 1.0) ? 1.0 : x[1]);
+		state->phase = WET;
+		state->p_MPa = exp(x[0]);
+		state->t_K = if97_r4_ts(state->p_MPa);
+		state->qual_pct = 100.0 * dblX;
+		sat_props(state->p_MPa, state->t_K, false, (iMask | IF97_MASK_V) & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &liq);
+		sat_props(state->p_MPa, state->t_K, true, (iMask | IF97_MASK_V) & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &vap);
+
+		// specific volume, not density, is a mass weighted average
+		state->rho_kgperM3 = 1.0 / (1.0 / liq.rho_kgperM3 + dblX * (1.0 / vap.rho_kgperM3 - 1.0 / liq.rho_kgperM3));
+		if (iMask & IF97_MASK_H)
+			state->h_kJperkg = liq.h_kJperkg + dblX * (vap.h_kJperkg - liq.h_kJperkg);
+		if (iMask & IF97_MASK_U)
+			state->u_kJperkg = liq.u_kJperkg + dblX * (vap.u_kJperkg - liq.u_kJperkg);
+		if (iMask & IF97_MASK_S)
+			state->s_kJperkgK = liq.s_kJperkgK + dblX * (vap.s_kJperkgK - liq.s_kJperkgK);
+		break;
+	case 5 :
+		state->phase = VAPOUR;
+		state->p_MPa = exp(x[0]);
+		state->t_K = x[1];
+		if97_r5_props(state->p_MPa, x[1], iMask | IF97_MASK_V, state);
+		break;
+	}
+}
+
+
+
+/* solves the pair in ctx's region from guess x.  If the solution is in the region,
+ * fills state with it and returns true */
+bool flashSolve(typFlashCtx *ctx, const double *dblSought, const double *x, const double *dblTol, int iMask, typSteamState *state){
+	typSolvResult2 slvResult;
+	double xSat[2], f[2];
+	int k;
+	
+	slvResult = newton2_solv(flashFunc, ctx, dblSought, x, flashMaxStep[ctx->iRegion], dblTol, SLV_ABS, FLASH_NEWTON_MAX);
+	if ((slvResult.iErrCode != SOLVE_CONVERGE) || !flashValid(ctx->iRegion, slvResult.dSolution)) return false;
+
+	// a solution just beyond the saturation lines is taken as on them only if the pair is still met 
+	// there.  Otherwise it is compressed liquid or superheated steam, for the other regions to find
+	if ((ctx->iRegion == 4) && ((slvResult.dSolution[1] < 0.0) || (slvResult.dSolution[1] > 1.0))) {
+		xSat[0] = slvResult.dSolution[0];
+		xSat[1] = (slvResult.dSolution[1] < 0.0) ? 0.0 : 1.0;
+		if (!flashFunc(xSat, ctx, f, NULL)) return false;
+		for (k = 0; k < 2; k++)
+			if (fabs(f[k] - dblSought[k]) > dblTol[k]) return false;
+	}
+	flashFillState(ctx->iRegion, slvResult.dSolution, iMask, state);
+	return true;
+}
+
+
+/* solves the pair in region 4 from the guesses x of flashSatGuess with a dryness fraction in 0 to 1
+ * (bWet), or from those just outside it.  Fills state with the first solution found and returns true */
+bool flashSolveSat(typFlashCtx *ctx, const double *dblSought, double x[][2], int nSat, bool bWet, const double *dblTol, int iMask, typSteamState *state){
+	int k;
+
+	ctx->iRegion = 4;
+	for (k = 0; k < nSat; k++)
+		if ((((x[k][1] >= -FLASH_X_TOL) && (x[k][1] <= 1.0 + FLASH_X_TOL)) == bWet) && flashSolve(ctx, dblSought, x[k], dblTol, iMask, state))
+			return true;
+	return false;
+}
+
+
+
+// ******  External   *******
+
+
+/** steam state at which the pair of properties pairType takes the values a and b.  See if97_flash.h */
+int if97_flash(enum if97_pair_t pairType, double a, double b, int iMask, typSteamState *state){
+	return if97_flash_region(pairType, a, b, 0, iMask, state);
+}
+
+
+/** as if97_flash, but trying iRegion first.  See if97_flash.h */
+int if97_flash_region(enum if97_pair_t pairType, double a, double b, int iRegion, int iMask, typSteamState *state){
+	const enum if97_prop_t pairProps[IF97_NPAIRS][2] = {
+		{IF97_P, IF97_T}, {IF97_P, IF97_H}, {IF97_P, IF97_S}, {IF97_P, IF97_V}, {IF97_T, IF97_H},
+		{IF97_T, IF97_S}, {IF97_T, IF97_V}, {IF97_H, IF97_S}, {IF97_U, IF97_V}, {IF97_V, IF97_U}};
+	typFlashCtx ctx;
+	typSolvResult2 slvResult;
+	double dblSought[2], dblTol[2];
+	double dblNearest[6][FLASH_TRIES];  // the distances of the nearest seeds of each region, nearest first
+	int iNearest[6][FLASH_TRIES];  // and their indices in flashSeeds
+	int iOrder[4] = {1, 2, 3, 5};
+	double dblDist, dblSatGuess[FLASH_SAT_GUESSES][2], xStart[2];
+	int i, j, k, iSeedRegion, nSat;
+	bool bSatFirst;
+
+	if ((pairType < 0) || (pairType >= IF97_NPAIRS) || (iRegion < 0) || (iRegion > 5)) {
+		if97_clear_state(state);
+		state->iRegion = 0;
+		return SOLVE_NOT_DEFINED;
+	}
+
+	// the pairs with region boundaries and backwards equations of their own
+	switch (pairType) {
+	case IF97_PAIR_PT :
+		*state = if97_pt_state_mask(a, b, iMask | IF97_MASK_V);
+		return (state->iRegion == 0) ? SOLVE_NO_CONVERGE : SOLVE_CONVERGE;
+	case IF97_PAIR_PH :
+		*state = if97_ph_state_mask(a, b, iMask | IF97_MASK_V);
+		return (state->iRegion == 0) ? SOLVE_NO_CONVERGE : SOLVE_CONVERGE;
+	case IF97_PAIR_PS :
+		*state = if97_ps_state_mask(a, b, iMask | IF97_MASK_V);
+		return (state->iRegion == 0) ? SOLVE_NO_CONVERGE : SOLVE_CONVERGE;
+	default :
+		break;
+	}
+
+	ctx.prop[0] = pairProps[pairType][0];
+	ctx.prop[1] = pairProps[pairType][1];
+	dblSought[0] = (pairType == IF97_PAIR_RHOU) ? 1.0 / a : a;  // the density is solved as specific volume
+	dblSought[1] = b;
+	for (k = 0; k < 2; k++) {
+		dblTol[k] = FLASH_TOL * fabs(dblSought[k]);
+		if (dblTol[k] < FLASH_TOL * flashScale[ctx.prop[k]]) dblTol[k] = FLASH_TOL * flashScale[ctx.prop[k]];
+	}
+
+	// the nearest seeds in each region
+	flashSeedsInit();
+	for (iSeedRegion = 1; iSeedRegion <= 5; iSeedRegion++)
+		for (j = 0; j < FLASH_TRIES; j++) {
+			dblNearest[iSeedRegion][j] = HUGE_VAL;
+			iNearest[iSeedRegion][j] = -1;
+		}
+	for (i = 0; i < flashNumSeeds; i++) {
+		iSeedRegion = flashSeeds[i].iRegion;
+		dblDist = sqr(flashDistance(ctx.prop[0], flashSeeds[i].val[ctx.prop[0]], dblSought[0]))
+				+ sqr(flashDistance(ctx.prop[1], flashSeeds[i].val[ctx.prop[1]], dblSought[1]));
+		for (j = FLASH_TRIES - 1; (j >= 0) && (dblDist < dblNearest[iSeedRegion][j]); j--) {
+			if (j < FLASH_TRIES - 1) {
+				dblNearest[iSeedRegion][j + 1] = dblNearest[iSeedRegion][j];
+				iNearest[iSeedRegion][j + 1] = iNearest[iSeedRegion][j];
+			}
+			dblNearest[iSeedRegion][j] = dblDist;
+			iNearest[iSeedRegion][j] = i;
+		}
+	}
+
+	// the single phase regions in order of their nearest seed, but the one asked for first
+	for (i = 1; i < 4; i++)
+		for (j = i; (j > 0) && ((iOrder[j] == iRegion) || ((iOrder[j - 1] != iRegion) && (dblNearest[iOrder[j]][0] < dblNearest[iOrder[j - 1]][0]))); j--) {
+			k = iOrder[j];
+			iOrder[j] = iOrder[j - 1];
+			iOrder[j - 1] = k;
+		}
+
+	// two phase is tried first from wherever the saturation line puts the pair there, last from where only 
+	// close.  But compressed liquid has the (T,h) or (T,s) of wet steam of a low quality, and is tried first
+	nSat = flashSatGuess(ctx.prop, dblSought, dblSatGuess);
+	bSatFirst = (iRegion == 4) || ((iRegion == 0) && ((pairType != IF97_PAIR_TH) && (pairType != IF97_PAIR_TS)));
+	if (bSatFirst && flashSolveSat(&ctx, dblSought, dblSatGuess, nSat, true, dblTol, iMask, state))
+		return SOLVE_CONVERGE;
+
+	for (i = 0; i < 4; i++) {
+		ctx.iRegion = iOrder[i];
+		for (j = 0; (j < FLASH_TRIES) && (iNearest[ctx.iRegion][j] >= 0); j++) {
+			// with T or p given, the seed is moved to it, so that only the other is iterated for.  Where the 
+			// property sought depends far more on T than on p (as s and h of the liquid) a step in both from 
+			// a seed at another temperature can run far off in p
+			xStart[0] = flashSeeds[iNearest[ctx.iRegion][j]].x[0];
+			xStart[1] = flashSeeds[iNearest[ctx.iRegion][j]].x[1];
+			if (ctx.prop[0] == IF97_T) xStart[1] = dblSought[0];
+			else if ((ctx.prop[0] == IF97_P) && (ctx.iRegion != 3)) xStart[0] = log(dblSought[0]);
+			slvResult = newton2_solv(flashFunc, &ctx, dblSought, xStart, flashMaxStep[ctx.iRegion], dblTol, SLV_ABS, FLASH_NEWTON_MAX);
+			if (slvResult.iErrCode != SOLVE_CONVERGE) continue;  // perhaps from the next seed
+			
+			if (flashValid(ctx.iRegion, slvResult.dSolution)) {
+				flashFillState(ctx.iRegion, slvResult.dSolution, iMask, state);
+				return SOLVE_CONVERGE;
+			}
+			
+			// a solution of a Gibbs region's equations in another region is usually close to the 
+			// solution in that region, so it is tried next, and the other seeds would find the same.
+			// Otherwise (out of range), there may be a second solution
+			if (ctx.iRegion == 3) continue;
+			iSeedRegion = region_pt(exp(slvResult.dSolution[0]), slvResult.dSolution[1]);
+			if (iSeedRegion == 0) continue;
+			for (k = i + 2; k < 4; k++)
+				if (iOrder[k] == iSeedRegion) {
+					iOrder[k] = iOrder[i + 1];
+					iOrder[i + 1] = iSeedRegion;
+				}
+			break;
+		}
+	}
+
+	if ((!bSatFirst && flashSolveSat(&ctx, dblSought, dblSatGuess, nSat, true, dblTol, iMask, state))
+			|| flashSolveSat(&ctx, dblSought, dblSatGuess, nSat, false, dblTol, iMask, state))
+		return SOLVE_CONVERGE;
+
+	if97_clear_state(state);
+	state->iRegion = 0;
+	return SOLVE_NO_CONVERGE;
+}
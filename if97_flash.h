@@ -0,0 +1,88 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    IAPWS-IF97 states from any pair of properties
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_flash.h
+ * @author Martin Lord
+ * @brief steam state from a pair of properties other than (p,T)
+ * @details
+ * if97_flash finds the state at which two given properties take the given values,
+ * by Newton's method in two variables (newton2_solv) with the analytic Jacobian
+ * from the free energy derivatives (if97_deriv.h).  Each region is solved in
+ * the variables its free energy is written in, but with ln p for p so that it stays
+ * positive: (ln p,T) in regions 1, 2 and 5, (rho,T) in region 3, and (ln p,x) in the
+ * two phase region 4, where the saturated properties are from the saturation line.  \n
+ *
+ * The region is found by trial.  A fixed set of states is spread over each single
+ * phase region, and those regions are tried in order of how close their nearest state
+ * is to the inputs, each from that state.  The pair is also compared with the saturated
+ * properties along the saturation line: wherever it lies between the saturated liquid and
+ * vapour, region 4 is tried first, from the quality and pressure so found, and wherever it
+ * lies only close to them, last.  A solution is accepted only if it lies in the
+ * region it was found in (by region_pt), and in region 3 if it is on the stable
+ * branch, on its own side of the saturation line.  (p,h) and (p,s) have region
+ * boundaries and backwards equations of their own, so are as if97_ph_state_mask and
+ * if97_ps_state_mask, and (p,T) as if97_pt_state_mask.  \n
+ *
+ * Some pairs do not fix a single state everywhere: (T,h) and (T,v) have two liquid
+ * states over small ranges, as does (p,v) below 4 C.  Compressed liquid has the (T,h) of wet 
+ * steam of a low quality at a lower pressure, as it has the (T,s) below 4 C.  For (T,h) and 
+ * (T,s) the single phase state is returned where there is one, and for the other pairs the 
+ * wet steam.  if97_flash_region returns the state in the region asked for where there is one.  
+ * Of two states in a single phase region, the one nearer a seed is returned. \n
+ *
+ * UNITS  p: MPa, T: K, v: m3/kg, rho: kg/m3, h, u: kJ/kg, s: kJ/kg/K
+ *
+ * @see http://www.iapws.org/relguide/IF97-Rev.html
+ */
+
+
+#ifndef IF97_FLASH_H
+#define IF97_FLASH_H
+
+#include "IF97_common.h"
+
+
+// pairs of properties from which a state may be found.  The first of the pair is a in if97_flash, the second b
+enum if97_pair_t {
+	IF97_PAIR_PT = 0,	// pressure, temperature
+	IF97_PAIR_PH = 1,	// pressure, specific enthalpy
+	IF97_PAIR_PS = 2,	// pressure, specific entropy
+	IF97_PAIR_PV = 3,	// pressure, specific volume
+	IF97_PAIR_TH = 4,	// temperature, specific enthalpy
+	IF97_PAIR_TS = 5,	// temperature, specific entropy
+	IF97_PAIR_TV = 6,	// temperature, specific volume
+	IF97_PAIR_HS = 7,	// specific enthalpy, specific entropy
+	IF97_PAIR_UV = 8,	// specific internal energy, specific volume
+	IF97_PAIR_RHOU = 9,	// density, specific internal energy
+	IF97_NPAIRS = 10,
+};
+
+
+/** steam state at which the pair of properties pairType takes the values a and b, with the
+ * properties selected by iMask (IF97_MASK_*) calculated.  p_MPa, t_K, the density, the quality
+ * and the region are always set.  Returns SOLVE_CONVERGE (0) if a state was found, otherwise
+ * SOLVE_NO_CONVERGE with the state's region 0 (out of range), or SOLVE_NOT_DEFINED for an
+ * unknown pairType */
+int if97_flash(enum if97_pair_t pairType, double a, double b, int iMask, typSteamState *state);
+
+
+/** as if97_flash, but the region iRegion (1 to 5) is tried first, so that of two states with the 
+ * same pair (see above) the one in iRegion is returned.  iRegion 0 tries the regions as if97_flash.  
+ * Returns SOLVE_NOT_DEFINED for an iRegion outside 0 to 5 */
+int if97_flash_region(enum if97_pair_t pairType, double a, double b, int iRegion, int iMask, typSteamState *state);
+
+
+#endif // IF97_FLASH_H
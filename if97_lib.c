@@ -20,13 +20,19 @@
 
 #include "IF97_common.h"  //PSTAR TSTAR & sqr
 #include "IF97_Region1.h"
+#include "IF97_Region1bw.h"
 #include "IF97_Region2.h"
+#include "IF97_Region2bw.h"
 #include "IF97_B23.h"
 #include "IF97_Region3.h"
 #include "IF97_Region4.h"
 #include "IF97_Region5.h"
 #include "solve.h"
-#include <math.h> // for pow, log
+#include "if97_stats.h"
+#include "if97_record.h"
+#include "if97_lib.h"
+#include <math.h> // for pow, log, isfinite
+#include <stdlib.h> // for malloc
 
 
 #include <stdio.h>  //used for debugging only
@@ -42,31 +48,533 @@
 */
 int region_pt(double p_MPa, double t_K) {
 	
-	if (p_MPa > IF97_R1_UPRESS )  return 0 ; // valid also for R2, R3
+	if (p_MPa > IF97_R1_UPRESS )  return IF97_STATS_REGION(0); // valid also for R2, R3
 	
-	else if (t_K > IF97_R5_UTEMP)  return 0 ; // outside valid bounds
+	else if (t_K > IF97_R5_UTEMP)  return IF97_STATS_REGION(0); // outside valid bounds
 	
-	else if (t_K < IF97_R1_LTEMP )  return 0 ; // outside valid bounds
+	else if (t_K < IF97_R1_LTEMP )  return IF97_STATS_REGION(0); // outside valid bounds
 	
-	else if (p_MPa < IF97_R1_LPRESS )  return 0 ; // valid also for R2
+	else if (p_MPa < IF97_R1_LPRESS )  return IF97_STATS_REGION(0); // valid also for R2
 			
 	else if (t_K > IF97_R2_UTEMP) {
-		if (p_MPa > IF97_R5_UPRESS) return 0;
-		else return 5;
+		if (p_MPa > IF97_R5_UPRESS) return IF97_STATS_REGION(0);
+		else return IF97_STATS_REGION(5);
 	}
 
 	else if (p_MPa < IF97_B23_LPRESS){
-		if (if97_r4_ts (p_MPa)> t_K) return 1;
-		else return 2;	
+		if (if97_r4_ts (p_MPa)> t_K) return IF97_STATS_REGION(1);
+		else return IF97_STATS_REGION(2);	
 	} 
 	
 
 	else if (t_K < IF97_R1_UTEMP) {
-		return 1;
+		return IF97_STATS_REGION(1);
 		}
-	else if  (IF97_B23T(p_MPa) < t_K) return 2;
+	else if  (IF97_B23T(p_MPa) < t_K) return IF97_STATS_REGION(2);
 	
-	else return 3;
+	else return IF97_STATS_REGION(3);
+}
+
+
+
+/* density in region 3 for a given pressure and temperature.  Uses the backwards
+ * equations, iterating on them with the secant method in the auxiliary zone near critical  */
+double r3_rho_pt(double p_MPa, double t_K) {
+	typSolvResult slvResult;
+	typIF97R3Isotherm iso;
+	
+	if (!(isNearCritical(p_MPa, t_K))) return 1/if97_R3bw_v_pt (p_MPa, t_K);
+	
+	IF97_STATS_NEAR_CRITICAL();  // here, not in isNearCritical, which the if97_pt_ functions also ask
+	if97_r3_isotherm(t_K, &iso);  // the secant of secant_solv, without the powers of tau at each step
+	slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, NULL, TEST_ACCURACY, SIG_FIG, 100 );
+	return slvResult.dSolution;
+}
+
+
+
+/* density of saturated water (bVapour false) or steam (bVapour true) in region 3.
+ * The backwards equations are evaluated just off the saturation line on the 
+ * required side, then refined by iteration on the saturation line.  Close to the 
+ * critical point the isotherm has three roots close together, and the secant may 
+ * reach the wrong one.  The root is then bracketed about the guess, widening the 
+ * bracket until it is found */
+double r3_rho_sat(double p_MPa, double ts_K, bool bVapour) {
+	typSolvResult slvResult;
+	typSolvBounds bounds;
+	double dblRhoGuess = 1/if97_R3bw_v_pt (p_MPa, bVapour ? ts_K + 0.0001 : ts_K - 0.0001);
+	double dblWidth;
+	typIF97R3Isotherm iso;
+	
+	if97_r3_isotherm(ts_K, &iso);
+	slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, p_MPa, dblRhoGuess, 0.05, NULL, TEST_ACCURACY, SIG_FIG, 100 );
+	if (!isfinite(dblRhoGuess) || ((slvResult.iErrCode == SOLVE_CONVERGE) && (bVapour == (slvResult.dSolution < IF97_RHOC))))
+		return slvResult.dSolution;
+	
+	for (dblWidth = 0.005; dblWidth < 0.5; dblWidth *= 2.0) {
+		bounds.dblLower = dblRhoGuess * (1.0 - dblWidth);
+		bounds.dblUpper = dblRhoGuess * (1.0 + dblWidth);
+		if ((if97_r3_p_iso(bounds.dblLower, &iso) - p_MPa) * (if97_r3_p_iso(bounds.dblUpper, &iso) - p_MPa) <= 0.0) break;
+	}
+	slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, p_MPa, dblRhoGuess, 0.05, &bounds, TEST_ACCURACY, SIG_FIG, 100 );
+	return slvResult.dSolution;
+}
+
+
+
+/* density in region 3 for arrays of n pressures and temperatures, each as r3_rho_pt gives.
+ * The points in the auxiliary zone near critical are iterated on together by secant_solv_n */
+void r3_rho_pt_n(const double *p_MPa, const double *t_K, double *rho_kgPerM3, int n) {
+	double *dblWork = malloc(3 * (size_t) n * sizeof(double));
+	double *dblP, *dblT, *dblGuess;
+	typSolvResult *slvResults = malloc((size_t) n * sizeof(typSolvResult));
+	int *iLane = malloc((size_t) n * sizeof(int));
+	int j, k, m = 0;
+	
+	if ((dblWork == NULL) || (slvResults == NULL) || (iLane == NULL)) {
+		for (k = 0; k < n; k++) rho_kgPerM3[k] = r3_rho_pt(p_MPa[k], t_K[k]);
+	}
+	else {
+		dblP = dblWork;
+		dblT = dblP + n;
+		dblGuess = dblT + n;
+		for (k = 0; k < n; k++) {
+			rho_kgPerM3[k] = 1/if97_R3bw_v_pt (p_MPa[k], t_K[k]);
+			if (!(isNearCritical(p_MPa[k], t_K[k]))) continue;
+			dblP[m] = p_MPa[k];
+			dblT[m] = t_K[k];
+			dblGuess[m] = rho_kgPerM3[k];
+			iLane[m++] = k;
+		}
+		
+		secant_solv_n(if97_r3_p_n, dblT, false, dblP, dblGuess, 0.05, TEST_ACCURACY, SIG_FIG, 100, slvResults, m);
+		for (j = 0; j < m; j++) 
+			rho_kgPerM3[iLane[j]] = (slvResults[j].iErrCode & SOLVE_NO_MEMORY) ? r3_rho_pt(dblP[j], dblT[j]) : slvResults[j].dSolution;
+	}
+	free(dblWork);
+	free(slvResults);
+	free(iLane);
+}
+
+
+
+/* properties selected by iMask of saturated water (bVapour false) or steam (bVapour true)
+ * at p_MPa and its saturation temperature ts_K.  The density is always set.
+ * Below IF97_B23_LPRESS the saturated states are in regions 1 and 2, above it in region 3, 
+ * consistent with region_pt */
+void sat_props(double p_MPa, double ts_K, bool bVapour, int iMask, typSteamState *state) {
+	
+	if (p_MPa >= IF97_B23_LPRESS) {
+		state->rho_kgperM3 = r3_rho_sat(p_MPa, ts_K, bVapour);
+		if97_r3_props(state->rho_kgperM3, ts_K, iMask, state);
+	}
+	else if (bVapour) 
+		if97_r2_props(p_MPa, ts_K, iMask | IF97_MASK_V, state);
+	else 
+		if97_r1_props(p_MPa, ts_K, iMask | IF97_MASK_V, state);
+}
+
+
+
+/* returns the region for a given pressure and enthalpy.
+* 0 = out of bounds.  4 = two phase
+* The boundaries follow region_pt, so that a state keeps its region when converted
+*/
+int region_ph(double p_MPa, double h_kJperkg) {
+	typSteamState liq, vap;
+	double ts_K;
+	
+	if ((p_MPa <= IF97_R1_LPRESS ) || (p_MPa > IF97_R1_UPRESS )) return 0 ; // valid also for R2, R3
+	
+	if (h_kJperkg < if97_r1_h(p_MPa, IF97_R1_LTEMP)) return 0 ; // outside valid bounds
+	
+	if (p_MPa < IF97_PC) {
+		ts_K = if97_r4_ts (p_MPa);
+		sat_props(p_MPa, ts_K, false, IF97_MASK_H, &liq);
+		sat_props(p_MPa, ts_K, true, IF97_MASK_H, &vap);
+		
+		if (h_kJperkg <= liq.h_kJperkg) {
+			if (p_MPa < IF97_B23_LPRESS) return 1;
+			else if (h_kJperkg <= if97_r1_h(p_MPa, IF97_R1_UTEMP)) return 1;
+			else return 3;
+		}
+		else if (h_kJperkg < vap.h_kJperkg) return 4;
+		
+		else if (p_MPa < IF97_B23_LPRESS){
+			if (h_kJperkg <= if97_r2_h(p_MPa, IF97_R2_UTEMP)) return 2;
+			else if ((p_MPa <= IF97_R5_UPRESS) && (h_kJperkg <= if97_r5_h(p_MPa, IF97_R5_UTEMP))) return 5;
+			else return 0;
+		}
+	}
+	else if (h_kJperkg <= if97_r1_h(p_MPa, IF97_R1_UTEMP)) return 1;
+	
+	if (h_kJperkg < if97_r2_h(p_MPa, IF97_B23T(p_MPa))) return 3;
+	else if (h_kJperkg <= if97_r2_h(p_MPa, IF97_R2_UTEMP)) return 2;
+	else if ((p_MPa <= IF97_R5_UPRESS) && (h_kJperkg <= if97_r5_h(p_MPa, IF97_R5_UTEMP))) return 5;
+	
+	return 0;
+}
+
+
+
+
+/* returns the region for a given pressure and entropy.
+* 0 = out of bounds.  4 = two phase
+* The boundaries follow region_pt, as region_ph
+*/
+int region_ps(double p_MPa, double s_kJperkgK) {
+	typSteamState liq, vap;
+	double ts_K;
+	
+	if ((p_MPa <= IF97_R1_LPRESS ) || (p_MPa > IF97_R1_UPRESS )) return 0 ; // valid also for R2, R3
+	
+	if (s_kJperkgK < if97_r1_s(p_MPa, IF97_R1_LTEMP)) return 0 ; // outside valid bounds
+	
+	if (p_MPa < IF97_PC) {
+		ts_K = if97_r4_ts (p_MPa);
+		sat_props(p_MPa, ts_K, false, IF97_MASK_S, &liq);
+		sat_props(p_MPa, ts_K, true, IF97_MASK_S, &vap);
+		
+		if (s_kJperkgK <= liq.s_kJperkgK) {
+			if (p_MPa < IF97_B23_LPRESS) return 1;
+			else if (s_kJperkgK <= if97_r1_s(p_MPa, IF97_R1_UTEMP)) return 1;
+			else return 3;
+		}
+		else if (s_kJperkgK < vap.s_kJperkgK) return 4;
+		
+		else if (p_MPa < IF97_B23_LPRESS){
+			if (s_kJperkgK <= if97_r2_s(p_MPa, IF97_R2_UTEMP)) return 2;
+			else if ((p_MPa <= IF97_R5_UPRESS) && (s_kJperkgK <= if97_r5_s(p_MPa, IF97_R5_UTEMP))) return 5;
+			else return 0;
+		}
+	}
+	else if (s_kJperkgK <= if97_r1_s(p_MPa, IF97_R1_UTEMP)) return 1;
+	
+	if (s_kJperkgK < if97_r2_s(p_MPa, IF97_B23T(p_MPa))) return 3;
+	else if (s_kJperkgK <= if97_r2_s(p_MPa, IF97_R2_UTEMP)) return 2;
+	else if ((p_MPa <= IF97_R5_UPRESS) && (s_kJperkgK <= if97_r5_s(p_MPa, IF97_R5_UTEMP))) return 5;
+	
+	return 0;
+}
+
+
+/* temperature in a Gibbs region (1, 2 or 5) for a given pressure and enthalpy.
+ * Newton's method from *t_K, using cp = [dh/dT]_p, which needs only the 
+ * tau derivatives of the Gibbs free energy.  Refines the backwards equations to 
+ * be consistent with the forward equations.  Returns the iterations taken */
+int gibbs_t_ph_newton(int iRegion, double p_MPa, double h_kJperkg, double *t_K) {
+	typSteamState state;
+	double tGuess = *t_K;
+	double dblDeltaT;
+	int i;
+	
+	for (i = 0; i < GIBBS_NEWTON_MAX; i++){
+		switch (iRegion) {
+		case 1 :
+			if97_r1_props(p_MPa, tGuess, IF97_MASK_H | IF97_MASK_CP, &state);
+			break;
+		case 2 :
+			if97_r2_props(p_MPa, tGuess, IF97_MASK_H | IF97_MASK_CP, &state);
+			break;
+		case 5 :
+			if97_r5_props(p_MPa, tGuess, IF97_MASK_H | IF97_MASK_CP, &state);
+			break;
+		}
+		dblDeltaT = (h_kJperkg - state.h_kJperkg) / state.Cp_kJperkgK;
+		tGuess += dblDeltaT;
+		if (fabs(dblDeltaT) <= 1e-12 * tGuess) break;
+	}
+	*t_K = tGuess;
+	return i + 1;  // GIBBS_NEWTON_MAX + 1 if it did not converge
+}
+
+
+double gibbs_t_ph(int iRegion, double p_MPa, double h_kJperkg, double tGuess) {
+	gibbs_t_ph_newton(iRegion, p_MPa, h_kJperkg, &tGuess);
+	return tGuess;
+}
+
+
+/* the temperature gibbs_t_ph starts from in a Gibbs region (1, 2 or 5): the backwards 
+ * equations in regions 1 and 2, and the lower temperature limit in region 5 */
+double gibbs_t_ph_guess(int iRegion, double p_MPa, double h_kJperkg) {
+	switch (iRegion) {
+	case 1 :
+		return if97_r1_t_ph(p_MPa, h_kJperkg);
+	case 2 :
+		if (p_MPa <= 4.0) return if97_r2a_t_ph(p_MPa, h_kJperkg);
+		else if (h_kJperkg >= IF97_B2bc_h(p_MPa)) return if97_r2b_t_ph(p_MPa, h_kJperkg);
+		else return if97_r2c_t_ph(p_MPa, h_kJperkg);
+	}
+	return IF97_R5_LTEMP;
+}
+
+
+
+/* density and temperature in region 3 for a given pressure and enthalpy, by
+ * Newton's method in two variables on p(rho,T) and h(rho,T) from *rho_kgPerM3 and *t_K, with 
+ * the analytic Jacobian from the Helmholtz free energy derivatives.  Returns the iterations taken */
+int r3_rhot_ph_newton(double p_MPa, double h_kJperkg, double *rho_kgPerM3, double *t_K) {
+	typIF97HelmDerivs d;
+	double delta, tau, dblRho = *rho_kgPerM3, dblT = *t_K, dblP, dblH, dblP_rho, dblP_T, dblH_rho, dblH_T, dblDet, dblDRho, dblDT;
+	int i;
+	
+	for (i = 0; i < R3_NEWTON_MAX; i++){
+		delta = dblRho / IF97_RHOC;
+		tau = IF97_TC / dblT;
+		if97_r3_helm_derivs(delta, tau, IF97_DX | IF97_DXX | IF97_DT | IF97_DTT | IF97_DXT, &d);
+		
+		dblP = dblRho * IF97_R * dblT * delta * d.phiDelta / 1000.0;
+		dblH = IF97_R * dblT * (tau * d.phiTau + delta * d.phiDelta);
+		
+		dblP_rho = IF97_R * dblT * (2.0 * delta * d.phiDelta + sqr(delta) * d.phiDeltaDelta) / 1000.0;
+		dblP_T = dblRho * IF97_R * delta * (d.phiDelta - tau * d.phiDeltaTau) / 1000.0;
+		dblH_rho = IF97_R * dblT * (tau * d.phiDeltaTau + d.phiDelta + delta * d.phiDeltaDelta) / IF97_RHOC;
+		dblH_T = IF97_R * (delta * d.phiDelta - sqr(tau) * d.phiTauTau - delta * tau * d.phiDeltaTau);
+		
+		dblDet = dblP_rho * dblH_T - dblP_T * dblH_rho;
+		dblDRho = ((p_MPa - dblP) * dblH_T - (h_kJperkg - dblH) * dblP_T) / dblDet;
+		dblDT = ((h_kJperkg - dblH) * dblP_rho - (p_MPa - dblP) * dblH_rho) / dblDet;
+		
+		// do not let a step take the density negative
+		if (dblRho + dblDRho <= 0.0) dblDRho = -dblRho / 2.0;
+		
+		dblRho += dblDRho;
+		dblT += dblDT;
+		if ((fabs(dblDRho) <= 1e-12 * dblRho) && (fabs(dblDT) <= 1e-12 * dblT)) break;
+	}
+	*rho_kgPerM3 = dblRho;
+	*t_K = dblT;
+	return i + 1;  // R3_NEWTON_MAX + 1 if it did not converge
+}
+
+
+
+/* density and temperature in region 3 for a given pressure and enthalpy, by r3_rhot_ph_newton.
+ * The initial temperature is interpolated between the region boundaries on the same side 
+ * of the saturation line, and the initial density is from the backwards equations.  
+ * Returns the iterations taken */
+int r3_rhot_ph(double p_MPa, double h_kJperkg, double *rho_kgPerM3, double *t_K) {
+	typSteamState sat;
+	double dblTLow = IF97_R3_LTEMP, dblTHigh = IF97_B23T(p_MPa);
+	double dblHLow = if97_r1_h(p_MPa, IF97_R3_LTEMP), dblHHigh = if97_r2_h(p_MPa, dblTHigh);
+	double ts_K;
+	
+	if (p_MPa < IF97_PC) { // interpolate only on the same side of the saturation line
+		ts_K = if97_r4_ts (p_MPa);
+		sat_props(p_MPa, ts_K, false, IF97_MASK_H, &sat);
+		if (h_kJperkg <= sat.h_kJperkg) {
+			dblTHigh = ts_K - 0.0001;
+			dblHHigh = sat.h_kJperkg;
+		}
+		else{
+			sat_props(p_MPa, ts_K, true, IF97_MASK_H, &sat);
+			dblTLow = ts_K + 0.0001;
+			dblHLow = sat.h_kJperkg;
+		}
+	}
+	
+	*t_K = dblTLow + (dblTHigh - dblTLow) * (h_kJperkg - dblHLow) / (dblHHigh - dblHLow);
+	*rho_kgPerM3 = 1/if97_R3bw_v_pt (p_MPa, *t_K);
+	return r3_rhot_ph_newton(p_MPa, h_kJperkg, rho_kgPerM3, t_K);
+}
+
+
+
+/* temperature in a Gibbs region (1, 2 or 5) for a given pressure and entropy.
+ * Newton's method from *t_K, using [ds/dT]_p = cp / T.  As gibbs_t_ph_newton */
+int gibbs_t_ps_newton(int iRegion, double p_MPa, double s_kJperkgK, double *t_K) {
+	typSteamState state;
+	double tGuess = *t_K;
+	double dblDeltaT;
+	int i;
+	
+	for (i = 0; i < GIBBS_NEWTON_MAX; i++){
+		switch (iRegion) {
+		case 1 :
+			if97_r1_props(p_MPa, tGuess, IF97_MASK_S | IF97_MASK_CP, &state);
+			break;
+		case 2 :
+			if97_r2_props(p_MPa, tGuess, IF97_MASK_S | IF97_MASK_CP, &state);
+			break;
+		case 5 :
+			if97_r5_props(p_MPa, tGuess, IF97_MASK_S | IF97_MASK_CP, &state);
+			break;
+		}
+		dblDeltaT = (s_kJperkgK - state.s_kJperkgK) * tGuess / state.Cp_kJperkgK;
+		tGuess += dblDeltaT;
+		if (fabs(dblDeltaT) <= 1e-12 * tGuess) break;
+	}
+	*t_K = tGuess;
+	return i + 1;  // GIBBS_NEWTON_MAX + 1 if it did not converge
+}
+
+
+double gibbs_t_ps(int iRegion, double p_MPa, double s_kJperkgK, double tGuess) {
+	gibbs_t_ps_newton(iRegion, p_MPa, s_kJperkgK, &tGuess);
+	return tGuess;
+}
+
+
+/* the temperature gibbs_t_ps starts from in a Gibbs region (1, 2 or 5).  As gibbs_t_ph_guess */
+double gibbs_t_ps_guess(int iRegion, double p_MPa, double s_kJperkgK) {
+	switch (iRegion) {
+	case 1 :
+		return if97_r1_t_ps(p_MPa, s_kJperkgK);
+	case 2 :
+		if (p_MPa <= 4.0) return if97_r2a_t_ps(p_MPa, s_kJperkgK);
+		else if (s_kJperkgK >= 5.85) return if97_r2b_t_ps(p_MPa, s_kJperkgK);  // the 2b-2c boundary
+		else return if97_r2c_t_ps(p_MPa, s_kJperkgK);
+	}
+	return IF97_R5_LTEMP;
+}
+
+
+
+/* density and temperature in region 3 for a given pressure and entropy, by
+ * Newton's method in two variables on p(rho,T) and s(rho,T).  As r3_rhot_ph_newton */
+int r3_rhot_ps_newton(double p_MPa, double s_kJperkgK, double *rho_kgPerM3, double *t_K) {
+	typIF97HelmDerivs d;
+	double delta, tau, dblRho = *rho_kgPerM3, dblT = *t_K, dblP, dblS, dblP_rho, dblP_T, dblS_rho, dblS_T, dblDet, dblDRho, dblDT;
+	int i;
+	
+	for (i = 0; i < R3_NEWTON_MAX; i++){
+		delta = dblRho / IF97_RHOC;
+		tau = IF97_TC / dblT;
+		if97_r3_helm_derivs(delta, tau, IF97_D0 | IF97_DX | IF97_DXX | IF97_DT | IF97_DTT | IF97_DXT, &d);
+		
+		dblP = dblRho * IF97_R * dblT * delta * d.phiDelta / 1000.0;
+		dblS = IF97_R * (tau * d.phiTau - d.phi);
+		
+		dblP_rho = IF97_R * dblT * (2.0 * delta * d.phiDelta + sqr(delta) * d.phiDeltaDelta) / 1000.0;
+		dblP_T = dblRho * IF97_R * delta * (d.phiDelta - tau * d.phiDeltaTau) / 1000.0;
+		dblS_rho = IF97_R * (tau * d.phiDeltaTau - d.phiDelta) / IF97_RHOC;
+		dblS_T = - IF97_R * sqr(tau) * d.phiTauTau / dblT;
+		
+		dblDet = dblP_rho * dblS_T - dblP_T * dblS_rho;
+		dblDRho = ((p_MPa - dblP) * dblS_T - (s_kJperkgK - dblS) * dblP_T) / dblDet;
+		dblDT = ((s_kJperkgK - dblS) * dblP_rho - (p_MPa - dblP) * dblS_rho) / dblDet;
+		
+		// do not let a step take the density negative
+		if (dblRho + dblDRho <= 0.0) dblDRho = -dblRho / 2.0;
+		
+		dblRho += dblDRho;
+		dblT += dblDT;
+		if ((fabs(dblDRho) <= 1e-12 * dblRho) && (fabs(dblDT) <= 1e-12 * dblT)) break;
+	}
+	*rho_kgPerM3 = dblRho;
+	*t_K = dblT;
+	return i + 1;  // R3_NEWTON_MAX + 1 if it did not converge
+}
+
+
+
+/* density and temperature in region 3 for a given pressure and entropy, by r3_rhot_ps_newton
+ * started as r3_rhot_ph */
+int r3_rhot_ps(double p_MPa, double s_kJperkgK, double *rho_kgPerM3, double *t_K) {
+	typSteamState sat;
+	double dblTLow = IF97_R3_LTEMP, dblTHigh = IF97_B23T(p_MPa);
+	double dblSLow = if97_r1_s(p_MPa, IF97_R3_LTEMP), dblSHigh = if97_r2_s(p_MPa, dblTHigh);
+	double ts_K;
+	
+	if (p_MPa < IF97_PC) { // interpolate only on the same side of the saturation line
+		ts_K = if97_r4_ts (p_MPa);
+		sat_props(p_MPa, ts_K, false, IF97_MASK_S, &sat);
+		if (s_kJperkgK <= sat.s_kJperkgK) {
+			dblTHigh = ts_K - 0.0001;
+			dblSHigh = sat.s_kJperkgK;
+		}
+		else{
+			sat_props(p_MPa, ts_K, true, IF97_MASK_S, &sat);
+			dblTLow = ts_K + 0.0001;
+			dblSLow = sat.s_kJperkgK;
+		}
+	}
+	
+	*t_K = dblTLow + (dblTHigh - dblTLow) * (s_kJperkgK - dblSLow) / (dblSHigh - dblSLow);
+	*rho_kgPerM3 = 1/if97_R3bw_v_pt (p_MPa, *t_K);
+	return r3_rhot_ps_newton(p_MPa, s_kJperkgK, rho_kgPerM3, t_K);
+}
+
+
+
+/* returns the region for a given density and temperature.
+* 0 = out of bounds.  4 = two phase
+* Below the critical temperature the saturated densities divide liquid, two phase 
+* and steam.  Steam above IF97_B23_LPRESS is in region 3 if it is denser than region 2 
+* on the B23 line.  The pressure is not yet known, so its upper limits are not checked
+*/
+int region_rhot(double rho_kgPerM3, double t_K) {
+	typSteamState liq, vap;
+	double ps_MPa;
+	
+	if (!isfinite(rho_kgPerM3) || (rho_kgPerM3 <= 0.0) || (t_K < IF97_R1_LTEMP) || (t_K > IF97_R5_UTEMP)) return 0;
+	if (t_K > IF97_R2_UTEMP) return 5;
+	
+	if (t_K < IF97_TC) {
+		ps_MPa = if97_r4_ps (t_K);
+		sat_props(ps_MPa, t_K, false, IF97_MASK_V, &liq);
+		sat_props(ps_MPa, t_K, true, IF97_MASK_V, &vap);
+		if (rho_kgPerM3 >= liq.rho_kgperM3) return (t_K <= IF97_R1_UTEMP) ? 1 : 3;
+		else if (rho_kgPerM3 > vap.rho_kgperM3) return 4;
+		else if (ps_MPa < IF97_B23_LPRESS) return 2;
+	}
+	
+	if (t_K > IF97_B23_UTEMP) return 2;
+	else if (rho_kgPerM3 > 1.0 / if97_r2_v(IF97_B23P(t_K), t_K)) return 3;
+	return 2;
+}
+
+
+/* pressure in a Gibbs region (1, 2 or 5) for a given density and temperature.
+ * Newton's method on the density 1/v(p) from *p_MPa, using [dv/dp]_T.  The 
+ * density is close to linear in the pressure in both liquid and steam, so few
+ * steps are needed.  Returns the iterations taken */
+int gibbs_p_rhot_newton(int iRegion, double rho_kgPerM3, double t_K, double *p_MPa) {
+	double pGuess = *p_MPa;
+	double dblV, dblDvdp, dblDeltaP;
+	int i;
+	
+	for (i = 0; i < GIBBS_NEWTON_MAX; i++){
+		switch (iRegion) {
+		case 1 :
+			if97_r1_v_dvdp(pGuess, t_K, &dblV, &dblDvdp);
+			break;
+		case 2 :
+			if97_r2_v_dvdp(pGuess, t_K, &dblV, &dblDvdp);
+			break;
+		default :
+			if97_r5_v_dvdp(pGuess, t_K, &dblV, &dblDvdp);
+			break;
+		}
+		// [drho/dp] = -[dv/dp] / v^2
+		dblDeltaP = (1.0 - rho_kgPerM3 * dblV) * dblV / dblDvdp;
+		if (pGuess + dblDeltaP <= 0.0) dblDeltaP = -0.5 * pGuess;  // the pressure must stay positive
+		pGuess += dblDeltaP;
+		// the liquid's density is so insensitive to pressure that the step may not shrink 
+		// below 1e-12 of it, but the density is then as close as it can be
+		if ((fabs(dblDeltaP) <= 1e-12 * pGuess) || (fabs(rho_kgPerM3 * dblV - 1.0) <= 1e-15)) break;
+	}
+	*p_MPa = pGuess;
+	return i + 1;  // GIBBS_NEWTON_MAX + 1 if it did not converge
+}
+
+
+/* the pressure gibbs_p_rhot_newton starts from in a Gibbs region (1, 2 or 5): the 
+ * saturation pressure in the liquid, and the ideal gas pressure in steam, or the 
+ * region's boundary pressure if that is lower */
+double gibbs_p_rhot_guess(int iRegion, double rho_kgPerM3, double t_K) {
+	double p_MPa = 0.001 * rho_kgPerM3 * IF97_R * t_K;  // kPa to MPa
+	
+	switch (iRegion) {
+	case 1 :
+		return if97_r4_ps (t_K);
+	case 2 :
+		if ((t_K < IF97_TC) && (if97_r4_ps (t_K) < p_MPa)) p_MPa = if97_r4_ps (t_K);
+		if ((t_K >= IF97_B23_LTEMP) && (t_K <= IF97_B23_UTEMP) && (IF97_B23P(t_K) < p_MPa)) p_MPa = IF97_B23P(t_K);
+		break;
+	}
+	return (p_MPa < IF97_R1_UPRESS) ? p_MPa : IF97_R1_UPRESS;
 }
 
 
@@ -80,10 +588,16 @@ int region_pt(double p_MPa, double t_K) {
 // SATURATION LINE
 
 // saturation temperature for a given pressure */
-double if97_Ps_t(double Ps_MPa) {return if97_r4_ts (Ps_MPa ); }
+double if97_Ps_t(double Ps_MPa) {
+	IF97_RECORD_1(IF97_REC_SAT_T, if97_Ps_t, Ps_MPa);
+	return if97_r4_ts (Ps_MPa );
+}
 
 // saturation pressure for a given temperature */
-double if97_Ts_p(double Ts_K) {return if97_r4_ps (Ts_K);}
+double if97_Ts_p(double Ts_K) {
+	IF97_RECORD_1(IF97_REC_SAT_P, if97_Ts_p, Ts_K);
+	return if97_r4_ps (Ts_K);
+}
 
 
 
@@ -92,6 +606,8 @@ double if97_Ts_p(double Ts_K) {return if97_r4_ps (Ts_K);}
 /* specific enthalpy for a given p_MPa and t_K */
 double if97_pt_h(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_H, if97_pt_h, p_MPa, t_K);
 
 switch (region_pt(p_MPa, t_K)) {
 	case 1 :
@@ -103,8 +619,7 @@ switch (region_pt(p_MPa, t_K)) {
 	case 3:
 		if (!(isNearCritical(p_MPa, t_K))) return if97_r3_h( 1/if97_R3bw_v_pt (p_MPa, t_K), t_K); // use backwards equations if not in the Auxiliary zone
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return if97_r3_h (slvResult.dSolution , t_K );
 		break;
 		}
@@ -112,13 +627,15 @@ switch (region_pt(p_MPa, t_K)) {
 		return if97_r5_h(p_MPa, t_K);
 		break;
 	}
-return -9998.0;  //error region not valid
+return IF97_STATS_ERROR(-9998.0);  //error region not valid
 }
 
 
 /* specific enthalpy for a given p_MPa and t_K */
 double if97_pt_u(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_U, if97_pt_u, p_MPa, t_K);
 
 switch (region_pt(p_MPa, t_K)) {
 	case 1 :
@@ -130,22 +647,23 @@ switch (region_pt(p_MPa, t_K)) {
 	case 3:
 		if (!(isNearCritical(p_MPa, t_K))) return if97_r3_u( 1/if97_R3bw_v_pt (p_MPa, t_K), t_K); // use backwards equations if not in the Auxiliary zone
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return if97_r3_u (slvResult.dSolution , t_K );
 		break;
 		}
 	case 5: 
-		return if97_r5_h(p_MPa, t_K);
+		return if97_r5_u(p_MPa, t_K);
 		break;
 	}
-return -9998.0;  //error region not valid
+return IF97_STATS_ERROR(-9998.0);  //error region not valid
 }
 
 
 /* specific entropy for a given p_MPa and t_K */
 double if97_pt_s(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_S, if97_pt_s, p_MPa, t_K);
 	switch (region_pt(p_MPa, t_K)) {
 	case 1 :
 		return if97_r1_s(p_MPa, t_K);
@@ -157,8 +675,7 @@ double if97_pt_s(double p_MPa, double t_K){
 		// use backwards equations to determine rho if not in the Auxiliary zone
 		if (!(isNearCritical(p_MPa, t_K))) return if97_r3_s( 1/(if97_R3bw_v_pt (p_MPa, t_K)), t_K); 
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return if97_r3_s (slvResult.dSolution , t_K );
 		break;
 		}
@@ -166,7 +683,7 @@ double if97_pt_s(double p_MPa, double t_K){
 		return if97_r5_s(p_MPa, t_K);
 		break;
 	}
-return -9998.0; //error region not valid
+return IF97_STATS_ERROR(-9998.0); //error region not valid
 	
 }
 
@@ -174,6 +691,8 @@ return -9998.0; //error region not valid
 /* specific volume for a given p_MPa and t_K */
 double if97_pt_v(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_V, if97_pt_v, p_MPa, t_K);
 	switch (region_pt(p_MPa, t_K)) {	
 	case 1 :
 		return if97_r1_v(p_MPa, t_K);
@@ -183,10 +702,9 @@ double if97_pt_v(double p_MPa, double t_K){
 		break;
 	case 3:
 		// use backwards equations to determine rho if not in the Auxiliary zone
-		if (!(isNearCritical(p_MPa, t_K))) return  1/(if97_R3bw_v_pt (p_MPa, t_K)); 
+		if (!(isNearCritical(p_MPa, t_K))) return if97_R3bw_v_pt (p_MPa, t_K); 
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return 1/slvResult.dSolution;
 		break;
 		}
@@ -194,13 +712,15 @@ double if97_pt_v(double p_MPa, double t_K){
 		return if97_r5_v(p_MPa, t_K);
 		break;
 	}
-return -9998.0;  //error region not valid
+return IF97_STATS_ERROR(-9998.0);  //error region not valid
 }
 
 
 /* specific isochoric heat capacity for a given p_MPa and t_K */
 double if97_pt_Cv(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_CV, if97_pt_Cv, p_MPa, t_K);
 	switch (region_pt(p_MPa, t_K)) {
 	case 1 :
 		return if97_r1_Cv(p_MPa, t_K);
@@ -212,8 +732,7 @@ double if97_pt_Cv(double p_MPa, double t_K){
 		// use backwards equations to determine rho if not in the Auxiliary zone
 		if (!(isNearCritical(p_MPa, t_K))) return if97_r3_Cv( 1/(if97_R3bw_v_pt (p_MPa, t_K)), t_K); 
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return if97_r3_Cv (slvResult.dSolution , t_K );
 		break;
 		}
@@ -221,7 +740,7 @@ double if97_pt_Cv(double p_MPa, double t_K){
 		return if97_r5_Cv(p_MPa, t_K);
 		break;
 	}
-return -9998.0; //error region not valid
+return IF97_STATS_ERROR(-9998.0); //error region not valid
 }
 
 
@@ -230,6 +749,8 @@ return -9998.0; //error region not valid
 /* specific isochoric heat capacity for a given p_MPa and t_K */
 double if97_pt_Cp(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_CP, if97_pt_Cp, p_MPa, t_K);
 	switch (region_pt(p_MPa, t_K)) {
 	case 1 :
 		return if97_r1_Cp(p_MPa, t_K);
@@ -241,8 +762,7 @@ double if97_pt_Cp(double p_MPa, double t_K){
 		// use backwards equations to determine rho if not in the Auxiliary zone
 		if (!(isNearCritical(p_MPa, t_K))) return if97_r3_Cp( 1/(if97_R3bw_v_pt (p_MPa, t_K)), t_K); 
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return if97_r3_Cp (slvResult.dSolution , t_K );
 		break;
 		}
@@ -250,7 +770,7 @@ double if97_pt_Cp(double p_MPa, double t_K){
 		return if97_r5_Cp(p_MPa, t_K);
 		break;
 	}
-return -9998.0; //error region not valid
+return IF97_STATS_ERROR(-9998.0); //error region not valid
 }
 
 
@@ -258,18 +778,22 @@ return -9998.0; //error region not valid
 
 /* thermal conductivity for a given p_MPa and t_K TODO */
 double if97_pt_k(double p_MPa, double t_K){
-return -9999.0; // TODO
+	IF97_RECORD_2(IF97_REC_PT_K, if97_pt_k, p_MPa, t_K);
+return IF97_STATS_ERROR(-9999.0); // TODO
 }
 
 /* dynamic viscosity for a given p_MPa and t_K  TODO */
 double if97_pt_mu(double p_MPa, double t_K){
-return -9999.0; // TODO
+	IF97_RECORD_2(IF97_REC_PT_MU, if97_pt_mu, p_MPa, t_K);
+return IF97_STATS_ERROR(-9999.0); // TODO
 }
 
 
 /** speed of sound for a given p_MPa and t_K */
 double if97_pt_Vs(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_VS, if97_pt_Vs, p_MPa, t_K);
 	switch (region_pt(p_MPa, t_K)) {
 	case 1 :
 		return if97_r1_w(p_MPa, t_K);
@@ -279,10 +803,9 @@ double if97_pt_Vs(double p_MPa, double t_K){
 		break;
 	case 3:
 		// use backwards equations to determine rho if not in the Auxiliary zone
-		if (!(isNearCritical(p_MPa, t_K))) return if97_r3_Cp( 1/(if97_R3bw_v_pt (p_MPa, t_K)), t_K); 
+		if (!(isNearCritical(p_MPa, t_K))) return if97_r3_w( 1/(if97_R3bw_v_pt (p_MPa, t_K)), t_K); 
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return if97_r3_w (slvResult.dSolution , t_K );
 		break;
 		}
@@ -290,7 +813,7 @@ double if97_pt_Vs(double p_MPa, double t_K){
 		return if97_r5_w(p_MPa, t_K);
 		break;
 	}
-return -9998.0; //error region not valid
+return IF97_STATS_ERROR(-9998.0); //error region not valid
 }
 
 
@@ -298,6 +821,8 @@ return -9998.0; //error region not valid
 /** isentropic expansion coefficient for a given p_MPa and t_K */
 double if97_pt_gamma(double p_MPa, double t_K){
 	typSolvResult slvResult;
+	
+	IF97_RECORD_2(IF97_REC_PT_GAMMA, if97_pt_gamma, p_MPa, t_K);
 	switch (region_pt(p_MPa, t_K)) {
 	case 1 :
 		return (if97_r1_Cp(p_MPa, t_K) / if97_r1_Cv(p_MPa, t_K));
@@ -311,8 +836,7 @@ double if97_pt_gamma(double p_MPa, double t_K){
 			return if97_r3_Cp( 1/(if97_R3bw_v_pt (p_MPa, t_K)), t_K)/if97_r3_Cv( 1/(if97_R3bw_v_pt (p_MPa, t_K)), t_K);
 		}
 		else{  // near critical.  Needs iteration
-			slvResult = secant_solv(if97_r3_p, t_K, false,  p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, TEST_ACCURACY, SIG_FIG, 100 );
-			slvResult.dSolution;
+			slvResult.dSolution = r3_rho_pt(p_MPa, t_K);
 			return if97_r3_Cp (slvResult.dSolution , t_K )/if97_r3_Cv (slvResult.dSolution , t_K );
 		break;
 		}
@@ -320,22 +844,555 @@ double if97_pt_gamma(double p_MPa, double t_K){
 		return (if97_r5_Cp(p_MPa, t_K) / if97_r5_Cv(p_MPa, t_K));
 		break;
 	}
-return -9998.0; //error region not valid;
+return IF97_STATS_ERROR(-9998.0); //error region not valid;
+}
+
+
+/** steam state for a given p_MPa and t_K with only the properties selected
+ * by iMask (IF97_MASK_*) calculated.  The others are left at -9999 */
+typSteamState if97_pt_state_mask(double p_MPa, double t_K, int iMask){
+	typSteamState returnState;
+	double dblRho;
+	
+	if97_clear_state(&returnState);
+	
+	returnState.iRegion = region_pt(p_MPa, t_K);
+	if (returnState.iRegion == 0) return returnState; //error region not valid
+	
+	returnState.p_MPa  = p_MPa;
+	returnState.t_K  = t_K;
+	
+	switch (returnState.iRegion) {
+	case 1 :
+		returnState.phase = LIQUID;
+		if97_r1_props(p_MPa, t_K, iMask, &returnState);
+		break;
+	case 2 :
+		returnState.phase = VAPOUR;
+		if97_r2_props(p_MPa, t_K, iMask, &returnState);
+		break;
+	case 3:
+		dblRho = r3_rho_pt(p_MPa, t_K);
+		returnState.phase = (dblRho > IF97_RHOC) ? LIQUID : VAPOUR;
+		if97_r3_props(dblRho, t_K, iMask, &returnState);
+		break;
+	case 5: 
+		returnState.phase = VAPOUR;
+		if97_r5_props(p_MPa, t_K, iMask, &returnState);
+		break;
+	}
+	return returnState;
 }
 
 
 /** full steam state for a given p_MPa and t_K */
 typSteamState if97_pt_state(double p_MPa, double t_K){
-	typSteamState returnState;
+	return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_ALL);
+}
+
+
+
+// Known Pressure and Enthalpy
+
+
+/** steam state for a given p_MPa and h_kJperkg with only the properties selected
+ * by iMask (IF97_MASK_*) calculated.  t_K, p_MPa and h are always set.
+ * In the two phase region, Cp, Cv and w are not applicable */
+typSteamState if97_ph_state_mask(double p_MPa, double h_kJperkg, int iMask){
+	typSteamState returnState, liq, vap;
+	double dblRho, dblX;
 	
-	returnState.p_MPa  = -9999.0;
-	returnState.t_K  = -9999.0;
+	if97_clear_state(&returnState);
 	
-	// TODO
+	returnState.iRegion = region_ph(p_MPa, h_kJperkg);
+	if (returnState.iRegion == 0) return returnState; //error region not valid
 	
+	returnState.p_MPa  = p_MPa;
 	
+	switch (returnState.iRegion) {
+	case 1 :
+		returnState.phase = LIQUID;
+		returnState.t_K = gibbs_t_ph(1, p_MPa, h_kJperkg, gibbs_t_ph_guess(1, p_MPa, h_kJperkg));
+		if97_r1_props(p_MPa, returnState.t_K, iMask, &returnState);
+		break;
+	case 2 :
+		returnState.phase = VAPOUR;
+		returnState.t_K = gibbs_t_ph(2, p_MPa, h_kJperkg, gibbs_t_ph_guess(2, p_MPa, h_kJperkg));
+		if97_r2_props(p_MPa, returnState.t_K, iMask, &returnState);
+		break;
+	case 3:
+		r3_rhot_ph(p_MPa, h_kJperkg, &dblRho, &returnState.t_K);
+		returnState.phase = (dblRho > IF97_RHOC) ? LIQUID : VAPOUR;
+		if97_r3_props(dblRho, returnState.t_K, iMask | IF97_MASK_V, &returnState);
+		break;
+	case 4:
+		returnState.phase = WET;
+		returnState.t_K = if97_r4_ts (p_MPa);
+		sat_props(p_MPa, returnState.t_K, false, (iMask | IF97_MASK_H) & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &liq);
+		sat_props(p_MPa, returnState.t_K, true, (iMask | IF97_MASK_H) & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &vap);
+		
+		dblX = (h_kJperkg - liq.h_kJperkg) / (vap.h_kJperkg - liq.h_kJperkg);
+		returnState.qual_pct = 100.0 * dblX;
+		
+		// specific volume, not density, is a mass weighted average
+		if (iMask & IF97_MASK_V)
+			returnState.rho_kgperM3 = 1.0 / (1.0 / liq.rho_kgperM3 + dblX * (1.0 / vap.rho_kgperM3 - 1.0 / liq.rho_kgperM3));
+		if (iMask & IF97_MASK_U)
+			returnState.u_kJperkg = liq.u_kJperkg + dblX * (vap.u_kJperkg - liq.u_kJperkg);
+		if (iMask & IF97_MASK_S)
+			returnState.s_kJperkgK = liq.s_kJperkgK + dblX * (vap.s_kJperkgK - liq.s_kJperkgK);
+		break;
+	case 5: 
+		returnState.phase = VAPOUR;
+		returnState.t_K = gibbs_t_ph(5, p_MPa, h_kJperkg, gibbs_t_ph_guess(5, p_MPa, h_kJperkg));
+		if97_r5_props(p_MPa, returnState.t_K, iMask, &returnState);
+		break;
+	}
+	returnState.h_kJperkg = h_kJperkg;
+	return returnState;
+}
+
+
+/** full steam state for a given p_MPa and h_kJperkg */
+typSteamState if97_ph_state(double p_MPa, double h_kJperkg){
+	return if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_ALL);
+}
+
+
+/** temperature (K) for a given p_MPa and h_kJperkg */
+double if97_ph_t(double p_MPa, double h_kJperkg){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PH_T, if97_ph_t, p_MPa, h_kJperkg);
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, 0);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.t_K;
+}
+
+
+/** specific entropy (kJ/kg/K) for a given p_MPa and h_kJperkg */
+double if97_ph_s(double p_MPa, double h_kJperkg){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PH_S, if97_ph_s, p_MPa, h_kJperkg);
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_S);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.s_kJperkgK;
+}
+
+
+/** specific volume (m3/kg) for a given p_MPa and h_kJperkg */
+double if97_ph_v(double p_MPa, double h_kJperkg){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PH_V, if97_ph_v, p_MPa, h_kJperkg);
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_V);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return 1.0 / state.rho_kgperM3;
+}
+
+
+/** quality (percent) for a given p_MPa and h_kJperkg. -9999 if not two phase */
+double if97_ph_q(double p_MPa, double h_kJperkg){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PH_Q, if97_ph_q, p_MPa, h_kJperkg);
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, 0);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.qual_pct;
+}
+
+
+/** specific isobaric heat capacity (kJ/kg/K) for a given p_MPa and h_kJperkg. -9999 if two phase */
+double if97_ph_Cp(double p_MPa, double h_kJperkg){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PH_CP, if97_ph_Cp, p_MPa, h_kJperkg);
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_CP);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.Cp_kJperkgK;
+}
+
+
+/** speed of sound (m/s) for a given p_MPa and h_kJperkg. -9999 if two phase */
+double if97_ph_Vs(double p_MPa, double h_kJperkg){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PH_VS, if97_ph_Vs, p_MPa, h_kJperkg);
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_W);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.Vs_MperSec;
+}
+
+
+/** isentropic expansion coefficient for a given p_MPa and h_kJperkg. -9999 if two phase */
+double if97_ph_gamma(double p_MPa, double h_kJperkg){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PH_GAMMA, if97_ph_gamma, p_MPa, h_kJperkg);
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_CP | IF97_MASK_CV);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	if (state.iRegion == 4) return IF97_STATS_ERROR(-9999.0);  // not applicable
+	return state.Cp_kJperkgK / state.Cv_kJperkgK;
+}
+
+
+
+
+// Known Pressure and Entropy
+
+
+/** steam state for a given p_MPa and s_kJperkgK with only the properties selected
+ * by iMask (IF97_MASK_*) calculated.  t_K, p_MPa and s are always set.
+ * In the two phase region, Cp, Cv and w are not applicable */
+typSteamState if97_ps_state_mask(double p_MPa, double s_kJperkgK, int iMask){
+	typSteamState returnState, liq, vap;
+	double dblRho, dblX;
+	
+	if97_clear_state(&returnState);
+	
+	returnState.iRegion = region_ps(p_MPa, s_kJperkgK);
+	if (returnState.iRegion == 0) return returnState; //error region not valid
+	
+	returnState.p_MPa  = p_MPa;
+	
+	switch (returnState.iRegion) {
+	case 1 :
+		returnState.phase = LIQUID;
+		returnState.t_K = gibbs_t_ps(1, p_MPa, s_kJperkgK, gibbs_t_ps_guess(1, p_MPa, s_kJperkgK));
+		if97_r1_props(p_MPa, returnState.t_K, iMask, &returnState);
+		break;
+	case 2 :
+		returnState.phase = VAPOUR;
+		returnState.t_K = gibbs_t_ps(2, p_MPa, s_kJperkgK, gibbs_t_ps_guess(2, p_MPa, s_kJperkgK));
+		if97_r2_props(p_MPa, returnState.t_K, iMask, &returnState);
+		break;
+	case 3:
+		r3_rhot_ps(p_MPa, s_kJperkgK, &dblRho, &returnState.t_K);
+		returnState.phase = (dblRho > IF97_RHOC) ? LIQUID : VAPOUR;
+		if97_r3_props(dblRho, returnState.t_K, iMask | IF97_MASK_V, &returnState);
+		break;
+	case 4:
+		returnState.phase = WET;
+		returnState.t_K = if97_r4_ts (p_MPa);
+		sat_props(p_MPa, returnState.t_K, false, (iMask | IF97_MASK_S) & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &liq);
+		sat_props(p_MPa, returnState.t_K, true, (iMask | IF97_MASK_S) & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &vap);
+		
+		dblX = (s_kJperkgK - liq.s_kJperkgK) / (vap.s_kJperkgK - liq.s_kJperkgK);
+		returnState.qual_pct = 100.0 * dblX;
+		
+		// specific volume, not density, is a mass weighted average
+		if (iMask & IF97_MASK_V)
+			returnState.rho_kgperM3 = 1.0 / (1.0 / liq.rho_kgperM3 + dblX * (1.0 / vap.rho_kgperM3 - 1.0 / liq.rho_kgperM3));
+		if (iMask & IF97_MASK_H)
+			returnState.h_kJperkg = liq.h_kJperkg + dblX * (vap.h_kJperkg - liq.h_kJperkg);
+		if (iMask & IF97_MASK_U)
+			returnState.u_kJperkg = liq.u_kJperkg + dblX * (vap.u_kJperkg - liq.u_kJperkg);
+		break;
+	case 5: 
+		returnState.phase = VAPOUR;
+		returnState.t_K = gibbs_t_ps(5, p_MPa, s_kJperkgK, gibbs_t_ps_guess(5, p_MPa, s_kJperkgK));
+		if97_r5_props(p_MPa, returnState.t_K, iMask, &returnState);
+		break;
+	}
+	returnState.s_kJperkgK = s_kJperkgK;
+	return returnState;
+}
+
+
+/** full steam state for a given p_MPa and s_kJperkgK */
+typSteamState if97_ps_state(double p_MPa, double s_kJperkgK){
+	return if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_ALL);
+}
+
+
+/** temperature (K) for a given p_MPa and s_kJperkgK */
+double if97_ps_t(double p_MPa, double s_kJperkgK){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PS_T, if97_ps_t, p_MPa, s_kJperkgK);
+	state = if97_ps_state_mask(p_MPa, s_kJperkgK, 0);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.t_K;
+}
+
+
+/** specific enthalpy (kJ/kg) for a given p_MPa and s_kJperkgK */
+double if97_ps_h(double p_MPa, double s_kJperkgK){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PS_H, if97_ps_h, p_MPa, s_kJperkgK);
+	state = if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_H);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.h_kJperkg;
+}
+
+
+/** specific volume (m3/kg) for a given p_MPa and s_kJperkgK */
+double if97_ps_v(double p_MPa, double s_kJperkgK){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PS_V, if97_ps_v, p_MPa, s_kJperkgK);
+	state = if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_V);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return 1.0 / state.rho_kgperM3;
+}
+
+
+/** quality (percent) for a given p_MPa and s_kJperkgK. -9999 if not two phase */
+double if97_ps_q(double p_MPa, double s_kJperkgK){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PS_Q, if97_ps_q, p_MPa, s_kJperkgK);
+	state = if97_ps_state_mask(p_MPa, s_kJperkgK, 0);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.qual_pct;
+}
+
+
+/** specific isobaric heat capacity (kJ/kg/K) for a given p_MPa and s_kJperkgK. -9999 if two phase */
+double if97_ps_Cp(double p_MPa, double s_kJperkgK){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PS_CP, if97_ps_Cp, p_MPa, s_kJperkgK);
+	state = if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_CP);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.Cp_kJperkgK;
+}
+
+
+/** speed of sound (m/s) for a given p_MPa and s_kJperkgK. -9999 if two phase */
+double if97_ps_Vs(double p_MPa, double s_kJperkgK){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PS_VS, if97_ps_Vs, p_MPa, s_kJperkgK);
+	state = if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_W);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.Vs_MperSec;
+}
+
+
+/** isentropic expansion coefficient for a given p_MPa and s_kJperkgK. -9999 if two phase */
+double if97_ps_gamma(double p_MPa, double s_kJperkgK){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_PS_GAMMA, if97_ps_gamma, p_MPa, s_kJperkgK);
+	state = if97_ps_state_mask(p_MPa, s_kJperkgK, IF97_MASK_CP | IF97_MASK_CV);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	if (state.iRegion == 4) return IF97_STATS_ERROR(-9999.0);  // not applicable
+	return state.Cp_kJperkgK / state.Cv_kJperkgK;
+}
+
+
+
+
+// Known Density and Temperature
+
+
+/** steam state for a given rho_kgPerM3 and t_K with only the properties selected
+ * by iMask (IF97_MASK_*) calculated.  p_MPa, t_K and the density are always set.
+ * Region 3 is evaluated directly.  In regions 1, 2 and 5 the pressure is found 
+ * by Newton's method.  In the two phase region, Cp, Cv and w are not applicable */
+typSteamState if97_rhot_state_mask(double rho_kgPerM3, double t_K, int iMask){
+	typSteamState returnState, liq, vap;
+	double dblX;
+	
+	if97_clear_state(&returnState);
+	
+	returnState.iRegion = region_rhot(rho_kgPerM3, t_K);
+	if (returnState.iRegion == 0) return returnState; //error region not valid
+	
+	returnState.t_K  = t_K;
+	
+	switch (returnState.iRegion) {
+	case 1 :
+	case 2 :
+	case 5 :
+		returnState.p_MPa = gibbs_p_rhot_guess(returnState.iRegion, rho_kgPerM3, t_K);
+		if ((gibbs_p_rhot_newton(returnState.iRegion, rho_kgPerM3, t_K, &returnState.p_MPa) > GIBBS_NEWTON_MAX) 
+				|| (returnState.p_MPa > ((returnState.iRegion == 5) ? IF97_R5_UPRESS : IF97_R1_UPRESS))) {
+			if97_clear_state(&returnState);
+			return returnState; //error region not valid
+		}
+		returnState.phase = (returnState.iRegion == 1) ? LIQUID : VAPOUR;
+		if (returnState.iRegion == 1) if97_r1_props(returnState.p_MPa, t_K, iMask, &returnState);
+		else if (returnState.iRegion == 2) if97_r2_props(returnState.p_MPa, t_K, iMask, &returnState);
+		else if97_r5_props(returnState.p_MPa, t_K, iMask, &returnState);
+		break;
+	case 3:
+		returnState.p_MPa = if97_r3_p(rho_kgPerM3, t_K);
+		if (returnState.p_MPa > IF97_R3_UPRESS) {
+			if97_clear_state(&returnState);
+			return returnState; //error region not valid
+		}
+		returnState.phase = (rho_kgPerM3 > IF97_RHOC) ? LIQUID : VAPOUR;
+		if97_r3_props(rho_kgPerM3, t_K, iMask, &returnState);
+		break;
+	case 4:
+		returnState.phase = WET;
+		returnState.p_MPa = if97_r4_ps (t_K);
+		sat_props(returnState.p_MPa, t_K, false, iMask & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &liq);
+		sat_props(returnState.p_MPa, t_K, true, iMask & (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S), &vap);
+		
+		// specific volume, not density, is a mass weighted average
+		dblX = (1.0 / rho_kgPerM3 - 1.0 / liq.rho_kgperM3) / (1.0 / vap.rho_kgperM3 - 1.0 / liq.rho_kgperM3);
+		returnState.qual_pct = 100.0 * dblX;
+		
+		if (iMask & IF97_MASK_H)
+			returnState.h_kJperkg = liq.h_kJperkg + dblX * (vap.h_kJperkg - liq.h_kJperkg);
+		if (iMask & IF97_MASK_U)
+			returnState.u_kJperkg = liq.u_kJperkg + dblX * (vap.u_kJperkg - liq.u_kJperkg);
+		if (iMask & IF97_MASK_S)
+			returnState.s_kJperkgK = liq.s_kJperkgK + dblX * (vap.s_kJperkgK - liq.s_kJperkgK);
+		break;
+	}
+	returnState.rho_kgperM3 = rho_kgPerM3;
 	return returnState;
 }
 
 
+/** full steam state for a given rho_kgPerM3 and t_K */
+typSteamState if97_rhot_state(double rho_kgPerM3, double t_K){
+	return if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_ALL);
+}
+
+
+/** pressure (MPa) for a given rho_kgPerM3 and t_K */
+double if97_rhot_p(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_P, if97_rhot_p, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, 0);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.p_MPa;
+}
+
+
+/** specific enthalpy (kJ/kg) for a given rho_kgPerM3 and t_K */
+double if97_rhot_h(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_H, if97_rhot_h, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_H);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.h_kJperkg;
+}
+
+
+/** specific internal energy (kJ/kg) for a given rho_kgPerM3 and t_K */
+double if97_rhot_u(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_U, if97_rhot_u, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_U);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.u_kJperkg;
+}
+
+
+/** specific entropy (kJ/kg/K) for a given rho_kgPerM3 and t_K */
+double if97_rhot_s(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_S, if97_rhot_s, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_S);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.s_kJperkgK;
+}
+
 
+/** quality (percent) for a given rho_kgPerM3 and t_K. -9999 if not two phase */
+double if97_rhot_q(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_Q, if97_rhot_q, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, 0);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.qual_pct;
+}
+
+
+/** specific isochoric heat capacity (kJ/kg/K) for a given rho_kgPerM3 and t_K. -9999 if two phase */
+double if97_rhot_Cv(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_CV, if97_rhot_Cv, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_CV);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.Cv_kJperkgK;
+}
+
+
+/** specific isobaric heat capacity (kJ/kg/K) for a given rho_kgPerM3 and t_K. -9999 if two phase */
+double if97_rhot_Cp(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_CP, if97_rhot_Cp, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_CP);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.Cp_kJperkgK;
+}
+
+
+/** speed of sound (m/s) for a given rho_kgPerM3 and t_K. -9999 if two phase */
+double if97_rhot_Vs(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_VS, if97_rhot_Vs, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_W);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.Vs_MperSec;
+}
+
+
+/** isentropic expansion coefficient for a given rho_kgPerM3 and t_K. -9999 if two phase */
+double if97_rhot_gamma(double rho_kgPerM3, double t_K){
+	typSteamState state;
+	
+	IF97_RECORD_2(IF97_REC_RHOT_GAMMA, if97_rhot_gamma, rho_kgPerM3, t_K);
+	state = if97_rhot_state_mask(rho_kgPerM3, t_K, IF97_MASK_CP | IF97_MASK_CV);
+	
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	if (state.iRegion == 4) return IF97_STATS_ERROR(-9999.0);  // not applicable
+	return state.Cp_kJperkgK / state.Cv_kJperkgK;
+}
+
+
+
+
+// Known Specific Volume and Temperature
+
+
+/** steam state for a given v_m3perkg and t_K with only the properties selected
+ * by iMask (IF97_MASK_*) calculated.  As if97_rhot_state_mask */
+typSteamState if97_vt_state_mask(double v_m3perkg, double t_K, int iMask){
+	return if97_rhot_state_mask(1.0 / v_m3perkg, t_K, iMask);
+}
+
+
+/** full steam state for a given v_m3perkg and t_K */
+typSteamState if97_vt_state(double v_m3perkg, double t_K){
+	return if97_rhot_state_mask(1.0 / v_m3perkg, t_K, IF97_MASK_ALL);
+}
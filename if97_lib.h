@@ -53,6 +53,77 @@
 #include <math.h> // for pow, log
 
 
+// USED INTERNALLY BY THE LIBRARY MODULES
+
+#define GIBBS_NEWTON_MAX 20  // iterations allowed to gibbs_t_ph_newton and gibbs_t_ps_newton
+#define R3_NEWTON_MAX 50  // iterations allowed to r3_rhot_ph_newton and r3_rhot_ps_newton
+
+/** region (1, 2, 3 or 5) for a given p_MPa and t_K.  0 = out of bounds.  Never returns 4 */
+int region_pt(double p_MPa, double t_K);
+
+/** density (kg/m3) in region 3 for a given p_MPa and t_K */
+double r3_rho_pt(double p_MPa, double t_K);
+
+/** density (kg/m3) in region 3 for arrays of n pressures and temperatures, each as r3_rho_pt gives */
+void r3_rho_pt_n(const double *p_MPa, const double *t_K, double *rho_kgPerM3, int n);
+
+/** density (kg/m3) of saturated water (bVapour false) or steam (bVapour true) in region 3 */
+double r3_rho_sat(double p_MPa, double ts_K, bool bVapour);
+
+/** properties selected by iMask of saturated water or steam at p_MPa and its saturation 
+ * temperature ts_K.  The density is always set */
+void sat_props(double p_MPa, double ts_K, bool bVapour, int iMask, typSteamState *state);
+
+/** region (1 to 5) for a given p_MPa and h_kJperkg.  0 = out of bounds.  4 = two phase */
+int region_ph(double p_MPa, double h_kJperkg);
+
+/** region (1 to 5) for a given p_MPa and s_kJperkgK.  0 = out of bounds.  4 = two phase */
+int region_ps(double p_MPa, double s_kJperkgK);
+
+/** temperature (K) from which to find the temperature in Gibbs region iRegion (1, 2 or 5) 
+ * for a given p_MPa and h_kJperkg: the backwards equations where there are any */
+double gibbs_t_ph_guess(int iRegion, double p_MPa, double h_kJperkg);
+
+/** temperature (K) from which to find the temperature in Gibbs region iRegion (1, 2 or 5) 
+ * for a given p_MPa and s_kJperkgK: the backwards equations where there are any */
+double gibbs_t_ps_guess(int iRegion, double p_MPa, double s_kJperkgK);
+
+/** refines *t_K, the temperature in Gibbs region iRegion (1, 2 or 5) for a given p_MPa and 
+ * h_kJperkg, by Newton's method.  Returns the iterations taken, more than GIBBS_NEWTON_MAX if it did not converge */
+int gibbs_t_ph_newton(int iRegion, double p_MPa, double h_kJperkg, double *t_K);
+
+/** refines *t_K, the temperature in Gibbs region iRegion (1, 2 or 5) for a given p_MPa and 
+ * s_kJperkgK, by Newton's method.  Returns the iterations taken, more than GIBBS_NEWTON_MAX if it did not converge */
+int gibbs_t_ps_newton(int iRegion, double p_MPa, double s_kJperkgK, double *t_K);
+
+/** refines *rho_kgPerM3 and *t_K in region 3 for a given p_MPa and h_kJperkg, 
+ * by Newton's method in two variables.  Returns the iterations taken, more than R3_NEWTON_MAX if it did not converge */
+int r3_rhot_ph_newton(double p_MPa, double h_kJperkg, double *rho_kgPerM3, double *t_K);
+
+/** refines *rho_kgPerM3 and *t_K in region 3 for a given p_MPa and s_kJperkgK, 
+ * by Newton's method in two variables.  Returns the iterations taken, more than R3_NEWTON_MAX if it did not converge */
+int r3_rhot_ps_newton(double p_MPa, double s_kJperkgK, double *rho_kgPerM3, double *t_K);
+
+/** density (kg/m3) and temperature (K) in region 3 for a given p_MPa and h_kJperkg.
+ * Returns the iterations taken */
+int r3_rhot_ph(double p_MPa, double h_kJperkg, double *rho_kgPerM3, double *t_K);
+
+/** density (kg/m3) and temperature (K) in region 3 for a given p_MPa and s_kJperkgK.
+ * Returns the iterations taken */
+int r3_rhot_ps(double p_MPa, double s_kJperkgK, double *rho_kgPerM3, double *t_K);
+
+/** region for a given density and temperature.  0 = out of bounds, 4 = two phase.
+ * The upper pressure limits are not checked */
+int region_rhot(double rho_kgPerM3, double t_K);
+
+/** pressure in a Gibbs region (1, 2 or 5) for a given density and temperature, by Newton's method 
+ * from *p_MPa.  Returns the iterations taken: GIBBS_NEWTON_MAX + 1 if it did not converge */
+int gibbs_p_rhot_newton(int iRegion, double rho_kgPerM3, double t_K, double *p_MPa);
+
+/** the pressure gibbs_p_rhot_newton starts from in a Gibbs region (1, 2 or 5) */
+double gibbs_p_rhot_guess(int iRegion, double rho_kgPerM3, double t_K);
+
+
 // SATURATION LINE
 
 
@@ -98,57 +169,122 @@ double if97_pt_gamma(double p_MPa, double t_K);
 /** full steam state for a given p_MPa and t_K */
 typSteamState if97_pt_state(double p_MPa, double t_K);
 
+/** steam state for a given p_MPa and t_K with only the properties selected by iMask 
+ * calculated (bitwise OR of IF97_MASK_V, _H, _U, _S, _CP, _CV, _W).  Only the free energy
+ * derivatives the selection needs are evaluated.  Unselected properties are -9999 */
+typSteamState if97_pt_state_mask(double p_MPa, double t_K, int iMask);
 
-// PH  TODO
+
+// PH
 
 /** t_K for a given p_MPa and h_KJperKg */
 double if97_ph_t(double p_MPa, double h_KJperKg);
 
-/** specific h_KJperKgK for a given p_MPa and h_KJperKg */
+/** specific entropy (kJ/kg/K) for a given p_MPa and h_KJperKg */
 double if97_ph_s(double p_MPa, double h_KJperKg);
 
-/** specific volume for a given p_MPa and h_KJperKg */
+/** specific volume (m3/kg) for a given p_MPa and h_KJperKg */
 double if97_ph_v(double p_MPa, double h_KJperKg);
 
-/** qual_pct for a given p_MPa and h_KJperKg */
+/** qual_pct for a given p_MPa and h_KJperKg.  -9999 if not two phase */
 double if97_ph_q(double p_MPa, double h_KJperKg);
 
-/** specific heat capacity #TODO - Which one# for a given p_MPa and h_KJperKg */
+/** specific isobaric heat capacity for a given p_MPa and h_KJperKg.  -9999 if two phase */
 double if97_ph_Cp(double p_MPa, double h_KJperKg);
 
-/** speed of sound for a given p_MPa and h_KJperKg */
+/** speed of sound for a given p_MPa and h_KJperKg.  -9999 if two phase */
 double if97_ph_Vs(double p_MPa, double h_KJperKg);
 
-/** isentropic expansion coefficient for a given p_MPa and h_KJperKg */
+/** isentropic expansion coefficient for a given p_MPa and h_KJperKg.  -9999 if two phase */
 double if97_ph_gamma(double p_MPa, double h_KJperKg);
 
+/** full steam state for a given p_MPa and h_KJperKg */
+typSteamState if97_ph_state(double p_MPa, double h_KJperKg);
+
+/** steam state for a given p_MPa and h_KJperKg with only the properties selected by iMask 
+ * (IF97_MASK_*) calculated.  t_K and the quality are always set */
+typSteamState if97_ph_state_mask(double p_MPa, double h_KJperKg, int iMask);
+
+
+// PS
+
+/** t_K for a given p_MPa and s_kJperkgK */
+double if97_ps_t(double p_MPa, double s_kJperkgK);
+
+/** specific enthalpy (kJ/kg) for a given p_MPa and s_kJperkgK */
+double if97_ps_h(double p_MPa, double s_kJperkgK);
+
+/** specific volume (m3/kg) for a given p_MPa and s_kJperkgK */
+double if97_ps_v(double p_MPa, double s_kJperkgK);
+
+/** qual_pct for a given p_MPa and s_kJperkgK.  -9999 if not two phase */
+double if97_ps_q(double p_MPa, double s_kJperkgK);
+
+/** specific isobaric heat capacity for a given p_MPa and s_kJperkgK.  -9999 if two phase */
+double if97_ps_Cp(double p_MPa, double s_kJperkgK);
+
+/** speed of sound for a given p_MPa and s_kJperkgK.  -9999 if two phase */
+double if97_ps_Vs(double p_MPa, double s_kJperkgK);
+
+/** isentropic expansion coefficient for a given p_MPa and s_kJperkgK.  -9999 if two phase */
+double if97_ps_gamma(double p_MPa, double s_kJperkgK);
+
+/** full steam state for a given p_MPa and s_kJperkgK */
+typSteamState if97_ps_state(double p_MPa, double s_kJperkgK);
+
+/** steam state for a given p_MPa and s_kJperkgK with only the properties selected by iMask 
+ * (IF97_MASK_*) calculated.  t_K and the quality are always set */
+typSteamState if97_ps_state_mask(double p_MPa, double s_kJperkgK, int iMask);
+
+
+
+// RHOT  density and temperature, which fix the state without iteration in region 3
+
+/** pressure (MPa) for a given rho_kgPerM3 and t_K */
+double if97_rhot_p(double rho_kgPerM3, double t_K);
+
+/** specific enthalpy (kJ/kg) for a given rho_kgPerM3 and t_K */
+double if97_rhot_h(double rho_kgPerM3, double t_K);
+
+/** specific internal energy (kJ/kg) for a given rho_kgPerM3 and t_K */
+double if97_rhot_u(double rho_kgPerM3, double t_K);
+
+/** specific entropy (kJ/kg/K) for a given rho_kgPerM3 and t_K */
+double if97_rhot_s(double rho_kgPerM3, double t_K);
+
+/** qual_pct for a given rho_kgPerM3 and t_K.  -9999 if not two phase */
+double if97_rhot_q(double rho_kgPerM3, double t_K);
 
-// PS  TODO
+/** specific isochoric heat capacity (kJ/kg/K) for a given rho_kgPerM3 and t_K.  -9999 if two phase */
+double if97_rhot_Cv(double rho_kgPerM3, double t_K);
 
-/** t_K for a given p_MPa and h_KJperKgK */
-double if97_ps_t(double p_MPa, double h_KJperKgK);
+/** specific isobaric heat capacity (kJ/kg/K) for a given rho_kgPerM3 and t_K.  -9999 if two phase */
+double if97_rhot_Cp(double rho_kgPerM3, double t_K);
 
-/** specific h_KJperKg for a given p_MPa and h_KJperKgK */
-double if97_ps_h(double p_MPa, double h_KJperKgK);
+/** speed of sound (m/s) for a given rho_kgPerM3 and t_K.  -9999 if two phase */
+double if97_rhot_Vs(double rho_kgPerM3, double t_K);
 
-/** specific volume for a given p_MPa and h_KJperKgK */
-double if97_ps_v(double p_MPa, double h_KJperKgK);
+/** isentropic expansion coefficient for a given rho_kgPerM3 and t_K.  -9999 if two phase */
+double if97_rhot_gamma(double rho_kgPerM3, double t_K);
 
-/** qual_pct for a given p_MPa and h_KJperKgK */
-double if97_ps_q(double p_MPa, double h_KJperKgK);
+/** full steam state for a given rho_kgPerM3 and t_K */
+typSteamState if97_rhot_state(double rho_kgPerM3, double t_K);
 
-/** specific heat capacity #TODO - Which one# for a given p_MPa and h_KJperKgK */
-double if97_ps_Cp(double p_MPa, double h_KJperKgK);
+/** steam state for a given rho_kgPerM3 and t_K with only the properties selected by iMask 
+ * (IF97_MASK_*) calculated.  p_MPa, the density and the quality are always set.  Region 3 
+ * is evaluated directly.  In regions 1, 2 and 5 the pressure is found by Newton's method, 
+ * and below the critical temperature a density between the saturated densities is two phase */
+typSteamState if97_rhot_state_mask(double rho_kgPerM3, double t_K, int iMask);
 
-/** speed of sound for a given p_MPa and h_KJperKgK */
-double if97_ps_Vs(double p_MPa, double h_KJperKgK);
 
-/** isentropic expansion coefficient for a given p_MPa and h_KJperKgK */
-double if97_ps_gamma(double p_MPa, double h_KJperKgK);
+// VT
 
+/** full steam state for a given v_m3perkg and t_K */
+typSteamState if97_vt_state(double v_m3perkg, double t_K);
 
-/** full steam state for a givenp_MPa and h_KJperKgK */
-typSteamState if97_ps_state(double p_MPa, double h_KJperKgK);
+/** steam state for a given v_m3perkg and t_K with only the properties selected by iMask 
+ * (IF97_MASK_*) calculated.  As if97_rhot_state_mask */
+typSteamState if97_vt_state_mask(double v_m3perkg, double t_K, int iMask);
 
 
 
@@ -11,6 +11,16 @@
 
 #include "if97_lib_test.h"
 #include "if97_lib.h"
+#include "IF97_Region1bw.h"  // for the backwards equation guesses
+#include "IF97_Region3bw.h"  // for isNearCritical
+#include "IF97_B23.h"
+#include "if97_warm.h"
+#include "if97_flash.h"
+#include "if97_sbtl.h"
+#include "if97_ttse.h"
+#include "if97_table.h"
+#include "if97_compact.h"
+#include "if97_quad.h"
 #include "IF97_common.h"
 #include "iapws_surftens.h"
 #include "solve_test.h"
@@ -19,6 +29,9 @@
 #include "IF97_Region3_test.h"
 #include "IF97_Region4_test.h"
 #include "IF97_B23_test.h"
+#include "if97_deriv_test.h"
+#include "units_test.h"
+#include "winsteam_compatibility_test.h"
 #include <stdio.h>
 #include <math.h>  // for fabs
 #include "winsteam_compatibility.h"
@@ -79,6 +92,21 @@ pTestLog = fopen(TESTLOGLOC, "w"); // open an empty file to write test results t
 	resultSummary ("iapws_surftens", pTestLog, intermediateResult);	
 		
 	
+	// *** test analytic partial derivatives ***
+	intermediateResult = 	if97_deriv_test (pTestLog);
+	resultSummary ("if97_deriv module", pTestLog, intermediateResult);	
+		
+	
+	// *** test unit conversions ***
+	intermediateResult = 	units_test (pTestLog);
+	resultSummary ("units module", pTestLog, intermediateResult);	
+	
+	
+	// *** test winsteam compatibility functions ***
+	intermediateResult = 	winsteam_compatibility_test (pTestLog);
+	resultSummary ("winsteam compatibility module", pTestLog, intermediateResult);	
+	
+	
 	// *** test library module ***
 	intermediateResult = 	if97_lib_test (pTestLog);
 	resultSummary ("IF97_lib library", pTestLog, intermediateResult);	
@@ -238,8 +266,113 @@ int testCharDoubleInput ( char (*func) (double, double), double input1, double i
 			fprintf ( logFile, "%s ( %.8g, %.8g ) = %c \t Expected: %c \t  \t FAIL\n", funcName, input1, input2, (*func)(input1, input2), expectedOutput);
 	}
 	
+	return testResult;
+}
+
+
+// test a count (eg from if97_stats_snapshot). Pass = 0. See IF97_Common.h for failure codes.
+//Function outputs more detail to logfile if VERBOSE_TEST is set to true
+int testCount ( long actual, long expectedOutput, char* countName, FILE *logFile){
+	int testResult = TEST_FAIL; // initialize as a fail.
+	if (actual == expectedOutput){
+		testResult = TEST_PASS;
+		if (VERBOSE_TEST)
+			fprintf ( logFile, "%s = %li \t Expected: %li \t  \t PASS\n", countName, actual, expectedOutput);
+	}
+	else{
+		testResult = testResult | TEST_INCORRECT;
+		if (VERBOSE_TEST)
+			fprintf ( logFile, "%s = %li \t Expected: %li \t  \t FAIL\n", countName, actual, expectedOutput);
+	}
+	
 	return testResult;
 }	
+
+
+// error values are compared exactly.  The parallel reductions of the region equations sum in
+// another order with another number of threads, or nested in a parallel loop
+bool testClose ( double actual, double expected, double dblTol){
+	return (actual == expected) || (fabs(actual - expected) <= dblTol * fabs(expected));
+}
+
+
+// a single phase typTestTableState, and wet steam
+typTestTableState testTablePT ( double p_MPa, double t_K, bool bIF97){
+	typTestTableState pt = {p_MPa, t_K, TEST_ONE_PHASE, bIF97};
+	return pt;
+}
+
+
+typTestTableState testTableWet ( double t_K, double dblQ){
+	typTestTableState pt = {0.0, t_K, dblQ, false};
+	return pt;
+}
+
+
+// the IF97 state of a typTestTableState.  The speed of sound of wet steam is -9999, as the engines give it
+typSteamState testTableSteam ( const typTestTableState *pt){
+	typSteamState state, liq, vap;
+	double p_MPa;
+
+	if (pt->dblQ == TEST_ONE_PHASE) return if97_pt_state_mask(pt->p_MPa, pt->t_K, IF97_MASK_ALL);
+	p_MPa = if97_r4_ps(pt->t_K);
+	sat_props(p_MPa, pt->t_K, false, IF97_MASK_ALL, &liq);
+	sat_props(p_MPa, pt->t_K, true, IF97_MASK_ALL, &vap);
+	state = liq;
+	state.p_MPa = p_MPa;
+	state.t_K = pt->t_K;
+	state.h_kJperkg = (1.0 - pt->dblQ) * liq.h_kJperkg + pt->dblQ * vap.h_kJperkg;
+	state.u_kJperkg = (1.0 - pt->dblQ) * liq.u_kJperkg + pt->dblQ * vap.u_kJperkg;
+	state.s_kJperkgK = (1.0 - pt->dblQ) * liq.s_kJperkgK + pt->dblQ * vap.s_kJperkgK;
+	state.rho_kgperM3 = 1.0 / ((1.0 - pt->dblQ) / liq.rho_kgperM3 + pt->dblQ / vap.rho_kgperM3);
+	state.Vs_MperSec = -9999.0;
+	return state;
+}
+
+
+double testTableProp ( const typSteamState *state, int iProp){
+	switch (iProp) {
+	case TEST_P : return state->p_MPa;
+	case TEST_T : return state->t_K;
+	case TEST_V : return 1.0 / state->rho_kgperM3;
+	case TEST_H : return state->h_kJperkg;
+	case TEST_U : return state->u_kJperkg;
+	case TEST_S : return state->s_kJperkgK;
+	default : return state->Vs_MperSec;
+	}
+}
+
+
+int testTable ( const typTestTableFunc *funcs, int nFuncs, const typTestTableState *states, int nStates, FILE *logFile){
+	int testResult = TEST_PASS;
+	typSteamState state;
+	double in1, in2;
+	int i, k;
+
+	for (i = 0; i < nStates; i++) {
+		state = testTableSteam(&states[i]);
+		for (k = 0; k < nFuncs; k++) {
+			in1 = state.p_MPa;
+			switch (funcs[k].iPair) {
+			case TEST_PAIR_PT :
+				if (states[i].dblQ != TEST_ONE_PHASE) continue;
+				in2 = state.t_K;
+				break;
+			case TEST_PAIR_PH :
+				in2 = state.h_kJperkg;
+				break;
+			default :
+				in1 = 1.0 / state.rho_kgperM3;
+				in2 = state.u_kJperkg;
+			}
+			if (states[i].bIF97)
+				testResult = testResult | testDoubleInput(funcs[k].func, in1, in2, testTableProp(&state, funcs[k].iProp), -log10(TEST_SOLV_TOL), SIG_FIG, funcs[k].funcName, logFile);
+			else
+				testResult = testResult | testDoubleInput(funcs[k].func, in1, in2, testTableProp(&state, funcs[k].iProp), funcs[k].tol, funcs[k].tolType, funcs[k].funcName, logFile);
+		}
+	}
+	return testResult;
+}
 	
 
 // prints a unit test summary to the log based on the test code
@@ -283,8 +416,118 @@ int if97_surftens_test (FILE *logFile){
 }
 
 
+// single property wrappers around the property-mask state functions, so they can be checked with testDoubleInput
+double mask_pt_v (double p_MPa, double t_K) {return 1/if97_pt_state_mask(p_MPa, t_K, IF97_MASK_V).rho_kgperM3;}
+double mask_pt_h (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_H).h_kJperkg;}
+double mask_pt_u (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_U).u_kJperkg;}
+double mask_pt_s (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_S).s_kJperkgK;}
+double mask_pt_Cp (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_CP).Cp_kJperkgK;}
+double mask_pt_Cv (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_CV).Cv_kJperkgK;}
+double mask_pt_w (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_W).Vs_MperSec;}
+double mask_pt_unselected (double p_MPa, double t_K) {return if97_pt_state_mask(p_MPa, t_K, IF97_MASK_H | IF97_MASK_V).Cp_kJperkgK;}
+
+double mask_r3_h (double rho, double t_K) {typSteamState state; if97_r3_props(rho, t_K, IF97_MASK_H, &state); return state.h_kJperkg;}
+double mask_r3_u (double rho, double t_K) {typSteamState state; if97_r3_props(rho, t_K, IF97_MASK_U, &state); return state.u_kJperkg;}
+double mask_r3_s (double rho, double t_K) {typSteamState state; if97_r3_props(rho, t_K, IF97_MASK_S, &state); return state.s_kJperkgK;}
+double mask_r3_Cp (double rho, double t_K) {typSteamState state; if97_r3_props(rho, t_K, IF97_MASK_CP, &state); return state.Cp_kJperkgK;}
+double mask_r3_Cv (double rho, double t_K) {typSteamState state; if97_r3_props(rho, t_K, IF97_MASK_CV, &state); return state.Cv_kJperkgK;}
+double mask_r3_w (double rho, double t_K) {typSteamState state; if97_r3_props(rho, t_K, IF97_MASK_W, &state); return state.Vs_MperSec;}
+
+
+
+// the table engines as functions of two doubles, for testTable, with the tables in these
+typIF97Sbtl testSbtl;
+double test_sbtl_ph_t (double p_MPa, double h_kJperkg) {return if97_sbtl_ph_t(&testSbtl, p_MPa, h_kJperkg);}
+double test_sbtl_ph_v (double p_MPa, double h_kJperkg) {return if97_sbtl_ph_v(&testSbtl, p_MPa, h_kJperkg);}
+double test_sbtl_ph_s (double p_MPa, double h_kJperkg) {return if97_sbtl_ph_s(&testSbtl, p_MPa, h_kJperkg);}
+double test_sbtl_ph_w (double p_MPa, double h_kJperkg) {return if97_sbtl_ph_w(&testSbtl, p_MPa, h_kJperkg);}
+double test_sbtl_vu_t (double v_m3perkg, double u_kJperkg) {return if97_sbtl_vu_t(&testSbtl, v_m3perkg, u_kJperkg);}
+double test_sbtl_vu_p (double v_m3perkg, double u_kJperkg) {return if97_sbtl_vu_p(&testSbtl, v_m3perkg, u_kJperkg);}
+double test_sbtl_vu_s (double v_m3perkg, double u_kJperkg) {return if97_sbtl_vu_s(&testSbtl, v_m3perkg, u_kJperkg);}
+double test_sbtl_vu_w (double v_m3perkg, double u_kJperkg) {return if97_sbtl_vu_w(&testSbtl, v_m3perkg, u_kJperkg);}
+
+// coarse tables, 40 x 20 cells, to keep the test quick.  They agree with IF97 to about 0.05 K, 1e-4 in v and p
+const typTestTableFunc testSbtlFuncs[] = {
+	{test_sbtl_ph_t, TEST_PAIR_PH, TEST_T, 0.1, ABS, "if97_sbtl_ph_t"},
+	{test_sbtl_ph_v, TEST_PAIR_PH, TEST_V, 3, SIG_FIG, "if97_sbtl_ph_v"},
+	{test_sbtl_ph_s, TEST_PAIR_PH, TEST_S, 1e-4, ABS, "if97_sbtl_ph_s"},
+	{test_sbtl_ph_w, TEST_PAIR_PH, TEST_W, 0.1, ABS, "if97_sbtl_ph_w"},
+	{test_sbtl_vu_t, TEST_PAIR_VU, TEST_T, 0.1, ABS, "if97_sbtl_vu_t"},
+	{test_sbtl_vu_p, TEST_PAIR_VU, TEST_P, 3, SIG_FIG, "if97_sbtl_vu_p"},
+	{test_sbtl_vu_s, TEST_PAIR_VU, TEST_S, 1e-4, ABS, "if97_sbtl_vu_s"},
+	{test_sbtl_vu_w, TEST_PAIR_VU, TEST_W, 0.1, ABS, "if97_sbtl_vu_w"},
+};
+#define TEST_SBTL_FUNCS (int) (sizeof(testSbtlFuncs) / sizeof(testSbtlFuncs[0]))
+
+typIF97Ttse testTtse;
+double test_ttse_ph_t (double p_MPa, double h_kJperkg) {return if97_ttse_ph_t(&testTtse, p_MPa, h_kJperkg);}
+double test_ttse_ph_v (double p_MPa, double h_kJperkg) {return if97_ttse_ph_v(&testTtse, p_MPa, h_kJperkg);}
+double test_ttse_ph_s (double p_MPa, double h_kJperkg) {return if97_ttse_ph_s(&testTtse, p_MPa, h_kJperkg);}
+double test_ttse_ph_u (double p_MPa, double h_kJperkg) {return if97_ttse_ph_u(&testTtse, p_MPa, h_kJperkg);}
+double test_ttse_pt_h (double p_MPa, double t_K) {return if97_ttse_pt_h(&testTtse, p_MPa, t_K);}
+double test_ttse_pt_v (double p_MPa, double t_K) {return if97_ttse_pt_v(&testTtse, p_MPa, t_K);}
+double test_ttse_pt_s (double p_MPa, double t_K) {return if97_ttse_pt_s(&testTtse, p_MPa, t_K);}
+double test_ttse_pt_u (double p_MPa, double t_K) {return if97_ttse_pt_u(&testTtse, p_MPa, t_K);}
+
+// coarse tables, 80 nodes each way.  They agree with IF97 to about 1e-3 K, 0.1 kJ/kg in h
+// beside the saturation line and about the pseudo critical temperature at 50 MPa, and 1e-4 relative in v
+const typTestTableFunc testTtseFuncs[] = {
+	{test_ttse_ph_t, TEST_PAIR_PH, TEST_T, 0.05, ABS, "if97_ttse_ph_t"},
+	{test_ttse_ph_v, TEST_PAIR_PH, TEST_V, 3, SIG_FIG, "if97_ttse_ph_v"},
+	{test_ttse_ph_s, TEST_PAIR_PH, TEST_S, 1e-3, ABS, "if97_ttse_ph_s"},
+	{test_ttse_ph_u, TEST_PAIR_PH, TEST_U, 0.2, ABS, "if97_ttse_ph_u"},
+	{test_ttse_pt_h, TEST_PAIR_PT, TEST_H, 0.2, ABS, "if97_ttse_pt_h"},
+	{test_ttse_pt_v, TEST_PAIR_PT, TEST_V, 3, SIG_FIG, "if97_ttse_pt_v"},
+	{test_ttse_pt_s, TEST_PAIR_PT, TEST_S, 1e-3, ABS, "if97_ttse_pt_s"},
+	{test_ttse_pt_u, TEST_PAIR_PT, TEST_U, 0.2, ABS, "if97_ttse_pt_u"},
+};
+#define TEST_TTSE_FUNCS (int) (sizeof(testTtseFuncs) / sizeof(testTtseFuncs[0]))
+
+typIF97Compact testCompact;
+double test_compact_pt_h (double p_MPa, double t_K) {return if97_compact_pt_h(&testCompact, p_MPa, t_K);}
+double test_compact_pt_v (double p_MPa, double t_K) {return if97_compact_pt_v(&testCompact, p_MPa, t_K);}
+double test_compact_pt_s (double p_MPa, double t_K) {return if97_compact_pt_s(&testCompact, p_MPa, t_K);}
+double test_compact_pt_u (double p_MPa, double t_K) {return if97_compact_pt_u(&testCompact, p_MPa, t_K);}
+
+// the bounds the test tables are built to, looser than the defaults
+const typTestTableFunc testCompactFuncs[] = {
+	{test_compact_pt_h, TEST_PAIR_PT, TEST_H, 1e-2, ABS, "if97_compact_pt_h"},
+	{test_compact_pt_v, TEST_PAIR_PT, TEST_V, 5, SIG_FIG, "if97_compact_pt_v"},
+	{test_compact_pt_s, TEST_PAIR_PT, TEST_S, 1e-5, ABS, "if97_compact_pt_s"},
+	{test_compact_pt_u, TEST_PAIR_PT, TEST_U, 1e-2, ABS, "if97_compact_pt_u"},
+};
+#define TEST_COMPACT_FUNCS (int) (sizeof(testCompactFuncs) / sizeof(testCompactFuncs[0]))
+
+typIF97Quad testQuad;
+double test_quad_eval (double p_MPa, double y) {return if97_quad_eval(&testQuad, p_MPa, y);}
+
+// one tree for each, to the bounds they are built to
+const typTestTableFunc testQuadFuncs[] = {
+	{test_quad_eval, TEST_PAIR_PT, TEST_H, 1e-2, ABS, "if97_quad_eval h on (p,T)"},
+	{test_quad_eval, TEST_PAIR_PH, TEST_T, 0.05, ABS, "if97_quad_eval T on (p,h)"},
+};
+
+
+
 int if97_lib_test (FILE *logFile){	
 	int intermediateResult;
+	int libResult = TEST_PASS;
+	typIF97Stats stats;
+	typIF97RecordFile recording;
+	double dblP[SOLVNTESTLANES], dblT[SOLVNTESTLANES], dblX[SOLVNTESTLANES], dblOut[SOLVNTESTLANES];
+	typSolvResult slvResults[SOLVNTESTLANES], slvResult;
+	typSolvBounds bounds;
+	typIF97R3Isotherm iso;
+	typIF97Warm warm;
+	typTestTableState tableStates[TEST_TABLE_STATES];
+	typIF97TtseSpec ttseSpec;
+	typIF97Table table;
+	typIF97CompactSpec compactSpec;
+	typIF97QuadSpec quadSpec;
+	FILE *tableFile;
+	typSteamState state, flashState;
+	long lMismatch;
+	int k;
 	
 	
 		// *** Testing  if97_pt_h  ******
@@ -300,14 +543,748 @@ int if97_lib_test (FILE *logFile){
 	intermediateResult = intermediateResult | testDoubleInput (if97_pt_h, 30.0, 1500.0, 5.16723514e03,TEST_ACCURACY, SIG_FIG,"if97_pt_h", logFile);
 	
 	intermediateResult = intermediateResult | testDoubleInput (if97_pt_u, IF97_PC + 0.000001, IF97_TC + 0.000001, 2015.769096450988, TEST_ACCURACY,  SIG_FIG,"if97_pt_u", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_pt_u, 30.0, 1500.0, 4.47495124e03,TEST_ACCURACY, SIG_FIG,"if97_pt_u", logFile);
 	intermediateResult = intermediateResult | testDoubleInput (if97_pt_s, IF97_PC + 0.000001, IF97_TC + 0.000001, 4.406259014859, TEST_ACCURACY,  SIG_FIG,"if97_pt_s", logFile);
 	intermediateResult = intermediateResult | testDoubleInput (if97_pt_Cv, IF97_PC + 0.000001, IF97_TC + 0.000001, 4.527598110108, TEST_ACCURACY,  SIG_FIG,"if97_pt_Cv", logFile);
 	intermediateResult = intermediateResult | testDoubleInput (if97_pt_Cp, IF97_PC + 0.000001, IF97_TC + 0.000001, 4.54022408404e5, TEST_ACCURACY,  SIG_FIG,"if97_pt_Cp", logFile);
 	intermediateResult = intermediateResult | testDoubleInput (if97_pt_Vs, IF97_PC + 0.000001, IF97_TC + 0.000001, 314.252078309417, TEST_ACCURACY,  SIG_FIG,"if97_pt_Vs", logFile);
+	// region 3 away from critical, where the density is from the backwards equations (accurate to about 5 figures)
+	intermediateResult = intermediateResult | testDoubleInput (if97_pt_v, 7.83095639e01, 750.0, 1.0/500.0, 5,  SIG_FIG,"if97_pt_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_pt_Vs, 7.83095639e01, 750.0, 7.60696041e02, 5,  SIG_FIG,"if97_pt_Vs", logFile);
 	
 	
 	
 	resultSummary ("if97_pt_h", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+		// *** Testing  if97_pt_state_mask  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_pt_state_mask  *** \n\n" );	
+	
+	// region 1. Table 5
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_v, 3.0, 300.0, 0.100215168e-2, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask V", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_h, 3.0, 300.0, 0.115331273e3, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask H", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_u, 3.0, 300.0, 0.112324818e3, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask U", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_s, 3.0, 300.0, 0.392294792, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask S", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_Cp, 3.0, 300.0, 0.417301218e1, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask CP", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_Cv, 3.0, 300.0, if97_r1_Cv(3.0, 300.0), TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask CV", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_w, 3.0, 300.0, 0.150773921e4, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask W", logFile);
+	
+	// region 2. Table 15
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_v, 0.0035, 300.0, 0.394913866e2, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask V", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_h, 0.0035, 300.0, 0.254991145e4, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask H", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_u, 0.0035, 300.0, 0.241169160e4, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask U", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_s, 0.0035, 300.0, 0.852238967e1, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask S", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_Cp, 0.0035, 300.0, 0.191300162e1, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask CP", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_Cv, 0.0035, 300.0, if97_r2_Cv(0.0035, 300.0), TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask CV", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_w, 0.0035, 300.0, 0.427920172e3, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask W", logFile);
+	
+	// region 3. Table 33
+	intermediateResult = intermediateResult | testDoubleInput (mask_r3_h, 500.0, 650.0, 0.186343019e4, TEST_ACCURACY, SIG_FIG, "if97_r3_props H", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_r3_u, 500.0, 650.0, 0.181226279e4, TEST_ACCURACY, SIG_FIG, "if97_r3_props U", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_r3_s, 500.0, 650.0, 0.405427273e1, TEST_ACCURACY, SIG_FIG, "if97_r3_props S", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_r3_Cp, 500.0, 650.0, 0.138935717e2, TEST_ACCURACY, SIG_FIG, "if97_r3_props CP", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_r3_Cv, 500.0, 650.0, if97_r3_Cv(500.0, 650.0), TEST_ACCURACY, SIG_FIG, "if97_r3_props CV", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_r3_w, 500.0, 650.0, 0.502005554e3, TEST_ACCURACY, SIG_FIG, "if97_r3_props W", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_h, IF97_PC + 0.000001, IF97_TC + 0.000001, 2083.817978619541, TEST_ACCURACY,  SIG_FIG,"if97_pt_state_mask H", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_w, IF97_PC + 0.000001, IF97_TC + 0.000001, 314.252078309417, TEST_ACCURACY,  SIG_FIG,"if97_pt_state_mask W", logFile);
+	
+	// region 5. Table 42
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_v, 0.5, 1500.0, 0.138455090e1, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask V", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_h, 0.5, 1500.0, 0.521976855e4, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask H", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_u, 0.5, 1500.0, 0.452749310e4, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask U", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_s, 0.5, 1500.0, 0.965408875e1, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask S", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_Cp, 0.5, 1500.0, 0.261609445e1, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask CP", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_Cv, 0.5, 1500.0, if97_r5_Cv(0.5, 1500.0), TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask CV", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_w, 0.5, 1500.0, 0.917068690e3, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask W", logFile);
+	
+	// properties not asked for are not calculated
+	intermediateResult = intermediateResult | testDoubleInput (mask_pt_unselected, 3.0, 300.0, -9999.0, TEST_ACCURACY, SIG_FIG, "if97_pt_state_mask unselected", logFile);
+	
+	resultSummary ("if97_pt_state_mask", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+		// *** Testing  if97_ph_  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_ph_  *** \n\n" );	
+	
+	// the temperature is refined to be consistent with the forward equations, so converting back should give the original temperature
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 3.0, if97_pt_h(3.0, 300.0), 300.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 80.0, if97_pt_h(80.0, 500.0), 500.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 0.0035, if97_pt_h(0.0035, 300.0), 300.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 5.0, if97_pt_h(5.0, 700.0), 700.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 25.0, if97_pt_h(25.0, 700.0), 700.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	// region 3 from the forward equations. if97_pt_h uses the backwards equations for density there.  See Table 33
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 0.255837018e2, 0.186343019e4, 650.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_v, 0.255837018e2, 0.186343019e4, 1/500.0, TEST_ACCURACY, SIG_FIG, "if97_ph_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 0.222930643e2, 0.237512401e4, 650.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_v, 0.222930643e2, 0.237512401e4, 1/200.0, TEST_ACCURACY, SIG_FIG, "if97_ph_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 0.783095639e2, 0.225868845e4, 750.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, if97_r3_p(550.0, 630.0), if97_r3_h(550.0, 630.0), 630.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, if97_r3_p(150.0, 640.0), if97_r3_h(150.0, 640.0), 640.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 0.5, if97_pt_h(0.5, 1500.0), 1500.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_s, 3.0, 0.115331273e3, 0.392294792, TEST_ACCURACY, SIG_FIG, "if97_ph_s", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_v, 0.0035, 0.254991145e4, 0.394913866e2, TEST_ACCURACY, SIG_FIG, "if97_ph_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_Cp, 0.5, 0.521976855e4, 0.261609445e1, TEST_ACCURACY, SIG_FIG, "if97_ph_Cp", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_Vs, 3.0, 0.115331273e3, 0.150773921e4, TEST_ACCURACY, SIG_FIG, "if97_ph_Vs", logFile);
+	
+	// two phase
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_q, 1.0, 0.7 * if97_r1_h(1.0, if97_r4_ts(1.0)) + 0.3 * if97_r2_h(1.0, if97_r4_ts(1.0)), 30.0, TEST_ACCURACY, SIG_FIG, "if97_ph_q", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 1.0, 0.7 * if97_r1_h(1.0, if97_r4_ts(1.0)) + 0.3 * if97_r2_h(1.0, if97_r4_ts(1.0)), if97_r4_ts(1.0), TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_v, 1.0, 0.7 * if97_r1_h(1.0, if97_r4_ts(1.0)) + 0.3 * if97_r2_h(1.0, if97_r4_ts(1.0)), 
+			0.7 * if97_r1_v(1.0, if97_r4_ts(1.0)) + 0.3 * if97_r2_v(1.0, if97_r4_ts(1.0)), TEST_ACCURACY, SIG_FIG, "if97_ph_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_q, 20.0, 2000.0, 
+			100.0 * (2000.0 - if97_r3_h(r3_rho_sat(20.0, if97_r4_ts(20.0), false), if97_r4_ts(20.0))) 
+			/ (if97_r3_h(r3_rho_sat(20.0, if97_r4_ts(20.0), true), if97_r4_ts(20.0)) - if97_r3_h(r3_rho_sat(20.0, if97_r4_ts(20.0), false), if97_r4_ts(20.0))), 
+			TEST_ACCURACY, SIG_FIG, "if97_ph_q", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_Cp, 1.0, 2000.0, -9999.0, TEST_ACCURACY, SIG_FIG, "if97_ph_Cp", logFile);
+	
+	// out of bounds
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 1.0, -100.0, -9998.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, 60.0, 7000.0, -9998.0, TEST_ACCURACY, SIG_FIG, "if97_ph_t", logFile);
+	
+	resultSummary ("if97_ph_", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+		// *** Testing  if97_ps_  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_ps_  *** \n\n" );	
+	
+	// as if97_ph_, converting back should give the original temperature
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 3.0, if97_pt_s(3.0, 300.0), 300.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 80.0, if97_pt_s(80.0, 500.0), 500.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 0.0035, if97_pt_s(0.0035, 300.0), 300.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 5.0, if97_pt_s(5.0, 700.0), 700.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 25.0, if97_pt_s(25.0, 700.0), 700.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 10.0, if97_pt_s(10.0, 600.0), 600.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	// region 3 from the forward equations.  See Table 33
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 0.255837018e2, 0.405427273e1, 650.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_v, 0.255837018e2, 0.405427273e1, 1/500.0, TEST_ACCURACY, SIG_FIG, "if97_ps_v", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_h, 0.222930643e2, 0.485438792e1, 0.237512401e4, TEST_ACCURACY, SIG_FIG, "if97_ps_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 0.783095639e2, 0.446971906e1, 750.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, if97_r3_p(150.0, 640.0), if97_r3_s(150.0, 640.0), 640.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 0.5, if97_pt_s(0.5, 1500.0), 1500.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_h, 3.0, 0.392294792, 0.115331273e3, TEST_ACCURACY, SIG_FIG, "if97_ps_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_Vs, 0.0035, 0.852238967e1, 0.427920172e3, TEST_ACCURACY, SIG_FIG, "if97_ps_Vs", logFile);
+	
+	// two phase
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_q, 1.0, 0.7 * if97_r1_s(1.0, if97_r4_ts(1.0)) + 0.3 * if97_r2_s(1.0, if97_r4_ts(1.0)), 30.0, TEST_ACCURACY, SIG_FIG, "if97_ps_q", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_h, 1.0, 0.7 * if97_r1_s(1.0, if97_r4_ts(1.0)) + 0.3 * if97_r2_s(1.0, if97_r4_ts(1.0)), 
+			0.7 * if97_r1_h(1.0, if97_r4_ts(1.0)) + 0.3 * if97_r2_h(1.0, if97_r4_ts(1.0)), TEST_ACCURACY, SIG_FIG, "if97_ps_h", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_gamma, 1.0, 4.0, -9999.0, TEST_ACCURACY, SIG_FIG, "if97_ps_gamma", logFile);
+	
+	// out of bounds
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 1.0, -1.0, -9998.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, 120.0, 5.0, -9998.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t", logFile);
+	
+	resultSummary ("if97_ps_", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  secant_solv_n  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  secant_solv_n  *** \n\n" );	
+	
+	// the array residuals should sum the same terms as the scalar ones, to within the order the threads add them in
+	for (k = 0; k < SOLVNTESTLANES; k++) {
+		dblP[k] = 0.5 + 2.0 * k;
+		dblT[k] = 300.0 + 8.0 * k;
+	}
+	if97_r1_h_n(dblP, dblT, dblOut, SOLVNTESTLANES);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) lMismatch += !testClose(dblOut[k], if97_r1_h(dblP[k], dblT[k]), TEST_ULP_TOL);
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_r1_h_n against if97_r1_h", logFile);
+	
+	for (k = 0; k < SOLVNTESTLANES; k++) dblT[k] = 700.0 + 20.0 * k;
+	if97_r2_h_n(dblP, dblT, dblOut, SOLVNTESTLANES);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) lMismatch += !testClose(dblOut[k], if97_r2_h(dblP[k], dblT[k]), TEST_ULP_TOL);
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_r2_h_n against if97_r2_h", logFile);
+	
+	for (k = 0; k < SOLVNTESTLANES; k++) {
+		dblX[k] = 150.0 + 40.0 * k;
+		dblT[k] = 630.0 + 6.0 * k;
+	}
+	if97_r3_p_n(dblX, dblT, dblOut, SOLVNTESTLANES);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) lMismatch += !testClose(dblOut[k], if97_r3_p(dblX[k], dblT[k]), TEST_ULP_TOL);
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_r3_p_n against if97_r3_p", logFile);
+	
+	// each lane should take the same steps as secant_solv.  Near critical, on both sides of the critical temperature
+	for (k = 0; k < SOLVNTESTLANES; k++) {
+		dblP[k] = 22.1 + 0.01 * k;
+		dblT[k] = 646.5 + 0.2 * k;
+		dblX[k] = 1/if97_R3bw_v_pt(dblP[k], dblT[k]);
+	}
+	secant_solv_n(if97_r3_p_n, dblT, false, dblP, dblX, 0.05, TEST_ACCURACY, SIG_FIG, 100, slvResults, SOLVNTESTLANES);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) {
+		slvResult = secant_solv(if97_r3_p, dblT[k], false, dblP[k], dblX[k], 0.05, TEST_ACCURACY, SIG_FIG, 100);
+		lMismatch += !testClose(slvResults[k].dSolution, slvResult.dSolution, TEST_SOLV_TOL) || (slvResults[k].lIterations != slvResult.lIterations)
+				|| (slvResults[k].iErrCode != slvResult.iErrCode);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "secant_solv_n against secant_solv", logFile);
+	
+	// too few iterations allowed, so some lanes do not converge.  They should report it as secant_solv does
+	secant_solv_n(if97_r3_p_n, dblT, false, dblP, dblX, 0.05, TEST_ACCURACY, SIG_FIG, 1, slvResults, SOLVNTESTLANES);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) {
+		slvResult = secant_solv(if97_r3_p, dblT[k], false, dblP[k], dblX[k], 0.05, TEST_ACCURACY, SIG_FIG, 1);
+		lMismatch += !testClose(slvResults[k].dSolution, slvResult.dSolution, TEST_SOLV_TOL) || (slvResults[k].lIterations != slvResult.lIterations)
+				|| (slvResults[k].iErrCode != slvResult.iErrCode);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "secant_solv_n not converged, against secant_solv", logFile);
+	intermediateResult = intermediateResult | testCount ((slvResults[0].iErrCode & SOLVE_NO_CONVERGE) ? 1 : 0, 1, "secant_solv_n SOLVE_NO_CONVERGE", logFile);
+	
+	r3_rho_pt_n(dblP, dblT, dblOut, SOLVNTESTLANES);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) lMismatch += !testClose(dblOut[k], r3_rho_pt(dblP[k], dblT[k]), TEST_SOLV_TOL);
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "r3_rho_pt_n against r3_rho_pt", logFile);
+	
+	// T from (p,h) in regions 1 and 2, each lane started from the backwards equation.  Back to the original temperatures
+	dblP[0] = 3.0;	dblT[0] = 300.0;
+	dblP[1] = 80.0;	dblT[1] = 500.0;
+	dblP[2] = 10.0;	dblT[2] = 580.0;
+	dblP[3] = 0.5;	dblT[3] = 400.0;
+	for (k = 0; k < 4; k++) {
+		dblX[k] = if97_r1_h(dblP[k], dblT[k]);
+		dblOut[k] = if97_r1_t_ph(dblP[k], dblX[k]);
+	}
+	secant_solv_n(if97_r1_h_n, dblP, true, dblX, dblOut, 0.001, TEST_ACCURACY, SIG_FIG, 100, slvResults, 4);
+	for (lMismatch = 0, k = 0; k < 4; k++) lMismatch += (slvResults[k].iErrCode != SOLVE_CONVERGE) || (fabs(slvResults[k].dSolution - dblT[k]) > 1e-6);
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "secant_solv_n if97_r1_h_n", logFile);
+	
+	dblP[0] = 0.0035;	dblT[0] = 700.0;
+	dblP[1] = 0.1;	dblT[1] = 400.0;
+	dblP[2] = 5.0;	dblT[2] = 700.0;
+	dblP[3] = 25.0;	dblT[3] = 700.0;
+	for (k = 0; k < 4; k++) {
+		dblX[k] = if97_r2_h(dblP[k], dblT[k]);
+		dblOut[k] = dblT[k] * 1.01;
+	}
+	secant_solv_n(if97_r2_h_n, dblP, true, dblX, dblOut, 0.001, TEST_ACCURACY, SIG_FIG, 100, slvResults, 4);
+	for (lMismatch = 0, k = 0; k < 4; k++) lMismatch += (slvResults[k].iErrCode != SOLVE_CONVERGE) || (fabs(slvResults[k].dSolution - dblT[k]) > 1e-6);
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "secant_solv_n if97_r2_h_n", logFile);
+	
+	resultSummary ("secant_solv_n", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  newton_solv and hybrid_solv  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  newton_solv and hybrid_solv  *** \n\n" );	
+	
+	// T from (p,h) in region 1, with Cp = [dh/dT]_p.  Fewer iterations than the secant from the same guess
+	dblX[0] = if97_r1_h(3.0, 300.0);
+	slvResult = newton_solv(if97_r1_h, if97_r1_Cp, 3.0, true, dblX[0], if97_r1_t_ph(3.0, dblX[0]), TEST_ACCURACY, SIG_FIG, 20);
+	intermediateResult = intermediateResult | testSolver (slvResult, 300.0, TEST_ACCURACY, SIG_FIG, "newton_solv if97_r1_h", logFile);
+	intermediateResult = intermediateResult | testCount (slvResult.lIterations < secant_solv(if97_r1_h, 3.0, true, dblX[0], if97_r1_t_ph(3.0, dblX[0]), 0.001, TEST_ACCURACY, SIG_FIG, 20).lIterations,
+			1, "newton_solv fewer iterations than secant_solv", logFile);
+	slvResult = hybrid_solv(if97_r1_h, if97_r1_Cp, 3.0, true, dblX[0], if97_r1_t_ph(3.0, dblX[0]), IF97_R1_LTEMP, IF97_R1_UTEMP, TEST_ACCURACY, SIG_FIG, 50);
+	intermediateResult = intermediateResult | testSolver (slvResult, 300.0, TEST_ACCURACY, SIG_FIG, "hybrid_solv if97_r1_h", logFile);
+	
+	// density from (p,T) near critical, with [dp/drho]_T.  As the secant solver check, if97_r3w_v_pt ( 22.15, 647.5 ) = 0.0036940323 
+	slvResult = newton_solv(if97_r3_p, if97_r3_dpdrho, 647.5, false, 22.15, 1/0.003, TEST_ACCURACY, SIG_FIG, 100);
+	intermediateResult = intermediateResult | testSolver (slvResult, 1/0.003694034494534, TEST_ACCURACY, SIG_FIG, "newton_solv if97_r3_p(x,647.5)", logFile);
+	slvResult = hybrid_solv(if97_r3_p, if97_r3_dpdrho, 647.5, false, 22.15, 1/0.003, 200.0, 400.0, TEST_ACCURACY, SIG_FIG, 100);
+	intermediateResult = intermediateResult | testSolver (slvResult, 1/0.003694034494534, TEST_ACCURACY, SIG_FIG, "hybrid_solv if97_r3_p(x,647.5)", logFile);
+	
+	// just above the critical temperature, where [dp/drho]_T is nearly zero.  The pressure tolerance allows more error in density
+	slvResult = hybrid_solv(if97_r3_p, if97_r3_dpdrho, 647.1, false, if97_r3_p(322.0, 647.1), 250.0, 200.0, 450.0, TEST_ACCURACY, SIG_FIG, 100);
+	intermediateResult = intermediateResult | testSolver (slvResult, 322.0, 6, SIG_FIG, "hybrid_solv if97_r3_p(x,647.1)", logFile);
+	
+	// the solution is not between the limits
+	slvResult = hybrid_solv(if97_r3_p, if97_r3_dpdrho, 647.5, false, 22.15, 220.0, 200.0, 250.0, TEST_ACCURACY, SIG_FIG, 100);
+	intermediateResult = intermediateResult | testCount (slvResult.iErrCode, SOLVE_NO_BRACKET, "hybrid_solv SOLVE_NO_BRACKET", logFile);
+	
+	resultSummary ("newton_solv and hybrid_solv", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  ctx_solv  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  ctx_solv  *** \n\n" );	
+	
+	// the isotherm carries the powers of tau from one step to the next.  Each step should be as secant_solv's on if97_r3_p, to within rounding
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) {
+		dblP[k] = 22.1 + 0.01 * k;
+		dblT[k] = 646.5 + 0.2 * k;
+		if97_r3_isotherm(dblT[k], &iso);
+		slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, dblP[k], 1/if97_R3bw_v_pt(dblP[k], dblT[k]), 0.05, NULL, TEST_ACCURACY, SIG_FIG, 100);
+		slvResults[k] = secant_solv(if97_r3_p, dblT[k], false, dblP[k], 1/if97_R3bw_v_pt(dblP[k], dblT[k]), 0.05, TEST_ACCURACY, SIG_FIG, 100);
+		lMismatch += !testClose(slvResults[k].dSolution, slvResult.dSolution, TEST_SOLV_TOL) || (slvResults[k].lIterations != slvResult.lIterations)
+				|| (slvResults[k].iErrCode != slvResult.iErrCode);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "ctx_solv if97_r3_p_iso against secant_solv", logFile);
+	
+	// bracketed, with no derivative
+	if97_r3_isotherm(647.5, &iso);
+	bounds.dblLower = 200.0;
+	bounds.dblUpper = 400.0;
+	slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, 22.15, 1/0.003, 0.05, &bounds, TEST_ACCURACY, SIG_FIG, 100);
+	intermediateResult = intermediateResult | testSolver (slvResult, 1/0.003694034494534, TEST_ACCURACY, SIG_FIG, "ctx_solv bracketed if97_r3_p_iso(x,647.5)", logFile);
+	bounds.dblUpper = 250.0;
+	slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, 22.15, 1/0.003, 0.05, &bounds, TEST_ACCURACY, SIG_FIG, 100);
+	intermediateResult = intermediateResult | testCount (slvResult.iErrCode, SOLVE_NO_BRACKET, "ctx_solv SOLVE_NO_BRACKET", logFile);
+	
+	resultSummary ("ctx_solv", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  if97_warm  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_warm  *** \n\n" );	
+	
+	// small steps in region 1.  The first call is cold, the rest warm, and all agree with if97_ph_t
+	if97_warm_init(&warm);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) {
+		dblT[k] = 400.0 + 0.5 * k;
+		dblX[k] = if97_pt_h(10.0, dblT[k]);
+		dblOut[k] = if97_warm_ph_t(&warm, 10.0, dblX[k]);
+		lMismatch += (fabs(dblOut[k] - if97_ph_t(10.0, dblX[k])) > 1e-9 * dblT[k]);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_warm_ph_t against if97_ph_t", logFile);
+	intermediateResult = intermediateResult | testCount (warm.lWarm, SOLVNTESTLANES - 1, "if97_warm_ph_t warm calls", logFile);
+	intermediateResult = intermediateResult | testCount (warm.lCold, 1, "if97_warm_ph_t cold calls", logFile);
+	
+	// a step into region 2, then into the two phase region and out of range, falls back to the cold path
+	intermediateResult = intermediateResult | testCount (fabs(if97_warm_ph_t(&warm, 10.0, if97_pt_h(10.0, 700.0)) - 700.0) < 1e-6, 1, "if97_warm_ph_t region 1 to 2", logFile);
+	intermediateResult = intermediateResult | testCount (warm.iRegion, 2, "if97_warm_ph_t region kept", logFile);
+	intermediateResult = intermediateResult | testCount (if97_warm_ph_t(&warm, 1.0, 2000.0) == if97_r4_ts(1.0), 1, "if97_warm_ph_t two phase", logFile);
+	intermediateResult = intermediateResult | testCount (warm.iRegion, 0, "if97_warm_ph_t two phase not kept", logFile);
+	intermediateResult = intermediateResult | testCount ((long) if97_warm_ph_t(&warm, 120.0, 2000.0), -9998, "if97_warm_ph_t out of range", logFile);
+	intermediateResult = intermediateResult | testCount (warm.lCold, 4, "if97_warm_ph_t cold calls after fall back", logFile);
+	
+	// small steps in region 2
+	if97_warm_init(&warm);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) {
+		dblT[k] = 700.0 + 0.5 * k;
+		dblX[k] = if97_pt_s(5.0, dblT[k]);
+		dblOut[k] = if97_warm_ps_t(&warm, 5.0, dblX[k]);
+		lMismatch += (fabs(dblOut[k] - if97_ps_t(5.0, dblX[k])) > 1e-9 * dblT[k]);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_warm_ps_t against if97_ps_t", logFile);
+	intermediateResult = intermediateResult | testCount (warm.lWarm, SOLVNTESTLANES - 1, "if97_warm_ps_t warm calls", logFile);
+	
+	// small steps near the critical point, within one subregion
+	if97_warm_init(&warm);
+	for (lMismatch = 0, k = 0; k < SOLVNTESTLANES; k++) {
+		dblP[k] = 22.3 + 0.001 * k;
+		dblT[k] = 647.2 + 0.01 * k;
+		dblOut[k] = if97_warm_r3_rho_pt(&warm, dblP[k], dblT[k]);
+		lMismatch += (fabs(dblOut[k] - r3_rho_pt(dblP[k], dblT[k])) > 1e-6 * dblOut[k]) || !isNearCritical(dblP[k], dblT[k]);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_warm_r3_rho_pt against r3_rho_pt", logFile);
+	intermediateResult = intermediateResult | testCount (warm.lWarm, SOLVNTESTLANES - 1, "if97_warm_r3_rho_pt warm calls", logFile);
+	
+	resultSummary ("if97_warm", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+
+	
+	// *** Testing  if97_flash  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_flash  *** \n\n" );	
+	
+	// one state in each single phase region, found again from each pair.  if97_pt_state_mask's region 3 
+	// density is from r3_rho_pt, so within its tolerance only
+	dblP[0] = 3.0;	dblT[0] = 300.0;	dblX[0] = 1e-6;  // region 1
+	dblP[1] = 0.0035;	dblT[1] = 700.0;	dblX[1] = 1e-6;  // region 2
+	dblP[2] = 25.0;	dblT[2] = 650.0;	dblX[2] = 1e-4;  // region 3, supercritical
+	dblP[3] = 19.0;	dblT[3] = 630.0;	dblX[3] = 1e-4;  // region 3, liquid below critical
+	dblP[4] = 30.0;	dblT[4] = 2000.0;	dblX[4] = 1e-6;  // region 5
+	for (lMismatch = 0, k = 0; k < 5; k++) {
+		state = if97_pt_state_mask(dblP[k], dblT[k], IF97_MASK_H | IF97_MASK_U | IF97_MASK_S | IF97_MASK_V);
+		lMismatch += (if97_flash(IF97_PAIR_HS, state.h_kJperkg, state.s_kJperkgK, IF97_MASK_H, &flashState) != SOLVE_CONVERGE) 
+				|| (fabs(flashState.t_K - dblT[k]) > dblX[k] * dblT[k]) || (fabs(flashState.p_MPa - dblP[k]) > dblX[k] * dblP[k]);
+		lMismatch += (if97_flash(IF97_PAIR_UV, state.u_kJperkg, 1/state.rho_kgperM3, IF97_MASK_H, &flashState) != SOLVE_CONVERGE) 
+				|| (fabs(flashState.t_K - dblT[k]) > dblX[k] * dblT[k]) || (fabs(flashState.h_kJperkg - state.h_kJperkg) > dblX[k] * fabs(state.h_kJperkg));
+		lMismatch += (if97_flash(IF97_PAIR_RHOU, state.rho_kgperM3, state.u_kJperkg, 0, &flashState) != SOLVE_CONVERGE) 
+				|| (fabs(flashState.p_MPa - dblP[k]) > dblX[k] * dblP[k]) || (flashState.iRegion != state.iRegion);
+		lMismatch += (if97_flash(IF97_PAIR_TS, dblT[k], state.s_kJperkgK, 0, &flashState) != SOLVE_CONVERGE) 
+				|| (fabs(flashState.p_MPa - dblP[k]) > dblX[k] * dblP[k]);
+		lMismatch += (if97_flash(IF97_PAIR_PV, dblP[k], 1/state.rho_kgperM3, 0, &flashState) != SOLVE_CONVERGE) 
+				|| (fabs(flashState.t_K - dblT[k]) > dblX[k] * dblT[k]);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_flash against if97_pt_state_mask", logFile);
+	
+	// wet steam at 1 MPa, 40% quality
+	dblT[0] = if97_r4_ts(1.0);
+	dblX[0] = 0.6 * if97_r1_h(1.0, dblT[0]) + 0.4 * if97_r2_h(1.0, dblT[0]);
+	dblX[1] = 0.6 * if97_r1_s(1.0, dblT[0]) + 0.4 * if97_r2_s(1.0, dblT[0]);
+	intermediateResult = intermediateResult | testCount (if97_flash(IF97_PAIR_HS, dblX[0], dblX[1], IF97_MASK_H, &flashState), SOLVE_CONVERGE, "if97_flash two phase (h,s)", logFile);
+	intermediateResult = intermediateResult | testCount (flashState.iRegion, 4, "if97_flash two phase region", logFile);
+	intermediateResult = intermediateResult | testCount ((fabs(flashState.p_MPa - 1.0) < 1e-6) && (fabs(flashState.qual_pct - 40.0) < 1e-4), 1, "if97_flash two phase p and quality", logFile);
+	
+	// wet steam of a low quality.  (h,s) meets the saturation line only between the points along it from 
+	// which region 4 is guessed, and compressed liquid shares (T,h) with all of them and (T,v) with some
+	dblP[0] = 0.5;	dblX[0] = 0.01;
+	dblP[1] = 1.0;	dblX[1] = 0.02;
+	dblP[2] = 2.5;	dblX[2] = 0.002;
+	dblP[3] = 10.0;	dblX[3] = 0.05;
+	dblP[4] = 16.0;	dblX[4] = 0.001;
+	for (lMismatch = 0, k = 0; k < 5; k++) {
+		dblT[k] = if97_r4_ts(dblP[k]);
+		dblOut[0] = (1.0 - dblX[k]) * if97_r1_h(dblP[k], dblT[k]) + dblX[k] * if97_r2_h(dblP[k], dblT[k]);
+		dblOut[1] = (1.0 - dblX[k]) * if97_r1_s(dblP[k], dblT[k]) + dblX[k] * if97_r2_s(dblP[k], dblT[k]);
+		dblOut[2] = (1.0 - dblX[k]) * if97_r1_v(dblP[k], dblT[k]) + dblX[k] * if97_r2_v(dblP[k], dblT[k]);
+		lMismatch += (if97_flash(IF97_PAIR_HS, dblOut[0], dblOut[1], 0, &flashState) != SOLVE_CONVERGE) || (flashState.iRegion != 4)
+				|| (fabs(flashState.p_MPa - dblP[k]) > 1e-6 * dblP[k]) || (fabs(flashState.qual_pct - 100.0 * dblX[k]) > 1e-4);
+		lMismatch += (if97_flash_region(IF97_PAIR_TH, dblT[k], dblOut[0], 4, 0, &flashState) != SOLVE_CONVERGE) || (flashState.iRegion != 4)
+				|| (fabs(flashState.p_MPa - dblP[k]) > 1e-6 * dblP[k]) || (fabs(flashState.qual_pct - 100.0 * dblX[k]) > 1e-4);
+		lMismatch += (if97_flash(IF97_PAIR_TV, dblT[k], dblOut[2], 0, &flashState) != SOLVE_CONVERGE) || (flashState.iRegion != 4)
+				|| (fabs(flashState.p_MPa - dblP[k]) > 1e-6 * dblP[k]) || (fabs(flashState.qual_pct - 100.0 * dblX[k]) > 1e-4);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_flash two phase of a low quality", logFile);
+	dblOut[0] = 0.99 * if97_r1_h(0.5, dblT[0]) + 0.01 * if97_r2_h(0.5, dblT[0]);
+	intermediateResult = intermediateResult | testCount ((if97_flash(IF97_PAIR_TH, dblT[0], dblOut[0], IF97_MASK_H, &flashState) == SOLVE_CONVERGE) 
+			&& (flashState.iRegion == 1) && (fabs(flashState.h_kJperkg / dblOut[0] - 1.0) < 1e-9), 1, "if97_flash (T,h) compressed liquid before wet steam", logFile);
+	
+	// compressed liquid a little above its saturation pressure, which is not saturated water at a lower pressure
+	dblP[0] = 0.194316;	dblT[0] = 323.636;
+	dblP[1] = 0.455022;	dblT[1] = 304.584;
+	dblP[2] = 0.01;	dblT[2] = 280.0;
+	for (lMismatch = 0, k = 0; k < 3; k++) {
+		state = if97_pt_state_mask(dblP[k], dblT[k], IF97_MASK_U | IF97_MASK_V);
+		lMismatch += (if97_flash(IF97_PAIR_UV, state.u_kJperkg, 1/state.rho_kgperM3, 0, &flashState) != SOLVE_CONVERGE) || (flashState.iRegion != 1)
+				|| (fabs(flashState.p_MPa - dblP[k]) > 1e-4 * dblP[k]) || (fabs(flashState.t_K - dblT[k]) > 1e-6 * dblT[k]);
+		lMismatch += (if97_flash(IF97_PAIR_TV, dblT[k], 1/state.rho_kgperM3, 0, &flashState) != SOLVE_CONVERGE) || (flashState.iRegion != 1)
+				|| (fabs(flashState.p_MPa - dblP[k]) > 1e-4 * dblP[k]);
+		lMismatch += (if97_flash(IF97_PAIR_RHOU, state.rho_kgperM3, state.u_kJperkg, 0, &flashState) != SOLVE_CONVERGE) || (flashState.iRegion != 1)
+				|| (fabs(flashState.p_MPa - dblP[k]) > 1e-4 * dblP[k]);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_flash compressed liquid near saturation", logFile);
+	
+	intermediateResult = intermediateResult | testCount (if97_flash(IF97_PAIR_TV, 300.0, 1e-5, 0, &flashState), SOLVE_NO_CONVERGE, "if97_flash out of range", logFile);
+	intermediateResult = intermediateResult | testCount (flashState.iRegion, 0, "if97_flash out of range region", logFile);
+	intermediateResult = intermediateResult | testCount (if97_flash(IF97_NPAIRS, 1.0, 1.0, 0, &flashState), SOLVE_NOT_DEFINED, "if97_flash unknown pair", logFile);
+	intermediateResult = intermediateResult | testCount (if97_flash_region(IF97_PAIR_TH, 400.0, 500.0, 6, 0, &flashState), SOLVE_NOT_DEFINED, "if97_flash_region unknown region", logFile);
+	
+	resultSummary ("if97_flash", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+
+	
+	// *** Testing  if97_rhot  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_rhot  *** \n\n" );	
+	
+	// the pressure found again in the Gibbs regions, and region 3 evaluated directly
+	dblP[0] = 3.0;	dblT[0] = 300.0;  // region 1
+	dblP[1] = 0.0035;	dblT[1] = 700.0;  // region 2
+	dblP[2] = 30.0;	dblT[2] = 700.0;  // region 2, above B23 pressure
+	dblP[3] = 30.0;	dblT[3] = 2000.0;  // region 5
+	for (lMismatch = 0, k = 0; k < 4; k++) {
+		state = if97_pt_state_mask(dblP[k], dblT[k], IF97_MASK_V | IF97_MASK_H | IF97_MASK_CP);
+		flashState = if97_rhot_state_mask(state.rho_kgperM3, dblT[k], IF97_MASK_H | IF97_MASK_CP);
+		lMismatch += (flashState.iRegion != state.iRegion) || (fabs(flashState.p_MPa - dblP[k]) > 1e-9 * dblP[k]) 
+				|| (fabs(flashState.h_kJperkg - state.h_kJperkg) > 1e-9 * state.h_kJperkg) || (fabs(flashState.Cp_kJperkgK - state.Cp_kJperkgK) > 1e-9 * state.Cp_kJperkgK);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_rhot_state_mask against if97_pt_state_mask", logFile);
+	intermediateResult = intermediateResult | testCount ((fabs(if97_rhot_h(500.0, 650.0) - if97_r3_h(500.0, 650.0)) < 1e-9) && (fabs(if97_rhot_p(500.0, 650.0) / if97_r3_p(500.0, 650.0) - 1.0) < 1e-12), 1, "if97_rhot region 3", logFile);
+	intermediateResult = intermediateResult | testCount (if97_rhot_state(1.0 / if97_r2_v(1.0, 500.0), 500.0).iRegion, 2, "if97_rhot region 2", logFile);
+	intermediateResult = intermediateResult | testCount ((fabs(if97_vt_state(if97_r1_v(50.0, 350.0), 350.0).p_MPa - 50.0) < 1e-8), 1, "if97_vt_state", logFile);
+	
+	// wet steam at 1 MPa, 40% quality
+	dblT[0] = if97_r4_ts(1.0);
+	dblX[0] = 0.6 * if97_r1_v(1.0, dblT[0]) + 0.4 * if97_r2_v(1.0, dblT[0]);
+	intermediateResult = intermediateResult | testCount ((fabs(if97_rhot_q(1.0 / dblX[0], dblT[0]) - 40.0) < 1e-6), 1, "if97_rhot_q two phase", logFile);
+	intermediateResult = intermediateResult | testCount ((fabs(if97_rhot_p(1.0 / dblX[0], dblT[0]) - 1.0) < 1e-8), 1, "if97_rhot_p two phase", logFile);
+	intermediateResult = intermediateResult | testCount ((long) if97_rhot_gamma(1.0 / dblX[0], dblT[0]), -9999, "if97_rhot_gamma two phase", logFile);
+	
+	intermediateResult = intermediateResult | testCount ((long) if97_rhot_h(1000.0, 200.0), -9998, "if97_rhot_h out of range T", logFile);
+	intermediateResult = intermediateResult | testCount ((long) if97_rhot_h(1100.0, 300.0), -9998, "if97_rhot_h out of range p", logFile);
+	
+	resultSummary ("if97_rhot", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  if97_sbtl  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_sbtl  *** \n\n" );	
+	
+	intermediateResult = intermediateResult | testCount (if97_sbtl_init(&testSbtl, 40, 20), SOLVE_CONVERGE, "if97_sbtl_init", logFile);
+	
+	// single phase on and between cell borders in x and on the edges of the domains, and wet steam in each
+	// of the two phase (v,u) domains.  Near critical and region 5 are outside the tables
+	dblX[0] = exp(testSbtl.ph[0].prop[IF97_SBTL_T].x0 + 17.0 / testSbtl.ph[0].prop[IF97_SBTL_T].dblRdx);  // p on a cell border of the subcritical (p,h) domains
+	dblX[1] = exp(testSbtl.vu[0].prop[IF97_SBTL_T].x0 + 38.0 / testSbtl.vu[0].prop[IF97_SBTL_T].dblRdx);  // v on a cell border of the cold liquid (v,u) domain
+	tableStates[0] = testTablePT(3.0, 300.0, false);  // region 1
+	tableStates[1] = testTablePT(10.0, 500.0, false);
+	tableStates[2] = testTablePT(dblX[0], 400.0, false);
+	tableStates[3] = testTablePT(if97_rhot_p(1.0 / dblX[1], 285.0), 285.0, false);
+	tableStates[4] = testTablePT(IF97_SBTL_PSAT, 600.0, false);
+	tableStates[5] = testTablePT(0.0035, 700.0, false);  // region 2
+	tableStates[6] = testTablePT(15.0, 800.0, false);
+	tableStates[7] = testTablePT(dblX[0], 700.0, false);
+	tableStates[8] = testTablePT(15.0, IF97_R2_UTEMP, false);
+	tableStates[9] = testTablePT(50.0, 700.0, false);  // region 3, supercritical
+	tableStates[10] = testTablePT(IF97_SBTL_PSUPER, 700.0, false);
+	tableStates[11] = testTableWet(if97_r4_ts(1.0), 0.4);
+	tableStates[12] = testTableWet(500.0, 0.01);  // below the liquid (v,u) domains
+	tableStates[13] = testTableWet(if97_r4_ts(IF97_SBTL_PSAT), 0.5);
+	tableStates[14] = testTablePT(22.0, 648.0, true);
+	tableStates[15] = testTablePT(30.0, 1500.0, true);
+	intermediateResult = intermediateResult | testTable (testSbtlFuncs, TEST_SBTL_FUNCS, tableStates, 16, logFile);
+	
+	// the inverse functions are exact inverses of the tables, at the single phase states within them
+	for (lMismatch = 0, k = 0; k < 11; k++) {
+		dblP[0] = tableStates[k].p_MPa;
+		dblT[0] = tableStates[k].t_K;
+		state = testTableSteam(&tableStates[k]);
+		dblX[0] = 1.0 / state.rho_kgperM3;
+		lMismatch += (fabs(if97_sbtl_ph_t(&testSbtl, dblP[0], if97_sbtl_pt_h(&testSbtl, dblP[0], dblT[0])) - dblT[0]) > 1e-9)
+				|| (fabs(if97_sbtl_ph_s(&testSbtl, dblP[0], if97_sbtl_ps_h(&testSbtl, dblP[0], state.s_kJperkgK)) - state.s_kJperkgK) > 1e-9)
+				|| (fabs(if97_sbtl_vu_t(&testSbtl, dblX[0], if97_sbtl_vt_u(&testSbtl, dblX[0], dblT[0])) - dblT[0]) > 1e-9)
+				|| (fabs(if97_sbtl_vu_p(&testSbtl, dblX[0], if97_sbtl_vp_u(&testSbtl, dblX[0], dblP[0])) - dblP[0]) > 1e-9);
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_sbtl inverses", logFile);
+	state = testTableSteam(&tableStates[11]);
+	intermediateResult = intermediateResult | testCount (if97_sbtl_vu_in_tables(&testSbtl, 1.0 / state.rho_kgperM3, state.u_kJperkg), 1, "if97_sbtl_vu_in_tables two phase", logFile);
+	if97_sbtl_free(&testSbtl);
+	
+	resultSummary ("if97_sbtl", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+
+	
+	// *** Testing  if97_ttse  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_ttse  *** \n\n" );	
+	
+	ttseSpec.nP = 80;	ttseSpec.nH = 80;	ttseSpec.nT = 80;
+	ttseSpec.pLo_MPa = 0.001;	ttseSpec.pHi_MPa = 100.0;
+	ttseSpec.tLo_K = 273.15;	ttseSpec.tHi_K = 1073.15;
+	intermediateResult = intermediateResult | testCount (if97_ttse_init(&testTtse, &ttseSpec), SOLVE_CONVERGE, "if97_ttse_init", logFile);
+	
+	// states half way between nodes in ln p and in T or h, furthest from the node they are expanded from, and
+	// either side of the saturation line, where the nearest node is on the other side.  Those near critical,
+	// within half a node of the critical pressure, and outside the envelope are from IF97
+	dblP[0] = exp(testTtse.pt.x0 + 40.5 / testTtse.pt.dblRdx);
+	dblX[0] = testTtse.ph.y0 + 10.5 / testTtse.ph.dblRdy;  // h half way between nodes, liquid and steam
+	dblX[1] = testTtse.ph.y0 + 67.5 / testTtse.ph.dblRdy;
+	tableStates[0] = testTablePT(3.0, 300.0, false);  // region 1
+	tableStates[1] = testTablePT(10.0, 500.0, false);
+	tableStates[2] = testTablePT(dblP[0], if97_ph_t(dblP[0], dblX[0]), false);
+	tableStates[3] = testTablePT(dblP[0], if97_r4_ts(dblP[0]) - 0.01, false);
+	tableStates[4] = testTablePT(0.0035, 700.0, false);  // region 2
+	tableStates[5] = testTablePT(15.0, 800.0, false);
+	tableStates[6] = testTablePT(dblP[0], testTtse.pt.y0 + 40.5 / testTtse.pt.dblRdy, false);
+	tableStates[7] = testTablePT(dblP[0], if97_ph_t(dblP[0], dblX[1]), false);
+	tableStates[8] = testTablePT(dblP[0], if97_r4_ts(dblP[0]) + 0.01, false);
+	tableStates[9] = testTablePT(50.0, 700.0, false);  // region 3, supercritical
+	tableStates[10] = testTablePT(IF97_TTSE_NC_PHI + 1.0, 660.0, false);  // above the near critical box
+	tableStates[11] = testTableWet(if97_r4_ts(1.0), 0.4);
+	dblP[1] = exp(0.5 * (log(IF97_PC) + testTtse.pt.x0 + (testTtse.nSat - 0.5) / testTtse.pt.dblRdx));  // nearest node across the critical pressure
+	tableStates[12] = testTablePT(dblP[1], 700.0, true);
+	tableStates[13] = testTablePT(30.0, 1500.0, true);
+	tableStates[14] = testTablePT(0.0005, 400.0, true);
+	intermediateResult = intermediateResult | testTable (testTtseFuncs, TEST_TTSE_FUNCS, tableStates, 15, logFile);
+	
+	// a two phase (p,h) is from the tabulated saturated properties, closer than the expansions
+	state = testTableSteam(&tableStates[11]);
+	intermediateResult = intermediateResult | testCount ((fabs(if97_ttse_ph_t(&testTtse, state.p_MPa, state.h_kJperkg) - state.t_K) < 1e-3) && (fabs(if97_ttse_ph_v(&testTtse, state.p_MPa, state.h_kJperkg) * state.rho_kgperM3 - 1.0) < 1e-4), 1, "if97_ttse_ph two phase", logFile);
+	
+	// the same tables written to a file and mapped back give the same look-ups, bit for bit
+	intermediateResult = intermediateResult | testCount (if97_table_write("if97_table_test.tbl", &testTtse), 0, "if97_table_write", logFile);
+	intermediateResult = intermediateResult | testCount (if97_table_open("if97_table_test.tbl", &table), IF97_TABLE_OK, "if97_table_open", logFile);
+	for (lMismatch = 0, k = 0; k < 11; k++) {
+		state = testTableSteam(&tableStates[k]);
+		lMismatch += (if97_ttse_ph_t(&table.ttse, state.p_MPa, state.h_kJperkg) != if97_ttse_ph_t(&testTtse, state.p_MPa, state.h_kJperkg))
+				|| (if97_ttse_pt_v(&table.ttse, state.p_MPa, state.t_K) != if97_ttse_pt_v(&testTtse, state.p_MPa, state.t_K));
+	}
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_table against if97_ttse", logFile);
+	if97_table_close(&table);
+	if97_ttse_free(&testTtse);
+	
+	// a file from other coefficients is refused.  Their hash is 216 bytes into the header (if97_table.h)
+	tableFile = fopen("if97_table_test.tbl", "r+b");
+	if (tableFile != NULL) {
+		fseek(tableFile, 216, SEEK_SET);
+		k = fgetc(tableFile);
+		fseek(tableFile, 216, SEEK_SET);
+		fputc(k ^ 0x55, tableFile);
+		fclose(tableFile);
+	}
+	intermediateResult = intermediateResult | testCount (if97_table_open("if97_table_test.tbl", &table), IF97_TABLE_BAD_COEFFS, "if97_table_open other coefficients", logFile);
+	
+	// as is a corrupted file, and the look-ups then fall through to IF97
+	tableFile = fopen("if97_table_test.tbl", "r+b");
+	if (tableFile != NULL) {
+		fseek(tableFile, 216, SEEK_SET);
+		fputc(k, tableFile);
+		fseek(tableFile, -8, SEEK_END);
+		fputc(0x55, tableFile);
+		fclose(tableFile);
+	}
+	intermediateResult = intermediateResult | testCount (if97_table_open("if97_table_test.tbl", &table), IF97_TABLE_BAD_CHECKSUM, "if97_table_open corrupted", logFile);
+	intermediateResult = intermediateResult | testCount (testClose(if97_ttse_ph_t(&table.ttse, 3.0, 200.0), if97_ph_t(3.0, 200.0), TEST_ULP_TOL), 1, "if97_table refused, as IF97", logFile);
+	remove("if97_table_test.tbl");
+	intermediateResult = intermediateResult | testCount (if97_table_open("if97_table_test.tbl", &table), IF97_TABLE_NO_FILE, "if97_table_open no file", logFile);
+	
+	ttseSpec.pHi_MPa = 150.0;
+	intermediateResult = intermediateResult | testCount (if97_ttse_init(&testTtse, &ttseSpec), SOLVE_NOT_DEFINED, "if97_ttse_init beyond IF97", logFile);
+	
+	resultSummary ("if97_ttse", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  if97_compact  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_compact  *** \n\n" );	
+	
+	compactSpec.dblTolH = 1e-2;	compactSpec.dblTolV = 1e-5;
+	compactSpec.dblTolS = 1e-5;	compactSpec.dblTolU = 1e-2;
+	intermediateResult = intermediateResult | testCount (if97_compact_init(&testCompact, &compactSpec), SOLVE_CONVERGE, "if97_compact_init", logFile);
+	
+	// states close to the saturation and B23 lines, and the corners of the domains, which are nodes of every
+	// table, so are the stored floats themselves.  Regions 3 and 5 are from IF97
+	tableStates[0] = testTablePT(3.0, 300.0, false);  // region 1
+	tableStates[1] = testTablePT(16.0, if97_r4_ts(16.0) - 0.5, false);
+	tableStates[2] = testTablePT(60.0, 620.0, false);
+	tableStates[3] = testTablePT(0.0035, 700.0, false);  // region 2
+	tableStates[4] = testTablePT(16.0, if97_r4_ts(16.0) + 0.5, false);
+	tableStates[5] = testTablePT(40.0, 1000.0, false);
+	tableStates[6] = testTablePT(IF97_B23_LPRESS, IF97_B23T(IF97_B23_LPRESS) + 0.5, false);
+	tableStates[7] = testTablePT(IF97_P_TRIP * 1e-6, IF97_R1_LTEMP, false);  // corners
+	tableStates[8] = testTablePT(IF97_B23_LPRESS, IF97_R1_LTEMP, false);
+	tableStates[9] = testTablePT(IF97_R1_UPRESS, IF97_R1_LTEMP, false);
+	tableStates[10] = testTablePT(IF97_P_TRIP * 1e-6, IF97_R2_UTEMP, false);
+	tableStates[11] = testTablePT(IF97_B23_LPRESS, IF97_R2_UTEMP, false);
+	tableStates[12] = testTablePT(IF97_R1_UPRESS, IF97_R2_UTEMP, false);
+	tableStates[13] = testTablePT(25.0, 650.0, true);
+	tableStates[14] = testTablePT(30.0, 1500.0, true);
+	intermediateResult = intermediateResult | testTable (testCompactFuncs, TEST_COMPACT_FUNCS, tableStates, 15, logFile);
+	if97_compact_free(&testCompact);
+	
+	compactSpec.dblTolS = 0.0;
+	intermediateResult = intermediateResult | testCount (if97_compact_init(&testCompact, &compactSpec), SOLVE_NOT_DEFINED, "if97_compact_init no bound", logFile);
+	
+	resultSummary ("if97_compact", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  if97_quad  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_quad  *** \n\n" );	
+	
+	// h on (p,T), to a looser bound and fewer levels than the defaults
+	quadSpec.iPair = IF97_QUAD_PT;	quadSpec.iProp = IF97_H;
+	quadSpec.pLo_MPa = 0.001;	quadSpec.pHi_MPa = 100.0;
+	quadSpec.yLo = 273.15;	quadSpec.yHi = 1073.15;
+	quadSpec.dblTol = 1e-2;	quadSpec.iDepth = 8;
+	intermediateResult = intermediateResult | testCount (if97_quad_init(&testQuad, &quadSpec), SOLVE_CONVERGE, "if97_quad_init (p,T)", logFile);
+	
+	// states in the cells split whatever their errors:  beside the saturation line, either side of the B23 line
+	// and of 623.15 K, and just above the near critical region.  Those in exact leaves are from IF97
+	tableStates[0] = testTablePT(3.0, 300.0, false);  // region 1
+	tableStates[1] = testTablePT(0.0035, 700.0, false);  // region 2
+	tableStates[2] = testTablePT(15.0, 800.0, false);
+	tableStates[3] = testTablePT(50.0, 700.0, false);  // region 3
+	tableStates[4] = testTablePT(1.0, if97_r4_ts(1.0) - 0.01, false);
+	tableStates[5] = testTablePT(50.0, IF97_B23T(50.0) - 0.5, false);
+	tableStates[6] = testTablePT(50.0, IF97_B23T(50.0) + 0.5, false);
+	tableStates[7] = testTablePT(50.0, IF97_R1_UTEMP - 0.5, false);
+	tableStates[8] = testTablePT(50.0, IF97_R1_UTEMP + 0.5, false);
+	tableStates[9] = testTablePT(22.6, 647.0, false);
+	tableStates[10] = testTablePT(1.0, if97_r4_ts(1.0) + 0.01, true);  // in a cell across the saturation line
+	tableStates[11] = testTablePT(22.0, 647.0, true);  // near critical
+	tableStates[12] = testTablePT(0.0005, 400.0, true);  // below the table
+	intermediateResult = intermediateResult | testTable (&testQuadFuncs[0], 1, tableStates, 13, logFile);
+	
+	// a batch gives each look-up as if97_quad_eval, the exact leaves to the rounding of IF97
+	for (k = 0; k < 7; k++) {
+		dblP[k] = tableStates[k + 6].p_MPa;
+		dblT[k] = tableStates[k + 6].t_K;
+	}
+	if97_quad_eval_n(&testQuad, dblP, dblT, dblOut, 7);
+	for (lMismatch = 0, k = 0; k < 7; k++) lMismatch += (fabs(dblOut[k] / if97_quad_eval(&testQuad, dblP[k], dblT[k]) - 1.0) > 1e-9);
+	intermediateResult = intermediateResult | testCount (lMismatch, 0, "if97_quad_eval_n", logFile);
+	if97_quad_free(&testQuad);
+	
+	// T on (p,h), at the same states and in the two phase region
+	quadSpec.iPair = IF97_QUAD_PH;	quadSpec.iProp = IF97_T;
+	quadSpec.yLo = 0.0;	quadSpec.yHi = 4000.0;
+	quadSpec.dblTol = 0.05;	quadSpec.iDepth = 6;
+	intermediateResult = intermediateResult | testCount (if97_quad_init(&testQuad, &quadSpec), SOLVE_CONVERGE, "if97_quad_init (p,h)", logFile);
+	tableStates[13] = testTableWet(if97_r4_ts(1.0), 0.6);
+	tableStates[14] = testTableWet(if97_r4_ts(1.0), 0.95);
+	intermediateResult = intermediateResult | testTable (&testQuadFuncs[1], 1, tableStates, 15, logFile);
+	if97_quad_free(&testQuad);
+	
+	quadSpec.iProp = IF97_U;
+	intermediateResult = intermediateResult | testCount (if97_quad_init(&testQuad, &quadSpec), SOLVE_NOT_DEFINED, "if97_quad_init u on (p,h)", logFile);
+	
+	resultSummary ("if97_quad", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  if97_stats  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_stats  *** \n\n" );	
+	
+	if97_stats_reset();
+	if97_pt_h(3.0, 300.0);  // region 1
+	if97_pt_h(0.0035, 700.0);  // region 2
+	if97_pt_h(IF97_PC + 0.000001, IF97_TC + 0.000001);  // region 3, near critical
+	if97_pt_h(120.0, 300.0);  // out of range
+	if97_pt_k(3.0, 300.0);  // not applicable
+	stats = if97_stats_snapshot();
+	if97_stats_dump(logFile);
+	
+#ifdef IF97_STATS
+	intermediateResult = intermediateResult | testCount (stats.lRegion[1], 1, "region_pt R1", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lRegion[2], 1, "region_pt R2", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lRegion[3], 1, "region_pt R3", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lRegion[0], 1, "region_pt out of range", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lNearCritical, 1, "near critical", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lR3Subregion[if97_r3_pt_subregion(IF97_PC + 0.000001, IF97_TC + 0.000001) - 'a'], 1, "region 3 subregion", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lSolveNoConverge, 0, "secant_solv not converged", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lRegionNotValid, 1, "-9998 returns", logFile);
+	intermediateResult = intermediateResult | testCount (stats.lNotApplicable, 1, "-9999 returns", logFile);
+	
+	if97_stats_reset();
+	stats = if97_stats_snapshot();
+	intermediateResult = intermediateResult | testCount (stats.lRegion[1], 0, "region_pt R1 after reset", logFile);
+#else
+	// not compiled in, so nothing is counted
+	intermediateResult = intermediateResult | testCount (stats.lRegion[1] + stats.lNearCritical + stats.lRegionNotValid, 0, "counts not compiled in", logFile);
+#endif
+	
+	resultSummary ("if97_stats", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	
+	
+	// *** Testing  if97_record  ******
+	intermediateResult = TEST_PASS;
+	fprintf ( logFile, "\n\n *** Testing  if97_record  *** \n\n" );	
+	
+	if97_record_start(RECORDTESTLOC, 4);  // a ring of 4, so the first two calls are overwritten
+	if97_pt_h(3.0, 300.0);
+	if97_pt_v(3.0, 300.0);
+	if97_ph_t(3.0, 500.0);
+	if97_Ps_t(1.0);
+	StmPTH(30.0, 26.85, "SI");  // its call of if97_pt_h is not recorded
+	if97_ps_t(120.0, 5.0);
+	intermediateResult = intermediateResult | testCount (if97_record_stop(), 0, "if97_record_stop", logFile);
+	intermediateResult = intermediateResult | testCount (if97_record_load(RECORDTESTLOC, &recording), 0, "if97_record_load", logFile);
+	
+#ifdef IF97_RECORD
+	intermediateResult = intermediateResult | testCount (recording.llCalls, 6, "calls recorded", logFile);
+	intermediateResult = intermediateResult | testCount (recording.lRecords, 4, "records kept", logFile);
+	if (recording.lRecords == 4) {
+		intermediateResult = intermediateResult | testCount (recording.records[0].iFunc, IF97_REC_PH_T, "oldest record kept", logFile);
+		intermediateResult = intermediateResult | testCount (recording.records[2].iFunc, IF97_REC_STMPTH, "StmPTH record", logFile);
+		intermediateResult = intermediateResult | testCount (recording.records[2].iUSet, 1, "StmPTH unit set", logFile);
+		intermediateResult = intermediateResult | testDoubleInput (if97_ph_t, recording.records[0].dblIn1, recording.records[0].dblIn2, recording.records[0].dblResult, 15, SIG_FIG, "if97_ph_t replayed", logFile);
+		intermediateResult = intermediateResult | testDoubleInput (if97_ps_t, recording.records[3].dblIn1, recording.records[3].dblIn2, -9998.0, TEST_ACCURACY, SIG_FIG, "if97_ps_t recorded", logFile);
+		intermediateResult = intermediateResult | testSingleInput (if97_Ps_t, recording.records[1].dblIn1, recording.records[1].dblResult, 15, SIG_FIG, "if97_Ps_t replayed", logFile);
+	}
+#else
+	// not compiled in, so nothing is recorded
+	intermediateResult = intermediateResult | testCount (recording.llCalls + recording.lRecords, 0, "nothing recorded", logFile);
+#endif
+	if97_record_free(&recording);
+	
+	resultSummary ("if97_record", logFile, intermediateResult);
+	libResult = libResult | intermediateResult;
+	intermediateResult = libResult;
 	
 	
 	if (intermediateResult != 0)
@@ -16,12 +16,59 @@
 #include "IF97_common.h"
 #include "iapws_surftens.h"
 #include "solve_test.h"
+#include "if97_stats.h"
+#include "if97_record.h"
 #include <stdio.h>
 #include <math.h>  // for fabs
 #include "winsteam_compatibility.h"
 
 // test a single input function. Pass = 0. See IF97_Common.h for failure codes. 
 //Function outputs more detail to logfile if VERBOSE_TEST is true
+#define SOLVNTESTLANES 8  // lanes in the secant_solv_n tests
+#define TEST_ULP_TOL 1e-12  // relative difference allowed between the same results, differently threaded
+#define TEST_SOLV_TOL 1e-9  // and between the same solutions.  Near critical, where [dp/drho]_T is small, a solver magnifies it
+#define RECORDTESTLOC "IF97RecordTest.rec"  // written and read back by the if97_record test
+#define TEST_TABLE_STATES 24  // most states in a testTable fixture
+#define TEST_ONE_PHASE -1.0  // dblQ of a single phase typTestTableState
+
+
+// a state at which a table engine is compared with IF97:  single phase at (p,T), or wet
+// steam of quality dblQ at the saturation pressure of t_K
+typedef struct sctTestTableState {
+	double p_MPa;  // not used for wet steam
+	double t_K;
+	double dblQ;  // TEST_ONE_PHASE if single phase
+	bool bIF97;  // outside the tables, so from the IF97 equations, to TEST_SOLV_TOL
+} typTestTableState;
+
+// the inputs of a table engine's function
+enum testTablePair {
+	TEST_PAIR_PT,
+	TEST_PAIR_PH,
+	TEST_PAIR_VU,
+};
+
+// the property it gives
+enum testTableProp {
+	TEST_P,
+	TEST_T,
+	TEST_V,
+	TEST_H,
+	TEST_U,
+	TEST_S,
+	TEST_W,
+};
+
+// a function of a table engine, of the two inputs of iPair, and its tolerance as for testDoubleInput
+typedef struct sctTestTableFunc {
+	double (*func) (double, double);
+	int iPair;
+	int iProp;
+	double tol;
+	int tolType;
+	char *funcName;
+} typTestTableFunc;
+
 int testSingleInput ( double (*func) (double), double input, double expectedOutput, double tol, int tolType, char* funcName, FILE *logFile);
 
 // test a double input function. Pass = 0. See IF97_Common.h for failure codes.
@@ -36,6 +83,16 @@ int testBoolDoubleInput ( bool (*func) (double, double), double input1, double i
 //Function outputs more detail to logfile if VERBOSE_TEST is set to true
 int testCharDoubleInput ( char (*func) (double, double), double input1, double input2, char expectedOutput, char* funcName, FILE *logFile);
 
+int testCount ( long actual, long expectedOutput, char* countName, FILE *logFile);
+
+// true if actual is within a relative dblTol of expected, or equal to it.  For results of differently
+// threaded calls, which may differ in their last bits, with TEST_ULP_TOL
+bool testClose ( double actual, double expected, double dblTol);
+
+// compares each of the functions of a table engine with IF97 at each of the states, by testDoubleInput.
+// Wet states are not given to (p,T) functions.  Pass = 0
+int testTable ( const typTestTableFunc *funcs, int nFuncs, const typTestTableState *states, int nStates, FILE *logFile);
+
 
 // prints a unit test summary to the log based on the test code
 void resultSummary (char* funcName, FILE *logFile, int testCode);
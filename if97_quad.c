@@ -0,0 +1,420 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Adaptive quadtree tables of a property on (p,T) or (p,h).  See if97_quad.h
+
+/* A cell at level L covers [ix, ix + 1] 2^-L by [iy, iy + 1] 2^-L of the unit square of
+ * u = (ln p - ln pLo) / (ln pHi - ln pLo) against v = (y - yLo) / (yHi - yLo).  Over it, in
+ * t and s running from 0 to 1 across it, the biquadratic through its 3 by 3 nodes is
+ *
+ * 	z = sum over (i,j) of  Q_i(t) Q_j(s) z_ij
+ *
+ * with Q_0(t) = (1 - t)(1 - 2t), Q_1(t) = 4t (1 - t) and Q_2(t) = t (2t - 1).  Its error falls
+ * as the cube of the cell's size, so each split cuts it by about 8.
+ *
+ * The tree is built a level at a time:  the cells of a level are sampled and judged together,
+ * in parallel, then those split give the next level's cells, whose nodes follow on in node,
+ * and the leaves their values in a.  So the nodes are in breadth first order.
+ */
+
+
+#include <math.h> // for log, exp, ldexp, fabs, isfinite
+#include <stdbool.h>
+#include <stddef.h> // for NULL
+#include <stdlib.h> // for malloc, realloc, free
+
+#include "if97_quad.h"
+#include "if97_lib.h"
+#include "if97_deriv.h"
+#include "IF97_common.h"
+#include "IF97_Region3bw.h"  // for isNearCritical
+#include "IF97_Region4.h"
+#include "solve.h"
+
+
+#define QUAD_P_TRIP (IF97_P_TRIP * 1e-6)  // MPa
+#define QUAD_SAMPLES 5  // samples along each side of a cell:  its 3 nodes and the 2 points between them
+#define QUAD_MARGIN 0.5  // fraction of the error bound a leaf must meet at the points checked, for those between them
+#define QUAD_GOLDEN 0.3819660112501051  // (3 - sqrt(5)) / 2
+#define QUAD_PEAK_ITERATIONS 60  // golden section steps for the pressure of the largest saturated vapour enthalpy
+
+
+// the judgement of a cell
+enum quadStatus {
+	QUAD_LEAF,
+	QUAD_SPLIT,
+	QUAD_EXACT,
+};
+
+
+// a cell of the level being built
+typedef struct sctQuadCell {
+	int iNode;
+	int iLevel;
+	int ix;  // 0 to 2^iLevel - 1, along u
+	int iy;
+} typQuadCell;
+
+
+
+// ******  Equations   *******
+
+// the tabulated value of spec at (p_MPa, y):  the property, or ln v.  Returns its region, 0 if outside
+// IF97 or not finite.  isNear is whether the state is near critical
+int quadSample(const typIF97QuadSpec *spec, double p_MPa, double y, double *z, bool *isNear){
+	const int iMask = (spec->iProp == IF97_H) ? IF97_MASK_H : (spec->iProp == IF97_S) ? IF97_MASK_S
+			: (spec->iProp == IF97_U) ? IF97_MASK_U : (spec->iProp == IF97_V) ? IF97_MASK_V : 0;
+	typSteamState state = (spec->iPair == IF97_QUAD_PT) ? if97_pt_state_mask(p_MPa, y, iMask) : if97_ph_state_mask(p_MPa, y, iMask);
+
+	*isNear = false;
+	if (state.iRegion == 0) return 0;
+	switch (spec->iProp) {
+	case IF97_T: *z = state.t_K; break;
+	case IF97_V: *z = -log(state.rho_kgperM3); break;
+	case IF97_H: *z = state.h_kJperkg; break;
+	case IF97_S: *z = state.s_kJperkgK; break;
+	default: *z = state.u_kJperkg; break;
+	}
+	*isNear = isNearCritical(p_MPa, (spec->iPair == IF97_QUAD_PT) ? y : state.t_K);
+	return isfinite(*z) ? state.iRegion : 0;
+}
+
+
+// the property of spec at (p_MPa, y), from the equations
+double quadExact(const typIF97QuadSpec *spec, double p_MPa, double y){
+	if (spec->iPair == IF97_QUAD_PT) {
+		switch (spec->iProp) {
+		case IF97_V: return if97_pt_v(p_MPa, y);
+		case IF97_H: return if97_pt_h(p_MPa, y);
+		case IF97_S: return if97_pt_s(p_MPa, y);
+		default: return if97_pt_u(p_MPa, y);
+		}
+	}
+	switch (spec->iProp) {
+	case IF97_V: return if97_ph_v(p_MPa, y);
+	case IF97_S: return if97_ph_s(p_MPa, y);
+	default: return if97_ph_t(p_MPa, y);
+	}
+}
+
+
+// enthalpy of saturated water (bVapour false) or steam at p_MPa
+double quadSatH(double p_MPa, bool bVapour){
+	typSteamState state;
+
+	sat_props(p_MPa, if97_r4_ts(p_MPa), bVapour, IF97_MASK_H, &state);
+	return state.h_kJperkg;
+}
+
+
+// the pressure at which the saturated vapour enthalpy is largest, by golden section in ln p
+double quadPeak(void){
+	double xa = log(QUAD_P_TRIP), xb = log(IF97_PC), x1, x2, h1, h2;
+	int i;
+
+	x1 = xa + QUAD_GOLDEN * (xb - xa);
+	x2 = xb - QUAD_GOLDEN * (xb - xa);
+	h1 = quadSatH(exp(x1), true);
+	h2 = quadSatH(exp(x2), true);
+	for (i = 0; i < QUAD_PEAK_ITERATIONS; i++) {
+		if (h1 < h2) {
+			xa = x1;
+			x1 = x2;
+			h1 = h2;
+			x2 = xb - QUAD_GOLDEN * (xb - xa);
+			h2 = quadSatH(exp(x2), true);
+		}
+		else {
+			xb = x2;
+			x2 = x1;
+			h2 = h1;
+			x1 = xa + QUAD_GOLDEN * (xb - xa);
+			h1 = quadSatH(exp(x1), true);
+		}
+	}
+	return exp(0.5 * (xa + xb));
+}
+
+
+// whether the saturation line (on (p,T)), or the saturated liquid or vapour line (on (p,h)),
+// passes through the cell from pa_MPa to pb_MPa and ya to yb.  pPeak_MPa is that of quadPeak
+bool quadCrossesSat(const typIF97QuadSpec *spec, double pa_MPa, double pb_MPa, double ya, double yb, double pPeak_MPa){
+	double hLo, hHi;
+
+	if (pa_MPa >= IF97_PC) return false;
+	if (pb_MPa > IF97_PC) pb_MPa = IF97_PC;
+
+	// Ts and hL rise with p, hV rises to its peak and then falls
+	if (spec->iPair == IF97_QUAD_PT) return (if97_r4_ts(pa_MPa) < yb) && (if97_r4_ts(pb_MPa) > ya);
+	if ((quadSatH(pa_MPa, false) < yb) && (quadSatH(pb_MPa, false) > ya)) return true;
+	hLo = quadSatH(pa_MPa, true);
+	hHi = quadSatH(pb_MPa, true);
+	if (hHi < hLo) hLo = hHi;
+	hHi = quadSatH((pPeak_MPa < pa_MPa) ? pa_MPa : (pPeak_MPa > pb_MPa) ? pb_MPa : pPeak_MPa, true);
+	return (hLo < yb) && (hHi > ya);
+}
+
+
+
+// ******  Cells   *******
+
+// the biquadratic through the nodes a of a leaf at (t,s) across it
+double quadInterp(const double *a, double t, double s){
+	const double qt[3] = {(1.0 - t) * (1.0 - 2.0 * t), 4.0 * t * (1.0 - t), t * (2.0 * t - 1.0)};
+	const double qs[3] = {(1.0 - s) * (1.0 - 2.0 * s), 4.0 * s * (1.0 - s), s * (2.0 * s - 1.0)};
+
+	return qs[0] * (qt[0] * a[0] + qt[1] * a[1] + qt[2] * a[2])
+			+ qs[1] * (qt[0] * a[3] + qt[1] * a[4] + qt[2] * a[5])
+			+ qs[2] * (qt[0] * a[6] + qt[1] * a[7] + qt[2] * a[8]);
+}
+
+
+// samples cell of tab and judges it, with its nodes into a and, for a leaf, its largest error into err
+int quadCell(const typIF97Quad *tab, const typQuadCell *cell, double pPeak_MPa, double *a, double *err){
+	const typIF97QuadSpec *spec = &tab->spec;
+	double z[QUAD_SAMPLES * QUAD_SAMPLES], dblSize = ldexp(1.0, -cell->iLevel), e;
+	double xa = tab->x0 + cell->ix * dblSize / tab->dblRdx, xb = tab->x0 + (cell->ix + 1) * dblSize / tab->dblRdx;
+	double ya = spec->yLo + cell->iy * dblSize / tab->dblRdy, yb = spec->yLo + (cell->iy + 1) * dblSize / tab->dblRdy;
+	int i, j, iRegion, iFirst = -1, nOut = 0, nNear = 0, nSamples = QUAD_SAMPLES * QUAD_SAMPLES;
+	bool isNear, isMixed = false, isDeepest = (cell->iLevel >= spec->iDepth);
+
+	for (j = 0; j < QUAD_SAMPLES; j++) {
+		for (i = 0; i < QUAD_SAMPLES; i++) {
+			iRegion = quadSample(spec, exp(xa + (xb - xa) * i / (QUAD_SAMPLES - 1)), ya + (yb - ya) * j / (QUAD_SAMPLES - 1),
+					&z[j * QUAD_SAMPLES + i], &isNear);
+			if (iRegion == 0) nOut++;
+			if (isNear) nNear++;
+			if (iFirst < 0) iFirst = iRegion;
+			else if (iRegion != iFirst) isMixed = true;
+		}
+	}
+	if ((nOut == nSamples) || (nNear == nSamples)) return QUAD_EXACT;
+
+	// the equations of neighbouring regions agree only to within their consistency, so a cell
+	// across a region boundary is split too
+	if (isMixed || (nNear > 0) || quadCrossesSat(spec, exp(xa), exp(xb), ya, yb, pPeak_MPa))
+		return isDeepest ? QUAD_EXACT : QUAD_SPLIT;
+
+	for (j = 0; j < 3; j++)
+		for (i = 0; i < 3; i++) a[3 * j + i] = z[2 * j * QUAD_SAMPLES + 2 * i];
+	*err = 0.0;
+	for (j = 0; j < QUAD_SAMPLES; j++) {
+		for (i = 0; i < QUAD_SAMPLES; i++) {
+			if ((i % 2 == 0) && (j % 2 == 0)) continue;  // a node
+			e = fabs(quadInterp(a, (double) i / (QUAD_SAMPLES - 1), (double) j / (QUAD_SAMPLES - 1)) - z[j * QUAD_SAMPLES + i]);
+			if (!(e <= *err)) *err = e;
+		}
+	}
+	if (*err <= QUAD_MARGIN * spec->dblTol) return QUAD_LEAF;
+	return isDeepest ? QUAD_EXACT : QUAD_SPLIT;
+}
+
+
+
+// ******  Look-up   *******
+
+// the leaf of tab at (u,v) of the unit square, into ~ its node, and (t,s) across it
+int quadDescend(const typIF97Quad *tab, double u, double v, double *t, double *s){
+	int iDepth = tab->spec.iDepth, nCells = 1 << iDepth, ix = (int) (u * nCells), iy = (int) (v * nCells);
+	int iNode = 0, n, l;
+
+	if (ix == nCells) ix--;
+	if (iy == nCells) iy--;
+	for (l = iDepth - 1; (n = tab->node[iNode]) >= 0; l--) iNode = n + ((ix >> l) & 1) + 2 * ((iy >> l) & 1);
+
+	// the leaf is at level iDepth - 1 - l
+	*t = ldexp(u, iDepth - 1 - l) - (ix >> (l + 1));
+	*s = ldexp(v, iDepth - 1 - l) - (iy >> (l + 1));
+	return n;
+}
+
+
+// the property of tab from a leaf at (t,s) across it.  NAN for an exact leaf
+double quadLeaf(const typIF97Quad *tab, int n, double t, double s){
+	double z = quadInterp(tab->a + (size_t) IF97_QUAD_NODES * ~n, t, s);
+
+	return (tab->spec.iProp == IF97_V) ? exp(z) : z;
+}
+
+
+
+// ******  External   *******
+
+int if97_quad_init(typIF97Quad *tab, const typIF97QuadSpec *spec){
+	const typIF97QuadSpec defaultSpec = {IF97_QUAD_PT, IF97_H, QUAD_P_TRIP, IF97_R1_UPRESS, IF97_R1_LTEMP, IF97_R2_UTEMP,
+			IF97_QUAD_TOL, IF97_QUAD_DEPTH};
+	typQuadCell *cell = NULL, *next;
+	double *val, *err, *a, pPeak_MPa;
+	int *iStatus, *node;
+	int c, q, k, nCells = 1, nSplit, nLeaf, iFail = 0;
+	bool isValid;
+
+	tab->node = NULL;
+	tab->a = NULL;
+	tab->nNodes = tab->nLeaves = tab->nExact = tab->iDeepest = 0;
+	tab->dblErr = 0.0;
+	tab->lBytes = 0;
+	tab->spec = (spec == NULL) ? defaultSpec : *spec;
+	spec = &tab->spec;
+
+	if (spec->iPair == IF97_QUAD_PT) isValid = (spec->iProp == IF97_H) || (spec->iProp == IF97_V) || (spec->iProp == IF97_S) || (spec->iProp == IF97_U);
+	else isValid = (spec->iPair == IF97_QUAD_PH) && ((spec->iProp == IF97_T) || (spec->iProp == IF97_V) || (spec->iProp == IF97_S));
+	if (!(isValid && (spec->pLo_MPa > 0.0) && (spec->pLo_MPa < spec->pHi_MPa) && isfinite(spec->pHi_MPa)
+			&& (spec->yLo < spec->yHi) && isfinite(spec->yLo) && isfinite(spec->yHi)
+			&& (spec->dblTol > 0.0) && isfinite(spec->dblTol) && (spec->iDepth >= 1) && (spec->iDepth <= IF97_QUAD_MAXDEPTH)))
+		return SOLVE_NOT_DEFINED;
+	tab->x0 = log(spec->pLo_MPa);
+	tab->dblRdx = 1.0 / (log(spec->pHi_MPa) - tab->x0);
+	tab->dblRdy = 1.0 / (spec->yHi - spec->yLo);
+	pPeak_MPa = quadPeak();
+
+	// the root, and leaf 0 for the exact leaves
+	tab->node = malloc(sizeof(int));
+	tab->a = malloc(IF97_QUAD_NODES * sizeof(double));
+	cell = malloc(sizeof(typQuadCell));
+	if ((tab->node == NULL) || (tab->a == NULL) || (cell == NULL)) iFail = SOLVE_NO_MEMORY;
+	else {
+		for (k = 0; k < IF97_QUAD_NODES; k++) tab->a[k] = NAN;
+		tab->nNodes = tab->nLeaves = 1;
+		cell[0].iNode = cell[0].iLevel = cell[0].ix = cell[0].iy = 0;
+	}
+
+	// a level at a time, until no cell is split
+	while ((iFail == 0) && (nCells > 0)) {
+		next = NULL;
+		val = malloc((size_t) nCells * IF97_QUAD_NODES * sizeof(double));
+		err = malloc((size_t) nCells * sizeof(double));
+		iStatus = malloc((size_t) nCells * sizeof(int));
+		if ((val == NULL) || (err == NULL) || (iStatus == NULL)) iFail = SOLVE_NO_MEMORY;
+		else {
+			#pragma omp parallel for  // the cells are independent
+			for (c = 0; c < nCells; c++) iStatus[c] = quadCell(tab, &cell[c], pPeak_MPa, val + (size_t) c * IF97_QUAD_NODES, &err[c]);
+
+			for (c = nSplit = nLeaf = 0; c < nCells; c++) {
+				nSplit += (iStatus[c] == QUAD_SPLIT);
+				nLeaf += (iStatus[c] == QUAD_LEAF);
+			}
+			node = realloc(tab->node, ((size_t) tab->nNodes + 4 * (size_t) nSplit) * sizeof(int));
+			if (node != NULL) tab->node = node;
+			a = realloc(tab->a, ((size_t) tab->nLeaves + nLeaf) * IF97_QUAD_NODES * sizeof(double));
+			if (a != NULL) tab->a = a;
+			next = malloc(((nSplit > 0) ? 4 * (size_t) nSplit : 1) * sizeof(typQuadCell));
+			if ((node == NULL) || (a == NULL) || (next == NULL)) iFail = SOLVE_NO_MEMORY;
+		}
+
+		// the next level's cells, and the leaves
+		for (c = nSplit = 0; (iFail == 0) && (c < nCells); c++) {
+			switch (iStatus[c]) {
+			case QUAD_SPLIT:
+				tab->node[cell[c].iNode] = tab->nNodes;
+				for (q = 0; q < 4; q++) {
+					next[nSplit].iNode = tab->nNodes++;
+					next[nSplit].iLevel = cell[c].iLevel + 1;
+					next[nSplit].ix = 2 * cell[c].ix + (q & 1);
+					next[nSplit++].iy = 2 * cell[c].iy + (q >> 1);
+				}
+				break;
+			case QUAD_LEAF:
+				tab->node[cell[c].iNode] = ~tab->nLeaves;
+				for (k = 0; k < IF97_QUAD_NODES; k++) tab->a[(size_t) tab->nLeaves * IF97_QUAD_NODES + k] = val[(size_t) c * IF97_QUAD_NODES + k];
+				tab->nLeaves++;
+				if (err[c] > tab->dblErr) tab->dblErr = err[c];
+				break;
+			default:
+				tab->node[cell[c].iNode] = ~0;
+				tab->nExact++;
+				break;
+			}
+			if ((iStatus[c] != QUAD_SPLIT) && (cell[c].iLevel > tab->iDeepest)) tab->iDeepest = cell[c].iLevel;
+		}
+		free(val);
+		free(err);
+		free(iStatus);
+		free(cell);
+		if (iFail != 0) {
+			free(next);
+			next = NULL;
+		}
+		cell = next;
+		nCells = nSplit;
+	}
+	free(cell);
+
+	if (iFail != 0) {
+		if97_quad_free(tab);
+		return iFail;
+	}
+	tab->lBytes = (size_t) tab->nNodes * sizeof(int) + (size_t) tab->nLeaves * IF97_QUAD_NODES * sizeof(double);
+	return SOLVE_CONVERGE;
+}
+
+
+void if97_quad_free(typIF97Quad *tab){
+	free(tab->node);
+	free(tab->a);
+	tab->node = NULL;
+	tab->a = NULL;
+	tab->nNodes = tab->nLeaves = tab->nExact = 0;
+	tab->lBytes = 0;
+}
+
+
+
+double if97_quad_eval(const typIF97Quad *tab, double p_MPa, double y){
+	double u = (log(p_MPa) - tab->x0) * tab->dblRdx, v = (y - tab->spec.yLo) * tab->dblRdy, t, s, z;
+	int n;
+
+	if ((tab->node == NULL) || !((u >= 0.0) && (u <= 1.0) && (v >= 0.0) && (v <= 1.0))) return quadExact(&tab->spec, p_MPa, y);
+	n = quadDescend(tab, u, v, &t, &s);
+	z = quadLeaf(tab, n, t, s);
+	if (isnan(z)) return quadExact(&tab->spec, p_MPa, y);
+	return z;
+}
+
+
+/* each batch of IF97_QUAD_LANES look-ups descends a level at a time together, so that the
+ * loads of their nodes, likely each a cache miss deep in a large tree, overlap */
+void if97_quad_eval_n(const typIF97Quad *tab, const double *p_MPa, const double *y, double *z, int n){
+	int iNode[IF97_QUAD_LANES], ix[IF97_QUAD_LANES], iy[IF97_QUAD_LANES], l[IF97_QUAD_LANES];
+	double u[IF97_QUAD_LANES], v[IF97_QUAD_LANES];
+	int iDepth = tab->spec.iDepth, nCells = 1 << iDepth, k0, j, m, nd, iLevel;
+	bool isMoving;
+
+	for (k0 = 0; k0 < n; k0 += IF97_QUAD_LANES) {
+		m = (n - k0 < IF97_QUAD_LANES) ? n - k0 : IF97_QUAD_LANES;
+		for (j = 0; j < m; j++) {
+			u[j] = (log(p_MPa[k0 + j]) - tab->x0) * tab->dblRdx;
+			v[j] = (y[k0 + j] - tab->spec.yLo) * tab->dblRdy;
+			iNode[j] = -1;
+			if (!((tab->node != NULL) && (u[j] >= 0.0) && (u[j] <= 1.0) && (v[j] >= 0.0) && (v[j] <= 1.0))) continue;
+			iNode[j] = 0;
+			ix[j] = (int) (u[j] * nCells);
+			if (ix[j] == nCells) ix[j]--;
+			iy[j] = (int) (v[j] * nCells);
+			if (iy[j] == nCells) iy[j]--;
+			l[j] = iDepth - 1;
+		}
+		do {
+			isMoving = false;
+			for (j = 0; j < m; j++) {
+				if ((iNode[j] < 0) || ((nd = tab->node[iNode[j]]) < 0)) continue;
+				iNode[j] = nd + ((ix[j] >> l[j]) & 1) + 2 * ((iy[j] >> l[j]) & 1);
+				l[j]--;
+				isMoving = true;
+			}
+		} while (isMoving);
+
+		for (j = 0; j < m; j++) {
+			if (iNode[j] < 0) z[k0 + j] = NAN;
+			else {
+				iLevel = iDepth - 1 - l[j];
+				z[k0 + j] = quadLeaf(tab, tab->node[iNode[j]], ldexp(u[j], iLevel) - (ix[j] >> (l[j] + 1)),
+						ldexp(v[j], iLevel) - (iy[j] >> (l[j] + 1)));
+			}
+			if (isnan(z[k0 + j])) z[k0 + j] = quadExact(&tab->spec, p_MPa[k0 + j], y[k0 + j]);
+		}
+	}
+}
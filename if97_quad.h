@@ -0,0 +1,121 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Adaptive quadtree tables of a property on (p,T) or (p,h)
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_quad.h
+ * @author Martin Lord
+ * @brief One property from (p,T) or (p,h), from a table refined only where the equations need it
+ * @details
+ * A regular grid fine enough for the critical region and the saturation line has far more
+ * nodes than the rest of the range needs.  Here the range, in x = ln p and y = T or h, is
+ * instead a quadtree:  each cell is compared with the IF97 equations and, unless within the
+ * error bound, split into four, down to spec.iDepth levels.  \n
+ *
+ * A leaf holds the property (ln v for v) at its corners, the middle of its edges and its
+ * centre, and is looked up by the biquadratic through them.  A cell is accepted as a leaf
+ * if the biquadratic is within half the bound at the 16 points of the 5 by 5 grid over it
+ * that are not nodes, leaving the other half for the points between them.  Some cells are
+ * split whatever their errors:  those that the saturation line (for (p,T)) or the saturated
+ * liquid or vapour line (for (p,h)) passes through, those part in the near critical region
+ * of isNearCritical, and those whose points are in more than one region, or part outside
+ * IF97, since the equations of neighbouring regions differ by up to their consistency.  Such
+ * a cell still split at the deepest level, a cell wholly near critical or outside IF97, or
+ * one that cannot meet the bound, is an exact leaf, looked up by the equations themselves.
+ * So a look-up is within the bound of the equations, as far as the checks can show, or is
+ * them.  \n
+ *
+ * For h on (p,T) to 1e-3 kJ/kg over regions 1 to 3, twelve levels deep, the tree has about
+ * 70000 leaves and 17000 exact leaves, in about 5 MB, where a uniform grid as fine as its
+ * deepest cells would have 16 million.  \n
+ *
+ * The tree is a flat array of ints, in breadth first order, with no pointers:  node[i] of an
+ * inner node is the index of the first of its four children, which follow one another, and
+ * that of a leaf is ~l, l its index into a.  Leaf 0 is every exact leaf, and holds NAN.  A
+ * look-up descends from node[0] by the bits of the state's cell at the deepest level.
+ * if97_quad_eval_n descends IF97_QUAD_LANES look-ups together, so that their loads overlap.
+ *
+ * UNITS  p: MPa, T: K, v: m3/kg, h, u: kJ/kg, s: kJ/kg/K
+ */
+
+
+#ifndef IF97_QUAD_H
+#define IF97_QUAD_H
+
+#include <stddef.h>
+
+
+#define IF97_QUAD_TOL 1e-3  // kJ/kg  default error bound, of h
+#define IF97_QUAD_DEPTH 12  // default deepest level below the root
+#define IF97_QUAD_MAXDEPTH 20
+#define IF97_QUAD_NODES 9  // values at each leaf
+#define IF97_QUAD_LANES 8  // look-ups descended together by if97_quad_eval_n
+
+
+// the pair the property is tabulated on
+enum if97_quad_pair_t {
+	IF97_QUAD_PT = 0,
+	IF97_QUAD_PH = 1,
+};
+
+
+/** the table to build */
+typedef struct sctIF97QuadSpec {
+	int iPair;  // enum if97_quad_pair_t
+	int iProp;  // enum if97_prop_t:  IF97_H, IF97_V, IF97_S or IF97_U on (p,T), IF97_T, IF97_V or IF97_S on (p,h)
+	double pLo_MPa;
+	double pHi_MPa;
+	double yLo;  // T (K) or h (kJ/kg)
+	double yHi;
+	double dblTol;  // largest difference from the equations allowed.  Relative for v
+	int iDepth;  // deepest level, 1 to IF97_QUAD_MAXDEPTH
+} typIF97QuadSpec;
+
+
+/** the quadtree of one property */
+typedef struct sctIF97Quad {
+	typIF97QuadSpec spec;
+	double x0;  // ln pLo_MPa
+	double dblRdx;  // 1 / (ln pHi_MPa - ln pLo_MPa)
+	double dblRdy;  // 1 / (yHi - yLo)
+	int nNodes;
+	int nLeaves;  // including leaf 0
+	int nExact;  // exact leaves
+	int iDeepest;  // level of the deepest leaf
+	double dblErr;  // largest error found in checking the leaves, other than the exact ones
+	size_t lBytes;  // memory of node and a
+	int *node;  // node[i] the first child of inner node i, as (lo x, lo y), (hi x, lo y), (lo x, hi y), (hi x, hi y), or ~l for leaf l
+	double *a;  // a[IF97_QUAD_NODES l + 3 j + i] the value at node (i,j), i along x, of leaf l
+} typIF97Quad;
+
+
+/** builds the quadtree of spec in tab, or of h on (p,T) from the triple point pressure to
+ * 100 MPa and 273.15 K to 1073.15 K, to IF97_QUAD_TOL and IF97_QUAD_DEPTH, if spec is NULL.
+ * Returns SOLVE_CONVERGE (0) if built, SOLVE_NO_MEMORY if it could not be allocated, or
+ * SOLVE_NOT_DEFINED if spec is not valid.  Unless built, tab holds no memory */
+int if97_quad_init(typIF97Quad *tab, const typIF97QuadSpec *spec);
+
+/** frees the quadtree of tab */
+void if97_quad_free(typIF97Quad *tab);
+
+
+/** the property of tab at p_MPa and y (T in K or h in kJ/kg).  As the IF97 equations (if97_pt_h,
+ * if97_ph_t and so on) in an exact leaf, or outside the table */
+double if97_quad_eval(const typIF97Quad *tab, double p_MPa, double y);
+
+/** the property of tab at each of n states, into z, each as if97_quad_eval gives */
+void if97_quad_eval_n(const typIF97Quad *tab, const double *p_MPa, const double *y, double *z, int n);
+
+
+#endif // IF97_QUAD_H
@@ -0,0 +1,350 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Optional recording of library calls, for replay by if97_replay.  See if97_record.h
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define IF97_HAVE_TSC
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>
+	#define IF97_HAVE_TSC
+#endif
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#include "if97_record.h"
+
+
+#define IF97_RECORD_MAGIC "IF97REC1"
+
+
+const char *if97RecFuncNames[IF97_REC_NUM_FUNCS] = {
+	"none",
+	"if97_Ps_t", "if97_Ts_p",
+	"if97_pt_h", "if97_pt_u", "if97_pt_s", "if97_pt_v", "if97_pt_Cv", "if97_pt_Cp",
+	"if97_pt_k", "if97_pt_mu", "if97_pt_Vs", "if97_pt_gamma",
+	"if97_ph_t", "if97_ph_s", "if97_ph_v", "if97_ph_q", "if97_ph_Cp", "if97_ph_Vs", "if97_ph_gamma",
+	"if97_ps_t", "if97_ps_h", "if97_ps_v", "if97_ps_q", "if97_ps_Cp", "if97_ps_Vs", "if97_ps_gamma",
+	"StmPT", "StmTP",
+	"StmPTH", "StmPTS", "StmPTV", "StmPTC", "StmPTK", "StmPTM", "StmPTW", "StmPTG",
+	"StmPHT", "StmPHS", "StmPHV", "StmPHQ", "StmPHC", "StmPHW", "StmPHG",
+	"StmPST", "StmPSH", "StmPSV", "StmPSQ", "StmPSC", "StmPSW", "StmPSG",
+	"if97_rhot_p", "if97_rhot_h", "if97_rhot_u", "if97_rhot_s", "if97_rhot_q", "if97_rhot_Cv", "if97_rhot_Cp", "if97_rhot_Vs", "if97_rhot_gamma"
+};
+
+
+const char *if97_record_func_name(int iFunc){
+	if ((iFunc <= IF97_REC_NONE) || (iFunc >= IF97_REC_NUM_FUNCS)) return "unknown";
+	return if97RecFuncNames[iFunc];
+}
+
+
+unsigned long long if97_record_ticks(void){
+#if defined(IF97_HAVE_TSC)
+	return (unsigned long long) __rdtsc();
+#elif defined(_WIN32)
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (unsigned long long) ((double) count.QuadPart * 1e9 / (double) freq.QuadPart);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long) ts.tv_sec * 1000000000ull + (unsigned long long) ts.tv_nsec;
+#endif
+}
+
+
+int if97_record_tick_unit(void){
+#ifdef IF97_HAVE_TSC
+	return IF97_TICKS_CYCLES;
+#else
+	return IF97_TICKS_NS;
+#endif
+}
+
+
+
+// ************** THE RING *********************
+
+typIF97Record *arrRecords = NULL;
+long lRecCapacity = 0;
+long long llRecNext = 0;  // calls recorded.  The next goes in [llRecNext % lRecCapacity]
+char strRecFile[260] = "";
+bool isRecExitSet = false;
+
+#ifdef IF97_RECORD
+	int if97RecordState = IF97_RECORD_UNKNOWN;
+	IF97_RECORD_THREAD_LOCAL bool if97RecordBusy = false;
+#endif
+
+
+void if97_record_exit(void){
+	if97_record_stop();
+}
+
+
+int if97_record_start(const char *strFile, long lCapacity){
+	typIF97Record *records;
+
+	if97_record_stop();
+	if (lCapacity <= 0) lCapacity = IF97_RECORD_SIZE;
+	records = malloc(lCapacity * sizeof(typIF97Record));
+	if (records == NULL) return 1;
+
+	#pragma omp critical (if97_record)
+	{
+		arrRecords = records;
+		lRecCapacity = lCapacity;
+		llRecNext = 0;
+		snprintf(strRecFile, sizeof(strRecFile), "%s", strFile);
+		if (!isRecExitSet) isRecExitSet = (atexit(if97_record_exit) == 0);
+#ifdef IF97_RECORD
+		if97RecordState = IF97_RECORD_ON;
+#endif
+	}
+	return 0;
+}
+
+
+void recWriteU32 (FILE *out, unsigned long lValue){
+	int i;
+	for (i = 0; i < 4; i++) fputc((int) ((lValue >> (8 * i)) & 0xff), out);
+}
+
+void recWriteU64 (FILE *out, unsigned long long llValue){
+	int i;
+	for (i = 0; i < 8; i++) fputc((int) ((llValue >> (8 * i)) & 0xff), out);
+}
+
+void recWriteDouble (FILE *out, double dblValue){
+	unsigned long long llBits;
+	memcpy(&llBits, &dblValue, sizeof(double));
+	recWriteU64(out, llBits);
+}
+
+
+int if97_record_stop(void){
+	FILE *out;
+	long long i, llFirst, llRecords;
+	int iThreads = 1;
+	int iErr = 0;
+
+	if (arrRecords == NULL) return 0;
+#ifdef IF97_RECORD
+	if97RecordState = IF97_RECORD_OFF;
+#endif
+#ifdef _OPENMP
+	iThreads = omp_get_max_threads();
+#endif
+
+	llRecords = (llRecNext < lRecCapacity) ? llRecNext : lRecCapacity;
+	llFirst = llRecNext - llRecords;
+
+	out = fopen(strRecFile, "wb");
+	if (out == NULL) iErr = 1;
+	else {
+		fwrite(IF97_RECORD_MAGIC, 1, 8, out);
+		recWriteU32(out, IF97_RECORD_BYTES);
+		recWriteU32(out, (unsigned long) if97_record_tick_unit());
+		recWriteU32(out, (unsigned long) iThreads);
+		recWriteU64(out, (unsigned long long) llRecNext);
+		recWriteU64(out, (unsigned long long) llRecords);
+		for (i = llFirst; i < llRecNext; i++) {
+			typIF97Record *rec = &arrRecords[i % lRecCapacity];
+			fputc(rec->iFunc & 0xff, out);
+			fputc((rec->iFunc >> 8) & 0xff, out);
+			fputc(0, out);
+			fputc(0, out);
+			recWriteU32(out, (unsigned long) rec->iUSet);
+			recWriteDouble(out, rec->dblIn1);
+			recWriteDouble(out, rec->dblIn2);
+			recWriteDouble(out, rec->dblResult);
+			recWriteU64(out, rec->llTicks);
+		}
+		if (fclose(out) != 0) iErr = 1;
+	}
+
+	free(arrRecords);
+	arrRecords = NULL;
+	lRecCapacity = 0;
+	return iErr;
+}
+
+
+
+// ************** THE HOOKS *********************
+
+#ifdef IF97_RECORD
+
+// looks for the environment variable IF97_RECORD on the first call
+bool if97_record_on(void){
+	const char *strFile, *strSize;
+
+	if (if97RecordState == IF97_RECORD_UNKNOWN) {
+		#pragma omp critical (if97_record_env)
+		{
+			if (if97RecordState == IF97_RECORD_UNKNOWN) {
+				strFile = getenv("IF97_RECORD");
+				strSize = getenv("IF97_RECORD_SIZE");
+				if ((strFile == NULL) || (strFile[0] == 0) || (if97_record_start(strFile, (strSize != NULL) ? atol(strSize) : 0) != 0))
+					if97RecordState = IF97_RECORD_OFF;
+			}
+		}
+	}
+	return (if97RecordState == IF97_RECORD_ON);
+}
+
+
+void if97_record_put(int iFunc, int iUSet, double dblIn1, double dblIn2, double dblResult, unsigned long long llTicks){
+	long long llSlot;
+	typIF97Record *rec;
+
+	if ((arrRecords == NULL) || (if97RecordState != IF97_RECORD_ON)) return;
+
+#if defined(_MSC_VER)
+	llSlot = InterlockedExchangeAdd64(&llRecNext, 1);
+#elif defined(__GNUC__)
+	llSlot = __sync_fetch_and_add(&llRecNext, 1);
+#else
+	#pragma omp critical (if97_record_slot)
+	llSlot = llRecNext++;
+#endif
+
+	rec = &arrRecords[llSlot % lRecCapacity];
+	rec->iFunc = iFunc;
+	rec->iUSet = iUSet;
+	rec->dblIn1 = dblIn1;
+	rec->dblIn2 = dblIn2;
+	rec->dblResult = dblResult;
+	rec->llTicks = llTicks;
+}
+
+
+double if97_record_1(int iFunc, double (*func) (double), double dblIn1){
+	unsigned long long llStart;
+	double dblResult;
+
+	if (!if97_record_on()) return func(dblIn1);
+
+	if97RecordBusy = true;
+	llStart = if97_record_ticks();
+	dblResult = func(dblIn1);
+	if97_record_put(iFunc, -1, dblIn1, 0.0, dblResult, if97_record_ticks() - llStart);
+	if97RecordBusy = false;
+	return dblResult;
+}
+
+
+double if97_record_2(int iFunc, double (*func) (double, double), double dblIn1, double dblIn2){
+	unsigned long long llStart;
+	double dblResult;
+
+	if (!if97_record_on()) return func(dblIn1, dblIn2);
+
+	if97RecordBusy = true;
+	llStart = if97_record_ticks();
+	dblResult = func(dblIn1, dblIn2);
+	if97_record_put(iFunc, -1, dblIn1, dblIn2, dblResult, if97_record_ticks() - llStart);
+	if97RecordBusy = false;
+	return dblResult;
+}
+
+#endif // IF97_RECORD
+
+
+
+// ************** READING *********************
+
+bool recReadU32 (FILE *in, unsigned long *lValue){
+	unsigned char bytes[4];
+	int i;
+
+	if (fread(bytes, 1, 4, in) != 4) return false;
+	*lValue = 0;
+	for (i = 3; i >= 0; i--) *lValue = (*lValue << 8) | bytes[i];
+	return true;
+}
+
+bool recReadU64 (FILE *in, unsigned long long *llValue){
+	unsigned char bytes[8];
+	int i;
+
+	if (fread(bytes, 1, 8, in) != 8) return false;
+	*llValue = 0;
+	for (i = 7; i >= 0; i--) *llValue = (*llValue << 8) | bytes[i];
+	return true;
+}
+
+bool recReadDouble (FILE *in, double *dblValue){
+	unsigned long long llBits;
+
+	if (!recReadU64(in, &llBits)) return false;
+	memcpy(dblValue, &llBits, sizeof(double));
+	return true;
+}
+
+
+int if97_record_load(const char *strFile, typIF97RecordFile *rec){
+	FILE *in = fopen(strFile, "rb");
+	char strMagic[8];
+	unsigned long lBytes, lTickUnit, lThreads, lFunc = 0, lUSet = 0;
+	unsigned long long llCalls, llRecords;
+	long i;
+	bool isOK;
+
+	memset(rec, 0, sizeof(typIF97RecordFile));
+	if (in == NULL) return 1;
+
+	isOK = (fread(strMagic, 1, 8, in) == 8) && (memcmp(strMagic, IF97_RECORD_MAGIC, 8) == 0)
+			&& recReadU32(in, &lBytes) && (lBytes == IF97_RECORD_BYTES) && recReadU32(in, &lTickUnit) && recReadU32(in, &lThreads)
+			&& recReadU64(in, &llCalls) && recReadU64(in, &llRecords) && (llRecords <= llCalls) && (llRecords < 0x7fffffffull);
+	if (isOK && (llRecords > 0)) {
+		rec->records = malloc((size_t) llRecords * sizeof(typIF97Record));
+		isOK = (rec->records != NULL);
+	}
+
+	for (i = 0; isOK && (i < (long) llRecords); i++) {
+		isOK = recReadU32(in, &lFunc) && recReadU32(in, &lUSet) && recReadDouble(in, &rec->records[i].dblIn1)
+				&& recReadDouble(in, &rec->records[i].dblIn2) && recReadDouble(in, &rec->records[i].dblResult)
+				&& recReadU64(in, &rec->records[i].llTicks);
+		rec->records[i].iFunc = (int) (lFunc & 0xffff);
+		rec->records[i].iUSet = (lUSet & 0x80000000UL) ? -(int) (((~lUSet) & 0xffffffffUL) + 1) : (int) lUSet;  // int32
+	}
+	fclose(in);
+
+	if (!isOK) {
+		if97_record_free(rec);
+		return 2;
+	}
+	rec->iTickUnit = (int) lTickUnit;
+	rec->iThreads = (int) lThreads;
+	rec->llCalls = (long long) llCalls;
+	rec->lRecords = (long) llRecords;
+	return 0;
+}
+
+
+void if97_record_free(typIF97RecordFile *rec){
+	free(rec->records);
+	rec->records = NULL;
+	rec->lRecords = 0;
+}
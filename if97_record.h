@@ -0,0 +1,153 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Optional recording of library calls, for replay by if97_replay
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_record.h
+ * @author Martin Lord
+ * @brief Records calls of the scalar functions of if97_lib and winsteam_compatibility
+ * @details
+ * The hooks are compiled in only if IF97_RECORD is defined (./waf configure --record).
+ * Otherwise the recording macros below expand to nothing.  \n
+ *
+ * With the hooks compiled in, nothing is recorded until if97_record_start is called,
+ * or, without any change to the calling programme, if the environment variable
+ * IF97_RECORD names a file when the first call is made.  IF97_RECORD_SIZE then sets
+ * the number of records kept.  \n
+ *
+ * Each outermost call (a call made by the library itself is not recorded) is kept
+ * in a ring in memory: the function, the bits of its inputs and result, its unit set
+ * and the ticks (cycles where the time stamp counter can be read, otherwise ns) it
+ * took.  When the ring is full the oldest records are overwritten.  The ring is
+ * written to the file, oldest first, by if97_record_stop, which is also called at
+ * exit.  Calls must not be in progress on other threads when it is stopped.  \n
+ *
+ * File (all little endian):
+ *   "IF97REC1"                                                 8 bytes
+ *   record size (40), tick unit (IF97_TICKS_*), threads        uint32 each
+ *   calls recorded, records in the file                        uint64 each
+ *   records: function (uint16), 0 (uint16), unit set (int32),
+ *            input 1, input 2, result (IEEE double), ticks (uint64)
+ */
+
+
+#ifndef IF97_RECORD_H
+#define IF97_RECORD_H
+
+#include <stdbool.h>
+
+
+#define IF97_RECORD_SIZE 262144  // default records kept
+#define IF97_RECORD_BYTES 40  // size of a record in the file
+
+#define IF97_TICKS_CYCLES 0  // time stamp counter
+#define IF97_TICKS_NS 1
+
+
+// the recorded functions.  The winsteam ones are recorded as their _u forms
+enum if97RecFunc {
+	IF97_REC_NONE = 0,
+	IF97_REC_SAT_T, IF97_REC_SAT_P,  // if97_Ps_t, if97_Ts_p
+	IF97_REC_PT_H, IF97_REC_PT_U, IF97_REC_PT_S, IF97_REC_PT_V, IF97_REC_PT_CV, IF97_REC_PT_CP,
+	IF97_REC_PT_K, IF97_REC_PT_MU, IF97_REC_PT_VS, IF97_REC_PT_GAMMA,
+	IF97_REC_PH_T, IF97_REC_PH_S, IF97_REC_PH_V, IF97_REC_PH_Q, IF97_REC_PH_CP, IF97_REC_PH_VS, IF97_REC_PH_GAMMA,
+	IF97_REC_PS_T, IF97_REC_PS_H, IF97_REC_PS_V, IF97_REC_PS_Q, IF97_REC_PS_CP, IF97_REC_PS_VS, IF97_REC_PS_GAMMA,
+	IF97_REC_STMPT, IF97_REC_STMTP,
+	IF97_REC_STMPTH, IF97_REC_STMPTS, IF97_REC_STMPTV, IF97_REC_STMPTC, IF97_REC_STMPTK, IF97_REC_STMPTM, IF97_REC_STMPTW, IF97_REC_STMPTG,
+	IF97_REC_STMPHT, IF97_REC_STMPHS, IF97_REC_STMPHV, IF97_REC_STMPHQ, IF97_REC_STMPHC, IF97_REC_STMPHW, IF97_REC_STMPHG,
+	IF97_REC_STMPST, IF97_REC_STMPSH, IF97_REC_STMPSV, IF97_REC_STMPSQ, IF97_REC_STMPSC, IF97_REC_STMPSW, IF97_REC_STMPSG,
+	IF97_REC_RHOT_P, IF97_REC_RHOT_H, IF97_REC_RHOT_U, IF97_REC_RHOT_S, IF97_REC_RHOT_Q, IF97_REC_RHOT_CV, IF97_REC_RHOT_CP, IF97_REC_RHOT_VS, IF97_REC_RHOT_GAMMA,
+	IF97_REC_NUM_FUNCS
+};
+
+
+typedef struct sctIF97Record {
+	int iFunc;  // enum if97RecFunc
+	int iUSet;  // unit set of the winsteam functions.  -1 for if97_lib
+	double dblIn1;
+	double dblIn2;  // 0 for functions of one input
+	double dblResult;
+	unsigned long long llTicks;
+} typIF97Record;
+
+
+typedef struct sctIF97RecordFile {
+	int iTickUnit;  // IF97_TICKS_*
+	int iThreads;  // OpenMP threads when recorded.  The region sums, and so the last bits, depend on it
+	long long llCalls;  // calls recorded, including those overwritten
+	long lRecords;  // records read
+	typIF97Record *records;  // oldest first.  Free with if97_record_free
+} typIF97RecordFile;
+
+
+/** starts recording into a ring of lCapacity records (IF97_RECORD_SIZE if 0 or less),
+ * to be written to strFile.  0 on success, 1 if the ring cannot be allocated */
+int if97_record_start(const char *strFile, long lCapacity);
+
+/** stops recording and writes the ring.  0 on success (or if not recording), 1 if it cannot be written */
+int if97_record_stop(void);
+
+/** reads a recording.  0 on success, 1 if the file cannot be opened, 2 if it is not a recording or is truncated */
+int if97_record_load(const char *strFile, typIF97RecordFile *rec);
+
+void if97_record_free(typIF97RecordFile *rec);
+
+/** the name of a recorded function, as called by the user */
+const char *if97_record_func_name(int iFunc);
+
+/** a time stamp in the units of if97_record_tick_unit */
+unsigned long long if97_record_ticks(void);
+int if97_record_tick_unit(void);
+
+
+
+// ******  Used internally   *******
+
+#ifdef IF97_RECORD
+
+	#if defined(_MSC_VER)
+		#define IF97_RECORD_THREAD_LOCAL __declspec(thread)
+	#elif defined(__GNUC__)
+		#define IF97_RECORD_THREAD_LOCAL __thread
+	#else
+		#define IF97_RECORD_THREAD_LOCAL _Thread_local
+	#endif
+
+	#define IF97_RECORD_UNKNOWN 0  // IF97_RECORD not yet looked for
+	#define IF97_RECORD_OFF 1
+	#define IF97_RECORD_ON 2
+
+	extern int if97RecordState;
+	extern IF97_RECORD_THREAD_LOCAL bool if97RecordBusy;  // in a recorded call, so calls within it are not recorded
+
+	bool if97_record_on(void);  // looks for IF97_RECORD on the first call
+	void if97_record_put(int iFunc, int iUSet, double dblIn1, double dblIn2, double dblResult, unsigned long long llTicks);
+	double if97_record_1(int iFunc, double (*func) (double), double dblIn1);
+	double if97_record_2(int iFunc, double (*func) (double, double), double dblIn1, double dblIn2);
+
+	// the first statement of a recorded function.  It calls the function again, timed, and records it
+	#define IF97_RECORD_1(iFunc, func, in1) \
+		if ((if97RecordState != IF97_RECORD_OFF) && !if97RecordBusy) return if97_record_1(iFunc, func, in1)
+	#define IF97_RECORD_2(iFunc, func, in1, in2) \
+		if ((if97RecordState != IF97_RECORD_OFF) && !if97RecordBusy) return if97_record_2(iFunc, func, in1, in2)
+
+#else
+
+	#define IF97_RECORD_1(iFunc, func, in1)
+	#define IF97_RECORD_2(iFunc, func, in1, in2)
+
+#endif // IF97_RECORD
+
+
+#endif // IF97_RECORD_H
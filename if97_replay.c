@@ -0,0 +1,296 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* REPLAY OF A RECORDING MADE WITH if97_record.h
+*
+* Each recorded call is made again, in the recorded order on one thread, and its
+* result compared bit for bit with the recorded result.  The calls are then made
+* again from several threads, for the throughput.  The report gives, for each
+* function, its calls, its share of the replay time, its mean ticks when recorded
+* and when replayed, and any results which differ.
+*
+* The sums of the region equations are OpenMP reductions, so their last bits
+* depend on the number of threads.  The single threaded replay uses the thread
+* count of the recording; the results of the multithreaded replay, where those
+* sums run on one thread, are checked but not expected to be bitwise identical.
+*
+* usage: if97_replay <recording> [threads]
+*         returns 0 if the single threaded replay matched, 1 if not, 2 on a file error
+* *******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#include "if97_lib.h"
+#include "if97_record.h"
+#include "winsteam_compatibility.h"
+
+
+#define REPLAY_MAX_REPORTED 10  // mismatches written out in full
+
+
+// the recorded functions, by enum if97RecFunc.  One of the four is set for each
+typedef struct sctReplayFunc {
+	double (*f1) (double);
+	double (*f2) (double, double);
+	double (*stm1) (double, const typStmUnitSet *);
+	double (*stm2) (double, double, const typStmUnitSet *);
+} typReplayFunc;
+
+
+typedef struct sctReplayTotals {
+	int iFunc;
+	long lCalls;
+	unsigned long long llRecTicks;
+	unsigned long long llReplayTicks;
+	long lMismatches;  // single threaded
+	long lThreadMismatches;  // multithreaded
+} typReplayTotals;
+
+
+typReplayFunc replayFuncs[IF97_REC_NUM_FUNCS];
+typReplayTotals totals[IF97_REC_NUM_FUNCS];
+volatile double dblSink;
+
+
+void replayFuncsInit (void){
+	memset(replayFuncs, 0, sizeof(replayFuncs));
+
+	replayFuncs[IF97_REC_SAT_T].f1 = if97_Ps_t;
+	replayFuncs[IF97_REC_SAT_P].f1 = if97_Ts_p;
+
+	replayFuncs[IF97_REC_PT_H].f2 = if97_pt_h;
+	replayFuncs[IF97_REC_PT_U].f2 = if97_pt_u;
+	replayFuncs[IF97_REC_PT_S].f2 = if97_pt_s;
+	replayFuncs[IF97_REC_PT_V].f2 = if97_pt_v;
+	replayFuncs[IF97_REC_PT_CV].f2 = if97_pt_Cv;
+	replayFuncs[IF97_REC_PT_CP].f2 = if97_pt_Cp;
+	replayFuncs[IF97_REC_PT_K].f2 = if97_pt_k;
+	replayFuncs[IF97_REC_PT_MU].f2 = if97_pt_mu;
+	replayFuncs[IF97_REC_PT_VS].f2 = if97_pt_Vs;
+	replayFuncs[IF97_REC_PT_GAMMA].f2 = if97_pt_gamma;
+
+	replayFuncs[IF97_REC_PH_T].f2 = if97_ph_t;
+	replayFuncs[IF97_REC_PH_S].f2 = if97_ph_s;
+	replayFuncs[IF97_REC_PH_V].f2 = if97_ph_v;
+	replayFuncs[IF97_REC_PH_Q].f2 = if97_ph_q;
+	replayFuncs[IF97_REC_PH_CP].f2 = if97_ph_Cp;
+	replayFuncs[IF97_REC_PH_VS].f2 = if97_ph_Vs;
+	replayFuncs[IF97_REC_PH_GAMMA].f2 = if97_ph_gamma;
+
+	replayFuncs[IF97_REC_PS_T].f2 = if97_ps_t;
+	replayFuncs[IF97_REC_PS_H].f2 = if97_ps_h;
+	replayFuncs[IF97_REC_PS_V].f2 = if97_ps_v;
+	replayFuncs[IF97_REC_PS_Q].f2 = if97_ps_q;
+	replayFuncs[IF97_REC_PS_CP].f2 = if97_ps_Cp;
+	replayFuncs[IF97_REC_PS_VS].f2 = if97_ps_Vs;
+	replayFuncs[IF97_REC_PS_GAMMA].f2 = if97_ps_gamma;
+
+	replayFuncs[IF97_REC_STMPT].stm1 = StmPT_u;
+	replayFuncs[IF97_REC_STMTP].stm1 = StmTP_u;
+
+	replayFuncs[IF97_REC_STMPTH].stm2 = StmPTH_u;
+	replayFuncs[IF97_REC_STMPTS].stm2 = StmPTS_u;
+	replayFuncs[IF97_REC_STMPTV].stm2 = StmPTV_u;
+	replayFuncs[IF97_REC_STMPTC].stm2 = StmPTC_u;
+	replayFuncs[IF97_REC_STMPTK].stm2 = StmPTK_u;
+	replayFuncs[IF97_REC_STMPTM].stm2 = StmPTM_u;
+	replayFuncs[IF97_REC_STMPTW].stm2 = StmPTW_u;
+	replayFuncs[IF97_REC_STMPTG].stm2 = StmPTG_u;
+
+	replayFuncs[IF97_REC_STMPHT].stm2 = StmPHT_u;
+	replayFuncs[IF97_REC_STMPHS].stm2 = StmPHS_u;
+	replayFuncs[IF97_REC_STMPHV].stm2 = StmPHV_u;
+	replayFuncs[IF97_REC_STMPHQ].stm2 = StmPHQ_u;
+	replayFuncs[IF97_REC_STMPHC].stm2 = StmPHC_u;
+	replayFuncs[IF97_REC_STMPHW].stm2 = StmPHW_u;
+	replayFuncs[IF97_REC_STMPHG].stm2 = StmPHG_u;
+
+	replayFuncs[IF97_REC_STMPST].stm2 = StmPST_u;
+	replayFuncs[IF97_REC_STMPSH].stm2 = StmPSH_u;
+	replayFuncs[IF97_REC_STMPSV].stm2 = StmPSV_u;
+	replayFuncs[IF97_REC_STMPSQ].stm2 = StmPSQ_u;
+	replayFuncs[IF97_REC_STMPSC].stm2 = StmPSC_u;
+	replayFuncs[IF97_REC_STMPSW].stm2 = StmPSW_u;
+	replayFuncs[IF97_REC_STMPSG].stm2 = StmPSG_u;
+
+	replayFuncs[IF97_REC_RHOT_P].f2 = if97_rhot_p;
+	replayFuncs[IF97_REC_RHOT_H].f2 = if97_rhot_h;
+	replayFuncs[IF97_REC_RHOT_U].f2 = if97_rhot_u;
+	replayFuncs[IF97_REC_RHOT_S].f2 = if97_rhot_s;
+	replayFuncs[IF97_REC_RHOT_Q].f2 = if97_rhot_q;
+	replayFuncs[IF97_REC_RHOT_CV].f2 = if97_rhot_Cv;
+	replayFuncs[IF97_REC_RHOT_CP].f2 = if97_rhot_Cp;
+	replayFuncs[IF97_REC_RHOT_VS].f2 = if97_rhot_Vs;
+	replayFuncs[IF97_REC_RHOT_GAMMA].f2 = if97_rhot_gamma;
+}
+
+
+// the unit set handle for a recorded unit set number
+const typStmUnitSet *replayUnitSet (int iUSet){
+	char strUnitSet[8];
+
+	if ((iUSet >= 0) && (iUSet <= 6)) {
+		sprintf(strUnitSet, "%i", iUSet);
+		return StmUnitSetOpen(strUnitSet);
+	}
+	if (iUSet == 100) return StmUnitSetOpen("none");
+	return StmUnitSetOpen("engo");  // an IFC-67 set
+}
+
+
+// makes the recorded call again.  false if the function is not known
+bool replayCall (const typIF97Record *rec, double *dblResult){
+	const typReplayFunc *f;
+
+	if ((rec->iFunc <= IF97_REC_NONE) || (rec->iFunc >= IF97_REC_NUM_FUNCS)) return false;
+	f = &replayFuncs[rec->iFunc];
+
+	if (f->f1 != NULL) *dblResult = f->f1(rec->dblIn1);
+	else if (f->f2 != NULL) *dblResult = f->f2(rec->dblIn1, rec->dblIn2);
+	else if (f->stm1 != NULL) *dblResult = f->stm1(rec->dblIn1, replayUnitSet(rec->iUSet));
+	else if (f->stm2 != NULL) *dblResult = f->stm2(rec->dblIn1, rec->dblIn2, replayUnitSet(rec->iUSet));
+	else return false;
+	return true;
+}
+
+
+// a wall clock time in s
+double replayNow (void){
+#ifdef _WIN32
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double) count.QuadPart / (double) freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+#endif
+}
+
+
+// the totals in descending order of replay ticks
+int replayCompare (const void *a, const void *b){
+	const typReplayTotals *ta = a, *tb = b;
+	return (ta->llReplayTicks < tb->llReplayTicks) - (ta->llReplayTicks > tb->llReplayTicks);
+}
+
+
+
+int main (int argc, char **argv){
+	typIF97RecordFile rec;
+	typIF97Record *r;
+	double dblResult = 0.0, dblStart, dblSeconds;
+	unsigned long long llStart, llTotalTicks = 0;
+	long i, lMismatches = 0, lThreadMismatches = 0, lUnknown = 0;
+	int iFunc, iThreads = 1, iErr;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: if97_replay <recording> [threads]\n");
+		return 2;
+	}
+#ifdef _OPENMP
+	iThreads = omp_get_max_threads();
+#endif
+	if (argc > 2) iThreads = atoi(argv[2]);
+	if (iThreads < 1) iThreads = 1;
+
+	iErr = if97_record_load(argv[1], &rec);
+	if (iErr != 0) {
+		fprintf(stderr, "if97_replay: %s %s\n", argv[1], (iErr == 1) ? "cannot be opened" : "is not a valid recording");
+		return 2;
+	}
+
+	printf("%s: %li records of %lli calls, recorded on %i threads, ticks in %s\n", argv[1], rec.lRecords, rec.llCalls,
+			rec.iThreads, (rec.iTickUnit == IF97_TICKS_CYCLES) ? "cycles" : "ns");
+	if (rec.iTickUnit != if97_record_tick_unit())
+		printf("the ticks of this machine are in %s, so recorded and replayed ticks do not compare\n",
+				(if97_record_tick_unit() == IF97_TICKS_CYCLES) ? "cycles" : "ns");
+
+	replayFuncsInit();
+	memset(totals, 0, sizeof(totals));
+	for (iFunc = 0; iFunc < IF97_REC_NUM_FUNCS; iFunc++) totals[iFunc].iFunc = iFunc;
+
+	// in order on one thread, bit for bit
+#ifdef _OPENMP
+	omp_set_num_threads((rec.iThreads > 0) ? rec.iThreads : 1);  // as recorded, for the same region sums
+#endif
+	dblStart = replayNow();
+	for (i = 0; i < rec.lRecords; i++) {
+		r = &rec.records[i];
+		llStart = if97_record_ticks();
+		if (!replayCall(r, &dblResult)) {
+			lUnknown++;
+			continue;
+		}
+		llStart = if97_record_ticks() - llStart;
+
+		totals[r->iFunc].lCalls++;
+		totals[r->iFunc].llRecTicks += r->llTicks;
+		totals[r->iFunc].llReplayTicks += llStart;
+		llTotalTicks += llStart;
+
+		if (memcmp(&dblResult, &r->dblResult, sizeof(double)) != 0) {
+			totals[r->iFunc].lMismatches++;
+			if (lMismatches++ < REPLAY_MAX_REPORTED)
+				printf("mismatch: record %li %s(%.17g, %.17g) unit set %i: recorded %.17g, replayed %.17g\n", i,
+						if97_record_func_name(r->iFunc), r->dblIn1, r->dblIn2, r->iUSet, r->dblResult, dblResult);
+		}
+	}
+	dblSeconds = replayNow() - dblStart;
+	printf("\nsingle threaded: %li calls in %.3f s, %.0f calls/s, %li results differ, %li unknown functions\n",
+			rec.lRecords - lUnknown, dblSeconds, (rec.lRecords - lUnknown) / dblSeconds, lMismatches, lUnknown);
+
+	// from several threads
+	if (iThreads > 1) {
+#ifdef _OPENMP
+		omp_set_num_threads(iThreads);
+#endif
+		dblStart = replayNow();
+		#pragma omp parallel for private(dblResult) reduction(+:lThreadMismatches) schedule(dynamic, 256)  //handle loop multithreaded
+		for (i = 0; i < rec.lRecords; i++) {
+			if (!replayCall(&rec.records[i], &dblResult)) continue;
+			if (memcmp(&dblResult, &rec.records[i].dblResult, sizeof(double)) != 0) {
+				lThreadMismatches++;
+				#pragma omp atomic
+				totals[rec.records[i].iFunc].lThreadMismatches++;
+			}
+		}
+		dblSeconds = replayNow() - dblStart;
+		printf("%i threads: %.3f s, %.0f calls/s, %li results differ\n", iThreads, dblSeconds,
+				(rec.lRecords - lUnknown) / dblSeconds, lThreadMismatches);
+	}
+
+	// where the time goes
+	qsort(totals, IF97_REC_NUM_FUNCS, sizeof(typReplayTotals), replayCompare);
+	printf("\n%-16s %10s %8s %14s %14s %10s %10s\n", "function", "calls", "time %", "ticks/call rec", "ticks/call", "differ", "differ MT");
+	for (iFunc = 0; iFunc < IF97_REC_NUM_FUNCS; iFunc++) {
+		if (totals[iFunc].lCalls == 0) continue;
+		printf("%-16s %10li %8.1f %14.0f %14.0f %10li %10li\n", if97_record_func_name(totals[iFunc].iFunc), totals[iFunc].lCalls,
+				(llTotalTicks > 0) ? 100.0 * totals[iFunc].llReplayTicks / llTotalTicks : 0.0,
+				(double) totals[iFunc].llRecTicks / totals[iFunc].lCalls, (double) totals[iFunc].llReplayTicks / totals[iFunc].lCalls,
+				totals[iFunc].lMismatches, totals[iFunc].lThreadMismatches);
+	}
+
+	dblSink = dblResult;
+	if97_record_free(&rec);
+	return (lMismatches == 0) ? 0 : 1;
+}
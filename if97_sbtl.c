@@ -0,0 +1,877 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Spline based table look-up for (p,h) and (v,u) inputs.  See if97_sbtl.h
+
+/* The splines interpolate the property at the nodes:  the two edges of each cell and
+ * its middle in each direction, so that the nx by ny cells of a domain have
+ * (nx + 2) by (ny + 2) nodes at which the IF97 equations are evaluated: both edges of
+ * the domain and the middle of every cell.  The values at the inner cell edges
+ * (the knots) are then found so that the first derivative is continuous.  For the
+ * quadratic in cell k through the knots s[k], s[k+1] and the middle value m[k],
+ *
+ * 	q(t) = s[k] (1 - 3t + 2t^2) + m[k] (4t - 4t^2) + s[k+1] (2t^2 - t)
+ *
+ * and equal slopes at the knots give the tridiagonal system
+ *
+ * 	s[k-1] + 6 s[k] + s[k+1] = 4 (m[k-1] + m[k])
+ *
+ * The biquadratic is the tensor product:  the knots are found along x for every row of
+ * nodes, then along eta for every column of values so found.
+ *
+ * Along the saturated liquid (v,u) has a turning point:  v' is least at IF97_SBTL_TVMAX,
+ * so that u'(v) there has an infinite slope, as sqrt(v - v'min).  That domain's x
+ * is therefore sqrt(v - v'min), in which u' is smooth.
+ */
+
+
+#include <math.h> // for log, exp, sqrt, fabs, isfinite
+#include <stdbool.h>
+#include <stddef.h> // for NULL
+#include <stdlib.h> // for malloc, free
+
+#include "if97_sbtl.h"
+#include "if97_lib.h"
+#include "if97_flash.h"
+#include "IF97_common.h"
+#include "IF97_Region4.h"
+#include "if97_stats.h"
+#include "solve.h"
+
+
+#define SBTL_TWO_PHASE -1  // sbtlPhLocate: between the saturated liquid and steam
+#define SBTL_EXACT -2  // sbtl*Locate: outside the tables
+#define SBTL_PAIR_PH 0
+#define SBTL_PAIR_VU 1
+#define SBTL_P_TRIP (IF97_P_TRIP * 1e-6)  // MPa
+#define SBTL_TOL 1e-12  // relative tolerance of the temperatures found in building the tables
+#define SBTL_V_TOL 1e-9  // relative tolerance of v on an isobar or the saturation line, which in region 3 are found by iteration
+#define SBTL_V_JUMP 1e-4  // largest relative jump in v, and in u (kJ/kg), across the B23 line
+#define SBTL_U_JUMP 0.2
+#define SBTL_SOLVE_MAX 100
+#define SBTL_MASK (IF97_MASK_V | IF97_MASK_H | IF97_MASK_U | IF97_MASK_S | IF97_MASK_W)
+
+
+// kinds of domain edge
+enum sbtlEdgeKind {
+	SBTL_ISOTHERM,
+	SBTL_ISOBAR,
+	SBTL_SAT_LIQ,
+	SBTL_SAT_VAP,
+	SBTL_WET_ISOTHERM,  // the two phase states at T
+};
+
+// the (v,u) domains
+enum sbtlVuDomain {
+	SBTL_VU_L1,  // liquid colder than IF97_SBTL_TVMAX:  from the 100 MPa isobar to IF97_SBTL_TVMAX
+	SBTL_VU_L2,  // liquid:  from the 100 MPa isobar to the saturated liquid
+	SBTL_VU_C1,  // near critical volumes:  from the IF97_SBTL_PSUPER isobar to the 100 MPa isobar
+	SBTL_VU_C2,  // near critical volumes:  from the IF97_SBTL_PSUPER isobar to 1073.15 K
+	SBTL_VU_G1,  // steam:  from the saturated steam to 1073.15 K
+	SBTL_VU_G2,  // steam beyond the saturated steam at the triple point:  from 273.16 K to 1073.15 K
+	SBTL_VU_W1,  // two phase below SBTL_VU_L2:  from the triple point to the saturated liquid
+	SBTL_VU_W2,  // two phase below SBTL_VU_C1 and SBTL_VU_C2:  from the triple point to IF97_SBTL_PSAT
+	SBTL_VU_W3,  // two phase below SBTL_VU_G1:  from the triple point to the saturated steam
+};
+
+
+typedef struct sctSbtlEdge {
+	int iKind;
+	double dblValue;  // T (K) of an isotherm, p (MPa) of an isobar
+} typSbtlEdge;
+
+
+typedef struct sctSbtlSpec {
+	int iPair;
+	typSbtlEdge lo;
+	typSbtlEdge hi;
+} typSbtlSpec;
+
+
+typedef struct sctSbtlSolveCtx {
+	double dblConst;  // the property held constant
+	bool bVapour;
+	double dblEdgeT[2];  // temperatures at the edges of a domain
+	double dblEdgeY[2];  // and u there
+} typSbtlSolveCtx;
+
+
+
+// ******  Splines   *******
+
+// the values at the knots and cell middles of the quadratic spline of n cells with f[0]
+// at the start, f[1 .. n] at the cell middles and f[n + 1] at the end.  val[2k] is
+// the value at knot k, val[2k + 1] at the middle of cell k.  f and val are strided.
+// work must hold n doubles
+void sbtlKnots(int n, const double *f, long lStrideF, double *val, long lStrideV, double *work){
+	double dblPrevC = 0.0, dblPrevD = 0.0, dblRhs, dblDenom;
+	int k;
+
+	val[0] = f[0];
+	val[2 * n * lStrideV] = f[(n + 1) * lStrideF];
+	for (k = 0; k < n; k++)
+		val[(2 * k + 1) * lStrideV] = f[(k + 1) * lStrideF];
+
+	// tridiagonal (1, 6, 1) system in the inner knots, by the Thomas algorithm
+	for (k = 1; k < n; k++) {
+		dblRhs = 4.0 * (val[(2 * k - 1) * lStrideV] + val[(2 * k + 1) * lStrideV]);
+		if (k == 1) dblRhs -= val[0];
+		if (k == n - 1) dblRhs -= val[2 * n * lStrideV];
+		dblDenom = 6.0 - dblPrevC;
+		work[k] = dblPrevC = 1.0 / dblDenom;
+		val[2 * k * lStrideV] = dblPrevD = (dblRhs - dblPrevD) / dblDenom;
+	}
+	for (k = n - 2; k >= 1; k--)
+		val[2 * k * lStrideV] -= work[k] * val[2 * (k + 1) * lStrideV];
+}
+
+
+// coefficients of t^0, t^1, t^2 of the quadratic through v0 at t = 0, vm at t = 1/2 and v1 at t = 1
+void sbtlQuadCoeffs(double v0, double vm, double v1, double *c){
+	c[0] = v0;
+	c[1] = -3.0 * v0 + 4.0 * vm - v1;
+	c[2] = 2.0 * v0 - 4.0 * vm + 2.0 * v1;
+}
+
+
+// x at node i of n cells from x0 to x1:  the two ends and the cell middles
+double sbtlNode(int i, int n, double x0, double x1){
+	if (i == 0) return x0;
+	if (i == n + 1) return x1;
+	return x0 + (x1 - x0) * (i - 0.5) / n;
+}
+
+
+bool sbtlSpline1Init(typIF97Spline1 *spl, int n, double x0, double x1, const double *f){
+	double *val = malloc((2 * n + 1) * sizeof(double));
+	double *work = malloc(n * sizeof(double));
+	int k;
+
+	spl->n = n;
+	spl->x0 = x0;
+	spl->dblRdx = n / (x1 - x0);
+	spl->a = malloc(3 * n * sizeof(double));
+	if ((val != NULL) && (work != NULL) && (spl->a != NULL)) {
+		sbtlKnots(n, f, 1, val, 1, work);
+		for (k = 0; k < n; k++)
+			sbtlQuadCoeffs(val[2 * k], val[2 * k + 1], val[2 * k + 2], spl->a + 3 * k);
+	}
+	free(val);
+	free(work);
+	return (spl->a != NULL) && (val != NULL) && (work != NULL);
+}
+
+
+double sbtlSpline1(const typIF97Spline1 *spl, double x){
+	double t = (x - spl->x0) * spl->dblRdx;
+	int k = (int) t;
+	const double *a;
+
+	if (k < 0) k = 0;
+	else if (k >= spl->n) k = spl->n - 1;
+	t -= k;
+	a = spl->a + 3 * k;
+	return a[0] + t * (a[1] + t * a[2]);
+}
+
+
+// builds spl from f[i (ny + 2) + j], its values at the nx + 2 nodes in x and the ny + 2 in eta
+bool sbtlSpline2Init(typIF97Spline2 *spl, int nx, int ny, double x0, double x1, const double *f){
+	long lRows = 2 * nx + 1, lCols = 2 * ny + 1;
+	double *g = malloc(lRows * (ny + 2) * sizeof(double));  // knots along x of every row of nodes
+	double *val = malloc(lRows * lCols * sizeof(double));  // and along eta of those
+	double *work = malloc(((nx > ny) ? nx : ny) * sizeof(double));
+	double w[3][3], c[3];
+	double *a;
+	int i, j, k, l;
+	bool bOk;
+
+	spl->nx = nx;
+	spl->ny = ny;
+	spl->x0 = x0;
+	spl->dblRdx = nx / (x1 - x0);
+	spl->a = malloc(9L * nx * ny * sizeof(double));
+	bOk = (g != NULL) && (val != NULL) && (work != NULL) && (spl->a != NULL);
+	if (bOk) {
+		for (j = 0; j < ny + 2; j++)
+			sbtlKnots(nx, f + j, ny + 2, g + j, ny + 2, work);
+		for (i = 0; i < lRows; i++)
+			sbtlKnots(ny, g + i * (ny + 2), 1, val + i * lCols, 1, work);
+
+		for (k = 0; k < nx; k++) {
+			for (l = 0; l < ny; l++) {
+				a = spl->a + 9 * ((long) k * ny + l);
+				for (i = 0; i < 3; i++)  // along eta, on each of the cell's rows
+					sbtlQuadCoeffs(val[(2 * k + i) * lCols + 2 * l], val[(2 * k + i) * lCols + 2 * l + 1],
+								val[(2 * k + i) * lCols + 2 * l + 2], w[i]);
+				for (j = 0; j < 3; j++) {  // then along x, for each power of u
+					sbtlQuadCoeffs(w[0][j], w[1][j], w[2][j], c);
+					for (i = 0; i < 3; i++) a[3 * i + j] = c[i];
+				}
+			}
+		}
+	}
+	free(g);
+	free(val);
+	free(work);
+	return bOk;
+}
+
+
+// the cell of spl holding x, and t, x's position across it
+const double *sbtlColumn(const typIF97Spline2 *spl, double x, double *t){
+	int k;
+
+	*t = (x - spl->x0) * spl->dblRdx;
+	k = (int) *t;
+	if (k < 0) k = 0;
+	else if (k >= spl->nx) k = spl->nx - 1;
+	*t -= k;
+	return spl->a + 9 * (long) k * spl->ny;
+}
+
+
+double sbtlSpline2(const typIF97Spline2 *spl, double x, double eta){
+	double t, u = eta * spl->ny;
+	int l = (int) u;
+	const double *a = sbtlColumn(spl, x, &t);
+
+	if (l < 0) l = 0;
+	else if (l >= spl->ny) l = spl->ny - 1;
+	u -= l;
+	a += 9 * l;
+	return (a[0] + u * (a[1] + u * a[2])) + t * ((a[3] + u * (a[4] + u * a[5])) + t * (a[6] + u * (a[7] + u * a[8])));
+}
+
+
+// root between 0 and 1 of c2 u^2 + c1 u + c0
+double sbtlQuadRoot(double c2, double c1, double c0){
+	double q, u1, u2;
+
+	if (fabs(c2) <= 1e-14 * fabs(c1)) u1 = u2 = -c0 / c1;
+	else {
+		q = c1 * c1 - 4.0 * c2 * c0;
+		q = -0.5 * (c1 + copysign(sqrt((q > 0.0) ? q : 0.0), c1));
+		u1 = q / c2;
+		u2 = (q != 0.0) ? c0 / q : u1;
+	}
+	if (fabs(u2 - 0.5) < fabs(u1 - 0.5)) u1 = u2;
+	return (u1 < 0.0) ? 0.0 : ((u1 > 1.0) ? 1.0 : u1);
+}
+
+
+// eta at which spl, which must be monotonic in eta, is z at x.  NAN if it is not between 0 and 1.
+// z within rounding of an edge, such as T on the 1073.15 K isotherm, is on it
+double sbtlSpline2Eta(const typIF97Spline2 *spl, double x, double z){
+	double t, zLo, zHi, zMid, dblTol;
+	const double *a = sbtlColumn(spl, x, &t);
+	int lLo = 0, lHi = spl->ny, lMid;
+	bool bUp;
+
+	zLo = a[0] + t * (a[3] + t * a[6]);
+	a += 9 * (spl->ny - 1);
+	zHi = (a[0] + a[1] + a[2]) + t * ((a[3] + a[4] + a[5]) + t * (a[6] + a[7] + a[8]));
+	a -= 9 * (spl->ny - 1);
+	bUp = zHi > zLo;
+	dblTol = SBTL_TOL * (fabs(zLo) + fabs(zHi));
+	if (!(bUp ? ((z >= zLo - dblTol) && (z <= zHi + dblTol)) : ((z <= zLo + dblTol) && (z >= zHi - dblTol)))) return NAN;
+	if ((z < zLo) == bUp) z = zLo;
+	if ((z > zHi) == bUp) z = zHi;
+
+	while (lHi - lLo > 1) {  // the cell whose lower edge is the last on the near side of z
+		lMid = (lLo + lHi) / 2;
+		zMid = a[9 * lMid] + t * (a[9 * lMid + 3] + t * a[9 * lMid + 6]);
+		if ((zMid <= z) == bUp) lLo = lMid;
+		else lHi = lMid;
+	}
+	a += 9 * lLo;
+	return (lLo + sbtlQuadRoot(a[2] + t * (a[5] + t * a[8]), a[1] + t * (a[4] + t * a[7]),
+						a[0] + t * (a[3] + t * a[6]) - z)) / spl->ny;
+}
+
+
+
+// ******  Domains   *******
+
+double sbtlX(const typIF97SbtlDomain *dom, double z){
+	if (dom->bSqrt) return sqrt(z - dom->z0);
+	return log(z);
+}
+
+
+// h or u at eta in dom at x
+double sbtlY(const typIF97SbtlDomain *dom, double x, double eta){
+	double yLo = sbtlSpline1(&dom->lo, x);
+	return yLo + eta * (sbtlSpline1(&dom->hi, x) - yLo);
+}
+
+
+double sbtlIsobarV(double t_K, void *ctx){
+	return if97_pt_v(((typSbtlSolveCtx *) ctx)->dblConst, t_K);
+}
+
+
+double sbtlSatV(double t_K, void *ctx){
+	typSteamState state;
+
+	sat_props(if97_r4_ps(t_K), t_K, ((typSbtlSolveCtx *) ctx)->bVapour, IF97_MASK_V, &state);
+	return 1.0 / state.rho_kgperM3;
+}
+
+
+// u at fixed density.  At the edges of the domain it is from the edge state, which may be 
+// just outside the range of if97_rhot_u by rounding
+double sbtlIsochoreU(double t_K, void *ctx){
+	typSbtlSolveCtx *c = ctx;
+
+	if (t_K <= c->dblEdgeT[0]) return c->dblEdgeY[0];
+	if (t_K >= c->dblEdgeT[1]) return c->dblEdgeY[1];
+	return if97_rhot_u(c->dblConst, t_K);
+}
+
+
+// temperature at which f is z, to within dblTol, between t1_K and t2_K, or either if f is z there.
+// Where f jumps across z, as v and u do between regions 2 and 3 on the B23 line by the
+// inconsistency of their equations, the edge of the jump, if it is no more than dblJump.
+// NAN if it is not found
+double sbtlSolveT(typSolvFunc f, typSbtlSolveCtx *ctx, double z, double dblTol, double dblJump, double t1_K, double t2_K){
+	typSolvBounds bounds = {t1_K, t2_K};
+	typSolvResult slvResult;
+
+	if (f(t1_K, ctx) == z) return t1_K;
+	if (f(t2_K, ctx) == z) return t2_K;
+	slvResult = ctx_solv(f, NULL, ctx, z, t1_K, 0.05, &bounds, dblTol, SLV_ABS, SBTL_SOLVE_MAX);
+	if ((slvResult.iErrCode == SOLVE_CONVERGE)
+			|| ((slvResult.iErrCode == SOLVE_NO_CONVERGE) && (fabs(f(slvResult.dSolution, ctx) - z) <= dblJump)))
+		return slvResult.dSolution;
+	return NAN;
+}
+
+
+// saturated liquid or steam at t_K.  false if the density found is on the wrong side of the critical density
+bool sbtlSatState(double t_K, bool bVapour, typSteamState *state){
+	if97_clear_state(state);
+	state->p_MPa = if97_r4_ps(t_K);
+	state->t_K = t_K;
+	sat_props(state->p_MPa, t_K, bVapour, SBTL_MASK, state);
+	state->iRegion = 4;
+	return bVapour ? (state->rho_kgperM3 < IF97_RHOC) : (state->rho_kgperM3 > IF97_RHOC);
+}
+
+
+// the state on edge at z, the pressure (p,h) or specific volume (v,u).  false if it cannot be found
+bool sbtlEdgeState(int iPair, const typSbtlEdge *edge, double z, typSteamState *state){
+	typSbtlSolveCtx ctx;
+	double t_K;
+
+	if (iPair == SBTL_PAIR_PH) {
+		if (edge->iKind == SBTL_ISOTHERM) *state = if97_pt_state_mask(z, edge->dblValue, SBTL_MASK);
+		else if (!sbtlSatState(if97_r4_ts(z), edge->iKind == SBTL_SAT_VAP, state)) return false;
+		return (state->iRegion != 0);
+	}
+
+	switch (edge->iKind) {
+	case SBTL_ISOTHERM :
+		*state = if97_vt_state_mask(z, edge->dblValue, SBTL_MASK);
+		if (state->iRegion == 0)  // at a corner with the 100 MPa isobar, by rounding
+			*state = if97_pt_state_mask(IF97_R1_UPRESS, edge->dblValue, SBTL_MASK);
+		else if (state->iRegion == 4)  // on the saturation line itself, by rounding
+			return sbtlSatState(edge->dblValue, state->qual_pct > 50.0, state);
+		return (state->iRegion != 0);
+	case SBTL_ISOBAR :
+		ctx.dblConst = edge->dblValue;
+		t_K = sbtlSolveT(sbtlIsobarV, &ctx, z, SBTL_V_TOL * z, SBTL_V_JUMP * z, IF97_SBTL_TVMAX, IF97_R2_UTEMP);
+		if (!isfinite(t_K)) return false;
+		*state = if97_vt_state_mask(z, t_K, SBTL_MASK);  // at z itself
+		if (state->iRegion == 0)  // above the 100 MPa isobar, by rounding
+			*state = if97_pt_state_mask(edge->dblValue, t_K, SBTL_MASK);
+		return (state->iRegion != 0);
+	case SBTL_WET_ISOTHERM :  // or at its ends the saturated liquid or steam, by rounding
+		*state = if97_vt_state_mask(z, edge->dblValue, SBTL_MASK);
+		return (state->iRegion != 0);
+	default :
+		ctx.bVapour = (edge->iKind == SBTL_SAT_VAP);
+		t_K = sbtlSolveT(sbtlSatV, &ctx, z, SBTL_V_TOL * z, 0.0, ctx.bVapour ? IF97_T_TRIP : IF97_SBTL_TVMAX, if97_r4_ts(IF97_SBTL_PSAT));
+		if (!isfinite(t_K)) return false;
+		return sbtlSatState(t_K, ctx.bVapour, state);
+	}
+}
+
+
+// the properties tabulated in a domain of iPair, from state
+void sbtlStateProps(int iPair, bool bLinear, const typSteamState *state, double *val){
+	val[IF97_SBTL_T] = state->t_K;
+	if (iPair == SBTL_PAIR_PH) val[IF97_SBTL_LNZ] = bLinear ? 1.0 / state->rho_kgperM3 : -log(state->rho_kgperM3);
+	else val[IF97_SBTL_LNZ] = bLinear ? state->p_MPa : log(state->p_MPa);
+	val[IF97_SBTL_S] = state->s_kJperkgK;
+	val[IF97_SBTL_W] = state->Vs_MperSec;
+}
+
+
+// the properties at the ny + 2 nodes across a domain at z, into f[iProp][i][j].  false if any could not be found
+bool sbtlNodeColumn(const typSbtlSpec *spec, bool bLinear, double z, int ny, double *f, long lStride, double *yLo, double *yHi){
+	typSteamState lo, hi, state;
+	typSbtlSolveCtx ctx;
+	double val[IF97_SBTL_NPROPS], y, t_K;
+	int j, k;
+	bool bDegenerate, bWet = (spec->lo.iKind == SBTL_WET_ISOTHERM);
+
+	if (!sbtlEdgeState(spec->iPair, &spec->lo, z, &lo) || !sbtlEdgeState(spec->iPair, &spec->hi, z, &hi)) return false;
+	*yLo = (spec->iPair == SBTL_PAIR_PH) ? lo.h_kJperkg : lo.u_kJperkg;
+	*yHi = (spec->iPair == SBTL_PAIR_PH) ? hi.h_kJperkg : hi.u_kJperkg;
+	bDegenerate = (fabs(hi.t_K - lo.t_K) <= SBTL_TOL * hi.t_K);  // the edges meet at a corner
+
+	for (j = 0; j < ny + 2; j++) {
+		if ((j == 0) || bDegenerate) state = lo;
+		else if (j == ny + 1) state = hi;
+		else {
+			y = *yLo + (*yHi - *yLo) * (j - 0.5) / ny;
+			if (spec->iPair == SBTL_PAIR_PH) state = if97_ph_state_mask(z, y, SBTL_MASK);
+			else {
+				ctx.dblConst = 1.0 / z;
+				ctx.dblEdgeT[0] = lo.t_K;
+				ctx.dblEdgeT[1] = hi.t_K;
+				ctx.dblEdgeY[0] = *yLo;
+				ctx.dblEdgeY[1] = *yHi;
+				t_K = sbtlSolveT(sbtlIsochoreU, &ctx, y, SBTL_TOL * (fabs(y) + 1000.0), SBTL_U_JUMP, lo.t_K, hi.t_K);
+				if (!isfinite(t_K)) return false;
+				state = if97_vt_state_mask(z, t_K, SBTL_MASK);
+			}
+			if ((state.iRegion == 0) || ((state.iRegion == 4) != bWet)) return false;
+		}
+		sbtlStateProps(spec->iPair, bLinear, &state, val);
+		for (k = 0; k < IF97_SBTL_NPROPS; k++) f[k * lStride + j] = val[k];
+	}
+	return true;
+}
+
+
+int sbtlDomainInit(typIF97SbtlDomain *dom, const typSbtlSpec *spec, int nx, int ny, double z0, double z1, bool bSqrt, bool bLinear){
+	long lStride = (long) (nx + 2) * (ny + 2);
+	double *f = malloc(IF97_SBTL_NPROPS * lStride * sizeof(double));
+	double *yLo = malloc((nx + 2) * sizeof(double));
+	double *yHi = malloc((nx + 2) * sizeof(double));
+	double x0, x1, x, z;
+	int i, k, iFail = 0;
+
+	dom->z0 = z0;
+	dom->z1 = z1;
+	dom->bSqrt = bSqrt;
+	dom->bLinear = bLinear;
+	x0 = sbtlX(dom, z0);
+	x1 = sbtlX(dom, z1);
+	if ((f == NULL) || (yLo == NULL) || (yHi == NULL)) iFail = SOLVE_NO_MEMORY;
+	else {
+		#pragma omp parallel for private(x, z) reduction(|:iFail)  // the nodes are independent
+		for (i = 0; i < nx + 2; i++) {
+			x = sbtlNode(i, nx, x0, x1);
+			if (i == 0) z = z0;  // the edges exactly, not as rounded through x
+			else if (i == nx + 1) z = z1;
+			else z = bSqrt ? z0 + x * x : exp(x);
+			if (!sbtlNodeColumn(spec, bLinear, z, ny, f + i * (ny + 2), lStride, yLo + i, yHi + i)) iFail = SOLVE_NO_CONVERGE;
+		}
+	}
+
+	if (iFail == 0) {
+		if (!sbtlSpline1Init(&dom->lo, nx, x0, x1, yLo) || !sbtlSpline1Init(&dom->hi, nx, x0, x1, yHi)) iFail = SOLVE_NO_MEMORY;
+		for (k = 0; (k < IF97_SBTL_NPROPS) && (iFail == 0); k++)
+			if (!sbtlSpline2Init(&dom->prop[k], nx, ny, x0, x1, f + k * lStride)) iFail = SOLVE_NO_MEMORY;
+	}
+	free(f);
+	free(yLo);
+	free(yHi);
+	return iFail;
+}
+
+
+void sbtlDomainClear(typIF97SbtlDomain *dom){
+	int k;
+
+	dom->lo.a = dom->hi.a = NULL;
+	for (k = 0; k < IF97_SBTL_NPROPS; k++) dom->prop[k].a = NULL;
+}
+
+
+void sbtlDomainFree(typIF97SbtlDomain *dom){
+	int k;
+
+	free(dom->lo.a);
+	free(dom->hi.a);
+	dom->lo.a = dom->hi.a = NULL;
+	for (k = 0; k < IF97_SBTL_NPROPS; k++) {
+		free(dom->prop[k].a);
+		dom->prop[k].a = NULL;
+	}
+}
+
+
+
+// ******  Look-up   *******
+
+// domain of tab->ph holding (p,h), with its x and eta, or SBTL_TWO_PHASE with the dryness fraction
+// in eta, or SBTL_EXACT if it is outside the tables
+int sbtlPhLocate(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg, double *x, double *eta){
+	double hLiq, hVap, hLo;
+	int iDom;
+
+	if (!((p_MPa >= SBTL_P_TRIP) && (p_MPa <= IF97_R1_UPRESS)) || !isfinite(h_kJperkg)) return SBTL_EXACT;
+	*x = log(p_MPa);
+	if (p_MPa <= IF97_SBTL_PSAT) {
+		hLiq = sbtlSpline1(&tab->ph[0].hi, *x);
+		if (h_kJperkg <= hLiq) iDom = 0;
+		else {
+			hVap = sbtlSpline1(&tab->ph[1].lo, *x);
+			if (h_kJperkg < hVap) {
+				*eta = (h_kJperkg - hLiq) / (hVap - hLiq);
+				return SBTL_TWO_PHASE;
+			}
+			iDom = 1;
+		}
+	}
+	else if (p_MPa >= IF97_SBTL_PSUPER) iDom = 2;
+	else return SBTL_EXACT;
+
+	hLo = sbtlSpline1(&tab->ph[iDom].lo, *x);
+	*eta = (h_kJperkg - hLo) / (sbtlSpline1(&tab->ph[iDom].hi, *x) - hLo);
+	if (!((*eta >= 0.0) && (*eta <= 1.0))) return SBTL_EXACT;
+	return iDom;
+}
+
+
+// property iProp of saturated liquid (bVapour false) or steam, from the (p,h) tables at x = ln p
+double sbtlPhSat(const typIF97Sbtl *tab, int iProp, double x, bool bVapour){
+	if (bVapour) return sbtlSpline2(&tab->ph[1].prop[iProp], x, 0.0);
+	return sbtlSpline2(&tab->ph[0].prop[iProp], x, 1.0);
+}
+
+
+// single phase domain of tab->vu between whose edges v lies, with its x.  SBTL_EXACT if there is none
+int sbtlVuDomain(const typIF97Sbtl *tab, double v_m3perkg, double *x){
+	int iDom;
+
+	if (!(v_m3perkg >= tab->vu[0].z0)) return SBTL_EXACT;
+	for (iDom = 0; iDom <= SBTL_VU_G2; iDom++) {
+		if (v_m3perkg <= tab->vu[iDom].z1) {
+			*x = sbtlX(&tab->vu[iDom], v_m3perkg);
+			return iDom;
+		}
+	}
+	return SBTL_EXACT;
+}
+
+
+// two phase domain of tab->vu below (at lower u than) the single phase domain iDom, if it holds v,
+// with its x.  SBTL_EXACT if there is none
+int sbtlVuWet(const typIF97Sbtl *tab, int iDom, double v_m3perkg, double *x){
+	int iWet;
+
+	switch (iDom) {
+	case SBTL_VU_L2 :
+		iWet = SBTL_VU_W1;
+		break;
+	case SBTL_VU_C1 :
+	case SBTL_VU_C2 :
+		iWet = SBTL_VU_W2;
+		break;
+	case SBTL_VU_G1 :
+		iWet = SBTL_VU_W3;
+		break;
+	default :
+		return SBTL_EXACT;
+	}
+	if (!((v_m3perkg >= tab->vu[iWet].z0) && (v_m3perkg <= tab->vu[iWet].z1))) return SBTL_EXACT;  // the liquid denser than at the triple point
+	*x = sbtlX(&tab->vu[iWet], v_m3perkg);
+	return iWet;
+}
+
+
+// eta of u in domain iDom of tab->vu at x
+double sbtlVuEta(const typIF97Sbtl *tab, int iDom, double x, double u_kJperkg){
+	double uLo = sbtlSpline1(&tab->vu[iDom].lo, x);
+	return (u_kJperkg - uLo) / (sbtlSpline1(&tab->vu[iDom].hi, x) - uLo);
+}
+
+
+// domain of tab->vu holding (v,u), single or two phase, with its x and eta, or SBTL_EXACT if it is outside the tables
+int sbtlVuLocate(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg, double *x, double *eta){
+	int iDom;
+
+	if (!isfinite(u_kJperkg)) return SBTL_EXACT;
+	iDom = sbtlVuDomain(tab, v_m3perkg, x);
+	if (iDom == SBTL_EXACT) return SBTL_EXACT;
+	*eta = sbtlVuEta(tab, iDom, *x, u_kJperkg);
+	if ((*eta >= 0.0) && (*eta <= 1.0)) return iDom;
+
+	if (*eta < 0.0) {
+		iDom = sbtlVuWet(tab, iDom, v_m3perkg, x);
+		if (iDom == SBTL_EXACT) return SBTL_EXACT;
+		*eta = sbtlVuEta(tab, iDom, *x, u_kJperkg);
+		if ((*eta >= 0.0) && (*eta <= 1.0)) return iDom;
+	}
+	return SBTL_EXACT;
+}
+
+
+// property iProp of the state (v,u) from if97_flash, with p for IF97_SBTL_LNZ
+double sbtlVuExact(double v_m3perkg, double u_kJperkg, int iProp){
+	typSteamState state;
+
+	if (if97_flash(IF97_PAIR_UV, u_kJperkg, v_m3perkg, (iProp == IF97_SBTL_S) ? IF97_MASK_S : IF97_MASK_W, &state) != SOLVE_CONVERGE)
+		return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	switch (iProp) {
+	case IF97_SBTL_T :
+		return state.t_K;
+	case IF97_SBTL_LNZ :
+		return state.p_MPa;
+	case IF97_SBTL_S :
+		return state.s_kJperkgK;
+	}
+	if (state.iRegion == 4) return IF97_STATS_ERROR(-9999.0);  // not applicable
+	return state.Vs_MperSec;
+}
+
+
+
+// ******  External   *******
+
+int if97_sbtl_init(typIF97Sbtl *tab, int nx, int ny){
+	const typSbtlSpec phSpec[IF97_SBTL_PH_DOMAINS] = {
+		{SBTL_PAIR_PH, {SBTL_ISOTHERM, IF97_R1_LTEMP}, {SBTL_SAT_LIQ, 0.0}},
+		{SBTL_PAIR_PH, {SBTL_SAT_VAP, 0.0}, {SBTL_ISOTHERM, IF97_R2_UTEMP}},
+		{SBTL_PAIR_PH, {SBTL_ISOTHERM, IF97_R1_LTEMP}, {SBTL_ISOTHERM, IF97_R2_UTEMP}},
+	};
+	double ts_K = if97_r4_ts(IF97_SBTL_PSAT);
+	const typSbtlSpec vuSpec[IF97_SBTL_VU_DOMAINS] = {
+		{SBTL_PAIR_VU, {SBTL_ISOTHERM, IF97_SBTL_TVMAX}, {SBTL_ISOBAR, IF97_R1_UPRESS}},
+		{SBTL_PAIR_VU, {SBTL_SAT_LIQ, 0.0}, {SBTL_ISOBAR, IF97_R1_UPRESS}},
+		{SBTL_PAIR_VU, {SBTL_ISOBAR, IF97_SBTL_PSUPER}, {SBTL_ISOBAR, IF97_R1_UPRESS}},
+		{SBTL_PAIR_VU, {SBTL_ISOBAR, IF97_SBTL_PSUPER}, {SBTL_ISOTHERM, IF97_R2_UTEMP}},
+		{SBTL_PAIR_VU, {SBTL_SAT_VAP, 0.0}, {SBTL_ISOTHERM, IF97_R2_UTEMP}},
+		{SBTL_PAIR_VU, {SBTL_ISOTHERM, IF97_T_TRIP}, {SBTL_ISOTHERM, IF97_R2_UTEMP}},
+		{SBTL_PAIR_VU, {SBTL_WET_ISOTHERM, IF97_T_TRIP}, {SBTL_SAT_LIQ, 0.0}},
+		{SBTL_PAIR_VU, {SBTL_WET_ISOTHERM, IF97_T_TRIP}, {SBTL_WET_ISOTHERM, ts_K}},
+		{SBTL_PAIR_VU, {SBTL_WET_ISOTHERM, IF97_T_TRIP}, {SBTL_SAT_VAP, 0.0}},
+	};
+	typSbtlSolveCtx ctx;
+	double vEdge[SBTL_VU_W1 + 1], vWet[4];
+	int i, iErr;
+
+	tab->nx = nx;
+	tab->ny = ny;
+	for (i = 0; i < IF97_SBTL_PH_DOMAINS; i++) sbtlDomainClear(&tab->ph[i]);
+	for (i = 0; i < IF97_SBTL_VU_DOMAINS; i++) sbtlDomainClear(&tab->vu[i]);
+	if ((nx < 1) || (ny < 1)) return SOLVE_NO_CONVERGE;
+
+	// specific volumes at the edges of the (v,u) domains.  The first is just inside the 100 MPa
+	// isobar, so that the corner node is within range of if97_vt_state
+	vEdge[0] = if97_pt_v(IF97_R1_UPRESS, IF97_SBTL_TVMAX) * (1.0 + 1e-9);
+	ctx.bVapour = false;
+	vEdge[1] = sbtlSatV(IF97_SBTL_TVMAX, &ctx);
+	vEdge[2] = sbtlSatV(ts_K, &ctx);
+	vEdge[3] = if97_pt_v(IF97_R1_UPRESS, IF97_R2_UTEMP);
+	ctx.bVapour = true;
+	vEdge[4] = sbtlSatV(ts_K, &ctx);
+	vEdge[5] = sbtlSatV(IF97_T_TRIP, &ctx);
+	vEdge[6] = if97_pt_v(SBTL_P_TRIP, IF97_R2_UTEMP);
+	// and of the two phase domains.  The saturated liquid is densest at IF97_SBTL_TVMAX, so that
+	// below it, between the saturated liquid at the triple point and its density maximum, are
+	// liquid and two phase states at the same v.  These are left outside the tables
+	ctx.bVapour = false;
+	vWet[0] = sbtlSatV(IF97_T_TRIP, &ctx);
+	vWet[1] = vEdge[2];
+	vWet[2] = vEdge[4];
+	vWet[3] = vEdge[5];
+
+	iErr = sbtlDomainInit(&tab->ph[0], &phSpec[0], nx, ny, SBTL_P_TRIP, IF97_SBTL_PSAT, false, false);
+	if (iErr == 0) iErr = sbtlDomainInit(&tab->ph[1], &phSpec[1], nx, ny, SBTL_P_TRIP, IF97_SBTL_PSAT, false, false);
+	if (iErr == 0) iErr = sbtlDomainInit(&tab->ph[2], &phSpec[2], nx, ny, IF97_SBTL_PSUPER, IF97_R1_UPRESS, false, false);
+	for (i = 0; (i <= SBTL_VU_G2) && (iErr == 0); i++)  // p is near linear in the liquid, where it falls to the saturation pressure
+		iErr = sbtlDomainInit(&tab->vu[i], &vuSpec[i], nx, ny, vEdge[i], vEdge[i + 1], i == SBTL_VU_L2, i <= SBTL_VU_L2);
+	for (i = SBTL_VU_W1; (i <= SBTL_VU_W3) && (iErr == 0); i++)
+		iErr = sbtlDomainInit(&tab->vu[i], &vuSpec[i], nx, ny, vWet[i - SBTL_VU_W1], vWet[i - SBTL_VU_W1 + 1], false, false);
+
+	if (iErr != 0) if97_sbtl_free(tab);
+	return iErr;
+}
+
+
+void if97_sbtl_free(typIF97Sbtl *tab){
+	int i;
+
+	for (i = 0; i < IF97_SBTL_PH_DOMAINS; i++) sbtlDomainFree(&tab->ph[i]);
+	for (i = 0; i < IF97_SBTL_VU_DOMAINS; i++) sbtlDomainFree(&tab->vu[i]);
+}
+
+
+
+double if97_sbtl_ph_t(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg){
+	double x, eta;
+	int iDom = sbtlPhLocate(tab, p_MPa, h_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return if97_ph_t(p_MPa, h_kJperkg);
+	if (iDom == SBTL_TWO_PHASE) return if97_r4_ts(p_MPa);
+	return sbtlSpline2(&tab->ph[iDom].prop[IF97_SBTL_T], x, eta);
+}
+
+
+double if97_sbtl_ph_v(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg){
+	double x, eta, vLiq;
+	int iDom = sbtlPhLocate(tab, p_MPa, h_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return if97_ph_v(p_MPa, h_kJperkg);
+	if (iDom == SBTL_TWO_PHASE) {
+		vLiq = exp(sbtlPhSat(tab, IF97_SBTL_LNZ, x, false));
+		return vLiq + eta * (exp(sbtlPhSat(tab, IF97_SBTL_LNZ, x, true)) - vLiq);
+	}
+	return exp(sbtlSpline2(&tab->ph[iDom].prop[IF97_SBTL_LNZ], x, eta));
+}
+
+
+double if97_sbtl_ph_s(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg){
+	double x, eta, sLiq;
+	int iDom = sbtlPhLocate(tab, p_MPa, h_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return if97_ph_s(p_MPa, h_kJperkg);
+	if (iDom == SBTL_TWO_PHASE) {
+		sLiq = sbtlPhSat(tab, IF97_SBTL_S, x, false);
+		return sLiq + eta * (sbtlPhSat(tab, IF97_SBTL_S, x, true) - sLiq);
+	}
+	return sbtlSpline2(&tab->ph[iDom].prop[IF97_SBTL_S], x, eta);
+}
+
+
+double if97_sbtl_ph_w(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg){
+	double x, eta;
+	int iDom = sbtlPhLocate(tab, p_MPa, h_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return if97_ph_Vs(p_MPa, h_kJperkg);
+	if (iDom == SBTL_TWO_PHASE) return IF97_STATS_ERROR(-9999.0);  // not applicable
+	return sbtlSpline2(&tab->ph[iDom].prop[IF97_SBTL_W], x, eta);
+}
+
+
+double if97_sbtl_pt_h(const typIF97Sbtl *tab, double p_MPa, double t_K){
+	double x, eta;
+	int iDom;
+
+	if (!((p_MPa >= SBTL_P_TRIP) && (p_MPa <= IF97_R1_UPRESS))) return if97_pt_h(p_MPa, t_K);
+	if (p_MPa <= IF97_SBTL_PSAT) iDom = (t_K <= if97_r4_ts(p_MPa)) ? 0 : 1;
+	else if (p_MPa >= IF97_SBTL_PSUPER) iDom = 2;
+	else return if97_pt_h(p_MPa, t_K);
+
+	x = log(p_MPa);
+	eta = sbtlSpline2Eta(&tab->ph[iDom].prop[IF97_SBTL_T], x, t_K);
+	if (isnan(eta)) return if97_pt_h(p_MPa, t_K);
+	return sbtlY(&tab->ph[iDom], x, eta);
+}
+
+
+double if97_sbtl_ps_h(const typIF97Sbtl *tab, double p_MPa, double s_kJperkgK){
+	double x, eta, sLiq, sVap, hLiq;
+	int iDom;
+
+	if (!((p_MPa >= SBTL_P_TRIP) && (p_MPa <= IF97_R1_UPRESS))) return if97_ps_h(p_MPa, s_kJperkgK);
+	x = log(p_MPa);
+	if (p_MPa <= IF97_SBTL_PSAT) {
+		sLiq = sbtlPhSat(tab, IF97_SBTL_S, x, false);
+		sVap = sbtlPhSat(tab, IF97_SBTL_S, x, true);
+		if (s_kJperkgK <= sLiq) iDom = 0;
+		else if (s_kJperkgK >= sVap) iDom = 1;
+		else {  // two phase
+			hLiq = sbtlSpline1(&tab->ph[0].hi, x);
+			return hLiq + (s_kJperkgK - sLiq) / (sVap - sLiq) * (sbtlSpline1(&tab->ph[1].lo, x) - hLiq);
+		}
+	}
+	else if (p_MPa >= IF97_SBTL_PSUPER) iDom = 2;
+	else return if97_ps_h(p_MPa, s_kJperkgK);
+
+	eta = sbtlSpline2Eta(&tab->ph[iDom].prop[IF97_SBTL_S], x, s_kJperkgK);
+	if (isnan(eta)) return if97_ps_h(p_MPa, s_kJperkgK);
+	return sbtlY(&tab->ph[iDom], x, eta);
+}
+
+
+
+double if97_sbtl_vu_p(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg){
+	double x, eta;
+	int iDom = sbtlVuLocate(tab, v_m3perkg, u_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return sbtlVuExact(v_m3perkg, u_kJperkg, IF97_SBTL_LNZ);
+	if (tab->vu[iDom].bLinear) return sbtlSpline2(&tab->vu[iDom].prop[IF97_SBTL_LNZ], x, eta);
+	return exp(sbtlSpline2(&tab->vu[iDom].prop[IF97_SBTL_LNZ], x, eta));
+}
+
+
+double if97_sbtl_vu_t(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg){
+	double x, eta;
+	int iDom = sbtlVuLocate(tab, v_m3perkg, u_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return sbtlVuExact(v_m3perkg, u_kJperkg, IF97_SBTL_T);
+	return sbtlSpline2(&tab->vu[iDom].prop[IF97_SBTL_T], x, eta);
+}
+
+
+double if97_sbtl_vu_s(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg){
+	double x, eta;
+	int iDom = sbtlVuLocate(tab, v_m3perkg, u_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return sbtlVuExact(v_m3perkg, u_kJperkg, IF97_SBTL_S);
+	return sbtlSpline2(&tab->vu[iDom].prop[IF97_SBTL_S], x, eta);
+}
+
+
+double if97_sbtl_vu_w(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg){
+	double x, eta;
+	int iDom = sbtlVuLocate(tab, v_m3perkg, u_kJperkg, &x, &eta);
+
+	if (iDom == SBTL_EXACT) return sbtlVuExact(v_m3perkg, u_kJperkg, IF97_SBTL_W);
+	if (iDom >= SBTL_VU_W1) return IF97_STATS_ERROR(-9999.0);  // two phase, not applicable
+	return sbtlSpline2(&tab->vu[iDom].prop[IF97_SBTL_W], x, eta);
+}
+
+
+bool if97_sbtl_vu_in_tables(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg){
+	double x, eta;
+
+	return sbtlVuLocate(tab, v_m3perkg, u_kJperkg, &x, &eta) != SBTL_EXACT;
+}
+
+
+double if97_sbtl_vt_u(const typIF97Sbtl *tab, double v_m3perkg, double t_K){
+	double x, eta;
+	int iDom = sbtlVuDomain(tab, v_m3perkg, &x);
+
+	if (iDom != SBTL_EXACT) {
+		eta = sbtlSpline2Eta(&tab->vu[iDom].prop[IF97_SBTL_T], x, t_K);
+		if (!isnan(eta)) return sbtlY(&tab->vu[iDom], x, eta);
+		iDom = sbtlVuWet(tab, iDom, v_m3perkg, &x);
+		if (iDom != SBTL_EXACT) {
+			eta = sbtlSpline2Eta(&tab->vu[iDom].prop[IF97_SBTL_T], x, t_K);
+			if (!isnan(eta)) return sbtlY(&tab->vu[iDom], x, eta);
+		}
+	}
+	return if97_rhot_u(1.0 / v_m3perkg, t_K);
+}
+
+
+double if97_sbtl_vp_u(const typIF97Sbtl *tab, double v_m3perkg, double p_MPa){
+	typSteamState state;
+	double x, eta, z;
+	int iDom = sbtlVuDomain(tab, v_m3perkg, &x);
+
+	if ((iDom != SBTL_EXACT) && (p_MPa > 0.0)) {
+		z = tab->vu[iDom].bLinear ? p_MPa : log(p_MPa);
+		eta = sbtlSpline2Eta(&tab->vu[iDom].prop[IF97_SBTL_LNZ], x, z);
+		if (!isnan(eta)) return sbtlY(&tab->vu[iDom], x, eta);
+		iDom = sbtlVuWet(tab, iDom, v_m3perkg, &x);
+		if (iDom != SBTL_EXACT) {
+			eta = sbtlSpline2Eta(&tab->vu[iDom].prop[IF97_SBTL_LNZ], x, log(p_MPa));
+			if (!isnan(eta)) return sbtlY(&tab->vu[iDom], x, eta);
+		}
+	}
+	if (if97_flash(IF97_PAIR_PV, p_MPa, v_m3perkg, IF97_MASK_U, &state) != SOLVE_CONVERGE) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.u_kJperkg;
+}
@@ -0,0 +1,192 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Spline based table look-up for (p,h) and (v,u) inputs
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_sbtl.h
+ * @author Martin Lord
+ * @brief T, v, s and w from (p,h), and p, T, s and w from (v,u), by spline based table look-up
+ * @details
+ * After the IAPWS Guideline on the Spline-Based Table Look-up Method (SBTL).  The
+ * tables are built once, by if97_sbtl_init, from the IF97 equations, and a look-up
+ * is then a cell index and a biquadratic polynomial, with no iteration.  \n
+ *
+ * Each table is split into domains, bounded by two pressures (p,h) or specific volumes
+ * (v,u) and by two curves between them: an isotherm, an isobar or the saturation line.
+ * Within a domain the coordinates are transformed to x = ln p (or ln v) and
+ * eta = (h - h_lo(x)) / (h_hi(x) - h_lo(x)) (or the same in u), which runs from 0 to 1 across
+ * the domain, so that the cells of a rectangular grid follow its boundaries, and no
+ * cell crosses the saturation line.  Over each cell every property is a biquadratic in
+ * (x,eta), continuous with its first derivatives across the cells.  The splines are
+ * of ln v and ln p rather than of v and p, except in the liquid (v,u) domains, where p
+ * itself is smoother.  \n
+ *
+ * The (p,h) domains are the liquid and the steam from the triple point pressure to
+ * IF97_SBTL_PSAT, and the fluid from IF97_SBTL_PSUPER to 100 MPa, each from 273.15 K (or
+ * the saturation line) to 1073.15 K.  The (v,u) domains cover the same states, between the
+ * 100 MPa isobar, the 1073.15 K isotherm and the saturation line, from the density
+ * maximum of the saturated liquid (IF97_SBTL_TVMAX) and the triple point to the triple point
+ * pressure at 1073.15 K: two liquid domains, two above the IF97_SBTL_PSUPER isobar about the
+ * critical volume, and two of steam.  Below them three two phase domains run from the triple
+ * point line to the saturated liquid, the two phase IF97_SBTL_PSAT isotherm and the saturated
+ * steam.  Region 5 and the states near the critical point,
+ * (p,h) between IF97_SBTL_PSAT and IF97_SBTL_PSUPER and (v,u) below the IF97_SBTL_PSUPER
+ * isobar between the saturated liquid and steam at IF97_SBTL_PSAT, are outside the tables,
+ * and given by the IF97 equations themselves (if97_ph_state_mask and if97_flash), as is
+ * anything else outside them.  \n
+ *
+ * In the two phase region (p,h) the mixture properties are from the saturated properties in the
+ * tables at the saturation temperature.  The two phase (v,u) domains tabulate the mixture
+ * itself, so that no iteration is needed.  The speed of sound is then -9999.  Liquid within
+ * round off of the saturated liquid at low pressure, whose (v,u) hardly differs from it,
+ * may be taken as saturated.  \n
+ *
+ * The inverse functions, h(p,T), h(p,s), u(v,T) and u(v,p), solve the spline of
+ * the given property for eta, which within a cell is a quadratic, so that they are the exact
+ * inverses of the tables: if97_sbtl_ph_t(p, if97_sbtl_pt_h(p, T)) is T to round off.  \n
+ *
+ * With the default 100 x 50 cells in each domain 99% of states agree with IF97 to within
+ * 5 mK, 1e-5 relative in v, 1e-5 kJ/kg/K in s, 4e-4 MPa in p and 0.04 m/s in w, the worst
+ * being within a few cells of the critical region and the region 1 / 3 boundary.  Doubling
+ * both resolutions cuts the errors about eight fold.  The tables take about 17 MB and
+ * 3 s to build (on several threads, with OpenMP).  if97_lib_test checks the agreement
+ * at sample states.  The tables are read only once built, so may be shared between threads.
+ *
+ * UNITS  p: MPa, T: K, v: m3/kg, h, u: kJ/kg, s: kJ/kg/K, w: m/s
+ *
+ * @see http://www.iapws.org/relguide/SBTL.html
+ */
+
+
+#ifndef IF97_SBTL_H
+#define IF97_SBTL_H
+
+#include <stdbool.h>
+
+
+#define IF97_SBTL_NX 100  // default number of cells along ln p or ln v in each domain
+#define IF97_SBTL_NY 50  // default number of cells across each domain
+#define IF97_SBTL_PSAT 21.0  // MPa  highest pressure of the subcritical (p,h) tables
+#define IF97_SBTL_PSUPER 23.0  // MPa  lowest pressure of the supercritical (p,h) table
+#define IF97_SBTL_TVMAX 277.13  // K  temperature of the densest saturated liquid
+#define IF97_SBTL_PH_DOMAINS 3  // liquid, steam, supercritical
+#define IF97_SBTL_VU_DOMAINS 9  // two liquid, two critical, two steam, three two phase
+
+
+// properties tabulated in each domain.  IF97_SBTL_LNZ is ln v in the (p,h) domains, ln p in the (v,u),
+// except in the liquid, where it is p itself
+enum if97_sbtl_prop_t {
+	IF97_SBTL_T = 0,
+	IF97_SBTL_LNZ = 1,
+	IF97_SBTL_S = 2,
+	IF97_SBTL_W = 3,
+	IF97_SBTL_NPROPS = 4,
+};
+
+
+/** quadratic spline of one variable, continuous with its first derivative, over n cells of width 1/dblRdx from x0 */
+typedef struct sctIF97Spline1 {
+	int n;
+	double x0;
+	double dblRdx;
+	double *a;  // a[3 k + i] is the coefficient of t^i in cell k, t running from 0 to 1 across it
+} typIF97Spline1;
+
+
+/** biquadratic spline of x and eta, over nx cells of width 1/dblRdx from x0, and ny cells of eta from 0 to 1 */
+typedef struct sctIF97Spline2 {
+	int nx;
+	int ny;
+	double x0;
+	double dblRdx;
+	double *a;  // a[9 (k ny + l) + 3 i + j] is the coefficient of t^i u^j in cell (k,l), t and u running from 0 to 1 across it
+} typIF97Spline2;
+
+
+/** one domain of a table */
+typedef struct sctIF97SbtlDomain {
+	double z0;  // p or v at the first edge
+	double z1;  // p or v at the second edge
+	bool bSqrt;  // x is sqrt(z - z0) rather than ln z
+	bool bLinear;  // the IF97_SBTL_LNZ spline is of p or v itself rather than its log
+	typIF97Spline1 lo;  // h or u at eta = 0, as a function of x
+	typIF97Spline1 hi;  // h or u at eta = 1
+	typIF97Spline2 prop[IF97_SBTL_NPROPS];  // the properties as functions of (x,eta)
+} typIF97SbtlDomain;
+
+
+/** the (p,h) and (v,u) tables */
+typedef struct sctIF97Sbtl {
+	int nx;
+	int ny;
+	typIF97SbtlDomain ph[IF97_SBTL_PH_DOMAINS];
+	typIF97SbtlDomain vu[IF97_SBTL_VU_DOMAINS];
+} typIF97Sbtl;
+
+
+/** builds the tables in tab, with nx by ny cells in each domain (IF97_SBTL_NX and IF97_SBTL_NY
+ * by default).  Returns SOLVE_CONVERGE (0) if they were built, SOLVE_NO_MEMORY if they could not be
+ * allocated, or SOLVE_NO_CONVERGE if a node could not be found.  Unless built, tab holds no memory */
+int if97_sbtl_init(typIF97Sbtl *tab, int nx, int ny);
+
+/** frees the tables of tab */
+void if97_sbtl_free(typIF97Sbtl *tab);
+
+
+/** temperature (K) for a given p_MPa and h_kJperkg.  As if97_ph_t outside the tables */
+double if97_sbtl_ph_t(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg);
+
+/** specific volume (m3/kg) for a given p_MPa and h_kJperkg.  As if97_ph_v outside the tables */
+double if97_sbtl_ph_v(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg);
+
+/** specific entropy (kJ/kg/K) for a given p_MPa and h_kJperkg.  As if97_ph_s outside the tables */
+double if97_sbtl_ph_s(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg);
+
+/** speed of sound (m/s) for a given p_MPa and h_kJperkg.  -9999 if two phase.  As if97_ph_Vs outside the tables */
+double if97_sbtl_ph_w(const typIF97Sbtl *tab, double p_MPa, double h_kJperkg);
+
+/** specific enthalpy (kJ/kg) for a given p_MPa and t_K, the inverse of if97_sbtl_ph_t.
+ * Saturated liquid at the saturation temperature.  As if97_pt_h outside the tables */
+double if97_sbtl_pt_h(const typIF97Sbtl *tab, double p_MPa, double t_K);
+
+/** specific enthalpy (kJ/kg) for a given p_MPa and s_kJperkgK, the inverse of if97_sbtl_ph_s.
+ * As if97_ps_h outside the tables */
+double if97_sbtl_ps_h(const typIF97Sbtl *tab, double p_MPa, double s_kJperkgK);
+
+
+/** pressure (MPa) for a given v_m3perkg and u_kJperkg.  As if97_flash outside the tables */
+double if97_sbtl_vu_p(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg);
+
+/** temperature (K) for a given v_m3perkg and u_kJperkg.  As if97_flash outside the tables */
+double if97_sbtl_vu_t(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg);
+
+/** specific entropy (kJ/kg/K) for a given v_m3perkg and u_kJperkg.  As if97_flash outside the tables */
+double if97_sbtl_vu_s(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg);
+
+/** speed of sound (m/s) for a given v_m3perkg and u_kJperkg.  -9999 if two phase.  As if97_flash outside the tables */
+double if97_sbtl_vu_w(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg);
+
+/** true if (v,u) is within the tables, false if the if97_sbtl_vu_ functions give it by if97_flash */
+bool if97_sbtl_vu_in_tables(const typIF97Sbtl *tab, double v_m3perkg, double u_kJperkg);
+
+/** specific internal energy (kJ/kg) for a given v_m3perkg and t_K, the inverse of if97_sbtl_vu_t.
+ * As if97_rhot_u outside the tables */
+double if97_sbtl_vt_u(const typIF97Sbtl *tab, double v_m3perkg, double t_K);
+
+/** specific internal energy (kJ/kg) for a given v_m3perkg and p_MPa, the inverse of if97_sbtl_vu_p.
+ * As if97_flash outside the tables */
+double if97_sbtl_vp_u(const typIF97Sbtl *tab, double v_m3perkg, double p_MPa);
+
+
+#endif // IF97_SBTL_H
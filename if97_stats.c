@@ -0,0 +1,160 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Optional counters of where the library spends its calls.  See if97_stats.h
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "if97_stats.h"
+#include "solve.h"
+
+
+#ifdef IF97_STATS
+
+#if defined(_MSC_VER)
+	#define IF97_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+	#define IF97_THREAD_LOCAL __thread
+#else
+	#define IF97_THREAD_LOCAL _Thread_local
+#endif
+
+
+// the counts of one thread, in a list of all threads which have counted
+typedef struct sctIF97StatsBlock {
+	typIF97Stats counts;
+	struct sctIF97StatsBlock *next;
+} typIF97StatsBlock;
+
+
+typIF97StatsBlock *statsBlocks = NULL;
+IF97_THREAD_LOCAL typIF97StatsBlock *localStats = NULL;
+IF97_THREAD_LOCAL typIF97Stats lostStats;  // counted into, but never summed, if a block cannot be made
+
+
+// the counts of this thread, made and added to the list on its first count
+typIF97Stats *if97_stats_local(void){
+	typIF97StatsBlock *block = localStats;
+
+	if (block != NULL) return &block->counts;
+
+	block = calloc(1, sizeof(typIF97StatsBlock));
+	if (block == NULL) return &lostStats;
+	#pragma omp critical (if97_stats)
+	{
+		block->next = statsBlocks;
+		statsBlocks = block;
+	}
+	localStats = block;
+	return &block->counts;
+}
+
+
+int if97_stats_region(int iRegion){
+	if ((iRegion >= 0) && (iRegion <= 5)) if97_stats_local()->lRegion[iRegion]++;
+	return iRegion;
+}
+
+
+void if97_stats_subregion(char cSubregion){
+	if ((cSubregion >= 'a') && (cSubregion <= 'z')) if97_stats_local()->lR3Subregion[cSubregion - 'a']++;
+}
+
+
+void if97_stats_near_critical(void){
+	if97_stats_local()->lNearCritical++;
+}
+
+
+void if97_stats_solve(long lIterations, int iErrCode){
+	typIF97Stats *stats = if97_stats_local();
+
+	stats->lSolveIter[((lIterations >= 0) && (lIterations < IF97_STATS_ITER_BINS)) ? lIterations : IF97_STATS_ITER_BINS - 1]++;
+	if (iErrCode & SOLVE_NO_CONVERGE) stats->lSolveNoConverge++;
+}
+
+
+double if97_stats_error(double dblErr){
+	if (dblErr == -9998.0) if97_stats_local()->lRegionNotValid++;
+	else if (dblErr == -9999.0) if97_stats_local()->lNotApplicable++;
+	return dblErr;
+}
+
+#endif // IF97_STATS
+
+
+
+typIF97Stats if97_stats_snapshot(void){
+	typIF97Stats sum;
+
+	memset(&sum, 0, sizeof(sum));
+#ifdef IF97_STATS
+	#pragma omp critical (if97_stats)
+	{
+		typIF97StatsBlock *block;
+		int i;
+
+		for (block = statsBlocks; block != NULL; block = block->next) {
+			for (i = 0; i < 6; i++) sum.lRegion[i] += block->counts.lRegion[i];
+			for (i = 0; i < 26; i++) sum.lR3Subregion[i] += block->counts.lR3Subregion[i];
+			for (i = 0; i < IF97_STATS_ITER_BINS; i++) sum.lSolveIter[i] += block->counts.lSolveIter[i];
+			sum.lNearCritical += block->counts.lNearCritical;
+			sum.lSolveNoConverge += block->counts.lSolveNoConverge;
+			sum.lRegionNotValid += block->counts.lRegionNotValid;
+			sum.lNotApplicable += block->counts.lNotApplicable;
+			sum.iThreads++;
+		}
+	}
+#endif
+	return sum;
+}
+
+
+void if97_stats_reset(void){
+#ifdef IF97_STATS
+	#pragma omp critical (if97_stats)
+	{
+		typIF97StatsBlock *block;
+
+		for (block = statsBlocks; block != NULL; block = block->next) memset(&block->counts, 0, sizeof(typIF97Stats));
+	}
+#endif
+}
+
+
+void if97_stats_dump(FILE *out){
+#ifndef IF97_STATS
+	fprintf(out, "IF97 statistics are not compiled in.  Define IF97_STATS (./waf configure --stats)\n");
+#else
+	typIF97Stats stats = if97_stats_snapshot();
+	long lSolves = 0;
+	int i;
+
+	fprintf(out, "IF97 statistics (%i threads)\n", stats.iThreads);
+	fprintf(out, "region_pt           R1 %li  R2 %li  R3 %li  R5 %li  out of range %li\n",
+			stats.lRegion[1], stats.lRegion[2], stats.lRegion[3], stats.lRegion[5], stats.lRegion[0]);
+
+	fprintf(out, "region 3 subregions");
+	for (i = 0; i < 26; i++)
+		if (stats.lR3Subregion[i] > 0) fprintf(out, "  3%c %li", 'a' + i, stats.lR3Subregion[i]);
+	fprintf(out, "\n");
+
+	fprintf(out, "near critical       %li\n", stats.lNearCritical);
+
+	for (i = 0; i < IF97_STATS_ITER_BINS; i++) lSolves += stats.lSolveIter[i];
+	fprintf(out, "secant_solv         %li calls, %li not converged\n", lSolves, stats.lSolveNoConverge);
+	for (i = 0; i < IF97_STATS_ITER_BINS; i++)
+		if (stats.lSolveIter[i] > 0)
+			fprintf(out, "    %2i%s iterations  %li\n", i, (i == IF97_STATS_ITER_BINS - 1) ? "+" : " ", stats.lSolveIter[i]);
+
+	fprintf(out, "returned -9998      %li (region not valid)\n", stats.lRegionNotValid);
+	fprintf(out, "returned -9999      %li (not applicable)\n", stats.lNotApplicable);
+#endif
+}
@@ -0,0 +1,95 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Optional counters of where the library spends its calls
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_stats.h
+ * @author Martin Lord
+ * @brief Counters of calls per region, region 3 subregion, solver iterations and errors
+ * @details
+ * Compiled in only if IF97_STATS is defined (./waf configure --stats).  Otherwise
+ * the counting macros below expand to their argument or to nothing, and
+ * if97_stats_snapshot returns zeros.  \n
+ *
+ * Each thread counts into its own block, so counting needs no locks.  The blocks
+ * are summed when a snapshot is taken.  A snapshot taken while other threads are
+ * counting may miss their latest calls. \n
+ *
+ * Counted are: the region found by region_pt, the region 3 subregion whose backwards
+ * equation is used, points in the near critical auxiliary zone (where the backwards
+ * equations are iterated on), secant_solv iterations and failures to converge, and
+ * the -9998 (region not valid) and -9999 (not applicable) returns of if97_lib.c
+ */
+
+
+#ifndef IF97_STATS_H
+#define IF97_STATS_H
+
+#include <stdio.h>
+
+
+#define IF97_STATS_ITER_BINS 16  // secant_solv iterations 0 to 14, then 15 or more
+
+
+typedef struct sctIF97Stats {
+	long lRegion[6];  // region_pt results.  [0] is out of range, [4] is never returned
+	long lR3Subregion[26];  // region 3 backwards equation used, 3a to 3z
+	long lNearCritical;  // points in the auxiliary zone near critical
+	long lSolveIter[IF97_STATS_ITER_BINS];  // secant_solv calls by iterations taken
+	long lSolveNoConverge;  // secant_solv calls ending SOLVE_NO_CONVERGE
+	long lRegionNotValid;  // -9998 returns
+	long lNotApplicable;  // -9999 returns
+	int iThreads;  // threads which have counted (in a snapshot)
+} typIF97Stats;
+
+
+/** the counts of all threads, summed */
+typIF97Stats if97_stats_snapshot(void);
+
+/** zeroes the counts of all threads */
+void if97_stats_reset(void);
+
+/** writes a snapshot as text */
+void if97_stats_dump(FILE *out);
+
+
+
+// ******  Used internally   *******
+
+#ifdef IF97_STATS
+
+	int if97_stats_region(int iRegion);  // returns iRegion
+	void if97_stats_subregion(char cSubregion);
+	void if97_stats_near_critical(void);
+	void if97_stats_solve(long lIterations, int iErrCode);
+	double if97_stats_error(double dblErr);  // returns dblErr
+
+	#define IF97_STATS_REGION(iRegion) if97_stats_region(iRegion)
+	#define IF97_STATS_SUBREGION(cSubregion) if97_stats_subregion(cSubregion)
+	#define IF97_STATS_NEAR_CRITICAL() if97_stats_near_critical()
+	#define IF97_STATS_SOLVE(lIterations, iErrCode) if97_stats_solve(lIterations, iErrCode)
+	#define IF97_STATS_ERROR(dblErr) if97_stats_error(dblErr)
+
+#else
+
+	#define IF97_STATS_REGION(iRegion) (iRegion)
+	#define IF97_STATS_SUBREGION(cSubregion) ((void) 0)
+	#define IF97_STATS_NEAR_CRITICAL() ((void) 0)
+	#define IF97_STATS_SOLVE(lIterations, iErrCode) ((void) 0)
+	#define IF97_STATS_ERROR(dblErr) (dblErr)
+
+#endif // IF97_STATS
+
+
+#endif // IF97_STATS_H
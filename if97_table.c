@@ -0,0 +1,380 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Memory mapped files of the Taylor series (TTSE) tables.  See if97_table.h
+
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "if97_table.h"
+#include "if97_ttse.h"
+#include "IF97_common.h"  // for typIF97Coeffs_IJn and typIF97Coeffs_Jn
+
+
+#define TABLE_ARRAYS 6  // sat, ph.yEdge, ph.side, ph.a, pt.side, pt.a
+#define TABLE_MAX_NODES 1000000  // along any one axis, far beyond any useful table
+#define TABLE_FNV_BASIS 14695981039346656037ULL
+#define TABLE_FNV_PRIME 1099511628211ULL
+#define TABLE_R4_COEFFS 10  // of the saturation line, IF97_R3_n[1] to [10]
+#define TABLE_B23_COEFFS 5
+
+
+// the coefficients of the equations the tables are built from, as the region modules hold them
+extern const typIF97Coeffs_IJn GIBBS_COEFFS_R1[];
+extern const int MAX_GIBBS_COEFFS_R1;
+extern const typIF97Coeffs_Jn GIBBS_COEFFS_R2_O[];
+extern const int MAX_GIBBS_COEFFS_R2_O;
+extern const typIF97Coeffs_IJn GIBBS_COEFFS_R2_R[];
+extern const int MAX_GIBBS_COEFFS_R2_R;
+extern const typIF97Coeffs_IJn PHI_COEFFS_R3[];
+extern const int MAX_COEFFS_PHI_R3;
+extern const double IF97_R3_n[];
+extern const typIF97Coeffs_Jn GIBBS_COEFFS_R5_O[];
+extern const int MAX_GIBBS_COEFFS_R5_O;
+extern const typIF97Coeffs_IJn GIBBS_COEFFS_R5_R[];
+extern const int MAX_GIBBS_COEFFS_R5_R;
+extern const double B23_N[];
+
+
+// the header, as it lies at the start of the file.  Every member is at its natural alignment,
+// so there is no padding between them
+typedef struct sctTableHeader {
+	char strMagic[8];
+	unsigned int lEndian;
+	unsigned int lFormat;
+	char strVersion[16];
+	unsigned int lHeaderBytes;
+	int nP;
+	int nH;
+	int nT;
+	double pLo_MPa;
+	double pHi_MPa;
+	double tLo_K;
+	double tHi_K;
+	int nSat;
+	int iZero;
+	double grid[2][4];  // x0, 1/dx, y0, 1/dy of the (p,h) and the (p,T) grid
+	unsigned long long llOffset[TABLE_ARRAYS];
+	unsigned long long llBytes;
+	unsigned long long llChecksum;
+	unsigned long long llCoeffs;
+	char strZero[32];
+} typTableHeader;
+
+// fails to compile unless the header is IF97_TABLE_HEADER_BYTES long, as it must be on every platform
+typedef char tableHeaderSizeCheck[(sizeof(typTableHeader) == IF97_TABLE_HEADER_BYTES) ? 1 : -1];
+
+
+
+// ******  Layout   *******
+
+// bytes of each array of tables with the envelope and resolution of hdr, in the order of llOffset
+void tableArrayBytes(const typTableHeader *hdr, unsigned long long *llArray){
+	unsigned long long nx = (unsigned long long) hdr->nP, nh = (unsigned long long) hdr->nH, nt = (unsigned long long) hdr->nT;
+	unsigned long long llNode = IF97_TTSE_NPROPS * IF97_TTSE_NTERMS * sizeof(double);
+
+	llArray[0] = nx * IF97_TTSE_SAT_DOUBLES * sizeof(double);
+	llArray[1] = 2 * nx * sizeof(double);
+	llArray[2] = nx * nh;
+	llArray[3] = nx * nh * llNode;
+	llArray[4] = nx * nt;
+	llArray[5] = nx * nt * llNode;
+}
+
+
+unsigned long long tableAlign(unsigned long long llBytes){
+	return (llBytes + IF97_TABLE_ALIGN - 1) / IF97_TABLE_ALIGN * IF97_TABLE_ALIGN;
+}
+
+
+// offsets of the arrays, each aligned after the one before, and the bytes of the file
+void tableLayout(typTableHeader *hdr){
+	unsigned long long llArray[TABLE_ARRAYS], llAt = IF97_TABLE_HEADER_BYTES;
+	int i;
+
+	tableArrayBytes(hdr, llArray);
+	for (i = 0; i < TABLE_ARRAYS; i++) {
+		hdr->llOffset[i] = llAt;
+		llAt = tableAlign(llAt + llArray[i]);
+	}
+	hdr->llBytes = llAt;
+}
+
+
+// the checksum continued over llBytes (a multiple of 8) from pData, or of zeros if pData is NULL
+unsigned long long tableSum(unsigned long long llSum, const void *pData, unsigned long long llBytes){
+	const unsigned char *bytes = pData;
+	unsigned long long llWord = 0, i;
+
+	for (i = 0; i < llBytes; i += 8) {
+		if (bytes != NULL) memcpy(&llWord, bytes + i, 8);
+		llSum = (llSum ^ llWord) * TABLE_FNV_PRIME;
+	}
+	return llSum;
+}
+
+
+// the checksum continued over one term of an equation.  Term by term, as typIF97Coeffs_Jn has padding
+unsigned long long tableSumTerm(unsigned long long llSum, int iI, int iJ, double dblN){
+	unsigned long long llWord[3];
+
+	llWord[0] = (unsigned long long) (long long) iI;
+	llWord[1] = (unsigned long long) (long long) iJ;
+	memcpy(&llWord[2], &dblN, 8);
+	return tableSum(llSum, llWord, sizeof(llWord));
+}
+
+
+// hash of the coefficients of the equations of regions 1 to 5 and the B23 line, which the tables
+// were built from.  A file from a library with any of them changed is refused
+unsigned long long tableCoeffsHash(void){
+	unsigned long long llSum = TABLE_FNV_BASIS;
+	int i;
+
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R1; i++) llSum = tableSumTerm(llSum, GIBBS_COEFFS_R1[i].Ii, GIBBS_COEFFS_R1[i].Ji, GIBBS_COEFFS_R1[i].ni);
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R2_O; i++) llSum = tableSumTerm(llSum, 0, GIBBS_COEFFS_R2_O[i].Ji, GIBBS_COEFFS_R2_O[i].ni);
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R2_R; i++) llSum = tableSumTerm(llSum, GIBBS_COEFFS_R2_R[i].Ii, GIBBS_COEFFS_R2_R[i].Ji, GIBBS_COEFFS_R2_R[i].ni);
+	for (i = 1; i <= MAX_COEFFS_PHI_R3; i++) llSum = tableSumTerm(llSum, PHI_COEFFS_R3[i].Ii, PHI_COEFFS_R3[i].Ji, PHI_COEFFS_R3[i].ni);
+	for (i = 1; i <= TABLE_R4_COEFFS; i++) llSum = tableSumTerm(llSum, 0, i, IF97_R3_n[i]);
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R5_O; i++) llSum = tableSumTerm(llSum, 0, GIBBS_COEFFS_R5_O[i].Ji, GIBBS_COEFFS_R5_O[i].ni);
+	for (i = 1; i <= MAX_GIBBS_COEFFS_R5_R; i++) llSum = tableSumTerm(llSum, GIBBS_COEFFS_R5_R[i].Ii, GIBBS_COEFFS_R5_R[i].Ji, GIBBS_COEFFS_R5_R[i].ni);
+	for (i = 1; i <= TABLE_B23_COEFFS; i++) llSum = tableSumTerm(llSum, 0, i, B23_N[i]);
+	return llSum;
+}
+
+
+// the arrays of tab, in the order of llOffset
+void tableArrays(const typIF97Ttse *tab, const void **pArray){
+	pArray[0] = tab->sat;
+	pArray[1] = tab->ph.yEdge;
+	pArray[2] = tab->ph.side;
+	pArray[3] = tab->ph.a;
+	pArray[4] = tab->pt.side;
+	pArray[5] = tab->pt.a;
+}
+
+
+
+// ******  External   *******
+
+int if97_table_write(const char *strFile, const typIF97Ttse *tab){
+	typTableHeader hdr;
+	const typIF97TtseGrid *grid[2] = {&tab->ph, &tab->pt};
+	const void *pArray[TABLE_ARRAYS];
+	unsigned long long llArray[TABLE_ARRAYS], llPad;
+	FILE *out;
+	int i;
+	bool isOK;
+
+	tableArrays(tab, pArray);
+	for (i = 0; i < TABLE_ARRAYS; i++) if (pArray[i] == NULL) return 1;  // not built
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.strMagic, IF97_TABLE_MAGIC, 8);
+	hdr.lEndian = IF97_TABLE_ENDIAN_TAG;
+	hdr.lFormat = IF97_TABLE_FORMAT;
+	strncpy(hdr.strVersion, IF97_TABLE_LIB_VERSION, sizeof(hdr.strVersion) - 1);
+	hdr.lHeaderBytes = IF97_TABLE_HEADER_BYTES;
+	hdr.llCoeffs = tableCoeffsHash();
+	hdr.nP = tab->spec.nP;
+	hdr.nH = tab->spec.nH;
+	hdr.nT = tab->spec.nT;
+	hdr.pLo_MPa = tab->spec.pLo_MPa;
+	hdr.pHi_MPa = tab->spec.pHi_MPa;
+	hdr.tLo_K = tab->spec.tLo_K;
+	hdr.tHi_K = tab->spec.tHi_K;
+	hdr.nSat = tab->nSat;
+	for (i = 0; i < 2; i++) {
+		hdr.grid[i][0] = grid[i]->x0;
+		hdr.grid[i][1] = grid[i]->dblRdx;
+		hdr.grid[i][2] = grid[i]->y0;
+		hdr.grid[i][3] = grid[i]->dblRdy;
+	}
+	tableLayout(&hdr);
+	tableArrayBytes(&hdr, llArray);
+
+	// the checksum covers the arrays and the zeros aligning each, as they lie in the file.  Each
+	// array but the sides is of doubles, and the sides are aligned, so whole words are summed
+	hdr.llChecksum = TABLE_FNV_BASIS;
+	for (i = 0; i < TABLE_ARRAYS; i++) {
+		llPad = ((i + 1 < TABLE_ARRAYS) ? hdr.llOffset[i + 1] : hdr.llBytes) - hdr.llOffset[i] - llArray[i];
+		hdr.llChecksum = tableSum(hdr.llChecksum, pArray[i], llArray[i] / 8 * 8);
+		if (llArray[i] % 8 != 0) {  // the last few bytes of a side, padded with zeros to a word
+			unsigned char bytes[8] = {0};
+			memcpy(bytes, (const unsigned char *) pArray[i] + llArray[i] / 8 * 8, llArray[i] % 8);
+			hdr.llChecksum = tableSum(hdr.llChecksum, bytes, 8);
+			llPad -= 8 - llArray[i] % 8;
+		}
+		hdr.llChecksum = tableSum(hdr.llChecksum, NULL, llPad);
+	}
+
+	out = fopen(strFile, "wb");
+	if (out == NULL) return 1;
+	isOK = (fwrite(&hdr, sizeof(hdr), 1, out) == 1);
+	for (i = 0; isOK && (i < TABLE_ARRAYS); i++) {
+		isOK = (fwrite(pArray[i], 1, (size_t) llArray[i], out) == llArray[i]);
+		for (llPad = hdr.llOffset[i] + llArray[i]; isOK && (llPad < ((i + 1 < TABLE_ARRAYS) ? hdr.llOffset[i + 1] : hdr.llBytes)); llPad++)
+			isOK = (fputc(0, out) != EOF);
+	}
+	if (fclose(out) != 0) isOK = false;
+	if (!isOK) remove(strFile);
+	return isOK ? 0 : 1;
+}
+
+
+
+// maps strFile read only into table->pMap.  false if it cannot be
+bool tableMap(const char *strFile, typIF97Table *table){
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(strFile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER size;
+
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	if (GetFileSizeEx(hFile, &size) && (size.QuadPart > 0)) {
+		table->hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (table->hMapping != NULL) {
+			table->pMap = MapViewOfFile(table->hMapping, FILE_MAP_READ, 0, 0, 0);
+			if (table->pMap == NULL) {
+				CloseHandle(table->hMapping);
+				table->hMapping = NULL;
+			}
+		}
+		table->lBytes = (size_t) size.QuadPart;
+	}
+	CloseHandle(hFile);  // the mapping keeps the file open
+#else
+	struct stat st;
+	int fd = open(strFile, O_RDONLY);
+
+	if (fd < 0) return false;
+	if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+		table->pMap = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (table->pMap == MAP_FAILED) table->pMap = NULL;
+		table->lBytes = (size_t) st.st_size;
+	}
+	close(fd);  // the mapping keeps the file open
+#endif
+	return (table->pMap != NULL);
+}
+
+
+int if97_table_open(const char *strFile, typIF97Table *table){
+	const typTableHeader *hdr;
+	const unsigned char *bytes;
+	typIF97TtseGrid *grid[2];
+	unsigned long long llArray[TABLE_ARRAYS];
+	int i;
+
+	memset(table, 0, sizeof(typIF97Table));
+	if (!tableMap(strFile, table)) {
+		if97_table_close(table);
+		return IF97_TABLE_NO_FILE;
+	}
+	bytes = table->pMap;
+	hdr = table->pMap;
+
+	// what the file is, then whether it is for this machine and library, then whether it is whole
+	if ((table->lBytes < IF97_TABLE_HEADER_BYTES) || (memcmp(hdr->strMagic, IF97_TABLE_MAGIC, 8) != 0)) {
+		if97_table_close(table);
+		return IF97_TABLE_BAD_FORMAT;
+	}
+	if (hdr->lEndian != IF97_TABLE_ENDIAN_TAG) {
+		if97_table_close(table);
+		return (hdr->lEndian == 0x04030201U) ? IF97_TABLE_BAD_ENDIAN : IF97_TABLE_BAD_FORMAT;
+	}
+	if ((hdr->lFormat != IF97_TABLE_FORMAT) || (strncmp(hdr->strVersion, IF97_TABLE_LIB_VERSION, sizeof(hdr->strVersion)) != 0)) {
+		if97_table_close(table);
+		return IF97_TABLE_BAD_VERSION;
+	}
+	if (hdr->llCoeffs != tableCoeffsHash()) {
+		if97_table_close(table);
+		return IF97_TABLE_BAD_COEFFS;
+	}
+	if (!((hdr->lHeaderBytes == IF97_TABLE_HEADER_BYTES) && (hdr->llBytes == table->lBytes)
+			&& (hdr->nP >= 2) && (hdr->nP <= TABLE_MAX_NODES) && (hdr->nH >= 2) && (hdr->nH <= TABLE_MAX_NODES)
+			&& (hdr->nT >= 2) && (hdr->nT <= TABLE_MAX_NODES) && (hdr->nSat >= 0) && (hdr->nSat <= hdr->nP))) {
+		if97_table_close(table);
+		return IF97_TABLE_BAD_FORMAT;
+	}
+	tableArrayBytes(hdr, llArray);
+	for (i = 0; i < TABLE_ARRAYS; i++) {
+		if ((hdr->llOffset[i] < IF97_TABLE_HEADER_BYTES) || (hdr->llOffset[i] % IF97_TABLE_ALIGN != 0)
+				|| (hdr->llOffset[i] > hdr->llBytes) || (llArray[i] > hdr->llBytes - hdr->llOffset[i])) {
+			if97_table_close(table);
+			return IF97_TABLE_BAD_FORMAT;
+		}
+	}
+	if ((hdr->llBytes % 8 != 0)
+			|| (tableSum(TABLE_FNV_BASIS, bytes + IF97_TABLE_HEADER_BYTES, hdr->llBytes - IF97_TABLE_HEADER_BYTES) != hdr->llChecksum)) {
+		if97_table_close(table);
+		return IF97_TABLE_BAD_CHECKSUM;
+	}
+
+	// the tables, where they lie
+	table->ttse.spec.nP = hdr->nP;
+	table->ttse.spec.nH = hdr->nH;
+	table->ttse.spec.nT = hdr->nT;
+	table->ttse.spec.pLo_MPa = hdr->pLo_MPa;
+	table->ttse.spec.pHi_MPa = hdr->pHi_MPa;
+	table->ttse.spec.tLo_K = hdr->tLo_K;
+	table->ttse.spec.tHi_K = hdr->tHi_K;
+	table->ttse.nSat = hdr->nSat;
+	table->ttse.sat = (double *) (bytes + hdr->llOffset[0]);
+	grid[0] = &table->ttse.ph;
+	grid[1] = &table->ttse.pt;
+	for (i = 0; i < 2; i++) {
+		grid[i]->nx = hdr->nP;
+		grid[i]->ny = (i == 0) ? hdr->nH : hdr->nT;
+		grid[i]->x0 = hdr->grid[i][0];
+		grid[i]->dblRdx = hdr->grid[i][1];
+		grid[i]->y0 = hdr->grid[i][2];
+		grid[i]->dblRdy = hdr->grid[i][3];
+	}
+	table->ttse.ph.yEdge = (double *) (bytes + hdr->llOffset[1]);
+	table->ttse.ph.side = (unsigned char *) (bytes + hdr->llOffset[2]);
+	table->ttse.ph.a = (double *) (bytes + hdr->llOffset[3]);
+	table->ttse.pt.side = (unsigned char *) (bytes + hdr->llOffset[4]);
+	table->ttse.pt.a = (double *) (bytes + hdr->llOffset[5]);
+	return IF97_TABLE_OK;
+}
+
+
+void if97_table_close(typIF97Table *table){
+	if (table->pMap != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile(table->pMap);
+		CloseHandle(table->hMapping);
+#else
+		munmap(table->pMap, table->lBytes);
+#endif
+	}
+	memset(table, 0, sizeof(typIF97Table));
+}
+
+
+const char *if97_table_error(int iResult){
+	switch (iResult) {
+		case IF97_TABLE_OK: return "open";
+		case IF97_TABLE_NO_FILE: return "cannot be opened";
+		case IF97_TABLE_BAD_FORMAT: return "not a table file, or truncated";
+		case IF97_TABLE_BAD_ENDIAN: return "written in the other byte order";
+		case IF97_TABLE_BAD_VERSION: return "written by another version";
+		case IF97_TABLE_BAD_CHECKSUM: return "checksum does not match";
+		case IF97_TABLE_BAD_COEFFS: return "written with other coefficients of the equations";
+		default: return "unknown";
+	}
+}
@@ -0,0 +1,107 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Memory mapped files of the Taylor series (TTSE) tables
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_table.h
+ * @author Martin Lord
+ * @brief Writes the TTSE tables of if97_ttse.h to a file, and maps them back from it
+ * @details
+ * Building the tables takes seconds, and every process builds its own copy.  Written once
+ * to a file (if97_table_write, or the if97_table_gen tool), they are instead mapped into
+ * memory by if97_table_open, read only, so that opening takes milliseconds and processes
+ * on the same machine share one copy in the page cache.  \n
+ *
+ * The file is the header below followed by the arrays of typIF97Ttse, each aligned to
+ * IF97_TABLE_ALIGN bytes, in the byte order of the machine that wrote it, so that they are
+ * used where they lie.  The header records that byte order, the format and library version,
+ * a hash of the coefficients of the region equations, the envelope and grids, the offsets of
+ * the arrays and a checksum of them.  A file written on a machine of the other byte order,
+ * by another version or from other coefficients, truncated or corrupted, is refused.  \n
+ *
+ * An open table is looked up with the if97_ttse_ functions on table.ttse, which fall
+ * through to the IF97 equations outside it.  If the file is refused table.ttse is left
+ * empty, so every look-up falls through to the equations:  a missing file costs speed,
+ * never a wrong answer.  \n
+ *
+ * Header (IF97_TABLE_HEADER_BYTES, in the byte order of the arrays):
+ *   "IF97TTSE"                                                   8 bytes
+ *   IF97_TABLE_ENDIAN_TAG, IF97_TABLE_FORMAT                     uint32 each
+ *   IF97_TABLE_LIB_VERSION                                       16 bytes, 0 padded
+ *   header bytes, nP, nH, nT                                     uint32, int32 each
+ *   pLo_MPa, pHi_MPa, tLo_K, tHi_K                               double each
+ *   nSat, 0                                                      int32 each
+ *   x0, 1/dx, y0, 1/dy of the (p,h) and then the (p,T) grid      double each
+ *   offsets of sat, ph.yEdge, ph.side, ph.a, pt.side, pt.a       uint64 each
+ *   file bytes, checksum (64 bit FNV-1a of the 8 byte words
+ *   after the header)                                            uint64 each
+ *   coefficient hash (64 bit FNV-1a of I, J and n of each term
+ *   of regions 1 to 5 and the B23 line)                          uint64
+ *   0                                                            to the end of the header
+ */
+
+
+#ifndef IF97_TABLE_H
+#define IF97_TABLE_H
+
+#include <stddef.h>
+
+#include "if97_ttse.h"
+
+
+#define IF97_TABLE_MAGIC "IF97TTSE"
+#define IF97_TABLE_ENDIAN_TAG 0x01020304U  // reads as 0x04030201 in the other byte order
+#define IF97_TABLE_FORMAT 2  // raised whenever the layout of the file changes
+#ifndef IF97_VERSION
+	#define IF97_VERSION "0.1pre"  // defined by wscript from its VERSION.  This serves builds without it
+#endif
+#define IF97_TABLE_LIB_VERSION IF97_VERSION
+#define IF97_TABLE_HEADER_BYTES 256
+#define IF97_TABLE_ALIGN 64
+
+// results of if97_table_open
+#define IF97_TABLE_OK 0
+#define IF97_TABLE_NO_FILE 1  // cannot be opened or mapped
+#define IF97_TABLE_BAD_FORMAT 2  // not a table file, or truncated
+#define IF97_TABLE_BAD_ENDIAN 3  // written in the other byte order
+#define IF97_TABLE_BAD_VERSION 4  // written by another format or library version
+#define IF97_TABLE_BAD_CHECKSUM 5
+#define IF97_TABLE_BAD_COEFFS 6  // written with other coefficients of the equations
+
+
+/** a table mapped from a file */
+typedef struct sctIF97Table {
+	typIF97Ttse ttse;  // its arrays point into the mapping.  Read only:  never pass it to if97_ttse_free
+	void *pMap;  // the mapping, NULL if not open
+	size_t lBytes;
+	void *hMapping;  // the file mapping object, on Windows
+} typIF97Table;
+
+
+/** writes the tables built by if97_ttse_init to strFile.  0 on success, 1 if it cannot be written */
+int if97_table_write(const char *strFile, const typIF97Ttse *tab);
+
+/** maps the tables in strFile into table, checking the header and the checksum.  IF97_TABLE_OK (0)
+ * if open, otherwise one of the IF97_TABLE_ errors, with table->ttse empty, so that the if97_ttse_
+ * functions on it give the IF97 equations */
+int if97_table_open(const char *strFile, typIF97Table *table);
+
+/** unmaps the tables of table, leaving table->ttse empty */
+void if97_table_close(typIF97Table *table);
+
+/** a description of an if97_table_open result */
+const char *if97_table_error(int iResult);
+
+
+#endif // IF97_TABLE_H
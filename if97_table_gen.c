@@ -0,0 +1,78 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* WRITES THE TTSE TABLES TO A FILE, FOR if97_table_open
+*
+* Builds the tables of if97_ttse.h, writes them, and opens the file again to check
+* it, giving the time to build and to open and the size of the file.
+*
+* usage: if97_table_gen <table file> [nP [nH [nT]]]
+*         the numbers of nodes default to IF97_TTSE_NP, IF97_TTSE_NH and IF97_TTSE_NT,
+*         over the default envelope of if97_ttse_init
+* *******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "IF97_common.h"
+#include "if97_ttse.h"
+#include "if97_table.h"
+#include "solve.h"
+
+
+int main (int argc, char **argv){
+	typIF97Ttse tab;
+	typIF97TtseSpec spec;
+	typIF97Table table;
+	clock_t tBuild, tOpen;
+	int iResult;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: if97_table_gen <table file> [nP [nH [nT]]]\n");
+		return 1;
+	}
+
+	// the default envelope of if97_ttse_init
+	spec.nP = (argc > 2) ? atoi(argv[2]) : IF97_TTSE_NP;
+	spec.nH = (argc > 3) ? atoi(argv[3]) : IF97_TTSE_NH;
+	spec.nT = (argc > 4) ? atoi(argv[4]) : IF97_TTSE_NT;
+	spec.pLo_MPa = IF97_P_TRIP * 1e-6;
+	spec.pHi_MPa = IF97_R1_UPRESS;
+	spec.tLo_K = IF97_R1_LTEMP;
+	spec.tHi_K = IF97_R2_UTEMP;
+
+	tBuild = clock();
+	iResult = if97_ttse_init(&tab, &spec);
+	tBuild = clock() - tBuild;
+	if (iResult != SOLVE_CONVERGE) {
+		fprintf(stderr, "the tables cannot be built:  %d\n", iResult);
+		return 1;
+	}
+
+	iResult = if97_table_write(argv[1], &tab);
+	if97_ttse_free(&tab);
+	if (iResult != 0) {
+		fprintf(stderr, "%s cannot be written\n", argv[1]);
+		return 1;
+	}
+
+	tOpen = clock();
+	iResult = if97_table_open(argv[1], &table);
+	tOpen = clock() - tOpen;
+	if (iResult != IF97_TABLE_OK) {
+		fprintf(stderr, "%s is written, but %s\n", argv[1], if97_table_error(iResult));
+		return 1;
+	}
+	printf("%s:  %d x %d (p,h) and %d x %d (p,T) nodes, %.1f MB\n", argv[1], spec.nP, spec.nH, spec.nP, spec.nT, table.lBytes / 1048576.0);
+	printf("built in %.2f s (processor time)\n", (double) tBuild / CLOCKS_PER_SEC);
+	printf("opened and checked in %.3f s\n", (double) tOpen / CLOCKS_PER_SEC);
+	if97_table_close(&table);
+	return 0;
+}
@@ -0,0 +1,63 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* THE VERIFICATION POINTS OF THE REGION PROPERTY (FORWARDS) EQUATIONS
+*
+* IAPWS-IF97 Tables 5, 15, 33 and 42, with g and Cv from freesteam and the Moscow Power
+* Institute check pages (see the region tests).  Shared by the region tests and
+* if97_constexpr_test.cpp, which evaluates both libraries at the same states
+* *******************************************************************************/
+
+#ifndef IF97_TEST_POINTS_H
+#define IF97_TEST_POINTS_H
+
+
+typedef struct sctIF97TestPoint {
+	double in1;  // p (MPa), or rho (kg/m3) in region 3
+	double t_K;
+	double g;  // g (kJ/kg), or the Helmholtz free energy in region 3
+	double vOrP;  // v (m3/kg), or p (MPa) in region 3
+	double h;
+	double u;
+	double s;
+	double Cp;
+	double Cv;
+	double w;
+} typIF97TestPoint;
+
+
+#define IF97_TEST_POINTS 3  // points per region
+
+//	p		T		g					v				h				u				s				Cp				Cv				w
+static const typIF97TestPoint IF97_R1_TEST_POINTS[IF97_TEST_POINTS] = {
+	{3.0,	300.0,	-2.35716470e+00,	1.00215168e-3,	1.15331273e2,	1.12324818e2,	3.92294792e-1,	4.17301218e0,	4.12120160e0,	1.50773921e3},
+	{80.0,	300.0,	7.35736720e+01,		9.71180894e-4,	1.84142828e2,	1.06448356e2,	3.68563852e-1,	4.01008987e0,	3.91736606e0,	1.63469054e3},
+	{3.0,	500.0,	-3.14667321e+02,	1.20241800e-3,	9.75542239e2,	9.71934985e2,	2.58041912e0,	4.65580682e0,	3.22139223e0,	1.24071337e3}
+};
+
+static const typIF97TestPoint IF97_R2_TEST_POINTS[IF97_TEST_POINTS] = {
+	{0.0035,	300.0,	-6.80544936074451,	3.94913866e01,	2.54991145e03,	2.41169160e03,	8.52238967e00,	1.91300162e00,	1.441326618975,	4.27920172e02},
+	{0.0035,	700.0,	-3786.81595128593,	9.23015898e01,	3.33568375e03,	3.01262819e03,	1.01749996e01,	2.08141274e00,	1.6197833256,	6.44289068e02},
+	{30.0,		700.0,	-991.287342764431,	5.42946619e-3,	2.63149474e03,	2.46861076e03,	5.17540298e00,	1.03505092e01,	2.975538368909,	4.80386523e02}
+};
+
+//	rho		T		f					p				h				u				s				Cp				Cv				w
+static const typIF97TestPoint IF97_R3_TEST_POINTS[IF97_TEST_POINTS] = {
+	{500.0,	650.0,	-823.014490474163,	2.55837018e01,	1.86343019e03,	1.81226279e03,	4.05427273e00,	1.38935717e01,	3.191317871889,	5.02005554e02},
+	{200.0,	650.0,	-891.693463667219,	2.22930643e01,	2.37512401e03,	2.26365868e03,	4.85438792e00,	4.46579342e01,	4.04118075955,	3.83444594e02},
+	{500.0,	750.0,	-1250.21997453598,	7.83095639e01,	2.25868845e03,	2.10206932e03,	4.46971906e00,	6.34165359e00,	2.71701677121,	7.60696041e02}
+};
+
+static const typIF97TestPoint IF97_R5_TEST_POINTS[IF97_TEST_POINTS] = {
+	{0.5,	1500.0,	-9261.36457876123,	1.38455090e00,	5.21976855e03,	4.52749310e03,	9.654088753313,	2.61609445e00,	2.1533778351,	9.17068690e02},
+	{30.0,	1500.0,	-6427.31684918484,	2.30761299e-02,	5.16723514e03,	4.47495124e03,	7.729701326183,	2.72724317e00,	2.192748293665,	9.28548002e02},
+	{30.0,	2000.0,	-10501.5844236579,	3.11385219e-02,	6.57122604e03,	5.63707038e03,	8.536405231138,	2.88569882e00,	2.395894362358,	1.06736948e03}
+};
+
+
+#endif // IF97_TEST_POINTS_H
@@ -0,0 +1,487 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Tabular Taylor series expansion of the properties.  See if97_ttse.h
+
+/* The derivatives at a node are with respect to x = ln p and y = h or T.  From the
+ * (p,T) base derivatives of if97_deriv, for a property z
+ *
+ * 	(p,T):  zx = p z_p,  zy = z_T
+ * 	(p,h):  zx = p (z_p - z_T h_p / h_T),  zy = z_T / h_T
+ *
+ * and the second derivatives are the central differences of these across a step of
+ * TTSE_STEP of a node spacing, or the one sided difference where the step on one side
+ * leaves the node's side of the saturation line or the range of IF97.
+ */
+
+
+#include <math.h> // for log, exp, floor, isfinite
+#include <stdbool.h>
+#include <stddef.h> // for NULL
+#include <stdlib.h> // for malloc, free
+
+#include "if97_ttse.h"
+#include "if97_lib.h"
+#include "if97_deriv.h"
+#include "IF97_common.h"
+#include "IF97_Region4.h"
+#include "if97_stats.h"
+#include "solve.h"
+
+
+#define TTSE_GRID_PH 0
+#define TTSE_GRID_PT 1
+#define TTSE_NONE 0  // sides of the saturation line
+#define TTSE_LIQUID 1
+#define TTSE_VAPOUR 2
+#define TTSE_P_TRIP (IF97_P_TRIP * 1e-6)  // MPa
+#define TTSE_STEP 1e-3  // step, as a fraction of the node spacing, over which the second derivatives are differenced
+#define TTSE_REACH 3  // furthest, in nodes along y, that a node on the side of a state is looked for
+#define TTSE_SAT_TERMS 3  // value, first and second derivative in x
+
+
+// the saturated properties at each node along x
+enum ttseSat {
+	TTSE_SAT_T,
+	TTSE_SAT_H_L,
+	TTSE_SAT_H_V,
+	TTSE_SAT_V_L,
+	TTSE_SAT_V_V,
+	TTSE_SAT_S_L,
+	TTSE_SAT_S_V,
+	TTSE_SAT_U_L,
+	TTSE_SAT_U_V,
+	TTSE_NSAT,  // TTSE_NSAT TTSE_SAT_TERMS is IF97_TTSE_SAT_DOUBLES
+};
+
+
+// the IF97 properties tabulated on each grid, in the order of enum if97_ttse_prop_t
+const enum if97_prop_t ttseProp[2][IF97_TTSE_NPROPS] = {
+	{IF97_T, IF97_V, IF97_S, IF97_U},
+	{IF97_H, IF97_V, IF97_S, IF97_U},
+};
+
+
+
+// ******  Building   *******
+
+// p at x, but the limits of IF97 exactly at the nodes there, which rounding through x may take just outside
+double ttseP(double x){
+	double p_MPa = exp(x);
+
+	if ((p_MPa < TTSE_P_TRIP) && (p_MPa > TTSE_P_TRIP * (1.0 - 1e-12))) return TTSE_P_TRIP;
+	if ((p_MPa > IF97_R1_UPRESS) && (p_MPa < IF97_R1_UPRESS * (1.0 + 1e-12))) return IF97_R1_UPRESS;
+	return p_MPa;
+}
+
+
+// side of the saturation line of (p,T) by the IF97 equations
+int ttseSidePT(double p_MPa, double t_K){
+	if (p_MPa < IF97_PC) return (t_K <= if97_r4_ts(p_MPa)) ? TTSE_LIQUID : TTSE_VAPOUR;
+	return (t_K <= IF97_TC) ? TTSE_LIQUID : TTSE_VAPOUR;
+}
+
+
+// the properties of grid iGrid and their first derivatives in x and y at (x,y), into f[3 k], f[3 k + 1]
+// and f[3 k + 2] for property k, and its region in *iRegion.  Returns the side of the saturation line
+// of the state, TTSE_NONE if it is two phase or outside the range of IF97
+int ttseFirst(int iGrid, double x, double y, double *f, int *iRegion){
+	typSteamState state;
+	typIF97Partials pd;
+	double p_MPa = ttseP(x), zp, zt;
+	int k;
+
+	if (iGrid == TTSE_GRID_PH) {
+		state = if97_ph_state_mask(p_MPa, y, 0);
+		*iRegion = state.iRegion;
+		if ((state.iRegion == 0) || (state.iRegion == 4)) return TTSE_NONE;
+		pd = if97_state_partials(&state);
+	}
+	else pd = if97_pt_partials(p_MPa, y);
+	*iRegion = pd.iRegion;
+	if (pd.iRegion == 0) return TTSE_NONE;
+
+	for (k = 0; k < IF97_TTSE_NPROPS; k++) {
+		zp = pd.d1[ttseProp[iGrid][k]];
+		zt = pd.d2[ttseProp[iGrid][k]];
+		f[3 * k] = pd.val[ttseProp[iGrid][k]];
+		if (iGrid == TTSE_GRID_PH) {
+			f[3 * k + 1] = p_MPa * (zp - zt * pd.d1[IF97_H] / pd.d2[IF97_H]);
+			f[3 * k + 2] = zt / pd.d2[IF97_H];
+		}
+		else {
+			f[3 * k + 1] = p_MPa * zp;
+			f[3 * k + 2] = zt;
+		}
+	}
+	return ttseSidePT(p_MPa, pd.val[IF97_T]);
+}
+
+
+// derivative of a quantity from its values fLo at -d, f at 0 and fHi at +d, either of
+// which may be missing.  0 if both are
+double ttseDiff(bool bLo, double fLo, double f, bool bHi, double fHi, double d){
+	if (bLo && bHi) return (fHi - fLo) / (2.0 * d);
+	if (bHi) return (fHi - f) / d;
+	if (bLo) return (f - fLo) / d;
+	return 0.0;
+}
+
+
+// the terms of every property at node (x,y) of grid iGrid into a.  Returns its side of the
+// saturation line, TTSE_NONE if it is two phase or outside the range of IF97
+int ttseNode(int iGrid, double x, double y, double dx, double dy, double *a){
+	double f[3 * IF97_TTSE_NPROPS], fxLo[3 * IF97_TTSE_NPROPS], fxHi[3 * IF97_TTSE_NPROPS];
+	double fyLo[3 * IF97_TTSE_NPROPS], fyHi[3 * IF97_TTSE_NPROPS];
+	double dblXY[2];
+	bool bXLo, bXHi, bYLo, bYHi;
+	int iSide, iRegion, iStepRegion, k, n;
+
+	iSide = ttseFirst(iGrid, x, y, f, &iRegion);
+	if (iSide == TTSE_NONE) return TTSE_NONE;
+
+	// the steps either side, if they stay on the node's side and in its region, across whose
+	// boundaries the properties of IF97 are not quite continuous
+	bXLo = (ttseFirst(iGrid, x - dx, y, fxLo, &iStepRegion) == iSide) && (iStepRegion == iRegion);
+	bXHi = (ttseFirst(iGrid, x + dx, y, fxHi, &iStepRegion) == iSide) && (iStepRegion == iRegion);
+	bYLo = (ttseFirst(iGrid, x, y - dy, fyLo, &iStepRegion) == iSide) && (iStepRegion == iRegion);
+	bYHi = (ttseFirst(iGrid, x, y + dy, fyHi, &iStepRegion) == iSide) && (iStepRegion == iRegion);
+
+	for (k = 0; k < IF97_TTSE_NPROPS; k++, a += IF97_TTSE_NTERMS) {
+		a[IF97_TTSE_Z] = f[3 * k];
+		a[IF97_TTSE_ZX] = f[3 * k + 1];
+		a[IF97_TTSE_ZY] = f[3 * k + 2];
+		a[IF97_TTSE_ZXX] = ttseDiff(bXLo, fxLo[3 * k + 1], f[3 * k + 1], bXHi, fxHi[3 * k + 1], dx);
+		a[IF97_TTSE_ZYY] = ttseDiff(bYLo, fyLo[3 * k + 2], f[3 * k + 2], bYHi, fyHi[3 * k + 2], dy);
+
+		// the mixed derivative both ways, averaged where both can be found
+		n = 0;
+		if (bXLo || bXHi) dblXY[n++] = ttseDiff(bXLo, fxLo[3 * k + 2], f[3 * k + 2], bXHi, fxHi[3 * k + 2], dx);
+		if (bYLo || bYHi) dblXY[n++] = ttseDiff(bYLo, fyLo[3 * k + 1], f[3 * k + 1], bYHi, fyHi[3 * k + 1], dy);
+		a[IF97_TTSE_ZXY] = (n == 0) ? 0.0 : (n == 1) ? dblXY[0] : 0.5 * (dblXY[0] + dblXY[1]);
+	}
+	return iSide;
+}
+
+
+// the saturated properties and their first derivatives in x at x, into f[2 k] and f[2 k + 1], or above
+// the critical pressure those on the critical isotherm.  false unless p is above the critical pressure just if bAbove
+bool ttseSatFirst(double x, bool bAbove, double *f){
+	typIF97Partials liq, vap;
+	double p_MPa = ttseP(x);
+	int k;
+
+	if (bAbove != (p_MPa >= IF97_PC)) return false;
+	if (bAbove) liq = vap = if97_pt_partials(p_MPa, IF97_TC);
+	else {
+		liq = if97_px_partials(p_MPa, 0.0);
+		vap = if97_px_partials(p_MPa, 1.0);
+	}
+	if ((liq.iRegion == 0) || (vap.iRegion == 0)) return false;
+
+	// along the saturation line d1 is the derivative along it, on the critical isotherm at constant T
+	f[2 * TTSE_SAT_T] = liq.val[IF97_T];
+	f[2 * TTSE_SAT_T + 1] = p_MPa * liq.d1[IF97_T];
+	for (k = 1; k < IF97_TTSE_NPROPS; k++) {
+		f[2 * (TTSE_SAT_H_L + 2 * k)] = liq.val[ttseProp[TTSE_GRID_PT][k]];
+		f[2 * (TTSE_SAT_H_L + 2 * k) + 1] = p_MPa * liq.d1[ttseProp[TTSE_GRID_PT][k]];
+		f[2 * (TTSE_SAT_H_V + 2 * k)] = vap.val[ttseProp[TTSE_GRID_PT][k]];
+		f[2 * (TTSE_SAT_H_V + 2 * k) + 1] = p_MPa * vap.d1[ttseProp[TTSE_GRID_PT][k]];
+	}
+	f[2 * TTSE_SAT_H_L] = liq.val[IF97_H];
+	f[2 * TTSE_SAT_H_L + 1] = p_MPa * liq.d1[IF97_H];
+	f[2 * TTSE_SAT_H_V] = vap.val[IF97_H];
+	f[2 * TTSE_SAT_H_V + 1] = p_MPa * vap.d1[IF97_H];
+	return true;
+}
+
+
+// the saturated terms at x into a.  false if they cannot be found
+bool ttseSatNode(double x, double dx, double *a){
+	double f[2 * TTSE_NSAT], fLo[2 * TTSE_NSAT], fHi[2 * TTSE_NSAT];
+	bool bAbove = (ttseP(x) >= IF97_PC), bLo, bHi;
+	int k;
+
+	if (!ttseSatFirst(x, bAbove, f)) return false;
+	bLo = ttseSatFirst(x - dx, bAbove, fLo);
+	bHi = ttseSatFirst(x + dx, bAbove, fHi);
+	for (k = 0; k < TTSE_NSAT; k++, a += TTSE_SAT_TERMS) {
+		a[0] = f[2 * k];
+		a[1] = f[2 * k + 1];
+		a[2] = ttseDiff(bLo, fLo[2 * k + 1], f[2 * k + 1], bHi, fHi[2 * k + 1], dx);
+	}
+	return true;
+}
+
+
+// allocates the nodes of grid, of nx by ny from x0 to x1 and y0 to y1.  false if they cannot be
+bool ttseGridAlloc(typIF97TtseGrid *grid, int nx, int ny, double x0, double x1, double y0, double y1){
+	grid->nx = nx;
+	grid->ny = ny;
+	grid->x0 = x0;
+	grid->dblRdx = (nx - 1) / (x1 - x0);
+	grid->y0 = y0;
+	grid->dblRdy = (ny - 1) / (y1 - y0);
+	grid->side = malloc((long) nx * ny * sizeof(unsigned char));
+	grid->a = malloc((long) nx * ny * IF97_TTSE_NPROPS * IF97_TTSE_NTERMS * sizeof(double));
+	return (grid->side != NULL) && (grid->a != NULL);
+}
+
+
+// the nodes of grid iGrid
+void ttseGridInit(typIF97TtseGrid *grid, int iGrid){
+	double dx = TTSE_STEP / grid->dblRdx, dy = TTSE_STEP / grid->dblRdy;
+	long lNode;
+	int i, j;
+
+	#pragma omp parallel for private(j, lNode)  // the nodes are independent
+	for (i = 0; i < grid->nx; i++) {
+		for (j = 0; j < grid->ny; j++) {
+			lNode = (long) i * grid->ny + j;
+			grid->side[lNode] = ttseNode(iGrid, grid->x0 + i / grid->dblRdx, grid->y0 + j / grid->dblRdy, dx, dy,
+					grid->a + lNode * IF97_TTSE_NPROPS * IF97_TTSE_NTERMS);
+		}
+	}
+}
+
+
+void ttseGridClear(typIF97TtseGrid *grid){
+	grid->yEdge = NULL;
+	grid->side = NULL;
+	grid->a = NULL;
+}
+
+
+void ttseGridFree(typIF97TtseGrid *grid){
+	free(grid->yEdge);
+	free(grid->side);
+	free(grid->a);
+	ttseGridClear(grid);
+}
+
+
+
+// ******  Look-up   *******
+
+// node along x nearest x, or -1 if x is outside the grid
+int ttseNearestX(const typIF97TtseGrid *grid, double x){
+	double dblI = floor((x - grid->x0) * grid->dblRdx + 0.5);
+
+	if (!((dblI >= 0.0) && (dblI < grid->nx))) return -1;
+	return (int) dblI;
+}
+
+
+// saturated property iSat at node i along x, expanded to x
+double ttseSat(const typIF97Ttse *tab, int i, int iSat, double x){
+	const double *a = tab->sat + ((long) i * TTSE_NSAT + iSat) * TTSE_SAT_TERMS;
+	double dx = x - (tab->pt.x0 + i / tab->pt.dblRdx);
+
+	return a[0] + dx * (a[1] + 0.5 * dx * a[2]);
+}
+
+
+// property k at (x,y), expanded from the node of grid on iSide nearest it along y at node i along x.
+// NAN if there is none within TTSE_REACH nodes
+double ttseExpand(const typIF97TtseGrid *grid, int i, double x, double y, int iSide, int k){
+	const double *a;
+	double dblJ = floor((y - grid->y0) * grid->dblRdy + 0.5), dx, dy;
+	int j, jNear, iStep;
+
+	if (dblJ < 0.0) jNear = 0;
+	else if (dblJ > grid->ny - 1) jNear = grid->ny - 1;
+	else jNear = (int) dblJ;
+	for (iStep = 0; iStep <= 2 * TTSE_REACH; iStep++) {
+		j = jNear + ((iStep % 2) ? (iStep + 1) / 2 : -iStep / 2);  // jNear, jNear + 1, jNear - 1, ...
+		if ((j < 0) || (j >= grid->ny) || (grid->side[(long) i * grid->ny + j] != iSide)) continue;
+
+		a = grid->a + (((long) i * grid->ny + j) * IF97_TTSE_NPROPS + k) * IF97_TTSE_NTERMS;
+		dx = x - (grid->x0 + i / grid->dblRdx);
+		dy = y - (grid->y0 + j / grid->dblRdy);
+		return a[IF97_TTSE_Z] + dx * (a[IF97_TTSE_ZX] + 0.5 * dx * a[IF97_TTSE_ZXX] + dy * a[IF97_TTSE_ZXY])
+				+ dy * (a[IF97_TTSE_ZY] + 0.5 * dy * a[IF97_TTSE_ZYY]);
+	}
+	return NAN;
+}
+
+
+// property k at (p,h), NAN if it is outside the tables
+double ttsePh(const typIF97Ttse *tab, double p_MPa, double h_kJperkg, int k){
+	const typIF97TtseGrid *grid = &tab->ph;
+	double x, dblFrac, hLo, hHi, hLiq, hVap, zLiq;
+	int i, iEdge;
+
+	if (!((p_MPa >= tab->spec.pLo_MPa) && (p_MPa <= tab->spec.pHi_MPa))) return NAN;
+	x = log(p_MPa);
+	i = ttseNearestX(grid, x);
+	if ((i < 0) || ((p_MPa < IF97_PC) != (i < tab->nSat))) return NAN;  // within half a node of the critical pressure
+
+	// the envelope, between the nodes either side
+	dblFrac = (x - grid->x0) * grid->dblRdx;
+	iEdge = (int) dblFrac;
+	if (iEdge > grid->nx - 2) iEdge = grid->nx - 2;
+	dblFrac -= iEdge;
+	hLo = grid->yEdge[2 * iEdge] + dblFrac * (grid->yEdge[2 * iEdge + 2] - grid->yEdge[2 * iEdge]);
+	hHi = grid->yEdge[2 * iEdge + 1] + dblFrac * (grid->yEdge[2 * iEdge + 3] - grid->yEdge[2 * iEdge + 1]);
+	if (!((h_kJperkg >= hLo) && (h_kJperkg <= hHi))) return NAN;
+
+	hLiq = ttseSat(tab, i, TTSE_SAT_H_L, x);
+	hVap = ttseSat(tab, i, TTSE_SAT_H_V, x);
+	if ((p_MPa < IF97_PC) && (h_kJperkg >= hLiq) && (h_kJperkg <= hVap)) {  // two phase, by the lever rule
+		if (k == IF97_TTSE_TH) return ttseSat(tab, i, TTSE_SAT_T, x);
+		zLiq = ttseSat(tab, i, TTSE_SAT_H_L + 2 * k, x);
+		return zLiq + (h_kJperkg - hLiq) / (hVap - hLiq) * (ttseSat(tab, i, TTSE_SAT_H_V + 2 * k, x) - zLiq);
+	}
+	return ttseExpand(grid, i, x, h_kJperkg, (h_kJperkg < hLiq) ? TTSE_LIQUID : TTSE_VAPOUR, k);
+}
+
+
+// property k at (p,T), NAN if it is outside the tables
+double ttsePt(const typIF97Ttse *tab, double p_MPa, double t_K, int k){
+	double x;
+	int i;
+
+	if (!((p_MPa >= tab->spec.pLo_MPa) && (p_MPa <= tab->spec.pHi_MPa) && (t_K >= tab->spec.tLo_K) && (t_K <= tab->spec.tHi_K)))
+		return NAN;
+	if ((p_MPa >= IF97_TTSE_NC_PLO) && (p_MPa <= IF97_TTSE_NC_PHI) && (t_K >= IF97_TTSE_NC_TLO) && (t_K <= IF97_TTSE_NC_THI))
+		return NAN;  // near critical, where h and v are too steep in T
+	x = log(p_MPa);
+	i = ttseNearestX(&tab->pt, x);
+	if ((i < 0) || ((p_MPa < IF97_PC) != (i < tab->nSat))) return NAN;  // within half a node of the critical pressure
+	return ttseExpand(&tab->pt, i, x, t_K, (t_K <= ttseSat(tab, i, TTSE_SAT_T, x)) ? TTSE_LIQUID : TTSE_VAPOUR, k);
+}
+
+
+
+// ******  External   *******
+
+int if97_ttse_init(typIF97Ttse *tab, const typIF97TtseSpec *spec){
+	const typIF97TtseSpec defaultSpec = {IF97_TTSE_NP, IF97_TTSE_NH, IF97_TTSE_NT, TTSE_P_TRIP, IF97_R1_UPRESS, IF97_R1_LTEMP, IF97_R2_UTEMP};
+	double x0, x1, x, p_MPa, hLo, hHi;
+	int i, nx, iFail = 0;
+
+	ttseGridClear(&tab->ph);
+	ttseGridClear(&tab->pt);
+	tab->sat = NULL;
+	tab->spec = (spec == NULL) ? defaultSpec : *spec;
+	spec = &tab->spec;
+	if (!((spec->nP >= 2) && (spec->nH >= 2) && (spec->nT >= 2)
+			&& (spec->pLo_MPa >= TTSE_P_TRIP) && (spec->pLo_MPa < spec->pHi_MPa) && (spec->pHi_MPa <= IF97_R1_UPRESS)
+			&& (spec->tLo_K >= IF97_R1_LTEMP) && (spec->tLo_K < spec->tHi_K) && (spec->tHi_K <= IF97_R5_UTEMP)))
+		return SOLVE_NOT_DEFINED;
+
+	nx = spec->nP;
+	x0 = log(spec->pLo_MPa);
+	x1 = log(spec->pHi_MPa);
+
+	// the (p,h) envelope, from the lowest to the highest temperature at each pressure.  Above the
+	// pressure limit of region 5 the highest is that of region 2
+	tab->ph.yEdge = malloc(2 * nx * sizeof(double));
+	tab->sat = malloc((long) nx * IF97_TTSE_SAT_DOUBLES * sizeof(double));
+	if ((tab->ph.yEdge == NULL) || (tab->sat == NULL)) iFail = SOLVE_NO_MEMORY;
+	for (i = 0, hLo = INFINITY, hHi = -INFINITY; (i < nx) && (iFail == 0); i++) {
+		p_MPa = ttseP(x0 + i * (x1 - x0) / (nx - 1));
+		tab->ph.yEdge[2 * i] = if97_pt_h(p_MPa, spec->tLo_K);
+		tab->ph.yEdge[2 * i + 1] = if97_pt_h(p_MPa, ((p_MPa > IF97_R5_UPRESS) && (spec->tHi_K > IF97_R2_UTEMP)) ? IF97_R2_UTEMP : spec->tHi_K);
+		if (tab->ph.yEdge[2 * i] < hLo) hLo = tab->ph.yEdge[2 * i];
+		if (tab->ph.yEdge[2 * i + 1] > hHi) hHi = tab->ph.yEdge[2 * i + 1];
+	}
+
+	if (iFail == 0) {
+		if (!ttseGridAlloc(&tab->ph, nx, spec->nH, x0, x1, hLo, hHi) || !ttseGridAlloc(&tab->pt, nx, spec->nT, x0, x1, spec->tLo_K, spec->tHi_K))
+			iFail = SOLVE_NO_MEMORY;
+	}
+	if (iFail == 0) {
+		for (i = 0, tab->nSat = 0; i < nx; i++) {
+			x = x0 + i / tab->pt.dblRdx;
+			if (ttseP(x) < IF97_PC) tab->nSat++;
+			if (!ttseSatNode(x, TTSE_STEP / tab->pt.dblRdx, tab->sat + (long) i * IF97_TTSE_SAT_DOUBLES))
+				iFail = SOLVE_NO_CONVERGE;
+		}
+		ttseGridInit(&tab->ph, TTSE_GRID_PH);
+		ttseGridInit(&tab->pt, TTSE_GRID_PT);
+	}
+
+	if (iFail != 0) if97_ttse_free(tab);
+	return iFail;
+}
+
+
+void if97_ttse_free(typIF97Ttse *tab){
+	ttseGridFree(&tab->ph);
+	ttseGridFree(&tab->pt);
+	free(tab->sat);
+	tab->sat = NULL;
+}
+
+
+
+double if97_ttse_ph_t(const typIF97Ttse *tab, double p_MPa, double h_kJperkg){
+	double z = ttsePh(tab, p_MPa, h_kJperkg, IF97_TTSE_TH);
+
+	if (isnan(z)) return if97_ph_t(p_MPa, h_kJperkg);
+	return z;
+}
+
+
+double if97_ttse_ph_v(const typIF97Ttse *tab, double p_MPa, double h_kJperkg){
+	double z = ttsePh(tab, p_MPa, h_kJperkg, IF97_TTSE_V);
+
+	if (isnan(z)) return if97_ph_v(p_MPa, h_kJperkg);
+	return z;
+}
+
+
+double if97_ttse_ph_s(const typIF97Ttse *tab, double p_MPa, double h_kJperkg){
+	double z = ttsePh(tab, p_MPa, h_kJperkg, IF97_TTSE_S);
+
+	if (isnan(z)) return if97_ph_s(p_MPa, h_kJperkg);
+	return z;
+}
+
+
+double if97_ttse_ph_u(const typIF97Ttse *tab, double p_MPa, double h_kJperkg){
+	typSteamState state;
+	double z = ttsePh(tab, p_MPa, h_kJperkg, IF97_TTSE_U);
+
+	if (!isnan(z)) return z;
+	state = if97_ph_state_mask(p_MPa, h_kJperkg, IF97_MASK_U);
+	if (state.iRegion == 0) return IF97_STATS_ERROR(-9998.0);  //error region not valid
+	return state.u_kJperkg;
+}
+
+
+
+double if97_ttse_pt_h(const typIF97Ttse *tab, double p_MPa, double t_K){
+	double z = ttsePt(tab, p_MPa, t_K, IF97_TTSE_TH);
+
+	if (isnan(z)) return if97_pt_h(p_MPa, t_K);
+	return z;
+}
+
+
+double if97_ttse_pt_v(const typIF97Ttse *tab, double p_MPa, double t_K){
+	double z = ttsePt(tab, p_MPa, t_K, IF97_TTSE_V);
+
+	if (isnan(z)) return if97_pt_v(p_MPa, t_K);
+	return z;
+}
+
+
+double if97_ttse_pt_s(const typIF97Ttse *tab, double p_MPa, double t_K){
+	double z = ttsePt(tab, p_MPa, t_K, IF97_TTSE_S);
+
+	if (isnan(z)) return if97_pt_s(p_MPa, t_K);
+	return z;
+}
+
+
+double if97_ttse_pt_u(const typIF97Ttse *tab, double p_MPa, double t_K){
+	double z = ttsePt(tab, p_MPa, t_K, IF97_TTSE_U);
+
+	if (isnan(z)) return if97_pt_u(p_MPa, t_K);
+	return z;
+}
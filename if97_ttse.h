@@ -0,0 +1,167 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Tabular Taylor series expansion (TTSE) of the properties on (ln p,h) and (ln p,T) grids
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_ttse.h
+ * @author Martin Lord
+ * @brief T, v, s and u from (p,h), and h, v, s and u from (p,T), by Taylor series from tabulated nodes
+ * @details
+ * The properties and their first and second derivatives are tabulated once, by
+ * if97_ttse_init, at the nodes of two regular grids: x = ln p against h, and x = ln p
+ * against T.  A look-up finds the nearest node by rounding, and expands each property
+ * from it to second order, \n
+ *
+ * z = z0 + zx dx + zy dy + zxx dx^2 / 2 + zxy dx dy + zyy dy^2 / 2 \n
+ *
+ * so costs two roundings and a dozen multiply-adds, with no search and no iteration.
+ * The temperature at each (p,h) node is found by iteration on h(p,T) (if97_ph_state_mask),
+ * and the derivatives are from the analytic first derivatives (if97_deriv.h), the second
+ * by differencing them across a small step about the node.  \n
+ *
+ * No expansion crosses the saturation line.  Each node is marked as liquid or steam, by
+ * whether it is colder or hotter than the saturation temperature or, above the critical
+ * pressure, the critical temperature, and a state is only expanded from a node on its own
+ * side:  the nearest such node along h or T, within a few nodes.  Nodes in the two phase
+ * region are marked as neither.  The saturated properties, continued above the critical
+ * pressure by those on the critical isotherm, are tabulated along ln p in the same way, and
+ * give the side of a state, and a two phase (p,h) by the lever rule.  States for which there
+ * is no node, those within half a node of the critical pressure, those outside the envelope,
+ * and (p,T) within the near critical box IF97_TTSE_NC_*, where h and v are too steep in T
+ * for the expansion, are from the IF97 equations themselves.  \n
+ *
+ * The envelope and resolution are set by typIF97TtseSpec.  By default they are the
+ * triple point pressure to 100 MPa and 273.15 K to 1073.15 K, on 200 nodes along ln p and
+ * 200 along h and T, for which the grids take about 16 MB and 3 s to build.  99% of states
+ * then agree with IF97 to within 1e-3 K in T and 5e-3 kJ/kg in h, 1e-5 relative in v and
+ * 1e-5 kJ/kg/K in s, the worst being by 1073.15 K, where the nodes beyond are in region 5, and
+ * about the near critical box.  The error falls as the cube of the node spacing.  The tables
+ * are read only once built, so may be shared between threads.
+ *
+ * UNITS  p: MPa, T: K, v: m3/kg, h, u: kJ/kg, s: kJ/kg/K
+ */
+
+
+#ifndef IF97_TTSE_H
+#define IF97_TTSE_H
+
+
+#define IF97_TTSE_NP 200  // default number of nodes along ln p
+#define IF97_TTSE_NH 200  // default number of nodes along h
+#define IF97_TTSE_NT 200  // default number of nodes along T
+#define IF97_TTSE_NC_PLO 18.0  // MPa  near critical box of (p,T), whose states are from the IF97 equations
+#define IF97_TTSE_NC_PHI 34.0  // MPa
+#define IF97_TTSE_NC_TLO 630.0  // K
+#define IF97_TTSE_NC_THI 700.0  // K
+#define IF97_TTSE_SAT_DOUBLES 27  // doubles of sat at each node along x:  9 properties, each with 2 derivatives
+
+
+// properties tabulated at each node.  IF97_TTSE_TH is T on the (p,h) grid, h on the (p,T) grid
+enum if97_ttse_prop_t {
+	IF97_TTSE_TH = 0,
+	IF97_TTSE_V = 1,
+	IF97_TTSE_S = 2,
+	IF97_TTSE_U = 3,
+	IF97_TTSE_NPROPS = 4,
+};
+
+
+// terms of the expansion of each property:  its value, first and second derivatives in x = ln p and y = h or T
+enum if97_ttse_term_t {
+	IF97_TTSE_Z = 0,
+	IF97_TTSE_ZX = 1,
+	IF97_TTSE_ZY = 2,
+	IF97_TTSE_ZXX = 3,
+	IF97_TTSE_ZXY = 4,
+	IF97_TTSE_ZYY = 5,
+	IF97_TTSE_NTERMS = 6,
+};
+
+
+/** envelope and resolution of the tables */
+typedef struct sctIF97TtseSpec {
+	int nP;  // nodes along ln p
+	int nH;  // nodes along h
+	int nT;  // nodes along T
+	double pLo_MPa;  // envelope, within the range of IF97
+	double pHi_MPa;
+	double tLo_K;
+	double tHi_K;
+} typIF97TtseSpec;
+
+
+/** one grid of nodes, x = ln p against y = h or T */
+typedef struct sctIF97TtseGrid {
+	int nx;
+	int ny;
+	double x0;  // x of the first node
+	double dblRdx;  // 1 / spacing of the nodes in x
+	double y0;
+	double dblRdy;
+	double *yEdge;  // (p,h):  h at the lowest and highest temperatures of the envelope, yEdge[2 i] and yEdge[2 i + 1], at node i along x
+	unsigned char *side;  // side[i ny + j] is the side of the saturation line of node (i,j):  1 liquid, 2 steam, 0 neither
+	double *a;  // a[((i ny + j) IF97_TTSE_NPROPS + k) IF97_TTSE_NTERMS + m] is term m of property k at node (i,j)
+} typIF97TtseGrid;
+
+
+/** the (p,h) and (p,T) tables */
+typedef struct sctIF97Ttse {
+	typIF97TtseSpec spec;
+	int nSat;  // nodes along x below the critical pressure
+	// at each node along x, ts, h', h'', v', v'', s', s'', u' and u'', each with its first and second derivative in x.
+	// Above the critical pressure, the critical temperature, and the properties there as both h' and h'' and so on
+	double *sat;
+	typIF97TtseGrid ph;
+	typIF97TtseGrid pt;
+} typIF97Ttse;
+
+
+/** builds the tables in tab, over the envelope and with the resolution of spec, or by default
+ * (IF97_TTSE_NP, IF97_TTSE_NH and IF97_TTSE_NT nodes from the triple point pressure to 100 MPa and
+ * 273.15 K to 1073.15 K) if spec is NULL.  Returns SOLVE_CONVERGE (0) if they were built, SOLVE_NO_MEMORY if
+ * they could not be allocated, or SOLVE_NOT_DEFINED if spec is not within the range of IF97 or has fewer
+ * than two nodes in any direction.  Unless built, tab holds no memory */
+int if97_ttse_init(typIF97Ttse *tab, const typIF97TtseSpec *spec);
+
+/** frees the tables of tab */
+void if97_ttse_free(typIF97Ttse *tab);
+
+
+/** temperature (K) for a given p_MPa and h_kJperkg.  As if97_ph_t outside the tables */
+double if97_ttse_ph_t(const typIF97Ttse *tab, double p_MPa, double h_kJperkg);
+
+/** specific volume (m3/kg) for a given p_MPa and h_kJperkg.  As if97_ph_v outside the tables */
+double if97_ttse_ph_v(const typIF97Ttse *tab, double p_MPa, double h_kJperkg);
+
+/** specific entropy (kJ/kg/K) for a given p_MPa and h_kJperkg.  As if97_ph_s outside the tables */
+double if97_ttse_ph_s(const typIF97Ttse *tab, double p_MPa, double h_kJperkg);
+
+/** specific internal energy (kJ/kg) for a given p_MPa and h_kJperkg.  As if97_ph_state_mask outside the tables */
+double if97_ttse_ph_u(const typIF97Ttse *tab, double p_MPa, double h_kJperkg);
+
+
+/** specific enthalpy (kJ/kg) for a given p_MPa and t_K.  As if97_pt_h outside the tables */
+double if97_ttse_pt_h(const typIF97Ttse *tab, double p_MPa, double t_K);
+
+/** specific volume (m3/kg) for a given p_MPa and t_K.  As if97_pt_v outside the tables */
+double if97_ttse_pt_v(const typIF97Ttse *tab, double p_MPa, double t_K);
+
+/** specific entropy (kJ/kg/K) for a given p_MPa and t_K.  As if97_pt_s outside the tables */
+double if97_ttse_pt_s(const typIF97Ttse *tab, double p_MPa, double t_K);
+
+/** specific internal energy (kJ/kg) for a given p_MPa and t_K.  As if97_pt_u outside the tables */
+double if97_ttse_pt_u(const typIF97Ttse *tab, double p_MPa, double t_K);
+
+
+#endif // IF97_TTSE_H
@@ -0,0 +1,183 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Inverse functions started from the previous solution.  See if97_warm.h
+
+
+#include <math.h> // for isfinite
+#include <stdbool.h>
+
+#include "if97_warm.h"
+#include "if97_lib.h"
+#include "IF97_common.h"
+#include "IF97_Region3bw.h"  // for isNearCritical, if97_r3_pt_subregion
+#include "if97_stats.h"
+#include "solve.h"
+
+
+#define WARM_GUESS_TOL_PCT 0.001  // offset of the secant's second guess from a warm start.  The step from a close guess is small
+
+
+
+void if97_warm_init(typIF97Warm *warm){
+	warm->iRegion = 0;
+	warm->cSubregion = 0;
+	warm->t_K = 0.0;
+	warm->rho_kgPerM3 = 0.0;
+	warm->iIterations = 0;
+	warm->lWarm = 0;
+	warm->lCold = 0;
+}
+
+
+
+// is a warm solution in the region it was started in?  Cheap checks only: region_pt,
+// and below the critical pressure in region 3, the side of the saturation line
+// (liquid is denser than critical, steam less dense)
+bool warmKeeps(int iRegion, double p_MPa, double t_K, double rho_kgPerM3){
+	if (!isfinite(t_K) || (region_pt(p_MPa, t_K) != iRegion)) return false;
+	if ((iRegion == 3) && (p_MPa < IF97_PC))
+		return ((t_K < if97_r4_ts(p_MPa)) == (rho_kgPerM3 > IF97_RHOC));
+	return true;
+}
+
+
+double warmKept(typIF97Warm *warm, int iIterations, double t_K, double rho_kgPerM3){
+	warm->t_K = t_K;
+	warm->rho_kgPerM3 = rho_kgPerM3;
+	warm->iIterations = iIterations;
+	warm->lWarm++;
+	return t_K;
+}
+
+
+
+double if97_warm_ph_t(typIF97Warm *warm, double p_MPa, double h_kJperkg){
+	double t_K = warm->t_K, rho_kgPerM3 = warm->rho_kgPerM3;
+	int iIterations;
+
+	switch (warm->iRegion) {
+	case 1 :
+	case 2 :
+	case 5 :
+		iIterations = gibbs_t_ph_newton(warm->iRegion, p_MPa, h_kJperkg, &t_K);
+		if ((iIterations <= GIBBS_NEWTON_MAX) && warmKeeps(warm->iRegion, p_MPa, t_K, rho_kgPerM3))
+			return warmKept(warm, iIterations, t_K, rho_kgPerM3);
+		break;
+	case 3:
+		iIterations = r3_rhot_ph_newton(p_MPa, h_kJperkg, &rho_kgPerM3, &t_K);
+		if ((iIterations <= R3_NEWTON_MAX) && warmKeeps(3, p_MPa, t_K, rho_kgPerM3))
+			return warmKept(warm, iIterations, t_K, rho_kgPerM3);
+		break;
+	}
+
+	// cold, as if97_ph_t
+	warm->lCold++;
+	warm->cSubregion = 0;
+	warm->iRegion = region_ph(p_MPa, h_kJperkg);
+	switch (warm->iRegion) {
+	case 1 :
+	case 2 :
+	case 5 :
+		warm->t_K = gibbs_t_ph_guess(warm->iRegion, p_MPa, h_kJperkg);
+		warm->iIterations = gibbs_t_ph_newton(warm->iRegion, p_MPa, h_kJperkg, &warm->t_K);
+		return warm->t_K;
+	case 3:
+		warm->iIterations = r3_rhot_ph(p_MPa, h_kJperkg, &warm->rho_kgPerM3, &warm->t_K);
+		return warm->t_K;
+	case 4:  // two phase.  There is nothing to start the next call from
+		warm->iRegion = 0;
+		warm->iIterations = 0;
+		warm->t_K = if97_r4_ts (p_MPa);
+		return warm->t_K;
+	}
+	warm->iIterations = 0;
+	return IF97_STATS_ERROR(-9998.0);  //error region not valid
+}
+
+
+
+double if97_warm_ps_t(typIF97Warm *warm, double p_MPa, double s_kJperkgK){
+	double t_K = warm->t_K, rho_kgPerM3 = warm->rho_kgPerM3;
+	int iIterations;
+
+	switch (warm->iRegion) {
+	case 1 :
+	case 2 :
+	case 5 :
+		iIterations = gibbs_t_ps_newton(warm->iRegion, p_MPa, s_kJperkgK, &t_K);
+		if ((iIterations <= GIBBS_NEWTON_MAX) && warmKeeps(warm->iRegion, p_MPa, t_K, rho_kgPerM3))
+			return warmKept(warm, iIterations, t_K, rho_kgPerM3);
+		break;
+	case 3:
+		iIterations = r3_rhot_ps_newton(p_MPa, s_kJperkgK, &rho_kgPerM3, &t_K);
+		if ((iIterations <= R3_NEWTON_MAX) && warmKeeps(3, p_MPa, t_K, rho_kgPerM3))
+			return warmKept(warm, iIterations, t_K, rho_kgPerM3);
+		break;
+	}
+
+	// cold, as if97_ps_t
+	warm->lCold++;
+	warm->cSubregion = 0;
+	warm->iRegion = region_ps(p_MPa, s_kJperkgK);
+	switch (warm->iRegion) {
+	case 1 :
+	case 2 :
+	case 5 :
+		warm->t_K = gibbs_t_ps_guess(warm->iRegion, p_MPa, s_kJperkgK);
+		warm->iIterations = gibbs_t_ps_newton(warm->iRegion, p_MPa, s_kJperkgK, &warm->t_K);
+		return warm->t_K;
+	case 3:
+		warm->iIterations = r3_rhot_ps(p_MPa, s_kJperkgK, &warm->rho_kgPerM3, &warm->t_K);
+		return warm->t_K;
+	case 4:  // two phase.  There is nothing to start the next call from
+		warm->iRegion = 0;
+		warm->iIterations = 0;
+		warm->t_K = if97_r4_ts (p_MPa);
+		return warm->t_K;
+	}
+	warm->iIterations = 0;
+	return IF97_STATS_ERROR(-9998.0);  //error region not valid
+}
+
+
+
+double if97_warm_r3_rho_pt(typIF97Warm *warm, double p_MPa, double t_K){
+	typIF97R3Isotherm iso;
+	typSolvResult slvResult;
+	char cSubregion;
+
+	if (!(isNearCritical(p_MPa, t_K))) {  // the backwards equations are enough
+		warm->lCold++;
+		warm->iRegion = 3;
+		warm->cSubregion = 0;
+		warm->iIterations = 0;
+		warm->t_K = t_K;
+		warm->rho_kgPerM3 = 1/if97_R3bw_v_pt (p_MPa, t_K);
+		return warm->rho_kgPerM3;
+	}
+
+	cSubregion = if97_r3_pt_subregion(p_MPa, t_K);
+	if97_r3_isotherm(t_K, &iso);
+
+	if ((warm->iRegion == 3) && (warm->cSubregion == cSubregion)) {
+		slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, p_MPa, warm->rho_kgPerM3, WARM_GUESS_TOL_PCT, NULL, TEST_ACCURACY, SIG_FIG, 100 );
+		if (slvResult.iErrCode == SOLVE_CONVERGE) {
+			warmKept(warm, (int) slvResult.lIterations, t_K, slvResult.dSolution);
+			return slvResult.dSolution;
+		}
+	}
+
+	// cold, as r3_rho_pt
+	slvResult = ctx_solv(if97_r3_p_iso, NULL, &iso, p_MPa, 1/if97_R3bw_v_pt (p_MPa, t_K), 0.05, NULL, TEST_ACCURACY, SIG_FIG, 100 );
+	warm->lCold++;
+	warm->iRegion = 3;
+	warm->cSubregion = cSubregion;
+	warm->iIterations = (int) slvResult.lIterations;
+	warm->t_K = t_K;
+	warm->rho_kgPerM3 = slvResult.dSolution;
+	return slvResult.dSolution;
+}
@@ -0,0 +1,69 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//    Inverse functions started from the previous solution, for time stepping
+
+
+/**
+ * @copyright
+ * Copyright Martin Lord 2014-2017. \n
+ * Distributed under the Boost Software License, Version 1.0. \n
+ * (See accompanying file LICENSE_1_0.txt or copy at \n
+ * http://www.boost.org/LICENSE_1_0.txt) \n
+ *
+ * @file if97_warm.h
+ * @author Martin Lord
+ * @brief t(p,h), t(p,s) and near critical density(p,T) started from the last solution
+ * @details
+ * In a dynamic simulation each state changes little from one time step to the next.
+ * A handle (typIF97Warm), kept for each state, remembers the region, temperature,
+ * density and region 3 subregion of its last solution.  The next call starts the
+ * iteration from them, rather than from the backwards equations.  \n
+ *
+ * The warm solution is kept only if it is in the same region (and, for density near
+ * critical, the same subregion) as the last, checked by region_pt, which is cheap.
+ * Below the critical pressure a region 3 solution must also be on the same side of
+ * the saturation line as its density.  Otherwise, or with no last solution (the
+ * handle is new, or the last call was two phase or out of range), the call is as
+ * if97_ph_t, if97_ps_t or r3_rho_pt.  \n
+ *
+ * The results agree with the cold path to within the solver tolerance, so may differ
+ * in the last few figures.  A handle must not be shared between threads without a lock
+ */
+
+
+#ifndef IF97_WARM_H
+#define IF97_WARM_H
+
+
+typedef struct sctIF97Warm {
+	int iRegion;  // region of the last solution.  0 if there is none, so the next call is cold
+	char cSubregion;  // region 3 subregion of the last near critical density, otherwise 0
+	double t_K;  // temperature of the last solution
+	double rho_kgPerM3;  // density of the last solution in region 3
+	int iIterations;  // iterations taken by the last call
+	long lWarm;  // calls kept from a warm start
+	long lCold;  // calls solved from the backwards equations
+} typIF97Warm;
+
+
+/** clears a handle, so that its next call is cold.  The counts are zeroed */
+void if97_warm_init(typIF97Warm *warm);
+
+/** temperature (K) for a given p_MPa and h_kJperkg, started from the last solution of warm.
+ *  -9998 if out of range */
+double if97_warm_ph_t(typIF97Warm *warm, double p_MPa, double h_kJperkg);
+
+/** temperature (K) for a given p_MPa and s_kJperkgK, started from the last solution of warm.
+ *  -9998 if out of range */
+double if97_warm_ps_t(typIF97Warm *warm, double p_MPa, double s_kJperkgK);
+
+/** density (kg/m3) in region 3 for a given p_MPa and t_K.  Near critical, it is iterated
+ * on from the last density of warm.  Elsewhere it is from the backwards equations */
+double if97_warm_r3_rho_pt(typIF97Warm *warm, double p_MPa, double t_K);
+
+
+#endif // IF97_WARM_H
@@ -0,0 +1,500 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* *****************************************************************************
+* WORKLOAD TRACES AND A REPLAY DRIVER
+*
+* The microbenchmarks (if97_bench) draw their inputs at random from each region.
+* Plant and CFD calculations do not: their states are mostly in regions 1 and 2,
+* move smoothly, and have a tail near the critical point.  This generates traces
+* of such calculations, stores them in a compact binary file, and replays them
+* through the scalar if97_pt_, if97_ph_ and Stm functions, single threaded and
+* from several threads, reporting the throughput for each workload.
+*
+* The workloads are
+*    boiler     once through (supercritical) boiler tubes, heated uniformly, as (p,T).
+*               Crosses the pseudo critical line, so has the near critical tail
+*    turbine    HP, IP and LP expansion lines at several loads, as (p,T), down to
+*               the saturation line
+*    condenser  a two phase sweep of condenser pressures and qualities, as (p,h)
+*    cfd        the cell field of an attemperator: superheated steam with a cold
+*               water jet, as (p,T)
+*
+* Trace file (all little endian):
+*    "IF97TRC1"                                     8 bytes
+*    number of traces                               uint32
+*    then for each trace
+*       name, zero padded                           32 bytes
+*       input pair (WL_PAIR_PT or WL_PAIR_PH)       uint32
+*       number of points                            uint32
+*       points: p (MPa), then T (K) or h (kJ/kg)    2 x IEEE double each
+*
+* usage: if97_workload generate [trace file]
+*        if97_workload replay [trace file] [threads] [repeats]
+*         defaults are if97_workload.trc, the OpenMP maximum and 3
+* *******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#include "IF97_common.h"
+#include "IF97_Region1.h"
+#include "IF97_Region2.h"
+#include "IF97_Region4.h"
+#include "if97_lib.h"
+#include "if97_stats.h"
+#include "winsteam_compatibility.h"
+
+
+#define WL_TRACELOC "if97_workload.trc"
+#define WL_MAGIC "IF97TRC1"
+#define WL_NAMELEN 32
+#define WL_MAX_TRACES 16
+#define WL_MAX_POINTS 1000000  // a sanity limit when reading
+#define WL_REPEATS 3  // default passes over each trace when replaying
+
+#define WL_PAIR_PT 0  // p (MPa), T (K)
+#define WL_PAIR_PH 1  // p (MPa), h (kJ/kg)
+
+
+typedef struct sctTrace {
+	char strName[WL_NAMELEN];
+	int iPair;
+	int n;
+	double *in1;  // p_MPa
+	double *in2;  // t_K or h_kJperkg
+} typTrace;
+
+
+typedef struct sctReplayFunc {
+	const char *strName;
+	int iPair;  // the traces it is replayed on
+	double (*func) (double, double);
+} typReplayFunc;
+
+
+typTrace traces[WL_MAX_TRACES];
+int numTraces = 0;
+volatile double dblSink;  // results are added here so that the calls are not optimised away
+
+
+
+// ***************** TIMING AND RANDOM NUMBERS *********************
+
+// a monotonic time in s
+double wlNow (void){
+#ifdef _WIN32
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double) count.QuadPart / (double) freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+#endif
+}
+
+
+// uniform on [0, 1) from a linear congruential generator, so every trace file is the same
+unsigned long wlSeed = 97;
+double wlRand (void){
+	wlSeed = (wlSeed * 1103515245ul + 12345ul) % 2147483648ul;
+	return (double) wlSeed / 2147483648.0;
+}
+
+
+
+// ***************** TRACES *********************
+
+// a new, empty trace, or NULL if there is no room
+typTrace *traceNew (const char *strName, int iPair, int iCapacity){
+	typTrace *tr;
+
+	if (numTraces >= WL_MAX_TRACES) return NULL;
+	tr = &traces[numTraces];
+	memset(tr->strName, 0, WL_NAMELEN);
+	strncpy(tr->strName, strName, WL_NAMELEN - 1);
+	tr->iPair = iPair;
+	tr->n = 0;
+	tr->in1 = malloc(iCapacity * sizeof(double));
+	tr->in2 = malloc(iCapacity * sizeof(double));
+	if ((tr->in1 == NULL) || (tr->in2 == NULL)) {
+		free(tr->in1);
+		free(tr->in2);
+		return NULL;
+	}
+	numTraces++;
+	return tr;
+}
+
+
+void traceAdd (typTrace *tr, double in1, double in2){
+	tr->in1[tr->n] = in1;
+	tr->in2[tr->n] = in2;
+	tr->n++;
+}
+
+
+void traceWriteU32 (FILE *out, unsigned long lValue){
+	int i;
+	for (i = 0; i < 4; i++) fputc((int) ((lValue >> (8 * i)) & 0xff), out);
+}
+
+void traceWriteDouble (FILE *out, double dblValue){
+	unsigned long long llBits;
+	int i;
+
+	memcpy(&llBits, &dblValue, sizeof(double));
+	for (i = 0; i < 8; i++) fputc((int) ((llBits >> (8 * i)) & 0xff), out);
+}
+
+// false at the end of the file
+bool traceReadU32 (FILE *in, unsigned long *lValue){
+	unsigned char bytes[4];
+	int i;
+
+	if (fread(bytes, 1, 4, in) != 4) return false;
+	*lValue = 0;
+	for (i = 3; i >= 0; i--) *lValue = (*lValue << 8) | bytes[i];
+	return true;
+}
+
+bool traceReadDouble (FILE *in, double *dblValue){
+	unsigned char bytes[8];
+	unsigned long long llBits = 0;
+	int i;
+
+	if (fread(bytes, 1, 8, in) != 8) return false;
+	for (i = 7; i >= 0; i--) llBits = (llBits << 8) | bytes[i];
+	memcpy(dblValue, &llBits, sizeof(double));
+	return true;
+}
+
+
+// 0 on success
+int traceWriteFile (const char *strFile){
+	FILE *out = fopen(strFile, "wb");
+	int i, j;
+
+	if (out == NULL) return 1;
+	fwrite(WL_MAGIC, 1, 8, out);
+	traceWriteU32(out, (unsigned long) numTraces);
+	for (i = 0; i < numTraces; i++) {
+		fwrite(traces[i].strName, 1, WL_NAMELEN, out);
+		traceWriteU32(out, (unsigned long) traces[i].iPair);
+		traceWriteU32(out, (unsigned long) traces[i].n);
+		for (j = 0; j < traces[i].n; j++) {
+			traceWriteDouble(out, traces[i].in1[j]);
+			traceWriteDouble(out, traces[i].in2[j]);
+		}
+	}
+	return (fclose(out) == 0) ? 0 : 1;
+}
+
+
+// 0 on success, 1 if the file cannot be opened, 2 if it is not a trace file or is truncated
+int traceReadFile (const char *strFile){
+	FILE *in = fopen(strFile, "rb");
+	char strMagic[8];
+	char strName[WL_NAMELEN];
+	unsigned long lTraces, lPair, lPoints, i, j;
+	double in1, in2;
+	typTrace *tr;
+
+	if (in == NULL) return 1;
+	if ((fread(strMagic, 1, 8, in) != 8) || (memcmp(strMagic, WL_MAGIC, 8) != 0) || !traceReadU32(in, &lTraces)) {
+		fclose(in);
+		return 2;
+	}
+	for (i = 0; i < lTraces; i++) {
+		if ((fread(strName, 1, WL_NAMELEN, in) != WL_NAMELEN) || !traceReadU32(in, &lPair) || !traceReadU32(in, &lPoints)
+				|| (lPoints > WL_MAX_POINTS)) {
+			fclose(in);
+			return 2;
+		}
+		strName[WL_NAMELEN - 1] = 0;
+		tr = traceNew(strName, (int) lPair, (lPoints > 0) ? (int) lPoints : 1);
+		if (tr == NULL) break;
+		for (j = 0; j < lPoints; j++) {
+			if (!traceReadDouble(in, &in1) || !traceReadDouble(in, &in2)) {
+				fclose(in);
+				return 2;
+			}
+			traceAdd(tr, in1, in2);
+		}
+	}
+	fclose(in);
+	return 0;
+}
+
+
+
+// ***************** WORKLOAD GENERATORS *********************
+
+/* Once through boiler tubes at supercritical pressure.  Each tube is heated uniformly,
+ * so the enthalpy rises linearly along it while the pressure falls with friction.  The
+ * temperature plateaus near the pseudo critical point, where many of the points are */
+void genBoiler (int numTubes, int numPoints){
+	typTrace *tr = traceNew("boiler", WL_PAIR_PT, numTubes * numPoints);
+	double p_in, p_out, t_in, t_out, h_in, h_out, p_MPa, h_kJperkg, t_K, dblFrac;
+	int i, j;
+
+	if (tr == NULL) return;
+	for (i = 0; i < numTubes; i++) {
+		p_in = 27.0 + 3.0 * wlRand();
+		p_out = p_in - 1.5 - 1.0 * wlRand();
+		t_in = 560.0 + 20.0 * wlRand();
+		t_out = 820.0 + 40.0 * wlRand();
+		h_in = if97_pt_h(p_in, t_in);
+		h_out = if97_pt_h(p_out, t_out);
+		for (j = 0; j < numPoints; j++) {
+			dblFrac = (double) j / (numPoints - 1);
+			p_MPa = p_in + (p_out - p_in) * dblFrac;
+			h_kJperkg = h_in + (h_out - h_in) * dblFrac;
+			t_K = if97_ph_t(p_MPa, h_kJperkg);
+			if (t_K > 0.0) traceAdd(tr, p_MPa, t_K);
+		}
+	}
+}
+
+
+/* Turbine expansion lines: HP, IP and LP cylinders at several loads.  The pressure
+ * falls in equal ratios through each cylinder, and the enthalpy follows from the
+ * isentropic efficiency.  The LP line stops at the saturation line */
+void genTurbine (int numLoads, int numPoints){
+	// inlet pressure (MPa), inlet temperature (K), outlet pressure (MPa), isentropic efficiency
+	const double cylinders[3][4] = {
+		{16.5, 838.15, 4.0, 0.86},
+		{3.6, 838.15, 0.55, 0.91},
+		{0.55, 573.15, 0.005, 0.88}
+	};
+	typTrace *tr = traceNew("turbine", WL_PAIR_PT, 3 * numLoads * numPoints);
+	double dblLoad, p_in, p_out, h_in, s_in, p_MPa, h_kJperkg, t_K;
+	int i, j, k;
+
+	if (tr == NULL) return;
+	for (i = 0; i < numLoads; i++) {
+		dblLoad = 0.5 + 0.5 * i / ((numLoads > 1) ? (numLoads - 1) : 1);  // sliding pressure from half to full load
+		for (k = 0; k < 3; k++) {
+			p_in = cylinders[k][0] * dblLoad;
+			p_out = cylinders[k][2] * ((k < 2) ? dblLoad : 1.0);
+			h_in = if97_pt_h(p_in, cylinders[k][1]);
+			s_in = if97_pt_s(p_in, cylinders[k][1]);
+			for (j = 0; j < numPoints; j++) {
+				p_MPa = p_in * pow(p_out / p_in, (double) j / (numPoints - 1));
+				h_kJperkg = h_in - cylinders[k][3] * (h_in - if97_ps_h(p_MPa, s_in));
+				if (region_ph(p_MPa, h_kJperkg) == 4) break;  // wet
+				t_K = if97_ph_t(p_MPa, h_kJperkg);
+				if (t_K > 0.0) traceAdd(tr, p_MPa, t_K);
+			}
+		}
+	}
+}
+
+
+/* Condenser: a sweep of quality from slightly subcooled to dry saturated, over the
+ * range of condenser pressures */
+void genCondenser (int numPressures, int numQualities){
+	typTrace *tr = traceNew("condenser", WL_PAIR_PH, numPressures * numQualities);
+	double p_MPa, ts_K, hf, hg, dblX;
+	int i, j;
+
+	if (tr == NULL) return;
+	for (i = 0; i < numPressures; i++) {
+		p_MPa = 0.004 + 0.008 * i / (numPressures - 1);
+		ts_K = if97_r4_ts(p_MPa);
+		hf = if97_r1_h(p_MPa, ts_K);
+		hg = if97_r2_h(p_MPa, ts_K);
+		for (j = 0; j < numQualities; j++) {
+			dblX = -0.02 + 1.02 * j / (numQualities - 1);
+			traceAdd(tr, p_MPa, hf + dblX * (hg - hf));
+		}
+	}
+}
+
+
+/* CFD cell field of a spray attemperator: a box of cells of superheated steam with a
+ * cold water jet along its axis.  Pressure falls along the box, the steam temperature
+ * varies a little across it, and the jet warms as it travels */
+void genCFD (int nx, int ny, int nz){
+	typTrace *tr = traceNew("cfd", WL_PAIR_PT, nx * ny * nz);
+	double x, y, z, r2, p_MPa, t_K, t_jet;
+	int i, j, k;
+
+	if (tr == NULL) return;
+	for (k = 0; k < nz; k++) {
+		z = (double) k / (nz - 1);
+		p_MPa = 17.0 - 0.3 * z;
+		t_jet = 450.0 + 100.0 * z;
+		for (j = 0; j < ny; j++) {
+			y = (double) j / (ny - 1) - 0.5;
+			for (i = 0; i < nx; i++) {
+				x = (double) i / (nx - 1) - 0.5;
+				r2 = (x * x + y * y) / (0.02 + 0.04 * z);
+				t_K = 790.0 - 40.0 * x * x + 2.0 * (wlRand() - 0.5);  // steam
+				if (r2 < 1.0) t_K = t_jet;  // water in the jet
+				else t_K = t_jet + (t_K - t_jet) * (1.0 - 0.5 * exp(-(r2 - 1.0)));  // steam cooled round it
+				traceAdd(tr, p_MPa, t_K);
+			}
+		}
+	}
+}
+
+
+void generate (void){
+	genBoiler(24, 400);
+	genTurbine(6, 200);
+	genCondenser(40, 120);
+	genCFD(32, 32, 24);
+}
+
+
+
+// ***************** REPLAY *********************
+
+double wl_StmPTH (double p_MPa, double t_K) {return StmPTH(10.0 * p_MPa, t_K - 273.15, "SI");}
+double wl_StmPTS (double p_MPa, double t_K) {return StmPTS(10.0 * p_MPa, t_K - 273.15, "SI");}
+double wl_StmPTV (double p_MPa, double t_K) {return StmPTV(10.0 * p_MPa, t_K - 273.15, "SI");}
+double wl_StmPHT (double p_MPa, double h_kJperkg) {return StmPHT(10.0 * p_MPa, h_kJperkg, "SI");}
+double wl_StmPHQ (double p_MPa, double h_kJperkg) {return StmPHQ(10.0 * p_MPa, h_kJperkg, "SI");}
+
+
+const typReplayFunc replayFuncs[] = {
+	{"if97_pt_h", WL_PAIR_PT, if97_pt_h},
+	{"if97_pt_s", WL_PAIR_PT, if97_pt_s},
+	{"if97_pt_v", WL_PAIR_PT, if97_pt_v},
+	{"if97_pt_Cp", WL_PAIR_PT, if97_pt_Cp},
+	{"StmPTH", WL_PAIR_PT, wl_StmPTH},
+	{"StmPTS", WL_PAIR_PT, wl_StmPTS},
+	{"StmPTV", WL_PAIR_PT, wl_StmPTV},
+	{"if97_ph_t", WL_PAIR_PH, if97_ph_t},
+	{"if97_ph_s", WL_PAIR_PH, if97_ph_s},
+	{"if97_ph_q", WL_PAIR_PH, if97_ph_q},
+	{"StmPHT", WL_PAIR_PH, wl_StmPHT},
+	{"StmPHQ", WL_PAIR_PH, wl_StmPHQ}
+};
+#define WL_NUM_REPLAY_FUNCS (int) (sizeof(replayFuncs) / sizeof(replayFuncs[0]))
+
+
+// the share of the points in each region, as a one line summary
+void printRegions (const typTrace *tr){
+	int counts[6] = {0, 0, 0, 0, 0, 0};
+	int i, iRegion;
+
+	for (i = 0; i < tr->n; i++) {
+		iRegion = (tr->iPair == WL_PAIR_PT) ? region_pt(tr->in1[i], tr->in2[i]) : region_ph(tr->in1[i], tr->in2[i]);
+		counts[((iRegion >= 1) && (iRegion <= 5)) ? iRegion : 0]++;
+	}
+	printf("%-10s %7i points (%s)  R1 %4.1f%%  R2 %4.1f%%  R3 %4.1f%%  R4 %4.1f%%  R5 %4.1f%%  invalid %4.1f%%\n",
+			tr->strName, tr->n, (tr->iPair == WL_PAIR_PT) ? "p,T" : "p,h",
+			100.0 * counts[1] / tr->n, 100.0 * counts[2] / tr->n, 100.0 * counts[3] / tr->n,
+			100.0 * counts[4] / tr->n, 100.0 * counts[5] / tr->n, 100.0 * counts[0] / tr->n);
+}
+
+
+// calls per second for func over the trace, repeated, on iThreads threads
+double replay (const typTrace *tr, double (*func) (double, double), int iThreads, int iRepeats){
+	double dblStart, dblSum = 0.0;
+	int i, r;
+
+#ifdef _OPENMP
+	omp_set_num_threads(iThreads);  // so that the library's own loops are on one thread when replaying on one thread
+#endif
+	dblStart = wlNow();
+	for (r = 0; r < iRepeats; r++) {
+		#pragma omp parallel for reduction(+:dblSum) schedule(static)  //handle loop multithreaded
+		for (i = 0; i < tr->n; i++) dblSum += func(tr->in1[i], tr->in2[i]);
+	}
+	dblSink += dblSum;
+	return (double) tr->n * iRepeats / (wlNow() - dblStart);
+}
+
+
+void replayAll (int iThreads, int iRepeats){
+	int i, j, t, numThreads[2] = {1, iThreads};
+	double dblRate, dblTime[2];
+	long lCalls;
+
+	printf("\n%-10s %-12s %8s %14s %14s\n", "workload", "function", "threads", "calls/s", "ns/call");
+	for (i = 0; i < numTraces; i++) {
+		if (traces[i].n == 0) continue;
+		lCalls = 0;
+		dblTime[0] = dblTime[1] = 0.0;
+		if97_stats_reset();
+		for (j = 0; j < WL_NUM_REPLAY_FUNCS; j++) {
+			if (replayFuncs[j].iPair != traces[i].iPair) continue;
+			lCalls += (long) traces[i].n * iRepeats;
+			for (t = 0; t < ((iThreads > 1) ? 2 : 1); t++) {
+				dblRate = replay(&traces[i], replayFuncs[j].func, numThreads[t], iRepeats);
+				dblTime[t] += (double) traces[i].n * iRepeats / dblRate;
+				printf("%-10s %-12s %8i %14.0f %14.1f\n", traces[i].strName, replayFuncs[j].strName, numThreads[t], dblRate, 1e9 / dblRate);
+			}
+		}
+		for (t = 0; t < ((iThreads > 1) ? 2 : 1); t++)
+			printf("%-10s %-12s %8i %14.0f %14.1f\n", traces[i].strName, "all", numThreads[t], lCalls / dblTime[t], 1e9 * dblTime[t] / lCalls);
+#ifdef IF97_STATS
+		if97_stats_dump(stdout);  // where the calls of this workload went
+#endif
+		fflush(stdout);
+	}
+}
+
+
+
+int main (int argc, char **argv){
+	const char *strFile = (argc > 2) ? argv[2] : WL_TRACELOC;
+	int i, iErr, iThreads = 1, iRepeats = WL_REPEATS;
+
+#ifdef _OPENMP
+	iThreads = omp_get_max_threads();
+#endif
+
+	if ((argc > 1) && (strcmp(argv[1], "generate") == 0)) {
+		generate();
+		for (i = 0; i < numTraces; i++) printRegions(&traces[i]);
+		if (traceWriteFile(strFile) != 0) {
+			fprintf(stderr, "if97_workload: cannot write %s\n", strFile);
+			return 1;
+		}
+		printf("Traces written to %s\n", strFile);
+		return 0;
+	}
+
+	if ((argc > 1) && (strcmp(argv[1], "replay") == 0)) {
+		if (argc > 3) iThreads = atoi(argv[3]);
+		if (argc > 4) iRepeats = atoi(argv[4]);
+		if (iThreads < 1) iThreads = 1;
+		if (iRepeats < 1) iRepeats = WL_REPEATS;
+
+		iErr = traceReadFile(strFile);
+		if (iErr != 0) {
+			fprintf(stderr, "if97_workload: %s %s\n", strFile, (iErr == 1) ? "cannot be opened" : "is not a valid trace file");
+			return 1;
+		}
+		for (i = 0; i < numTraces; i++) printRegions(&traces[i]);
+		replayAll(iThreads, iRepeats);
+		return 0;
+	}
+
+	fprintf(stderr, "usage: if97_workload generate [trace file]\n");
+	fprintf(stderr, "       if97_workload replay [trace file] [threads] [repeats]\n");
+	return 1;
+}
@@ -21,11 +21,45 @@
 
 #include <math.h> // for pow, log, fabs
 #include <stdbool.h>
+#include <stdlib.h> // for malloc
 
 #include "solve.h"
+#include "if97_stats.h"
 
 #include <stdio.h>  //used for debugging only
 
+
+
+//***************************************************************
+//****** ACCEPTANCE TEST AND RESULTS ****************************
+
+/*  the acceptance test of the solvers, for an error (deviation from seek_result) of dblErr */
+bool slvIsSolved(double dblErr, double seek_result, double solutionTol, int solutionTolType){
+	switch (solutionTolType){
+		case SLV_PERCENT:
+			return (fabs(dblErr/seek_result) <= solutionTol/100.0);
+		case SLV_ABS:
+			return (dblErr <= solutionTol);
+		case SLV_SIG_FIG:
+			return (dblErr <= pow(10,-solutionTol ));
+	}
+	return false;
+}
+
+
+void slvLaneResult(typSolvResult *solution, double dSolution, long int lIterations, int iErrCode){
+	solution->dSolution = dSolution;
+	solution->lIterations = lIterations;
+	solution->iErrCode = iErrCode;
+	IF97_STATS_SOLVE(lIterations, iErrCode);
+}
+
+
+
+
+//***************************************************************
+//****** SOLVERS ON f(x, ctx) ***********************************
+
 /*  Assuming Secant method most securely finds roots.
  * Use this if Newton Raphson doesn't solve or if the derivatives are not known.
  *  
@@ -51,15 +85,8 @@
  */
  
 
-typSolvResult  secant_solv ( double (*func)(double, double),  // pointer to the function. one variable is known (held constant), the other is sought.
-							double funcConst, //  the function variable which is held constant
-							bool isFuncConstPos1,  // is input held constant the first of the two function variables? (false if it is the second)
-							double seek_result,  // the (known) result of the function when the sought variable is correct.
-							double in_guess,  // initial guess of the sought variable
-							double guess_tol_pct, //  
-							double solutionTol, //
-							int solutionTolType, //	SLV_SIG_FIG, SLV_ABS, SLV_PERCENT, - in this case defined in IF97_common.h
-							long int max_iterations){   // maximum number of iterations to attempt before declaring an error
+typSolvResult  slvSecant ( typSolvFunc f, void *ctx, double seek_result, double in_guess, double guess_tol_pct, 
+							double solutionTol, int solutionTolType, long int max_iterations){
 	
 	double lastGuessResult, thisGuessResult, nextGuessResult;
 	double lastGuess = in_guess ;
@@ -67,52 +94,20 @@ typSolvResult  secant_solv ( double (*func)(double, double),  // pointer to the
 	double nextGuess = in_guess * (1 - guess_tol_pct/100.0);
 	double lastErr, thisErr, nextErr; // deviation from goal seek as a ratio of goal seek
 	long int i =0;
-	int eCode = 0;  // error code.  Initialised with no error
 	typSolvResult solution;
 	
 	// first, check the initial guess.  Maybe it's right first time.
-	if (isFuncConstPos1 == true) lastGuessResult = (*func)(funcConst, lastGuess);
-	else                         lastGuessResult = (*func)(lastGuess, funcConst) ;
-		
+	lastGuessResult = (*f)(lastGuess, ctx);
 	lastErr = fabs(lastGuessResult - seek_result);
 	
-	switch (solutionTolType){
-		case SLV_PERCENT:		
-			if (fabs(lastErr/seek_result) <= solutionTol/100.0){
-				solution.dSolution = lastGuess;
-				solution.lIterations = i;
-				solution.iErrCode = eCode;
-				return solution ;
-			}
-			break;
-		case SLV_ABS:
-			if (lastErr <= solutionTol){
-				solution.dSolution = lastGuess;
-				solution.lIterations = i;
-				solution.iErrCode = eCode;
-				return solution ;
-			}
-			break;			
-		case SLV_SIG_FIG:
-			if (lastErr <= pow(10,-solutionTol )){
-				solution.dSolution = lastGuess;
-				solution.lIterations = i;
-				solution.iErrCode = eCode;
-				return solution ;
-			}
-			break;		
+	if (slvIsSolved(lastErr, seek_result, solutionTol, solutionTolType)) {
+		slvLaneResult(&solution, lastGuess, i, SOLVE_CONVERGE);
+		return solution ;
 	}
 	
-	
 	// Not right first time, so calculate the guesses either side of the initial (last) guess
-	if (isFuncConstPos1 == true){
-		thisGuessResult = (*func)(funcConst, thisGuess);
-		nextGuessResult = (*func)(funcConst, nextGuess);
-	}
-	else {
-		thisGuessResult = (*func)(thisGuess,  funcConst) ;
-		nextGuessResult = (*func)(nextGuess,  funcConst) ;
-	}
+	thisGuessResult = (*f)(thisGuess, ctx);
+	nextGuessResult = (*f)(nextGuess, ctx);
 
 	// make closest tol the next guess and discard the other
 	if (fabs(thisGuessResult - seek_result) > fabs(nextGuessResult - seek_result)) {
@@ -134,37 +129,13 @@ typSolvResult  secant_solv ( double (*func)(double, double),  // pointer to the
 									/ (thisErr - lastErr)      );
 				
 		// try function with new next guess
-		if (isFuncConstPos1 == true) nextGuessResult = (*func)(funcConst, nextGuess);
-		else                         nextGuessResult = (*func)(nextGuess, funcConst) ;
-
+		nextGuessResult = (*f)(nextGuess, ctx);
 		nextErr = fabs((nextGuessResult - seek_result));
 
 		//  check if the result of the try meets the solution acceptance criterion
-		switch (solutionTolType){
-			case SLV_PERCENT:		
-				if (fabs(nextErr/seek_result) <= solutionTol/100.0){
-					solution.dSolution = nextGuess;
-					solution.lIterations = i;
-					solution.iErrCode = eCode;
-					return solution ;
-				}
-				break;
-			case SLV_ABS:
-				if (nextErr <= solutionTol){
-					solution.dSolution = nextGuess;
-					solution.lIterations = i;
-					solution.iErrCode = eCode;
-					return solution ;
-				}
-				break;			
-			case SLV_SIG_FIG:
-				if (nextErr <= pow(10,-solutionTol )){
-					solution.dSolution = nextGuess;
-					solution.lIterations = i;
-					solution.iErrCode = eCode;
-					return solution ;
-				}
-				break;		
+		if (slvIsSolved(nextErr, seek_result, solutionTol, solutionTolType)) {
+			slvLaneResult(&solution, nextGuess, i, SOLVE_CONVERGE);
+			return solution ;
 		}
 	
 /* if we reach here on this iteration, we do not have a solution so
@@ -179,28 +150,491 @@ typSolvResult  secant_solv ( double (*func)(double, double),  // pointer to the
 		thisErr = nextErr;
 	} // end of main loop
 
-	eCode = SOLVE_NO_CONVERGE;  // if this executes, we have exceeded the maximum number of iterations without converging
+	// if this executes, we have exceeded the maximum number of iterations without converging
+	slvLaneResult(&solution, nextGuess, i, SOLVE_NO_CONVERGE);
+return solution ;
+}
+
+
+
+/*  Use Newton Raphson if the first derivatives are know and are known not
+ * to have discontinuities.  Do NOT use it near discontinuities. 
+ * i.e. not v(p,t) near critical point.  not straddling the saturation 
+ * line on the P, T plane   
+ * 
+ * Each iteration is one call of func and one of deriv.  The acceptance test
+ * is as secant_solv's, on the deviation of func from seek_result.
+*/
+
+typSolvResult  slvNewton ( typSolvFunc f, typSolvFunc df, void *ctx, double seek_result, double in_guess, 
+							double solutionTol, int solutionTolType, long int max_iterations){
 	
-	solution.dSolution = nextGuess;
-	solution.lIterations = i;
-	solution.iErrCode = eCode;
+	double thisGuess = in_guess;
+	double thisErr, thisSlope;
+	long int i;
+	int eCode = SOLVE_NO_CONVERGE;  // unless it converges below
+	typSolvResult solution;
+	
+	for (i = 0; i <= max_iterations; i++) {
+		thisErr = (*f)(thisGuess, ctx) - seek_result;
+		
+		if (slvIsSolved(fabs(thisErr), seek_result, solutionTol, solutionTolType)) {
+			eCode = SOLVE_CONVERGE;
+			break;
+		}
+		if (i == max_iterations) break;
+		
+		thisSlope = (*df)(thisGuess, ctx);
+		if ((thisSlope == 0.0) || !isfinite(thisSlope)) {
+			eCode = SOLVE_ZERO_SLOPE;
+			break;
+		}
+		
+		thisGuess -= thisErr / thisSlope;
+	}
+	
+	slvLaneResult(&solution, thisGuess, i, eCode);
 return solution ;
 }
 
 
 
+/*  Newton Raphson kept within a bracket [lower, upper] which holds a root: Newton's method
+ * where it behaves, bisection where it does not.  With no derivative (df is NULL) the slope
+ * is that of the secant through the last two points, so the steps are secant steps.
+ * 
+ * A Newton step is taken only if it lands inside the bracket and the previous step
+ * at least halved the residual against the slope (the test of rtsafe in Numerical Recipes).  
+ * Otherwise the bracket is bisected.  Every iteration narrows the bracket, 
+ * so it converges even where the slope goes to zero, as at the critical point.
+*/
+
+typSolvResult  slvHybrid ( typSolvFunc f, typSolvFunc df, void *ctx, double seek_result, double in_guess, 
+							double lower, double upper, double solutionTol, int solutionTolType, long int max_iterations){
+	
+	double lowErr = (*f)(lower, ctx) - seek_result;
+	double highErr = (*f)(upper, ctx) - seek_result;
+	double negSide, posSide;  // the ends of the bracket where the error is negative and positive
+	double lastGuess = lower, lastErr = lowErr;  // the previous point, for the secant slope
+	double thisGuess, thisErr, thisSlope, nextGuess;
+	double lastStep = fabs(upper - lower), thisStep = lastStep;
+	long int i = 0;
+	typSolvResult solution;
+	
+	// either end may be a solution already
+	if (slvIsSolved(fabs(lowErr), seek_result, solutionTol, solutionTolType)) {
+		slvLaneResult(&solution, lower, i, SOLVE_CONVERGE);
+		return solution;
+	}
+	if (slvIsSolved(fabs(highErr), seek_result, solutionTol, solutionTolType)) {
+		slvLaneResult(&solution, upper, i, SOLVE_CONVERGE);
+		return solution;
+	}
+	if (!((lowErr < 0.0 && highErr > 0.0) || (lowErr > 0.0 && highErr < 0.0))) {
+		slvLaneResult(&solution, in_guess, i, SOLVE_NO_BRACKET);
+		return solution;
+	}
+	
+	negSide = (lowErr < 0.0) ? lower : upper;
+	posSide = (lowErr < 0.0) ? upper : lower;
+	
+	// start from the guess if it is inside the bracket, otherwise from the middle
+	thisGuess = (in_guess > fmin(lower, upper) && in_guess < fmax(lower, upper)) ? in_guess : 0.5 * (lower + upper);
+	thisErr = (*f)(thisGuess, ctx) - seek_result;
+	
+	for (i = 0; i <= max_iterations; i++) {
+		if (slvIsSolved(fabs(thisErr), seek_result, solutionTol, solutionTolType)) {
+			slvLaneResult(&solution, thisGuess, i, SOLVE_CONVERGE);
+			return solution;
+		}
+		if (i == max_iterations) break;
+		
+		// keep the root between negSide and posSide
+		if (thisErr < 0.0) negSide = thisGuess;
+		else               posSide = thisGuess;
+		
+		if (df != NULL) thisSlope = (*df)(thisGuess, ctx);
+		else            thisSlope = (thisErr - lastErr) / (thisGuess - lastGuess);
+		nextGuess = thisGuess - thisErr / thisSlope;
+		
+		if ((thisSlope == 0.0) || !isfinite(nextGuess)
+				|| ((nextGuess - negSide) * (nextGuess - posSide) >= 0.0)  // outside the bracket
+				|| (fabs(2.0 * thisErr) > fabs(lastStep * thisSlope))) {  // not falling fast enough
+			lastStep = thisStep;
+			nextGuess = 0.5 * (negSide + posSide);
+			thisStep = fabs(nextGuess - thisGuess);
+		}
+		else {
+			lastStep = thisStep;
+			thisStep = fabs(nextGuess - thisGuess);
+		}
+		
+		lastGuess = thisGuess;
+		lastErr = thisErr;
+		thisGuess = nextGuess;
+		thisErr = (*f)(thisGuess, ctx) - seek_result;
+	}
+	
+	slvLaneResult(&solution, thisGuess, i, SOLVE_NO_CONVERGE);
+	return solution;
+}
+
+
+
+/*  Chooses the method from what is given: the secant without a derivative or bounds, 
+ * Newton Raphson with a derivative, and the bracketed hybrid with bounds */
 
+typSolvResult  ctx_solv ( typSolvFunc f,
+							typSolvFunc df,
+							void *ctx,
+							double seek_result,
+							double in_guess,
+							double guess_tol_pct,
+							const typSolvBounds *bounds,
+							double solutionTol,
+							int solutionTolType,
+							long int max_iterations){
+	
+	if (bounds != NULL) 
+		return slvHybrid(f, df, ctx, seek_result, in_guess, bounds->dblLower, bounds->dblUpper, solutionTol, solutionTolType, max_iterations);
+	if (df != NULL) 
+		return slvNewton(f, df, ctx, seek_result, in_guess, solutionTol, solutionTolType, max_iterations);
+	return slvSecant(f, ctx, seek_result, in_guess, guess_tol_pct, solutionTol, solutionTolType, max_iterations);
+}
 
 
 
 
+//***************************************************************
+//****** SOLVERS ON TWO VARIABLE FUNCTIONS **********************
 
+/* the context of a two variable function, one variable of which is held constant */
+typedef struct sctSolvPair {
+	double (*func)(double, double);
+	double (*deriv)(double, double);
+	double funcConst;
+	bool isFuncConstPos1;
+} typSolvPair;
 
-/*  Use Newton Raphson if the first derivatives are know and are known not
- * to have discontinuities.  Do NOT use it near discontinuities. 
- * i.e. not v(p,t) near critical point.  not straddling the saturation 
- * line on the P, T plane   
-*/
 
+double slvPairFunc(double x, void *ctx){
+	typSolvPair *pair = ctx;
+	
+	if (pair->isFuncConstPos1 == true) return (*pair->func)(pair->funcConst, x);
+	else                               return (*pair->func)(x, pair->funcConst);
+}
+
+
+double slvPairDeriv(double x, void *ctx){
+	typSolvPair *pair = ctx;
+	
+	if (pair->isFuncConstPos1 == true) return (*pair->deriv)(pair->funcConst, x);
+	else                               return (*pair->deriv)(x, pair->funcConst);
+}
 
 
+typSolvResult  secant_solv ( double (*func)(double, double),  // pointer to the function. one variable is known (held constant), the other is sought.
+							double funcConst, //  the function variable which is held constant
+							bool isFuncConstPos1,  // is input held constant the first of the two function variables? (false if it is the second)
+							double seek_result,  // the (known) result of the function when the sought variable is correct.
+							double in_guess,  // initial guess of the sought variable
+							double guess_tol_pct, //  
+							double solutionTol, //
+							int solutionTolType, //	SLV_SIG_FIG, SLV_ABS, SLV_PERCENT, - in this case defined in IF97_common.h
+							long int max_iterations){   // maximum number of iterations to attempt before declaring an error
+	
+	typSolvPair pair = {func, NULL, funcConst, isFuncConstPos1};
+	
+	return slvSecant(slvPairFunc, &pair, seek_result, in_guess, guess_tol_pct, solutionTol, solutionTolType, max_iterations);
+}
+
+
+typSolvResult  newton_solv ( double (*func)(double, double),
+							double (*deriv)(double, double),
+							double funcConst,
+							bool isFuncConstPos1,
+							double seek_result,
+							double in_guess,
+							double solutionTol,
+							int solutionTolType,
+							long int max_iterations){
+	
+	typSolvPair pair = {func, deriv, funcConst, isFuncConstPos1};
+	
+	return slvNewton(slvPairFunc, slvPairDeriv, &pair, seek_result, in_guess, solutionTol, solutionTolType, max_iterations);
+}
+
+
+typSolvResult  hybrid_solv ( double (*func)(double, double),
+							double (*deriv)(double, double),
+							double funcConst,
+							bool isFuncConstPos1,
+							double seek_result,
+							double in_guess,
+							double lower,
+							double upper,
+							double solutionTol,
+							int solutionTolType,
+							long int max_iterations){
+	
+	typSolvPair pair = {func, deriv, funcConst, isFuncConstPos1};
+	
+	return slvHybrid(slvPairFunc, slvPairDeriv, &pair, seek_result, in_guess, lower, upper, solutionTol, solutionTolType, max_iterations);
+}
+
+
+
+
+//***************************************************************
+//****** SOLVERS ON ARRAYS **************************************
+
+/* puts the held constant and the guess of lane k into position j of the function inputs */
+void slvPlace(const double *funcConst, bool isFuncConstPos1, double guess, int k, int j, double *in1, double *in2){
+	if (isFuncConstPos1 == true) {
+		in1[j] = funcConst[k];
+		in2[j] = guess;
+	}
+	else {
+		in1[j] = guess;
+		in2[j] = funcConst[k];
+	}
+}
+
+
+/*  Secant method for n lanes in lock step.  The steps of each lane are those of 
+ * secant_solv.  The lanes still to be solved are listed in iActive, and their 
+ * inputs packed into in1 and in2 for each call of func */
+
+void secant_solv_n ( void (*func)(const double *, const double *, double *, int),
+							const double *funcConst,
+							bool isFuncConstPos1,
+							const double *seek_result,
+							const double *in_guess,
+							double guess_tol_pct,
+							double solutionTol,
+							int solutionTolType,
+							long int max_iterations,
+							typSolvResult *solutions,
+							int n){
+
+	double *lastGuess, *lastErr, *thisGuess, *thisErr, *nextGuess, *in1, *in2, *out;
+	double *dblWork = malloc(11 * (size_t) n * sizeof(double));  // the lane states, then the inputs and outputs for two guesses per lane
+	int *iActive = malloc((size_t) n * sizeof(int));
+	double nextErr;
+	long int i = 0;
+	int j, k, m = 0, mNext;
+
+	if ((dblWork == NULL) || (iActive == NULL)) {
+		for (k = 0; k < n; k++) {
+			solutions[k].dSolution = in_guess[k];
+			solutions[k].lIterations = 0;
+			solutions[k].iErrCode = SOLVE_NO_MEMORY;
+		}
+		free(dblWork);
+		free(iActive);
+		return;
+	}
+	lastGuess = dblWork;
+	lastErr = lastGuess + n;
+	thisGuess = lastErr + n;
+	thisErr = thisGuess + n;
+	nextGuess = thisErr + n;
+	in1 = nextGuess + n;
+	in2 = in1 + 2 * n;
+	out = in2 + 2 * n;
+
+	// first, check the initial guesses.  Maybe they are right first time.
+	for (k = 0; k < n; k++) {
+		lastGuess[k] = in_guess[k];
+		thisGuess[k] = in_guess[k] * (1 + guess_tol_pct/100.0);
+		nextGuess[k] = in_guess[k] * (1 - guess_tol_pct/100.0);
+		slvPlace(funcConst, isFuncConstPos1, lastGuess[k], k, k, in1, in2);
+	}
+	if (n > 0) (*func)(in1, in2, out, n);
+	for (k = 0; k < n; k++) {
+		lastErr[k] = fabs(out[k] - seek_result[k]);
+		if (slvIsSolved(lastErr[k], seek_result[k], solutionTol, solutionTolType)) slvLaneResult(&solutions[k], lastGuess[k], i, SOLVE_CONVERGE);
+		else iActive[m++] = k;
+	}
+
+	// the guesses either side of the initial guess, the closest of which is kept as thisGuess
+	for (j = 0; j < m; j++) {
+		k = iActive[j];
+		slvPlace(funcConst, isFuncConstPos1, thisGuess[k], k, j, in1, in2);
+		slvPlace(funcConst, isFuncConstPos1, nextGuess[k], k, m + j, in1, in2);
+	}
+	if (m > 0) (*func)(in1, in2, out, 2 * m);
+	for (j = 0; j < m; j++) {
+		k = iActive[j];
+		if (fabs(out[j] - seek_result[k]) > fabs(out[m + j] - seek_result[k])) {
+			thisGuess[k] = nextGuess[k];
+			out[j] = out[m + j];
+		}
+		thisErr[k] = fabs((out[j] - seek_result[k]));
+	}
+
+	// Iterate the lanes not yet solved, dropping each as it converges
+	for (i = 1; (i <= max_iterations) && (m > 0); i++) {
+		for (j = 0; j < m; j++) {
+			k = iActive[j];
+			nextGuess[k] = thisGuess[k] - ( (thisErr[k] * ( thisGuess[k] - lastGuess[k]))
+										/ (thisErr[k] - lastErr[k])      );
+			slvPlace(funcConst, isFuncConstPos1, nextGuess[k], k, j, in1, in2);
+		}
+		(*func)(in1, in2, out, m);
+
+		mNext = 0;
+		for (j = 0; j < m; j++) {
+			k = iActive[j];
+			nextErr = fabs((out[j] - seek_result[k]));
+			if (slvIsSolved(nextErr, seek_result[k], solutionTol, solutionTolType)) {
+				slvLaneResult(&solutions[k], nextGuess[k], i, SOLVE_CONVERGE);
+				continue;
+			}
+			lastGuess[k] = thisGuess[k];
+			lastErr[k] = thisErr[k];
+			thisGuess[k] = nextGuess[k];
+			thisErr[k] = nextErr;
+			iActive[mNext++] = k;
+		}
+		m = mNext;
+	}
+
+	// the lanes left have exceeded the maximum number of iterations without converging
+	for (j = 0; j < m; j++) slvLaneResult(&solutions[iActive[j]], nextGuess[iActive[j]], i, SOLVE_NO_CONVERGE);
+
+	free(dblWork);
+	free(iActive);
+}
+
+
+
+
+//***************************************************************
+//****** NEWTON IN TWO VARIABLES ********************************
+
+#define SLV_LINE_HALVINGS 20  // halvings of a Newton step allowed to the line search
+
+/*  the size of error which slvIsSolved accepts, as an absolute value, to measure each residual against */
+double slvTolAbs(double seek_result, double solutionTol, int solutionTolType){
+	double dblTol = 1.0;
+	
+	switch (solutionTolType){
+		case SLV_PERCENT:
+			dblTol = fabs(seek_result) * solutionTol / 100.0;
+			break;
+		case SLV_ABS:
+			dblTol = solutionTol;
+			break;
+		case SLV_SIG_FIG:
+			dblTol = pow(10, -solutionTol);
+			break;
+	}
+	return (dblTol > 0.0) ? dblTol : 1.0;
+}
+
+
+/*  the measure of two residuals, each already divided by its tolerance, which the line search reduces */
+double slvMerit(double dblErr0, double dblErr1){
+	return dblErr0 * dblErr0 + dblErr1 * dblErr1;
+}
+
+
+/*  the full step from thisGuess, or the largest fraction of it (halving each time) which 
+ * reduces the merit by the Armijo condition.  The point reached is put in nextGuess, 
+ * nextF and nextJac.  false if no fraction does */
+bool slvLineSearch(typSolvFunc2 f, void *ctx, const double *seek_result, const double *dblTol, const double *thisGuess, 
+							const double *step, double thisMerit, double *nextGuess, double *nextF, double *nextJac){
+	double dblFrac = 1.0;
+	int j;
+	
+	for (j = 0; j <= SLV_LINE_HALVINGS; j++, dblFrac /= 2.0) {
+		nextGuess[0] = thisGuess[0] + dblFrac * step[0];
+		nextGuess[1] = thisGuess[1] + dblFrac * step[1];
+		if (!(*f)(nextGuess, ctx, nextF, nextJac)) continue;
+		
+		if (slvMerit((nextF[0] - seek_result[0]) / dblTol[0], (nextF[1] - seek_result[1]) / dblTol[1]) 
+				<= (1.0 - 2e-4 * dblFrac) * thisMerit) 
+			return true;
+	}
+	return false;
+}
+
+
+/*  Newton Raphson on two variables.  The step solves J dx = -err by Cramer's rule.
+ * Each variable's part of the step is then cut to no more than its max_step.  If no 
+ * fraction of the cut step is accepted, the line search is tried on the Newton step itself.
+ * The line search keeps a step only if it reduces the sum of the squared residuals, 
+ * each divided by its tolerance, by the Armijo condition.  Otherwise the step is
+ * halved.  If no fraction of the step is accepted, the iteration stops there */
+
+typSolvResult2  newton2_solv ( typSolvFunc2 f,
+							void *ctx,
+							const double *seek_result,
+							const double *in_guess,
+							const double *max_step,
+							const double *solutionTol,
+							int solutionTolType,
+							long int max_iterations){
+	
+	double thisGuess[2] = {in_guess[0], in_guess[1]};
+	double nextGuess[2], thisF[2], nextF[2], thisJac[4], nextJac[4], step[2], cutStep[2], err[2], dblTol[2];
+	double thisMerit, dblDet;
+	bool isCut;
+	long int i;
+	int k;
+	int eCode = SOLVE_NO_CONVERGE;  // unless it converges below
+	typSolvResult2 solution;
+	
+	for (k = 0; k < 2; k++) dblTol[k] = slvTolAbs(seek_result[k], solutionTol[k], solutionTolType);
+	
+	if (!(*f)(thisGuess, ctx, thisF, thisJac)) {
+		eCode = SOLVE_NOT_DEFINED;
+		i = 0;
+	}
+	else for (i = 0; i <= max_iterations; i++) {
+		for (k = 0; k < 2; k++) err[k] = thisF[k] - seek_result[k];
+		
+		if (slvIsSolved(fabs(err[0]), seek_result[0], solutionTol[0], solutionTolType)
+				&& slvIsSolved(fabs(err[1]), seek_result[1], solutionTol[1], solutionTolType)) {
+			eCode = SOLVE_CONVERGE;
+			break;
+		}
+		if (i == max_iterations) break;
+		
+		dblDet = thisJac[0] * thisJac[3] - thisJac[1] * thisJac[2];
+		if ((dblDet == 0.0) || !isfinite(dblDet)) {
+			eCode = SOLVE_ZERO_SLOPE;
+			break;
+		}
+		step[0] = (thisJac[1] * err[1] - thisJac[3] * err[0]) / dblDet;
+		step[1] = (thisJac[2] * err[0] - thisJac[0] * err[1]) / dblDet;
+		isCut = false;
+		for (k = 0; k < 2; k++) {
+			cutStep[k] = step[k];
+			if ((max_step != NULL) && (fabs(step[k]) > max_step[k])) {
+				cutStep[k] = (step[k] > 0.0) ? max_step[k] : -max_step[k];
+				isCut = true;
+			}
+		}
+		
+		// the cut step, or if no part of it reduces the residuals, the Newton step
+		thisMerit = slvMerit(err[0] / dblTol[0], err[1] / dblTol[1]);
+		if (!slvLineSearch(f, ctx, seek_result, dblTol, thisGuess, cutStep, thisMerit, nextGuess, nextF, nextJac)
+				&& (!isCut || !slvLineSearch(f, ctx, seek_result, dblTol, thisGuess, step, thisMerit, nextGuess, nextF, nextJac))) 
+			break;
+		
+		for (k = 0; k < 2; k++) {
+			thisGuess[k] = nextGuess[k];
+			thisF[k] = nextF[k];
+		}
+		for (k = 0; k < 4; k++) thisJac[k] = nextJac[k];
+	}
+	
+	solution.dSolution[0] = thisGuess[0];
+	solution.dSolution[1] = thisGuess[1];
+	solution.lIterations = i;
+	solution.iErrCode = eCode;
+	IF97_STATS_SOLVE(i, eCode);
+return solution ;
+}
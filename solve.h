@@ -32,7 +32,7 @@
  * @author Martin Lord
  * @date 08 June 2015
  * @brief solver intended for property tables
- * @details   So far, there is a Secant Solver implimented
+ * @details   Secant, Newton Raphson and bracketed Newton Raphson solvers are implimented
  */
 
 
@@ -48,6 +48,10 @@
 // bitwise test error codes. //
 #define SOLVE_CONVERGE 0   //Solver reports solution found
 #define SOLVE_NO_CONVERGE 8 // A solution did not converge within the maximum allowed number of iterations
+#define SOLVE_NO_MEMORY 16 // working memory for a batch could not be allocated.  Nothing was solved
+#define SOLVE_ZERO_SLOPE 32 // the derivative was zero (or not finite) so a Newton step could not be taken
+#define SOLVE_NO_BRACKET 64 // the function does not change sign between the bracket limits
+#define SOLVE_NOT_DEFINED 128 // the function could not be evaluated at the initial guess
 
 
 typedef struct sctSolvResult {
@@ -64,6 +68,57 @@ enum SlvTolType{
 };
 
 
+/** a function of the sought variable x, with anything else it needs in ctx */
+typedef double (*typSolvFunc)(double x, void *ctx);
+
+
+/** a function of two sought variables x[0], x[1], with anything else it needs in ctx.
+ * Sets its two results in f and, if jac is not NULL, their Jacobian, row major:
+ * jac[2 * i + j] is [d f[i] / d x[j]].  Returns false if it cannot be evaluated at x */
+typedef bool (*typSolvFunc2)(const double *x, void *ctx, double *f, double *jac);
+
+
+/** solution of a problem in two variables */
+typedef struct sctSolvResult2 {
+	double dSolution[2];
+	long int lIterations;
+	int iErrCode;
+} typSolvResult2;
+
+
+/** limits which bracket a solution */
+typedef struct sctSolvBounds {
+	double dblLower;
+	double dblUpper;
+} typSolvBounds;
+
+
+/**  Solver on a function of one variable, f(x, ctx), which carries its own context:
+ * ctx is passed to every call of f and df unchanged, so may hold the held constant 
+ * variables, a unit set, or work to be reused from one iteration to the next 
+ * (e.g. a density or region found on the first call).  Nothing global is needed, 
+ * so it is thread safe if f is.
+ * 
+ * The method is chosen from what is given:
+ *  - bounds NULL, df NULL:  the secant method, exactly as secant_solv (guess_tol_pct is used)
+ *  - bounds NULL, df given: Newton Raphson, as newton_solv
+ *  - bounds given: the bracketed hybrid, as hybrid_solv.  Without df its steps are secant steps
+ * 
+ * secant_solv, newton_solv and hybrid_solv call this with the two variable function as the context
+ */
+typSolvResult  ctx_solv ( typSolvFunc f,  // function of the sought variable.
+							typSolvFunc df,  // derivative of f with respect to x, or NULL if it is not known
+							void *ctx,  // passed to f and df
+							double seek_result,  // the (known) result of f when the sought variable is correct.
+							double in_guess,  // initial guess of the sought variable
+							double guess_tol_pct, //  offset of the second guess, for the secant method
+							const typSolvBounds *bounds,  // limits which bracket the solution, or NULL
+							double solutionTol, //
+							int solutionTolType, //	SIG_FIG, ABS, PERCENT, - in this case defined in IF97_common.h
+							long int max_iterations);   // maximum number of iterations to attempt before declaring an error
+
+
+
 /**  Secant method for two variable PDE:
  * Use this if Newton Raphson doesn't solve or if the derivatives are not known.
  *  
@@ -95,5 +150,100 @@ typSolvResult  secant_solv ( double (*func)(double, double),  // pointer to the
 
 
 
+/**  Secant method for n independent problems at once, in lock step.
+ * 
+ * Each problem (lane) is as for secant_solv, with its own held constant, sought result 
+ * and initial guess.  func evaluates the function for arrays of n1 inputs:
+ * func(in1, in2, out, n1), where in1 and in2 are as the two variables of secant_solv's func.
+ * It is called once per iteration on the lanes not yet solved, so the lanes can be
+ * evaluated together (vectorised, or shared between threads) and a lane which 
+ * has converged costs nothing more.  
+ * 
+ * Each lane takes the same steps as secant_solv would, so solutions[k] is as 
+ * secant_solv gives for lane k: the solution, the iterations it took and its error code. 
+ * If the working memory cannot be allocated, every lane has the error code SOLVE_NO_MEMORY
+ */
+void secant_solv_n ( void (*func)(const double *, const double *, double *, int),  // evaluates the function for arrays of inputs
+							const double *funcConst, //  the function variable held constant, for each lane
+							bool isFuncConstPos1,  // is input held constant the first of the two function variables? (false if it is the second)
+							const double *seek_result,  // the (known) result of the function for each lane
+							const double *in_guess,  // initial guess of the sought variable for each lane
+							double guess_tol_pct, //  
+							double solutionTol, //
+							int solutionTolType, //	SIG_FIG, ABS, PERCENT, - in this case defined in IF97_common.h
+							long int max_iterations,   // maximum number of iterations to attempt before declaring an error
+							typSolvResult *solutions,  // the result for each lane
+							int n);  // number of lanes
+
+
+
+/**  Newton Raphson method for two variable PDE:
+ * Use this if the first derivative with respect to the sought variable is known, and 
+ * has no discontinuities between the guess and the solution.  Converges quadratically
+ * from a good guess, so needs fewer iterations than secant_solv.  
+ * 
+ * deriv takes the same two variables as func, and returns the derivative of func with
+ * respect to the sought one. e.g. to find t(p,h) from h(p,t), deriv is Cp(p,t).
+ * The solution is accepted as secant_solv does.  If the derivative is zero
+ * the error code is SOLVE_ZERO_SLOPE, and the solution is the last guess.
+ */
+typSolvResult  newton_solv ( double (*func)(double, double),  // pointer to the function. one variable is known (held constant), the other is sought.
+							double (*deriv)(double, double),  // derivative of func with respect to the sought variable
+							double funcConst, //  the function variable which is held constant
+							bool isFuncConstPos1,  // is input held constant the first of the two function variables? (false if it is the second)
+							double seek_result,  // the (known) result of the function when the sought variable is correct.
+							double in_guess,  // initial guess of the sought variable
+							double solutionTol, //
+							int solutionTolType, //	SIG_FIG, ABS, PERCENT, - in this case defined in IF97_common.h
+							long int max_iterations);   // maximum number of iterations to attempt before declaring an error
+
+
+
+/**  Newton Raphson method, safeguarded by a bracket:
+ * As newton_solv, but the solution is kept between lower and upper, which must
+ * bracket it (func - seek_result changes sign between them).  A Newton step which 
+ * would leave the bracket, or which is not reducing the error quickly enough, is 
+ * replaced by bisection.  Use this where the derivative may vanish, e.g. for density near 
+ * the critical point.  If lower and upper do not bracket a solution, the error code is 
+ * SOLVE_NO_BRACKET and the solution is in_guess
+ */
+typSolvResult  hybrid_solv ( double (*func)(double, double),  // pointer to the function. one variable is known (held constant), the other is sought.
+							double (*deriv)(double, double),  // derivative of func with respect to the sought variable
+							double funcConst, //  the function variable which is held constant
+							bool isFuncConstPos1,  // is input held constant the first of the two function variables? (false if it is the second)
+							double seek_result,  // the (known) result of the function when the sought variable is correct.
+							double in_guess,  // initial guess of the sought variable.  The middle of the bracket is used if it is outside
+							double lower,  // one end of the bracket
+							double upper,  // the other end of the bracket
+							double solutionTol, //
+							int solutionTolType, //	SIG_FIG, ABS, PERCENT, - in this case defined in IF97_common.h
+							long int max_iterations);   // maximum number of iterations to attempt before declaring an error
+
+
+
+/**  Newton Raphson method in two variables, with a line search:
+ * solves f(x, ctx) = seek_result for the two variables x, from the analytic Jacobian 
+ * given by f.  Each result is accepted as secant_solv accepts one, against its own 
+ * solutionTol.  
+ * 
+ * Where the full Newton step does not reduce the residuals (each measured against 
+ * its tolerance), or lands where f cannot be evaluated, it is halved until it does.
+ * The line search makes it far less sensitive to the initial guess than the plain 
+ * iteration.  If max_step is not NULL, the step in each variable is first cut to no 
+ * more than max_step for that variable, so that an error in one variable cannot throw 
+ * the other far from the solution.  If the Jacobian is singular the error code is SOLVE_ZERO_SLOPE, if f
+ * cannot be evaluated at in_guess it is SOLVE_NOT_DEFINED.  The solution is the last point reached
+ */
+typSolvResult2  newton2_solv ( typSolvFunc2 f,  // the two functions of the two sought variables, and their Jacobian
+							void *ctx,  // passed to f
+							const double *seek_result,  // the two (known) results of f at the solution
+							const double *in_guess,  // initial guess of the two sought variables
+							const double *max_step,  // largest step allowed in each variable, or NULL
+							const double *solutionTol, //  tolerance of each result
+							int solutionTolType, //	SIG_FIG, ABS, PERCENT, - in this case defined in IF97_common.h
+							long int max_iterations);   // maximum number of iterations to attempt before declaring an error
+
+
+
 #endif //SOLVE_H
 
@@ -14,7 +14,7 @@
 #include "solve.h"
 #include "IF97_common.h"
 #include "if97_lib_test.h"
-#include "if97_Region3.h"
+#include "IF97_Region3.h"
 #include <stdio.h>
 
 int solve_test (FILE *logFile){	
@@ -16,7 +16,7 @@
 #include "solve.h"
 #include "IF97_common.h"
 #include "if97_lib_test.h"
-#include "if97_Region3.h"
+#include "IF97_Region3.h"
 #include <stdio.h>
 
 /** run the tests on the solver module  **/ 
@@ -17,6 +17,10 @@
 #include <stdio.h>
 #include <float.h>
 
+#ifndef UNITS_HASHGEN  // units_hashgen.c compiles this file to build the hash, so cannot use it
+#include <units_hash.h>  // perfect hash of the unit symbols and names, generated by units_hashgen.c.  <> so that the include path decides which copy
+#endif
+
 
 
 
@@ -26,6 +30,8 @@ const typUnit builtInUnits[] = {
 	#include "built_in_units.dat" 
 };
 
+const int NUM_BUILT_IN_UNITS = sizeof (builtInUnits) / sizeof (typUnit);
+
 
 
 double applyCoeffs (double input, typConvCoeffs coeffs) {
@@ -67,7 +73,9 @@ strcpy(char *s1, const char *s2)
 	return (strOutput);  //return a pointer to the lowercase string
 }
 				
-int getUnitIndex ( const char strUnit[]){
+/* finds a unit by searching the table: first the symbols, then the names, then (for strings
+ * of 5 or more characters) the lowercase names.  The first match wins */
+int scanUnitIndex ( const char strUnit[]){
 
 	int i = 0;
 
@@ -76,13 +84,13 @@ int getUnitIndex ( const char strUnit[]){
 //	printf ("endIndex = %i\n", endIndex);
 
 	// try matching the unit symbol with the input text
-	while ((strcmp(builtInUnits[i].strSymbol, strUnit) != 0) && (i <= endIndex) ){       
+	while ((i <= endIndex) && (strcmp(builtInUnits[i].strSymbol, strUnit) != 0)){       
       i++;       
 	}	  
 	if (i <= endIndex) return i ;
   
 	i = 0;  // reset i and try again with the full names
-	while ((strcmp(builtInUnits[i].strName, strUnit) != 0) && (i <= endIndex) ){       
+	while ((i <= endIndex) && (strcmp(builtInUnits[i].strName, strUnit) != 0)){       
       i++;        
 	}	  
 	if (i <= endIndex) return i ;
@@ -91,7 +99,7 @@ int getUnitIndex ( const char strUnit[]){
 	i = 0; // reset i and try again with lowercase names
 	if (strlen(strUnit) < 5) return -1 ;  // but only for long strigs to avaid mismatching mPa with MPA mREM with MREM etc.
 	char strLowercase [NAMESTRLEN] ="";
-	while ((strcmp(lowercase(strLowercase, builtInUnits[i].strName, NAMESTRLEN), strUnit) != 0) && (i <= endIndex) ){       
+	while ((i <= endIndex) && (strcmp(lowercase(strLowercase, builtInUnits[i].strName, NAMESTRLEN), strUnit) != 0)){       
       i++;        
 	}	  
 	if (i <= endIndex) return i ;
@@ -103,6 +111,39 @@ return -1; //failed to find the unit
 
 
 
+
+
+/* FNV-1a hash of a unit string, varied by seed.  Shared with units_hashgen.c, which
+ * chooses the seeds of the perfect hash */
+unsigned int unitHash (const char strUnit[], unsigned int seed){
+	unsigned int h = 2166136261u ^ (seed * 2654435761u);
+	
+	while (*strUnit != 0) {
+		h ^= (unsigned char) *strUnit++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+
+/* the hashed lookup gives the same unit as scanUnitIndex: the generator resolved each string
+ * with it.  If built_in_units.dat has changed since the hash was generated, fall back to the scan */
+int getUnitIndex ( const char strUnit[]){
+
+#ifndef UNITS_HASHGEN
+	if (UNITS_HASH_NUM_UNITS == NUM_BUILT_IN_UNITS) {
+		unsigned int slot = unitHash(strUnit, UNITS_HASH_SEED[unitHash(strUnit, 0) % UNITS_HASH_NUM_BUCKETS]) % UNITS_HASH_NUM_SLOTS;
+
+		if ((UNITS_HASH_INDEX[slot] >= 0) && (strcmp(UNITS_HASH_KEY[slot], strUnit) == 0)) return UNITS_HASH_INDEX[slot];
+		return -1;
+	}
+#endif
+
+return scanUnitIndex(strUnit);
+}
+
+
+
 typConvCoeffs getCoeffs (int UnitIndex){
 	
 	return builtInUnits[UnitIndex].tConvCoeffs;
@@ -117,38 +158,44 @@ double convertUnit (double inVal, int inUnit, int outUnit){
 }
 
 
-double convertNamedUnit (double inVal, const char strInUnit[], const char strOutUnit[]){
-	if (strcmp(strInUnit, strOutUnit) == 0) return inVal; //if the input unit is the output unit return unchanged
+typUnitConv getUnitConv (const char strInUnit[], const char strOutUnit[]){
+	typUnitConv tConv = { 1.0, 0.0, true };  // the same unit is returned unchanged
+	typConvCoeffs tIn, tOut;
+	int inUnitIndex, outUnitIndex;
+	
+	if (strcmp(strInUnit, strOutUnit) == 0) return tConv;
 	
-	int inUnitIndex = -1;
-	int outUnitIndex = -1;
-	char strInUnitSI[NAMESTRLEN] = "void";
-	char strOutUnitSI[NAMESTRLEN] = "void";
-	double valSI = DBL_MIN;
+	inUnitIndex = getUnitIndex( strInUnit);
+	outUnitIndex = getUnitIndex( strOutUnit);
 	
+	if ((inUnitIndex < 0) || (outUnitIndex < 0) 
+			|| (strcmp(builtInUnits[inUnitIndex].strConvertsTo, builtInUnits[outUnitIndex].strConvertsTo) != 0)) {
+		tConv.isValid = false;  //Error  unknown or incompatible units.  TODO may need code to go through an intermediate conversion step
+		return tConv;
+	}
+	
+	// in to SI:  valSI = inVal * in[1] + in[0].   SI to out:  (valSI - out[0]) / out[1]
+	tIn = builtInUnits[inUnitIndex].tConvCoeffs;
+	tOut = builtInUnits[outUnitIndex].tConvCoeffs;
+	tConv.dblScale = tIn.dblPow[1] / tOut.dblPow[1];
+	tConv.dblOffset = (tIn.dblPow[0] - tOut.dblPow[0]) / tOut.dblPow[1];
+	
+	return tConv;
+}
 
+
+
+double applyUnitConv (double inVal, typUnitConv tConv){
+	if (!tConv.isValid) return DBL_MIN;
 	
-	inUnitIndex = getUnitIndex( strInUnit);
-	strcpy ( strInUnitSI, builtInUnits[inUnitIndex].strConvertsTo);
-	// printf ("SI Unit is = %s\n", strInUnitSI);  // uncomment for debugging
+	return inVal * tConv.dblScale + tConv.dblOffset;
+}
 
-	outUnitIndex = getUnitIndex( strOutUnit);
-	strcpy ( strOutUnitSI, builtInUnits[outUnitIndex].strConvertsTo);
-	
-	if(strcmp(strInUnitSI, strOutUnitSI) == 0) {  // OK - compatible units
-		
-		// First convert to the SI unit
-		valSI = inVal * builtInUnits[inUnitIndex].tConvCoeffs.dblPow[1] + builtInUnits[inUnitIndex].tConvCoeffs.dblPow[0];
-		
-		
-		//printf( "%f  %s\n", valSI, strInUnitSI);  // uncomment for debugging
-		
-		// then convert from the SI unit to the output unit
-		return (valSI - builtInUnits[outUnitIndex].tConvCoeffs.dblPow[0]) / builtInUnits[outUnitIndex].tConvCoeffs.dblPow[1] ;
-		
-		}
-		
-	return DBL_MIN;  //Error  incompatible units.  TODO may need code to go through an intermediate conversion step
+
+
+double convertNamedUnit (double inVal, const char strInUnit[], const char strOutUnit[]){
+	
+	return applyUnitConv (inVal, getUnitConv (strInUnit, strOutUnit));
 }
 
 
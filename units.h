@@ -98,6 +98,15 @@ typedef struct sctUnit {
 } typUnit;
 
 
+/* a conversion between two units, resolved once by getUnitConv so that 
+ * it can be applied repeatedly without looking the units up again */
+typedef struct sctUnitConv {
+	double dblScale;	// out = in * dblScale + dblOffset
+	double dblOffset;
+	bool isValid;		// false if either unit is unknown or they are incompatible
+} typUnitConv;
+
+
 
 
 /* *********************************************************************
@@ -107,9 +116,16 @@ typedef struct sctUnit {
 
 
 
-/** gets the index of the unit for passing to other functions */
+/** gets the index of the unit for passing to other functions.  Symbols are matched before 
+ * names, and names before lowercase names (5 or more characters only).  -1 if not found */
 int getUnitIndex ( const char strUnit[]);
 
+/** as getUnitIndex, by searching the table rather than by the perfect hash */
+int scanUnitIndex ( const char strUnit[]);
+
+/** the hash of a unit string used by the perfect hash in units_hash.h */
+unsigned int unitHash (const char strUnit[], unsigned int seed);
+
 /** get the conversion coefficients corresponding to UnitIndex */
 typConvCoeffs getCoeffs (int UnitIndex);
 
@@ -120,6 +136,13 @@ double convertUnit (double inVal, int inUnit, int outUnit);
  * indices from the names.  Error value equal to DBL_MIN in <float.h>*/
 double convertNamedUnit (double inVal, const char strInUnit[], const char strOutUnit[]);
 
+/** resolves the conversion from strInUnit to strOutUnit once, for use by applyUnitConv.  
+ * isValid is false if either unit is unknown or they are incompatible */
+typUnitConv getUnitConv (const char strInUnit[], const char strOutUnit[]);
+
+/** converts inVal with a conversion from getUnitConv.  Error value equal to DBL_MIN in <float.h>*/
+double applyUnitConv (double inVal, typUnitConv tConv);
+
 double isCompatible (int inUnit, int outUnit);
 
 
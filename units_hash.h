@@ -0,0 +1,111 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+//  GENERATED BY units_hashgen FROM built_in_units.dat.  DO NOT EDIT
+
+//  Perfect hash of the unit symbols and names, for getUnitIndex in units.c
+//  slot = unitHash(str, UNITS_HASH_SEED[unitHash(str, 0) % UNITS_HASH_NUM_BUCKETS]) % UNITS_HASH_NUM_SLOTS
+
+#ifndef UNITS_HASH_H
+#define UNITS_HASH_H
+
+#define UNITS_HASH_NUM_UNITS 32  // rows of builtInUnits when generated
+#define UNITS_HASH_NUM_BUCKETS 16
+#define UNITS_HASH_NUM_SLOTS 76
+
+const unsigned int UNITS_HASH_SEED[UNITS_HASH_NUM_BUCKETS] = {
+	10, 7, 14, 2, 5, 5, 1, 14, 82, 1, 19, 18, 1, 18, 0, 11
+};
+
+// the string in each slot, and the index of its unit in builtInUnits.  -1 is an empty slot
+const char *const UNITS_HASH_KEY[UNITS_HASH_NUM_SLOTS] = {
+	 "kJ(kg K)"
+	,""
+	,""
+	,"K"
+	,"Joule per kilogram"
+	,"btu/lb/f"
+	,"kCal/kg/K"
+	,"W/(m C)"
+	,"kg/cm2"
+	,""
+	,"kCal/kg"
+	,""
+	,""
+	,"BTU/(lb F)"
+	,""
+	,"m3/kg"
+	,"void"
+	,"\302\260F"
+	,"at"
+	,""
+	,"btu/lb"
+	,"J/(kg K)"
+	,"technical atmosphere"
+	,""
+	,"j/kg/k"
+	,"MPa"
+	,"-"
+	,"\302\260K"
+	,""
+	,"kCal/kg/C"
+	,"kcal/kg"
+	,"w/m/c"
+	,"pascal"
+	,"btu/lb/F"
+	,"kj/kg/c"
+	,""
+	,"J/kg/K"
+	,"\302\260R"
+	,"kj/kg"
+	,""
+	,"kCal/ (kg K)"
+	,"kcal/kg/c"
+	,"kJ/kg"
+	,"kPa"
+	,"BTU/lb"
+	,"ata"
+	,"F"
+	,"w/m/k"
+	,"kJ/kg/K"
+	,"Pa"
+	,"kJ/kg/C"
+	,"W/m/C"
+	,"psia"
+	,""
+	,"J/kg"
+	,""
+	,""
+	,"ft3/lb"
+	,"kcal/kg/k"
+	,"W/(m K)"
+	,"C"
+	,"kJ/(kg K)"
+	,""
+	,"kCal/(kg K)"
+	,"Pascal"
+	,"joule per kilogram kelvin"
+	,""
+	,"\302\260C"
+	,"joule per kilogram"
+	,"btu/(lbm F)"
+	,"psig"
+	,"bar"
+	,"kj/kg/k"
+	,"kJ/(kg C)"
+	,"R"
+	,"W/m/K"
+};
+
+const int UNITS_HASH_INDEX[UNITS_HASH_NUM_SLOTS] = {
+	26, -1, -1, 2, 14, 21, 29, 31, 11, -1, 17, -1, -1, 27, -1, 23,
+	0, 5, 10, -1, 16, 18, 10, -1, 25, 13, 0, 2, -1, 22, 17, 31,
+	6, 21, 20, -1, 25, 4, 15, -1, 29, 22, 15, 12, 16, 11, 5, 30,
+	19, 6, 20, 31, 8, -1, 14, -1, -1, 24, 29, 30, 3, 19, -1, 22,
+	6, 18, -1, 3, 14, 21, 9, 7, 19, 20, 4, 30
+};
+
+#endif // UNITS_HASH_H
@@ -0,0 +1,177 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+/* *****************************************************************************
+* GENERATES units_hash.h, A PERFECT HASH OF THE UNITS IN built_in_units.dat
+*
+* Every string which getUnitIndex recognises (symbols, names and lowercase names)
+* is resolved by scanning the table as before, so the hashed lookup gives the same
+* unit, precedence included.  The hash is in two levels (hash and displace): the
+* first level picks a bucket, and each bucket has a seed for the second level which
+* puts its strings in free slots.  A lookup is then two hashes and one strcmp.
+*
+* usage: units_hashgen [output file]    (standard output if none is given)
+* *******************************************************************************/
+
+
+#define UNITS_HASHGEN
+#include "units.c"  // the same table, scan and hash function as the library
+#include <stdlib.h>
+
+
+#define MAX_KEYS 512
+#define MAX_SEED 100000
+
+
+typedef struct sctHashKey {
+	char strKey[NAMESTRLEN];
+	int iUnit;
+	unsigned int iBucket;
+} typHashKey;
+
+
+typHashKey keys[MAX_KEYS];
+int numKeys = 0;
+
+
+// adds a string and the unit it resolves to, once
+void addKey (const char strKey[]){
+	int i;
+
+	if (strKey[0] == 0) return;
+	for (i = 0; i < numKeys; i++)
+		if (strcmp(keys[i].strKey, strKey) == 0) return;
+	if (scanUnitIndex(strKey) < 0) return;
+
+	strcpy(keys[numKeys].strKey, strKey);
+	keys[numKeys].iUnit = scanUnitIndex(strKey);
+	numKeys++;
+}
+
+
+// writes a string as a C literal, escaping anything outside printable ASCII
+void printKey (FILE *out, const char strKey[]){
+	const unsigned char *c;
+
+	fputc('"', out);
+	for (c = (const unsigned char *) strKey; *c != 0; c++) {
+		if (*c == '"' || *c == '\\') fprintf(out, "\\%c", *c);
+		else if (*c < 32 || *c > 126) fprintf(out, "\\%03o", *c);
+		else fputc(*c, out);
+	}
+	fputc('"', out);
+}
+
+
+int main (int argc, char **argv){
+	int i, j, k, b, n;
+	int numBuckets, numSlots;
+	int *slotKey, *bucketSize, *bucketOrder;
+	unsigned int *bucketSeed, seed, slot;
+	unsigned int slotsTried[MAX_KEYS];
+	char strLowercase [NAMESTRLEN];
+	FILE *out = stdout;
+
+	// every string getUnitIndex can match
+	for (i = 0; i < NUM_BUILT_IN_UNITS; i++) {
+		addKey(builtInUnits[i].strSymbol);
+		addKey(builtInUnits[i].strName);
+		lowercase(strLowercase, builtInUnits[i].strName, NAMESTRLEN);
+		if (strlen(strLowercase) >= 5) addKey(strLowercase);
+	}
+
+	numBuckets = numKeys / 4 + 1;
+	numSlots = numKeys + numKeys / 4 + 1;
+	slotKey = malloc(numSlots * sizeof(int));
+	bucketSize = calloc(numBuckets, sizeof(int));
+	bucketOrder = malloc(numBuckets * sizeof(int));
+	bucketSeed = calloc(numBuckets, sizeof(unsigned int));
+	for (i = 0; i < numSlots; i++) slotKey[i] = -1;
+
+	for (i = 0; i < numKeys; i++) {
+		keys[i].iBucket = unitHash(keys[i].strKey, 0) % numBuckets;
+		bucketSize[keys[i].iBucket]++;
+	}
+
+	// place the largest buckets first, while there are most free slots
+	for (i = 0; i < numBuckets; i++) bucketOrder[i] = i;
+	for (i = 1; i < numBuckets; i++)
+		for (j = i; (j > 0) && (bucketSize[bucketOrder[j]] > bucketSize[bucketOrder[j - 1]]); j--) {
+			b = bucketOrder[j]; bucketOrder[j] = bucketOrder[j - 1]; bucketOrder[j - 1] = b;
+		}
+
+	for (i = 0; i < numBuckets; i++) {
+		b = bucketOrder[i];
+		if (bucketSize[b] == 0) break;
+
+		for (seed = 1; seed < MAX_SEED; seed++) {  // a seed for which the whole bucket lands in free, distinct slots
+			bool isFree = true;
+
+			n = 0;
+			for (j = 0; (j < numKeys) && isFree; j++) {
+				if (keys[j].iBucket != b) continue;
+				slot = unitHash(keys[j].strKey, seed) % numSlots;
+				for (k = 0; (k < n) && (slotsTried[k] != slot); k++);
+				isFree = (slotKey[slot] < 0) && (k == n);
+				slotsTried[n++] = slot;
+			}
+			if (isFree) break;
+		}
+		if (seed == MAX_SEED) {
+			fprintf(stderr, "units_hashgen: no seed found for bucket %i\n", b);
+			return 1;
+		}
+
+		bucketSeed[b] = seed;
+		for (j = 0; j < numKeys; j++)
+			if (keys[j].iBucket == b) slotKey[unitHash(keys[j].strKey, seed) % numSlots] = j;
+	}
+
+	if (argc > 1) out = fopen(argv[1], "w");
+	if (out == NULL) {
+		fprintf(stderr, "units_hashgen: cannot write %s\n", argv[1]);
+		return 1;
+	}
+
+	fprintf(out, "//          Copyright Martin Lord 2014-2017.\n");
+	fprintf(out, "// Distributed under the Boost Software License, Version 1.0.\n");
+	fprintf(out, "//    (See accompanying file LICENSE_1_0.txt or copy at\n");
+	fprintf(out, "//          http://www.boost.org/LICENSE_1_0.txt)\n\n\n");
+	fprintf(out, "//  GENERATED BY units_hashgen FROM built_in_units.dat.  DO NOT EDIT\n\n");
+	fprintf(out, "//  Perfect hash of the unit symbols and names, for getUnitIndex in units.c\n");
+	fprintf(out, "//  slot = unitHash(str, UNITS_HASH_SEED[unitHash(str, 0) %% UNITS_HASH_NUM_BUCKETS]) %% UNITS_HASH_NUM_SLOTS\n\n");
+	fprintf(out, "#ifndef UNITS_HASH_H\n#define UNITS_HASH_H\n\n");
+	fprintf(out, "#define UNITS_HASH_NUM_UNITS %i  // rows of builtInUnits when generated\n", NUM_BUILT_IN_UNITS);
+	fprintf(out, "#define UNITS_HASH_NUM_BUCKETS %i\n", numBuckets);
+	fprintf(out, "#define UNITS_HASH_NUM_SLOTS %i\n\n", numSlots);
+
+	fprintf(out, "const unsigned int UNITS_HASH_SEED[UNITS_HASH_NUM_BUCKETS] = {");
+	for (i = 0; i < numBuckets; i++) fprintf(out, "%s%s%u", (i ? "," : ""), (i % 16 ? " " : "\n\t"), bucketSeed[i]);
+	fprintf(out, "\n};\n\n");
+
+	fprintf(out, "// the string in each slot, and the index of its unit in builtInUnits.  -1 is an empty slot\n");
+	fprintf(out, "const char *const UNITS_HASH_KEY[UNITS_HASH_NUM_SLOTS] = {\n");
+	for (i = 0; i < numSlots; i++) {
+		fprintf(out, "\t%s", (i ? "," : " "));
+		if (slotKey[i] < 0) fprintf(out, "\"\"");
+		else printKey(out, keys[slotKey[i]].strKey);
+		fprintf(out, "\n");
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "const int UNITS_HASH_INDEX[UNITS_HASH_NUM_SLOTS] = {");
+	for (i = 0; i < numSlots; i++)
+		fprintf(out, "%s%s%i", (i ? "," : ""), (i % 16 ? " " : "\n\t"), (slotKey[i] < 0) ? -1 : keys[slotKey[i]].iUnit);
+	fprintf(out, "\n};\n\n#endif // UNITS_HASH_H\n");
+
+	if (out != stdout) fclose(out);
+	free(slotKey);
+	free(bucketSize);
+	free(bucketOrder);
+	free(bucketSeed);
+
+return 0;
+}
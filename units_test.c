@@ -0,0 +1,94 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* ********************************************************************
+* A SHORT PROGRAMME TO CHECK THE UNIT CONVERSIONS
+* *********************************************************************/
+
+#include "units.h"
+#include <stdio.h>
+#include <float.h>
+#include "IF97_common.h"
+#include "if97_lib_test.h"
+
+
+extern const typUnit builtInUnits[];
+extern const int NUM_BUILT_IN_UNITS;
+
+
+double units_psia_MPa (double val, double dummy) {return convertNamedUnit(val, "psia", "MPa");}
+double units_C_F (double val, double dummy) {return convertNamedUnit(val, "C", "F");}
+double units_degF_K (double val, double dummy) {return convertNamedUnit(val, "°F", "K");}
+double units_bar_kPa (double val, double dummy) {return convertNamedUnit(val, "bar", "kPa");}
+double units_psig_bar (double val, double dummy) {return convertNamedUnit(val, "psig", "bar");}
+double units_kJ_btu (double val, double dummy) {return convertNamedUnit(val, "kJ/kg", "BTU/lb");}
+double units_name_kJ (double val, double dummy) {return convertNamedUnit(val, "Joule per kilogram", "kJ/kg");}
+double units_lower_kJ (double val, double dummy) {return convertNamedUnit(val, "joule per kilogram", "kJ/kg");}
+
+// conversions through a handle resolved once
+double units_conv_psia_MPa (double val, double dummy) {return applyUnitConv(val, getUnitConv("psia", "MPa"));}
+double units_conv_C_F (double val, double dummy) {return applyUnitConv(val, getUnitConv("C", "F"));}
+
+// errors are DBL_MIN.  The same string is returned unchanged, even if not a unit
+bool units_incompatible (double val, double dummy) {return convertNamedUnit(val, "MPa", "K") == DBL_MIN;}
+bool units_unknown (double val, double dummy) {return convertNamedUnit(val, "furlong", "MPa") == DBL_MIN;}
+bool units_unknown_valid (double val, double dummy) {return getUnitConv("MPa", "furlong").isValid;}
+bool units_same (double val, double dummy) {return convertNamedUnit(val, "furlong", "furlong") == val;}
+
+// the lowercase names are only matched for 5 or more characters, so "mpa" is not "MPa"
+bool units_short_lower (double val, double dummy) {return getUnitIndex("mpa") == -1;}
+
+
+
+// every string the table search recognises gives the same unit by the perfect hash
+int units_hash_check (FILE *logFile){
+	int i, iErr = TEST_PASS;
+	char strLowercase [NAMESTRLEN];
+	const char *strMisses[] = {"", "mpa", "furlong", "Kelvin", "kj/kg", "J/(kg K) ", "psi"};
+	
+	for (i = 0; i < NUM_BUILT_IN_UNITS; i++) {
+		lowercase(strLowercase, builtInUnits[i].strName, NAMESTRLEN);
+		if (getUnitIndex(builtInUnits[i].strSymbol) != scanUnitIndex(builtInUnits[i].strSymbol)) iErr = TEST_INCORRECT;
+		if (getUnitIndex(builtInUnits[i].strName) != scanUnitIndex(builtInUnits[i].strName)) iErr = TEST_INCORRECT;
+		if (getUnitIndex(strLowercase) != scanUnitIndex(strLowercase)) iErr = TEST_INCORRECT;
+	}
+	for (i = 0; i < (int) (sizeof(strMisses) / sizeof(strMisses[0])); i++)
+		if (getUnitIndex(strMisses[i]) != scanUnitIndex(strMisses[i])) iErr = TEST_INCORRECT;
+	
+	fprintf(logFile, "getUnitIndex by perfect hash against table search for %i units \t %s\n", NUM_BUILT_IN_UNITS, (iErr == TEST_PASS) ? "PASS" : "FAIL");
+	return iErr;
+}
+
+
+
+int units_test (FILE *logFile){	
+	int intermediateResult= TEST_PASS; //initialise with clear flags.  
+	
+	fprintf(logFile, "\n\n*** UNIT CONVERSION CHECK ***\n" );
+
+	intermediateResult = intermediateResult | units_hash_check (logFile);
+	
+	intermediateResult = intermediateResult | testDoubleInput ( units_psia_MPa, 100.0, 0.0, 0.6894757293, TEST_ACCURACY, SIG_FIG, "psia to MPa", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_C_F, 100.0, 0.0, 212.0, TEST_ACCURACY, SIG_FIG, "C to F", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_degF_K, 32.0, 0.0, 273.15, TEST_ACCURACY, SIG_FIG, "°F to K", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_bar_kPa, 1.0, 0.0, 100.0, TEST_ACCURACY, SIG_FIG, "bar to kPa", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_psig_bar, 0.0, 0.0, 1.01325, TEST_ACCURACY, SIG_FIG, "psig to bar", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_kJ_btu, 2326.0, 0.0, 1000.0, 5, SIG_FIG, "kJ/kg to BTU/lb", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_name_kJ, 1000.0, 0.0, 1.0, TEST_ACCURACY, SIG_FIG, "Joule per kilogram to kJ/kg", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_lower_kJ, 1000.0, 0.0, 1.0, TEST_ACCURACY, SIG_FIG, "joule per kilogram to kJ/kg", logFile);
+	
+	intermediateResult = intermediateResult | testDoubleInput ( units_conv_psia_MPa, 100.0, 0.0, 0.6894757293, TEST_ACCURACY, SIG_FIG, "applyUnitConv psia to MPa", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( units_conv_C_F, -40.0, 0.0, -40.0, TEST_ACCURACY, SIG_FIG, "applyUnitConv C to F", logFile);
+	
+	intermediateResult = intermediateResult | testBoolDoubleInput ( units_incompatible, 1.0, 0.0, true, "incompatible units give DBL_MIN", logFile);
+	intermediateResult = intermediateResult | testBoolDoubleInput ( units_unknown, 1.0, 0.0, true, "unknown unit gives DBL_MIN", logFile);
+	intermediateResult = intermediateResult | testBoolDoubleInput ( units_unknown_valid, 1.0, 0.0, false, "getUnitConv unknown unit isValid", logFile);
+	intermediateResult = intermediateResult | testBoolDoubleInput ( units_same, 7.0, 0.0, true, "same unit unchanged", logFile);
+	intermediateResult = intermediateResult | testBoolDoubleInput ( units_short_lower, 0.0, 0.0, true, "mpa not found", logFile);
+
+	return intermediateResult;
+}
@@ -0,0 +1,24 @@
+//          Copyright Martin Lord 2014-2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+
+
+/* ********************************************************************
+* A SHORT PROGRAMME TO CHECK THE UNIT CONVERSIONS
+* *********************************************************************/
+
+
+#ifndef UNITS_TEST_H
+#define UNITS_TEST_H
+
+#include "units.h"
+#include <stdio.h>
+#include "IF97_common.h"
+#include "if97_lib_test.h"
+
+
+int units_test (FILE *logFile);
+
+#endif // UNITS_TEST_H
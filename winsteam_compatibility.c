@@ -12,9 +12,6 @@
 
 
 
-#ifndef IF97_WINSTEAM_H
-#define IF97_WINSTEAM_H
-
 /*
  * Unit Set	| English	| SI		| English	| SI		| SI kPa	| Metric	| Metric	|
  * 			|			| Customary	| Gauge		| Formal	|			|			| Formal	|
@@ -40,8 +37,10 @@
 #include <ctype.h>  // for tolower
 #include "units.h"  // unit conversion library, lowercase
 #include <float.h>  //for minimum number storable for each type
+#include <stdlib.h>  // for malloc
 #include "if97_lib.h" // IF 97 steam tables in MPa, K, kg, kJ 
 #include "winsteam_compatibility.h"
+#include "if97_record.h"  // recording of calls, if compiled in
 
 #define UNITSTRLEN 5
 
@@ -95,8 +94,9 @@ char *lowercase (char *strOutput, const char *strInput, int OutLen){
 
 //* get the integer value of the unit set calls for IFC 67 tables  are +10 */
 int getUnitSetNo (char *unitset){
-	char strLowercase [UNITSTRLEN] = "";
-	lowercase(strLowercase, unitset, UNITSTRLEN);
+	char strLowercase [UNITSTRLEN + 2] = "";  // room for one letter more than the longest name, and the terminator
+	lowercase(strLowercase, unitset, UNITSTRLEN + 1);
+	if (strlen(strLowercase) > UNITSTRLEN) return 100;  // too long to be a unit set
 	
 	
 		if (strcmp (strLowercase, "0") == 0)  return 0;
@@ -133,396 +133,1086 @@ int getUnitSetNo (char *unitset){
 }
 
 
-// ********   SATURATION LINE   **************
 
+/* the unit sets, with their conversions resolved, are built once and shared.  The
+ * extra two are returned for the IFC-67 sets and for an unrecognised name */
+typStmUnitSet arrStmUnitSets [9];
+bool isStmUnitSetsBuilt = false;
 
-/* saturation temperature for a given pressure */
-double StmPT(double pressure, char* unitset){
+
+// resolves the conversions between the unit set iUSet and SIF, the units of if97_lib
+void buildStmUnitSet (typStmUnitSet *us, int iUSet){
+	int iParam;
+	
+	us->iUSet = iUSet;
+	if (iUSet > 6) return;  // no conversions.  The functions return an error code for these sets
 	
+	for (iParam = TEMP; iParam <= VEL; iParam++) {
+		us->toSIF[iParam] = getUnitConv (arrUSets[iUSet][iParam], arrUSets[SIF][iParam]);
+		us->fromSIF[iParam] = getUnitConv (arrUSets[SIF][iParam], arrUSets[iUSet][iParam]);
+	}
+}
+
+
+const typStmUnitSet *StmUnitSetOpen (char *unitset){
 	int iUSet = getUnitSetNo(unitset);
+	int i;
+	
+	#pragma omp critical (stm_unit_sets)
+	{
+		if (!isStmUnitSetsBuilt) {
+			for (i = 0; i <= METF; i++) buildStmUnitSet (&arrStmUnitSets[i], i);
+			buildStmUnitSet (&arrStmUnitSets[7], 10);  // IFC-67 tables. Not supported yet
+			buildStmUnitSet (&arrStmUnitSets[8], 100);  // not found
+			isStmUnitSetsBuilt = true;
+		}
+	}
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (iUSet == 100) return &arrStmUnitSets[8];
+	if (iUSet > 6) return &arrStmUnitSets[7];
+	return &arrStmUnitSets[iUSet];
+}
+
+
+
+// ************** RECORDING *********************
+
+/* With IF97_RECORD defined, calls of the _u functions (and so of the string forms) are
+ * recorded with their unit set, as the if97_lib functions are.  See if97_record.h */
+
+#ifdef IF97_RECORD
+
+double stmRecord1 (int iFunc, double (*func) (double, const typStmUnitSet *), double dblIn1, const typStmUnitSet *us){
+	unsigned long long llStart;
+	double dblResult;
+	
+	if (!if97_record_on()) return func(dblIn1, us);
+	
+	if97RecordBusy = true;
+	llStart = if97_record_ticks();
+	dblResult = func(dblIn1, us);
+	if97_record_put(iFunc, us->iUSet, dblIn1, 0.0, dblResult, if97_record_ticks() - llStart);
+	if97RecordBusy = false;
+	return dblResult;
+}
+
+double stmRecord2 (int iFunc, double (*func) (double, double, const typStmUnitSet *), double dblIn1, double dblIn2, const typStmUnitSet *us){
+	unsigned long long llStart;
+	double dblResult;
 	
-	return convertNamedUnit(if97_Ps_t(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS])), arrUSets[SIF][TEMP], arrUSets[iUSet][TEMP]);
+	if (!if97_record_on()) return func(dblIn1, dblIn2, us);
 	
+	if97RecordBusy = true;
+	llStart = if97_record_ticks();
+	dblResult = func(dblIn1, dblIn2, us);
+	if97_record_put(iFunc, us->iUSet, dblIn1, dblIn2, dblResult, if97_record_ticks() - llStart);
+	if97RecordBusy = false;
+	return dblResult;
+}
+
+	#define STM_RECORD_1(iFunc, func, in1, us) \
+		if ((if97RecordState != IF97_RECORD_OFF) && !if97RecordBusy) return stmRecord1(iFunc, func, in1, us)
+	#define STM_RECORD_2(iFunc, func, in1, in2, us) \
+		if ((if97RecordState != IF97_RECORD_OFF) && !if97RecordBusy) return stmRecord2(iFunc, func, in1, in2, us)
+
+#else
+
+	#define STM_RECORD_1(iFunc, func, in1, us)
+	#define STM_RECORD_2(iFunc, func, in1, in2, us)
+
+#endif // IF97_RECORD
+
+
+
+// ************** MEMOISATION *********************
+
+/* Results can be kept in a cache with a fixed number of entries, keyed on the function, 
+ * the bits of its inputs and the unit set.  The least recently used entry is replaced 
+ * when it is full.  Entries are found through a hash table of chained indices, and the
+ * recency order is a doubly linked list of indices, so nothing is allocated per call.
+ * It is off until StmCacheSetCapacity is called */
+
+enum stmFunc { STM_PT, STM_TP, STM_PTH, STM_PTS, STM_PTV, STM_PTC, STM_PTK, STM_PTM, STM_PTW, STM_PTG, STM_PHT, STM_PHS, STM_PHV, STM_PHQ, STM_PHC, STM_PHW, STM_PHG, STM_PST, STM_PSH, STM_PSV, STM_PSQ, STM_PSC, STM_PSW, STM_PSG };
+
+typedef struct sctStmCacheEntry {
+	int iFunc;  // enum stmFunc
+	int iUSet;
+	double dblIn1;  // inputs, compared bit for bit
+	double dblIn2;
+	double dblResult;
+	int iPrev;  // more recently used.  -1 at the head
+	int iNext;  // less recently used.  -1 at the tail
+	int iHashNext;  // next entry in the same bucket.  -1 at the end
+} typStmCacheEntry;
+
+typStmCacheEntry *arrStmCache = NULL;
+int *arrStmCacheBucket = NULL;  // first entry in each bucket.  -1 if empty
+int iStmCacheCapacity = 0;  // 0 when off
+int iStmCacheEntries = 0;
+int iStmCacheHead = -1;
+int iStmCacheTail = -1;
+unsigned long lStmCacheHits = 0;
+unsigned long lStmCacheMisses = 0;
+unsigned long lStmCacheEvictions = 0;
+
+
+// bucket for a key.  FNV-1a of the bytes of the key
+int stmCacheBucket(int iFunc, double dblIn1, double dblIn2, int iUSet){
+	unsigned char key[2 * sizeof(int) + 2 * sizeof(double)];
+	unsigned int hash = 2166136261u;
+	size_t i;
+	
+	memcpy(key, &iFunc, sizeof(int));
+	memcpy(key + sizeof(int), &iUSet, sizeof(int));
+	memcpy(key + 2 * sizeof(int), &dblIn1, sizeof(double));
+	memcpy(key + 2 * sizeof(int) + sizeof(double), &dblIn2, sizeof(double));
+	for (i = 0; i < sizeof(key); i++) {
+		hash ^= key[i];
+		hash *= 16777619u;
+	}
+	return (int) (hash % (unsigned int) iStmCacheCapacity);  // as many buckets as entries
+}
+
+
+// index of the entry for a key, or -1.  Call only inside the stm_cache critical section
+int stmCacheFind(int iBucket, int iFunc, double dblIn1, double dblIn2, int iUSet){
+	int i;
+	
+	for (i = arrStmCacheBucket[iBucket]; i >= 0; i = arrStmCache[i].iHashNext)
+		if ((arrStmCache[i].iFunc == iFunc) && (arrStmCache[i].iUSet == iUSet) 
+				&& (memcmp(&arrStmCache[i].dblIn1, &dblIn1, sizeof(double)) == 0) 
+				&& (memcmp(&arrStmCache[i].dblIn2, &dblIn2, sizeof(double)) == 0)) return i;
+	return -1;
+}
+
+
+// takes an entry out of the recency list
+void stmCacheUnlink(int i){
+	if (arrStmCache[i].iPrev >= 0) arrStmCache[arrStmCache[i].iPrev].iNext = arrStmCache[i].iNext;
+	else iStmCacheHead = arrStmCache[i].iNext;
+	if (arrStmCache[i].iNext >= 0) arrStmCache[arrStmCache[i].iNext].iPrev = arrStmCache[i].iPrev;
+	else iStmCacheTail = arrStmCache[i].iPrev;
+}
 
-} // StmPT
+
+// puts an entry at the head of the recency list, as the most recently used
+void stmCachePushHead(int i){
+	arrStmCache[i].iPrev = -1;
+	arrStmCache[i].iNext = iStmCacheHead;
+	if (iStmCacheHead >= 0) arrStmCache[iStmCacheHead].iPrev = i;
+	iStmCacheHead = i;
+	if (iStmCacheTail < 0) iStmCacheTail = i;
+}
+
+
+/* true, with the result, if the function has been called with these inputs and unit set.
+ * Always false if the cache is off */
+bool stmCacheLookup(int iFunc, double dblIn1, double dblIn2, const typStmUnitSet *us, double *dblResult){
+	bool isHit = false;
+	int i;
+	
+	if (iStmCacheCapacity == 0) return false;
+	
+	#pragma omp critical (stm_cache)
+	{
+		i = stmCacheFind(stmCacheBucket(iFunc, dblIn1, dblIn2, us->iUSet), iFunc, dblIn1, dblIn2, us->iUSet);
+		if (i >= 0) {
+			isHit = true;
+			*dblResult = arrStmCache[i].dblResult;
+			stmCacheUnlink(i);
+			stmCachePushHead(i);
+			lStmCacheHits++;
+		}
+		else lStmCacheMisses++;
+	}
+	return isHit;
+}
+
+
+/* keeps a result in the cache, replacing the least recently used entry if it is full.
+ * Returns the result, so that it can wrap the calculation */
+double stmCacheStore(int iFunc, double dblIn1, double dblIn2, const typStmUnitSet *us, double dblResult){
+	int i, iBucket, *pLink;
+	
+	if (iStmCacheCapacity == 0) return dblResult;
+	
+	#pragma omp critical (stm_cache)
+	{
+		iBucket = stmCacheBucket(iFunc, dblIn1, dblIn2, us->iUSet);
+		i = stmCacheFind(iBucket, iFunc, dblIn1, dblIn2, us->iUSet);  // another thread may have stored it since the lookup
+		
+		if (i >= 0) stmCacheUnlink(i);
+		else {
+			if (iStmCacheEntries < iStmCacheCapacity) i = iStmCacheEntries++;
+			else {  // replace the least recently used
+				i = iStmCacheTail;
+				stmCacheUnlink(i);
+				pLink = &arrStmCacheBucket[stmCacheBucket(arrStmCache[i].iFunc, arrStmCache[i].dblIn1, arrStmCache[i].dblIn2, arrStmCache[i].iUSet)];
+				while (*pLink != i) pLink = &arrStmCache[*pLink].iHashNext;
+				*pLink = arrStmCache[i].iHashNext;
+				lStmCacheEvictions++;
+			}
+			arrStmCache[i].iFunc = iFunc;
+			arrStmCache[i].iUSet = us->iUSet;
+			arrStmCache[i].dblIn1 = dblIn1;
+			arrStmCache[i].dblIn2 = dblIn2;
+			arrStmCache[i].iHashNext = arrStmCacheBucket[iBucket];
+			arrStmCacheBucket[iBucket] = i;
+		}
+		arrStmCache[i].dblResult = dblResult;
+		stmCachePushHead(i);
+	}
+	return dblResult;
+}
+
+
+int StmCacheSetCapacity (int iCapacity){
+	int iErr = 0;
+	
+	#pragma omp critical (stm_cache)
+	{
+		free(arrStmCache);
+		free(arrStmCacheBucket);
+		arrStmCache = NULL;
+		arrStmCacheBucket = NULL;
+		iStmCacheCapacity = 0;
+		
+		if (iCapacity > 0) {
+			arrStmCache = malloc(iCapacity * sizeof(typStmCacheEntry));
+			arrStmCacheBucket = malloc(iCapacity * sizeof(int));
+			if ((arrStmCache == NULL) || (arrStmCacheBucket == NULL)) {
+				free(arrStmCache);
+				free(arrStmCacheBucket);
+				arrStmCache = NULL;
+				arrStmCacheBucket = NULL;
+				iErr = -1;
+			}
+			else iStmCacheCapacity = iCapacity;
+		}
+	}
+	StmCacheClear();
+	return iErr;
+}
+
+
+void StmCacheClear (void){
+	int i;
+	
+	#pragma omp critical (stm_cache)
+	{
+		for (i = 0; i < iStmCacheCapacity; i++) arrStmCacheBucket[i] = -1;
+		iStmCacheEntries = 0;
+		iStmCacheHead = -1;
+		iStmCacheTail = -1;
+		lStmCacheHits = 0;
+		lStmCacheMisses = 0;
+		lStmCacheEvictions = 0;
+	}
+}
+
+
+typStmCacheStats StmCacheStats (void){
+	typStmCacheStats stats;
+	
+	#pragma omp critical (stm_cache)
+	{
+		stats.lHits = lStmCacheHits;
+		stats.lMisses = lStmCacheMisses;
+		stats.lEvictions = lStmCacheEvictions;
+		stats.iEntries = iStmCacheEntries;
+		stats.iCapacity = iStmCacheCapacity;
+	}
+	stats.dblHitRate = (stats.lHits + stats.lMisses > 0) ? (double) stats.lHits / (double) (stats.lHits + stats.lMisses) : 0.0;
+	return stats;
+}
+
+
+// ********   SATURATION LINE   **************
+
+
+/*  saturation temperature for a given pressure */
+double StmPT_u(double pressure, const typStmUnitSet *us){
+	double dblResult;
+	
+	STM_RECORD_1(IF97_REC_STMPT, StmPT_u, pressure, us);
+	
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PT, pressure, 0.0, us, &dblResult)) return dblResult;
+	
+	return stmCacheStore(STM_PT, pressure, 0.0, us, applyUnitConv(if97_Ps_t(applyUnitConv (pressure, us->toSIF[PRESS])), us->fromSIF[TEMP]));
+
+} // StmPT_u
+
+double StmPT(double pressure, char* unitset){
+	return StmPT_u(pressure, StmUnitSetOpen(unitset));
+}
 
 
 
 /*  saturation pressure for a given temperatrue */
-double StmTP(double temperature, char* unitset){
+double StmTP_u(double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_1(IF97_REC_STMTP, StmTP_u, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_TP, temperature, 0.0, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_Ts_p(convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), arrUSets[SIF][PRESS], arrUSets[iUSet][PRESS]);
+	return stmCacheStore(STM_TP, temperature, 0.0, us, applyUnitConv(if97_Ts_p(applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[PRESS]));
+
+} // StmTP_u
 
-} // StmTP
+double StmTP(double temperature, char* unitset){
+	return StmTP_u(temperature, StmUnitSetOpen(unitset));
+}
 
 
 
 
 // ***************** PT *********************
 
-/*  specific enthalpy for a given pressure and temperature*/
-double StmPTH(double pressure, double temperature, char* unitset){
+/*  specific enthalpy for a given pressure and temperature */
+double StmPTH_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTH, StmPTH_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTH, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_h(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][ENTH], arrUSets[iUSet][ENTH]);
+	return stmCacheStore(STM_PTH, pressure, temperature, us, applyUnitConv(if97_pt_h(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[ENTH]));
 
-} // StmPTH
+} // StmPTH_u
+
+double StmPTH(double pressure, double temperature, char* unitset){
+	return StmPTH_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
 
 
 
 /*  specific entropy for a given pressure and temperature */
-double StmPTS(double pressure, double temperature, char* unitset){
+double StmPTS_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTS, StmPTS_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTS, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_s(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][ENTR], arrUSets[iUSet][ENTR]);
+	return stmCacheStore(STM_PTS, pressure, temperature, us, applyUnitConv(if97_pt_s(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[ENTR]));
+
+} // StmPTS_u
+
+double StmPTS(double pressure, double temperature, char* unitset){
+	return StmPTS_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
 
-} // StmPTS
 
 
 /*  specific volume for a given pressure and temperature */
-double StmPTV(double pressure, double temperature, char* unitset){
+double StmPTV_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTV, StmPTV_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTV, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_v(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][VOL], arrUSets[iUSet][VOL]);
+	return stmCacheStore(STM_PTV, pressure, temperature, us, applyUnitConv(if97_pt_v(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[VOL]));
+
+} // StmPTV_u
 
-} // StmPTV
+double StmPTV(double pressure, double temperature, char* unitset){
+	return StmPTV_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
 
 
 
 /*  specific isobaric heat capacity Cp for a given pressure and temperature */
-double StmPTC(double pressure, double temperature, char* unitset){
+double StmPTC_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTC, StmPTC_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTC, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_Cp(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][SPEC_HEAT], arrUSets[iUSet][SPEC_HEAT]);
+	return stmCacheStore(STM_PTC, pressure, temperature, us, applyUnitConv(if97_pt_Cp(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[SPEC_HEAT]));
 
-} // StmPTC
+} // StmPTC_u
 
+double StmPTC(double pressure, double temperature, char* unitset){
+	return StmPTC_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
 
 
 
 /*  thermal conductivity for a given pressure and temperature */
-double StmPTK(double pressure, double temperature, char* unitset){
+double StmPTK_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTK, StmPTK_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTK, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_k(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][COND], arrUSets[iUSet][COND]);
+	return stmCacheStore(STM_PTK, pressure, temperature, us, applyUnitConv(if97_pt_k(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[COND]));
 
-} // StmPTK
+} // StmPTK_u
+
+double StmPTK(double pressure, double temperature, char* unitset){
+	return StmPTK_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
 
 
 
 /*  dynamic viscosity for a given pressure and temperature */
-double StmPTM(double pressure, double temperature, char* unitset){
+double StmPTM_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTM, StmPTM_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTM, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_mu(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][VISC], arrUSets[iUSet][VISC]);
+	return stmCacheStore(STM_PTM, pressure, temperature, us, applyUnitConv(if97_pt_mu(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[VISC]));
 
-} // StmPTM
+} // StmPTM_u
 
+double StmPTM(double pressure, double temperature, char* unitset){
+	return StmPTM_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
 
 
 
 /*  speed of sound for a given pressure and temperature */
-double StmPTW(double pressure, double temperature, char* unitset){
+double StmPTW_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTW, StmPTW_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTW, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_Vs(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][VEL], arrUSets[iUSet][VEL]);
+	return stmCacheStore(STM_PTW, pressure, temperature, us, applyUnitConv(if97_pt_Vs(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[VEL]));
 
-} // StmPTW
+} // StmPTW_u
+
+double StmPTW(double pressure, double temperature, char* unitset){
+	return StmPTW_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
 
 
 
 /*  isentropic expansion coefficient for a given pressure and temperature */
-double StmPTG(double pressure, double temperature, char* unitset){
+double StmPTG_u(double pressure, double temperature, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPTG, StmPTG_u, pressure, temperature, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PTG, pressure, temperature, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_pt_gamma(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (temperature,  arrUSets[iUSet][TEMP] , arrUSets[SIF][TEMP])), \
-							arrUSets[SIF][GAMMA], arrUSets[iUSet][GAMMA]);
+	return stmCacheStore(STM_PTG, pressure, temperature, us, applyUnitConv(if97_pt_gamma(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (temperature, us->toSIF[TEMP])), us->fromSIF[GAMMA]));
+
+} // StmPTG_u
+
+double StmPTG(double pressure, double temperature, char* unitset){
+	return StmPTG_u(pressure, temperature, StmUnitSetOpen(unitset));
+}
+
 
-} // StmPTG
 
-/*  Uncomment as these become availabel in if97_lib
 
 // ************** PH *********************
 
-//  temperature for a given pressure and enthalpy
-double StmPHT(double pressure, double enthalpy, char* unitset){
+/*  temperature for a given pressure and enthalpy */
+double StmPHT_u(double pressure, double enthalpy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPHT, StmPHT_u, pressure, enthalpy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PHT, pressure, enthalpy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ph_t(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (enthalpy,  arrUSets[iUSet][ENTH] , arrUSets[SIF][ENTH])), \
-							arrUSets[SIF][TEMP], arrUSets[iUSet][TEMP]);
+	return stmCacheStore(STM_PHT, pressure, enthalpy, us, applyUnitConv(if97_ph_t(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (enthalpy, us->toSIF[ENTH])), us->fromSIF[TEMP]));
 
-} // StmPHT
+} // StmPHT_u
 
+double StmPHT(double pressure, double enthalpy, char* unitset){
+	return StmPHT_u(pressure, enthalpy, StmUnitSetOpen(unitset));
+}
 
 
 
-//  specific entropy for a given pressure and enthalpy 
-double StmPHS(double pressure, double enthalpy, char* unitset){
+/*  specific entropy for a given pressure and enthalpy */
+double StmPHS_u(double pressure, double enthalpy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPHS, StmPHS_u, pressure, enthalpy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PHS, pressure, enthalpy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ph_s(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (enthalpy,  arrUSets[iUSet][ENTH] , arrUSets[SIF][ENTH])), \
-							arrUSets[SIF][ENTR], arrUSets[iUSet][ENTR]);
+	return stmCacheStore(STM_PHS, pressure, enthalpy, us, applyUnitConv(if97_ph_s(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (enthalpy, us->toSIF[ENTH])), us->fromSIF[ENTR]));
 
-} // StmPHS
+} // StmPHS_u
 
+double StmPHS(double pressure, double enthalpy, char* unitset){
+	return StmPHS_u(pressure, enthalpy, StmUnitSetOpen(unitset));
+}
 
 
-//  specific volume for a given pressure and enthalpy
-double StmPHV(double pressure, double enthalpy, char* unitset){
+
+/*  specific volume for a given pressure and enthalpy */
+double StmPHV_u(double pressure, double enthalpy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPHV, StmPHV_u, pressure, enthalpy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PHV, pressure, enthalpy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ph_v(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (enthalpy,  arrUSets[iUSet][ENTH] , arrUSets[SIF][ENTH])), \
-							arrUSets[SIF][VOL], arrUSets[iUSet][VOL]);
+	return stmCacheStore(STM_PHV, pressure, enthalpy, us, applyUnitConv(if97_ph_v(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (enthalpy, us->toSIF[ENTH])), us->fromSIF[VOL]));
 
-} // StmPHV
+} // StmPHV_u
 
+double StmPHV(double pressure, double enthalpy, char* unitset){
+	return StmPHV_u(pressure, enthalpy, StmUnitSetOpen(unitset));
+}
 
 
-//  quality for a given pressure and enthalpy
-double StmPHQ(double pressure, double enthalpy, char* unitset){
+
+/*  quality for a given pressure and enthalpy */
+double StmPHQ_u(double pressure, double enthalpy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPHQ, StmPHQ_u, pressure, enthalpy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PHQ, pressure, enthalpy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ph_q(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (enthalpy,  arrUSets[iUSet][ENTH] , arrUSets[SIF][ENTH])), \
-							arrUSets[SIF][QUAL], arrUSets[iUSet][QUAL]);
+	return stmCacheStore(STM_PHQ, pressure, enthalpy, us, applyUnitConv(if97_ph_q(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (enthalpy, us->toSIF[ENTH])), us->fromSIF[QUAL]));
 
-} // StmPHQ
+} // StmPHQ_u
 
+double StmPHQ(double pressure, double enthalpy, char* unitset){
+	return StmPHQ_u(pressure, enthalpy, StmUnitSetOpen(unitset));
+}
 
 
-//  specific isobaric heat capacity Cp for a given pressure and enthalpy
-double StmPHC(double pressure, double enthalpy, char* unitset){
+
+/*  specific isobaric heat capacity Cp for a given pressure and enthalpy */
+double StmPHC_u(double pressure, double enthalpy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPHC, StmPHC_u, pressure, enthalpy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PHC, pressure, enthalpy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ph_Cp(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (enthalpy,  arrUSets[iUSet][ENTH] , arrUSets[SIF][ENTH])), \
-							arrUSets[SIF][SPEC_HEAT], arrUSets[iUSet][SPEC_HEAT]);
+	return stmCacheStore(STM_PHC, pressure, enthalpy, us, applyUnitConv(if97_ph_Cp(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (enthalpy, us->toSIF[ENTH])), us->fromSIF[SPEC_HEAT]));
+
+} // StmPHC_u
 
-} // StmPHC
+double StmPHC(double pressure, double enthalpy, char* unitset){
+	return StmPHC_u(pressure, enthalpy, StmUnitSetOpen(unitset));
+}
 
 
 
-//  speed of sound for a given pressure and enthalpy
-double StmPHW(double pressure, double enthalpy, char* unitset){
+/*  speed of sound for a given pressure and enthalpy */
+double StmPHW_u(double pressure, double enthalpy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPHW, StmPHW_u, pressure, enthalpy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PHW, pressure, enthalpy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ph_Vs(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (enthalpy,  arrUSets[iUSet][ENTH] , arrUSets[SIF][ENTH])), \
-							arrUSets[SIF][VEL], arrUSets[iUSet][VEL]);
+	return stmCacheStore(STM_PHW, pressure, enthalpy, us, applyUnitConv(if97_ph_Vs(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (enthalpy, us->toSIF[ENTH])), us->fromSIF[VEL]));
 
-} // StmPHW
+} // StmPHW_u
 
+double StmPHW(double pressure, double enthalpy, char* unitset){
+	return StmPHW_u(pressure, enthalpy, StmUnitSetOpen(unitset));
+}
 
 
-//  isentropic expansion coefficient for a given pressure and enthalpy
-double StmPHG(double pressure, double enthalpy, char* unitset){
+
+/*  isentropic expansion coefficient for a given pressure and enthalpy */
+double StmPHG_u(double pressure, double enthalpy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPHG, StmPHG_u, pressure, enthalpy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PHG, pressure, enthalpy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ph_gamma(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (enthalpy,  arrUSets[iUSet][ENTH] , arrUSets[SIF][ENTH])), \
-							arrUSets[SIF][GAMMA], arrUSets[iUSet][GAMMA]);
+	return stmCacheStore(STM_PHG, pressure, enthalpy, us, applyUnitConv(if97_ph_gamma(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (enthalpy, us->toSIF[ENTH])), us->fromSIF[GAMMA]));
+
+} // StmPHG_u
+
+double StmPHG(double pressure, double enthalpy, char* unitset){
+	return StmPHG_u(pressure, enthalpy, StmUnitSetOpen(unitset));
+}
+
 
-} // StmPHW
 
 
 // *************  PS  ***************************
 
-//  temperature for a given pressure and entropy
-double StmPST(double pressure, double entropy, char* unitset){
+/*  temperature for a given pressure and entropy */
+double StmPST_u(double pressure, double entropy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPST, StmPST_u, pressure, entropy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PST, pressure, entropy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ps_t(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (entropy,  arrUSets[iUSet][ENTR] , arrUSets[SIF][ENTR])), \
-							arrUSets[SIF][TEMP], arrUSets[iUSet][TEMP]);
+	return stmCacheStore(STM_PST, pressure, entropy, us, applyUnitConv(if97_ps_t(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (entropy, us->toSIF[ENTR])), us->fromSIF[TEMP]));
 
-} // StmPST
+} // StmPST_u
 
+double StmPST(double pressure, double entropy, char* unitset){
+	return StmPST_u(pressure, entropy, StmUnitSetOpen(unitset));
+}
 
 
-//  specific enthalpy for a given pressure and entropy
-double StmPSH(double pressure, double entropy, char* unitset){
+
+/*  specific enthalpy for a given pressure and entropy */
+double StmPSH_u(double pressure, double entropy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPSH, StmPSH_u, pressure, entropy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PSH, pressure, entropy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ps_h(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (entropy,  arrUSets[iUSet][ENTR] , arrUSets[SIF][ENTR])), \
-							arrUSets[SIF][ENTH], arrUSets[iUSet][ENTH]);
+	return stmCacheStore(STM_PSH, pressure, entropy, us, applyUnitConv(if97_ps_h(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (entropy, us->toSIF[ENTR])), us->fromSIF[ENTH]));
 
-} // StmPSH
+} // StmPSH_u
 
+double StmPSH(double pressure, double entropy, char* unitset){
+	return StmPSH_u(pressure, entropy, StmUnitSetOpen(unitset));
+}
 
 
-//  specific volume for a given pressure and entropy
-double StmPSV(double pressure, double entropy, char* unitset){
+
+/*  specific volume for a given pressure and entropy */
+double StmPSV_u(double pressure, double entropy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPSV, StmPSV_u, pressure, entropy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PSV, pressure, entropy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ps_v(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (entropy,  arrUSets[iUSet][ENTR] , arrUSets[SIF][ENTR])), \
-							arrUSets[SIF][VOL], arrUSets[iUSet][VOL]);
+	return stmCacheStore(STM_PSV, pressure, entropy, us, applyUnitConv(if97_ps_v(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (entropy, us->toSIF[ENTR])), us->fromSIF[VOL]));
 
-} // StmPSV
+} // StmPSV_u
 
+double StmPSV(double pressure, double entropy, char* unitset){
+	return StmPSV_u(pressure, entropy, StmUnitSetOpen(unitset));
+}
 
 
-//  quality for a given pressure and entropy
-double StmPSQ(double pressure, double entropy, char* unitset){
+
+/*  quality for a given pressure and entropy */
+double StmPSQ_u(double pressure, double entropy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPSQ, StmPSQ_u, pressure, entropy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PSQ, pressure, entropy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ps_q(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (entropy,  arrUSets[iUSet][ENTR] , arrUSets[SIF][ENTR])), \
-							arrUSets[SIF][QUAL], arrUSets[iUSet][QUAL]);
+	return stmCacheStore(STM_PSQ, pressure, entropy, us, applyUnitConv(if97_ps_q(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (entropy, us->toSIF[ENTR])), us->fromSIF[QUAL]));
+
+} // StmPSQ_u
+
+double StmPSQ(double pressure, double entropy, char* unitset){
+	return StmPSQ_u(pressure, entropy, StmUnitSetOpen(unitset));
+}
+
 
-} // StmPSQ
 
+/*  specific isobaric heat capacity Cp for a given pressure and entropy */
+double StmPSC_u(double pressure, double entropy, const typStmUnitSet *us){
+	double dblResult;
+	
+	STM_RECORD_2(IF97_REC_STMPSC, StmPSC_u, pressure, entropy, us);
+	
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PSC, pressure, entropy, us, &dblResult)) return dblResult;
+	
+	return stmCacheStore(STM_PSC, pressure, entropy, us, applyUnitConv(if97_ps_Cp(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (entropy, us->toSIF[ENTR])), us->fromSIF[SPEC_HEAT]));
 
+} // StmPSC_u
 
-//  specific isobaric heat capacity Cp for a given pressure and entropy
 double StmPSC(double pressure, double entropy, char* unitset){
+	return StmPSC_u(pressure, entropy, StmUnitSetOpen(unitset));
+}
+
+
+
+/*  speed of sound for a given pressure and entropy */
+double StmPSW_u(double pressure, double entropy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPSW, StmPSW_u, pressure, entropy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PSW, pressure, entropy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ps_Cp(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (entropy,  arrUSets[iUSet][ENTR] , arrUSets[SIF][ENTR])), \
-							arrUSets[SIF][SPEC_HEAT], arrUSets[iUSet][SPEC_HEAT]);
+	return stmCacheStore(STM_PSW, pressure, entropy, us, applyUnitConv(if97_ps_Vs(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (entropy, us->toSIF[ENTR])), us->fromSIF[VEL]));
 
-} // StmPSC
+} // StmPSW_u
 
-//  speed of sound for a given pressure and entropy
 double StmPSW(double pressure, double entropy, char* unitset){
+	return StmPSW_u(pressure, entropy, StmUnitSetOpen(unitset));
+}
+
+
+
+/*  isentropic expansion coefficient for a given pressure and entropy */
+double StmPSG_u(double pressure, double entropy, const typStmUnitSet *us){
+	double dblResult;
 	
-	int iUSet = getUnitSetNo(unitset);
+	STM_RECORD_2(IF97_REC_STMPSG, StmPSG_u, pressure, entropy, us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (us->iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
+	if (us->iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+	if (stmCacheLookup(STM_PSG, pressure, entropy, us, &dblResult)) return dblResult;
 	
-	return convertNamedUnit(if97_ps_Vs(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (entropy,  arrUSets[iUSet][ENTR] , arrUSets[SIF][ENTR])), \
-							arrUSets[SIF][VEL], arrUSets[iUSet][VEL]);
+	return stmCacheStore(STM_PSG, pressure, entropy, us, applyUnitConv(if97_ps_gamma(applyUnitConv (pressure, us->toSIF[PRESS]), applyUnitConv (entropy, us->toSIF[ENTR])), us->fromSIF[GAMMA]));
 
-} // StmPSW
+} // StmPSG_u
 
+double StmPSG(double pressure, double entropy, char* unitset){
+	return StmPSG_u(pressure, entropy, StmUnitSetOpen(unitset));
+}
 
 
-//  isentropic expansion coefficient for a given pressure and entropy
-double StmPSG(double pressure, double entropy, char* unitset){
+
+// ************** ARRAYS *********************
+// the unit set is opened once for the whole array, and the elements are shared between threads
+
+/*  saturation temperature for an array of pressures */
+void StmPT_n(const double *pressure, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
 	
-	int iUSet = getUnitSetNo(unitset);
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPT_u(pressure[i], us);
 	
-	if (iUSet > 6 ) return DBL_MIN;  //1967 tables not supported yet
-	if (iUSet == 100)  return DBL_MIN + 1.0;  //unit string incorrect. Cant find unit No.
+} // StmPT_n
+
+
+/*  saturation pressure for an array of temperatures */
+void StmTP_n(const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
 	
-	return convertNamedUnit(if97_ps_gamma(convertNamedUnit (pressure,  arrUSets[iUSet][PRESS] , arrUSets[SIF][PRESS]), \
-									  convertNamedUnit (entropy,  arrUSets[iUSet][ENTR] , arrUSets[SIF][ENTR])), \
-							arrUSets[SIF][GAMMA], arrUSets[iUSet][GAMMA]);
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmTP_u(temperature[i], us);
+	
+} // StmTP_n
+
+
+/*  specific enthalpy for arrays of pressures and temperatures */
+void StmPTH_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTH_u(pressure[i], temperature[i], us);
+	
+} // StmPTH_n
+
+
+/*  specific entropy for arrays of pressures and temperatures */
+void StmPTS_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTS_u(pressure[i], temperature[i], us);
+	
+} // StmPTS_n
+
+
+/*  specific volume for arrays of pressures and temperatures */
+void StmPTV_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTV_u(pressure[i], temperature[i], us);
+	
+} // StmPTV_n
+
+
+/*  specific isobaric heat capacity Cp for arrays of pressures and temperatures */
+void StmPTC_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTC_u(pressure[i], temperature[i], us);
+	
+} // StmPTC_n
+
+
+/*  thermal conductivity for arrays of pressures and temperatures */
+void StmPTK_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTK_u(pressure[i], temperature[i], us);
+	
+} // StmPTK_n
+
+
+/*  dynamic viscosity for arrays of pressures and temperatures */
+void StmPTM_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTM_u(pressure[i], temperature[i], us);
+	
+} // StmPTM_n
+
+
+/*  speed of sound for arrays of pressures and temperatures */
+void StmPTW_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTW_u(pressure[i], temperature[i], us);
+	
+} // StmPTW_n
+
+
+/*  isentropic expansion coefficient for arrays of pressures and temperatures */
+void StmPTG_n(const double *pressure, const double *temperature, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPTG_u(pressure[i], temperature[i], us);
+	
+} // StmPTG_n
+
+
+/*  temperature for arrays of pressures and enthalpies */
+void StmPHT_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPHT_u(pressure[i], enthalpy[i], us);
+	
+} // StmPHT_n
+
+
+/*  specific entropy for arrays of pressures and enthalpies */
+void StmPHS_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPHS_u(pressure[i], enthalpy[i], us);
+	
+} // StmPHS_n
+
+
+/*  specific volume for arrays of pressures and enthalpies */
+void StmPHV_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPHV_u(pressure[i], enthalpy[i], us);
+	
+} // StmPHV_n
+
+
+/*  quality for arrays of pressures and enthalpies */
+void StmPHQ_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPHQ_u(pressure[i], enthalpy[i], us);
+	
+} // StmPHQ_n
+
+
+/*  specific isobaric heat capacity Cp for arrays of pressures and enthalpies */
+void StmPHC_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPHC_u(pressure[i], enthalpy[i], us);
+	
+} // StmPHC_n
+
+
+/*  speed of sound for arrays of pressures and enthalpies */
+void StmPHW_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPHW_u(pressure[i], enthalpy[i], us);
+	
+} // StmPHW_n
 
-} // StmPSG
 
+/*  isentropic expansion coefficient for arrays of pressures and enthalpies */
+void StmPHG_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPHG_u(pressure[i], enthalpy[i], us);
+	
+} // StmPHG_n
+
+
+/*  temperature for arrays of pressures and entropies */
+void StmPST_n(const double *pressure, const double *entropy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPST_u(pressure[i], entropy[i], us);
+	
+} // StmPST_n
 
 
+/*  specific enthalpy for arrays of pressures and entropies */
+void StmPSH_n(const double *pressure, const double *entropy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPSH_u(pressure[i], entropy[i], us);
+	
+} // StmPSH_n
+
+
+/*  specific volume for arrays of pressures and entropies */
+void StmPSV_n(const double *pressure, const double *entropy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPSV_u(pressure[i], entropy[i], us);
+	
+} // StmPSV_n
+
+
+/*  quality for arrays of pressures and entropies */
+void StmPSQ_n(const double *pressure, const double *entropy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPSQ_u(pressure[i], entropy[i], us);
+	
+} // StmPSQ_n
+
+
+/*  specific isobaric heat capacity Cp for arrays of pressures and entropies */
+void StmPSC_n(const double *pressure, const double *entropy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPSC_u(pressure[i], entropy[i], us);
+	
+} // StmPSC_n
+
+
+/*  speed of sound for arrays of pressures and entropies */
+void StmPSW_n(const double *pressure, const double *entropy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPSW_u(pressure[i], entropy[i], us);
+	
+} // StmPSW_n
+
+
+/*  isentropic expansion coefficient for arrays of pressures and entropies */
+void StmPSG_n(const double *pressure, const double *entropy, double *out, int n, char* unitset){
+	const typStmUnitSet *us = StmUnitSetOpen(unitset);
+	int i;
+	
+	#pragma omp parallel for 	//handle loop multithreaded
+	for (i = 0; i < n; i++)
+		out[i] = StmPSG_u(pressure[i], entropy[i], us);
+	
+} // StmPSG_n
+
+
+
+/*  Uncomment as these become availabel in if97_lib
+
 // *************  TQ  ********************
 
 //  specific enthalpy for a given temperature and quality
@@ -796,10 +1486,3 @@ double StmTEMPTI(double temp90, char* unitset) ;
 
 */
 
-
-
-
-
-
-#endif // IF97_WINSTEAM_H
-
@@ -56,89 +56,234 @@
 #define UNITSTRLEN 5
 
 
+/** A unit set with the conversions of each quantity to and from SIF (the units of 
+ * if97_lib) already resolved.  Get one with StmUnitSetOpen and pass it to the _u 
+ * functions, which then do no string handling.  Useful when calling in a loop */
+typedef struct sctStmUnitSet {
+	int iUSet;  // set number, as getUnitSetNo
+	typUnitConv toSIF[12];  // [unittype] from this set to SIF
+	typUnitConv fromSIF[12];  // [unittype] from SIF to this set
+} typStmUnitSet;
+
+
+/** the unit set with the given name or number, as used by the other functions.  Sets are 
+ * built on the first call and shared, so the pointer need not be freed and stays valid */
+const typStmUnitSet *StmUnitSetOpen (char *unitset);
+
+
+
+/** Hit rate statistics of the result cache, from StmCacheStats */
+typedef struct sctStmCacheStats {
+	unsigned long lHits;
+	unsigned long lMisses;  // calls not found, which are then calculated and kept
+	unsigned long lEvictions;  // least recently used entries replaced
+	int iEntries;
+	int iCapacity;  // 0 when the cache is off
+	double dblHitRate;  // hits / (hits + misses).  0 before any call
+} typStmCacheStats;
+
+
+/** Turns on the result cache with room for iCapacity results, or off for 0 (the default).
+ * When on, the Stm functions first look for a result with the same function, inputs (bit for 
+ * bit) and unit set, and keep what they calculate, replacing the least recently used result 
+ * when full.  Worthwhile when the same calls are repeated, as in spreadsheet recalculation,
+ * and especially for the functions that iterate (PH and PS).  The cache is shared between 
+ * threads.  Any earlier results and statistics are discarded.  Do not call while other threads 
+ * are calling the Stm functions.  Returns 0, or -1 if the memory could not be allocated (the cache is then off) */
+int StmCacheSetCapacity (int iCapacity);
+
+/** empties the result cache and zeros its statistics */
+void StmCacheClear (void);
+
+/** hits, misses and evictions of the result cache since it was turned on or cleared */
+typStmCacheStats StmCacheStats (void);
+
+
 // SATURATION LINE
 
 
 /** saturation temperature for a given pressure */
 double StmPT(double pressure, char* unitset); //OK except enggo
+double StmPT_u(double pressure, const typStmUnitSet *us);
 
 /** saturation pressure for a given temperatrue */
 double StmTP(double temperature, char* unitset); //OK except enggo
+double StmTP_u(double temperature, const typStmUnitSet *us);
 
 
 // PT
 
 /** specific enthalpy for a given pressure and temperature */
 double StmPTH(double pressure, double temperature, char* unitset);  //OK except enggo
+double StmPTH_u(double pressure, double temperature, const typStmUnitSet *us);
 
 /** specific entropy for a given pressure and temperature */
 double StmPTS(double pressure, double temperature, char* unitset);  //OK except enggo
+double StmPTS_u(double pressure, double temperature, const typStmUnitSet *us);
 
 /** specific volume for a given pressure and temperature */
 double StmPTV(double pressure, double temperature , char* unitset);  //OK except eng, enggo.  engg not checked yet
+double StmPTV_u(double pressure, double temperature , const typStmUnitSet *us);
 
 /** specific isobaric heat capacity for a given pressure and temperature */
 double StmPTC(double pressure, double temperature, char* unitset);
+double StmPTC_u(double pressure, double temperature, const typStmUnitSet *us);
 
 /** thermal conductivity for a given pressure and temperature */
 double StmPTK(double pressure, double temperature, char* unitset);
+double StmPTK_u(double pressure, double temperature, const typStmUnitSet *us);
 
 /** dynamic viscosity for a given pressure and temperature */
 double StmPTM(double pressure, double temperature, char* unitset);
+double StmPTM_u(double pressure, double temperature, const typStmUnitSet *us);
 
 /** speed of sound for a given pressure and temperature */
 double StmPTW(double pressure, double temperature, char* unitset);
+double StmPTW_u(double pressure, double temperature, const typStmUnitSet *us);
 
 /** isentropic expansion coefficient for a given pressure and temperature */
 double StmPTG(double pressure, double temperature, char* unitset);
+double StmPTG_u(double pressure, double temperature, const typStmUnitSet *us);
 
 
 // PH
 
 /** temperature for a given pressure and enthalpy */
 double StmPHT(double pressure, double enthalpy, char* unitset);
+double StmPHT_u(double pressure, double enthalpy, const typStmUnitSet *us);
 
 /** specific entropy for a given pressure and enthalpy */
 double StmPHS(double pressure, double enthalpy, char* unitset);
+double StmPHS_u(double pressure, double enthalpy, const typStmUnitSet *us);
 
 /** specific volume for a given pressure and enthalpy */
 double StmPHV(double pressure, double enthalpy, char* unitset);
+double StmPHV_u(double pressure, double enthalpy, const typStmUnitSet *us);
 
 /** quality for a given pressure and enthalpy */
 double StmPHQ(double pressure, double enthalpy, char* unitset);
+double StmPHQ_u(double pressure, double enthalpy, const typStmUnitSet *us);
 
-/** specific heat capacity #TODO - Which one# for a given pressure and enthalpy */
+/** specific isobaric heat capacity for a given pressure and enthalpy */
 double StmPHC(double pressure, double enthalpy, char* unitset);
+double StmPHC_u(double pressure, double enthalpy, const typStmUnitSet *us);
 
 /** speed of sound for a given pressure and enthalpy */
 double StmPHW(double pressure, double enthalpy, char* unitset);
+double StmPHW_u(double pressure, double enthalpy, const typStmUnitSet *us);
 
 /** isentropic expansion coefficient for a given pressure and enthalpy */
 double StmPHG(double pressure, double enthalpy, char* unitset);
+double StmPHG_u(double pressure, double enthalpy, const typStmUnitSet *us);
 
 
 // PS
 
 /** temperature for a given pressure and entropy */
-double StmPST(double pressure, double entropy);
+double StmPST(double pressure, double entropy, char* unitset);
+double StmPST_u(double pressure, double entropy, const typStmUnitSet *us);
 
 /** specific enthalpy for a given pressure and entropy */
-double StmPSH(double pressure, double entropy);
+double StmPSH(double pressure, double entropy, char* unitset);
+double StmPSH_u(double pressure, double entropy, const typStmUnitSet *us);
 
 /** specific volume for a given pressure and entropy */
-double StmPSV(double pressure, double entropy);
+double StmPSV(double pressure, double entropy, char* unitset);
+double StmPSV_u(double pressure, double entropy, const typStmUnitSet *us);
 
 /** quality for a given pressure and entropy */
-double StmPSQ(double pressure, double entropy);
+double StmPSQ(double pressure, double entropy, char* unitset);
+double StmPSQ_u(double pressure, double entropy, const typStmUnitSet *us);
 
-/** specific heat capacity #TODO - Which one# for a given pressure and entropy */
-double StmPSC(double pressure, double entropy);
+/** specific isobaric heat capacity for a given pressure and entropy */
+double StmPSC(double pressure, double entropy, char* unitset);
+double StmPSC_u(double pressure, double entropy, const typStmUnitSet *us);
 
 /** speed of sound for a given pressure and entropy */
-double StmPSW(double pressure, double entropy);
+double StmPSW(double pressure, double entropy, char* unitset);
+double StmPSW_u(double pressure, double entropy, const typStmUnitSet *us);
 
 /** isentropic expansion coefficient for a given pressure and entropy */
-double StmPSG(double pressure, double entropy);
+double StmPSG(double pressure, double entropy, char* unitset);
+double StmPSG_u(double pressure, double entropy, const typStmUnitSet *us);
+
+
+// ARRAYS
+
+/* each of the functions above for arrays of n inputs, in the units of unitset. Each output is as the 
+ * single function gives, error values included.  The elements are shared between threads by OpenMP */
+
+/** saturation temperature for an array of pressures */
+void StmPT_n(const double *pressure, double *out, int n, char* unitset);
+
+/** saturation pressure for an array of temperatures */
+void StmTP_n(const double *temperature, double *out, int n, char* unitset);
+
+/** specific enthalpy for arrays of pressures and temperatures */
+void StmPTH_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** specific entropy for arrays of pressures and temperatures */
+void StmPTS_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** specific volume for arrays of pressures and temperatures */
+void StmPTV_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** specific isobaric heat capacity Cp for arrays of pressures and temperatures */
+void StmPTC_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** thermal conductivity for arrays of pressures and temperatures */
+void StmPTK_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** dynamic viscosity for arrays of pressures and temperatures */
+void StmPTM_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** speed of sound for arrays of pressures and temperatures */
+void StmPTW_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** isentropic expansion coefficient for arrays of pressures and temperatures */
+void StmPTG_n(const double *pressure, const double *temperature, double *out, int n, char* unitset);
+
+/** temperature for arrays of pressures and enthalpies */
+void StmPHT_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset);
+
+/** specific entropy for arrays of pressures and enthalpies */
+void StmPHS_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset);
+
+/** specific volume for arrays of pressures and enthalpies */
+void StmPHV_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset);
+
+/** quality for arrays of pressures and enthalpies */
+void StmPHQ_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset);
+
+/** specific isobaric heat capacity Cp for arrays of pressures and enthalpies */
+void StmPHC_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset);
+
+/** speed of sound for arrays of pressures and enthalpies */
+void StmPHW_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset);
+
+/** isentropic expansion coefficient for arrays of pressures and enthalpies */
+void StmPHG_n(const double *pressure, const double *enthalpy, double *out, int n, char* unitset);
+
+/** temperature for arrays of pressures and entropies */
+void StmPST_n(const double *pressure, const double *entropy, double *out, int n, char* unitset);
+
+/** specific enthalpy for arrays of pressures and entropies */
+void StmPSH_n(const double *pressure, const double *entropy, double *out, int n, char* unitset);
+
+/** specific volume for arrays of pressures and entropies */
+void StmPSV_n(const double *pressure, const double *entropy, double *out, int n, char* unitset);
+
+/** quality for arrays of pressures and entropies */
+void StmPSQ_n(const double *pressure, const double *entropy, double *out, int n, char* unitset);
+
+/** specific isobaric heat capacity Cp for arrays of pressures and entropies */
+void StmPSC_n(const double *pressure, const double *entropy, double *out, int n, char* unitset);
+
+/** speed of sound for arrays of pressures and entropies */
+void StmPSW_n(const double *pressure, const double *entropy, double *out, int n, char* unitset);
+
+/** isentropic expansion coefficient for arrays of pressures and entropies */
+void StmPSG_n(const double *pressure, const double *entropy, double *out, int n, char* unitset);
 
 
 // TQ
@@ -17,15 +17,143 @@
 #include "if97_lib_test.h"
 
 
+double stm_pt_si (double p, double dummy) {return StmPT(p, "SI");}
+double stm_pth_si (double p, double t) {return StmPTH(p, t, "SI");}
+double stm_pth_eng (double p, double t) {return StmPTH(p, t, "eng");}
+double stm_pth_sik (double p, double t) {return StmPTH(p, t, "Sik");}
+double stm_pts_si (double p, double t) {return StmPTS(p, t, "1");}
+double stm_pht_si (double p, double h) {return StmPHT(p, h, "SI");}
+double stm_pst_eng (double p, double s) {return StmPST(p, s, "ENG");}
+
+// through a unit set opened once
+double stm_pth_u_eng (double p, double t) {return StmPTH_u(p, t, StmUnitSetOpen("ENG"));}
+double stm_pht_u_met (double p, double h) {return StmPHT_u(p, h, StmUnitSetOpen("met"));}
+
+// the handle gives the same result as the unit set name
+bool stm_u_same (double p, double t) {
+	const typStmUnitSet *us = StmUnitSetOpen("SIK");
+	return testClose(StmPTH_u(p, t, us), StmPTH(p, t, "SIK"), TEST_ULP_TOL) && testClose(StmPTS_u(p, t, us), StmPTS(p, t, "SIK"), TEST_ULP_TOL)
+			&& testClose(StmTP_u(100.0, us), StmTP(100.0, "SIK"), TEST_ULP_TOL);
+}
+
+// IFC-67 sets and unknown names give error values
+bool stm_ifc67 (double p, double t) {return StmPTH(p, t, "enggo") == DBL_MIN;}
+bool stm_unknown (double p, double t) {return StmPTH_u(p, t, StmUnitSetOpen("furlongs")) == StmPTH(p, t, "furlongs");}
+
+
+
+#define STM_ARRAY_TEST_N 40
+#define STM_CACHE_TEST_STATES 8  // distinct states among them in the threaded cache test
+
+// the array functions give each element as the single functions do, error values included.  Not bit for bit:
+// nested in the arrays' parallel loop, the region equations' reductions run serially
+int stm_array_check (FILE *logFile){
+	int i, iErr = TEST_PASS;
+	double p[STM_ARRAY_TEST_N], t[STM_ARRAY_TEST_N], out[STM_ARRAY_TEST_N], h[STM_ARRAY_TEST_N];
+	
+	for (i = 0; i < STM_ARRAY_TEST_N; i++) {
+		p[i] = 1.0 + 100.0 * i;  // psia
+		t[i] = 100.0 + 50.0 * i;  // F
+	}
+	
+	StmPTH_n(p, t, out, STM_ARRAY_TEST_N, "ENG");
+	for (i = 0; i < STM_ARRAY_TEST_N; i++) {
+		if (!testClose(out[i], StmPTH(p[i], t[i], "ENG"), TEST_ULP_TOL)) iErr = TEST_INCORRECT;
+		h[i] = out[i];
+	}
+	
+	StmPHT_n(p, h, out, STM_ARRAY_TEST_N, "ENG");
+	for (i = 0; i < STM_ARRAY_TEST_N; i++)
+		if (!testClose(out[i], StmPHT(p[i], h[i], "ENG"), TEST_ULP_TOL)) iErr = TEST_INCORRECT;
+	
+	StmTP_n(t, out, 12, "ENG");  // below the critical point
+	for (i = 0; i < 12; i++)
+		if (!testClose(out[i], StmTP(t[i], "ENG"), TEST_ULP_TOL)) iErr = TEST_INCORRECT;
+	
+	StmPTS_n(p, t, out, STM_ARRAY_TEST_N, "enggo");
+	for (i = 0; i < STM_ARRAY_TEST_N; i++)
+		if (out[i] != DBL_MIN) iErr = TEST_INCORRECT;
+	
+	fprintf(logFile, "Stm*_n arrays of %i against single calls \t %s\n", STM_ARRAY_TEST_N, (iErr == TEST_PASS) ? "PASS" : "FAIL");
+	return iErr;
+}
+
+
+
+// the result cache gives the calculated results, and replaces the least recently used when full
+int stm_cache_check (FILE *logFile){
+	int i, iErr = TEST_PASS;
+	double dblPHT = StmPHT(100.0, 3375.0, "SI"), dblPST = StmPST(100.0, 6.6, "SI");
+	double p[STM_ARRAY_TEST_N], t[STM_ARRAY_TEST_N], out[STM_ARRAY_TEST_N];
+	typStmCacheStats stats;
+	
+	StmCacheSetCapacity(3);
+	if (!testClose(StmPHT(100.0, 3375.0, "SI"), dblPHT, TEST_ULP_TOL)) iErr = TEST_INCORRECT;  // miss
+	if (!testClose(StmPHT(100.0, 3375.0, "SI"), dblPHT, TEST_ULP_TOL)) iErr = TEST_INCORRECT;  // hit
+	StmPST(100.0, 6.6, "SI");  // miss
+	StmPST(100.0, 6.6, "SIK");  // miss.  Another unit set.  Now full
+	StmPHQ(1.0, 1500.0, "SI");  // miss.  Replaces StmPHT
+	if (!testClose(StmPST(100.0, 6.6, "SI"), dblPST, TEST_ULP_TOL)) iErr = TEST_INCORRECT;  // hit
+	if (!testClose(StmPHT(100.0, 3375.0, "SI"), dblPHT, TEST_ULP_TOL)) iErr = TEST_INCORRECT;  // miss.  Replaces StmPST SIK
+	
+	stats = StmCacheStats();
+	if ((stats.lHits != 2) || (stats.lMisses != 5) || (stats.lEvictions != 2) || (stats.iEntries != 3)) iErr = TEST_INCORRECT;
+	fprintf(logFile, "StmCache hits %lu, misses %lu, evictions %lu, entries %i of %i, hit rate %.3f\n", 
+			stats.lHits, stats.lMisses, stats.lEvictions, stats.iEntries, stats.iCapacity, stats.dblHitRate);
+	
+	// repeated inputs from many threads.  How many hit depends on how the threads interleave, but
+	// every call is a hit or a miss
+	StmCacheSetCapacity(16);
+	for (i = 0; i < STM_ARRAY_TEST_N; i++) {
+		p[i] = 1.0 + 100.0 * (i % STM_CACHE_TEST_STATES);
+		t[i] = 400.0 + 50.0 * (i % STM_CACHE_TEST_STATES);
+	}
+	StmPTH_n(p, t, out, STM_ARRAY_TEST_N, "ENG");
+	stats = StmCacheStats();
+	if (stats.lHits + stats.lMisses != STM_ARRAY_TEST_N) iErr = TEST_INCORRECT;
+	
+	// from one thread each state misses only the first time
+	StmCacheClear();
+	for (i = 0; i < STM_ARRAY_TEST_N; i++) StmPTH(p[i], t[i], "ENG");
+	stats = StmCacheStats();
+	if ((stats.lHits != STM_ARRAY_TEST_N - STM_CACHE_TEST_STATES) || (stats.lMisses != STM_CACHE_TEST_STATES)) iErr = TEST_INCORRECT;
+	StmCacheSetCapacity(0);
+	
+	for (i = 0; i < STM_ARRAY_TEST_N; i++)
+		if (!testClose(out[i], StmPTH(p[i], t[i], "ENG"), TEST_ULP_TOL)) iErr = TEST_INCORRECT;
+	
+	fprintf(logFile, "StmCache LRU replacement and threaded use \t %s\n", (iErr == TEST_PASS) ? "PASS" : "FAIL");
+	return iErr;
+}
+
+
+
 int winsteam_compatibility_test (FILE *logFile){	
 	int intermediateResult= TEST_PASS; //initialise with clear flags.  
 	
-	fprintf(logFile, "\n\n*** IF97 REGION 5 MODULE CHECK ***\n" );
+	fprintf(logFile, "\n\n*** WINSTEAM COMPATIBILITY MODULE CHECK ***\n" );
+
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pt_si, 100.0, 0.0, 310.99949, 7, SIG_FIG, "StmPT SI", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pth_si, 100.0, 500.0, 3375.05844, TEST_ACCURACY, SIG_FIG, "StmPTH SI", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pth_eng, 100.0, 500.0, 1279.32095, 6, SIG_FIG, "StmPTH ENG", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pth_sik, 100.0, 500.0, 3488.70857, TEST_ACCURACY, SIG_FIG, "StmPTH SIK", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pts_si, 100.0, 500.0, 6.59932253, TEST_ACCURACY, SIG_FIG, "StmPTS SI", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pht_si, 100.0, 3375.05844, 500.0, 6, SIG_FIG, "StmPHT SI", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pst_eng, 100.0, 1.70889598, 500.0, 6, SIG_FIG, "StmPST ENG", logFile);
+	
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pth_u_eng, 100.0, 500.0, 1279.32095, 6, SIG_FIG, "StmPTH_u ENG", logFile);
+	intermediateResult = intermediateResult | testDoubleInput ( stm_pht_u_met, 100.0, 806.118860, 500.0, 6, SIG_FIG, "StmPHT_u MET", logFile);
+	intermediateResult = intermediateResult | testBoolDoubleInput ( stm_u_same, 100.0, 500.0, true, "_u same as unit set name", logFile);
+	intermediateResult = intermediateResult | testBoolDoubleInput ( stm_ifc67, 100.0, 500.0, true, "IFC-67 set gives DBL_MIN", logFile);
+	intermediateResult = intermediateResult | testBoolDoubleInput ( stm_unknown, 100.0, 500.0, true, "unknown set same error as name", logFile);
+	intermediateResult = intermediateResult | stm_array_check (logFile);
+	intermediateResult = intermediateResult | stm_cache_check (logFile);
 
+	if (intermediateResult != 0)
+		intermediateResult= intermediateResult | TEST_FAIL;
+	return intermediateResult;	
+}
 
-	fprintf(logFile, "*** IF97 REGION 5 (high temperature steam) PROPERTY (FORWARDS) EQUATIONS CHECK ***\n" );
-	
-	//intermediateResult = intermediateResult | testDoubleInput ( StmPT, 0.5, 1500.0, -1, TEST_ACCURACY, SIG_FIG, "if97_r5_v", logFile);
 
 
 /*
@@ -144,30 +272,4 @@ int winsteam_compatibility_test (FILE *logFile){
 	fprintf ( pTestLog, "StmPTG (100 [bar], 500 (°C), ""MET" " ) should be XXX :  Calculated as %.8f\n", StmPTG(100, 500, "met"));
 	fprintf ( pTestLog, "StmPTG (100 [ata], 500 (°C), ""METF" " ) should be XXX :  Calculated as %.8f\n", StmPTG(100, 500, "metf"));	
 	**/	
-	
-	
-	
-
-	
-	
-	
-	if (intermediateResult != 0)
-		intermediateResult= intermediateResult | TEST_FAIL;
-	return intermediateResult;	
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
 